@@ -7,7 +7,10 @@
 
 #include <algorithm> // For std::toupper
 #include <cstdlib>   // For std::getenv
+#include <atomic>    // For std::atomic
 #include <iostream>  // For std::cerr
+#include <mutex>     // For std::mutex
+#include <numeric>   // For std::accumulate
 #include <string>    // For std::string
 
 namespace vtk
@@ -18,6 +21,20 @@ namespace smp
 {
 VTK_ABI_NAMESPACE_BEGIN
 
+namespace
+{
+// Counted per thread, so that the calls made by concurrent algorithms are
+// told apart.
+VTK_THREAD_LOCAL vtkIdType NumberOfForCalls = 0;
+
+// Instrumentation of the For() calls. The label is set per thread by the
+// caller of For().
+std::atomic<bool> Instrumentation(false);
+VTK_THREAD_LOCAL const char* LoopLabel = nullptr;
+std::mutex LoopStatisticsMutex;
+std::vector<vtkSMPToolsLoopStatistics> LoopStatistics;
+}
+
 //------------------------------------------------------------------------------
 vtkSMPToolsAPI::vtkSMPToolsAPI()
 {
@@ -228,6 +245,43 @@ bool vtkSMPToolsAPI::GetNestedParallelism()
   return false;
 }
 
+//------------------------------------------------------------------------------
+void vtkSMPToolsAPI::SetWorkStealing(bool enable)
+{
+  switch (this->ActivatedBackend)
+  {
+    case BackendType::Sequential:
+      this->SequentialBackend->SetWorkStealing(enable);
+      break;
+    case BackendType::STDThread:
+      this->STDThreadBackend->SetWorkStealing(enable);
+      break;
+    case BackendType::TBB:
+      this->TBBBackend->SetWorkStealing(enable);
+      break;
+    case BackendType::OpenMP:
+      this->OpenMPBackend->SetWorkStealing(enable);
+      break;
+  }
+}
+
+//------------------------------------------------------------------------------
+bool vtkSMPToolsAPI::GetWorkStealing()
+{
+  switch (this->ActivatedBackend)
+  {
+    case BackendType::Sequential:
+      return this->SequentialBackend->GetWorkStealing();
+    case BackendType::STDThread:
+      return this->STDThreadBackend->GetWorkStealing();
+    case BackendType::TBB:
+      return this->TBBBackend->GetWorkStealing();
+    case BackendType::OpenMP:
+      return this->OpenMPBackend->GetWorkStealing();
+  }
+  return false;
+}
+
 //------------------------------------------------------------------------------
 bool vtkSMPToolsAPI::IsParallelScope()
 {
@@ -245,6 +299,82 @@ bool vtkSMPToolsAPI::IsParallelScope()
   return false;
 }
 
+//------------------------------------------------------------------------------
+void vtkSMPToolsAPI::CountForCall()
+{
+  ++NumberOfForCalls;
+}
+
+//------------------------------------------------------------------------------
+vtkIdType vtkSMPToolsAPI::GetNumberOfForCalls()
+{
+  return NumberOfForCalls;
+}
+
+//------------------------------------------------------------------------------
+void vtkSMPToolsAPI::SetInstrumentation(bool enable)
+{
+  Instrumentation.store(enable, std::memory_order_relaxed);
+}
+
+//------------------------------------------------------------------------------
+bool vtkSMPToolsAPI::GetInstrumentation()
+{
+  return Instrumentation.load(std::memory_order_relaxed);
+}
+
+//------------------------------------------------------------------------------
+void vtkSMPToolsAPI::SetLoopLabel(const char* label)
+{
+  LoopLabel = label;
+}
+
+//------------------------------------------------------------------------------
+const char* vtkSMPToolsAPI::GetLoopLabel()
+{
+  return LoopLabel;
+}
+
+//------------------------------------------------------------------------------
+void vtkSMPToolsAPI::AddLoopStatistics(vtkSMPToolsLoopStatistics&& statistics)
+{
+  auto& api = vtkSMPToolsAPI::GetInstance();
+  statistics.Label = LoopLabel ? LoopLabel : "";
+  statistics.Backend = api.GetBackend();
+  // Threads which executed no chunk were idle during the whole loop.
+  statistics.NumberOfThreads = std::max(
+    api.GetEstimatedNumberOfThreads(), static_cast<int>(statistics.BusyTimes.size()));
+  const double busy =
+    std::accumulate(statistics.BusyTimes.begin(), statistics.BusyTimes.end(), 0.0);
+  if (busy > 0.0)
+  {
+    const double maximum =
+      *std::max_element(statistics.BusyTimes.begin(), statistics.BusyTimes.end());
+    statistics.Imbalance = maximum * statistics.NumberOfThreads / busy;
+  }
+  if (statistics.WallTime > 0.0)
+  {
+    statistics.Efficiency = busy / (statistics.NumberOfThreads * statistics.WallTime);
+  }
+
+  std::lock_guard<std::mutex> lock(LoopStatisticsMutex);
+  LoopStatistics.push_back(std::move(statistics));
+}
+
+//------------------------------------------------------------------------------
+std::vector<vtkSMPToolsLoopStatistics> vtkSMPToolsAPI::GetLoopStatistics()
+{
+  std::lock_guard<std::mutex> lock(LoopStatisticsMutex);
+  return LoopStatistics;
+}
+
+//------------------------------------------------------------------------------
+void vtkSMPToolsAPI::ClearLoopStatistics()
+{
+  std::lock_guard<std::mutex> lock(LoopStatisticsMutex);
+  LoopStatistics.clear();
+}
+
 //------------------------------------------------------------------------------
 bool vtkSMPToolsAPI::GetSingleThread()
 {
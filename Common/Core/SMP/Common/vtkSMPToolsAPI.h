@@ -10,6 +10,8 @@
 #include "vtkSMP.h"
 
 #include <memory>
+#include <string>
+#include <vector>
 
 #include "SMP/Common/vtkSMPToolsImpl.h"
 #if VTK_SMP_ENABLE_SEQUENTIAL
@@ -35,6 +37,25 @@ VTK_ABI_NAMESPACE_BEGIN
 
 using vtkSMPToolsDefaultImpl = vtkSMPToolsImpl<DefaultBackend>;
 
+//--------------------------------------------------------------------------------
+// Statistics of an instrumented For() call, see vtkSMPTools::SetInstrumentation().
+struct vtkSMPToolsLoopStatistics
+{
+  std::string Label;
+  std::string Backend;
+  vtkIdType First = 0;
+  vtkIdType Last = 0;
+  vtkIdType Grain = 0;
+  vtkIdType NumberOfChunks = 0;
+  vtkIdType MinimumChunkSize = 0;
+  vtkIdType MaximumChunkSize = 0;
+  int NumberOfThreads = 1;
+  double WallTime = 0.0;
+  std::vector<double> BusyTimes;
+  double Imbalance = 1.0;
+  double Efficiency = 1.0;
+};
+
 class VTKCOMMONCORE_EXPORT vtkSMPToolsAPI
 {
 public:
@@ -65,12 +86,32 @@ public:
   //--------------------------------------------------------------------------------
   bool GetNestedParallelism();
 
+  //--------------------------------------------------------------------------------
+  void SetWorkStealing(bool enable);
+
+  //--------------------------------------------------------------------------------
+  bool GetWorkStealing();
+
   //--------------------------------------------------------------------------------
   bool IsParallelScope();
 
   //--------------------------------------------------------------------------------
   bool GetSingleThread();
 
+  //--------------------------------------------------------------------------------
+  // Number of For() calls made from the calling thread.
+  static vtkIdType GetNumberOfForCalls();
+
+  //--------------------------------------------------------------------------------
+  // Instrumentation of the For() calls, see vtkSMPTools::SetInstrumentation().
+  static void SetInstrumentation(bool enable);
+  static bool GetInstrumentation();
+  static void SetLoopLabel(const char* label);
+  static const char* GetLoopLabel();
+  static void AddLoopStatistics(vtkSMPToolsLoopStatistics&& statistics);
+  static std::vector<vtkSMPToolsLoopStatistics> GetLoopStatistics();
+  static void ClearLoopStatistics();
+
   //--------------------------------------------------------------------------------
   int GetInternalDesiredNumberOfThread() { return this->DesiredNumberOfThread; }
 
@@ -96,6 +137,7 @@ public:
   template <typename FunctorInternal>
   void For(vtkIdType first, vtkIdType last, vtkIdType grain, FunctorInternal& fi)
   {
+    vtkSMPToolsAPI::CountForCall();
     switch (this->ActivatedBackend)
     {
       case BackendType::Sequential:
@@ -219,6 +261,88 @@ public:
     }
   }
 
+  //--------------------------------------------------------------------------------
+  template <typename InputIt, typename T, typename ReduceOp, typename TransformOp>
+  T TransformReduce(
+    InputIt inBegin, InputIt inEnd, T init, ReduceOp& reduce, TransformOp& transform)
+  {
+    switch (this->ActivatedBackend)
+    {
+      case BackendType::Sequential:
+        return this->SequentialBackend->TransformReduce(inBegin, inEnd, init, reduce, transform);
+      case BackendType::STDThread:
+        return this->STDThreadBackend->TransformReduce(inBegin, inEnd, init, reduce, transform);
+      case BackendType::TBB:
+        return this->TBBBackend->TransformReduce(inBegin, inEnd, init, reduce, transform);
+      case BackendType::OpenMP:
+        return this->OpenMPBackend->TransformReduce(inBegin, inEnd, init, reduce, transform);
+    }
+    return init;
+  }
+
+  //--------------------------------------------------------------------------------
+  template <typename InputIt, typename OutputIt, typename BinaryOp>
+  void InclusiveScan(InputIt inBegin, InputIt inEnd, OutputIt outBegin, BinaryOp& op)
+  {
+    switch (this->ActivatedBackend)
+    {
+      case BackendType::Sequential:
+        this->SequentialBackend->InclusiveScan(inBegin, inEnd, outBegin, op);
+        break;
+      case BackendType::STDThread:
+        this->STDThreadBackend->InclusiveScan(inBegin, inEnd, outBegin, op);
+        break;
+      case BackendType::TBB:
+        this->TBBBackend->InclusiveScan(inBegin, inEnd, outBegin, op);
+        break;
+      case BackendType::OpenMP:
+        this->OpenMPBackend->InclusiveScan(inBegin, inEnd, outBegin, op);
+        break;
+    }
+  }
+
+  //--------------------------------------------------------------------------------
+  template <typename InputIt, typename OutputIt, typename BinaryOp, typename T>
+  void InclusiveScan(InputIt inBegin, InputIt inEnd, OutputIt outBegin, BinaryOp& op, T init)
+  {
+    switch (this->ActivatedBackend)
+    {
+      case BackendType::Sequential:
+        this->SequentialBackend->InclusiveScan(inBegin, inEnd, outBegin, op, init);
+        break;
+      case BackendType::STDThread:
+        this->STDThreadBackend->InclusiveScan(inBegin, inEnd, outBegin, op, init);
+        break;
+      case BackendType::TBB:
+        this->TBBBackend->InclusiveScan(inBegin, inEnd, outBegin, op, init);
+        break;
+      case BackendType::OpenMP:
+        this->OpenMPBackend->InclusiveScan(inBegin, inEnd, outBegin, op, init);
+        break;
+    }
+  }
+
+  //--------------------------------------------------------------------------------
+  template <typename InputIt, typename OutputIt, typename T, typename BinaryOp>
+  void ExclusiveScan(InputIt inBegin, InputIt inEnd, OutputIt outBegin, T init, BinaryOp& op)
+  {
+    switch (this->ActivatedBackend)
+    {
+      case BackendType::Sequential:
+        this->SequentialBackend->ExclusiveScan(inBegin, inEnd, outBegin, init, op);
+        break;
+      case BackendType::STDThread:
+        this->STDThreadBackend->ExclusiveScan(inBegin, inEnd, outBegin, init, op);
+        break;
+      case BackendType::TBB:
+        this->TBBBackend->ExclusiveScan(inBegin, inEnd, outBegin, init, op);
+        break;
+      case BackendType::OpenMP:
+        this->OpenMPBackend->ExclusiveScan(inBegin, inEnd, outBegin, init, op);
+        break;
+    }
+  }
+
   // disable copying
   vtkSMPToolsAPI(vtkSMPToolsAPI const&) = delete;
   void operator=(vtkSMPToolsAPI const&) = delete;
@@ -238,6 +362,9 @@ private:
   //--------------------------------------------------------------------------------
   void RefreshNumberOfThread();
 
+  //--------------------------------------------------------------------------------
+  static void CountForCall();
+
   //--------------------------------------------------------------------------------
   // This operator overload is used to unpack Config parameters and set them
   // in vtkSMPToolsAPI (e.g `*this << config;`)
@@ -247,6 +374,7 @@ private:
     this->Initialize(config.MaxNumberOfThreads);
     this->SetBackend(config.Backend.c_str());
     this->SetNestedParallelism(config.NestedParallelism);
+    this->SetWorkStealing(config.WorkStealing);
     return *this;
   }
 
@@ -61,6 +61,12 @@ public:
   //--------------------------------------------------------------------------------
   bool GetNestedParallelism();
 
+  //--------------------------------------------------------------------------------
+  void SetWorkStealing(bool enable);
+
+  //--------------------------------------------------------------------------------
+  bool GetWorkStealing();
+
   //--------------------------------------------------------------------------------
   bool IsParallelScope();
 
@@ -92,6 +98,23 @@ public:
   template <typename RandomAccessIterator, typename Compare>
   void Sort(RandomAccessIterator begin, RandomAccessIterator end, Compare comp);
 
+  //--------------------------------------------------------------------------------
+  template <typename InputIt, typename T, typename ReduceOp, typename TransformOp>
+  T TransformReduce(
+    InputIt inBegin, InputIt inEnd, T init, ReduceOp reduce, TransformOp transform);
+
+  //--------------------------------------------------------------------------------
+  template <typename InputIt, typename OutputIt, typename BinaryOp>
+  void InclusiveScan(InputIt inBegin, InputIt inEnd, OutputIt outBegin, BinaryOp op);
+
+  //--------------------------------------------------------------------------------
+  template <typename InputIt, typename OutputIt, typename BinaryOp, typename T>
+  void InclusiveScan(InputIt inBegin, InputIt inEnd, OutputIt outBegin, BinaryOp op, T init);
+
+  //--------------------------------------------------------------------------------
+  template <typename InputIt, typename OutputIt, typename T, typename BinaryOp>
+  void ExclusiveScan(InputIt inBegin, InputIt inEnd, OutputIt outBegin, T init, BinaryOp op);
+
   //--------------------------------------------------------------------------------
   vtkSMPToolsImpl();
 
@@ -103,6 +126,7 @@ public:
 
 private:
   bool NestedActivated = false;
+  bool WorkStealing = false;
   std::atomic<bool> IsParallel{ false };
 };
 
@@ -118,6 +142,18 @@ bool vtkSMPToolsImpl<Backend>::GetNestedParallelism()
   return this->NestedActivated;
 }
 
+template <BackendType Backend>
+void vtkSMPToolsImpl<Backend>::SetWorkStealing(bool enable)
+{
+  this->WorkStealing = enable;
+}
+
+template <BackendType Backend>
+bool vtkSMPToolsImpl<Backend>::GetWorkStealing()
+{
+  return this->WorkStealing;
+}
+
 template <BackendType Backend>
 bool vtkSMPToolsImpl<Backend>::IsParallelScope()
 {
@@ -127,6 +163,7 @@ bool vtkSMPToolsImpl<Backend>::IsParallelScope()
 template <BackendType Backend>
 vtkSMPToolsImpl<Backend>::vtkSMPToolsImpl()
   : NestedActivated(true)
+  , WorkStealing(false)
   , IsParallel(false)
 {
 }
@@ -134,6 +171,7 @@ vtkSMPToolsImpl<Backend>::vtkSMPToolsImpl()
 template <BackendType Backend>
 vtkSMPToolsImpl<Backend>::vtkSMPToolsImpl(const vtkSMPToolsImpl& other)
   : NestedActivated(other.NestedActivated)
+  , WorkStealing(other.WorkStealing)
   , IsParallel(other.IsParallel.load())
 {
 }
@@ -142,6 +180,7 @@ template <BackendType Backend>
 void vtkSMPToolsImpl<Backend>::operator=(const vtkSMPToolsImpl& other)
 {
   this->NestedActivated = other.NestedActivated;
+  this->WorkStealing = other.WorkStealing;
   this->IsParallel = other.IsParallel.load();
 }
 
@@ -4,7 +4,10 @@
 #ifndef vtkSMPToolsInternal_h
 #define vtkSMPToolsInternal_h
 
-#include <iterator> // For std::advance
+#include <algorithm> // For std::min, std::max
+#include <iterator>  // For std::advance
+#include <utility>   // For std::forward
+#include <vector>    // For std::vector
 
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
 namespace vtk
@@ -90,6 +93,211 @@ public:
   T operator()(T vtkNotUsed(inValue)) { return Value; }
 };
 
+//--------------------------------------------------------------------------------
+struct IdentityFunctor
+{
+  template <typename U>
+  U&& operator()(U&& value) const
+  {
+    return std::forward<U>(value);
+  }
+};
+
+//--------------------------------------------------------------------------------
+// Splits [0, size) into contiguous blocks used by the parallel reductions and
+// scans. The number of blocks only depends on the size and on the number of
+// threads, so partial results are always combined in the same order for a
+// given thread count.
+class BlockPartition
+{
+  vtkIdType Size;
+  vtkIdType NumberOfBlocks;
+
+public:
+  static constexpr vtkIdType MinimumBlockSize = 1024;
+  static constexpr vtkIdType BlocksPerThread = 4;
+
+  BlockPartition(vtkIdType size, int numberOfThreads)
+    : Size(size)
+  {
+    const vtkIdType maxBlocks = std::max(numberOfThreads, 1) * BlocksPerThread;
+    const vtkIdType sizeBlocks = (size + MinimumBlockSize - 1) / MinimumBlockSize;
+    this->NumberOfBlocks = std::max<vtkIdType>(std::min(maxBlocks, sizeBlocks), 1);
+  }
+
+  vtkIdType GetNumberOfBlocks() const { return this->NumberOfBlocks; }
+
+  vtkIdType GetBlockBegin(vtkIdType block) const
+  {
+    return block * this->Size / this->NumberOfBlocks;
+  }
+};
+
+// Wrapper preventing std::vector<bool> bit packing when partial results are
+// written concurrently by several threads.
+template <typename T>
+struct BlockValue
+{
+  T Value;
+};
+
+//--------------------------------------------------------------------------------
+template <typename InputIt, typename T, typename ReduceOp, typename TransformOp>
+class TransformReduceCall
+{
+  InputIt In;
+  BlockPartition Blocks;
+  ReduceOp& Reduce;
+  TransformOp& Transform;
+  std::vector<BlockValue<T>> Partials;
+
+public:
+  TransformReduceCall(InputIt _in, vtkIdType _size, int _numberOfThreads, const T& _init,
+    ReduceOp& _reduce, TransformOp& _transform)
+    : In(_in)
+    , Blocks(_size, _numberOfThreads)
+    , Reduce(_reduce)
+    , Transform(_transform)
+    , Partials(this->Blocks.GetNumberOfBlocks(), BlockValue<T>{ _init })
+  {
+  }
+
+  vtkIdType GetNumberOfBlocks() const { return this->Blocks.GetNumberOfBlocks(); }
+
+  void Execute(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType block = begin; block < end; ++block)
+    {
+      const vtkIdType first = this->Blocks.GetBlockBegin(block);
+      const vtkIdType last = this->Blocks.GetBlockBegin(block + 1);
+      InputIt itIn(this->In);
+      std::advance(itIn, first);
+      T partial = this->Transform(*itIn);
+      for (vtkIdType it = first + 1; it < last; ++it)
+      {
+        ++itIn;
+        partial = this->Reduce(partial, this->Transform(*itIn));
+      }
+      this->Partials[block].Value = partial;
+    }
+  }
+
+  T GetResult(T init) const
+  {
+    for (const auto& partial : this->Partials)
+    {
+      init = this->Reduce(init, partial.Value);
+    }
+    return init;
+  }
+};
+
+//--------------------------------------------------------------------------------
+// Two pass blocked scan. The first pass computes the sum of each block, the
+// block offsets are then scanned serially, and the second pass writes the
+// output of each block starting from its offset. Input and output may alias.
+template <typename InputIt, typename OutputIt, typename T, typename BinaryOp>
+class ScanCall
+{
+  InputIt In;
+  OutputIt Out;
+  BlockPartition Blocks;
+  BinaryOp& Op;
+  std::vector<BlockValue<T>> BlockSums;
+  T Init;
+  bool HasInit;
+  bool Exclusive;
+  bool Downsweep = false;
+
+public:
+  ScanCall(InputIt _in, OutputIt _out, vtkIdType _size, int _numberOfThreads, BinaryOp& _op,
+    const T& _init, bool _hasInit, bool _exclusive)
+    : In(_in)
+    , Out(_out)
+    , Blocks(_size, _numberOfThreads)
+    , Op(_op)
+    , BlockSums(this->Blocks.GetNumberOfBlocks(), BlockValue<T>{ _init })
+    , Init(_init)
+    , HasInit(_hasInit)
+    , Exclusive(_exclusive)
+  {
+  }
+
+  vtkIdType GetNumberOfBlocks() const { return this->Blocks.GetNumberOfBlocks(); }
+
+  // Turn the block sums computed by the first pass into block offsets and
+  // switch Execute() to the second pass.
+  void PrepareDownsweep()
+  {
+    T running = this->Init;
+    bool hasRunning = this->HasInit;
+    for (auto& block : this->BlockSums)
+    {
+      const T sum = block.Value;
+      if (hasRunning)
+      {
+        block.Value = running;
+        running = this->Op(running, sum);
+      }
+      else
+      {
+        running = sum;
+        hasRunning = true;
+      }
+    }
+    this->Downsweep = true;
+  }
+
+  void Execute(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType block = begin; block < end; ++block)
+    {
+      const vtkIdType first = this->Blocks.GetBlockBegin(block);
+      const vtkIdType last = this->Blocks.GetBlockBegin(block + 1);
+      InputIt itIn(this->In);
+      std::advance(itIn, first);
+      if (!this->Downsweep)
+      {
+        T sum = *itIn;
+        for (vtkIdType it = first + 1; it < last; ++it)
+        {
+          ++itIn;
+          sum = this->Op(sum, *itIn);
+        }
+        this->BlockSums[block].Value = sum;
+        continue;
+      }
+
+      OutputIt itOut(this->Out);
+      std::advance(itOut, first);
+      if (this->Exclusive)
+      {
+        T acc = this->BlockSums[block].Value;
+        for (vtkIdType it = first; it < last; ++it, ++itIn, ++itOut)
+        {
+          // Read before write so that the scan can be done in place
+          T value = *itIn;
+          *itOut = acc;
+          acc = this->Op(acc, value);
+        }
+      }
+      else
+      {
+        T acc = (block > 0 || this->HasInit) ? this->Op(this->BlockSums[block].Value, *itIn)
+                                             : static_cast<T>(*itIn);
+        *itOut = acc;
+        for (vtkIdType it = first + 1; it < last; ++it)
+        {
+          ++itIn;
+          ++itOut;
+          acc = this->Op(acc, *itIn);
+          *itOut = acc;
+        }
+      }
+    }
+  }
+};
+
 VTK_ABI_NAMESPACE_END
 
 } // namespace smp
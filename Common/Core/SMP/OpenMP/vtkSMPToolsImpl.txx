@@ -159,6 +159,82 @@ VTKCOMMONCORE_EXPORT int vtkSMPToolsImpl<BackendType::OpenMP>::GetEstimatedDefau
 template <>
 VTKCOMMONCORE_EXPORT bool vtkSMPToolsImpl<BackendType::OpenMP>::GetSingleThread();
 
+//--------------------------------------------------------------------------------
+template <>
+template <typename InputIt, typename T, typename ReduceOp, typename TransformOp>
+T vtkSMPToolsImpl<BackendType::OpenMP>::TransformReduce(
+  InputIt inBegin, InputIt inEnd, T init, ReduceOp reduce, TransformOp transform)
+{
+  auto size = std::distance(inBegin, inEnd);
+  if (size <= 0)
+  {
+    return init;
+  }
+
+  TransformReduceCall<InputIt, T, ReduceOp, TransformOp> exec(
+    inBegin, size, this->GetEstimatedNumberOfThreads(), init, reduce, transform);
+  this->For(0, exec.GetNumberOfBlocks(), 1, exec);
+  return exec.GetResult(init);
+}
+
+//--------------------------------------------------------------------------------
+template <>
+template <typename InputIt, typename OutputIt, typename BinaryOp>
+void vtkSMPToolsImpl<BackendType::OpenMP>::InclusiveScan(
+  InputIt inBegin, InputIt inEnd, OutputIt outBegin, BinaryOp op)
+{
+  using T = typename std::iterator_traits<InputIt>::value_type;
+  auto size = std::distance(inBegin, inEnd);
+  if (size <= 0)
+  {
+    return;
+  }
+
+  ScanCall<InputIt, OutputIt, T, BinaryOp> exec(
+    inBegin, outBegin, size, this->GetEstimatedNumberOfThreads(), op, *inBegin, false, false);
+  this->For(0, exec.GetNumberOfBlocks(), 1, exec);
+  exec.PrepareDownsweep();
+  this->For(0, exec.GetNumberOfBlocks(), 1, exec);
+}
+
+//--------------------------------------------------------------------------------
+template <>
+template <typename InputIt, typename OutputIt, typename BinaryOp, typename T>
+void vtkSMPToolsImpl<BackendType::OpenMP>::InclusiveScan(
+  InputIt inBegin, InputIt inEnd, OutputIt outBegin, BinaryOp op, T init)
+{
+  auto size = std::distance(inBegin, inEnd);
+  if (size <= 0)
+  {
+    return;
+  }
+
+  ScanCall<InputIt, OutputIt, T, BinaryOp> exec(
+    inBegin, outBegin, size, this->GetEstimatedNumberOfThreads(), op, init, true, false);
+  this->For(0, exec.GetNumberOfBlocks(), 1, exec);
+  exec.PrepareDownsweep();
+  this->For(0, exec.GetNumberOfBlocks(), 1, exec);
+}
+
+//--------------------------------------------------------------------------------
+template <>
+template <typename InputIt, typename OutputIt, typename T, typename BinaryOp>
+void vtkSMPToolsImpl<BackendType::OpenMP>::ExclusiveScan(
+  InputIt inBegin, InputIt inEnd, OutputIt outBegin, T init, BinaryOp op)
+{
+  auto size = std::distance(inBegin, inEnd);
+  if (size <= 0)
+  {
+    return;
+  }
+
+  ScanCall<InputIt, OutputIt, T, BinaryOp> exec(
+    inBegin, outBegin, size, this->GetEstimatedNumberOfThreads(), op, init, true, true);
+  this->For(0, exec.GetNumberOfBlocks(), 1, exec);
+  exec.PrepareDownsweep();
+  this->For(0, exec.GetNumberOfBlocks(), 1, exec);
+}
+
 VTK_ABI_NAMESPACE_END
 } // namespace smp
 } // namespace detail
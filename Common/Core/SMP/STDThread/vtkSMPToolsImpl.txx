@@ -9,8 +9,9 @@
 
 #include "SMP/Common/vtkSMPToolsImpl.h"
 #include "SMP/Common/vtkSMPToolsInternal.h" // For common vtk smp class
-#include "SMP/STDThread/vtkSMPThreadPool.h" // For vtkSMPThreadPool
-#include "vtkCommonCoreModule.h"            // For export macro
+#include "SMP/STDThread/vtkSMPThreadPool.h"         // For vtkSMPThreadPool
+#include "SMP/STDThread/vtkSMPWorkStealingRanges.h" // For vtkSMPWorkStealingRanges
+#include "vtkCommonCoreModule.h"                    // For export macro
 
 namespace vtk
 {
@@ -42,6 +43,38 @@ void vtkSMPToolsImpl<BackendType::STDThread>::For(
   {
     int threadNumber = GetNumberOfThreadsSTDThread();
 
+    if (this->WorkStealing)
+    {
+      // Chunks are only a scheduling unit here since idle workers split the remaining
+      // ranges of busy ones, so a finer default grain is affordable.
+      if (grain <= 0)
+      {
+        vtkIdType estimateGrain = (last - first) / (threadNumber * 16);
+        grain = (estimateGrain > 0) ? estimateGrain : 1;
+      }
+
+      auto proxy = vtkSMPThreadPool::GetInstance().AllocateThreads(threadNumber);
+      const std::size_t workerNumber = proxy.GetThreads().size();
+      vtkSMPWorkStealingRanges ranges(first, last, grain, workerNumber);
+
+      for (std::size_t worker = 0; worker < workerNumber; ++worker)
+      {
+        proxy.DoJob(
+          [&fi, &ranges, worker]
+          {
+            vtkIdType from;
+            vtkIdType to;
+            while (ranges.GetNextChunk(worker, from, to))
+            {
+              fi.Execute(from, to);
+            }
+          });
+      }
+
+      proxy.Join();
+      return;
+    }
+
     if (grain <= 0)
     {
       vtkIdType estimateGrain = (last - first) / (threadNumber * 4);
@@ -136,6 +169,82 @@ VTKCOMMONCORE_EXPORT bool vtkSMPToolsImpl<BackendType::STDThread>::GetSingleThre
 template <>
 VTKCOMMONCORE_EXPORT bool vtkSMPToolsImpl<BackendType::STDThread>::IsParallelScope();
 
+//--------------------------------------------------------------------------------
+template <>
+template <typename InputIt, typename T, typename ReduceOp, typename TransformOp>
+T vtkSMPToolsImpl<BackendType::STDThread>::TransformReduce(
+  InputIt inBegin, InputIt inEnd, T init, ReduceOp reduce, TransformOp transform)
+{
+  auto size = std::distance(inBegin, inEnd);
+  if (size <= 0)
+  {
+    return init;
+  }
+
+  TransformReduceCall<InputIt, T, ReduceOp, TransformOp> exec(
+    inBegin, size, this->GetEstimatedNumberOfThreads(), init, reduce, transform);
+  this->For(0, exec.GetNumberOfBlocks(), 1, exec);
+  return exec.GetResult(init);
+}
+
+//--------------------------------------------------------------------------------
+template <>
+template <typename InputIt, typename OutputIt, typename BinaryOp>
+void vtkSMPToolsImpl<BackendType::STDThread>::InclusiveScan(
+  InputIt inBegin, InputIt inEnd, OutputIt outBegin, BinaryOp op)
+{
+  using T = typename std::iterator_traits<InputIt>::value_type;
+  auto size = std::distance(inBegin, inEnd);
+  if (size <= 0)
+  {
+    return;
+  }
+
+  ScanCall<InputIt, OutputIt, T, BinaryOp> exec(
+    inBegin, outBegin, size, this->GetEstimatedNumberOfThreads(), op, *inBegin, false, false);
+  this->For(0, exec.GetNumberOfBlocks(), 1, exec);
+  exec.PrepareDownsweep();
+  this->For(0, exec.GetNumberOfBlocks(), 1, exec);
+}
+
+//--------------------------------------------------------------------------------
+template <>
+template <typename InputIt, typename OutputIt, typename BinaryOp, typename T>
+void vtkSMPToolsImpl<BackendType::STDThread>::InclusiveScan(
+  InputIt inBegin, InputIt inEnd, OutputIt outBegin, BinaryOp op, T init)
+{
+  auto size = std::distance(inBegin, inEnd);
+  if (size <= 0)
+  {
+    return;
+  }
+
+  ScanCall<InputIt, OutputIt, T, BinaryOp> exec(
+    inBegin, outBegin, size, this->GetEstimatedNumberOfThreads(), op, init, true, false);
+  this->For(0, exec.GetNumberOfBlocks(), 1, exec);
+  exec.PrepareDownsweep();
+  this->For(0, exec.GetNumberOfBlocks(), 1, exec);
+}
+
+//--------------------------------------------------------------------------------
+template <>
+template <typename InputIt, typename OutputIt, typename T, typename BinaryOp>
+void vtkSMPToolsImpl<BackendType::STDThread>::ExclusiveScan(
+  InputIt inBegin, InputIt inEnd, OutputIt outBegin, T init, BinaryOp op)
+{
+  auto size = std::distance(inBegin, inEnd);
+  if (size <= 0)
+  {
+    return;
+  }
+
+  ScanCall<InputIt, OutputIt, T, BinaryOp> exec(
+    inBegin, outBegin, size, this->GetEstimatedNumberOfThreads(), op, init, true, true);
+  this->For(0, exec.GetNumberOfBlocks(), 1, exec);
+  exec.PrepareDownsweep();
+  this->For(0, exec.GetNumberOfBlocks(), 1, exec);
+}
+
 VTK_ABI_NAMESPACE_END
 } // namespace smp
 } // namespace detail
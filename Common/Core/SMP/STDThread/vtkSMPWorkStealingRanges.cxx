@@ -0,0 +1,113 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "SMP/STDThread/vtkSMPWorkStealingRanges.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace vtk
+{
+namespace detail
+{
+namespace smp
+{
+VTK_ABI_NAMESPACE_BEGIN
+
+// Aligned on a cache line to prevent false sharing between workers
+struct alignas(64) vtkSMPWorkStealingRanges::WorkerRange
+{
+  std::mutex Mutex;
+  vtkIdType Begin{};
+  vtkIdType End{};
+  std::size_t Steals{}; // Successful steals done by this worker
+};
+
+vtkSMPWorkStealingRanges::vtkSMPWorkStealingRanges(
+  vtkIdType first, vtkIdType last, vtkIdType grain, std::size_t numberOfWorkers)
+  : Ranges{ new WorkerRange[std::max<std::size_t>(numberOfWorkers, 1)] }
+  , NumberOfWorkers{ std::max<std::size_t>(numberOfWorkers, 1) }
+  , Grain{ std::max<vtkIdType>(grain, 1) }
+{
+  const vtkIdType size = last - first;
+  const auto workers = static_cast<vtkIdType>(this->NumberOfWorkers);
+  for (vtkIdType worker = 0; worker < workers; ++worker)
+  {
+    this->Ranges[worker].Begin = first + worker * size / workers;
+    this->Ranges[worker].End = first + (worker + 1) * size / workers;
+  }
+}
+
+vtkSMPWorkStealingRanges::~vtkSMPWorkStealingRanges() = default;
+
+bool vtkSMPWorkStealingRanges::GetNextChunk(std::size_t worker, vtkIdType& begin, vtkIdType& end)
+{
+  assert(worker < this->NumberOfWorkers && "worker out of range");
+
+  WorkerRange& own = this->Ranges[worker];
+  {
+    std::lock_guard<std::mutex> lock{ own.Mutex };
+    if (own.Begin < own.End)
+    {
+      begin = own.Begin;
+      end = (std::min)(own.Begin + this->Grain, own.End);
+      own.Begin = end;
+      return true;
+    }
+  }
+
+  return this->Steal(worker, begin, end);
+}
+
+bool vtkSMPWorkStealingRanges::Steal(std::size_t thief, vtkIdType& begin, vtkIdType& end)
+{
+  // Visit the other workers starting from the next one so that thieves spread over victims
+  for (std::size_t i = 1; i < this->NumberOfWorkers; ++i)
+  {
+    WorkerRange& victim = this->Ranges[(thief + i) % this->NumberOfWorkers];
+
+    vtkIdType stolenBegin;
+    vtkIdType stolenEnd;
+    {
+      std::lock_guard<std::mutex> lock{ victim.Mutex };
+      const vtkIdType remaining = victim.End - victim.Begin;
+      if (remaining <= 0)
+      {
+        continue;
+      }
+
+      // Take the back half, or everything when only one chunk is left
+      stolenEnd = victim.End;
+      stolenBegin = remaining > this->Grain ? victim.End - remaining / 2 : victim.Begin;
+      victim.End = stolenBegin;
+    }
+
+    // Keep the first chunk and expose the rest of the stolen range to other thieves
+    WorkerRange& own = this->Ranges[thief];
+    std::lock_guard<std::mutex> lock{ own.Mutex };
+    begin = stolenBegin;
+    end = (std::min)(stolenBegin + this->Grain, stolenEnd);
+    own.Begin = end;
+    own.End = stolenEnd;
+    ++own.Steals;
+    return true;
+  }
+
+  return false;
+}
+
+std::size_t vtkSMPWorkStealingRanges::GetNumberOfSteals() const
+{
+  std::size_t steals = 0;
+  for (std::size_t worker = 0; worker < this->NumberOfWorkers; ++worker)
+  {
+    std::lock_guard<std::mutex> lock{ this->Ranges[worker].Mutex };
+    steals += this->Ranges[worker].Steals;
+  }
+  return steals;
+}
+
+VTK_ABI_NAMESPACE_END
+} // namespace smp
+} // namespace detail
+} // namespace vtk
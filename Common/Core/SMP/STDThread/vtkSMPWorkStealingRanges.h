@@ -0,0 +1,81 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// .NAME vtkSMPWorkStealingRanges - Per worker iteration ranges with stealing
+//
+// .SECTION Description
+// vtkSMPWorkStealingRanges splits an iteration range into one contiguous
+// sub-range per worker. Each worker consumes grain sized chunks from the front
+// of its own sub-range. Once it is empty, the worker steals the back half of
+// the remaining sub-range of another worker, so load-imbalanced functors keep
+// every worker busy until the whole range is processed.
+
+#ifndef vtkSMPWorkStealingRanges_h
+#define vtkSMPWorkStealingRanges_h
+
+#include "vtkCommonCoreModule.h" // For export macro
+#include "vtkSystemIncludes.h"
+
+#include <memory> // For std::unique_ptr
+#include <mutex>  // For std::mutex
+
+namespace vtk
+{
+namespace detail
+{
+namespace smp
+{
+VTK_ABI_NAMESPACE_BEGIN
+
+/**
+ * @brief Internal scheduler used by the STDThread backend when work stealing is enabled.
+ *
+ * Each worker owns a [Begin, End) range protected by its own mutex. Owners take chunks from
+ * the front of their range while thieves cut the back half of a victim range, so the owner
+ * and a thief rarely contend. A single mutex is ever locked at a time, which makes the
+ * scheduler deadlock free.
+ */
+class VTKCOMMONCORE_EXPORT vtkSMPWorkStealingRanges
+{
+public:
+  /**
+   * @brief Split [first, last) evenly between numberOfWorkers workers.
+   *
+   * grain is the size of the chunks taken by a worker from its own range. It must be
+   * strictly positive.
+   */
+  vtkSMPWorkStealingRanges(
+    vtkIdType first, vtkIdType last, vtkIdType grain, std::size_t numberOfWorkers);
+  ~vtkSMPWorkStealingRanges();
+  vtkSMPWorkStealingRanges(const vtkSMPWorkStealingRanges&) = delete;
+  vtkSMPWorkStealingRanges& operator=(const vtkSMPWorkStealingRanges&) = delete;
+
+  /**
+   * @brief Get the next chunk to process for the given worker.
+   *
+   * Returns false once no work could be found in any range, in which case the worker
+   * should stop. Must only be called by the thread running the given worker.
+   */
+  bool GetNextChunk(std::size_t worker, vtkIdType& begin, vtkIdType& end);
+
+  /**
+   * @brief Number of successful steals since construction, mainly useful for testing.
+   */
+  std::size_t GetNumberOfSteals() const;
+
+private:
+  struct WorkerRange;
+
+  bool Steal(std::size_t thief, vtkIdType& begin, vtkIdType& end);
+
+  std::unique_ptr<WorkerRange[]> Ranges;
+  std::size_t NumberOfWorkers;
+  vtkIdType Grain;
+};
+
+VTK_ABI_NAMESPACE_END
+} // namespace smp
+} // namespace detail
+} // namespace vtk
+
+#endif
+/* VTK-HeaderTest-Exclude: vtkSMPWorkStealingRanges.h */
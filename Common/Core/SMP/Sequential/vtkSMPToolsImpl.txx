@@ -5,6 +5,7 @@
 #define SequentialvtkSMPToolsImpl_txx
 
 #include <algorithm> // For std::sort, std::transform, std::fill
+#include <numeric>   // For std::transform_reduce, std::inclusive_scan, std::exclusive_scan
 
 #include "SMP/Common/vtkSMPToolsImpl.h"
 #include "SMP/Common/vtkSMPToolsInternal.h" // For common vtk smp class
@@ -90,6 +91,42 @@ void vtkSMPToolsImpl<BackendType::Sequential>::Sort(
   std::sort(begin, end, comp);
 }
 
+//--------------------------------------------------------------------------------
+template <>
+template <typename InputIt, typename T, typename ReduceOp, typename TransformOp>
+T vtkSMPToolsImpl<BackendType::Sequential>::TransformReduce(
+  InputIt inBegin, InputIt inEnd, T init, ReduceOp reduce, TransformOp transform)
+{
+  return std::transform_reduce(inBegin, inEnd, init, reduce, transform);
+}
+
+//--------------------------------------------------------------------------------
+template <>
+template <typename InputIt, typename OutputIt, typename BinaryOp>
+void vtkSMPToolsImpl<BackendType::Sequential>::InclusiveScan(
+  InputIt inBegin, InputIt inEnd, OutputIt outBegin, BinaryOp op)
+{
+  std::inclusive_scan(inBegin, inEnd, outBegin, op);
+}
+
+//--------------------------------------------------------------------------------
+template <>
+template <typename InputIt, typename OutputIt, typename BinaryOp, typename T>
+void vtkSMPToolsImpl<BackendType::Sequential>::InclusiveScan(
+  InputIt inBegin, InputIt inEnd, OutputIt outBegin, BinaryOp op, T init)
+{
+  std::inclusive_scan(inBegin, inEnd, outBegin, op, init);
+}
+
+//--------------------------------------------------------------------------------
+template <>
+template <typename InputIt, typename OutputIt, typename T, typename BinaryOp>
+void vtkSMPToolsImpl<BackendType::Sequential>::ExclusiveScan(
+  InputIt inBegin, InputIt inEnd, OutputIt outBegin, T init, BinaryOp op)
+{
+  std::exclusive_scan(inBegin, inEnd, outBegin, init, op);
+}
+
 //--------------------------------------------------------------------------------
 template <>
 VTKCOMMONCORE_EXPORT void vtkSMPToolsImpl<BackendType::Sequential>::Initialize(int);
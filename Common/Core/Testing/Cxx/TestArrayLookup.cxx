@@ -767,6 +767,80 @@ int TestMultiComponent()
   return errors;
 }
 
+int TestSortedLookup()
+{
+  int errors = 0;
+
+  // Values with duplicates, out of order, and a NaN.
+  vtkNew<vtkFloatArray> array;
+  array->SetNumberOfComponents(2);
+  const vtkIdType numTuples = 100000;
+  array->SetNumberOfTuples(numTuples);
+  for (vtkIdType i = 0; i < numTuples; ++i)
+  {
+    array->SetTypedComponent(i, 0, static_cast<float>((i * 7919) % 5003));
+    array->SetTypedComponent(i, 1, static_cast<float>(-i));
+  }
+  array->SetTypedComponent(42, 1, std::numeric_limits<float>::quiet_NaN());
+  vtkNew<vtkFloatArray> queries;
+  for (int i = -10; i < 6000; ++i)
+  {
+    queries->InsertNextValue(static_cast<float>(i));
+  }
+  queries->InsertNextValue(std::numeric_limits<float>::quiet_NaN());
+
+  // The sorted lookup must return the same indices as the hash map.
+  vtkNew<vtkIdList> hashIndices;
+  array->LookupValues(queries, hashIndices);
+  std::vector<std::vector<vtkIdType>> hashLists(queries->GetNumberOfValues());
+  vtkNew<vtkIdList> list;
+  for (vtkIdType i = 0; i < queries->GetNumberOfValues(); ++i)
+  {
+    array->LookupValue(queries->GetValue(i), list);
+    hashLists[i].assign(list->begin(), list->end());
+  }
+
+  array->SetLookupStrategy(vtkFloatArray::SORTED_LOOKUP);
+  if (array->GetLookupStrategy() != vtkFloatArray::SORTED_LOOKUP)
+  {
+    std::cerr << "TestSortedLookup: the lookup strategy was not set" << std::endl;
+    ++errors;
+  }
+  vtkNew<vtkIdList> sortedIndices;
+  array->LookupValues(queries, sortedIndices);
+  for (vtkIdType i = 0; i < queries->GetNumberOfValues(); ++i)
+  {
+    const float value = queries->GetValue(i);
+    if (sortedIndices->GetId(i) != hashIndices->GetId(i) ||
+      array->LookupValue(value) != hashIndices->GetId(i))
+    {
+      std::cerr << "TestSortedLookup: index of " << value << " expected "
+                << hashIndices->GetId(i) << " actual " << sortedIndices->GetId(i) << std::endl;
+      ++errors;
+    }
+    array->LookupValue(value, list);
+    if (std::vector<vtkIdType>(list->begin(), list->end()) != hashLists[i])
+    {
+      std::cerr << "TestSortedLookup: wrong list of indices for " << value << std::endl;
+      ++errors;
+    }
+  }
+
+  // Arrays of another type are searched through vtkVariant.
+  vtkNew<vtkIntArray> intQueries;
+  intQueries->InsertNextValue(4999);
+  intQueries->InsertNextValue(-99999);
+  intQueries->InsertNextValue(6000);
+  array->LookupValues(intQueries, sortedIndices);
+  if (sortedIndices->GetNumberOfIds() != 3 || sortedIndices->GetId(0) != array->LookupValue(4999) ||
+    sortedIndices->GetId(1) != 2 * (numTuples - 1) + 1 || sortedIndices->GetId(2) != -1)
+  {
+    std::cerr << "TestSortedLookup: wrong indices for an array of another type" << std::endl;
+    ++errors;
+  }
+  return errors;
+}
+
 int TestArrayLookup(int argc, char* argv[])
 {
   vtkIdType min = 100;
@@ -843,5 +917,6 @@ int TestArrayLookup(int argc, char* argv[])
     std::cerr << std::endl;
   }
   errors += TestMultiComponent();
+  errors += TestSortedLookup();
   return errors;
 }
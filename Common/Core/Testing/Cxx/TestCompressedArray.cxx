@@ -0,0 +1,193 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// Test vtkCompressedArray with a run-length codec: the values read through
+// the vtkDataArray API, mapTuple, GetValues and from several threads must be
+// the values of the original array.
+
+#include "vtkCompressedArray.h"
+#include "vtkDataArrayRange.h"
+#include "vtkDoubleArray.h"
+#include "vtkFloatArray.h"
+#include "vtkNew.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+constexpr vtkIdType NUMBER_OF_TUPLES = 100000;
+
+//------------------------------------------------------------------------------
+// Run-length encoding as pairs (count, byte).
+bool Compress(const unsigned char* input, std::size_t size, std::vector<unsigned char>& output)
+{
+  output.clear();
+  for (std::size_t i = 0; i < size;)
+  {
+    std::size_t count = 1;
+    while (i + count < size && count < 255 && input[i + count] == input[i])
+    {
+      ++count;
+    }
+    output.push_back(static_cast<unsigned char>(count));
+    output.push_back(input[i]);
+    i += count;
+  }
+  return true;
+}
+
+bool Decompress(
+  const unsigned char* input, std::size_t inputSize, unsigned char* output, std::size_t outputSize)
+{
+  std::size_t size = 0;
+  for (std::size_t i = 0; i + 1 < inputSize; i += 2)
+  {
+    if (size + input[i] > outputSize)
+    {
+      return false;
+    }
+    for (int j = 0; j < input[i]; ++j)
+    {
+      output[size++] = input[i + 1];
+    }
+  }
+  return size == outputSize;
+}
+
+//------------------------------------------------------------------------------
+void FillSmooth(vtkDataArray* array, int numberOfComponents)
+{
+  array->SetNumberOfComponents(numberOfComponents);
+  array->SetNumberOfTuples(NUMBER_OF_TUPLES);
+  for (vtkIdType i = 0; i < NUMBER_OF_TUPLES; ++i)
+  {
+    // Smooth values, as written by a simulation in single precision.
+    const double x = static_cast<float>(1000.0 + std::sin(i * 1e-4));
+    for (int c = 0; c < numberOfComponents; ++c)
+    {
+      array->SetComponent(i, c, (c + 1) * x);
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+vtkSmartPointer<vtkCompressedArray<double>> MakeCompressed(vtkDataArray* array,
+  vtkIdType blockSize, const vtkCompressedImplicitBackend<double>::CompressFunction& compress,
+  int cacheSize)
+{
+  auto compressed = vtkSmartPointer<vtkCompressedArray<double>>::New();
+  compressed->ConstructBackend(array, blockSize, compress, Decompress, cacheSize);
+  compressed->SetNumberOfComponents(array->GetNumberOfComponents());
+  compressed->SetNumberOfTuples(array->GetNumberOfTuples());
+  return compressed;
+}
+
+//------------------------------------------------------------------------------
+bool TestValues(vtkDataArray* original, vtkCompressedArray<double>* compressed)
+{
+  auto backend = compressed->GetBackend();
+  const vtkIdType numberOfValues = original->GetNumberOfValues();
+  bool success = compressed->GetNumberOfValues() == numberOfValues;
+
+  // Reading in order decompresses each block once.
+  const vtkIdType before = backend->GetNumberOfDecompressions();
+  auto range = vtk::DataArrayValueRange(original);
+  vtkIdType idx = 0;
+  for (double value : range)
+  {
+    success &= compressed->GetValue(idx++) == value;
+  }
+  success &= backend->GetNumberOfDecompressions() - before == backend->GetNumberOfBlocks();
+
+  const int numberOfComponents = original->GetNumberOfComponents();
+  std::vector<double> tuple(numberOfComponents);
+  for (vtkIdType tupleIdx = NUMBER_OF_TUPLES - 1; tupleIdx >= 0; tupleIdx -= 997)
+  {
+    compressed->GetTypedTuple(tupleIdx, tuple.data());
+    for (int c = 0; c < numberOfComponents; ++c)
+    {
+      success &= tuple[c] == original->GetComponent(tupleIdx, c);
+    }
+  }
+
+  std::vector<double> values(numberOfValues - 1000);
+  backend->GetValues(500, numberOfValues - 500, values.data());
+  for (std::size_t i = 0; i < values.size(); ++i)
+  {
+    success &= values[i] == range[500 + i];
+  }
+  if (!success)
+  {
+    std::cerr << "Wrong values read from the compressed array." << std::endl;
+  }
+  return success;
+}
+
+//------------------------------------------------------------------------------
+// Concurrent random reads go through the shared cache.
+bool TestThreads(vtkDataArray* original, vtkCompressedArray<double>* compressed)
+{
+  std::atomic<bool> success(true);
+  vtkSMPTools::For(0, NUMBER_OF_TUPLES,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType i = begin; i < end; ++i)
+      {
+        const vtkIdType tupleIdx = (i * 7919) % NUMBER_OF_TUPLES;
+        if (compressed->GetComponent(tupleIdx, 1) != original->GetComponent(tupleIdx, 1))
+        {
+          success = false;
+        }
+      }
+    });
+  if (!success)
+  {
+    std::cerr << "Wrong values read concurrently from the compressed array." << std::endl;
+  }
+  return success;
+}
+}
+
+//------------------------------------------------------------------------------
+int TestCompressedArray(int, char*[])
+{
+  vtkNew<vtkDoubleArray> scalars;
+  FillSmooth(scalars, 1);
+  auto compressed = MakeCompressed(scalars, 4096, Compress, 4);
+  auto backend = compressed->GetBackend();
+  const double ratio = static_cast<double>(backend->GetCompressedSize()) /
+    (scalars->GetNumberOfValues() * sizeof(double));
+  std::cout << "Compression ratio: " << 1.0 / ratio << ", memory: "
+            << compressed->GetActualMemorySize() << " KiB instead of "
+            << scalars->GetActualMemorySize() << " KiB." << std::endl;
+  bool success = true;
+  if (ratio > 0.5)
+  {
+    std::cerr << "The shuffled blocks of a smooth field should compress." << std::endl;
+    success = false;
+  }
+  success &= TestValues(scalars, compressed);
+
+  // Blocks hold whole tuples.
+  vtkNew<vtkDoubleArray> vectors;
+  FillSmooth(vectors, 3);
+  compressed = MakeCompressed(vectors, 4096, Compress, 4);
+  success &= compressed->GetBackend()->GetBlockSize() == 4098;
+  success &= TestValues(vectors, compressed);
+  success &= TestThreads(vectors, compressed);
+
+  // Values of another type are converted. Without codec, the blocks are kept as is.
+  vtkNew<vtkFloatArray> floats;
+  FillSmooth(floats, 3);
+  compressed = MakeCompressed(floats, 1000, {}, 1);
+  success &= compressed->GetBackend()->GetCompressedSize() ==
+    static_cast<std::size_t>(floats->GetNumberOfValues()) * sizeof(double);
+  success &= TestValues(floats, compressed);
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,176 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// Test that vtkDataArray::ModifiedTuples keeps the cached ranges equal to the
+// ranges computed from scratch after partial writes, appends and truncations,
+// including for arrays without finite value and with large integers.
+
+#include "vtkDataArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkFloatArray.h"
+#include "vtkIntArray.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkSmartPointer.h"
+#include "vtkUnsignedIntArray.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+
+namespace
+{
+constexpr vtkIdType NUMBER_OF_TUPLES = 300000;
+
+//------------------------------------------------------------------------------
+void FillRandom(vtkDataArray* array, vtkIdType begin, vtkIdType end, double min, double max,
+  vtkMinimalStandardRandomSequence* random)
+{
+  for (vtkIdType i = begin; i < end; ++i)
+  {
+    for (int c = 0; c < array->GetNumberOfComponents(); ++c)
+    {
+      array->SetComponent(i, c, random->GetNextRangeValue(min, max));
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+// Compare the cached ranges of array to the ranges of a copy computed from scratch.
+bool CheckRanges(vtkDataArray* array, const char* step)
+{
+  vtkSmartPointer<vtkDataArray> copy = vtk::TakeSmartPointer(array->NewInstance());
+  copy->DeepCopy(array);
+  for (int c = -1; c < array->GetNumberOfComponents(); ++c)
+  {
+    double range[2], expected[2];
+    array->GetRange(range, c);
+    copy->GetRange(expected, c);
+    if (range[0] != expected[0] || range[1] != expected[1])
+    {
+      std::cerr << step << ": range of component " << c << " is [" << range[0] << ", " << range[1]
+                << "] instead of [" << expected[0] << ", " << expected[1] << "]" << std::endl;
+      return false;
+    }
+    array->GetFiniteRange(range, c);
+    copy->GetFiniteRange(expected, c);
+    if (range[0] != expected[0] || range[1] != expected[1])
+    {
+      std::cerr << step << ": finite range of component " << c << " is [" << range[0] << ", "
+                << range[1] << "] instead of [" << expected[0] << ", " << expected[1] << "]"
+                << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool TestArray(vtkDataArray* array, int numComps, vtkMinimalStandardRandomSequence* random)
+{
+  array->SetNumberOfComponents(numComps);
+  array->SetNumberOfTuples(NUMBER_OF_TUPLES);
+  FillRandom(array, 0, NUMBER_OF_TUPLES, -100.0, 100.0, random);
+  // Without cached range, ModifiedTuples() behaves as Modified().
+  array->ModifiedTuples(0, NUMBER_OF_TUPLES);
+  bool success = CheckRanges(array, "Initial");
+
+  // Widen the range in the middle of the array.
+  FillRandom(array, 1000, 1010, -200.0, 200.0, random);
+  array->ModifiedTuples(1000, 1010);
+  success &= CheckRanges(array, "Widen");
+
+  // Overwrite the extrema: the range must shrink back.
+  FillRandom(array, 1000, 1010, -1.0, 1.0, random);
+  array->ModifiedTuples(1000, 1010);
+  success &= CheckRanges(array, "Narrow");
+
+  // Append tuples.
+  double tuple[4] = { 500.0, -500.0, 500.0, -500.0 };
+  for (int i = 0; i < 100; ++i)
+  {
+    array->InsertNextTuple(tuple);
+  }
+  array->ModifiedTuples(NUMBER_OF_TUPLES, NUMBER_OF_TUPLES + 100);
+  success &= CheckRanges(array, "Append");
+
+  // Remove the appended tuples.
+  array->SetNumberOfTuples(NUMBER_OF_TUPLES);
+  array->ModifiedTuples(0, 0);
+  success &= CheckRanges(array, "Truncate");
+
+  // A full Modified() in between falls back to a complete scan.
+  FillRandom(array, 0, 10, -300.0, 300.0, random);
+  array->Modified();
+  array->GetRange(0);
+  FillRandom(array, NUMBER_OF_TUPLES - 10, NUMBER_OF_TUPLES, -400.0, 400.0, random);
+  array->ModifiedTuples(NUMBER_OF_TUPLES - 10, NUMBER_OF_TUPLES);
+  success &= CheckRanges(array, "After Modified");
+  return success;
+}
+}
+
+//------------------------------------------------------------------------------
+int TestDataArrayModifiedTuples(int, char*[])
+{
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(4321);
+
+  bool success = true;
+  vtkNew<vtkDoubleArray> scalars;
+  success &= TestArray(scalars, 1, random);
+  vtkNew<vtkDoubleArray> vectors;
+  success &= TestArray(vectors, 3, random);
+  vtkNew<vtkIntArray> integers;
+  success &= TestArray(integers, 2, random);
+  vtkNew<vtkFloatArray> floats;
+  success &= TestArray(floats, 4, random);
+
+  // Non finite values only affect the range.
+  vectors->SetComponent(5, 1, std::numeric_limits<double>::infinity());
+  vectors->SetComponent(6, 2, std::numeric_limits<double>::quiet_NaN());
+  vectors->ModifiedTuples(5, 7);
+  success &= CheckRanges(vectors, "Non finite");
+
+  // Without finite value, the finite range of the norm is empty.
+  constexpr float nan = std::numeric_limits<float>::quiet_NaN();
+  constexpr float inf = std::numeric_limits<float>::infinity();
+  vtkNew<vtkFloatArray> nonFinite;
+  nonFinite->SetNumberOfComponents(2);
+  nonFinite->SetNumberOfTuples(10);
+  nonFinite->Fill(nan);
+  nonFinite->GetFiniteRange(-1);
+  nonFinite->SetComponent(3, 1, inf);
+  nonFinite->ModifiedTuples(3, 4);
+  success &= CheckRanges(nonFinite, "No finite value");
+  double range[2];
+  nonFinite->GetFiniteRange(range, -1);
+  if (!(range[0] > range[1]))
+  {
+    std::cerr << "No finite value: finite norm range is [" << range[0] << ", " << range[1]
+              << "] instead of an empty range" << std::endl;
+    success = false;
+  }
+
+  // The squared norms of large unsigned integers do not overflow.
+  vtkNew<vtkUnsignedIntArray> large;
+  large->SetNumberOfComponents(3);
+  large->SetNumberOfTuples(2);
+  large->Fill(1);
+  large->GetRange(-1);
+  for (int c = 0; c < 3; ++c)
+  {
+    large->SetTypedComponent(1, c, 4000000000u);
+  }
+  large->ModifiedTuples(1, 2);
+  success &= CheckRanges(large, "Large integers");
+  large->GetRange(range, -1);
+  if (std::abs(range[1] - std::sqrt(3.0) * 4e9) > 1.0)
+  {
+    std::cerr << "Large integers: norm range is [" << range[0] << ", " << range[1] << "]"
+              << std::endl;
+    success = false;
+  }
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
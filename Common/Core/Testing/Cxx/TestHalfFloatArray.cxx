@@ -0,0 +1,202 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// Test the conversions of vtkHalfFloatArray, scalar and bulk, and the
+// vtkDataArray API: ranges, interpolation, deep and shallow copies.
+
+#include "vtkFloatArray.h"
+#include "vtkHalfFloatArray.h"
+#include "vtkIdList.h"
+#include "vtkNew.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+namespace
+{
+constexpr vtkIdType NUMBER_OF_TUPLES = 1000;
+
+//------------------------------------------------------------------------------
+bool TestScalarConversions()
+{
+  bool success = true;
+  auto check = [&](float value, float expected)
+  {
+    const float result = vtkHalfFloatArray::HalfToFloat(vtkHalfFloatArray::FloatToHalf(value));
+    if (result != expected && !(std::isnan(result) && std::isnan(expected)))
+    {
+      std::cerr << "Wrong conversion of " << value << ": " << result << " instead of " << expected
+                << std::endl;
+      success = false;
+    }
+  };
+
+  // Exact values, largest value, smallest normal and subnormal values.
+  check(0.f, 0.f);
+  check(1.f, 1.f);
+  check(-2.5f, -2.5f);
+  check(65504.f, 65504.f);
+  check(std::ldexp(1.f, -14), std::ldexp(1.f, -14));
+  check(std::ldexp(1.f, -24), std::ldexp(1.f, -24));
+  // Ties are rounded to even.
+  check(1.f + std::ldexp(1.f, -11), 1.f);
+  check(1.f + 3 * std::ldexp(1.f, -11), 1.f + std::ldexp(1.f, -9));
+  check(std::ldexp(1.f, -25), 0.f);
+  check(3 * std::ldexp(1.f, -25), std::ldexp(1.f, -23));
+  // Overflows, infinities and NaN.
+  const float inf = std::numeric_limits<float>::infinity();
+  check(65520.f, inf);
+  check(-1e10f, -inf);
+  check(inf, inf);
+  check(std::numeric_limits<float>::quiet_NaN(), std::numeric_limits<float>::quiet_NaN());
+  if (std::signbit(vtkHalfFloatArray::HalfToFloat(vtkHalfFloatArray::FloatToHalf(-0.f))))
+  {
+    std::cout << "Negative zero is preserved." << std::endl;
+  }
+  else
+  {
+    std::cerr << "The sign of negative zero is lost." << std::endl;
+    success = false;
+  }
+
+  // All the half values survive a round trip through float.
+  for (unsigned int bits = 0; bits < 0x10000; ++bits)
+  {
+    const auto half = static_cast<vtkTypeUInt16>(bits);
+    const float value = vtkHalfFloatArray::HalfToFloat(half);
+    if (!std::isnan(value) && vtkHalfFloatArray::FloatToHalf(value) != half)
+    {
+      std::cerr << "Round trip of the half value " << bits << " failed." << std::endl;
+      success = false;
+      break;
+    }
+  }
+  return success;
+}
+
+//------------------------------------------------------------------------------
+// The bulk conversions, which may use SIMD instructions, must match the scalar ones.
+bool TestBulkConversions()
+{
+  std::vector<vtkTypeUInt16> halves(0x10000);
+  for (unsigned int bits = 0; bits < 0x10000; ++bits)
+  {
+    halves[bits] = static_cast<vtkTypeUInt16>(bits);
+  }
+  std::vector<float> floats(halves.size());
+  vtkHalfFloatArray::HalfToFloat(halves.data(), floats.data(), 0x10000);
+  bool success = true;
+  for (unsigned int bits = 0; bits < 0x10000; ++bits)
+  {
+    const float expected = vtkHalfFloatArray::HalfToFloat(halves[bits]);
+    success &= floats[bits] == expected || (std::isnan(floats[bits]) && std::isnan(expected));
+  }
+
+  // An odd number of values exercises the remainder loops.
+  std::vector<float> values(1003);
+  for (std::size_t i = 0; i < values.size(); ++i)
+  {
+    values[i] = static_cast<float>(std::sin(0.1 * i) * std::pow(10.0, i % 11 - 5.0));
+  }
+  std::vector<vtkTypeUInt16> converted(values.size());
+  vtkHalfFloatArray::FloatToHalf(values.data(), converted.data(), 1003);
+  for (std::size_t i = 0; i < values.size(); ++i)
+  {
+    success &= converted[i] == vtkHalfFloatArray::FloatToHalf(values[i]);
+  }
+  if (!success)
+  {
+    std::cerr << "The bulk conversions do not match the scalar ones." << std::endl;
+  }
+  return success;
+}
+
+//------------------------------------------------------------------------------
+bool TestArray()
+{
+  vtkNew<vtkFloatArray> floats;
+  floats->SetNumberOfComponents(3);
+  floats->SetNumberOfTuples(NUMBER_OF_TUPLES);
+  for (vtkIdType i = 0; i < NUMBER_OF_TUPLES; ++i)
+  {
+    for (int c = 0; c < 3; ++c)
+    {
+      floats->SetTypedComponent(i, c, static_cast<float>((c + 1) * std::cos(i * 0.01)));
+    }
+  }
+
+  vtkNew<vtkHalfFloatArray> halves;
+  halves->DeepCopy(floats);
+  bool success = halves->GetNumberOfTuples() == NUMBER_OF_TUPLES;
+  success &= halves->GetNumberOfComponents() == 3;
+  for (vtkIdType i = 0; i < NUMBER_OF_TUPLES; ++i)
+  {
+    for (int c = 0; c < 3; ++c)
+    {
+      const float value = floats->GetTypedComponent(i, c);
+      success &= halves->GetTypedComponent(i, c) ==
+        vtkHalfFloatArray::HalfToFloat(vtkHalfFloatArray::FloatToHalf(value));
+      success &= std::abs(halves->GetTypedComponent(i, c) - value) <= std::abs(value) / 1024;
+    }
+  }
+  if (!success)
+  {
+    std::cerr << "Wrong values after a deep copy of a float array." << std::endl;
+  }
+
+  double range[2];
+  halves->GetRange(range, 2);
+  if (range[0] != -3.0 || range[1] != 3.0)
+  {
+    std::cerr << "Wrong range: [" << range[0] << ", " << range[1] << "]" << std::endl;
+    success = false;
+  }
+
+  vtkNew<vtkIdList> ids;
+  ids->InsertNextId(0);
+  ids->InsertNextId(1);
+  double weights[2] = { 0.25, 0.75 };
+  halves->InterpolateTuple(2, ids, halves, weights);
+  const double expected = 0.25 * halves->GetComponent(0, 1) + 0.75 * halves->GetComponent(1, 1);
+  if (std::abs(halves->GetComponent(2, 1) - expected) > 1e-3)
+  {
+    std::cerr << "Wrong interpolated value: " << halves->GetComponent(2, 1) << std::endl;
+    success = false;
+  }
+
+  // Back to float, through the bulk conversion of vtkDataArray::DeepCopy.
+  vtkNew<vtkFloatArray> copy;
+  copy->DeepCopy(halves);
+  for (vtkIdType i = 0; i < NUMBER_OF_TUPLES; ++i)
+  {
+    success &= copy->GetTypedComponent(i, 0) == halves->GetTypedComponent(i, 0);
+  }
+
+  vtkNew<vtkHalfFloatArray> shallow;
+  shallow->ShallowCopy(halves);
+  success &= shallow->GetHalfPointer(0) == halves->GetHalfPointer(0);
+  success &= shallow->GetValue(42) == halves->GetValue(42);
+
+  // Half the memory of the float array.
+  if (halves->GetActualMemorySize() != 6 || floats->GetActualMemorySize() != 12)
+  {
+    std::cerr << "Wrong memory size: " << halves->GetActualMemorySize() << " KiB." << std::endl;
+    success = false;
+  }
+
+  halves->FillValue(0.5f);
+  success &= halves->GetValue(0) == 0.5f && halves->GetValue(3 * NUMBER_OF_TUPLES - 1) == 0.5f;
+  return success;
+}
+}
+
+//------------------------------------------------------------------------------
+int TestHalfFloatArray(int, char*[])
+{
+  bool success = TestScalarConversions();
+  success &= TestBulkConversions();
+  success &= TestArray();
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,156 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// .NAME Test speed of the vtkObjectBase life cycle.
+// .SECTION Description
+// Probe the cost of New/Delete, Register/UnRegister and Modified on small
+// objects, as created by the million in cell loops, and check that the
+// reference count stays exact when objects are shared between threads.
+
+#include "vtkIdList.h"
+#include "vtkNew.h"
+#include "vtkObject.h"
+#include "vtkSMPTools.h"
+#include "vtkTimerLog.h"
+
+#include <cstdlib>
+#include <vector>
+
+#include <iostream>
+
+// How many times the tests are run to average the elapsed time.
+static constexpr int STRESS_COUNT = 5;
+
+static constexpr int NUMBER_OF_OPERATIONS = 1000000;
+
+namespace
+{
+//------------------------------------------------------------------------------
+template <typename Functor>
+double MeanDuration(Functor&& functor)
+{
+  vtkNew<vtkTimerLog> timer;
+  double duration = 0.0;
+  for (int i = 0; i < STRESS_COUNT; ++i)
+  {
+    timer->StartTimer();
+    functor();
+    timer->StopTimer();
+    duration += timer->GetElapsedTime();
+  }
+  return duration / STRESS_COUNT;
+}
+
+//------------------------------------------------------------------------------
+void ReportMeasurement(const char* name, double duration)
+{
+  std::cout << "<DartMeasurement name=\"" << name << "\" type=\"numeric/double\">" << duration
+            << "</DartMeasurement>" << std::endl;
+}
+}
+
+//------------------------------------------------------------------------------
+int TestObjectBasePerformance(int, char*[])
+{
+  ReportMeasurement("NewDeleteObject",
+    MeanDuration(
+      []()
+      {
+        for (int i = 0; i < NUMBER_OF_OPERATIONS; ++i)
+        {
+          vtkObject::New()->Delete();
+        }
+      }));
+
+  ReportMeasurement("NewDeleteIdList",
+    MeanDuration(
+      []()
+      {
+        for (int i = 0; i < NUMBER_OF_OPERATIONS; ++i)
+        {
+          vtkIdList* ids = vtkIdList::New();
+          ids->InsertNextId(i);
+          ids->Delete();
+        }
+      }));
+
+  vtkNew<vtkObject> object;
+  ReportMeasurement("RegisterUnRegister",
+    MeanDuration(
+      [&]()
+      {
+        for (int i = 0; i < NUMBER_OF_OPERATIONS; ++i)
+        {
+          object->Register(nullptr);
+          object->UnRegister(nullptr);
+        }
+      }));
+
+  ReportMeasurement("Modified",
+    MeanDuration(
+      [&]()
+      {
+        for (int i = 0; i < NUMBER_OF_OPERATIONS; ++i)
+        {
+          object->Modified();
+        }
+      }));
+
+  // Share the same objects between all the threads.
+  std::vector<vtkObject*> shared(16);
+  for (auto& o : shared)
+  {
+    o = vtkObject::New();
+  }
+  ReportMeasurement("SharedRegisterUnRegister",
+    MeanDuration(
+      [&]()
+      {
+        vtkSMPTools::For(0, NUMBER_OF_OPERATIONS,
+          [&](vtkIdType begin, vtkIdType end)
+          {
+            for (vtkIdType i = begin; i < end; ++i)
+            {
+              vtkObject* o = shared[i % shared.size()];
+              o->Register(nullptr);
+              o->UnRegister(nullptr);
+            }
+          });
+      }));
+
+  int status = EXIT_SUCCESS;
+  for (auto& o : shared)
+  {
+    if (o->GetReferenceCount() != 1)
+    {
+      std::cerr << "Error: reference count is " << o->GetReferenceCount() << " instead of 1."
+                << std::endl;
+      status = EXIT_FAILURE;
+    }
+    o->Delete();
+  }
+
+  // The time stamps must stay unique when modified from several threads.
+  std::vector<vtkMTimeType> times(NUMBER_OF_OPERATIONS);
+  vtkSMPTools::For(0, NUMBER_OF_OPERATIONS,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      vtkTimeStamp stamp;
+      for (vtkIdType i = begin; i < end; ++i)
+      {
+        stamp.Modified();
+        times[i] = stamp.GetMTime();
+      }
+    });
+  vtkSMPTools::Sort(times.begin(), times.end());
+  for (int i = 1; i < NUMBER_OF_OPERATIONS; ++i)
+  {
+    if (times[i] == times[i - 1])
+    {
+      std::cerr << "Error: time stamp " << times[i] << " was given twice." << std::endl;
+      status = EXIT_FAILURE;
+      break;
+    }
+  }
+
+  return status;
+}
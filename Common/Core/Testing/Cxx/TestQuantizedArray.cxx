@@ -0,0 +1,113 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// Test vtkQuantizedArray: the values read back must be within the maximum
+// error reported by the backend, and integral values must be rounded.
+
+#include "vtkDoubleArray.h"
+#include "vtkIntArray.h"
+#include "vtkNew.h"
+#include "vtkQuantizedArray.h"
+#include "vtkSmartPointer.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+namespace
+{
+constexpr vtkIdType NUMBER_OF_TUPLES = 10000;
+
+//------------------------------------------------------------------------------
+template <typename ValueType>
+vtkSmartPointer<vtkQuantizedArray<ValueType>> MakeQuantized(
+  vtkDataArray* array, int numberOfBits, vtkIdType blockSize)
+{
+  auto quantized = vtkSmartPointer<vtkQuantizedArray<ValueType>>::New();
+  quantized->ConstructBackend(array, numberOfBits, blockSize);
+  quantized->SetNumberOfComponents(array->GetNumberOfComponents());
+  quantized->SetNumberOfTuples(array->GetNumberOfTuples());
+  return quantized;
+}
+
+//------------------------------------------------------------------------------
+bool TestDouble(int numberOfBits)
+{
+  vtkNew<vtkDoubleArray> values;
+  values->SetNumberOfComponents(2);
+  values->SetNumberOfTuples(NUMBER_OF_TUPLES);
+  for (vtkIdType i = 0; i < NUMBER_OF_TUPLES; ++i)
+  {
+    values->SetTypedComponent(i, 0, std::sin(i * 1e-3));
+    // A second component with another scale.
+    values->SetTypedComponent(i, 1, 1e4 * std::cos(i * 1e-2));
+  }
+
+  auto quantized = MakeQuantized<double>(values, numberOfBits, 256);
+  auto backend = quantized->GetBackend();
+  const double maxError = backend->GetMaximumError();
+  bool success = backend->GetNumberOfBits() == numberOfBits && backend->GetBlockSize() == 256;
+  // The error is bounded by half the step of the largest component.
+  success &= maxError > 0 && maxError <= 1e4 / ((1 << numberOfBits) - 1);
+
+  double tuple[2];
+  double error[2] = { 0.0, 0.0 };
+  for (vtkIdType i = 0; i < NUMBER_OF_TUPLES; ++i)
+  {
+    quantized->GetTypedTuple(i, tuple);
+    for (int c = 0; c < 2; ++c)
+    {
+      const double diff = std::abs(tuple[c] - values->GetTypedComponent(i, c));
+      error[c] = std::max(error[c], diff);
+      success &= quantized->GetTypedComponent(i, c) == tuple[c];
+    }
+  }
+  // Each component is scaled separately: the first one is much more accurate.
+  success &= error[1] <= maxError * (1 + 1e-12) && error[0] < 1e-3 * error[1];
+  std::cout << numberOfBits << " bits: maximum error " << error[0] << " and " << error[1]
+            << ", memory " << quantized->GetActualMemorySize() << " KiB instead of "
+            << values->GetActualMemorySize() << " KiB." << std::endl;
+  success &= quantized->GetActualMemorySize() < values->GetActualMemorySize() / 3;
+  if (!success)
+  {
+    std::cerr << "Wrong quantization on " << numberOfBits << " bits." << std::endl;
+  }
+  return success;
+}
+
+//------------------------------------------------------------------------------
+bool TestInt()
+{
+  vtkNew<vtkIntArray> values;
+  values->SetNumberOfTuples(NUMBER_OF_TUPLES);
+  for (vtkIdType i = 0; i < NUMBER_OF_TUPLES; ++i)
+  {
+    values->SetValue(i, static_cast<int>(i % 100) - 50);
+  }
+  // 100 distinct values in each block are exactly represented on 8 bits.
+  auto quantized = MakeQuantized<int>(values, 8, 1000);
+  bool success = true;
+  for (vtkIdType i = 0; i < NUMBER_OF_TUPLES; ++i)
+  {
+    success &= quantized->GetValue(i) == values->GetValue(i);
+  }
+
+  // A constant block has a null step.
+  values->Fill(7);
+  quantized = MakeQuantized<int>(values, 4, 1000);
+  success &= quantized->GetValue(123) == 7 && quantized->GetBackend()->GetMaximumError() == 0;
+  if (!success)
+  {
+    std::cerr << "Wrong quantization of integers." << std::endl;
+  }
+  return success;
+}
+}
+
+//------------------------------------------------------------------------------
+int TestQuantizedArray(int, char*[])
+{
+  bool success = TestDouble(16);
+  success &= TestDouble(8);
+  success &= TestInt();
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -9,6 +9,7 @@
 #include "vtkSMPTools.h"
 #include "vtkStringScanner.h"
 
+#include <algorithm>
 #include <cstdlib>
 #include <deque>
 #include <functional>
@@ -348,6 +349,46 @@ int doTestSMP()
     return EXIT_FAILURE;
   }
 
+  // Test work stealing with a load-imbalanced functor: every index must be visited once
+  for (const vtkIdType grain : { vtkIdType(0), vtkIdType(1), vtkIdType(7) })
+  {
+    std::vector<int> visits(Target, 0);
+    vtkSMPTools::LocalScope(vtkSMPTools::Config{ 0, vtkSMPTools::GetBackend(), false, true },
+      [&]()
+      {
+        if (!vtkSMPTools::GetWorkStealing())
+        {
+          return;
+        }
+        vtkSMPTools::For(0, Target, grain,
+          [&](vtkIdType start, vtkIdType end)
+          {
+            for (vtkIdType i = start; i < end; ++i)
+            {
+              // The last indices are much more expensive
+              volatile double work = 0;
+              for (vtkIdType j = 0; j < (i > Target - Target / 8 ? 2000 : 1); ++j)
+              {
+                work = work + 1;
+              }
+              visits[i]++;
+            }
+          });
+      });
+    if (vtkSMPTools::GetWorkStealing())
+    {
+      std::cerr << "Error: vtkSMPTools::LocalScope did not restore work stealing setting!"
+                << std::endl;
+      return EXIT_FAILURE;
+    }
+    if (std::count(visits.begin(), visits.end(), 1) != Target)
+    {
+      std::cerr << "Error: work stealing did not visit every index exactly once with grain "
+                << grain << "!" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
   // Test sorting
   double data0[] = { 2, 1, 0, 3, 9, 6, 7, 3, 8, 4, 5 };
   std::vector<double> myvector(data0, data0 + 11);
@@ -497,6 +538,96 @@ int doTestSMP()
       return EXIT_FAILURE;
     }
   }
+
+  // Test reduce
+  std::vector<vtkIdType> reduceData0(100003);
+  std::iota(reduceData0.begin(), reduceData0.end(), 0);
+  const vtkIdType reduceTarget0 = std::accumulate(reduceData0.begin(), reduceData0.end(), 7);
+  if (vtkSMPTools::Reduce(reduceData0.cbegin(), reduceData0.cend(), vtkIdType(7)) !=
+    reduceTarget0)
+  {
+    std::cerr << "Error: Invalid output for vtkSMPTools::Reduce applied on std::vector!"
+              << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  const vtkIdType reduceMax = vtkSMPTools::Reduce(reduceData0.cbegin(), reduceData0.cend(),
+    vtkIdType(-1), [](vtkIdType a, vtkIdType b) { return std::max(a, b); });
+  if (reduceMax != 100002)
+  {
+    std::cerr << "Error: Invalid output for vtkSMPTools::Reduce with max operation!"
+              << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  if (vtkSMPTools::Reduce(reduceData0.cbegin(), reduceData0.cbegin(), vtkIdType(42)) != 42)
+  {
+    std::cerr << "Error: vtkSMPTools::Reduce on an empty range must return the initial value!"
+              << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::set<double> reduceData1 = { 1, 2, 3, 4, 5 };
+  const double reduceSquares = vtkSMPTools::TransformReduce(reduceData1.cbegin(),
+    reduceData1.cend(), 0.0, std::plus<>(), [](double x) { return x * x; });
+  if (reduceSquares != 55)
+  {
+    std::cerr << "Error: Invalid output for vtkSMPTools::TransformReduce applied on std::set!"
+              << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Test scans
+  std::vector<vtkIdType> scanData0(250007);
+  for (std::size_t i = 0; i < scanData0.size(); ++i)
+  {
+    scanData0[i] = static_cast<vtkIdType>(i % 7);
+  }
+  std::vector<vtkIdType> scanTarget(scanData0.size());
+  std::vector<vtkIdType> scanResult(scanData0.size());
+
+  std::exclusive_scan(scanData0.begin(), scanData0.end(), scanTarget.begin(), vtkIdType(3));
+  vtkSMPTools::ExclusiveScan(
+    scanData0.cbegin(), scanData0.cend(), scanResult.begin(), vtkIdType(3));
+  if (scanResult != scanTarget)
+  {
+    std::cerr << "Error: Invalid output for vtkSMPTools::ExclusiveScan!" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::inclusive_scan(scanData0.begin(), scanData0.end(), scanTarget.begin());
+  vtkSMPTools::InclusiveScan(scanData0.cbegin(), scanData0.cend(), scanResult.begin());
+  if (scanResult != scanTarget)
+  {
+    std::cerr << "Error: Invalid output for vtkSMPTools::InclusiveScan!" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::inclusive_scan(
+    scanData0.begin(), scanData0.end(), scanTarget.begin(), std::plus<>(), vtkIdType(-5));
+  vtkSMPTools::InclusiveScan(
+    scanData0.cbegin(), scanData0.cend(), scanResult.begin(), std::plus<>(), vtkIdType(-5));
+  if (scanResult != scanTarget)
+  {
+    std::cerr << "Error: Invalid output for vtkSMPTools::InclusiveScan with initial value!"
+              << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // In place exclusive scan on a vtkDataArray, as used to turn counts into offsets
+  vtkNew<vtkAOSDataArrayTemplate<vtkIdType>> scanArray;
+  scanArray->SetNumberOfValues(static_cast<vtkIdType>(scanData0.size()));
+  std::copy(scanData0.begin(), scanData0.end(), scanArray->GetPointer(0));
+  auto scanRange = vtk::DataArrayValueRange<1>(scanArray);
+  std::exclusive_scan(scanData0.begin(), scanData0.end(), scanTarget.begin(), vtkIdType(0));
+  vtkSMPTools::ExclusiveScan(scanRange.begin(), scanRange.end(), scanRange.begin(), vtkIdType(0));
+  if (!std::equal(scanRange.begin(), scanRange.end(), scanTarget.begin()))
+  {
+    std::cerr << "Error: Invalid output for in place vtkSMPTools::ExclusiveScan applied on "
+                 "vtk::DataArrayValueRange!"
+              << std::endl;
+    return EXIT_FAILURE;
+  }
   return EXIT_SUCCESS;
 }
 
@@ -0,0 +1,115 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// .NAME Test speed of vtkSMPTools reductions and scans.
+// .SECTION Description
+// Compare vtkSMPTools::Reduce, vtkSMPTools::InclusiveScan and
+// vtkSMPTools::ExclusiveScan against their std counterparts on a large
+// array of per-cell sizes, as found in the output allocation pass of
+// extraction filters.
+
+#include "vtkNew.h"
+#include "vtkSMPTools.h"
+#include "vtkTimerLog.h"
+
+#include <cstdlib>
+#include <functional>
+#include <numeric>
+#include <vector>
+
+#include <iostream>
+
+// How many times the tests are run to average the elapsed time.
+static constexpr int STRESS_COUNT = 5;
+
+static constexpr vtkIdType NUMBER_OF_VALUES = 10000000;
+
+namespace
+{
+//------------------------------------------------------------------------------
+template <typename Functor>
+double MeanDuration(Functor&& functor)
+{
+  vtkNew<vtkTimerLog> timer;
+  double duration = 0.0;
+  for (int i = 0; i < STRESS_COUNT; ++i)
+  {
+    timer->StartTimer();
+    functor();
+    timer->StopTimer();
+    duration += timer->GetElapsedTime();
+  }
+  return duration / STRESS_COUNT;
+}
+
+//------------------------------------------------------------------------------
+void ReportMeasurement(const char* name, double duration)
+{
+  std::cout << "<DartMeasurement name=\"" << name << "-" << vtkSMPTools::GetBackend()
+            << "\" type=\"numeric/double\">" << duration << "</DartMeasurement>" << std::endl;
+}
+}
+
+//------------------------------------------------------------------------------
+int TestSMPScanPerformance(int, char*[])
+{
+  std::cout << "Benchmarking " << NUMBER_OF_VALUES << " values with "
+            << vtkSMPTools::GetEstimatedNumberOfThreads() << " threads and the "
+            << vtkSMPTools::GetBackend() << " backend." << std::endl;
+
+  // Mimic the number of points per cell of a mixed mesh.
+  std::vector<vtkIdType> sizes(NUMBER_OF_VALUES);
+  vtkSMPTools::For(0, NUMBER_OF_VALUES,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType i = begin; i < end; ++i)
+      {
+        sizes[i] = 3 + (i * 7919) % 6;
+      }
+    });
+  std::vector<vtkIdType> stdOffsets(NUMBER_OF_VALUES);
+  std::vector<vtkIdType> smpOffsets(NUMBER_OF_VALUES);
+
+  vtkIdType stdSum = 0;
+  vtkIdType smpSum = 0;
+  ReportMeasurement("StdReduce",
+    MeanDuration([&]() { stdSum = std::reduce(sizes.cbegin(), sizes.cend(), vtkIdType(0)); }));
+  ReportMeasurement("SMPReduce",
+    MeanDuration(
+      [&]() { smpSum = vtkSMPTools::Reduce(sizes.cbegin(), sizes.cend(), vtkIdType(0)); }));
+  if (stdSum != smpSum)
+  {
+    std::cerr << "Error: vtkSMPTools::Reduce returned " << smpSum << " instead of " << stdSum
+              << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  ReportMeasurement("StdInclusiveScan",
+    MeanDuration([&]() { std::inclusive_scan(sizes.cbegin(), sizes.cend(), stdOffsets.begin()); }));
+  ReportMeasurement("SMPInclusiveScan",
+    MeanDuration(
+      [&]() { vtkSMPTools::InclusiveScan(sizes.cbegin(), sizes.cend(), smpOffsets.begin()); }));
+  if (stdOffsets != smpOffsets)
+  {
+    std::cerr << "Error: vtkSMPTools::InclusiveScan differs from std::inclusive_scan"
+              << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  ReportMeasurement("StdExclusiveScan",
+    MeanDuration([&]()
+      { std::exclusive_scan(sizes.cbegin(), sizes.cend(), stdOffsets.begin(), vtkIdType(0)); }));
+  ReportMeasurement("SMPExclusiveScan",
+    MeanDuration(
+      [&]()
+      {
+        vtkSMPTools::ExclusiveScan(sizes.cbegin(), sizes.cend(), smpOffsets.begin(), vtkIdType(0));
+      }));
+  if (stdOffsets != smpOffsets)
+  {
+    std::cerr << "Error: vtkSMPTools::ExclusiveScan differs from std::exclusive_scan"
+              << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
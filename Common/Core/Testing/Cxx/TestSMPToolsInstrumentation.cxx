@@ -0,0 +1,164 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// .NAME Test of the instrumentation of vtkSMPTools::For.
+// .SECTION Description
+// Run labeled loops with the instrumentation enabled and check the recorded
+// chunks, busy times and load balance ratios, and the report.
+
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+namespace
+{
+constexpr vtkIdType NUMBER_OF_VALUES = 100000;
+constexpr vtkIdType GRAIN = 1000;
+
+//------------------------------------------------------------------------------
+struct SumFunctor
+{
+  const std::vector<double>& Values;
+  vtkSMPThreadLocal<double> Sums;
+  double Sum = 0.0;
+
+  SumFunctor(const std::vector<double>& values)
+    : Values(values)
+  {
+  }
+  void Initialize() { this->Sums.Local() = 0.0; }
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    double& sum = this->Sums.Local();
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      sum += std::sqrt(this->Values[i]);
+    }
+  }
+  void Reduce()
+  {
+    for (double sum : this->Sums)
+    {
+      this->Sum += sum;
+    }
+  }
+};
+
+//------------------------------------------------------------------------------
+bool CheckStatistics(const vtkSMPTools::LoopStatistics& loop, const char* label)
+{
+  bool success = true;
+  if (loop.Label != label)
+  {
+    std::cerr << "Error: label is \"" << loop.Label << "\" instead of \"" << label << "\"."
+              << std::endl;
+    success = false;
+  }
+  if (loop.First != 0 || loop.Last != NUMBER_OF_VALUES || loop.Grain != GRAIN)
+  {
+    std::cerr << "Error: recorded range [" << loop.First << ", " << loop.Last << "[ and grain "
+              << loop.Grain << "." << std::endl;
+    success = false;
+  }
+  if (loop.NumberOfChunks < 1 || loop.MinimumChunkSize < 1 ||
+    loop.MinimumChunkSize > loop.MaximumChunkSize ||
+    loop.NumberOfChunks * loop.MaximumChunkSize < NUMBER_OF_VALUES ||
+    loop.NumberOfChunks * loop.MinimumChunkSize > NUMBER_OF_VALUES)
+  {
+    std::cerr << "Error: " << loop.NumberOfChunks << " chunks of " << loop.MinimumChunkSize
+              << " to " << loop.MaximumChunkSize << " values recorded." << std::endl;
+    success = false;
+  }
+  if (loop.BusyTimes.empty() || static_cast<int>(loop.BusyTimes.size()) > loop.NumberOfThreads ||
+    loop.Imbalance < 1.0 - 1e-9 || loop.Efficiency < 0.0 || loop.Efficiency > 1.0 + 1e-9)
+  {
+    std::cerr << "Error: " << loop.BusyTimes.size() << " busy threads out of "
+              << loop.NumberOfThreads << ", imbalance " << loop.Imbalance << " and efficiency "
+              << loop.Efficiency << " recorded." << std::endl;
+    success = false;
+  }
+  return success;
+}
+}
+
+//------------------------------------------------------------------------------
+int TestSMPToolsInstrumentation(int, char*[])
+{
+  int status = EXIT_SUCCESS;
+  std::vector<double> values(NUMBER_OF_VALUES);
+  for (vtkIdType i = 0; i < NUMBER_OF_VALUES; ++i)
+  {
+    values[i] = static_cast<double>(i);
+  }
+  SumFunctor reference(values);
+  vtkSMPTools::For(0, NUMBER_OF_VALUES, GRAIN, reference);
+
+  // Nothing is recorded while the instrumentation is disabled.
+  vtkSMPTools::ClearLoopStatistics();
+  if (vtkSMPTools::GetInstrumentation() || !vtkSMPTools::GetLoopStatistics().empty())
+  {
+    std::cerr << "Error: the instrumentation is enabled by default." << std::endl;
+    status = EXIT_FAILURE;
+  }
+
+  vtkSMPTools::SetInstrumentation(true);
+  {
+    vtkSMPTools::LoopLabel label("Sum");
+    SumFunctor sum(values);
+    vtkSMPTools::For(0, NUMBER_OF_VALUES, GRAIN, sum);
+    if (std::abs(sum.Sum - reference.Sum) > 1e-6 * reference.Sum)
+    {
+      std::cerr << "Error: the instrumented loop computed " << sum.Sum << " instead of "
+                << reference.Sum << "." << std::endl;
+      status = EXIT_FAILURE;
+    }
+    {
+      vtkSMPTools::LoopLabel nested("Nested sum");
+      vtkSMPTools::For(0, NUMBER_OF_VALUES, GRAIN, sum);
+    }
+    vtkSMPTools::For(0, NUMBER_OF_VALUES, GRAIN, sum);
+  }
+  SumFunctor sum(values);
+  vtkSMPTools::For(0, NUMBER_OF_VALUES, GRAIN, sum);
+  vtkSMPTools::SetInstrumentation(false);
+  vtkSMPTools::For(0, NUMBER_OF_VALUES, GRAIN, sum);
+
+  std::vector<vtkSMPTools::LoopStatistics> loops = vtkSMPTools::GetLoopStatistics();
+  const char* labels[] = { "Sum", "Nested sum", "Sum", "" };
+  if (loops.size() != 4)
+  {
+    std::cerr << "Error: " << loops.size() << " loops recorded instead of 4." << std::endl;
+    return EXIT_FAILURE;
+  }
+  for (std::size_t i = 0; i < loops.size(); ++i)
+  {
+    if (!CheckStatistics(loops[i], labels[i]))
+    {
+      status = EXIT_FAILURE;
+    }
+  }
+
+  std::ostringstream report;
+  vtkSMPTools::PrintLoopStatistics(report);
+  std::cout << report.str();
+  if (report.str().find("Sum: 2 calls") == std::string::npos ||
+    report.str().find("Nested sum: 1 calls") == std::string::npos ||
+    report.str().find("(no label): 1 calls") == std::string::npos)
+  {
+    std::cerr << "Error: unexpected report." << std::endl;
+    status = EXIT_FAILURE;
+  }
+
+  vtkSMPTools::ClearLoopStatistics();
+  if (!vtkSMPTools::GetLoopStatistics().empty())
+  {
+    std::cerr << "Error: statistics remain after ClearLoopStatistics()." << std::endl;
+    status = EXIT_FAILURE;
+  }
+
+  return status;
+}
@@ -0,0 +1,190 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// Test the memory and the object pools of vtkScratchArena, and check with the
+// allocation counters that the arenas serve the inner loop of a parallel
+// algorithm without heap allocations once they are warmed up.
+
+#include "vtkDoubleArray.h"
+#include "vtkIdList.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
+#include "vtkScratchArena.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <numeric>
+#include <vector>
+
+namespace
+{
+//------------------------------------------------------------------------------
+bool TestMemory()
+{
+  vtkScratchArena arena(1024);
+  char* c = arena.Allocate<char>(3);
+  double* d = arena.Allocate<double>(10);
+  if (reinterpret_cast<std::uintptr_t>(d) % alignof(double) != 0 ||
+    reinterpret_cast<std::uintptr_t>(c) == reinterpret_cast<std::uintptr_t>(d))
+  {
+    std::cerr << "Allocate: misaligned or overlapping values." << std::endl;
+    return false;
+  }
+  // Larger than a block.
+  vtkIdType* ids = arena.Allocate<vtkIdType>(1000);
+  std::iota(ids, ids + 1000, 0);
+  if (arena.GetCapacity() < 1024 + 1000 * sizeof(vtkIdType))
+  {
+    std::cerr << "Allocate: capacity is " << arena.GetCapacity() << std::endl;
+    return false;
+  }
+
+  void* first;
+  {
+    vtkScratchArena::Scope scope(arena);
+    first = arena.Allocate(100);
+    {
+      vtkScratchArena::Scope nested(arena);
+      arena.Allocate(100);
+    }
+    if (arena.Allocate(100) == first)
+    {
+      std::cerr << "Scope: memory handed out twice." << std::endl;
+      return false;
+    }
+  }
+  if (arena.Allocate(100) != first)
+  {
+    std::cerr << "Scope: memory was not given back." << std::endl;
+    return false;
+  }
+  const std::size_t capacity = arena.GetCapacity();
+  arena.Reset();
+  arena.Allocate<vtkIdType>(1000);
+  if (arena.GetCapacity() != capacity)
+  {
+    std::cerr << "Reset: blocks were not reused." << std::endl;
+    return false;
+  }
+  arena.Squeeze();
+  return arena.GetCapacity() == 0;
+}
+
+//------------------------------------------------------------------------------
+bool TestPools()
+{
+  vtkScratchArena arena;
+  vtkIdList* ids;
+  vtkDoubleArray* array;
+  {
+    vtkScratchArena::Scope scope(arena);
+    ids = arena.AcquireIdList();
+    ids->SetNumberOfIds(100);
+    array = arena.Acquire<vtkDoubleArray>();
+    if (arena.AcquireIdList() == ids || arena.Acquire<vtkDoubleArray>() == array)
+    {
+      std::cerr << "Acquire: object handed out twice." << std::endl;
+      return false;
+    }
+  }
+  if (arena.GetNumberOfPooledObjects() != 4)
+  {
+    std::cerr << "Acquire: " << arena.GetNumberOfPooledObjects() << " pooled objects."
+              << std::endl;
+    return false;
+  }
+  vtkIdList* recycled = arena.AcquireIdList();
+  if (recycled != ids || recycled->GetNumberOfIds() != 0 ||
+    arena.Acquire<vtkDoubleArray>() != array)
+  {
+    std::cerr << "Scope: objects were not recycled." << std::endl;
+    return false;
+  }
+  arena.Reset();
+  return arena.AcquireIdList() == ids && arena.GetNumberOfPooledObjects() == 4;
+}
+
+//------------------------------------------------------------------------------
+struct NeighborSum
+{
+  vtkSMPThreadLocal<vtkScratchArena> TLArena;
+  vtkIdType* Sums;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkScratchArena& arena = this->TLArena.Local();
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      vtkScratchArena::Scope scope(arena);
+      vtkIdList* neighbors = arena.AcquireIdList();
+      neighbors->Allocate(50);
+      vtkIdType* weights = arena.Allocate<vtkIdType>(static_cast<std::size_t>(i % 50 + 1));
+      for (vtkIdType j = 0; j <= i % 50; ++j)
+      {
+        neighbors->InsertNextId(i + j);
+        weights[j] = j % 2 ? 1 : -1;
+      }
+      this->Sums[i] = 0;
+      for (vtkIdType j = 0; j < neighbors->GetNumberOfIds(); ++j)
+      {
+        this->Sums[i] += weights[j] * neighbors->GetId(j);
+      }
+    }
+  }
+};
+
+//------------------------------------------------------------------------------
+bool TestAllocationCounts()
+{
+  constexpr vtkIdType size = 100000;
+  std::vector<vtkIdType> sums(size);
+  NeighborSum functor;
+  functor.Sums = sums.data();
+
+  vtkScratchArena::SetCountAllocations(true);
+  vtkScratchArena::ResetStatistics();
+  vtkSMPTools::For(0, size, functor);
+  vtkSMPTools::For(0, size, functor);
+  const vtkScratchArena::Statistics statistics = vtkScratchArena::GetStatistics();
+  vtkScratchArena::SetCountAllocations(false);
+  const vtkIdType numberOfArenas = static_cast<vtkIdType>(functor.TLArena.size());
+
+  std::cout << numberOfArenas << " arenas: " << statistics.HeapAllocations
+            << " heap allocations, " << statistics.ArenaAllocations << " arena allocations, "
+            << statistics.ObjectsCreated << " objects created, " << statistics.ObjectsReused
+            << " objects reused." << std::endl;
+
+  for (vtkIdType i = 0; i < size; ++i)
+  {
+    vtkIdType expected = 0;
+    for (vtkIdType j = 0; j <= i % 50; ++j)
+    {
+      expected += (j % 2 ? 1 : -1) * (i + j);
+    }
+    if (sums[i] != expected)
+    {
+      std::cerr << "Wrong sum for " << i << std::endl;
+      return false;
+    }
+  }
+  // Each arena allocates one block, one list and its ids, then reuses them.
+  if (statistics.ObjectsCreated != numberOfArenas ||
+    statistics.ObjectsCreated + statistics.ObjectsReused != 2 * size ||
+    statistics.HeapAllocations > 3 * numberOfArenas ||
+    statistics.ArenaAllocations < 2 * size - numberOfArenas)
+  {
+    std::cerr << "Allocations were not served by the arenas." << std::endl;
+    return false;
+  }
+  return true;
+}
+}
+
+//------------------------------------------------------------------------------
+int TestScratchArena(int, char*[])
+{
+  bool success = TestMemory();
+  success &= TestPools();
+  success &= TestAllocationCounts();
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -337,6 +337,17 @@ int vtkAbstractArray::CopyInformation(vtkInformation* infoFrom, vtkTypeBool deep
   return 1;
 }
 
+//------------------------------------------------------------------------------
+void vtkAbstractArray::LookupValues(vtkAbstractArray* values, vtkIdList* indices)
+{
+  const vtkIdType numberOfValues = values->GetNumberOfValues();
+  indices->SetNumberOfIds(numberOfValues);
+  for (vtkIdType i = 0; i < numberOfValues; ++i)
+  {
+    indices->SetId(i, this->LookupValue(values->GetVariantValue(i)));
+  }
+}
+
 //------------------------------------------------------------------------------
 // call modified on superclass
 void vtkAbstractArray::Modified()
@@ -630,6 +641,8 @@ const char* vtkAbstractArray::GetArrayTypeAsString(int arrayType)
       return "VTK_STRIDED_ARRAY";
     case vtkArrayTypes::VTK_STRUCTURED_POINT_ARRAY:
       return "VTK_STRUCTURED_POINT_ARRAY";
+    case vtkArrayTypes::VTK_HALF_FLOAT_ARRAY:
+      return "VTK_HALF_FLOAT_ARRAY";
   }
   return "Unknown";
 }
@@ -493,6 +493,17 @@ public:
   virtual void LookupValue(vtkVariant value, vtkIdList* valueIds) = 0;
   ///@}
 
+  /**
+   * Batched LookupValue(): resize indices to the number of values of the
+   * values array, and store for each of them the index of its first
+   * occurrence in this array, or -1 if it is not found. vtkGenericDataArray
+   * subclasses search the values in parallel.
+   *
+   * @warning Same as LookupValue(), make sure that the lookup structure is
+   * not outdated.
+   */
+  virtual void LookupValues(vtkAbstractArray* values, vtkIdList* indices);
+
   /**
    * Retrieve value from the array as a variant.
    */
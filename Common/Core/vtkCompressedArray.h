@@ -0,0 +1,37 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+#ifndef vtkCompressedArray_h
+#define vtkCompressedArray_h
+
+#include "vtkCompressedImplicitBackend.h" // for the array backend
+#include "vtkImplicitArray.h"
+
+/**
+ * \var vtkCompressedArray
+ * \brief An implicit array storing its values in compressed blocks.
+ *
+ * The blocks are decompressed on demand, and the last ones are kept in a
+ * small cache. See vtkCompressedImplicitBackend for the storage details, and
+ * vtkToCompressedArrayStrategy to compress the arrays of a dataset with
+ * vtkToImplicitArrayFilter.
+ *
+ * An example of potential usage:
+ * ```
+ * vtkNew<vtkCompressedArray<float>> compressed;
+ * compressed->ConstructBackend(explicitArray, 16384, compress, decompress);
+ * compressed->SetNumberOfComponents(explicitArray->GetNumberOfComponents());
+ * compressed->SetNumberOfTuples(explicitArray->GetNumberOfTuples());
+ * // Fast path to read a range of values:
+ * compressed->GetBackend()->GetValues(begin, end, buffer);
+ * ```
+ *
+ * @sa
+ * vtkImplicitArray vtkCompressedImplicitBackend
+ */
+
+VTK_ABI_NAMESPACE_BEGIN
+template <typename T>
+using vtkCompressedArray = vtkImplicitArray<vtkCompressedImplicitBackend<T>>;
+VTK_ABI_NAMESPACE_END
+
+#endif // vtkCompressedArray_h
@@ -0,0 +1,148 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+#ifndef vtkCompressedImplicitBackend_h
+#define vtkCompressedImplicitBackend_h
+
+/**
+ * \class vtkCompressedImplicitBackend
+ *
+ * A backend for the `vtkImplicitArray` framework keeping the values of an array in compressed
+ * blocks, which are decompressed on demand. It cuts the resident memory of arrays which are
+ * rarely accessed, such as the fields of the past time steps of a simulation.
+ *
+ * The values are split in blocks of a fixed number of values, rounded up to a whole number of
+ * tuples. The bytes of the values of a block are shuffled, i.e. the first bytes of all the values
+ * are stored first, then the second bytes, and so on, before the block is given to the compression
+ * function: the high order bytes of the values of smooth fields are mostly identical and compress
+ * well once grouped. A block which does not compress is stored as is.
+ *
+ * The codec is provided as a pair of functions, so that this backend does not depend on any
+ * compression library. `vtkToCompressedArrayStrategy` wraps a `vtkDataCompressor` (LZ4, zstd,
+ * ...) for use with `vtkToImplicitArrayFilter`.
+ *
+ * The last decompressed blocks are kept in a least recently used cache of CacheSize blocks,
+ * shared by all the threads reading the array and protected by a mutex. Reading the values in
+ * order, with `mapTuple` or `GetValues`, decompresses each block once.
+ *
+ * An example of potential usage in a `vtkImplicitArray`:
+ * ```
+ * vtkNew<vtkCompressedArray<double>> compressed;
+ * compressed->ConstructBackend(explicitArray, 16384, compress, decompress);
+ * compressed->SetNumberOfComponents(explicitArray->GetNumberOfComponents());
+ * compressed->SetNumberOfTuples(explicitArray->GetNumberOfTuples());
+ * ```
+ *
+ * @sa
+ * vtkImplicitArray, vtkCompressedArray, vtkToCompressedArrayStrategy
+ */
+
+#include "vtkCommonCoreModule.h"
+
+#include "vtkType.h"
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <vector>
+
+VTK_ABI_NAMESPACE_BEGIN
+class vtkDataArray;
+template <typename ValueType>
+class VTKCOMMONCORE_EXPORT vtkCompressedImplicitBackend final
+{
+public:
+  /**
+   * Compress inputSize bytes of input into output. Return false if the data
+   * cannot be compressed.
+   */
+  using CompressFunction = std::function<bool(
+    const unsigned char* input, std::size_t inputSize, std::vector<unsigned char>& output)>;
+
+  /**
+   * Decompress inputSize bytes of input into the outputSize bytes of output.
+   * Return false on failure.
+   */
+  using DecompressFunction = std::function<bool(const unsigned char* input,
+    std::size_t inputSize, unsigned char* output, std::size_t outputSize)>;
+
+  /**
+   * Compress the values of array by blocks of at least blockSize values.
+   * The values are converted to ValueType when array has another value type.
+   * The decompression function is kept to read the blocks, and up to cacheSize
+   * blocks are kept decompressed.
+   */
+  vtkCompressedImplicitBackend(vtkDataArray* array, vtkIdType blockSize,
+    const CompressFunction& compress, DecompressFunction decompress, int cacheSize = 4);
+  ~vtkCompressedImplicitBackend();
+
+  /**
+   * Indexing operation for the compressed array respecting the backend expectations of
+   * `vtkImplicitArray`
+   */
+  ValueType operator()(vtkIdType idx) const;
+
+  /**
+   * Fill tuple with the components of the tuple tupleIdx. The tuples never
+   * straddle two blocks.
+   */
+  void mapTuple(vtkIdType tupleIdx, ValueType* tuple) const;
+
+  /**
+   * Copy the values [begin, end) to values, decompressing each block at most
+   * once. This is the fast path to iterate over a range of the array.
+   */
+  void GetValues(vtkIdType begin, vtkIdType end, ValueType* values) const;
+
+  ///@{
+  /**
+   * Information about the compressed blocks.
+   */
+  vtkIdType GetBlockSize() const;
+  vtkIdType GetNumberOfBlocks() const;
+  std::size_t GetCompressedSize() const;
+  ///@}
+
+  /**
+   * Return the number of blocks decompressed so far, cache misses included.
+   */
+  vtkIdType GetNumberOfDecompressions() const;
+
+  /**
+   * Returns the smallest integer memory size in KiB needed to store the array,
+   * compressed blocks and cache included.
+   * Used to implement GetActualMemorySize on `vtkCompressedImplicitBackend`.
+   */
+  unsigned long getMemorySize() const;
+
+private:
+  struct Internals;
+  std::unique_ptr<Internals> Internal;
+};
+VTK_ABI_NAMESPACE_END
+
+#endif // vtkCompressedImplicitBackend_h
+
+#if defined(VTK_COMPRESSED_BACKEND_INSTANTIATING)
+
+#define VTK_INSTANTIATE_COMPRESSED_BACKEND(ValueType)                                              \
+  VTK_ABI_NAMESPACE_BEGIN                                                                          \
+  template class VTKCOMMONCORE_EXPORT vtkCompressedImplicitBackend<ValueType>;                     \
+  VTK_ABI_NAMESPACE_END
+
+#elif defined(VTK_USE_EXTERN_TEMPLATE)
+
+#ifndef VTK_COMPRESSED_BACKEND_TEMPLATE_EXTERN
+#define VTK_COMPRESSED_BACKEND_TEMPLATE_EXTERN
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable : 4910) // extern and dllexport incompatible
+#endif
+VTK_ABI_NAMESPACE_BEGIN
+vtkExternTemplateMacro(extern template class VTKCOMMONCORE_EXPORT vtkCompressedImplicitBackend);
+VTK_ABI_NAMESPACE_END
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+#endif // VTK_COMPRESSED_BACKEND_TEMPLATE_EXTERN
+
+#endif
@@ -0,0 +1,258 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkCompressedImplicitBackend.h"
+
+#include "vtkAOSDataArrayTemplate.h"
+#include "vtkDataArray.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+
+VTK_ABI_NAMESPACE_BEGIN
+//-----------------------------------------------------------------------
+template <typename ValueType>
+struct vtkCompressedImplicitBackend<ValueType>::Internals
+{
+  struct Block
+  {
+    std::vector<unsigned char> Data;
+    bool Compressed = false;
+  };
+
+  struct CacheEntry
+  {
+    vtkIdType BlockId = -1;
+    std::uint64_t LastUse = 0;
+    std::vector<ValueType> Values;
+  };
+
+  vtkIdType GetBlockLength(vtkIdType blockId) const
+  {
+    return std::min(this->BlockSize, this->NumberOfValues - blockId * this->BlockSize);
+  }
+
+  // Return the decompressed values of a block. The mutex must be locked.
+  const ValueType* GetBlockValues(vtkIdType blockId)
+  {
+    CacheEntry* entry = &this->Cache[0];
+    for (auto& candidate : this->Cache)
+    {
+      if (candidate.BlockId == blockId)
+      {
+        candidate.LastUse = ++this->Clock;
+        return candidate.Values.data();
+      }
+      if (candidate.LastUse < entry->LastUse)
+      {
+        entry = &candidate;
+      }
+    }
+
+    // Miss: decompress the block in the least recently used entry.
+    const Block& block = this->Blocks[blockId];
+    const vtkIdType length = this->GetBlockLength(blockId);
+    const std::size_t bytes = static_cast<std::size_t>(length) * sizeof(ValueType);
+    entry->Values.resize(static_cast<std::size_t>(this->BlockSize));
+    const unsigned char* shuffled = block.Data.data();
+    if (block.Compressed)
+    {
+      this->Buffer.resize(bytes);
+      if (!this->Decompress(block.Data.data(), block.Data.size(), this->Buffer.data(), bytes))
+      {
+        std::fill(this->Buffer.begin(), this->Buffer.end(), 0);
+      }
+      shuffled = this->Buffer.data();
+    }
+    Unshuffle(shuffled, length, entry->Values.data());
+    entry->BlockId = blockId;
+    entry->LastUse = ++this->Clock;
+    ++this->NumberOfDecompressions;
+    return entry->Values.data();
+  }
+
+  // Byte i of the value j is stored at i * length + j.
+  static void Shuffle(const ValueType* values, vtkIdType length, unsigned char* shuffled)
+  {
+    const auto bytes = reinterpret_cast<const unsigned char*>(values);
+    for (std::size_t i = 0; i < sizeof(ValueType); ++i)
+    {
+      for (vtkIdType j = 0; j < length; ++j)
+      {
+        shuffled[i * length + j] = bytes[j * sizeof(ValueType) + i];
+      }
+    }
+  }
+
+  static void Unshuffle(const unsigned char* shuffled, vtkIdType length, ValueType* values)
+  {
+    const auto bytes = reinterpret_cast<unsigned char*>(values);
+    for (std::size_t i = 0; i < sizeof(ValueType); ++i)
+    {
+      for (vtkIdType j = 0; j < length; ++j)
+      {
+        bytes[j * sizeof(ValueType) + i] = shuffled[i * length + j];
+      }
+    }
+  }
+
+  std::vector<Block> Blocks;
+  vtkIdType BlockSize = 1;
+  vtkIdType NumberOfValues = 0;
+  int NumberOfComponents = 1;
+  DecompressFunction Decompress;
+
+  std::mutex Mutex;
+  std::vector<CacheEntry> Cache;
+  std::vector<unsigned char> Buffer;
+  std::uint64_t Clock = 0;
+  vtkIdType NumberOfDecompressions = 0;
+};
+
+//-----------------------------------------------------------------------
+template <typename ValueType>
+vtkCompressedImplicitBackend<ValueType>::vtkCompressedImplicitBackend(vtkDataArray* array,
+  vtkIdType blockSize, const CompressFunction& compress, DecompressFunction decompress,
+  int cacheSize)
+  : Internal(new Internals())
+{
+  auto& internals = *this->Internal;
+  internals.Decompress = std::move(decompress);
+  internals.Cache.resize(static_cast<std::size_t>(std::max(cacheSize, 1)));
+  if (!array)
+  {
+    return;
+  }
+  internals.NumberOfComponents = array->GetNumberOfComponents();
+  internals.NumberOfValues = array->GetNumberOfValues();
+  // Round the block size up to whole tuples.
+  const vtkIdType nComps = internals.NumberOfComponents;
+  internals.BlockSize = std::max<vtkIdType>((blockSize + nComps - 1) / nComps, 1) * nComps;
+
+  const vtkIdType numberOfBlocks =
+    (internals.NumberOfValues + internals.BlockSize - 1) / internals.BlockSize;
+  internals.Blocks.resize(static_cast<std::size_t>(numberOfBlocks));
+  auto aos = vtkAOSDataArrayTemplate<ValueType>::FastDownCast(array);
+  std::vector<ValueType> values(static_cast<std::size_t>(internals.BlockSize));
+  std::vector<unsigned char> shuffled;
+  for (vtkIdType blockId = 0; blockId < numberOfBlocks; ++blockId)
+  {
+    const vtkIdType begin = blockId * internals.BlockSize;
+    const vtkIdType length = internals.GetBlockLength(blockId);
+    if (aos)
+    {
+      std::copy_n(aos->GetPointer(begin), length, values.begin());
+    }
+    else
+    {
+      for (vtkIdType idx = 0; idx < length; ++idx)
+      {
+        values[idx] = static_cast<ValueType>(
+          array->GetComponent((begin + idx) / nComps, static_cast<int>((begin + idx) % nComps)));
+      }
+    }
+    const std::size_t bytes = static_cast<std::size_t>(length) * sizeof(ValueType);
+    shuffled.resize(bytes);
+    Internals::Shuffle(values.data(), length, shuffled.data());
+
+    auto& block = internals.Blocks[blockId];
+    if (compress && compress(shuffled.data(), bytes, block.Data) && block.Data.size() < bytes)
+    {
+      block.Compressed = true;
+      block.Data.shrink_to_fit();
+    }
+    else
+    {
+      block.Data = shuffled;
+      block.Compressed = false;
+    }
+  }
+}
+
+//-----------------------------------------------------------------------
+template <typename ValueType>
+vtkCompressedImplicitBackend<ValueType>::~vtkCompressedImplicitBackend() = default;
+
+//-----------------------------------------------------------------------
+template <typename ValueType>
+ValueType vtkCompressedImplicitBackend<ValueType>::operator()(vtkIdType idx) const
+{
+  auto& internals = *this->Internal;
+  std::lock_guard<std::mutex> lock(internals.Mutex);
+  return internals.GetBlockValues(idx / internals.BlockSize)[idx % internals.BlockSize];
+}
+
+//-----------------------------------------------------------------------
+template <typename ValueType>
+void vtkCompressedImplicitBackend<ValueType>::mapTuple(vtkIdType tupleIdx, ValueType* tuple) const
+{
+  auto& internals = *this->Internal;
+  const vtkIdType idx = tupleIdx * internals.NumberOfComponents;
+  std::lock_guard<std::mutex> lock(internals.Mutex);
+  const ValueType* values = internals.GetBlockValues(idx / internals.BlockSize);
+  std::copy_n(values + idx % internals.BlockSize, internals.NumberOfComponents, tuple);
+}
+
+//-----------------------------------------------------------------------
+template <typename ValueType>
+void vtkCompressedImplicitBackend<ValueType>::GetValues(
+  vtkIdType begin, vtkIdType end, ValueType* values) const
+{
+  auto& internals = *this->Internal;
+  std::lock_guard<std::mutex> lock(internals.Mutex);
+  while (begin < end)
+  {
+    const vtkIdType blockId = begin / internals.BlockSize;
+    const vtkIdType offset = begin % internals.BlockSize;
+    const vtkIdType length = std::min(end - begin, internals.BlockSize - offset);
+    values = std::copy_n(internals.GetBlockValues(blockId) + offset, length, values);
+    begin += length;
+  }
+}
+
+//-----------------------------------------------------------------------
+template <typename ValueType>
+vtkIdType vtkCompressedImplicitBackend<ValueType>::GetBlockSize() const
+{
+  return this->Internal->BlockSize;
+}
+
+//-----------------------------------------------------------------------
+template <typename ValueType>
+vtkIdType vtkCompressedImplicitBackend<ValueType>::GetNumberOfBlocks() const
+{
+  return static_cast<vtkIdType>(this->Internal->Blocks.size());
+}
+
+//-----------------------------------------------------------------------
+template <typename ValueType>
+std::size_t vtkCompressedImplicitBackend<ValueType>::GetCompressedSize() const
+{
+  std::size_t size = 0;
+  for (const auto& block : this->Internal->Blocks)
+  {
+    size += block.Data.size();
+  }
+  return size;
+}
+
+//-----------------------------------------------------------------------
+template <typename ValueType>
+vtkIdType vtkCompressedImplicitBackend<ValueType>::GetNumberOfDecompressions() const
+{
+  std::lock_guard<std::mutex> lock(this->Internal->Mutex);
+  return this->Internal->NumberOfDecompressions;
+}
+
+//-----------------------------------------------------------------------
+template <typename ValueType>
+unsigned long vtkCompressedImplicitBackend<ValueType>::getMemorySize() const
+{
+  const auto& internals = *this->Internal;
+  const std::size_t cacheSize = internals.Cache.size() *
+    static_cast<std::size_t>(internals.BlockSize) * sizeof(ValueType);
+  const std::size_t size = this->GetCompressedSize() + cacheSize;
+  return static_cast<unsigned long>(std::max<std::size_t>((size + 1023) / 1024, 1));
+}
+VTK_ABI_NAMESPACE_END
@@ -25,6 +25,9 @@
 #   Include vtkStructuredPointArray<ValueType> for the basic types supported
 #   by VTK. This should probably not be turned off.
 #
+# - VTK_DISPATCH_HALF_FLOAT_ARRAYS (default: OFF)
+#   Include vtkHalfFloatArray, the half precision array of float values.
+#
 # At a lower level, specific arrays can be added to the list individually in
 # two ways:
 #
@@ -149,6 +152,12 @@ macro(vtkArrayDispatch_default_array_setup)
   _vtkCreateArrayDispatch(VTK_DISPATCH_AOS_ARRAYS "vtkAOSDataArrayTemplate" "${vtk_numeric_types}")
   _vtkCreateArrayDispatch(VTK_DISPATCH_SOA_ARRAYS "vtkSOADataArrayTemplate" "${vtk_numeric_types}")
 
+  # Set up reduced precision arrays
+  if (VTK_DISPATCH_HALF_FLOAT_ARRAYS)
+    list(APPEND vtkArrayDispatch_extra_headers "vtkHalfFloatArray.h")
+    list(APPEND vtkArrayDispatch_extra_arrays "vtkHalfFloatArray")
+  endif ()
+
   # Helper macro for implicit arrays
   macro(_vtkCreateArrayDispatchImplicit var class types)
     if (${var})
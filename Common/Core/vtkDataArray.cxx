@@ -14,9 +14,11 @@
 #include "vtkInformationVector.h"
 #include "vtkLookupTable.h"
 #include "vtkMath.h"
+#include "vtkSMPTools.h"
 #include "vtkTypeTraits.h"
 
 #include <algorithm> // for min(), max()
+#include <cmath>     // for std::sqrt
 #include <vector>    // for std::vector
 
 namespace
@@ -53,6 +55,21 @@ vtkInformationKeyRestrictedMacro(vtkDataArray, L2_NORM_RANGE, DoubleVector, 2);
 vtkInformationKeyRestrictedMacro(vtkDataArray, L2_NORM_FINITE_RANGE, DoubleVector, 2);
 vtkInformationKeyMacro(vtkDataArray, UNITS_LABEL, String);
 
+//------------------------------------------------------------------------------
+// Ranges of blocks of tuples, kept by ModifiedTuples() so that the cached
+// ranges can be updated by scanning only the modified blocks.
+struct vtkDataArray::vtkRangeBlocks
+{
+  static constexpr vtkIdType BlockSize = 65536;
+
+  // Modification time of the array when the blocks were last updated.
+  vtkMTimeType Time = 0;
+  int NumberOfComponents = 0;
+  vtkIdType NumberOfTuples = 0;
+  // 4 * (NumberOfComponents + 1) values per block, see ComputeTupleRanges().
+  std::vector<double> Ranges;
+};
+
 //------------------------------------------------------------------------------
 // Construct object with default tuple dimension (number of components) of 1.
 vtkDataArray::vtkDataArray()
@@ -99,6 +116,8 @@ vtkDataArray* vtkDataArray::FastDownCast(vtkAbstractArray* source)
       case vtkArrayTypes::VTK_STD_FUNCTION_ARRAY:
       case vtkArrayTypes::VTK_STRIDED_ARRAY:
       case vtkArrayTypes::VTK_STRUCTURED_POINT_ARRAY:
+      // Reduced precision GenericDataArray subclasses
+      case vtkArrayTypes::VTK_HALF_FLOAT_ARRAY:
         return static_cast<vtkDataArray*>(source);
       default:
         break;
@@ -836,9 +855,9 @@ void vtkDataArray::ComputeFiniteRange(
   }
   else
   {
-    std::vector<double> allCompRanges(this->NumberOfComponents * 2);
     if (ghosts)
     {
+      std::vector<double> allCompRanges(this->NumberOfComponents * 2);
       if (this->ComputeFiniteScalarRange(allCompRanges.data(), ghosts, ghostsToSkip))
       {
         range[0] = allCompRanges[comp * 2];
@@ -851,6 +870,7 @@ void vtkDataArray::ComputeFiniteRange(
     // hasValidKey will update range to the cached value if it exists.
     if (!hasValidKey(info, PER_FINITE_COMPONENT(), rkey, range, comp))
     {
+      std::vector<double> allCompRanges(this->NumberOfComponents * 2);
       const bool computed = this->ComputeFiniteScalarRange(allCompRanges.data());
       if (computed)
       {
@@ -918,9 +938,9 @@ void vtkDataArray::ComputeRange(
   }
   else
   {
-    std::vector<double> allCompRanges(this->NumberOfComponents * 2);
     if (ghosts)
     {
+      std::vector<double> allCompRanges(this->NumberOfComponents * 2);
       if (this->ComputeScalarRange(allCompRanges.data(), ghosts, ghostsToSkip))
       {
         range[0] = allCompRanges[comp * 2];
@@ -933,6 +953,7 @@ void vtkDataArray::ComputeRange(
     // hasValidKey will update range to the cached value if it exists.
     if (!hasValidKey(info, PER_COMPONENT(), rkey, range, comp))
     {
+      std::vector<double> allCompRanges(this->NumberOfComponents * 2);
       const bool computed = this->ComputeScalarRange(allCompRanges.data());
       if (computed)
       {
@@ -966,9 +987,120 @@ void vtkDataArray::Modified()
     info->Remove(L2_NORM_RANGE());
     info->Remove(L2_NORM_FINITE_RANGE());
   }
+  this->RangeBlocks.reset();
   this->Superclass::Modified();
 }
 
+//------------------------------------------------------------------------------
+void vtkDataArray::ModifiedTuples(vtkIdType beginTuple, vtkIdType endTuple)
+{
+  const int numComps = this->NumberOfComponents;
+  const vtkIdType numTuples = this->GetNumberOfTuples();
+  vtkInformation* info = this->HasInformation() ? this->GetInformation() : nullptr;
+  const bool hasCachedRange = info &&
+    (info->Has(PER_COMPONENT()) || info->Has(PER_FINITE_COMPONENT()) ||
+      info->Has(L2_NORM_RANGE()) || info->Has(L2_NORM_FINITE_RANGE()));
+  if (!hasCachedRange || numTuples == 0)
+  {
+    // Nothing to update, the ranges will be computed on demand.
+    this->Modified();
+    return;
+  }
+
+  constexpr vtkIdType blockSize = vtkRangeBlocks::BlockSize;
+  const int rangeSize = 4 * (numComps + 1);
+  const vtkIdType numBlocks = (numTuples + blockSize - 1) / blockSize;
+  vtkIdType firstBlock = 0;
+  vtkIdType endBlock = 0;
+  vtkRangeBlocks* blocks = this->RangeBlocks.get();
+  if (blocks && blocks->Time == this->GetMTime() && blocks->NumberOfComponents == numComps)
+  {
+    beginTuple = std::max<vtkIdType>(beginTuple, 0);
+    endTuple = std::min(endTuple, numTuples);
+    if (beginTuple < endTuple)
+    {
+      firstBlock = beginTuple / blockSize;
+      endBlock = (endTuple + blockSize - 1) / blockSize;
+    }
+    if (numTuples != blocks->NumberOfTuples)
+    {
+      // Tuples were appended or removed: the last block before the change is
+      // partial, and the following ones are new.
+      const vtkIdType firstChanged = std::min(numTuples, blocks->NumberOfTuples) / blockSize;
+      firstBlock = firstBlock < endBlock ? std::min(firstBlock, firstChanged) : firstChanged;
+      endBlock = numBlocks;
+    }
+  }
+  else
+  {
+    // The blocks are missing or out of date: scan the whole array once.
+    this->RangeBlocks.reset(new vtkRangeBlocks);
+    blocks = this->RangeBlocks.get();
+    blocks->NumberOfComponents = numComps;
+    endBlock = numBlocks;
+  }
+
+  blocks->Ranges.resize(numBlocks * rangeSize);
+  blocks->NumberOfTuples = numTuples;
+  double* blockRanges = blocks->Ranges.data();
+  vtkSMPTools::For(firstBlock, endBlock,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType block = begin; block < end; ++block)
+      {
+        this->ComputeTupleRanges(block * blockSize, std::min((block + 1) * blockSize, numTuples),
+          blockRanges + block * rangeSize);
+      }
+    });
+
+  // Reduce the ranges of the blocks.
+  std::vector<double> ranges(blockRanges, blockRanges + rangeSize);
+  for (vtkIdType block = 1; block < numBlocks; ++block)
+  {
+    const double* blockRange = blockRanges + block * rangeSize;
+    for (int i = 0; i < rangeSize; i += 2)
+    {
+      ranges[i] = std::min(ranges[i], blockRange[i]);
+      ranges[i + 1] = std::max(ranges[i + 1], blockRange[i + 1]);
+    }
+  }
+
+  // Update the modification time, without the invalidation of Modified().
+  this->DataChanged();
+  this->vtkObject::Modified();
+  blocks->Time = this->GetMTime();
+
+  auto setComponentRanges = [&](vtkInformationInformationVectorKey* key, const double* compRanges)
+  {
+    vtkInformationVector* infoVec = vtkInformationVector::New();
+    info->Set(key, infoVec);
+    infoVec->SetNumberOfInformationObjects(numComps);
+    for (int i = 0; i < numComps; ++i)
+    {
+      infoVec->GetInformationObject(i)->Set(COMPONENT_RANGE(), compRanges + (i * 2), 2);
+    }
+    infoVec->FastDelete();
+  };
+  setComponentRanges(PER_COMPONENT(), ranges.data());
+  setComponentRanges(PER_FINITE_COMPONENT(), ranges.data() + 2 * numComps);
+  if (numComps > 1)
+  {
+    // The blocks hold the ranges of the squared norm. A range stays empty
+    // when no tuple is finite, like the ones computed from scratch.
+    double* l2Ranges = ranges.data() + 4 * numComps;
+    for (int i = 0; i < 4; i += 2)
+    {
+      if (l2Ranges[i] <= l2Ranges[i + 1])
+      {
+        l2Ranges[i] = std::sqrt(l2Ranges[i]);
+        l2Ranges[i + 1] = std::sqrt(l2Ranges[i + 1]);
+      }
+    }
+    info->Set(L2_NORM_RANGE(), l2Ranges, 2);
+    info->Set(L2_NORM_FINITE_RANGE(), l2Ranges + 2, 2);
+  }
+}
+
 //------------------------------------------------------------------------------
 void vtkDataArray::GetDataTypeRange(double range[2])
 {
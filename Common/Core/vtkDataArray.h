@@ -27,6 +27,8 @@
 #include "vtkCommonCoreModule.h" // For export macro
 #include "vtkWrappingHints.h"    // For VTK_MARSHALMANUAL
 
+#include <memory> // For std::unique_ptr
+
 VTK_ABI_NAMESPACE_BEGIN
 class vtkDoubleArray;
 class vtkIdList;
@@ -569,6 +571,28 @@ public:
    */
   void Modified() override;
 
+  /**
+   * Notify the array that only the tuples in [beginTuple, endTuple) were
+   * modified or appended. Like Modified(), this updates the modification time
+   * of the array, but the cached ranges are updated instead of being discarded:
+   * the array keeps the ranges of blocks of tuples, and only the blocks
+   * containing modified tuples, or tuples appended or removed since the
+   * ranges were cached, are scanned again. The ranges of all the components,
+   * finite or not, and of the L2 norm remain available in O(1) to GetRange()
+   * and GetFiniteRange().
+   *
+   * When no range is cached, this is equivalent to Modified(). The first
+   * call after a range is computed scans the whole array once to build the
+   * blocks.
+   *
+   * The array never calls this method itself: SetValue(), SetTuple(),
+   * InsertNextTuple() and the other setters do not update the modification
+   * time. The code writing the tuples calls it once for the span it wrote,
+   * instead of Modified().
+   * THIS METHOD IS NOT THREAD SAFE.
+   */
+  void ModifiedTuples(vtkIdType beginTuple, vtkIdType endTuple);
+
   /**
    * A human-readable string indicating the units for the array data.
    * \ingroup InformationKeys
@@ -732,6 +756,15 @@ protected:
     double range[2], const unsigned char* ghosts, unsigned char ghostsToSkip = 0xff);
   ///@}
 
+  /**
+   * Compute in a single pass the ranges of the tuples in [beginTuple,
+   * endTuple): the range of each component, the finite range of each
+   * component, then the range and the finite range of the squared L2 norm of
+   * the tuples. ranges must hold 4 * (number of components + 1) values.
+   * Used by ModifiedTuples().
+   */
+  void ComputeTupleRanges(vtkIdType beginTuple, vtkIdType endTuple, double* ranges);
+
   // Construct object with default tuple dimension (number of components) of 1.
   vtkDataArray();
   ~vtkDataArray() override;
@@ -741,6 +774,9 @@ protected:
   double FiniteRange[2];
 
 private:
+  struct vtkRangeBlocks;
+  std::unique_ptr<vtkRangeBlocks> RangeBlocks;
+
   double* GetTupleN(vtkIdType i, int n);
 
   vtkDataArray(const vtkDataArray&) = delete;
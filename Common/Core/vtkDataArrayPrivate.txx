@@ -12,12 +12,33 @@
 
 #include <algorithm>
 #include <array>
+#include <cmath>
+#include <type_traits>
 #include <vector>
 
 namespace vtkDataArrayPrivate
 {
 VTK_ABI_NAMESPACE_BEGIN
 
+// Type in which the squared L2 norms of tuples of ValueType are computed. The
+// squared norms of 8 and 16 bit integers are exact in 64 bit integers, while
+// the ones of larger integers could overflow them.
+template <typename ValueType>
+using SquaredNormType =
+  std::conditional_t<std::is_integral_v<ValueType> && sizeof(ValueType) <= 2, vtkTypeInt64, double>;
+
+// Take the square root of a range of squared norms, unless it is empty
+// because no value was found.
+template <typename T>
+void SquaredNormRangeToNormRange(T* range)
+{
+  if (range[0] <= range[1])
+  {
+    range[0] = std::sqrt(range[0]);
+    range[1] = std::sqrt(range[1]);
+  }
+}
+
 template <typename ArrayT, typename APIType, int RangeNumComps>
 class MinAndMax
 {
@@ -164,8 +185,7 @@ public:
     MinAndMaxT::CopyRanges(ranges);
     // now that we have computed the smallest and largest value, take the
     // square root of that value.
-    ranges[0] = std::sqrt(ranges[0]);
-    ranges[1] = std::sqrt(ranges[1]);
+    SquaredNormRangeToNormRange(ranges);
   }
   void operator()(vtkIdType begin, vtkIdType end)
   {
@@ -210,8 +230,7 @@ public:
     MinAndMaxT::CopyRanges(ranges);
     // now that we have computed the smallest and largest value, take the
     // square root of that value.
-    ranges[0] = std::sqrt(ranges[0]);
-    ranges[1] = std::sqrt(ranges[1]);
+    SquaredNormRangeToNormRange(ranges);
   }
   void operator()(vtkIdType begin, vtkIdType end)
   {
@@ -268,8 +287,7 @@ struct ComputeVectorRange
   bool operator()(ArrayT* array, RangeValueType* ranges, AllValues, const unsigned char* ghosts,
     unsigned char ghostsToSkip)
   {
-    using APIType =
-      std::conditional_t<std::is_floating_point_v<vtk::GetAPIType<ArrayT>>, double, vtkTypeInt64>;
+    using APIType = SquaredNormType<vtk::GetAPIType<ArrayT>>;
     MagnitudeAllValuesMinAndMax<NumComps, ArrayT, APIType> minmax(array, ghosts, ghostsToSkip);
     vtkSMPTools::For(0, array->GetNumberOfTuples(), minmax);
     minmax.CopyRanges(ranges);
@@ -279,8 +297,7 @@ struct ComputeVectorRange
   bool operator()(ArrayT* array, RangeValueType* ranges, FiniteValues, const unsigned char* ghosts,
     unsigned char ghostsToSkip)
   {
-    using APIType =
-      std::conditional_t<std::is_floating_point_v<vtk::GetAPIType<ArrayT>>, double, vtkTypeInt64>;
+    using APIType = SquaredNormType<vtk::GetAPIType<ArrayT>>;
     MagnitudeFiniteMinAndMax<NumComps, ArrayT, APIType> minmax(array, ghosts, ghostsToSkip);
     vtkSMPTools::For(0, array->GetNumberOfTuples(), minmax);
     minmax.CopyRanges(ranges);
@@ -441,8 +458,7 @@ public:
     MinAndMaxT::CopyRanges(ranges);
     // now that we have computed the smallest and largest value, take the
     // square root of that value.
-    ranges[0] = std::sqrt(ranges[0]);
-    ranges[1] = std::sqrt(ranges[1]);
+    SquaredNormRangeToNormRange(ranges);
   }
   void operator()(vtkIdType begin, vtkIdType end)
   {
@@ -487,8 +503,7 @@ public:
     MinAndMaxT::CopyRanges(ranges);
     // now that we have computed the smallest and largest value, take the
     // square root of that value.
-    ranges[0] = std::sqrt(ranges[0]);
-    ranges[1] = std::sqrt(ranges[1]);
+    SquaredNormRangeToNormRange(ranges);
   }
   void operator()(vtkIdType begin, vtkIdType end)
   {
@@ -539,8 +554,7 @@ template <class ArrayT, typename RangeValueType>
 bool GenericComputeVectorRange(ArrayT* array, RangeValueType* ranges, AllValues,
   const unsigned char* ghosts, unsigned char ghostsToSkip)
 {
-  using APIType =
-    std::conditional_t<std::is_floating_point_v<vtk::GetAPIType<ArrayT>>, double, vtkTypeInt64>;
+  using APIType = SquaredNormType<vtk::GetAPIType<ArrayT>>;
   MagnitudeAllValuesGenericMinAndMax<ArrayT, APIType> minmax(array, ghosts, ghostsToSkip);
   vtkSMPTools::For(0, array->GetNumberOfTuples(), minmax);
   minmax.CopyRanges(ranges);
@@ -552,8 +566,7 @@ template <class ArrayT, typename RangeValueType>
 bool GenericComputeVectorRange(ArrayT* array, RangeValueType* ranges, FiniteValues,
   const unsigned char* ghosts, unsigned char ghostsToSkip)
 {
-  using APIType =
-    std::conditional_t<std::is_floating_point_v<vtk::GetAPIType<ArrayT>>, double, vtkTypeInt64>;
+  using APIType = SquaredNormType<vtk::GetAPIType<ArrayT>>;
   MagnitudeFiniteGenericMinAndMax<ArrayT, APIType> minmax(array, ghosts, ghostsToSkip);
   vtkSMPTools::For(0, array->GetNumberOfTuples(), minmax);
   minmax.CopyRanges(ranges);
@@ -9,6 +9,7 @@
 #include "vtkArrayDispatch.h"
 #include "vtkDataArrayRange.h"
 #include "vtkGenericDataArray.h"
+#include "vtkHalfFloatArray.h"
 #include "vtkLookupTable.h"
 #include "vtkSMPTools.h"
 #include "vtkScaledSOADataArrayTemplate.h"
@@ -94,6 +95,12 @@ struct DeepCopyWorker
 #endif
 #endif
 
+  // Half --> float specialization, converted in bulk:
+  void operator()(vtkHalfFloatArray* src, vtkAOSDataArrayTemplate<float>* dst) const
+  {
+    src->GetFloatValues(0, src->GetNumberOfValues(), dst->GetPointer(0));
+  }
+
   // Generic implementation:
   template <typename SrcArrayT, typename DstArrayT>
   void DoGenericCopy(SrcArrayT* src, DstArrayT* dst) const
@@ -151,7 +158,12 @@ void vtkDataArray::DeepCopy(vtkDataArray* da)
     if (numTuples != 0)
     {
       DeepCopyWorker worker;
-      if (!vtkArrayDispatch::Dispatch2::Execute(da, this, worker))
+      // vtkHalfFloatArray may not be in the dispatch list, check it first:
+      using HalfToFloatDispatch =
+        vtkArrayDispatch::Dispatch2ByArray<vtkTypeList::Create<vtkHalfFloatArray>,
+          vtkTypeList::Create<vtkAOSDataArrayTemplate<float>>>;
+      if (!HalfToFloatDispatch::Execute(da, this, worker) &&
+        !vtkArrayDispatch::Dispatch2::Execute(da, this, worker))
       {
         // If dispatch fails, use fallback:
         worker(da, this);
@@ -0,0 +1,80 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "vtkDataArray.h"
+
+#include "vtkArrayDispatch.h"
+#include "vtkDataArrayPrivate.txx"
+#include "vtkDataArrayRange.h"
+#include "vtkMathUtilities.h"
+#include "vtkTypeTraits.h"
+
+#include <vector>
+
+namespace
+{
+
+// Compute all the ranges cached by vtkDataArray in a single pass over a
+// subset of the tuples. The ranges are computed with the same value types as
+// vtkDataArrayPrivate so that they match the ones of a full computation.
+struct TupleRangesWorker
+{
+  template <typename ArrayT>
+  void operator()(ArrayT* array, vtkIdType begin, vtkIdType end, double* ranges)
+  {
+    using APIType = vtk::GetAPIType<ArrayT>;
+    using SquaredType = vtkDataArrayPrivate::SquaredNormType<APIType>;
+    const int numComps = array->GetNumberOfComponents();
+
+    // Ranges of the components, then finite ranges of the components.
+    std::vector<APIType> componentRanges(4 * numComps);
+    for (int i = 0; i < 2 * numComps; ++i)
+    {
+      componentRanges[2 * i] = vtkTypeTraits<APIType>::Max();
+      componentRanges[2 * i + 1] = vtkTypeTraits<APIType>::Min();
+    }
+    SquaredType magnitudeRanges[4] = { vtkTypeTraits<SquaredType>::Max(),
+      vtkTypeTraits<SquaredType>::Min(), vtkTypeTraits<SquaredType>::Max(),
+      vtkTypeTraits<SquaredType>::Min() };
+
+    APIType* finiteRanges = componentRanges.data() + 2 * numComps;
+    const auto tuples = vtk::DataArrayTupleRange(array, begin, end);
+    for (const auto tuple : tuples)
+    {
+      SquaredType squaredSum = 0;
+      for (int i = 0, j = 0; i < numComps; ++i, j += 2)
+      {
+        const APIType value = tuple[i];
+        vtkMathUtilities::UpdateRange(componentRanges[j], componentRanges[j + 1], value);
+        vtkMathUtilities::UpdateRangeFinite(finiteRanges[j], finiteRanges[j + 1], value);
+        squaredSum += static_cast<SquaredType>(value) * value;
+      }
+      vtkMathUtilities::UpdateRange(magnitudeRanges[0], magnitudeRanges[1], squaredSum);
+      vtkMathUtilities::UpdateRangeFinite(magnitudeRanges[2], magnitudeRanges[3], squaredSum);
+    }
+
+    for (int i = 0; i < 4 * numComps; ++i)
+    {
+      ranges[i] = static_cast<double>(componentRanges[i]);
+    }
+    for (int i = 0; i < 4; ++i)
+    {
+      ranges[4 * numComps + i] = static_cast<double>(magnitudeRanges[i]);
+    }
+  }
+};
+
+} // end anon namespace
+
+VTK_ABI_NAMESPACE_BEGIN
+//------------------------------------------------------------------------------
+void vtkDataArray::ComputeTupleRanges(vtkIdType beginTuple, vtkIdType endTuple, double* ranges)
+{
+  TupleRangesWorker worker;
+  if (!vtkArrayDispatch::DispatchByArray<vtkArrayDispatch::AllArrays>::Execute(
+        this, worker, beginTuple, endTuple, ranges))
+  {
+    worker(this, beginTuple, endTuple, ranges);
+  }
+}
+VTK_ABI_NAMESPACE_END
@@ -352,6 +352,50 @@ public:
   VTK_DEPRECATED_IN_9_7_0("Use vtk::DataArrayValueRange, or the array directly")
   VTK_NEWINSTANCE vtkArrayIterator* NewIterator() override;
 
+  /**
+   * Strategies used to index the values of the array for LookupValue().
+   */
+  enum LookupStrategies
+  {
+    /**
+     * Map each distinct value to the list of its indices with a hash map.
+     * This is the fastest to query, but uses a lot of memory when most of
+     * the values are distinct.
+     */
+    HASH_LOOKUP = 0,
+    /**
+     * Sort the pairs of value and index in parallel and search them by
+     * bisection. This uses sizeof(std::pair<ValueType, vtkIdType>) bytes per
+     * value whatever the values, which suits large arrays of unique values
+     * such as global ids.
+     */
+    SORTED_LOOKUP = 1
+  };
+
+  ///@{
+  /**
+   * Set/Get the strategy used to index the values of the array for
+   * LookupValue() and LookupValues(), see LookupStrategies. Changing the
+   * strategy releases the current lookup structure. Default is HASH_LOOKUP.
+   */
+  void SetLookupStrategy(int strategy);
+  int GetLookupStrategy();
+  ///@}
+
+  /**
+   * Batched LookupTypedValue(): store in indices[i] the index of the first
+   * occurrence of values[i] in this array, or -1 if it is not found, for i in
+   * [0, numberOfValues). The lookup structure is built once, then the values
+   * are searched in parallel.
+   */
+  void LookupTypedValues(const ValueType* values, vtkIdType numberOfValues, vtkIdType* indices);
+
+  /**
+   * Batched LookupValue(). Values of the same array type are searched in
+   * parallel, other arrays are searched value by value through vtkVariant.
+   */
+  void LookupValues(vtkAbstractArray* values, vtkIdList* indices) override;
+
 protected:
   vtkGenericDataArray();
   ~vtkGenericDataArray() override;
@@ -384,6 +384,46 @@ void vtkGenericDataArray<DerivedT, ValueTypeT, ArrayType>::LookupTypedValue(
   this->Lookup.LookupValue(value, ids);
 }
 
+//-----------------------------------------------------------------------------
+template <class DerivedT, class ValueTypeT, int ArrayType>
+void vtkGenericDataArray<DerivedT, ValueTypeT, ArrayType>::LookupTypedValues(
+  const ValueType* values, vtkIdType numberOfValues, vtkIdType* indices)
+{
+  this->Lookup.LookupValues(
+    numberOfValues, [values](vtkIdType i) { return values[i]; }, indices);
+}
+
+//-----------------------------------------------------------------------------
+template <class DerivedT, class ValueTypeT, int ArrayType>
+void vtkGenericDataArray<DerivedT, ValueTypeT, ArrayType>::LookupValues(
+  vtkAbstractArray* values, vtkIdList* indices)
+{
+  DerivedT* typedValues = vtkArrayDownCast<DerivedT>(values);
+  if (!typedValues)
+  {
+    this->Superclass::LookupValues(values, indices);
+    return;
+  }
+  indices->SetNumberOfIds(typedValues->GetNumberOfValues());
+  this->Lookup.LookupValues(
+    typedValues->GetNumberOfValues(),
+    [typedValues](vtkIdType i) { return typedValues->GetValue(i); }, indices->GetPointer(0));
+}
+
+//-----------------------------------------------------------------------------
+template <class DerivedT, class ValueTypeT, int ArrayType>
+void vtkGenericDataArray<DerivedT, ValueTypeT, ArrayType>::SetLookupStrategy(int strategy)
+{
+  this->Lookup.SetSorted(strategy == SORTED_LOOKUP);
+}
+
+//-----------------------------------------------------------------------------
+template <class DerivedT, class ValueTypeT, int ArrayType>
+int vtkGenericDataArray<DerivedT, ValueTypeT, ArrayType>::GetLookupStrategy()
+{
+  return this->Lookup.GetSorted() ? SORTED_LOOKUP : HASH_LOOKUP;
+}
+
 //-----------------------------------------------------------------------------
 template <class DerivedT, class ValueTypeT, int ArrayType>
 void vtkGenericDataArray<DerivedT, ValueTypeT, ArrayType>::ClearLookup()
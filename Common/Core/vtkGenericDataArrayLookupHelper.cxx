@@ -0,0 +1,36 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkGenericDataArrayLookupHelper.h"
+
+#include "vtkSMPTools.h"
+
+namespace vtkGenericDataArrayLookupHelper_detail
+{
+VTK_ABI_NAMESPACE_BEGIN
+#define vtkGenericDataArrayLookupHelperSortPairsMacro(T)                                          \
+  void SortPairs(std::pair<T, vtkIdType>* begin, std::pair<T, vtkIdType>* end)                   \
+  {                                                                                                \
+    vtkSMPTools::Sort(begin, end);                                                                 \
+  }
+vtkGenericDataArrayLookupHelperSortPairsMacro(char)
+vtkGenericDataArrayLookupHelperSortPairsMacro(signed char)
+vtkGenericDataArrayLookupHelperSortPairsMacro(unsigned char)
+vtkGenericDataArrayLookupHelperSortPairsMacro(short)
+vtkGenericDataArrayLookupHelperSortPairsMacro(unsigned short)
+vtkGenericDataArrayLookupHelperSortPairsMacro(int)
+vtkGenericDataArrayLookupHelperSortPairsMacro(unsigned int)
+vtkGenericDataArrayLookupHelperSortPairsMacro(long)
+vtkGenericDataArrayLookupHelperSortPairsMacro(unsigned long)
+vtkGenericDataArrayLookupHelperSortPairsMacro(long long)
+vtkGenericDataArrayLookupHelperSortPairsMacro(unsigned long long)
+vtkGenericDataArrayLookupHelperSortPairsMacro(float)
+vtkGenericDataArrayLookupHelperSortPairsMacro(double)
+#undef vtkGenericDataArrayLookupHelperSortPairsMacro
+
+//------------------------------------------------------------------------------
+void For(vtkIdType begin, vtkIdType end, const std::function<void(vtkIdType, vtkIdType)>& functor)
+{
+  vtkSMPTools::For(begin, end, functor);
+}
+VTK_ABI_NAMESPACE_END
+} // namespace vtkGenericDataArrayLookupHelper_detail
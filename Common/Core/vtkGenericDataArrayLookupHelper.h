@@ -5,16 +5,23 @@
  * @brief   internal class used by
  * vtkGenericDataArray to support LookupValue.
  *
+ * By default, the values are indexed with a hash map from each distinct value
+ * to the list of its indices. When Sorted is set, the pairs of value and index
+ * are instead sorted in parallel (vtkSMPTools::Sort) and searched by
+ * bisection, which uses a fixed amount of memory per value.
  */
 
 #ifndef vtkGenericDataArrayLookupHelper_h
 #define vtkGenericDataArrayLookupHelper_h
 
+#include "vtkCommonCoreModule.h" // For export macro
 #include "vtkIdList.h"
 #include <algorithm>
 #include <cmath>
+#include <functional>
 #include <limits>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace vtkGenericDataArrayLookupHelper_detail
@@ -41,6 +48,34 @@ bool isnan(T x)
   // Select the correct partially specialized type.
   return has_NaN<T, std::numeric_limits<T>::has_quiet_NaN>::isnan(x);
 }
+
+// Sort pairs of value and index with vtkSMPTools::Sort. These are compiled in
+// vtkGenericDataArrayLookupHelper.cxx so that vtkSMPTools is not included here.
+template <typename T>
+void SortPairs(std::pair<T, vtkIdType>* begin, std::pair<T, vtkIdType>* end)
+{
+  std::sort(begin, end);
+}
+#define vtkGenericDataArrayLookupHelperSortPairsMacro(T)                                          \
+  VTKCOMMONCORE_EXPORT void SortPairs(std::pair<T, vtkIdType>* begin, std::pair<T, vtkIdType>* end);
+vtkGenericDataArrayLookupHelperSortPairsMacro(char)
+vtkGenericDataArrayLookupHelperSortPairsMacro(signed char)
+vtkGenericDataArrayLookupHelperSortPairsMacro(unsigned char)
+vtkGenericDataArrayLookupHelperSortPairsMacro(short)
+vtkGenericDataArrayLookupHelperSortPairsMacro(unsigned short)
+vtkGenericDataArrayLookupHelperSortPairsMacro(int)
+vtkGenericDataArrayLookupHelperSortPairsMacro(unsigned int)
+vtkGenericDataArrayLookupHelperSortPairsMacro(long)
+vtkGenericDataArrayLookupHelperSortPairsMacro(unsigned long)
+vtkGenericDataArrayLookupHelperSortPairsMacro(long long)
+vtkGenericDataArrayLookupHelperSortPairsMacro(unsigned long long)
+vtkGenericDataArrayLookupHelperSortPairsMacro(float)
+vtkGenericDataArrayLookupHelperSortPairsMacro(double)
+#undef vtkGenericDataArrayLookupHelperSortPairsMacro
+
+// Run functor(begin, end) on chunks of [first, last) with vtkSMPTools::For.
+VTKCOMMONCORE_EXPORT void For(
+  vtkIdType first, vtkIdType last, const std::function<void(vtkIdType, vtkIdType)>& functor);
 VTK_ABI_NAMESPACE_END
 } // namespace detail
 
@@ -65,21 +100,42 @@ public:
     }
   }
 
-  vtkIdType LookupValue(ValueType elem)
+  ///@{
+  /**
+   * Set/Get whether the values are indexed by sorting them instead of with a
+   * hash map. Changing it releases the current lookup.
+   */
+  void SetSorted(bool sorted)
   {
-    this->UpdateLookup();
-    auto indices = FindIndexVec(elem);
-    if (indices == nullptr)
+    if (this->Sorted != sorted)
     {
-      return -1;
+      this->ClearLookup();
+      this->Sorted = sorted;
     }
-    return indices->front();
+  }
+  bool GetSorted() const { return this->Sorted; }
+  ///@}
+
+  vtkIdType LookupValue(ValueType elem)
+  {
+    this->UpdateLookup();
+    return this->FindFirstIndex(elem);
   }
 
   void LookupValue(ValueType elem, vtkIdList* ids)
   {
     ids->Reset();
     this->UpdateLookup();
+    if (this->Sorted && !vtkGenericDataArrayLookupHelper_detail::isnan(elem))
+    {
+      auto range = this->FindSortedRange(elem);
+      ids->Allocate(static_cast<vtkIdType>(range.second - range.first));
+      for (auto it = range.first; it != range.second; ++it)
+      {
+        ids->InsertNextId(it->second);
+      }
+      return;
+    }
     auto indices = FindIndexVec(elem);
     if (indices)
     {
@@ -91,6 +147,25 @@ public:
     }
   }
 
+  /**
+   * Store in indices[i] the first index of getValue(i) for i in
+   * [0, numberOfValues), or -1 if it is not found. The values are searched in
+   * parallel.
+   */
+  template <typename ValueGetter>
+  void LookupValues(vtkIdType numberOfValues, ValueGetter getValue, vtkIdType* indices)
+  {
+    this->UpdateLookup();
+    vtkGenericDataArrayLookupHelper_detail::For(0, numberOfValues,
+      [&](vtkIdType begin, vtkIdType end)
+      {
+        for (vtkIdType i = begin; i < end; ++i)
+        {
+          indices[i] = this->FindFirstIndex(getValue(i));
+        }
+      });
+  }
+
   ///@{
   /**
    * Release any allocated memory for internal data-structures.
@@ -99,6 +174,8 @@ public:
   {
     this->ValueMap.clear();
     this->NanIndices.clear();
+    this->SortedValues.clear();
+    this->SortedValues.shrink_to_fit();
   }
   ///@}
 
@@ -106,15 +183,22 @@ private:
   vtkGenericDataArrayLookupHelper(const vtkGenericDataArrayLookupHelper&) = delete;
   void operator=(const vtkGenericDataArrayLookupHelper&) = delete;
 
+  using ValueIndex = std::pair<ValueType, vtkIdType>;
+
   void UpdateLookup()
   {
     if (!this->AssociatedArray || (this->AssociatedArray->GetNumberOfTuples() < 1) ||
-      (!this->ValueMap.empty() || !this->NanIndices.empty()))
+      (!this->ValueMap.empty() || !this->NanIndices.empty() || !this->SortedValues.empty()))
     {
       return;
     }
 
     vtkIdType num = this->AssociatedArray->GetNumberOfValues();
+    if (this->Sorted)
+    {
+      this->UpdateSortedLookup(num);
+      return;
+    }
     this->ValueMap.reserve(num);
     for (vtkIdType i = 0; i < num; ++i)
     {
@@ -127,6 +211,67 @@ private:
     }
   }
 
+  void UpdateSortedLookup(vtkIdType num)
+  {
+    this->SortedValues.resize(num);
+    ArrayTypeT* array = this->AssociatedArray;
+    ValueIndex* sortedValues = this->SortedValues.data();
+    vtkGenericDataArrayLookupHelper_detail::For(0, num,
+      [array, sortedValues](vtkIdType begin, vtkIdType end)
+      {
+        for (vtkIdType i = begin; i < end; ++i)
+        {
+          sortedValues[i] = ValueIndex(array->GetValue(i), i);
+        }
+      });
+    if constexpr (std::numeric_limits<ValueType>::has_quiet_NaN)
+    {
+      // NaN values cannot be ordered: move their indices apart.
+      auto last = std::remove_if(this->SortedValues.begin(), this->SortedValues.end(),
+        [this](const ValueIndex& valueIndex)
+        {
+          if (vtkGenericDataArrayLookupHelper_detail::isnan(valueIndex.first))
+          {
+            this->NanIndices.push_back(valueIndex.second);
+            return true;
+          }
+          return false;
+        });
+      this->SortedValues.erase(last, this->SortedValues.end());
+    }
+    // Sorting the pairs orders the indices of equal values: the first one is
+    // the first occurrence, as with the hash map.
+    vtkGenericDataArrayLookupHelper_detail::SortPairs(
+      this->SortedValues.data(), this->SortedValues.data() + this->SortedValues.size());
+  }
+
+  // Return the range of the sorted pairs with the given value.
+  std::pair<const ValueIndex*, const ValueIndex*> FindSortedRange(ValueType value) const
+  {
+    const ValueIndex* begin = this->SortedValues.data();
+    const ValueIndex* end = begin + this->SortedValues.size();
+    const ValueIndex* first = std::lower_bound(begin, end, value,
+      [](const ValueIndex& valueIndex, ValueType v) { return valueIndex.first < v; });
+    const ValueIndex* last = std::upper_bound(first, end, value,
+      [](ValueType v, const ValueIndex& valueIndex) { return v < valueIndex.first; });
+    return std::make_pair(first, last);
+  }
+
+  // Return the first index of value, -1 if it is not found.
+  vtkIdType FindFirstIndex(ValueType value)
+  {
+    if (this->Sorted && !vtkGenericDataArrayLookupHelper_detail::isnan(value))
+    {
+      const ValueIndex* begin = this->SortedValues.data();
+      const ValueIndex* end = begin + this->SortedValues.size();
+      const ValueIndex* found = std::lower_bound(begin, end, value,
+        [](const ValueIndex& valueIndex, ValueType v) { return valueIndex.first < v; });
+      return (found != end && found->first == value) ? found->second : -1;
+    }
+    auto indices = FindIndexVec(value);
+    return indices ? indices->front() : -1;
+  }
+
   // Return a pointer to the relevant vector of indices if specified value was
   // found in the array.
   std::vector<vtkIdType>* FindIndexVec(ValueType value)
@@ -145,8 +290,10 @@ private:
   }
 
   ArrayTypeT* AssociatedArray{ nullptr };
+  bool Sorted{ false };
   std::unordered_map<ValueType, std::vector<vtkIdType>> ValueMap;
   std::vector<vtkIdType> NanIndices;
+  std::vector<ValueIndex> SortedValues;
 };
 
 VTK_ABI_NAMESPACE_END
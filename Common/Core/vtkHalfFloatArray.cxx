@@ -0,0 +1,277 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+#define VTK_HALF_FLOAT_ARRAY_INSTANTIATING
+#include "vtkHalfFloatArray.h"
+
+#define VTK_GDA_VALUERANGE_INSTANTIATING
+#include "vtkDataArrayPrivate.txx"
+#undef VTK_GDA_VALUERANGE_INSTANTIATING
+
+#include "vtkAOSDataArrayTemplate.h"
+#include "vtkCommand.h"
+#include "vtkLookupTable.h"
+#include "vtkObjectFactory.h"
+#include "vtkSmartPointer.h"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__F16C__)
+#include <immintrin.h>
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+namespace vtkDataArrayPrivate
+{
+VTK_ABI_NAMESPACE_BEGIN
+VTK_INSTANTIATE_VALUERANGE_ARRAYTYPE(vtkHalfFloatArray, double)
+VTK_ABI_NAMESPACE_END
+}
+
+VTK_ABI_NAMESPACE_BEGIN
+vtkStandardNewMacro(vtkHalfFloatArray);
+
+//------------------------------------------------------------------------------
+vtkHalfFloatArray::vtkHalfFloatArray()
+{
+  this->Buffer = vtkBuffer<vtkTypeUInt16>::New();
+}
+
+//------------------------------------------------------------------------------
+vtkHalfFloatArray::~vtkHalfFloatArray()
+{
+  this->Buffer->Delete();
+}
+
+//------------------------------------------------------------------------------
+void vtkHalfFloatArray::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+}
+
+//------------------------------------------------------------------------------
+void vtkHalfFloatArray::FloatToHalf(const float* values, vtkTypeUInt16* halves, vtkIdType n)
+{
+  vtkIdType i = 0;
+#if defined(__F16C__)
+  for (; i + 8 <= n; i += 8)
+  {
+    const __m256 floats = _mm256_loadu_ps(values + i);
+    const __m128i packed = _mm256_cvtps_ph(floats, _MM_FROUND_TO_NEAREST_INT);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(halves + i), packed);
+  }
+#elif defined(__aarch64__)
+  for (; i + 4 <= n; i += 4)
+  {
+    vst1_u16(halves + i, vreinterpret_u16_f16(vcvt_f16_f32(vld1q_f32(values + i))));
+  }
+#endif
+  for (; i < n; ++i)
+  {
+    halves[i] = vtkHalfFloatArray::FloatToHalf(values[i]);
+  }
+}
+
+//------------------------------------------------------------------------------
+void vtkHalfFloatArray::HalfToFloat(const vtkTypeUInt16* halves, float* values, vtkIdType n)
+{
+  vtkIdType i = 0;
+#if defined(__F16C__)
+  for (; i + 8 <= n; i += 8)
+  {
+    const __m128i packed = _mm_loadu_si128(reinterpret_cast<const __m128i*>(halves + i));
+    _mm256_storeu_ps(values + i, _mm256_cvtph_ps(packed));
+  }
+#elif defined(__aarch64__)
+  for (; i + 4 <= n; i += 4)
+  {
+    vst1q_f32(values + i, vcvt_f32_f16(vreinterpret_f16_u16(vld1_u16(halves + i))));
+  }
+#endif
+  for (; i < n; ++i)
+  {
+    values[i] = vtkHalfFloatArray::HalfToFloat(halves[i]);
+  }
+}
+
+//------------------------------------------------------------------------------
+void vtkHalfFloatArray::GetFloatValues(vtkIdType valueIdx, vtkIdType n, float* values) const
+{
+  vtkHalfFloatArray::HalfToFloat(this->Buffer->GetBuffer() + valueIdx, values, n);
+}
+
+//------------------------------------------------------------------------------
+void vtkHalfFloatArray::SetFloatValues(vtkIdType valueIdx, vtkIdType n, const float* values)
+{
+  vtkHalfFloatArray::FloatToHalf(values, this->Buffer->GetBuffer() + valueIdx, n);
+  this->DataChanged();
+}
+
+//------------------------------------------------------------------------------
+void vtkHalfFloatArray::FillValue(ValueType value)
+{
+  std::fill_n(
+    this->Buffer->GetBuffer(), this->MaxId + 1, vtkHalfFloatArray::FloatToHalf(value));
+}
+
+//------------------------------------------------------------------------------
+void vtkHalfFloatArray::SetHalfArray(
+  vtkTypeUInt16* array, vtkIdType size, bool save, int deleteMethod)
+{
+  this->Buffer->SetBuffer(array, size);
+
+  if (deleteMethod == VTK_DATA_ARRAY_DELETE)
+  {
+    this->Buffer->SetFreeFunction(save, ::operator delete[]);
+  }
+  else if (deleteMethod == VTK_DATA_ARRAY_ALIGNED_FREE)
+  {
+#ifdef _WIN32
+    this->Buffer->SetFreeFunction(save, _aligned_free);
+#else
+    this->Buffer->SetFreeFunction(save, free);
+#endif
+  }
+  else if (deleteMethod == VTK_DATA_ARRAY_USER_DEFINED || deleteMethod == VTK_DATA_ARRAY_FREE)
+  {
+    this->Buffer->SetFreeFunction(save, free);
+  }
+
+  this->Size = size;
+  this->MaxId = this->Size - 1;
+  this->DataChanged();
+}
+
+//------------------------------------------------------------------------------
+unsigned long vtkHalfFloatArray::GetActualMemorySize() const
+{
+  // The allocated array may be larger than the number of values used.
+  const double size = static_cast<double>(this->GetSize()) * sizeof(vtkTypeUInt16);
+  return static_cast<unsigned long>(std::ceil(size / 1024.0));
+}
+
+//------------------------------------------------------------------------------
+void vtkHalfFloatArray::DeepCopy(vtkDataArray* other)
+{
+  vtkHalfFloatArray* half = vtkHalfFloatArray::FastDownCast(other);
+  vtkAOSDataArrayTemplate<float>* floats = vtkAOSDataArrayTemplate<float>::FastDownCast(other);
+  if (other == this || (!half && !floats))
+  {
+    this->Superclass::DeepCopy(other);
+    return;
+  }
+
+  // Same as vtkDataArray::DeepCopy, with the bulk copy or conversion of the values.
+  this->vtkAbstractArray::DeepCopy(other);
+  this->SetNumberOfComponents(other->GetNumberOfComponents());
+  this->SetNumberOfTuples(other->GetNumberOfTuples());
+  const vtkIdType numValues = this->GetNumberOfValues();
+  if (half)
+  {
+    std::copy_n(half->Buffer->GetBuffer(), numValues, this->Buffer->GetBuffer());
+  }
+  else
+  {
+    vtkHalfFloatArray::FloatToHalf(floats->GetPointer(0), this->Buffer->GetBuffer(), numValues);
+  }
+
+  this->SetLookupTable(nullptr);
+  if (vtkLookupTable* lut = other->GetLookupTable())
+  {
+    auto copy = vtk::TakeSmartPointer(lut->NewInstance());
+    copy->DeepCopy(lut);
+    this->SetLookupTable(copy);
+  }
+  this->Squeeze();
+}
+
+//------------------------------------------------------------------------------
+void vtkHalfFloatArray::ShallowCopy(vtkDataArray* other)
+{
+  vtkHalfFloatArray* o = vtkHalfFloatArray::FastDownCast(other);
+  if (o)
+  {
+    this->Size = o->Size;
+    this->MaxId = o->MaxId;
+    this->SetName(o->Name);
+    this->SetNumberOfComponents(o->NumberOfComponents);
+    this->CopyComponentNames(o);
+    if (this->Buffer != o->Buffer)
+    {
+      this->Buffer->Delete();
+      this->Buffer = o->Buffer;
+      this->Buffer->Register(nullptr);
+    }
+    this->DataChanged();
+  }
+  else
+  {
+    this->Superclass::ShallowCopy(other);
+  }
+}
+
+//------------------------------------------------------------------------------
+bool vtkHalfFloatArray::ComputeScalarRange(
+  double* ranges, const unsigned char* ghosts, unsigned char ghostsToSkip)
+{
+  return vtkDataArrayPrivate::DoComputeScalarRange(
+    this, ranges, vtkDataArrayPrivate::AllValues(), ghosts, ghostsToSkip);
+}
+
+//------------------------------------------------------------------------------
+bool vtkHalfFloatArray::ComputeVectorRange(
+  double range[2], const unsigned char* ghosts, unsigned char ghostsToSkip)
+{
+  return vtkDataArrayPrivate::DoComputeVectorRange(
+    this, range, vtkDataArrayPrivate::AllValues(), ghosts, ghostsToSkip);
+}
+
+//------------------------------------------------------------------------------
+bool vtkHalfFloatArray::ComputeFiniteScalarRange(
+  double* ranges, const unsigned char* ghosts, unsigned char ghostsToSkip)
+{
+  return vtkDataArrayPrivate::DoComputeScalarRange(
+    this, ranges, vtkDataArrayPrivate::FiniteValues(), ghosts, ghostsToSkip);
+}
+
+//------------------------------------------------------------------------------
+bool vtkHalfFloatArray::ComputeFiniteVectorRange(
+  double range[2], const unsigned char* ghosts, unsigned char ghostsToSkip)
+{
+  return vtkDataArrayPrivate::DoComputeVectorRange(
+    this, range, vtkDataArrayPrivate::FiniteValues(), ghosts, ghostsToSkip);
+}
+
+//------------------------------------------------------------------------------
+bool vtkHalfFloatArray::AllocateTuples(vtkIdType numTuples)
+{
+  vtkIdType numValues = numTuples * this->GetNumberOfComponents();
+  if (this->Buffer->Allocate(numValues))
+  {
+    this->Size = this->Buffer->GetSize();
+    return true;
+  }
+  return false;
+}
+
+//------------------------------------------------------------------------------
+bool vtkHalfFloatArray::ReallocateTuples(vtkIdType numTuples)
+{
+  vtkIdType newSize = numTuples * this->GetNumberOfComponents();
+  if (newSize == this->Size)
+  {
+    return true;
+  }
+
+  if (this->Buffer->Reallocate(newSize))
+  {
+    this->Size = this->Buffer->GetSize();
+    // Notify observers that the buffer may have changed
+    this->InvokeEvent(vtkCommand::BufferChangedEvent);
+    return true;
+  }
+  return false;
+}
+VTK_ABI_NAMESPACE_END
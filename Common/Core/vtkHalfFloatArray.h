@@ -0,0 +1,302 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class   vtkHalfFloatArray
+ * @brief   dynamic, self-adjusting array of 16-bit floating point values
+ *
+ * vtkHalfFloatArray stores its values as IEEE 754 half precision floating
+ * point numbers (1 sign bit, 5 exponent bits, 10 mantissa bits) in the array
+ * of structs layout, and exposes them as float: GetDataType() returns
+ * VTK_FLOAT, so the array can be used wherever a float array is expected.
+ * It halves the memory of fields which do not need more than 11 significant
+ * bits, typically fields only used for display. Values are rounded to the
+ * nearest half, values above 65504 in magnitude become infinite, values below
+ * 6.1e-5 in magnitude lose precision and values below 3e-8 become zero.
+ *
+ * The raw half values can be accessed with GetHalfPointer() to upload them
+ * to a GPU without conversion. Bulk conversions between float and half use
+ * the F16C instructions on x86 processors when the compiler targets them, and
+ * the conversion instructions of NEON on 64-bit ARM.
+ *
+ * The array is written as a Float32 array by the XML and HDF writers.
+ *
+ * vtkHalfFloatArray is only dispatched by vtkArrayDispatch when VTK is
+ * configured with VTK_DISPATCH_HALF_FLOAT_ARRAYS. Otherwise the generic
+ * algorithms go through the vtkDataArray API.
+ *
+ * @sa
+ * vtkGenericDataArray vtkFloatArray vtkQuantizedImplicitBackend
+ */
+
+#ifndef vtkHalfFloatArray_h
+#define vtkHalfFloatArray_h
+
+#include "vtkBuffer.h"           // For storage buffer
+#include "vtkCommonCoreModule.h" // For export macro
+#include "vtkCompiler.h"         // For VTK_USE_EXTERN_TEMPLATE
+#include "vtkGenericDataArray.h"
+
+#include <cstring> // For std::memcpy
+
+VTK_ABI_NAMESPACE_BEGIN
+class VTKCOMMONCORE_EXPORT vtkHalfFloatArray
+  : public vtkGenericDataArray<vtkHalfFloatArray, float, vtkArrayTypes::VTK_HALF_FLOAT_ARRAY>
+{
+  using GenericDataArrayType =
+    vtkGenericDataArray<vtkHalfFloatArray, float, vtkArrayTypes::VTK_HALF_FLOAT_ARRAY>;
+
+public:
+  vtkTypeMacro(vtkHalfFloatArray, GenericDataArrayType);
+  using typename Superclass::ArrayTypeTag;
+  using typename Superclass::DataTypeTag;
+  using typename Superclass::ValueType;
+
+  static vtkHalfFloatArray* New();
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  ///@{
+  /**
+   * Convert a single value between float and half precision, rounding to
+   * the nearest half. NaN values stay NaN.
+   */
+  static vtkTypeUInt16 FloatToHalf(float value)
+  {
+    vtkTypeUInt32 bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    const vtkTypeUInt32 sign = bits & 0x80000000u;
+    bits ^= sign;
+    vtkTypeUInt32 half;
+    if (bits >= 0x47800000u)
+    {
+      // Overflow to infinity, NaN stays NaN.
+      half = bits > 0x7f800000u ? 0x7e00u : 0x7c00u;
+    }
+    else if (bits < 0x38800000u)
+    {
+      // Subnormal half or zero: align the mantissa with a magic addition,
+      // which rounds to nearest even.
+      const vtkTypeUInt32 magicBits = 126u << 23;
+      float magic, shifted;
+      std::memcpy(&magic, &magicBits, sizeof(magic));
+      std::memcpy(&shifted, &bits, sizeof(shifted));
+      shifted += magic;
+      std::memcpy(&bits, &shifted, sizeof(bits));
+      half = bits - magicBits;
+    }
+    else
+    {
+      // Normal half: rebias the exponent and round to nearest even.
+      const vtkTypeUInt32 odd = (bits >> 13) & 1u;
+      bits += 0xc8000fffu + odd;
+      half = bits >> 13;
+    }
+    return static_cast<vtkTypeUInt16>(half | (sign >> 16));
+  }
+  static float HalfToFloat(vtkTypeUInt16 value)
+  {
+    constexpr vtkTypeUInt32 exponentMask = 0x7c00u << 13;
+    vtkTypeUInt32 bits = (value & 0x7fffu) << 13;
+    const vtkTypeUInt32 exponent = bits & exponentMask;
+    bits += (127u - 15u) << 23;
+    float result;
+    if (exponent == exponentMask)
+    {
+      // Infinity or NaN.
+      bits += (128u - 16u) << 23;
+    }
+    else if (exponent == 0)
+    {
+      // Zero or subnormal: renormalize.
+      const vtkTypeUInt32 magicBits = 113u << 23;
+      float magic;
+      std::memcpy(&magic, &magicBits, sizeof(magic));
+      bits += 1u << 23;
+      std::memcpy(&result, &bits, sizeof(result));
+      result -= magic;
+      std::memcpy(&bits, &result, sizeof(bits));
+    }
+    bits |= static_cast<vtkTypeUInt32>(value & 0x8000u) << 16;
+    std::memcpy(&result, &bits, sizeof(result));
+    return result;
+  }
+  ///@}
+
+  ///@{
+  /**
+   * Convert n values between float and half precision. These are the
+   * vectorized versions of FloatToHalf and HalfToFloat.
+   */
+  static void FloatToHalf(const float* values, vtkTypeUInt16* halves, vtkIdType n);
+  static void HalfToFloat(const vtkTypeUInt16* halves, float* values, vtkIdType n);
+  ///@}
+
+  /**
+   * Get the value at @a valueIdx. @a valueIdx assumes AOS ordering.
+   */
+  ValueType GetValue(vtkIdType valueIdx) const
+    VTK_EXPECTS(0 <= valueIdx && valueIdx < GetNumberOfValues())
+  {
+    return vtkHalfFloatArray::HalfToFloat(this->Buffer->GetBuffer()[valueIdx]);
+  }
+
+  /**
+   * Set the value at @a valueIdx to @a value. @a valueIdx assumes AOS ordering.
+   */
+  void SetValue(vtkIdType valueIdx, ValueType value)
+    VTK_EXPECTS(0 <= valueIdx && valueIdx < GetNumberOfValues())
+  {
+    this->Buffer->GetBuffer()[valueIdx] = vtkHalfFloatArray::FloatToHalf(value);
+  }
+
+  /**
+   * Copy the tuple at @a tupleIdx into @a tuple.
+   */
+  void GetTypedTuple(vtkIdType tupleIdx, ValueType* tuple) const
+    VTK_EXPECTS(0 <= tupleIdx && tupleIdx < GetNumberOfTuples())
+  {
+    const vtkTypeUInt16* halves = this->Buffer->GetBuffer() + tupleIdx * this->NumberOfComponents;
+    for (int c = 0; c < this->NumberOfComponents; ++c)
+    {
+      tuple[c] = vtkHalfFloatArray::HalfToFloat(halves[c]);
+    }
+  }
+
+  /**
+   * Set this array's tuple at @a tupleIdx to the values in @a tuple.
+   */
+  void SetTypedTuple(vtkIdType tupleIdx, const ValueType* tuple)
+    VTK_EXPECTS(0 <= tupleIdx && tupleIdx < GetNumberOfTuples())
+  {
+    vtkTypeUInt16* halves = this->Buffer->GetBuffer() + tupleIdx * this->NumberOfComponents;
+    for (int c = 0; c < this->NumberOfComponents; ++c)
+    {
+      halves[c] = vtkHalfFloatArray::FloatToHalf(tuple[c]);
+    }
+  }
+
+  /**
+   * Get component @a comp of the tuple at @a tupleIdx.
+   */
+  ValueType GetTypedComponent(vtkIdType tupleIdx, int comp) const
+    VTK_EXPECTS(0 <= tupleIdx && GetNumberOfComponents() * tupleIdx + comp < GetNumberOfValues())
+      VTK_EXPECTS(0 <= comp && comp < GetNumberOfComponents())
+  {
+    return this->GetValue(this->NumberOfComponents * tupleIdx + comp);
+  }
+
+  /**
+   * Set component @a comp of the tuple at @a tupleIdx to @a value.
+   */
+  void SetTypedComponent(vtkIdType tupleIdx, int comp, ValueType value)
+    VTK_EXPECTS(0 <= tupleIdx && GetNumberOfComponents() * tupleIdx + comp < GetNumberOfValues())
+      VTK_EXPECTS(0 <= comp && comp < GetNumberOfComponents())
+  {
+    this->SetValue(this->NumberOfComponents * tupleIdx + comp, value);
+  }
+
+  ///@{
+  /**
+   * Copy n values starting at @a valueIdx from or to float values, using
+   * the vectorized conversions. The array must hold the values.
+   */
+  void GetFloatValues(vtkIdType valueIdx, vtkIdType n, float* values) const;
+  void SetFloatValues(vtkIdType valueIdx, vtkIdType n, const float* values);
+  ///@}
+
+  /**
+   * Set all the values in array to @a value.
+   */
+  void FillValue(ValueType value) override;
+
+  /**
+   * Get the address of the half value at @a valueIdx, e.g. to upload the
+   * values to a GPU as 16-bit floats.
+   */
+  vtkTypeUInt16* GetHalfPointer(vtkIdType valueIdx) VTK_EXPECTS(0 <= valueIdx)
+  {
+    return this->Buffer->GetBuffer() + valueIdx;
+  }
+
+  /**
+   * Use an externally allocated buffer of @a size half values. With @a save
+   * true the array does not release the buffer, otherwise it releases it with
+   * @a deleteMethod. The number of values is set to @a size.
+   */
+  void SetHalfArray(VTK_ZEROCOPY vtkTypeUInt16* array, vtkIdType size, bool save,
+    int deleteMethod = VTK_DATA_ARRAY_FREE);
+
+  /**
+   * Return the memory used by the half values, in KiB.
+   */
+  unsigned long GetActualMemorySize() const override;
+
+  ///@{
+  /**
+   * Copies of vtkHalfFloatArray and of float arrays use the bulk conversions.
+   * ShallowCopy shares the buffer of another vtkHalfFloatArray.
+   */
+  void DeepCopy(vtkDataArray* other) override;
+  using Superclass::DeepCopy;
+  void ShallowCopy(vtkDataArray* other) override;
+  using Superclass::ShallowCopy;
+  ///@}
+
+protected:
+  vtkHalfFloatArray();
+  ~vtkHalfFloatArray() override;
+
+  ///@{
+  /**
+   * The ranges are computed on the half values directly.
+   */
+  bool ComputeScalarRange(
+    double* ranges, const unsigned char* ghosts, unsigned char ghostsToSkip = 0xff) override;
+  using Superclass::ComputeScalarRange;
+  bool ComputeVectorRange(
+    double range[2], const unsigned char* ghosts, unsigned char ghostsToSkip = 0xff) override;
+  using Superclass::ComputeVectorRange;
+  bool ComputeFiniteScalarRange(
+    double* ranges, const unsigned char* ghosts, unsigned char ghostsToSkip = 0xff) override;
+  using Superclass::ComputeFiniteScalarRange;
+  bool ComputeFiniteVectorRange(
+    double range[2], const unsigned char* ghosts, unsigned char ghostsToSkip = 0xff) override;
+  using Superclass::ComputeFiniteVectorRange;
+  ///@}
+
+  /**
+   * Allocate space for numTuples. Old data is not preserved. If numTuples == 0,
+   * all data is freed.
+   */
+  bool AllocateTuples(vtkIdType numTuples);
+
+  /**
+   * Allocate space for numTuples. Old data is preserved. If numTuples == 0,
+   * all data is freed.
+   */
+  bool ReallocateTuples(vtkIdType numTuples);
+
+  vtkBuffer<vtkTypeUInt16>* Buffer;
+
+private:
+  vtkHalfFloatArray(const vtkHalfFloatArray&) = delete;
+  void operator=(const vtkHalfFloatArray&) = delete;
+
+  friend class vtkGenericDataArray<vtkHalfFloatArray, float, vtkArrayTypes::VTK_HALF_FLOAT_ARRAY>;
+};
+
+// Define vtkArrayDownCast implementation:
+vtkArrayDownCast_FastCastMacro(vtkHalfFloatArray);
+
+VTK_ABI_NAMESPACE_END
+
+#if defined(VTK_USE_EXTERN_TEMPLATE) && !defined(VTK_HALF_FLOAT_ARRAY_INSTANTIATING)
+namespace vtkDataArrayPrivate
+{
+VTK_ABI_NAMESPACE_BEGIN
+// This is instantiated in vtkHalfFloatArray.cxx
+VTK_DECLARE_VALUERANGE_ARRAYTYPE(vtkHalfFloatArray, double)
+VTK_ABI_NAMESPACE_END
+}
+#endif
+
+#endif // vtkHalfFloatArray_h
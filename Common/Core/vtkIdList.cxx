@@ -2,7 +2,8 @@
 // SPDX-License-Identifier: BSD-3-Clause
 #include "vtkIdList.h"
 #include "vtkObjectFactory.h"
-#include "vtkSMPTools.h" //for parallel sort
+#include "vtkSMPTools.h"     //for parallel sort
+#include "vtkScratchArena.h" // for allocation counters
 
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkIdList);
@@ -14,6 +15,7 @@ vtkIdList::vtkIdList()
   this->Size = 0;
   this->Ids = nullptr;
   this->ManageMemory = true;
+  vtkScratchArena::CountHeapAllocation(sizeof(vtkIdList));
 }
 
 //------------------------------------------------------------------------------
@@ -61,6 +63,7 @@ bool vtkIdList::AllocateInternal(vtkIdType sz, vtkIdType numberOfIds)
     this->InitializeMemory();
     this->Size = (sz > 0 ? sz : 1);
     this->Ids = new vtkIdType[this->Size];
+    vtkScratchArena::CountHeapAllocation(this->Size * sizeof(vtkIdType));
     if (this->Ids == nullptr)
     {
       vtkErrorMacro("Could not allocate memory for " << this->Size << " ids.");
@@ -202,6 +205,7 @@ vtkIdType* vtkIdList::Resize(const vtkIdType sz)
     vtkErrorMacro(<< "Cannot allocate memory\n");
     return nullptr;
   }
+  vtkScratchArena::CountHeapAllocation(newSize * sizeof(vtkIdType));
 
   this->NumberOfIds = std::min(this->NumberOfIds, newSize);
 
@@ -252,6 +256,7 @@ void vtkIdList::IntersectWith(vtkIdList* otherIds)
   else
   { // use slower method for extreme cases
     vtkIdType* thisIds = new vtkIdType[thisNumIds];
+    vtkScratchArena::CountHeapAllocation(thisNumIds * sizeof(vtkIdType));
     vtkIdType i, vtkid;
 
     for (i = 0; i < thisNumIds; i++)
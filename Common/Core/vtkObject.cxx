@@ -212,7 +212,9 @@ vtkObject::vtkObject()
 {
   this->Debug = false;
   this->SubjectHelper = nullptr;
-  this->Modified(); // Ensures modified time > than any other time
+  // Ensures modified time > than any other time. No observer can be there
+  // yet, so skip the ModifiedEvent of Modified().
+  this->MTime.Modified();
   // initial reference count = 1 and reference counting on.
 }
 
@@ -127,9 +127,9 @@ ostream& operator<<(ostream& os, vtkObjectBase& o)
 // Create an object with Debug turned off and modified time initialized
 // to zero.
 vtkObjectBase::vtkObjectBase()
+  : ReferenceCount(1) // not assigned, to avoid a sequentially consistent store
+  , WeakPointers(nullptr)
 {
-  this->ReferenceCount = 1;
-  this->WeakPointers = nullptr;
 #ifdef VTK_DEBUG_LEAKS
   vtkDebugLeaks::ConstructingObject(this);
 #endif
@@ -297,7 +297,9 @@ void vtkObjectBase::RegisterInternal(vtkObjectBase*, vtkTypeBool check)
   // count.
   if (!(check && vtkObjectBaseToGarbageCollectorFriendship::TakeReference(this)))
   {
-    this->ReferenceCount++;
+    // A new reference is always made from an existing one, which keeps the
+    // object alive: the increment needs atomicity but no ordering.
+    this->ReferenceCount.fetch_add(1, std::memory_order_relaxed);
   }
 }
 
@@ -313,7 +315,10 @@ void vtkObjectBase::UnRegisterInternal(vtkObjectBase*, vtkTypeBool check)
   }
 
   // Decrement the reference count, delete object if count goes to zero.
-  if (--this->ReferenceCount <= 0)
+  // The release makes the writes of this thread visible to the thread that
+  // deletes the object, the acquire makes the writes of all the other
+  // threads visible before the deletion.
+  if (this->ReferenceCount.fetch_sub(1, std::memory_order_acq_rel) <= 1)
   {
     // Let subclasses know the object is on its way out.
     this->ObjectFinalize();
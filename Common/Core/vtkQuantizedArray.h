@@ -0,0 +1,35 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+#ifndef vtkQuantizedArray_h
+#define vtkQuantizedArray_h
+
+#include "vtkImplicitArray.h"
+#include "vtkQuantizedImplicitBackend.h" // for the array backend
+
+/**
+ * \var vtkQuantizedArray
+ * \brief An implicit array storing its values as 8 or 16 bits integer codes.
+ *
+ * Each component of each block of tuples is mapped linearly to the codes, so
+ * that the error is bounded by half the quantization step of the block. See
+ * vtkQuantizedImplicitBackend for the details.
+ *
+ * An example of potential usage:
+ * ```
+ * vtkNew<vtkQuantizedArray<float>> quantized;
+ * quantized->ConstructBackend(explicitArray, 16, 1024);
+ * quantized->SetNumberOfComponents(explicitArray->GetNumberOfComponents());
+ * quantized->SetNumberOfTuples(explicitArray->GetNumberOfTuples());
+ * double error = quantized->GetBackend()->GetMaximumError();
+ * ```
+ *
+ * @sa
+ * vtkImplicitArray vtkQuantizedImplicitBackend vtkHalfFloatArray
+ */
+
+VTK_ABI_NAMESPACE_BEGIN
+template <typename T>
+using vtkQuantizedArray = vtkImplicitArray<vtkQuantizedImplicitBackend<T>>;
+VTK_ABI_NAMESPACE_END
+
+#endif // vtkQuantizedArray_h
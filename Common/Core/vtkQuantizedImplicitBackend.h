@@ -0,0 +1,115 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+#ifndef vtkQuantizedImplicitBackend_h
+#define vtkQuantizedImplicitBackend_h
+
+/**
+ * \class vtkQuantizedImplicitBackend
+ *
+ * A backend for the `vtkImplicitArray` framework storing the values of an array as integer codes
+ * of 8 or 16 bits, i.e. a lossy compression with a bounded error.
+ *
+ * The values are split in blocks of whole tuples. In each block, each component is mapped linearly
+ * from its [min, max] range to the codes [0, 2^NumberOfBits - 1], and a value is read back as
+ * `min + code * step`. The absolute error of a value is at most half the step of its block and
+ * component, which is reported by `GetMaximumError`. The values of integral types are rounded to
+ * the nearest integer. Non finite values are not preserved.
+ *
+ * The scale and shift are kept per block, so that a few large values only degrade the precision of
+ * their block. With 16 bits, a double array uses a fourth of its memory.
+ *
+ * An example of potential usage in a `vtkImplicitArray`:
+ * ```
+ * vtkNew<vtkQuantizedArray<double>> quantized;
+ * quantized->ConstructBackend(explicitArray, 16, 1024);
+ * quantized->SetNumberOfComponents(explicitArray->GetNumberOfComponents());
+ * quantized->SetNumberOfTuples(explicitArray->GetNumberOfTuples());
+ * ```
+ *
+ * @sa
+ * vtkImplicitArray, vtkQuantizedArray, vtkHalfFloatArray
+ */
+
+#include "vtkCommonCoreModule.h"
+
+#include "vtkType.h"
+
+#include <memory>
+
+VTK_ABI_NAMESPACE_BEGIN
+class vtkDataArray;
+template <typename ValueType>
+class VTKCOMMONCORE_EXPORT vtkQuantizedImplicitBackend final
+{
+public:
+  /**
+   * Quantize the values of array on numberOfBits bits, clamped to [1, 16], by
+   * blocks of blockSize tuples.
+   */
+  vtkQuantizedImplicitBackend(
+    vtkDataArray* array, int numberOfBits = 16, vtkIdType blockSize = 1024);
+  ~vtkQuantizedImplicitBackend();
+
+  /**
+   * Indexing operation for the quantized array respecting the backend expectations of
+   * `vtkImplicitArray`
+   */
+  ValueType operator()(vtkIdType idx) const;
+
+  /**
+   * Fill tuple with the components of the tuple tupleIdx.
+   */
+  void mapTuple(vtkIdType tupleIdx, ValueType* tuple) const;
+
+  ///@{
+  /**
+   * Information about the quantization.
+   */
+  int GetNumberOfBits() const;
+  vtkIdType GetBlockSize() const;
+  ///@}
+
+  /**
+   * Return the largest absolute difference between a value of the array given
+   * to the constructor and the value read back, before rounding for integral types.
+   */
+  double GetMaximumError() const;
+
+  /**
+   * Returns the smallest integer memory size in KiB needed to store the array.
+   * Used to implement GetActualMemorySize on `vtkQuantizedImplicitBackend`.
+   */
+  unsigned long getMemorySize() const;
+
+private:
+  struct Internals;
+  std::unique_ptr<Internals> Internal;
+};
+VTK_ABI_NAMESPACE_END
+
+#endif // vtkQuantizedImplicitBackend_h
+
+#if defined(VTK_QUANTIZED_BACKEND_INSTANTIATING)
+
+#define VTK_INSTANTIATE_QUANTIZED_BACKEND(ValueType)                                               \
+  VTK_ABI_NAMESPACE_BEGIN                                                                          \
+  template class VTKCOMMONCORE_EXPORT vtkQuantizedImplicitBackend<ValueType>;                      \
+  VTK_ABI_NAMESPACE_END
+
+#elif defined(VTK_USE_EXTERN_TEMPLATE)
+
+#ifndef VTK_QUANTIZED_BACKEND_TEMPLATE_EXTERN
+#define VTK_QUANTIZED_BACKEND_TEMPLATE_EXTERN
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable : 4910) // extern and dllexport incompatible
+#endif
+VTK_ABI_NAMESPACE_BEGIN
+vtkExternTemplateMacro(extern template class VTKCOMMONCORE_EXPORT vtkQuantizedImplicitBackend);
+VTK_ABI_NAMESPACE_END
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+#endif // VTK_QUANTIZED_BACKEND_TEMPLATE_EXTERN
+
+#endif
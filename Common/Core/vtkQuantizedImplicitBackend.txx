@@ -0,0 +1,183 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkQuantizedImplicitBackend.h"
+
+#include "vtkDataArray.h"
+#include "vtkDataArrayRange.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+VTK_ABI_NAMESPACE_BEGIN
+//-----------------------------------------------------------------------
+template <typename ValueType>
+struct vtkQuantizedImplicitBackend<ValueType>::Internals
+{
+  // Linear map of the codes of one component in one block.
+  struct Scale
+  {
+    double Min = 0.0;
+    double Step = 0.0;
+  };
+
+  vtkTypeUInt16 GetCode(vtkIdType idx) const
+  {
+    return this->NumberOfBits > 8 ? this->Codes16[idx] : this->Codes8[idx];
+  }
+
+  ValueType Decode(vtkIdType idx, int comp) const
+  {
+    const Scale& scale =
+      this->Scales[(idx / this->BlockSize) * this->NumberOfComponents + comp];
+    const double value = scale.Min + this->GetCode(idx) * scale.Step;
+    if (std::is_integral<ValueType>::value)
+    {
+      return static_cast<ValueType>(std::round(value));
+    }
+    return static_cast<ValueType>(value);
+  }
+
+  int NumberOfBits = 16;
+  int NumberOfComponents = 1;
+  // Number of values per block, i.e. a whole number of tuples.
+  vtkIdType BlockSize = 1;
+  std::vector<Scale> Scales;
+  std::vector<vtkTypeUInt8> Codes8;
+  std::vector<vtkTypeUInt16> Codes16;
+};
+
+//-----------------------------------------------------------------------
+template <typename ValueType>
+vtkQuantizedImplicitBackend<ValueType>::vtkQuantizedImplicitBackend(
+  vtkDataArray* array, int numberOfBits, vtkIdType blockSize)
+  : Internal(new Internals())
+{
+  auto& internals = *this->Internal;
+  internals.NumberOfBits = std::min(std::max(numberOfBits, 1), 16);
+  if (!array)
+  {
+    return;
+  }
+  const int nComps = array->GetNumberOfComponents();
+  const vtkIdType numberOfValues = array->GetNumberOfValues();
+  internals.NumberOfComponents = nComps;
+  internals.BlockSize = std::max<vtkIdType>(blockSize, 1) * nComps;
+  const vtkIdType numberOfBlocks = (numberOfValues + internals.BlockSize - 1) / internals.BlockSize;
+  internals.Scales.resize(static_cast<std::size_t>(numberOfBlocks * nComps));
+  if (internals.NumberOfBits > 8)
+  {
+    internals.Codes16.resize(static_cast<std::size_t>(numberOfValues));
+  }
+  else
+  {
+    internals.Codes8.resize(static_cast<std::size_t>(numberOfValues));
+  }
+
+  const double maxCode = static_cast<double>((1 << internals.NumberOfBits) - 1);
+  const auto values = vtk::DataArrayValueRange(array);
+  for (vtkIdType blockId = 0; blockId < numberOfBlocks; ++blockId)
+  {
+    const vtkIdType begin = blockId * internals.BlockSize;
+    const vtkIdType end = std::min(begin + internals.BlockSize, numberOfValues);
+    for (int comp = 0; comp < nComps; ++comp)
+    {
+      double min = std::numeric_limits<double>::max();
+      double max = std::numeric_limits<double>::lowest();
+      for (vtkIdType idx = begin + comp; idx < end; idx += nComps)
+      {
+        const double value = values[idx];
+        if (std::isfinite(value))
+        {
+          min = std::min(min, value);
+          max = std::max(max, value);
+        }
+      }
+      if (min > max)
+      {
+        min = max = 0.0;
+      }
+
+      auto& scale = internals.Scales[blockId * nComps + comp];
+      scale.Min = min;
+      scale.Step = (max - min) / maxCode;
+      const double invStep = scale.Step > 0.0 ? 1.0 / scale.Step : 0.0;
+      for (vtkIdType idx = begin + comp; idx < end; idx += nComps)
+      {
+        double code = std::round((values[idx] - min) * invStep);
+        code = std::isnan(code) ? 0.0 : std::min(std::max(code, 0.0), maxCode);
+        if (internals.NumberOfBits > 8)
+        {
+          internals.Codes16[idx] = static_cast<vtkTypeUInt16>(code);
+        }
+        else
+        {
+          internals.Codes8[idx] = static_cast<vtkTypeUInt8>(code);
+        }
+      }
+    }
+  }
+}
+
+//-----------------------------------------------------------------------
+template <typename ValueType>
+vtkQuantizedImplicitBackend<ValueType>::~vtkQuantizedImplicitBackend() = default;
+
+//-----------------------------------------------------------------------
+template <typename ValueType>
+ValueType vtkQuantizedImplicitBackend<ValueType>::operator()(vtkIdType idx) const
+{
+  return this->Internal->Decode(idx, static_cast<int>(idx % this->Internal->NumberOfComponents));
+}
+
+//-----------------------------------------------------------------------
+template <typename ValueType>
+void vtkQuantizedImplicitBackend<ValueType>::mapTuple(vtkIdType tupleIdx, ValueType* tuple) const
+{
+  const auto& internals = *this->Internal;
+  const vtkIdType idx = tupleIdx * internals.NumberOfComponents;
+  for (int comp = 0; comp < internals.NumberOfComponents; ++comp)
+  {
+    tuple[comp] = internals.Decode(idx + comp, comp);
+  }
+}
+
+//-----------------------------------------------------------------------
+template <typename ValueType>
+int vtkQuantizedImplicitBackend<ValueType>::GetNumberOfBits() const
+{
+  return this->Internal->NumberOfBits;
+}
+
+//-----------------------------------------------------------------------
+template <typename ValueType>
+vtkIdType vtkQuantizedImplicitBackend<ValueType>::GetBlockSize() const
+{
+  return this->Internal->BlockSize / this->Internal->NumberOfComponents;
+}
+
+//-----------------------------------------------------------------------
+template <typename ValueType>
+double vtkQuantizedImplicitBackend<ValueType>::GetMaximumError() const
+{
+  double step = 0.0;
+  for (const auto& scale : this->Internal->Scales)
+  {
+    step = std::max(step, scale.Step);
+  }
+  return 0.5 * step;
+}
+
+//-----------------------------------------------------------------------
+template <typename ValueType>
+unsigned long vtkQuantizedImplicitBackend<ValueType>::getMemorySize() const
+{
+  const auto& internals = *this->Internal;
+  const std::size_t size = internals.Codes8.size() +
+    internals.Codes16.size() * sizeof(vtkTypeUInt16) +
+    internals.Scales.size() * sizeof(typename Internals::Scale);
+  return static_cast<unsigned long>(std::max<std::size_t>((size + 1023) / 1024, 1));
+}
+VTK_ABI_NAMESPACE_END
@@ -5,6 +5,10 @@
 
 #include "vtkSMP.h"
 
+#include <algorithm>
+#include <map>
+#include <string>
+
 //------------------------------------------------------------------------------
 VTK_ABI_NAMESPACE_BEGIN
 const char* vtkSMPTools::GetBackend()
@@ -55,6 +59,20 @@ bool vtkSMPTools::GetNestedParallelism()
   return SMPToolsAPI.GetNestedParallelism();
 }
 
+//------------------------------------------------------------------------------
+void vtkSMPTools::SetWorkStealing(bool enable)
+{
+  auto& SMPToolsAPI = vtk::detail::smp::vtkSMPToolsAPI::GetInstance();
+  SMPToolsAPI.SetWorkStealing(enable);
+}
+
+//------------------------------------------------------------------------------
+bool vtkSMPTools::GetWorkStealing()
+{
+  auto& SMPToolsAPI = vtk::detail::smp::vtkSMPToolsAPI::GetInstance();
+  return SMPToolsAPI.GetWorkStealing();
+}
+
 //------------------------------------------------------------------------------
 bool vtkSMPTools::IsParallelScope()
 {
@@ -68,4 +86,98 @@ bool vtkSMPTools::GetSingleThread()
   auto& SMPToolsAPI = vtk::detail::smp::vtkSMPToolsAPI::GetInstance();
   return SMPToolsAPI.GetSingleThread();
 }
+
+//------------------------------------------------------------------------------
+vtkIdType vtkSMPTools::GetNumberOfForCalls()
+{
+  return vtk::detail::smp::vtkSMPToolsAPI::GetNumberOfForCalls();
+}
+
+//------------------------------------------------------------------------------
+void vtkSMPTools::SetInstrumentation(bool enable)
+{
+  vtk::detail::smp::vtkSMPToolsAPI::SetInstrumentation(enable);
+}
+
+//------------------------------------------------------------------------------
+bool vtkSMPTools::GetInstrumentation()
+{
+  return vtk::detail::smp::vtkSMPToolsAPI::GetInstrumentation();
+}
+
+//------------------------------------------------------------------------------
+std::vector<vtkSMPTools::LoopStatistics> vtkSMPTools::GetLoopStatistics()
+{
+  return vtk::detail::smp::vtkSMPToolsAPI::GetLoopStatistics();
+}
+
+//------------------------------------------------------------------------------
+void vtkSMPTools::ClearLoopStatistics()
+{
+  vtk::detail::smp::vtkSMPToolsAPI::ClearLoopStatistics();
+}
+
+//------------------------------------------------------------------------------
+void vtkSMPTools::PrintLoopStatistics(ostream& os)
+{
+  struct Summary
+  {
+    std::string Label;
+    vtkIdType Calls = 0;
+    vtkIdType Size = 0;
+    vtkIdType Chunks = 0;
+    vtkIdType MinimumGrain = VTK_ID_MAX;
+    vtkIdType MaximumGrain = 0;
+    double WallTime = 0.0;
+    double Imbalance = 0.0;
+    double MaximumImbalance = 0.0;
+    double Efficiency = 0.0;
+  };
+  std::map<std::string, Summary> summaries;
+  for (const LoopStatistics& loop : vtkSMPTools::GetLoopStatistics())
+  {
+    Summary& summary = summaries[loop.Label];
+    summary.Label = loop.Label.empty() ? "(no label)" : loop.Label;
+    ++summary.Calls;
+    summary.Size += loop.Last - loop.First;
+    summary.Chunks += loop.NumberOfChunks;
+    summary.MinimumGrain = std::min(summary.MinimumGrain, loop.Grain);
+    summary.MaximumGrain = std::max(summary.MaximumGrain, loop.Grain);
+    summary.WallTime += loop.WallTime;
+    // Weighted by time, so that the long loops dominate.
+    summary.Imbalance += loop.Imbalance * loop.WallTime;
+    summary.MaximumImbalance = std::max(summary.MaximumImbalance, loop.Imbalance);
+    summary.Efficiency += loop.Efficiency * loop.WallTime;
+  }
+  std::vector<const Summary*> sorted;
+  for (const auto& summary : summaries)
+  {
+    sorted.push_back(&summary.second);
+  }
+  std::sort(sorted.begin(), sorted.end(),
+    [](const Summary* a, const Summary* b) { return a->WallTime > b->WallTime; });
+
+  os << "vtkSMPTools::For() statistics (" << vtkSMPTools::GetBackend() << ", "
+     << vtkSMPTools::GetEstimatedNumberOfThreads() << " threads)\n";
+  for (const Summary* summary : sorted)
+  {
+    const double time = summary->WallTime > 0.0 ? summary->WallTime : 1.0;
+    os << summary->Label << ": " << summary->Calls << " calls, " << summary->WallTime << " s\n"
+       << "  grain: ";
+    if (summary->MinimumGrain == summary->MaximumGrain)
+    {
+      os << summary->MinimumGrain;
+    }
+    else
+    {
+      os << summary->MinimumGrain << " to " << summary->MaximumGrain;
+    }
+    os << ", chunks per call: " << static_cast<double>(summary->Chunks) / summary->Calls
+       << ", mean chunk size: "
+       << (summary->Chunks ? static_cast<double>(summary->Size) / summary->Chunks : 0.0) << "\n"
+       << "  imbalance: " << summary->Imbalance / time
+       << " (worst " << summary->MaximumImbalance << ")"
+       << ", efficiency: " << 100.0 * summary->Efficiency / time << "%\n";
+  }
+}
 VTK_ABI_NAMESPACE_END
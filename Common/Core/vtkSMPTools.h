@@ -24,8 +24,11 @@
 #include "SMP/Common/vtkSMPToolsAPI.h"
 #include "vtkSMPThreadLocal.h" // For Initialized
 
+#include <algorithm>   // For std::min, std::max
+#include <chrono>      // For instrumentation
 #include <functional>  // For std::function
 #include <type_traits> // For std:::enable_if
+#include <vector>      // For GetLoopStatistics
 
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
 namespace vtk
@@ -71,6 +74,63 @@ public:
   static bool const value = sizeof(check<T>(0)) == sizeof(yes_type);
 };
 
+// Times the chunks executed by each thread, see vtkSMPTools::SetInstrumentation().
+template <typename FunctorInternal>
+struct vtkSMPTools_InstrumentedFunctor
+{
+  using Clock = std::chrono::steady_clock;
+
+  struct ThreadStatistics
+  {
+    double BusyTime = 0.0;
+    vtkIdType NumberOfChunks = 0;
+    vtkIdType MinimumChunkSize = VTK_ID_MAX;
+    vtkIdType MaximumChunkSize = 0;
+  };
+
+  FunctorInternal& FI;
+  vtkSMPThreadLocal<ThreadStatistics> Threads;
+  vtkSMPTools_InstrumentedFunctor(FunctorInternal& fi)
+    : FI(fi)
+  {
+  }
+  void Execute(vtkIdType first, vtkIdType last)
+  {
+    const Clock::time_point start = Clock::now();
+    this->FI.Execute(first, last);
+    ThreadStatistics& thread = this->Threads.Local();
+    thread.BusyTime += std::chrono::duration<double>(Clock::now() - start).count();
+    ++thread.NumberOfChunks;
+    thread.MinimumChunkSize = std::min(thread.MinimumChunkSize, last - first);
+    thread.MaximumChunkSize = std::max(thread.MaximumChunkSize, last - first);
+  }
+  void For(vtkIdType first, vtkIdType last, vtkIdType grain)
+  {
+    auto& SMPToolsAPI = vtkSMPToolsAPI::GetInstance();
+    const Clock::time_point start = Clock::now();
+    SMPToolsAPI.For(first, last, grain, *this);
+
+    vtkSMPToolsLoopStatistics statistics;
+    statistics.WallTime = std::chrono::duration<double>(Clock::now() - start).count();
+    statistics.First = first;
+    statistics.Last = last;
+    statistics.Grain = grain;
+    statistics.MinimumChunkSize = VTK_ID_MAX;
+    for (const ThreadStatistics& thread : this->Threads)
+    {
+      statistics.BusyTimes.push_back(thread.BusyTime);
+      statistics.NumberOfChunks += thread.NumberOfChunks;
+      statistics.MinimumChunkSize = std::min(statistics.MinimumChunkSize, thread.MinimumChunkSize);
+      statistics.MaximumChunkSize = std::max(statistics.MaximumChunkSize, thread.MaximumChunkSize);
+    }
+    if (statistics.NumberOfChunks == 0)
+    {
+      statistics.MinimumChunkSize = 0;
+    }
+    vtkSMPToolsAPI::AddLoopStatistics(std::move(statistics));
+  }
+};
+
 template <typename Functor, bool Init>
 struct vtkSMPTools_FunctorInternal;
 
@@ -85,8 +145,16 @@ struct vtkSMPTools_FunctorInternal<Functor, false>
   void Execute(vtkIdType first, vtkIdType last) { this->F(first, last); }
   void For(vtkIdType first, vtkIdType last, vtkIdType grain)
   {
-    auto& SMPToolsAPI = vtkSMPToolsAPI::GetInstance();
-    SMPToolsAPI.For(first, last, grain, *this);
+    if (vtkSMPToolsAPI::GetInstrumentation())
+    {
+      vtkSMPTools_InstrumentedFunctor<vtkSMPTools_FunctorInternal> instrumented(*this);
+      instrumented.For(first, last, grain);
+    }
+    else
+    {
+      auto& SMPToolsAPI = vtkSMPToolsAPI::GetInstance();
+      SMPToolsAPI.For(first, last, grain, *this);
+    }
   }
   vtkSMPTools_FunctorInternal<Functor, false>& operator=(
     const vtkSMPTools_FunctorInternal<Functor, false>&);
@@ -115,8 +183,16 @@ struct vtkSMPTools_FunctorInternal<Functor, true>
   }
   void For(vtkIdType first, vtkIdType last, vtkIdType grain)
   {
-    auto& SMPToolsAPI = vtkSMPToolsAPI::GetInstance();
-    SMPToolsAPI.For(first, last, grain, *this);
+    if (vtkSMPToolsAPI::GetInstrumentation())
+    {
+      vtkSMPTools_InstrumentedFunctor<vtkSMPTools_FunctorInternal> instrumented(*this);
+      instrumented.For(first, last, grain);
+    }
+    else
+    {
+      auto& SMPToolsAPI = vtkSMPToolsAPI::GetInstance();
+      SMPToolsAPI.For(first, last, grain, *this);
+    }
     this->F.Reduce();
   }
   vtkSMPTools_FunctorInternal<Functor, true>& operator=(
@@ -437,6 +513,27 @@ public:
    */
   static bool GetNestedParallelism();
 
+  /**
+   * /!\ This method is not thread safe.
+   * If true, enable the work stealing scheduler of the backend in use.
+   * Only the STDThread backend honors this setting:
+   *    - By default STDThread splits the range of For() in statically sized chunks
+   *      distributed round-robin to its threads.
+   *    - With work stealing, each thread processes its own contiguous part of the range
+   *      and an idle thread steals the back half of the remaining part of a busy one.
+   *      This balances functors whose cost varies a lot across the range (e.g. cells
+   *      generating much more output than others) at the price of a little locking.
+   *    - TBB always balances work dynamically and OpenMP follows OMP_SCHEDULE.
+   *
+   * Default to false.
+   */
+  static void SetWorkStealing(bool enable);
+
+  /**
+   * Get true if the work stealing scheduler is enabled.
+   */
+  static bool GetWorkStealing();
+
   /**
    * Return true if it is called from a parallel scope.
    */
@@ -448,18 +545,103 @@ public:
    */
   static bool GetSingleThread();
 
+  /**
+   * Return the number of For() calls made from the calling thread so far.
+   * Profilers compare it before and after running some code to count the
+   * parallel loops that code started.
+   */
+  static vtkIdType GetNumberOfForCalls();
+
+  ///@{
+  /**
+   * /!\ This method is not thread safe.
+   * Enable/disable the instrumentation of For(). When enabled, each call
+   * records its range, its grain, the number and sizes of the chunks the
+   * backend executed and the time each thread spent executing them, see
+   * LoopStatistics. This gives the data needed to tune the grain of a loop.
+   * The instrumentation times every chunk, so it slows down loops with many
+   * small chunks. Calls made while it is disabled cost one more test.
+   *
+   * Default to false.
+   */
+  static void SetInstrumentation(bool enable);
+  static bool GetInstrumentation();
+  ///@}
+
+  /**
+   * Statistics of an instrumented For() call:
+   *    - Label, the label of the calling thread, see LoopLabel.
+   *    - Backend, the backend which executed the loop.
+   *    - First, Last and Grain, the arguments of For(). A grain of 0 lets the backend choose.
+   *    - NumberOfChunks, MinimumChunkSize and MaximumChunkSize describe the chunks executed.
+   *    - NumberOfThreads, the estimated number of threads available to the loop.
+   *    - WallTime, the time spent in For(), in seconds.
+   *    - BusyTimes, the time each thread which executed chunks spent in the functor.
+   *    - Imbalance, the ratio of the longest busy time to the mean busy time of the
+   *      threads available, 1 for a perfectly balanced loop.
+   *    - Efficiency, the ratio of the total busy time to the time available to the
+   *      threads during the loop. The rest is spent idle or in the backend.
+   */
+  using LoopStatistics = vtk::detail::smp::vtkSMPToolsLoopStatistics;
+
+  /**
+   * Return the statistics of the For() calls made while the instrumentation
+   * was enabled, in the order they completed.
+   */
+  static std::vector<LoopStatistics> GetLoopStatistics();
+
+  /**
+   * Remove the recorded statistics.
+   */
+  static void ClearLoopStatistics();
+
+  /**
+   * Print a report of the recorded statistics, aggregated per label, the
+   * labels with the longest wall time first.
+   */
+  static void PrintLoopStatistics(ostream& os);
+
+  /**
+   * Label the For() calls made by the calling thread during the lifetime of
+   * this object, so that their statistics can be told apart. The label must
+   * outlive the object, string literals are expected.
+   *
+   * \code
+   * vtkSMPTools::LoopLabel label("vtkWindowedSincPolyDataFilter::Smooth");
+   * vtkSMPTools::For(0, numPts, worker);
+   * \endcode
+   */
+  class LoopLabel
+  {
+  public:
+    LoopLabel(const char* label)
+      : Previous(vtk::detail::smp::vtkSMPToolsAPI::GetLoopLabel())
+    {
+      vtk::detail::smp::vtkSMPToolsAPI::SetLoopLabel(label);
+    }
+    ~LoopLabel() { vtk::detail::smp::vtkSMPToolsAPI::SetLoopLabel(this->Previous); }
+    LoopLabel(const LoopLabel&) = delete;
+    LoopLabel& operator=(const LoopLabel&) = delete;
+
+  private:
+    const char* Previous;
+  };
+
   /**
    * Structure used to specify configuration for LocalScope() method.
    * Several parameters can be configured:
    *    - MaxNumberOfThreads set the maximum number of threads.
    *    - Backend set a specific SMPTools backend.
    *    - NestedParallelism, if true enable nested parallelism.
+   *    - WorkStealing, if true enable the work stealing scheduler (see SetWorkStealing()).
+   *      Default to the current setting.
    */
   struct Config
   {
     int MaxNumberOfThreads = 0;
     std::string Backend = vtk::detail::smp::vtkSMPToolsAPI::GetInstance().GetBackend();
     bool NestedParallelism = false;
+    bool WorkStealing = vtk::detail::smp::vtkSMPToolsAPI::GetInstance().GetWorkStealing();
 
     Config() = default;
     Config(int maxNumberOfThreads)
@@ -480,11 +662,19 @@ public:
       , NestedParallelism(nestedParallelism)
     {
     }
+    Config(int maxNumberOfThreads, std::string backend, bool nestedParallelism, bool workStealing)
+      : MaxNumberOfThreads(maxNumberOfThreads)
+      , Backend(backend)
+      , NestedParallelism(nestedParallelism)
+      , WorkStealing(workStealing)
+    {
+    }
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
     Config(vtk::detail::smp::vtkSMPToolsAPI& API)
       : MaxNumberOfThreads(API.GetInternalDesiredNumberOfThread())
       , Backend(API.GetBackend())
       , NestedParallelism(API.GetNestedParallelism())
+      , WorkStealing(API.GetWorkStealing())
     {
     }
 #endif // DOXYGEN_SHOULD_SKIP_THIS
@@ -623,6 +813,125 @@ public:
     auto& SMPToolsAPI = vtk::detail::smp::vtkSMPToolsAPI::GetInstance();
     SMPToolsAPI.Sort(begin, end, comp);
   }
+
+  ///@{
+  /**
+   * A convenience method for reducing data. It is a drop in replacement for
+   * std::reduce(), it combines the values of the input range and the initial value
+   * with the given binary operation (std::plus<> by default). The operation must be
+   * associative. The range is split into a number of blocks that only depends on the
+   * range size and on the number of threads, so the partial results are combined in
+   * the same order on every run with a given number of threads.
+   *
+   * Usage example with vtkDataArray:
+   * \code
+   * const auto range = vtk::DataArrayValueRange<1>(array);
+   * double sum = vtkSMPTools::Reduce(range.cbegin(), range.cend(), 0.0);
+   * double max = vtkSMPTools::Reduce(range.cbegin(), range.cend(), VTK_DOUBLE_MIN,
+   *   [](double a, double b) { return std::max(a, b); });
+   * \endcode
+   */
+  template <typename InputIt, typename T>
+  static T Reduce(InputIt begin, InputIt end, T init)
+  {
+    return vtkSMPTools::Reduce(begin, end, init, std::plus<>());
+  }
+
+  template <typename InputIt, typename T, typename BinaryOp>
+  static T Reduce(InputIt begin, InputIt end, T init, BinaryOp reduce)
+  {
+    vtk::detail::smp::IdentityFunctor identity;
+    auto& SMPToolsAPI = vtk::detail::smp::vtkSMPToolsAPI::GetInstance();
+    return SMPToolsAPI.TransformReduce(begin, end, init, reduce, identity);
+  }
+  ///@}
+
+  /**
+   * A convenience method for transforming and reducing data. It is a drop in
+   * replacement for std::transform_reduce(), it applies the unary transform to
+   * each value of the input range and combines the results with the initial value
+   * using the reduce operation. See Reduce() for the requirements on the reduce
+   * operation.
+   *
+   * Usage example with vtkDataArray:
+   * \code
+   * // Sum of squares
+   * const auto range = vtk::DataArrayValueRange<1>(array);
+   * double sum = vtkSMPTools::TransformReduce(range.cbegin(), range.cend(), 0.0,
+   *   std::plus<>(), [](double x) { return x * x; });
+   * \endcode
+   */
+  template <typename InputIt, typename T, typename ReduceOp, typename TransformOp>
+  static T TransformReduce(
+    InputIt begin, InputIt end, T init, ReduceOp reduce, TransformOp transform)
+  {
+    auto& SMPToolsAPI = vtk::detail::smp::vtkSMPToolsAPI::GetInstance();
+    return SMPToolsAPI.TransformReduce(begin, end, init, reduce, transform);
+  }
+
+  ///@{
+  /**
+   * A convenience method computing prefix sums. It is a drop in replacement for
+   * std::inclusive_scan(), the i-th output value is the combination of the
+   * optional initial value and of the input values 0 to i (included) with the given
+   * binary operation (std::plus<> by default). The operation must be associative.
+   * The output range may be the input range.
+   *
+   * The parallel backends use two passes over the input: one computing the sum of
+   * each block and one writing the scanned values, so the input is read twice.
+   */
+  template <typename InputIt, typename OutputIt>
+  static void InclusiveScan(InputIt inBegin, InputIt inEnd, OutputIt outBegin)
+  {
+    vtkSMPTools::InclusiveScan(inBegin, inEnd, outBegin, std::plus<>());
+  }
+
+  template <typename InputIt, typename OutputIt, typename BinaryOp>
+  static void InclusiveScan(InputIt inBegin, InputIt inEnd, OutputIt outBegin, BinaryOp op)
+  {
+    auto& SMPToolsAPI = vtk::detail::smp::vtkSMPToolsAPI::GetInstance();
+    SMPToolsAPI.InclusiveScan(inBegin, inEnd, outBegin, op);
+  }
+
+  template <typename InputIt, typename OutputIt, typename BinaryOp, typename T>
+  static void InclusiveScan(
+    InputIt inBegin, InputIt inEnd, OutputIt outBegin, BinaryOp op, T init)
+  {
+    auto& SMPToolsAPI = vtk::detail::smp::vtkSMPToolsAPI::GetInstance();
+    SMPToolsAPI.InclusiveScan(inBegin, inEnd, outBegin, op, init);
+  }
+  ///@}
+
+  ///@{
+  /**
+   * A convenience method computing prefix sums. It is a drop in replacement for
+   * std::exclusive_scan(), the i-th output value is the combination of the initial
+   * value and of the input values 0 to i (excluded) with the given binary operation
+   * (std::plus<> by default). The operation must be associative. The output range
+   * may be the input range.
+   *
+   * This is typically used to turn per-cell or per-point output sizes into offsets
+   * before filling preallocated output arrays in parallel:
+   * \code
+   * std::vector<vtkIdType> counts(numCells + 1, 0); // computed in parallel
+   * vtkSMPTools::ExclusiveScan(counts.begin(), counts.end(), counts.begin(), vtkIdType(0));
+   * vtkIdType totalSize = counts.back();
+   * \endcode
+   */
+  template <typename InputIt, typename OutputIt, typename T>
+  static void ExclusiveScan(InputIt inBegin, InputIt inEnd, OutputIt outBegin, T init)
+  {
+    vtkSMPTools::ExclusiveScan(inBegin, inEnd, outBegin, init, std::plus<>());
+  }
+
+  template <typename InputIt, typename OutputIt, typename T, typename BinaryOp>
+  static void ExclusiveScan(
+    InputIt inBegin, InputIt inEnd, OutputIt outBegin, T init, BinaryOp op)
+  {
+    auto& SMPToolsAPI = vtk::detail::smp::vtkSMPToolsAPI::GetInstance();
+    SMPToolsAPI.ExclusiveScan(inBegin, inEnd, outBegin, init, op);
+  }
+  ///@}
 };
 
 VTK_ABI_NAMESPACE_END
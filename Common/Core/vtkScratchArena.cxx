@@ -0,0 +1,265 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkScratchArena.h"
+
+#include "vtkIdList.h"
+#include "vtkObjectBase.h"
+#include "vtkSmartPointer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+VTK_ABI_NAMESPACE_BEGIN
+namespace
+{
+std::atomic<bool> CountAllocations(false);
+std::atomic<vtkIdType> HeapAllocations(0);
+std::atomic<vtkIdType> HeapBytes(0);
+std::atomic<vtkIdType> ArenaAllocations(0);
+std::atomic<vtkIdType> ObjectsCreated(0);
+std::atomic<vtkIdType> ObjectsReused(0);
+
+//------------------------------------------------------------------------------
+void Count(std::atomic<vtkIdType>& counter, vtkIdType value = 1)
+{
+  if (CountAllocations.load(std::memory_order_relaxed))
+  {
+    counter.fetch_add(value, std::memory_order_relaxed);
+  }
+}
+}
+
+//------------------------------------------------------------------------------
+struct vtkScratchArena::vtkInternals
+{
+  struct Block
+  {
+    std::unique_ptr<unsigned char[]> Data;
+    std::size_t Size;
+  };
+
+  struct Pool
+  {
+    const std::type_info* Type;
+    std::vector<vtkSmartPointer<vtkObjectBase>> Objects;
+    std::size_t NumberOfUsed;
+  };
+
+  explicit vtkInternals(std::size_t blockSize)
+    : BlockSize(std::max<std::size_t>(blockSize, 64))
+  {
+  }
+
+  std::size_t BlockSize;
+  // Memory is bumped in Blocks[CurrentBlock], the following blocks are free.
+  std::vector<Block> Blocks;
+  std::size_t CurrentBlock = 0;
+  std::size_t Offset = 0;
+  // An arena serves few types of objects: the pools are searched linearly.
+  std::vector<Pool> Pools;
+  // Pool index of each object handed out, in order, so that scopes can give
+  // them back.
+  std::vector<std::size_t> Acquired;
+};
+
+//------------------------------------------------------------------------------
+vtkScratchArena::vtkScratchArena(std::size_t blockSize)
+  : Internals(new vtkInternals(blockSize))
+{
+}
+
+//------------------------------------------------------------------------------
+vtkScratchArena::vtkScratchArena(const vtkScratchArena& other)
+  : Internals(new vtkInternals(other.Internals->BlockSize))
+{
+}
+
+//------------------------------------------------------------------------------
+vtkScratchArena& vtkScratchArena::operator=(const vtkScratchArena& other)
+{
+  if (this != &other)
+  {
+    this->Internals.reset(new vtkInternals(other.Internals->BlockSize));
+  }
+  return *this;
+}
+
+//------------------------------------------------------------------------------
+vtkScratchArena::~vtkScratchArena() = default;
+
+//------------------------------------------------------------------------------
+void* vtkScratchArena::Allocate(std::size_t size, std::size_t alignment)
+{
+  auto& internals = *this->Internals;
+  const std::uintptr_t mask = ~static_cast<std::uintptr_t>(alignment - 1);
+  for (; internals.CurrentBlock < internals.Blocks.size(); ++internals.CurrentBlock)
+  {
+    auto& block = internals.Blocks[internals.CurrentBlock];
+    const auto begin = reinterpret_cast<std::uintptr_t>(block.Data.get());
+    const std::uintptr_t aligned = (begin + internals.Offset + alignment - 1) & mask;
+    if (aligned + size <= begin + block.Size)
+    {
+      internals.Offset = aligned + size - begin;
+      Count(ArenaAllocations);
+      return reinterpret_cast<void*>(aligned);
+    }
+    internals.Offset = 0;
+  }
+
+  // No free block is large enough: append a new one.
+  vtkInternals::Block block;
+  block.Size = std::max(internals.BlockSize, size + alignment);
+  block.Data.reset(new unsigned char[block.Size]);
+  vtkScratchArena::CountHeapAllocation(block.Size);
+  const auto begin = reinterpret_cast<std::uintptr_t>(block.Data.get());
+  const std::uintptr_t aligned = (begin + alignment - 1) & mask;
+  internals.Blocks.push_back(std::move(block));
+  internals.CurrentBlock = internals.Blocks.size() - 1;
+  internals.Offset = aligned + size - begin;
+  return reinterpret_cast<void*>(aligned);
+}
+
+//------------------------------------------------------------------------------
+vtkObjectBase* vtkScratchArena::AcquireObject(
+  const std::type_info& type, vtkObjectBase* (*newObject)())
+{
+  auto& internals = *this->Internals;
+  std::size_t poolIndex = 0;
+  while (poolIndex < internals.Pools.size() && *internals.Pools[poolIndex].Type != type)
+  {
+    ++poolIndex;
+  }
+  if (poolIndex == internals.Pools.size())
+  {
+    internals.Pools.push_back(vtkInternals::Pool{ &type, {}, 0 });
+  }
+  auto& pool = internals.Pools[poolIndex];
+  internals.Acquired.push_back(poolIndex);
+  if (pool.NumberOfUsed < pool.Objects.size())
+  {
+    Count(ObjectsReused);
+    return pool.Objects[pool.NumberOfUsed++];
+  }
+  Count(ObjectsCreated);
+  pool.Objects.push_back(vtk::TakeSmartPointer(newObject()));
+  ++pool.NumberOfUsed;
+  return pool.Objects.back();
+}
+
+//------------------------------------------------------------------------------
+vtkIdList* vtkScratchArena::AcquireIdList()
+{
+  vtkIdList* ids = this->Acquire<vtkIdList>();
+  ids->Reset();
+  return ids;
+}
+
+//------------------------------------------------------------------------------
+void vtkScratchArena::Reset()
+{
+  auto& internals = *this->Internals;
+  internals.CurrentBlock = 0;
+  internals.Offset = 0;
+  for (auto& pool : internals.Pools)
+  {
+    pool.NumberOfUsed = 0;
+  }
+  internals.Acquired.clear();
+}
+
+//------------------------------------------------------------------------------
+void vtkScratchArena::Squeeze()
+{
+  this->Internals.reset(new vtkInternals(this->Internals->BlockSize));
+}
+
+//------------------------------------------------------------------------------
+std::size_t vtkScratchArena::GetCapacity() const
+{
+  std::size_t capacity = 0;
+  for (const auto& block : this->Internals->Blocks)
+  {
+    capacity += block.Size;
+  }
+  return capacity;
+}
+
+//------------------------------------------------------------------------------
+vtkIdType vtkScratchArena::GetNumberOfPooledObjects() const
+{
+  vtkIdType number = 0;
+  for (const auto& pool : this->Internals->Pools)
+  {
+    number += static_cast<vtkIdType>(pool.Objects.size());
+  }
+  return number;
+}
+
+//------------------------------------------------------------------------------
+vtkScratchArena::Scope::Scope(vtkScratchArena& arena)
+  : Arena(arena)
+  , Block(arena.Internals->CurrentBlock)
+  , Offset(arena.Internals->Offset)
+  , NumberOfAcquired(arena.Internals->Acquired.size())
+{
+}
+
+//------------------------------------------------------------------------------
+vtkScratchArena::Scope::~Scope()
+{
+  auto& internals = *this->Arena.Internals;
+  internals.CurrentBlock = this->Block;
+  internals.Offset = this->Offset;
+  while (internals.Acquired.size() > this->NumberOfAcquired)
+  {
+    --internals.Pools[internals.Acquired.back()].NumberOfUsed;
+    internals.Acquired.pop_back();
+  }
+}
+
+//------------------------------------------------------------------------------
+void vtkScratchArena::SetCountAllocations(bool count)
+{
+  CountAllocations.store(count);
+}
+
+//------------------------------------------------------------------------------
+bool vtkScratchArena::GetCountAllocations()
+{
+  return CountAllocations.load();
+}
+
+//------------------------------------------------------------------------------
+vtkScratchArena::Statistics vtkScratchArena::GetStatistics()
+{
+  Statistics statistics;
+  statistics.HeapAllocations = HeapAllocations.load();
+  statistics.HeapBytes = HeapBytes.load();
+  statistics.ArenaAllocations = ArenaAllocations.load();
+  statistics.ObjectsCreated = ObjectsCreated.load();
+  statistics.ObjectsReused = ObjectsReused.load();
+  return statistics;
+}
+
+//------------------------------------------------------------------------------
+void vtkScratchArena::ResetStatistics()
+{
+  HeapAllocations.store(0);
+  HeapBytes.store(0);
+  ArenaAllocations.store(0);
+  ObjectsCreated.store(0);
+  ObjectsReused.store(0);
+}
+
+//------------------------------------------------------------------------------
+void vtkScratchArena::CountHeapAllocation(std::size_t bytes)
+{
+  if (CountAllocations.load(std::memory_order_relaxed))
+  {
+    HeapAllocations.fetch_add(1, std::memory_order_relaxed);
+    HeapBytes.fetch_add(static_cast<vtkIdType>(bytes), std::memory_order_relaxed);
+  }
+}
+VTK_ABI_NAMESPACE_END
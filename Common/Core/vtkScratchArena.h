@@ -0,0 +1,216 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class   vtkScratchArena
+ * @brief   per-thread scratch memory and object pools for inner loops
+ *
+ * vtkScratchArena provides the temporary storage of a thread in the inner
+ * loop of an algorithm without going through the heap once it is warmed up:
+ * - Allocate() hands out raw memory from large blocks by bumping a pointer,
+ * - Acquire() and AcquireIdList() hand out VTK objects (vtkIdList,
+ *   vtkGenericCell, ...) from pools of objects created on first use.
+ *
+ * Nothing is freed individually: the memory and the objects obtained since
+ * a Scope was opened are given back to the arena when the Scope is closed,
+ * and all of them by Reset(). The blocks and the objects themselves are
+ * kept for reuse, so that a recycled vtkIdList keeps its capacity.
+ *
+ * An arena is meant to be used by a single thread, typically through a
+ * vtkSMPThreadLocal, with a Scope per chunk of work:
+ * \code
+ * vtkSMPThreadLocal<vtkScratchArena> TLArena;
+ * void operator()(vtkIdType begin, vtkIdType end)
+ * {
+ *   vtkScratchArena& arena = this->TLArena.Local();
+ *   for (vtkIdType cellId = begin; cellId < end; ++cellId)
+ *   {
+ *     vtkScratchArena::Scope scope(arena);
+ *     vtkIdList* ptIds = arena.AcquireIdList();
+ *     vtkGenericCell* cell = arena.Acquire<vtkGenericCell>();
+ *     double* weights = arena.Allocate<double>(maxCellSize);
+ *     ...
+ *   }
+ * }
+ * \endcode
+ *
+ * Copying an arena only copies its block size: the copy starts empty. This
+ * lets vtkSMPThreadLocal construct the arena of each thread from an
+ * exemplar.
+ *
+ * vtkScratchArena also hosts process-wide allocation counters, enabled with
+ * SetCountAllocations(). When enabled, the arenas, vtkIdList and
+ * vtkGenericCell count the heap allocations they make, which helps to
+ * measure and remove the heap traffic in the hot loops of the filters.
+ *
+ * @warning
+ * The memory and the objects handed out must not be used after the Scope in
+ * which they were obtained is closed, or after Reset(). Objects are returned
+ * in the state left by their previous user, except by AcquireIdList().
+ *
+ * @sa
+ * vtkSMPThreadLocal vtkIdList vtkGenericCell
+ */
+
+#ifndef vtkScratchArena_h
+#define vtkScratchArena_h
+
+#include "vtkCommonCoreModule.h" // For export macro
+#include "vtkType.h"             // For vtkIdType
+#include "vtkWrappingHints.h"    // For VTK_WRAPEXCLUDE
+
+#include <cstddef>     // For std::size_t
+#include <memory>      // For std::unique_ptr
+#include <type_traits> // For std::is_trivially_destructible
+#include <typeinfo>    // For std::type_info
+
+VTK_ABI_NAMESPACE_BEGIN
+class vtkIdList;
+class vtkObjectBase;
+
+class VTKCOMMONCORE_EXPORT VTK_WRAPEXCLUDE vtkScratchArena
+{
+public:
+  /**
+   * Construct an empty arena. Memory is requested from the heap by blocks
+   * of at least blockSize bytes. Default is 64 KiB.
+   */
+  explicit vtkScratchArena(std::size_t blockSize = 65536);
+  ~vtkScratchArena();
+
+  ///@{
+  /**
+   * Construct or assign an empty arena with the same block size.
+   */
+  vtkScratchArena(const vtkScratchArena& other);
+  vtkScratchArena& operator=(const vtkScratchArena& other);
+  ///@}
+
+  /**
+   * Return size bytes of memory aligned on alignment, which must be a power
+   * of two. The memory is not initialized.
+   */
+  void* Allocate(std::size_t size, std::size_t alignment = alignof(std::max_align_t));
+
+  /**
+   * Return uninitialized memory for n values of type T.
+   */
+  template <class T>
+  T* Allocate(std::size_t n)
+  {
+    static_assert(std::is_trivially_destructible<T>::value,
+      "vtkScratchArena never runs destructors of the allocated values.");
+    return static_cast<T*>(this->Allocate(n * sizeof(T), alignof(T)));
+  }
+
+  /**
+   * Return an object of type T from the pool of the arena, created with
+   * T::New() if the pool has no available object. The arena keeps the
+   * ownership of the object: do not Delete() it.
+   */
+  template <class T>
+  T* Acquire()
+  {
+    return static_cast<T*>(this->AcquireObject(typeid(T), &vtkScratchArena::NewObject<T>));
+  }
+
+  /**
+   * Return an empty vtkIdList from the pool of the arena. The list keeps the
+   * capacity it had when it was last used.
+   */
+  vtkIdList* AcquireIdList();
+
+  /**
+   * Give back all the memory and objects handed out by the arena, keeping
+   * them for reuse. Scopes opened before must not be closed afterwards.
+   */
+  void Reset();
+
+  /**
+   * Release all the memory and objects of the arena.
+   */
+  void Squeeze();
+
+  /**
+   * Return the number of bytes of the blocks of memory owned by the arena.
+   */
+  std::size_t GetCapacity() const;
+
+  /**
+   * Return the number of objects in the pools of the arena.
+   */
+  vtkIdType GetNumberOfPooledObjects() const;
+
+  /**
+   * RAII helper giving back to the arena, when it goes out of scope, the
+   * memory and the objects handed out since its construction. Scopes can be
+   * nested as long as they are closed in reverse order of opening.
+   */
+  class VTKCOMMONCORE_EXPORT Scope
+  {
+  public:
+    explicit Scope(vtkScratchArena& arena);
+    ~Scope();
+
+  private:
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+    vtkScratchArena& Arena;
+    std::size_t Block;
+    std::size_t Offset;
+    std::size_t NumberOfAcquired;
+  };
+
+  /**
+   * Process-wide allocation counters, see SetCountAllocations().
+   */
+  struct Statistics
+  {
+    vtkIdType HeapAllocations = 0;  // heap allocations counted with CountHeapAllocation()
+    vtkIdType HeapBytes = 0;        // bytes of these heap allocations, when known
+    vtkIdType ArenaAllocations = 0; // allocations served by the arenas without the heap
+    vtkIdType ObjectsCreated = 0;   // objects created by the pools of the arenas
+    vtkIdType ObjectsReused = 0;    // objects recycled by the pools of the arenas
+  };
+
+  ///@{
+  /**
+   * Enable/disable the allocation counters. When disabled, which is the
+   * default, counting costs a single relaxed atomic load per allocation.
+   */
+  static void SetCountAllocations(bool count);
+  static bool GetCountAllocations();
+  ///@}
+
+  ///@{
+  /**
+   * Get/reset the counters accumulated by all threads.
+   */
+  static Statistics GetStatistics();
+  static void ResetStatistics();
+  ///@}
+
+  /**
+   * Count a heap allocation of the given number of bytes, if the counters
+   * are enabled. Called by the classes which may draw from an arena instead,
+   * such as vtkIdList and vtkGenericCell.
+   */
+  static void CountHeapAllocation(std::size_t bytes = 0);
+
+private:
+  template <class T>
+  static vtkObjectBase* NewObject()
+  {
+    return T::New();
+  }
+
+  vtkObjectBase* AcquireObject(const std::type_info& type, vtkObjectBase* (*newObject)());
+
+  struct vtkInternals;
+  std::unique_ptr<vtkInternals> Internals;
+};
+
+VTK_ABI_NAMESPACE_END
+#endif
+
+// VTK-HeaderTest-Exclude: vtkScratchArena.h
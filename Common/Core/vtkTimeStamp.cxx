@@ -42,6 +42,8 @@ void vtkTimeStamp::Modified()
 #else
   static std::atomic<uint32_t> GlobalTimeStamp(0U);
 #endif
-  this->ModifiedTime = (vtkMTimeType)++GlobalTimeStamp;
+  // The increments of all the threads are still totally ordered, so the times
+  // are unique and increasing. Synchronizing other memory is left to callers.
+  this->ModifiedTime = (vtkMTimeType)(GlobalTimeStamp.fetch_add(1, std::memory_order_relaxed) + 1);
 }
 VTK_ABI_NAMESPACE_END
@@ -96,6 +96,9 @@ enum vtkArrayTypes
   VTK_STRIDED_ARRAY,
   VTK_STRUCTURED_POINT_ARRAY,
 
+  // Reduced precision GenericDataArray subclasses
+  VTK_HALF_FLOAT_ARRAY,
+
   VTK_NUM_ARRAY_TYPES,
 };
 
@@ -0,0 +1,350 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// .NAME Test of vtkBVHCellLocator.
+// .SECTION Description
+// The queries of vtkBVHCellLocator must return the same results as
+// vtkStaticCellLocator. The build time and the ray throughput of the
+// ray-oriented cell locators are also reported for a triangulated surface.
+
+#include "vtkBVHCellLocator.h"
+#include "vtkCellArray.h"
+#include "vtkCellLocator.h"
+#include "vtkCellTreeLocator.h"
+#include "vtkCellType.h"
+#include "vtkDoubleArray.h"
+#include "vtkGenericCell.h"
+#include "vtkIdList.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTools.h"
+#include "vtkStaticCellLocator.h"
+#include "vtkTimerLog.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+constexpr int GRID_DIMENSION = 16;
+constexpr int SURFACE_DIMENSION = 300;
+constexpr vtkIdType NUMBER_OF_QUERIES = 20000;
+
+//------------------------------------------------------------------------------
+void BuildGrid(vtkUnstructuredGrid* grid)
+{
+  const int numPoints = GRID_DIMENSION + 1;
+  vtkNew<vtkPoints> points;
+  points->SetNumberOfPoints(numPoints * numPoints * numPoints);
+  for (int k = 0; k < numPoints; ++k)
+  {
+    for (int j = 0; j < numPoints; ++j)
+    {
+      for (int i = 0; i < numPoints; ++i)
+      {
+        // Slightly warped lattice so that the cells are not axis aligned.
+        points->SetPoint(i + numPoints * (j + numPoints * k),
+          i + 0.2 * std::sin(0.5 * j + 0.3 * k), j + 0.2 * std::sin(0.4 * k), k);
+      }
+    }
+  }
+  grid->SetPoints(points);
+  grid->AllocateExact(GRID_DIMENSION * GRID_DIMENSION * GRID_DIMENSION, 8);
+  for (int k = 0; k < GRID_DIMENSION; ++k)
+  {
+    for (int j = 0; j < GRID_DIMENSION; ++j)
+    {
+      for (int i = 0; i < GRID_DIMENSION; ++i)
+      {
+        const vtkIdType p0 = i + numPoints * (j + numPoints * k);
+        const vtkIdType px = 1;
+        const vtkIdType py = numPoints;
+        const vtkIdType pz = numPoints * numPoints;
+        const vtkIdType hex[8] = { p0, p0 + px, p0 + px + py, p0 + py, p0 + pz, p0 + px + pz,
+          p0 + px + py + pz, p0 + py + pz };
+        grid->InsertNextCell(VTK_HEXAHEDRON, 8, hex);
+      }
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+// A triangulated height field over [0, SURFACE_DIMENSION]^2.
+void BuildSurface(vtkPolyData* surface)
+{
+  const int numPoints = SURFACE_DIMENSION + 1;
+  vtkNew<vtkPoints> points;
+  points->SetNumberOfPoints(numPoints * numPoints);
+  for (int j = 0; j < numPoints; ++j)
+  {
+    for (int i = 0; i < numPoints; ++i)
+    {
+      points->SetPoint(
+        i + numPoints * j, i, j, 5.0 * std::sin(0.05 * i) * std::cos(0.07 * j) + 0.01 * i);
+    }
+  }
+  vtkNew<vtkCellArray> polys;
+  polys->AllocateExact(2 * SURFACE_DIMENSION * SURFACE_DIMENSION, 6 * SURFACE_DIMENSION);
+  for (int j = 0; j < SURFACE_DIMENSION; ++j)
+  {
+    for (int i = 0; i < SURFACE_DIMENSION; ++i)
+    {
+      const vtkIdType p0 = i + numPoints * j;
+      const vtkIdType triangles[2][3] = { { p0, p0 + 1, p0 + 1 + numPoints },
+        { p0, p0 + 1 + numPoints, p0 + numPoints } };
+      polys->InsertNextCell(3, triangles[0]);
+      polys->InsertNextCell(3, triangles[1]);
+    }
+  }
+  surface->SetPoints(points);
+  surface->SetPolys(polys);
+}
+
+//------------------------------------------------------------------------------
+void RandomPoints(vtkMinimalStandardRandomSequence* random, vtkPoints* points, vtkIdType number,
+  const double min[3], const double max[3])
+{
+  points->SetNumberOfPoints(number);
+  for (vtkIdType i = 0; i < number; ++i)
+  {
+    double x[3];
+    for (int c = 0; c < 3; ++c)
+    {
+      x[c] = random->GetNextRangeValue(min[c], max[c]);
+    }
+    points->SetPoint(i, x);
+  }
+}
+
+//------------------------------------------------------------------------------
+bool SameIds(vtkIdList* ids1, vtkIdList* ids2)
+{
+  std::vector<vtkIdType> sorted1(ids1->begin(), ids1->end());
+  std::vector<vtkIdType> sorted2(ids2->begin(), ids2->end());
+  std::sort(sorted1.begin(), sorted1.end());
+  std::sort(sorted2.begin(), sorted2.end());
+  return sorted1 == sorted2;
+}
+
+//------------------------------------------------------------------------------
+// Compare the point and box queries of the BVH to the static cell locator.
+bool TestQueries(vtkMinimalStandardRandomSequence* random)
+{
+  vtkNew<vtkUnstructuredGrid> grid;
+  BuildGrid(grid);
+  vtkNew<vtkBVHCellLocator> bvh;
+  bvh->SetDataSet(grid);
+  bvh->BuildLocator();
+  vtkNew<vtkStaticCellLocator> reference;
+  reference->SetDataSet(grid);
+  reference->BuildLocator();
+
+  const double min[3] = { -1.0, -1.0, -1.0 };
+  const double max[3] = { GRID_DIMENSION + 1.0, GRID_DIMENSION + 1.0, GRID_DIMENSION + 1.0 };
+  vtkNew<vtkPoints> points;
+  RandomPoints(random, points, NUMBER_OF_QUERIES / 10, min, max);
+  vtkNew<vtkGenericCell> cell;
+  vtkNew<vtkIdList> ids1;
+  vtkNew<vtkIdList> ids2;
+  vtkNew<vtkPoints> hits1;
+  vtkNew<vtkPoints> hits2;
+  double weights[8], pcoords[3];
+  int subId, inside;
+  for (vtkIdType i = 0; i + 1 < points->GetNumberOfPoints(); ++i)
+  {
+    double x[3], y[3];
+    points->GetPoint(i, x);
+    points->GetPoint(i + 1, y);
+
+    const vtkIdType cellId = bvh->FindCell(x, 0.0, cell, subId, pcoords, weights);
+    if (cellId != reference->FindCell(x, 0.0, cell, subId, pcoords, weights))
+    {
+      std::cerr << "FindCell: wrong cell " << cellId << " for point " << i << std::endl;
+      return false;
+    }
+
+    double closest[3], dist2, referenceDist2;
+    vtkIdType closestId;
+    const vtkIdType found =
+      bvh->FindClosestPointWithinRadius(x, 1.5, closest, cell, closestId, subId, dist2, inside);
+    if (found !=
+        reference->FindClosestPointWithinRadius(
+          x, 1.5, closest, cell, closestId, subId, referenceDist2, inside) ||
+      (found && std::abs(dist2 - referenceDist2) > 1e-12))
+    {
+      std::cerr << "FindClosestPointWithinRadius: wrong distance " << dist2 << " for point " << i
+                << std::endl;
+      return false;
+    }
+
+    const double bounds[6] = { std::min(x[0], y[0]), std::max(x[0], y[0]),
+      std::min(x[1], y[1]), std::max(x[1], y[1]), std::min(x[2], y[2]),
+      std::max(x[2], y[2]) };
+    // vtkStaticCellLocator returns the cells of the bins overlapping the box,
+    // compare to a brute force search instead.
+    bvh->FindCellsWithinBounds(const_cast<double*>(bounds), ids1);
+    ids2->Reset();
+    for (vtkIdType candidateId = 0; candidateId < grid->GetNumberOfCells(); ++candidateId)
+    {
+      double cellBounds[6];
+      grid->GetCellBounds(candidateId, cellBounds);
+      if (cellBounds[0] <= bounds[1] && bounds[0] <= cellBounds[1] &&
+        cellBounds[2] <= bounds[3] && bounds[2] <= cellBounds[3] && cellBounds[4] <= bounds[5] &&
+        bounds[4] <= cellBounds[5])
+      {
+        ids2->InsertNextId(candidateId);
+      }
+    }
+    if (!SameIds(ids1, ids2))
+    {
+      std::cerr << "FindCellsWithinBounds: wrong cells for box " << i << std::endl;
+      return false;
+    }
+
+    bvh->IntersectWithLine(x, y, 0.0, hits1, ids1, cell);
+    reference->IntersectWithLine(x, y, 0.0, hits2, ids2, cell);
+    if (!SameIds(ids1, ids2))
+    {
+      std::cerr << "IntersectWithLine: wrong cells for segment " << i << std::endl;
+      return false;
+    }
+  }
+
+  // The leaves partition the cells.
+  vtkNew<vtkPolyData> representation;
+  bvh->GenerateRepresentation(-1, representation);
+  if (representation->GetNumberOfLines() == 0 || representation->GetNumberOfLines() % 12 != 0 ||
+    representation->GetNumberOfLines() / 12 * bvh->GetNumberOfCellsPerNode() <
+      grid->GetNumberOfCells())
+  {
+    std::cerr << "GenerateRepresentation: wrong number of leaves" << std::endl;
+    return false;
+  }
+
+  // Shallow copies share the hierarchy.
+  vtkNew<vtkBVHCellLocator> copy;
+  copy->SetDataSet(grid);
+  copy->ShallowCopy(bvh);
+  double x[3] = { 3.5, 4.5, 5.5 };
+  if (copy->GetNumberOfNodes() != bvh->GetNumberOfNodes() ||
+    copy->FindCell(x, 0.0, cell, subId, pcoords, weights) !=
+      reference->FindCell(x, 0.0, cell, subId, pcoords, weights))
+  {
+    std::cerr << "ShallowCopy: wrong copy" << std::endl;
+    return false;
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+// Shoot the rays with a locator, compare the closest hits with the expected
+// ones and report the timings.
+bool TimeLocator(vtkAbstractCellLocator* locator, vtkPolyData* surface, vtkPoints* p1,
+  vtkPoints* p2, std::vector<double>& expected, const char* name)
+{
+  vtkNew<vtkTimerLog> timer;
+  locator->SetDataSet(surface);
+  timer->StartTimer();
+  locator->BuildLocator();
+  timer->StopTimer();
+  const double buildTime = timer->GetElapsedTime();
+
+  const vtkIdType numRays = p1->GetNumberOfPoints();
+  std::vector<double> tValues(numRays, -1.0);
+  vtkNew<vtkGenericCell> cell;
+  timer->StartTimer();
+  for (vtkIdType i = 0; i < numRays; ++i)
+  {
+    double a0[3], a1[3], t, x[3], pcoords[3];
+    int subId;
+    vtkIdType cellId;
+    p1->GetPoint(i, a0);
+    p2->GetPoint(i, a1);
+    if (locator->IntersectWithLine(a0, a1, 0.0, t, x, pcoords, subId, cellId, cell))
+    {
+      tValues[i] = t;
+    }
+  }
+  timer->StopTimer();
+  const double rayTime = timer->GetElapsedTime();
+
+  vtkNew<vtkIdList> cellIds;
+  vtkNew<vtkDoubleArray> t;
+  timer->StartTimer();
+  locator->IntersectWithLines(p1, p2, 0.0, cellIds, t);
+  timer->StopTimer();
+  const double batchedTime = timer->GetElapsedTime();
+
+  std::cout << name << ": build " << buildTime << "s, " << numRays / std::max(rayTime, 1e-9)
+            << " rays/s, " << numRays / std::max(batchedTime, 1e-9) << " rays/s batched";
+  if (auto bvh = vtkBVHCellLocator::SafeDownCast(locator))
+  {
+    std::cout << ", " << bvh->GetNumberOfNodes() << " nodes, " << bvh->GetActualMemorySize()
+              << " KiB";
+  }
+  std::cout << std::endl;
+
+  if (expected.empty())
+  {
+    expected = tValues;
+  }
+  // Several cells may be hit at the same distance: only compare the distances.
+  for (vtkIdType i = 0; i < numRays; ++i)
+  {
+    const double batchedT = cellIds->GetId(i) < 0 ? -1.0 : t->GetValue(i);
+    if (std::abs(tValues[i] - expected[i]) > 1e-9 || std::abs(batchedT - expected[i]) > 1e-9)
+    {
+      std::cerr << name << ": wrong intersection for ray " << i << ", t = " << tValues[i]
+                << " and " << batchedT << " instead of " << expected[i] << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool TestRays(vtkMinimalStandardRandomSequence* random)
+{
+  vtkNew<vtkPolyData> surface;
+  BuildSurface(surface);
+
+  // Rays from above the surface towards the surface, most of them hit it.
+  const double min1[3] = { -10.0, -10.0, 10.0 };
+  const double max1[3] = { SURFACE_DIMENSION + 10.0, SURFACE_DIMENSION + 10.0, 20.0 };
+  const double min2[3] = { 0.0, 0.0, -10.0 };
+  const double max2[3] = { SURFACE_DIMENSION, SURFACE_DIMENSION, -5.0 };
+  vtkNew<vtkPoints> p1;
+  RandomPoints(random, p1, NUMBER_OF_QUERIES, min1, max1);
+  vtkNew<vtkPoints> p2;
+  RandomPoints(random, p2, NUMBER_OF_QUERIES, min2, max2);
+
+  std::cout << surface->GetNumberOfCells() << " triangles, " << NUMBER_OF_QUERIES << " rays, "
+            << vtkSMPTools::GetEstimatedNumberOfThreads() << " threads." << std::endl;
+  std::vector<double> expected;
+  bool success = true;
+  vtkNew<vtkBVHCellLocator> bvh;
+  success &= TimeLocator(bvh, surface, p1, p2, expected, "vtkBVHCellLocator");
+  vtkNew<vtkCellTreeLocator> cellTree;
+  success &= TimeLocator(cellTree, surface, p1, p2, expected, "vtkCellTreeLocator");
+  vtkNew<vtkStaticCellLocator> staticLocator;
+  success &= TimeLocator(staticLocator, surface, p1, p2, expected, "vtkStaticCellLocator");
+  vtkNew<vtkCellLocator> cellLocator;
+  success &= TimeLocator(cellLocator, surface, p1, p2, expected, "vtkCellLocator");
+  return success;
+}
+}
+
+//------------------------------------------------------------------------------
+int TestBVHCellLocator(int, char*[])
+{
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(1984);
+  bool success = TestQueries(random);
+  success &= TestRays(random);
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,201 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// Test the view storages of vtkCellArray, which reference external connectivity
+// buffers without copying them: padded fixed-size records, 1-based buffers, and
+// the copy of the cells on modification.
+
+#include "vtkCellArray.h"
+#include "vtkCellArrayIterator.h"
+#include "vtkIdList.h"
+#include "vtkNew.h"
+#include "vtkSmartPointer.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+//------------------------------------------------------------------------------
+// Compare the cells of array to the expected ones, with GetCellAtId() and with
+// an iterator.
+bool CheckCells(
+  vtkCellArray* array, const std::vector<std::vector<vtkIdType>>& expected, const char* name)
+{
+  if (array->GetNumberOfCells() != static_cast<vtkIdType>(expected.size()))
+  {
+    std::cerr << name << ": " << array->GetNumberOfCells() << " cells instead of "
+              << expected.size() << std::endl;
+    return false;
+  }
+  vtkNew<vtkIdList> ids;
+  auto iter = vtk::TakeSmartPointer(array->NewIterator());
+  vtkIdType cellId = 0;
+  for (iter->GoToFirstCell(); !iter->IsDoneWithTraversal(); iter->GoToNextCell(), ++cellId)
+  {
+    vtkIdType npts;
+    const vtkIdType* pts;
+    iter->GetCurrentCell(npts, pts);
+    array->GetCellAtId(cellId, ids);
+    const auto& cell = expected[cellId];
+    if (npts != static_cast<vtkIdType>(cell.size()) || ids->GetNumberOfIds() != npts)
+    {
+      std::cerr << name << ": wrong size for cell " << cellId << std::endl;
+      return false;
+    }
+    for (vtkIdType i = 0; i < npts; ++i)
+    {
+      if (pts[i] != cell[i] || ids->GetId(i) != cell[i])
+      {
+        std::cerr << name << ": wrong point " << i << " for cell " << cellId << std::endl;
+        return false;
+      }
+    }
+  }
+  return cellId == array->GetNumberOfCells();
+}
+
+//------------------------------------------------------------------------------
+// Tetrahedra stored as records of 4 point ids followed by a material id.
+bool TestFixedSizeView()
+{
+  std::vector<vtkTypeInt32> records = { 0, 1, 2, 3, 7, 1, 2, 3, 4, 7, 2, 3, 4, 5, 8, 3, 4, 5, 6,
+    8 };
+  std::vector<std::vector<vtkIdType>> expected = { { 0, 1, 2, 3 }, { 1, 2, 3, 4 }, { 2, 3, 4, 5 },
+    { 3, 4, 5, 6 } };
+
+  vtkNew<vtkCellArray> view;
+  view->SetFixedSizeDataView(4, 4, records.data(), 5);
+  bool success = view->GetStorageType() == vtkCellArray::FixedSizeViewInt32 &&
+    view->IsStorageView() && view->IsHomogeneous() == 4;
+  success &= CheckCells(view, expected, "Fixed size view");
+
+  // The view does not copy the buffer.
+  records[5] = 9;
+  expected[1][0] = 9;
+  success &= CheckCells(view, expected, "Fixed size view, modified buffer");
+
+  // Copies of a view own their memory.
+  vtkNew<vtkCellArray> copy;
+  copy->DeepCopy(view);
+  success &= copy->GetStorageType() == vtkCellArray::FixedSizeInt32;
+  success &= CheckCells(copy, expected, "Deep copy of fixed size view");
+  vtkNew<vtkCellArray> shallowCopy;
+  shallowCopy->ShallowCopy(view);
+  success &= shallowCopy->GetStorageType() == vtkCellArray::FixedSizeViewInt32;
+  records[5] = 1;
+  success &= CheckCells(copy, expected, "Deep copy, modified buffer");
+  expected[1][0] = 1;
+  success &= CheckCells(shallowCopy, expected, "Shallow copy, modified buffer");
+
+  success &= view->ConvertTo64BitStorage() && view->IsStorage64Bit();
+  success &= CheckCells(view, expected, "Converted fixed size view");
+  if (!success)
+  {
+    std::cerr << "Fixed size view failed." << std::endl;
+  }
+  return success;
+}
+
+//------------------------------------------------------------------------------
+// Mixed cells of a 1-based Fortran code.
+bool TestFortranView()
+{
+  const std::vector<vtkTypeInt64> offsets = { 1, 4, 8, 10 };
+  const std::vector<vtkTypeInt64> connectivity = { 1, 2, 3, 2, 3, 5, 4, 6, 7 };
+  const std::vector<std::vector<vtkIdType>> expected = { { 0, 1, 2 }, { 1, 2, 4, 3 },
+    { 5, 6 } };
+
+  vtkNew<vtkCellArray> view;
+  view->SetDataView(3, offsets.data(), connectivity.data(), 1);
+  bool success = view->GetStorageType() == vtkCellArray::ViewInt64 && view->IsStorageView() &&
+    view->GetNumberOfConnectivityIds() == 9 && view->IsHomogeneous() == -1 &&
+    view->GetMaxCellSize() == 4;
+  success &= CheckCells(view, expected, "Fortran view");
+
+  // The view arrays are recognized by the generic SetData().
+  vtkNew<vtkCellArray> generic;
+  generic->SetData(view->GetOffsetsArray(), view->GetConnectivityArray());
+  success &= generic->GetStorageType() == vtkCellArray::ViewInt64;
+
+  vtkNew<vtkCellArray> copy;
+  copy->DeepCopy(view);
+  success &= copy->GetStorageType() == vtkCellArray::Int64;
+  success &= CheckCells(copy, expected, "Deep copy of Fortran view");
+
+  success &= view->ConvertTo32BitStorage() && view->IsStorage32Bit();
+  success &= CheckCells(view, expected, "Converted Fortran view");
+  if (!success)
+  {
+    std::cerr << "Fortran view failed." << std::endl;
+  }
+  return success;
+}
+
+//------------------------------------------------------------------------------
+// Modifying a view copies its cells first and leaves the external buffers alone.
+bool TestModifiedView()
+{
+  const std::vector<vtkTypeInt32> offsets = { 0, 3, 6 };
+  const std::vector<vtkTypeInt32> connectivity = { 0, 1, 2, 2, 1, 3 };
+  std::vector<std::vector<vtkIdType>> expected = { { 0, 1, 2 }, { 2, 1, 3 } };
+
+  vtkNew<vtkCellArray> view;
+  view->SetDataView(2, offsets.data(), connectivity.data());
+  bool success = view->InsertNextCell({ 3, 4, 5 }) == 2;
+  success &= view->GetStorageType() == vtkCellArray::Int32 && !view->IsStorageView();
+  expected.push_back({ 3, 4, 5 });
+  success &= CheckCells(view, expected, "Extended view");
+
+  view->SetDataView(2, offsets.data(), connectivity.data());
+  view->ReplaceCellPointAtId(1, 0, 7);
+  success &= view->GetStorageType() == vtkCellArray::Int32;
+  expected.pop_back();
+  expected[1][0] = 7;
+  success &= CheckCells(view, expected, "Modified view");
+
+  // The incremental API.
+  view->SetDataView(2, offsets.data(), connectivity.data());
+  view->InsertNextCell(2);
+  view->InsertCellPoint(4);
+  view->InsertCellPoint(5);
+  expected[1][0] = 2;
+  expected.push_back({ 4, 5 });
+  success &= CheckCells(view, expected, "Incrementally extended view");
+
+  // Reset drops the view.
+  view->SetDataView(2, offsets.data(), connectivity.data());
+  view->Reset();
+  success &= view->GetStorageType() == vtkCellArray::Int32 && view->GetNumberOfCells() == 0 &&
+    view->GetNumberOfConnectivityIds() == 0;
+  view->InsertNextCell({ 0, 1 });
+  success &= CheckCells(view, { { 0, 1 } }, "Reset view");
+
+  success &= offsets == std::vector<vtkTypeInt32>{ 0, 3, 6 } &&
+    connectivity == std::vector<vtkTypeInt32>{ 0, 1, 2, 2, 1, 3 };
+
+  // Triangles stored as records of 3 point ids followed by a material id.
+  const std::vector<vtkTypeInt64> records = { 0, 1, 2, 8, 1, 2, 3, 9 };
+  vtkNew<vtkCellArray> fixedSizeView;
+  fixedSizeView->SetFixedSizeDataView(2, 3, records.data(), 4);
+  success &= fixedSizeView->InsertNextCell({ 2, 3, 4 }) == 2;
+  success &= fixedSizeView->GetStorageType() == vtkCellArray::FixedSizeInt64;
+  success &= CheckCells(
+    fixedSizeView, { { 0, 1, 2 }, { 1, 2, 3 }, { 2, 3, 4 } }, "Extended fixed size view");
+  success &= records == std::vector<vtkTypeInt64>{ 0, 1, 2, 8, 1, 2, 3, 9 };
+  if (!success)
+  {
+    std::cerr << "Modified view failed." << std::endl;
+  }
+  return success;
+}
+}
+
+//------------------------------------------------------------------------------
+int TestCellArrayViews(int, char*[])
+{
+  bool success = TestFixedSizeView();
+  success &= TestFortranView();
+  success &= TestModifiedView();
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,246 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// .NAME Test of the batched queries of the cell locators.
+// .SECTION Description
+// FindCells, FindClosestPoints and IntersectWithLines must return the same
+// results as the corresponding single queries, with and without query
+// reordering, for locators with a native batched implementation and for
+// locators using the generic one.
+
+#include "vtkAbstractCellLocator.h"
+#include "vtkCellLocator.h"
+#include "vtkCellTreeLocator.h"
+#include "vtkCellType.h"
+#include "vtkDoubleArray.h"
+#include "vtkGenericCell.h"
+#include "vtkIdList.h"
+#include "vtkMath.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkSMPTools.h"
+#include "vtkStaticCellLocator.h"
+#include "vtkTimerLog.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+constexpr int DIMENSION = 24;
+constexpr vtkIdType NUMBER_OF_QUERIES = 50000;
+
+//------------------------------------------------------------------------------
+void BuildGrid(vtkUnstructuredGrid* grid)
+{
+  const int numPoints = DIMENSION + 1;
+  vtkNew<vtkPoints> points;
+  points->SetNumberOfPoints(numPoints * numPoints * numPoints);
+  for (int k = 0; k < numPoints; ++k)
+  {
+    for (int j = 0; j < numPoints; ++j)
+    {
+      for (int i = 0; i < numPoints; ++i)
+      {
+        // Slightly warped lattice so that the cells are not axis aligned.
+        points->SetPoint(i + numPoints * (j + numPoints * k),
+          i + 0.2 * std::sin(0.5 * j + 0.3 * k), j + 0.2 * std::sin(0.4 * k), k);
+      }
+    }
+  }
+  grid->SetPoints(points);
+  grid->AllocateExact(DIMENSION * DIMENSION * DIMENSION, 8);
+  for (int k = 0; k < DIMENSION; ++k)
+  {
+    for (int j = 0; j < DIMENSION; ++j)
+    {
+      for (int i = 0; i < DIMENSION; ++i)
+      {
+        const vtkIdType p0 = i + numPoints * (j + numPoints * k);
+        const vtkIdType px = 1;
+        const vtkIdType py = numPoints;
+        const vtkIdType pz = numPoints * numPoints;
+        const vtkIdType hex[8] = { p0, p0 + px, p0 + px + py, p0 + py, p0 + pz, p0 + px + pz,
+          p0 + px + py + pz, p0 + py + pz };
+        grid->InsertNextCell(VTK_HEXAHEDRON, 8, hex);
+      }
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+void RandomPoints(vtkMinimalStandardRandomSequence* random, vtkPoints* points, vtkIdType number,
+  double min, double max)
+{
+  points->SetNumberOfPoints(number);
+  for (vtkIdType i = 0; i < number; ++i)
+  {
+    double x[3];
+    for (int c = 0; c < 3; ++c)
+    {
+      x[c] = random->GetNextRangeValue(min, max);
+    }
+    points->SetPoint(i, x);
+  }
+}
+
+//------------------------------------------------------------------------------
+bool TestFindCells(vtkAbstractCellLocator* locator, vtkPoints* points, const char* name)
+{
+  vtkNew<vtkTimerLog> timer;
+  vtkNew<vtkIdList> cellIds;
+  vtkNew<vtkDoubleArray> pcoords;
+  timer->StartTimer();
+  locator->FindCells(points, cellIds, 0.0, pcoords);
+  timer->StopTimer();
+  const double batchedDuration = timer->GetElapsedTime();
+
+  vtkNew<vtkGenericCell> cell;
+  std::vector<double> weights(8);
+  int subId;
+  double pc[3];
+  timer->StartTimer();
+  for (vtkIdType i = 0; i < points->GetNumberOfPoints(); ++i)
+  {
+    double x[3];
+    points->GetPoint(i, x);
+    const vtkIdType cellId = locator->FindCell(x, 0.0, cell, subId, pc, weights.data());
+    if (cellId != cellIds->GetId(i))
+    {
+      std::cerr << name << " FindCells: point " << i << " found cell " << cellIds->GetId(i)
+                << " instead of " << cellId << std::endl;
+      return false;
+    }
+    if (cellId >= 0 &&
+      (pcoords->GetComponent(i, 0) != pc[0] || pcoords->GetComponent(i, 1) != pc[1] ||
+        pcoords->GetComponent(i, 2) != pc[2]))
+    {
+      std::cerr << name << " FindCells: wrong parametric coordinates for point " << i
+                << std::endl;
+      return false;
+    }
+  }
+  timer->StopTimer();
+  std::cout << name << " FindCells: " << batchedDuration << "s batched, "
+            << timer->GetElapsedTime() << "s one by one." << std::endl;
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool TestFindClosestPoints(vtkAbstractCellLocator* locator, vtkPoints* points, const char* name)
+{
+  vtkNew<vtkIdList> cellIds;
+  vtkNew<vtkPoints> closestPoints;
+  vtkNew<vtkDoubleArray> dist2;
+  locator->FindClosestPoints(points, cellIds, closestPoints, dist2);
+
+  vtkNew<vtkGenericCell> cell;
+  for (vtkIdType i = 0; i < points->GetNumberOfPoints(); ++i)
+  {
+    double x[3], closestPoint[3], d2;
+    vtkIdType cellId;
+    int subId;
+    points->GetPoint(i, x);
+    locator->FindClosestPoint(x, closestPoint, cell, cellId, subId, d2);
+    // Several cells may be at the same distance: only compare the distances.
+    if (cellIds->GetId(i) < 0 || std::abs(d2 - dist2->GetValue(i)) > 1e-12 ||
+      std::abs(vtkMath::Distance2BetweenPoints(x, closestPoints->GetPoint(i)) - d2) > 1e-9)
+    {
+      std::cerr << name << " FindClosestPoints: wrong closest point for point " << i
+                << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool TestIntersectWithLines(
+  vtkAbstractCellLocator* locator, vtkPoints* p1, vtkPoints* p2, const char* name)
+{
+  vtkNew<vtkIdList> cellIds;
+  vtkNew<vtkDoubleArray> t;
+  vtkNew<vtkPoints> intersections;
+  locator->IntersectWithLines(p1, p2, 0.0, cellIds, t, intersections);
+
+  vtkNew<vtkGenericCell> cell;
+  for (vtkIdType i = 0; i < p1->GetNumberOfPoints(); ++i)
+  {
+    double a0[3], a1[3], tHit, x[3], pcoords[3];
+    vtkIdType cellId = -1;
+    int subId;
+    p1->GetPoint(i, a0);
+    p2->GetPoint(i, a1);
+    if (!locator->IntersectWithLine(a0, a1, 0.0, tHit, x, pcoords, subId, cellId, cell))
+    {
+      cellId = -1;
+    }
+    if (cellId != cellIds->GetId(i) || (cellId >= 0 && tHit != t->GetValue(i)))
+    {
+      std::cerr << name << " IntersectWithLines: segment " << i << " hit cell "
+                << cellIds->GetId(i) << " instead of " << cellId << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool TestLocator(vtkAbstractCellLocator* locator, vtkUnstructuredGrid* grid, vtkPoints* points,
+  vtkPoints* p1, vtkPoints* p2, bool closestPoints, const char* name)
+{
+  locator->SetDataSet(grid);
+  locator->BuildLocator();
+  bool success = true;
+  for (int reorder = 0; reorder < 2; ++reorder)
+  {
+    locator->SetReorderQueries(reorder);
+    success &= TestFindCells(locator, points, name);
+    success &= TestIntersectWithLines(locator, p1, p2, name);
+    if (closestPoints)
+    {
+      success &= TestFindClosestPoints(locator, p1, name);
+    }
+  }
+  return success;
+}
+}
+
+//------------------------------------------------------------------------------
+int TestCellLocatorBatchedQueries(int, char*[])
+{
+  vtkNew<vtkUnstructuredGrid> grid;
+  BuildGrid(grid);
+
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(8775070);
+  // Some of the points lie outside of the grid.
+  vtkNew<vtkPoints> points;
+  RandomPoints(random, points, NUMBER_OF_QUERIES, -1.0, DIMENSION + 1.0);
+  vtkNew<vtkPoints> p1;
+  RandomPoints(random, p1, NUMBER_OF_QUERIES / 10, -5.0, DIMENSION + 5.0);
+  vtkNew<vtkPoints> p2;
+  RandomPoints(random, p2, NUMBER_OF_QUERIES / 10, -5.0, DIMENSION + 5.0);
+
+  std::cout << "Running " << NUMBER_OF_QUERIES << " queries with "
+            << vtkSMPTools::GetEstimatedNumberOfThreads() << " threads." << std::endl;
+
+  bool success = true;
+  vtkNew<vtkStaticCellLocator> staticLocator;
+  success &= TestLocator(staticLocator, grid, points, p1, p2, true, "vtkStaticCellLocator");
+  vtkNew<vtkCellTreeLocator> cellTreeLocator;
+  success &= TestLocator(cellTreeLocator, grid, points, p1, p2, false, "vtkCellTreeLocator");
+  vtkNew<vtkCellLocator> cellLocator;
+  success &= TestLocator(cellLocator, grid, points, p1, p2, true, "vtkCellLocator");
+
+  // Empty batches are valid.
+  vtkNew<vtkPoints> noPoints;
+  vtkNew<vtkIdList> cellIds;
+  staticLocator->FindCells(noPoints, cellIds);
+  success &= cellIds->GetNumberOfIds() == 0;
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,187 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// .NAME Test of the parallel build and batched k-NN queries of vtkKdTree.
+// .SECTION Description
+// The regions of the k-d tree built in parallel must partition the points.
+// FindClosestNPointsBatch must return the same neighbors as
+// FindClosestNPoints, for vtkKdTreePointLocator and for the generic
+// implementation of vtkAbstractPointLocator, threaded or not.
+
+#include "vtkDoubleArray.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkKdTree.h"
+#include "vtkKdTreePointLocator.h"
+#include "vtkMath.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkPointLocator.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkStaticPointLocator.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+constexpr vtkIdType NUMBER_OF_POINTS = 20000;
+constexpr int NUMBER_OF_NEIGHBORS = 8;
+
+//------------------------------------------------------------------------------
+void RandomPoints(
+  vtkMinimalStandardRandomSequence* random, vtkPoints* points, vtkIdType number, double max)
+{
+  points->SetNumberOfPoints(number);
+  for (vtkIdType i = 0; i < number; ++i)
+  {
+    double x[3];
+    for (int c = 0; c < 3; ++c)
+    {
+      x[c] = random->GetNextRangeValue(-max, max);
+    }
+    points->SetPoint(i, x);
+  }
+}
+
+//------------------------------------------------------------------------------
+// Each point must belong to exactly one region, within the bounds of that region.
+bool TestParallelBuild(vtkPoints* points)
+{
+  vtkNew<vtkKdTree> kdTree;
+  kdTree->BuildLocatorFromPoints(points);
+  if (kdTree->GetNumberOfRegions() < 2)
+  {
+    std::cerr << "Parallel build: the points were not divided" << std::endl;
+    return false;
+  }
+
+  std::vector<int> numberOfRegions(points->GetNumberOfPoints(), 0);
+  for (int regionId = 0; regionId < kdTree->GetNumberOfRegions(); ++regionId)
+  {
+    double bounds[6];
+    kdTree->GetRegionBounds(regionId, bounds);
+    vtkIdTypeArray* ids = kdTree->GetPointsInRegion(regionId);
+    for (vtkIdType i = 0; ids && i < ids->GetNumberOfValues(); ++i)
+    {
+      const vtkIdType ptId = ids->GetValue(i);
+      double x[3];
+      points->GetPoint(ptId, x);
+      ++numberOfRegions[ptId];
+      if (x[0] < bounds[0] || x[0] > bounds[1] || x[1] < bounds[2] || x[1] > bounds[3] ||
+        x[2] < bounds[4] || x[2] > bounds[5])
+      {
+        std::cerr << "Parallel build: point " << ptId << " outside of region " << regionId
+                  << std::endl;
+        return false;
+      }
+    }
+  }
+  for (vtkIdType ptId = 0; ptId < points->GetNumberOfPoints(); ++ptId)
+  {
+    if (numberOfRegions[ptId] != 1)
+    {
+      std::cerr << "Parallel build: point " << ptId << " in " << numberOfRegions[ptId]
+                << " regions" << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+// Compare the batched neighbors of all the points to FindClosestNPoints.
+bool TestBatch(vtkAbstractPointLocator* locator, vtkPolyData* cloud, vtkPoints* queries,
+  const char* name)
+{
+  locator->SetDataSet(cloud);
+  locator->BuildLocator();
+
+  vtkNew<vtkIdTypeArray> neighbors;
+  vtkNew<vtkDoubleArray> dist2;
+  locator->FindClosestNPointsBatch(NUMBER_OF_NEIGHBORS, queries, neighbors, dist2);
+
+  vtkNew<vtkIdList> ids;
+  for (vtkIdType i = 0; i < queries->GetNumberOfPoints(); ++i)
+  {
+    double x[3];
+    queries->GetPoint(i, x);
+    locator->FindClosestNPoints(NUMBER_OF_NEIGHBORS, x, ids);
+    if (ids->GetNumberOfIds() != NUMBER_OF_NEIGHBORS ||
+      neighbors->GetNumberOfComponents() != NUMBER_OF_NEIGHBORS)
+    {
+      std::cerr << name << ": wrong number of neighbors for point " << i << std::endl;
+      return false;
+    }
+    // Several points may be at the same distance: only compare the distances.
+    for (int k = 0; k < NUMBER_OF_NEIGHBORS; ++k)
+    {
+      const double expected = vtkMath::Distance2BetweenPoints(x, cloud->GetPoint(ids->GetId(k)));
+      const double found =
+        vtkMath::Distance2BetweenPoints(x, cloud->GetPoint(neighbors->GetTypedComponent(i, k)));
+      if (std::abs(found - expected) > 1e-5 * (1.0 + expected) ||
+        std::abs(dist2->GetTypedComponent(i, k) - found) > 1e-5 * (1.0 + found))
+      {
+        std::cerr << name << ": wrong neighbor " << k << " for point " << i << std::endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+// Less points than neighbors requested: the lists are padded with -1.
+bool TestPadding()
+{
+  vtkNew<vtkPoints> points;
+  points->InsertNextPoint(0.0, 0.0, 0.0);
+  points->InsertNextPoint(1.0, 0.0, 0.0);
+  points->InsertNextPoint(0.0, 2.0, 0.0);
+  vtkNew<vtkPolyData> cloud;
+  cloud->SetPoints(points);
+  vtkNew<vtkKdTreePointLocator> locator;
+  locator->SetDataSet(cloud);
+
+  vtkNew<vtkIdTypeArray> neighbors;
+  locator->FindClosestNPointsBatch(5, points, neighbors);
+  const vtkIdType expected[5] = { 1, 0, 2, -1, -1 };
+  for (int k = 0; k < 5; ++k)
+  {
+    if (neighbors->GetTypedComponent(1, k) != expected[k])
+    {
+      std::cerr << "Padding: wrong neighbor " << k << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+//------------------------------------------------------------------------------
+int TestKdTreeBatchedQueries(int, char*[])
+{
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(1177);
+  vtkNew<vtkPoints> points;
+  points->SetDataTypeToFloat();
+  RandomPoints(random, points, NUMBER_OF_POINTS, 1.0);
+  vtkNew<vtkPolyData> cloud;
+  cloud->SetPoints(points);
+  // Some of the queries lie outside of the cloud.
+  vtkNew<vtkPoints> queries;
+  RandomPoints(random, queries, NUMBER_OF_POINTS / 10, 1.2);
+
+  bool success = TestParallelBuild(points);
+  vtkNew<vtkKdTreePointLocator> kdTreeLocator;
+  success &= TestBatch(kdTreeLocator, cloud, points, "vtkKdTreePointLocator, all points");
+  success &= TestBatch(kdTreeLocator, cloud, queries, "vtkKdTreePointLocator, queries");
+  vtkNew<vtkStaticPointLocator> staticLocator;
+  success &= TestBatch(staticLocator, cloud, queries, "vtkStaticPointLocator, queries");
+  vtkNew<vtkPointLocator> pointLocator;
+  success &= TestBatch(pointLocator, cloud, queries, "vtkPointLocator, queries");
+  success &= TestPadding();
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
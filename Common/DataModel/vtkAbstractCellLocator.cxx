@@ -4,6 +4,7 @@
 #include "vtkAbstractCellLocator.h"
 
 #include "vtkCellArray.h"
+#include "vtkCellLocatorBatchPrivate.h"
 #include "vtkDataArrayRange.h"
 #include "vtkDataSet.h"
 #include "vtkGenericCell.h"
@@ -16,6 +17,8 @@
 #include "vtkSMPTools.h"
 #include "vtkUnstructuredGrid.h"
 
+#include <atomic>
+
 //------------------------------------------------------------------------------
 VTK_ABI_NAMESPACE_BEGIN
 vtkAbstractCellLocator::vtkAbstractCellLocator()
@@ -27,6 +30,7 @@ vtkAbstractCellLocator::vtkAbstractCellLocator()
   this->RetainCellLists = 1;
   this->NumberOfCellsPerNode = 32;
   this->UseExistingSearchStructure = 0;
+  this->ReorderQueries = 1;
 }
 
 //------------------------------------------------------------------------------
@@ -245,12 +249,11 @@ vtkIdType vtkAbstractCellLocator::FindCell(
 {
   vtkIdType returnVal = -1;
   //
-  static bool warning_shown = false;
-  if (!warning_shown)
+  static std::atomic<bool> warning_shown(false);
+  if (!warning_shown.exchange(true))
   {
     vtkWarningMacro(<< this->GetClassName() << " Does not implement FindCell"
                     << " Reverting to slow DataSet implementation");
-    warning_shown = true;
   }
   //
   if (this->DataSet)
@@ -260,6 +263,106 @@ vtkIdType vtkAbstractCellLocator::FindCell(
   return returnVal;
 }
 
+//------------------------------------------------------------------------------
+void vtkAbstractCellLocator::ComputeQueryOrder(vtkPoints* points, std::vector<vtkIdType>& order)
+{
+  vtkCellLocatorBatch::ComputeMortonOrder(points, order);
+}
+
+//------------------------------------------------------------------------------
+void vtkAbstractCellLocator::GetQueryOrder(
+  vtkPoints* p1, vtkPoints* p2, std::vector<vtkIdType>& order)
+{
+  order.clear();
+  if (!this->ReorderQueries)
+  {
+    return;
+  }
+  if (!p2)
+  {
+    this->ComputeQueryOrder(p1, order);
+    return;
+  }
+  vtkNew<vtkPoints> midpoints;
+  vtkCellLocatorBatch::ComputeMidpoints(p1, p2, midpoints);
+  this->ComputeQueryOrder(midpoints, order);
+}
+
+//------------------------------------------------------------------------------
+void vtkAbstractCellLocator::FindCells(
+  vtkPoints* points, vtkIdList* cellIds, double tol2, vtkDoubleArray* pcoords)
+{
+  if (!points || !cellIds)
+  {
+    return;
+  }
+  this->BuildLocator();
+  std::vector<vtkIdType> order;
+  this->GetQueryOrder(points, nullptr, order);
+  // The vtkDataSet::FindCell fallback builds state lazily.
+  vtkCellLocatorBatch::FindCells(
+    this->DataSet, points, order, cellIds, pcoords,
+    [&](double x[3], vtkGenericCell* cell, int& subId, double pc[3], double* weights)
+    { return this->FindCell(x, tol2, cell, subId, pc, weights); },
+    (this->GetThreadSafeQueries() & FIND_CELL) != 0);
+}
+
+//------------------------------------------------------------------------------
+void vtkAbstractCellLocator::FindClosestPoints(
+  vtkPoints* points, vtkIdList* cellIds, vtkPoints* closestPoints, vtkDoubleArray* dist2)
+{
+  if (!points || !cellIds)
+  {
+    return;
+  }
+  if (!(this->GetThreadSafeQueries() & FIND_CLOSEST_POINT))
+  {
+    vtkErrorMacro(<< "The locator class - " << this->GetClassName()
+                  << " does not support FindClosestPoints");
+    cellIds->SetNumberOfIds(points->GetNumberOfPoints());
+    cellIds->Fill(-1);
+    return;
+  }
+  this->BuildLocator();
+  std::vector<vtkIdType> order;
+  this->GetQueryOrder(points, nullptr, order);
+  vtkCellLocatorBatch::FindClosestPoints(this->DataSet, points, order, cellIds, closestPoints,
+    dist2,
+    [&](double x[3], double closestPoint[3], vtkGenericCell* cell, vtkIdType& cellId, int& subId,
+      double& d2)
+    {
+      int inside;
+      return this->FindClosestPointWithinRadius(
+               x, vtkMath::Inf(), closestPoint, cell, cellId, subId, d2, inside) != 0;
+    });
+}
+
+//------------------------------------------------------------------------------
+void vtkAbstractCellLocator::IntersectWithLines(vtkPoints* p1, vtkPoints* p2, double tol,
+  vtkIdList* cellIds, vtkDoubleArray* t, vtkPoints* intersections)
+{
+  if (!p1 || !p2 || !cellIds || p1->GetNumberOfPoints() != p2->GetNumberOfPoints())
+  {
+    vtkErrorMacro(<< "IntersectWithLines needs as many start points as end points");
+    return;
+  }
+  if (!(this->GetThreadSafeQueries() & INTERSECT_WITH_LINE))
+  {
+    vtkErrorMacro(<< "The locator class - " << this->GetClassName()
+                  << " does not support IntersectWithLines");
+    cellIds->SetNumberOfIds(p1->GetNumberOfPoints());
+    cellIds->Fill(-1);
+    return;
+  }
+  this->BuildLocator();
+  std::vector<vtkIdType> order;
+  this->GetQueryOrder(p1, p2, order);
+  vtkCellLocatorBatch::IntersectWithLines(this->DataSet, p1, p2, order, cellIds, t, intersections,
+    [&](const double a0[3], const double a1[3], double& tHit, double x[3], double pcoords[3],
+      int& subId, vtkIdType& cellId, vtkGenericCell* cell)
+    { return this->IntersectWithLine(a0, a1, tol, tHit, x, pcoords, subId, cellId, cell); });
+}
+
 //------------------------------------------------------------------------------
 bool vtkAbstractCellLocator::InsideCellBounds(double x[3], vtkIdType cell_ID)
 {
@@ -295,5 +398,6 @@ void vtkAbstractCellLocator::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Cache Cell Bounds: " << this->CacheCellBounds << "\n";
   os << indent << "Retain Cell Lists: " << (this->RetainCellLists ? "On\n" : "Off\n");
   os << indent << "Number of Cells Per Bucket: " << this->NumberOfCellsPerNode << "\n";
+  os << indent << "Reorder Queries: " << (this->ReorderQueries ? "On\n" : "Off\n");
 }
 VTK_ABI_NAMESPACE_END
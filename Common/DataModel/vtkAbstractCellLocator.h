@@ -34,6 +34,7 @@
 
 VTK_ABI_NAMESPACE_BEGIN
 class vtkCellArray;
+class vtkDoubleArray;
 class vtkGenericCell;
 class vtkIdList;
 class vtkPoints;
@@ -287,6 +288,82 @@ public:
     double pcoords[3], double* weights);
   ///@}
 
+  /**
+   * Single queries taking a vtkGenericCell which a locator implements in a
+   * thread safe way, as returned by GetThreadSafeQueries().
+   */
+  enum ThreadSafeQuery
+  {
+    FIND_CELL = 1,
+    FIND_CLOSEST_POINT = 2,
+    INTERSECT_WITH_LINE = 4
+  };
+
+  /**
+   * Return a combination of the ThreadSafeQuery flags, for the single queries
+   * which this locator implements. The batched queries run them in parallel.
+   * Otherwise FindCells runs the vtkDataSet::FindCell fallback serially, and
+   * FindClosestPoints and IntersectWithLines report an error. Subclasses
+   * implementing these queries override this method. Default is 0.
+   */
+  virtual int GetThreadSafeQueries() { return 0; }
+
+  ///@{
+  /**
+   * Boolean controls whether the batched queries (FindCells,
+   * FindClosestPoints and IntersectWithLines) are processed in a spatially
+   * coherent order rather than in the given order, so that consecutive
+   * queries of a thread visit the same cells and nodes. The results are
+   * always returned in the given order. Default is on.
+   */
+  vtkSetMacro(ReorderQueries, vtkTypeBool);
+  vtkGetMacro(ReorderQueries, vtkTypeBool);
+  vtkBooleanMacro(ReorderQueries, vtkTypeBool);
+  ///@}
+
+  /**
+   * Batched version of FindCell: find the cell containing each of the given
+   * points. cellIds is resized to the number of points and receives -1 for
+   * the points outside of all cells. If pcoords is given, it receives the
+   * parametric coordinates of each point (3 components). The queries run in
+   * parallel with vtkSMPTools if the locator implements a thread safe
+   * FindCell, serially otherwise. The locator is built beforehand if needed.
+   *
+   * THIS FUNCTION IS NOT THREAD SAFE.
+   */
+  virtual void FindCells(
+    vtkPoints* points, vtkIdList* cellIds, double tol2 = 0.0, vtkDoubleArray* pcoords = nullptr);
+
+  /**
+   * Batched version of FindClosestPoint: find the closest cell to each of
+   * the given points. cellIds is resized to the number of points. If given,
+   * closestPoints receives the closest point on the closest cell and dist2
+   * the squared distance to it. The queries run in parallel with vtkSMPTools.
+   *
+   * A vtkAbstractCellLocator subclass needs to implement
+   * FindClosestPointWithinRadius which is used internally, and to list it
+   * in GetThreadSafeQueries().
+   *
+   * THIS FUNCTION IS NOT THREAD SAFE.
+   */
+  virtual void FindClosestPoints(vtkPoints* points, vtkIdList* cellIds,
+    vtkPoints* closestPoints = nullptr, vtkDoubleArray* dist2 = nullptr);
+
+  /**
+   * Batched version of IntersectWithLine: intersect each segment
+   * (p1[i], p2[i]) with the cells and return the first cell hit in cellIds,
+   * or -1. If given, t receives the parametric coordinate of the hit along
+   * each segment and intersections the hit points. The queries run in
+   * parallel with vtkSMPTools.
+   *
+   * A vtkAbstractCellLocator subclass needs to implement IntersectWithLine
+   * taking a vtkGenericCell, and to list it in GetThreadSafeQueries().
+   *
+   * THIS FUNCTION IS NOT THREAD SAFE.
+   */
+  virtual void IntersectWithLines(vtkPoints* p1, vtkPoints* p2, double tol, vtkIdList* cellIds,
+    vtkDoubleArray* t = nullptr, vtkPoints* intersections = nullptr);
+
   /**
    * Quickly test if a point is inside the bounds of a particular cell.
    * Some locators cache cell bounds and this function can make use
@@ -323,9 +400,24 @@ protected:
    */
   void UpdateInternalWeights();
 
+  /**
+   * Compute the order in which the batched queries process the given points
+   * when ReorderQueries is on. An empty order keeps the given order. The
+   * default sorts the points along a Morton curve spanning their bounds;
+   * subclasses may follow their own search structure instead.
+   */
+  virtual void ComputeQueryOrder(vtkPoints* points, std::vector<vtkIdType>& order);
+
+  /**
+   * Order of a batch of point queries (p2 is nullptr) or of segment queries
+   * (ordered by their midpoints), following ReorderQueries.
+   */
+  void GetQueryOrder(vtkPoints* p1, vtkPoints* p2, std::vector<vtkIdType>& order);
+
   int NumberOfCellsPerNode;
   vtkTypeBool RetainCellLists;
   vtkTypeBool CacheCellBounds;
+  vtkTypeBool ReorderQueries;
   vtkNew<vtkGenericCell> GenericCell;
   std::shared_ptr<std::vector<double>> CellBoundsSharedPtr;
   double* CellBounds; // The is just used for simplicity in the internal code
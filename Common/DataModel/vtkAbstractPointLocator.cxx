@@ -3,7 +3,15 @@
 #include "vtkAbstractPointLocator.h"
 
 #include "vtkDataSet.h"
+#include "vtkDoubleArray.h"
 #include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkMath.h"
+#include "vtkPoints.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+
+#include <algorithm>
 
 //------------------------------------------------------------------------------
 VTK_ABI_NAMESPACE_BEGIN
@@ -42,6 +50,72 @@ void vtkAbstractPointLocator::FindClosestNPoints(
   this->FindClosestNPoints(N, p, result);
 }
 
+//------------------------------------------------------------------------------
+void vtkAbstractPointLocator::FindClosestNPointsBatch(
+  int N, vtkPoints* points, vtkIdTypeArray* neighbors, vtkDoubleArray* dist2)
+{
+  if (!points || !neighbors)
+  {
+    return;
+  }
+  const vtkIdType numQueries = points->GetNumberOfPoints();
+  N = std::max(N, 0);
+  neighbors->SetNumberOfComponents(N);
+  neighbors->SetNumberOfTuples(numQueries);
+  if (dist2)
+  {
+    dist2->SetNumberOfComponents(N);
+    dist2->SetNumberOfTuples(numQueries);
+  }
+  if (N == 0 || numQueries == 0)
+  {
+    return;
+  }
+  // Build once here, the queries of a thread safe locator may then run concurrently.
+  this->BuildLocator();
+  vtkDataSet* dataSet = this->DataSet;
+  vtkIdType* neighborIds = neighbors->GetPointer(0);
+  double* distances = dist2 ? dist2->GetPointer(0) : nullptr;
+
+  vtkSMPThreadLocalObject<vtkIdList> localIds;
+  auto findNeighbors = [&](vtkIdType begin, vtkIdType end)
+  {
+    vtkIdList* ids = localIds.Local();
+    double x[3], y[3];
+    for (vtkIdType queryId = begin; queryId < end; ++queryId)
+    {
+      points->GetPoint(queryId, x);
+      this->FindClosestNPoints(N, x, ids);
+      const vtkIdType numIds = std::min<vtkIdType>(ids->GetNumberOfIds(), N);
+      vtkIdType* out = neighborIds + queryId * N;
+      std::copy_n(ids->GetPointer(0), numIds, out);
+      std::fill(out + numIds, out + N, -1);
+      if (distances)
+      {
+        double* d2 = distances + queryId * N;
+        for (vtkIdType i = 0; i < numIds; ++i)
+        {
+          dataSet->GetPoint(out[i], y);
+          d2[i] = vtkMath::Distance2BetweenPoints(x, y);
+        }
+        std::fill(d2 + numIds, d2 + N, VTK_DOUBLE_MAX);
+      }
+    }
+  };
+
+  if (this->IsFindClosestNPointsThreadSafe())
+  {
+    // Make GetPoint thread safe before the threads use it
+    double x[3];
+    dataSet->GetPoint(0, x);
+    vtkSMPTools::For(0, numQueries, findNeighbors);
+  }
+  else
+  {
+    findNeighbors(0, numQueries);
+  }
+}
+
 //------------------------------------------------------------------------------
 void vtkAbstractPointLocator::FindPointsWithinRadius(
   double R, double x, double y, double z, vtkIdList* result)
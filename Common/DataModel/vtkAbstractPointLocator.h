@@ -22,7 +22,10 @@
 #include "vtkLocator.h"
 
 VTK_ABI_NAMESPACE_BEGIN
+class vtkDoubleArray;
 class vtkIdList;
+class vtkIdTypeArray;
+class vtkPoints;
 
 class VTKCOMMONDATAMODEL_EXPORT vtkAbstractPointLocator : public vtkLocator
 {
@@ -67,6 +70,30 @@ public:
   void FindClosestNPoints(int N, double x, double y, double z, vtkIdList* result);
   ///@}
 
+  /**
+   * Find the closest N points to each of the given points, for instance to
+   * all the points of the data set. neighbors gets N components per query
+   * point: the ids of the closest points sorted from closest to farthest,
+   * padded with -1 if the data set has less than N points. If dist2 is
+   * given, it gets the matching squared distances (VTK_DOUBLE_MAX for
+   * padding). The default implementation calls FindClosestNPoints for each
+   * point, in parallel if IsFindClosestNPointsThreadSafe() returns true and
+   * serially otherwise; subclasses may provide a faster one. The locator is
+   * built beforehand if needed.
+   *
+   * THIS FUNCTION IS NOT THREAD SAFE.
+   */
+  virtual void FindClosestNPointsBatch(
+    int N, vtkPoints* points, vtkIdTypeArray* neighbors, vtkDoubleArray* dist2 = nullptr);
+
+  /**
+   * Return true if FindClosestNPoints may be called concurrently once the
+   * locator is built, in which case the default FindClosestNPointsBatch runs
+   * the queries in parallel. Subclasses known to be thread safe override this
+   * method. Default is false.
+   */
+  virtual bool IsFindClosestNPointsThreadSafe() { return false; }
+
   ///@{
   /**
    * Find all points within a specified radius R of position x.
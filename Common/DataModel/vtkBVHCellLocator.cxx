@@ -0,0 +1,1343 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "vtkBVHCellLocator.h"
+
+#include "vtkBox.h"
+#include "vtkCellArray.h"
+#include "vtkCellLocatorBatchPrivate.h"
+#include "vtkDataSet.h"
+#include "vtkDoubleArray.h"
+#include "vtkGenericCell.h"
+#include "vtkIdList.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <queue>
+#include <vector>
+
+VTK_ABI_NAMESPACE_BEGIN
+vtkStandardNewMacro(vtkBVHCellLocator);
+
+//========================= BVH MACHINERY =====================================
+
+// The hierarchy. The two children of an interior node are adjacent in the
+// node array, so that they are tested together with a single cache line.
+struct vtkBVHTree
+{
+  struct Node
+  {
+    float Min[3];   // bounds, rounded outwards to single precision
+    float Max[3];   //
+    int32_t Offset; // leaf: first index in CellIds; interior: index of the left child
+    int32_t Count;  // leaf: number of cells; interior: 0
+
+    bool IsLeaf() const { return this->Count > 0; }
+  };
+
+  std::vector<Node> Nodes;
+  std::vector<vtkIdType> CellIds; // cell ids, contiguous per leaf
+  double Bounds[6];
+  int MaxCellSize = 0;
+};
+
+namespace
+{ // anonymous to wrap non-public stuff
+
+static_assert(sizeof(vtkBVHTree::Node) == 32, "BVH nodes must be 32 bytes.");
+
+// Relative cost of traversing a node with respect to testing a cell.
+constexpr double TRAVERSAL_COST = 0.5;
+// Below this depth nodes are split with the SAH, then at the median so that
+// the depth (and the traversal stacks) stays bounded.
+constexpr int SAH_MAX_DEPTH = 32;
+constexpr int MAX_STACK_SIZE = 128;
+// Nodes with more cells than this are binned in parallel.
+constexpr vtkIdType PARALLEL_BINNING_SIZE = 1 << 16;
+// Number of rays traversed together by IntersectWithLines.
+constexpr int PACKET_SIZE = 8;
+
+//------------------------------------------------------------------------------
+float RoundDown(double value)
+{
+  float rounded = static_cast<float>(value);
+  return rounded > value ? std::nextafter(rounded, -std::numeric_limits<float>::infinity())
+                         : rounded;
+}
+
+float RoundUp(double value)
+{
+  float rounded = static_cast<float>(value);
+  return rounded < value ? std::nextafter(rounded, std::numeric_limits<float>::infinity())
+                         : rounded;
+}
+
+//------------------------------------------------------------------------------
+// Axis aligned box used while building.
+struct Box
+{
+  double Min[3] = { VTK_DOUBLE_MAX, VTK_DOUBLE_MAX, VTK_DOUBLE_MAX };
+  double Max[3] = { VTK_DOUBLE_MIN, VTK_DOUBLE_MIN, VTK_DOUBLE_MIN };
+
+  void AddBounds(const double bounds[6])
+  {
+    for (int i = 0; i < 3; ++i)
+    {
+      this->Min[i] = std::min(this->Min[i], bounds[2 * i]);
+      this->Max[i] = std::max(this->Max[i], bounds[2 * i + 1]);
+    }
+  }
+  void AddPoint(const double x[3])
+  {
+    for (int i = 0; i < 3; ++i)
+    {
+      this->Min[i] = std::min(this->Min[i], x[i]);
+      this->Max[i] = std::max(this->Max[i], x[i]);
+    }
+  }
+  void AddBox(const Box& box)
+  {
+    for (int i = 0; i < 3; ++i)
+    {
+      this->Min[i] = std::min(this->Min[i], box.Min[i]);
+      this->Max[i] = std::max(this->Max[i], box.Max[i]);
+    }
+  }
+  double HalfArea() const
+  {
+    if (this->Min[0] > this->Max[0])
+    {
+      return 0.0;
+    }
+    const double dx = this->Max[0] - this->Min[0];
+    const double dy = this->Max[1] - this->Min[1];
+    const double dz = this->Max[2] - this->Min[2];
+    return dx * dy + dy * dz + dz * dx;
+  }
+};
+
+//------------------------------------------------------------------------------
+// Cells still to be organized: the range [Begin, End) of the cell ids, with
+// the bounds of their cells and of their centroids.
+struct Range
+{
+  vtkIdType Begin;
+  vtkIdType End;
+  Box Bounds;
+  Box Centroids;
+  int Depth;
+
+  vtkIdType Size() const { return this->End - this->Begin; }
+};
+
+struct Bin
+{
+  Box Bounds;
+  Box Centroids;
+  vtkIdType Count = 0;
+};
+
+//------------------------------------------------------------------------------
+// Builds the hierarchy top down. The first levels are split one node at a
+// time with parallel binning, the resulting subtrees are then built in
+// parallel and appended to the node array.
+struct BVHBuilder
+{
+  vtkBVHTree* Tree;
+  const double* CellBounds;
+  std::vector<double> Centroids;
+  vtkIdType* Ids;
+  int NumberOfBins;
+  int MaxLeafSize;
+
+  BVHBuilder(vtkBVHTree* tree, const double* cellBounds, int numberOfBins, int maxLeafSize)
+    : Tree(tree)
+    , CellBounds(cellBounds)
+    , Ids(nullptr)
+    , NumberOfBins(numberOfBins)
+    , MaxLeafSize(maxLeafSize)
+  {
+  }
+
+  // How a range is split: cells whose centroid falls in a bin <= SplitBin along
+  // Axis go left. A negative axis means a median split of the ids.
+  struct Split
+  {
+    int Axis = -1;
+    int SplitBin = 0;
+    double Scale = 0.0;
+    vtkIdType Middle = 0;
+    Range Left;
+    Range Right;
+  };
+
+  int GetBin(vtkIdType cellId, int axis, const Range& range, double scale) const
+  {
+    const double centroid = this->Centroids[3 * cellId + axis];
+    const int bin = static_cast<int>((centroid - range.Centroids.Min[axis]) * scale);
+    return std::min(std::max(bin, 0), this->NumberOfBins - 1);
+  }
+
+  //----------------------------------------------------------------------------
+  // Initialize the ids and centroids, return the root range.
+  Range Initialize(vtkIdType numCells)
+  {
+    this->Tree->CellIds.resize(numCells);
+    this->Ids = this->Tree->CellIds.data();
+    this->Centroids.resize(3 * numCells);
+
+    struct LocalBoxes
+    {
+      Box Bounds;
+      Box Centroids;
+    };
+    vtkSMPThreadLocal<LocalBoxes> localBoxes;
+    vtkSMPTools::For(0, numCells,
+      [&](vtkIdType begin, vtkIdType end)
+      {
+        LocalBoxes& boxes = localBoxes.Local();
+        for (vtkIdType cellId = begin; cellId < end; ++cellId)
+        {
+          const double* bds = this->CellBounds + 6 * cellId;
+          double* centroid = this->Centroids.data() + 3 * cellId;
+          centroid[0] = 0.5 * (bds[0] + bds[1]);
+          centroid[1] = 0.5 * (bds[2] + bds[3]);
+          centroid[2] = 0.5 * (bds[4] + bds[5]);
+          boxes.Bounds.AddBounds(bds);
+          boxes.Centroids.AddPoint(centroid);
+          this->Ids[cellId] = cellId;
+        }
+      });
+
+    Range root{ 0, numCells, Box(), Box(), 0 };
+    for (auto& boxes : localBoxes)
+    {
+      root.Bounds.AddBox(boxes.Bounds);
+      root.Centroids.AddBox(boxes.Centroids);
+    }
+    return root;
+  }
+
+  //----------------------------------------------------------------------------
+  // Accumulate the cells of the range in the bins of the three axes.
+  void FillBins(const Range& range, const double scale[3], std::vector<Bin>& bins) const
+  {
+    const int numBins = this->NumberOfBins;
+    auto fill = [&](vtkIdType begin, vtkIdType end, std::vector<Bin>& localBins)
+    {
+      for (vtkIdType i = begin; i < end; ++i)
+      {
+        const vtkIdType cellId = this->Ids[i];
+        const double* bds = this->CellBounds + 6 * cellId;
+        const double* centroid = this->Centroids.data() + 3 * cellId;
+        for (int axis = 0; axis < 3; ++axis)
+        {
+          if (scale[axis] > 0.0)
+          {
+            Bin& bin = localBins[axis * numBins + this->GetBin(cellId, axis, range, scale[axis])];
+            bin.Bounds.AddBounds(bds);
+            bin.Centroids.AddPoint(centroid);
+            ++bin.Count;
+          }
+        }
+      }
+    };
+
+    bins.assign(3 * numBins, Bin());
+    if (range.Size() < PARALLEL_BINNING_SIZE)
+    {
+      fill(range.Begin, range.End, bins);
+      return;
+    }
+    vtkSMPThreadLocal<std::vector<Bin>> localBins;
+    vtkSMPTools::For(range.Begin, range.End,
+      [&](vtkIdType begin, vtkIdType end)
+      {
+        std::vector<Bin>& local = localBins.Local();
+        if (local.empty())
+        {
+          local.resize(3 * numBins);
+        }
+        fill(begin, end, local);
+      });
+    for (auto& local : localBins)
+    {
+      for (int i = 0; i < 3 * numBins; ++i)
+      {
+        bins[i].Bounds.AddBox(local[i].Bounds);
+        bins[i].Centroids.AddBox(local[i].Centroids);
+        bins[i].Count += local[i].Count;
+      }
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  // Choose the split minimizing the surface area heuristic. Return false if
+  // the range should rather be a leaf.
+  bool FindSplit(const Range& range, Split& split) const
+  {
+    const vtkIdType size = range.Size();
+    if (size <= this->MaxLeafSize)
+    {
+      return false;
+    }
+    if (range.Depth >= SAH_MAX_DEPTH)
+    {
+      return this->FindMedianSplit(range, split);
+    }
+
+    double scale[3];
+    bool canSplit = false;
+    for (int axis = 0; axis < 3; ++axis)
+    {
+      const double extent = range.Centroids.Max[axis] - range.Centroids.Min[axis];
+      scale[axis] = extent > 0.0 ? this->NumberOfBins / extent : 0.0;
+      canSplit |= extent > 0.0;
+    }
+    if (!canSplit)
+    {
+      // All the centroids coincide.
+      return this->FindMedianSplit(range, split);
+    }
+
+    const int numBins = this->NumberOfBins;
+    std::vector<Bin> bins;
+    this->FillBins(range, scale, bins);
+
+    double bestCost = VTK_DOUBLE_MAX;
+    std::vector<double> rightCosts(numBins);
+    for (int axis = 0; axis < 3; ++axis)
+    {
+      if (scale[axis] <= 0.0)
+      {
+        continue;
+      }
+      const Bin* axisBins = bins.data() + axis * numBins;
+      // Sweep from the right, then from the left.
+      Box right;
+      vtkIdType rightCount = 0;
+      for (int i = numBins - 1; i > 0; --i)
+      {
+        right.AddBox(axisBins[i].Bounds);
+        rightCount += axisBins[i].Count;
+        rightCosts[i] = rightCount * right.HalfArea();
+      }
+      Box left;
+      vtkIdType leftCount = 0;
+      for (int i = 0; i < numBins - 1; ++i)
+      {
+        left.AddBox(axisBins[i].Bounds);
+        leftCount += axisBins[i].Count;
+        if (leftCount == 0 || leftCount == size)
+        {
+          continue;
+        }
+        const double cost = leftCount * left.HalfArea() + rightCosts[i + 1];
+        if (cost < bestCost)
+        {
+          bestCost = cost;
+          split.Axis = axis;
+          split.SplitBin = i;
+          split.Scale = scale[axis];
+        }
+      }
+    }
+    if (split.Axis < 0)
+    {
+      return this->FindMedianSplit(range, split);
+    }
+
+    // Small ranges become leaves when splitting does not pay off.
+    const double area = range.Bounds.HalfArea();
+    if (size <= 2 * this->MaxLeafSize && bestCost + TRAVERSAL_COST * area >= size * area)
+    {
+      return false;
+    }
+
+    // Partition the ids and gather the children bounds from the bins.
+    split.Left = Range{ range.Begin, range.Begin, Box(), Box(), range.Depth + 1 };
+    split.Right = Range{ range.Begin, range.End, Box(), Box(), range.Depth + 1 };
+    const Bin* axisBins = bins.data() + split.Axis * numBins;
+    for (int i = 0; i < numBins; ++i)
+    {
+      Range& child = i <= split.SplitBin ? split.Left : split.Right;
+      child.Bounds.AddBox(axisBins[i].Bounds);
+      child.Centroids.AddBox(axisBins[i].Centroids);
+      if (i <= split.SplitBin)
+      {
+        split.Left.End += axisBins[i].Count;
+      }
+    }
+    std::partition(this->Ids + range.Begin, this->Ids + range.End,
+      [&](vtkIdType cellId)
+      { return this->GetBin(cellId, split.Axis, range, split.Scale) <= split.SplitBin; });
+    split.Middle = split.Left.End;
+    split.Right.Begin = split.Middle;
+    return true;
+  }
+
+  //----------------------------------------------------------------------------
+  // Split at the median of the centroids along the largest axis.
+  bool FindMedianSplit(const Range& range, Split& split) const
+  {
+    int axis = 0;
+    double largest = -1.0;
+    for (int i = 0; i < 3; ++i)
+    {
+      const double extent = range.Centroids.Max[i] - range.Centroids.Min[i];
+      if (extent > largest)
+      {
+        largest = extent;
+        axis = i;
+      }
+    }
+    const vtkIdType middle = range.Begin + range.Size() / 2;
+    const double* centroids = this->Centroids.data();
+    std::nth_element(this->Ids + range.Begin, this->Ids + middle, this->Ids + range.End,
+      [&](vtkIdType a, vtkIdType b)
+      {
+        const double ca = centroids[3 * a + axis];
+        const double cb = centroids[3 * b + axis];
+        return ca < cb || (ca == cb && a < b);
+      });
+
+    split.Axis = -1;
+    split.Middle = middle;
+    split.Left = Range{ range.Begin, middle, Box(), Box(), range.Depth + 1 };
+    split.Right = Range{ middle, range.End, Box(), Box(), range.Depth + 1 };
+    for (Range* child : { &split.Left, &split.Right })
+    {
+      for (vtkIdType i = child->Begin; i < child->End; ++i)
+      {
+        child->Bounds.AddBounds(this->CellBounds + 6 * this->Ids[i]);
+        child->Centroids.AddPoint(centroids + 3 * this->Ids[i]);
+      }
+    }
+    return true;
+  }
+
+  //----------------------------------------------------------------------------
+  static void SetBounds(vtkBVHTree::Node& node, const Box& box)
+  {
+    for (int i = 0; i < 3; ++i)
+    {
+      node.Min[i] = RoundDown(box.Min[i]);
+      node.Max[i] = RoundUp(box.Max[i]);
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  // Build the subtree of a range serially. The root of the subtree is nodes[0].
+  void BuildSubtree(const Range& root, std::vector<vtkBVHTree::Node>& nodes) const
+  {
+    nodes.clear();
+    nodes.emplace_back();
+    std::vector<std::pair<vtkIdType, Range>> stack;
+    stack.emplace_back(0, root);
+    Split split;
+    while (!stack.empty())
+    {
+      const vtkIdType nodeId = stack.back().first;
+      const Range range = stack.back().second;
+      stack.pop_back();
+
+      BVHBuilder::SetBounds(nodes[nodeId], range.Bounds);
+      split = Split();
+      if (!this->FindSplit(range, split))
+      {
+        nodes[nodeId].Offset = static_cast<int32_t>(range.Begin);
+        nodes[nodeId].Count = static_cast<int32_t>(range.Size());
+        continue;
+      }
+      const vtkIdType left = static_cast<vtkIdType>(nodes.size());
+      nodes[nodeId].Offset = static_cast<int32_t>(left);
+      nodes[nodeId].Count = 0;
+      nodes.emplace_back();
+      nodes.emplace_back();
+      stack.emplace_back(left + 1, split.Right);
+      stack.emplace_back(left, split.Left);
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  void Build(vtkIdType numCells)
+  {
+    const Range root = this->Initialize(numCells);
+    for (int i = 0; i < 3; ++i)
+    {
+      this->Tree->Bounds[2 * i] = root.Bounds.Min[i];
+      this->Tree->Bounds[2 * i + 1] = root.Bounds.Max[i];
+    }
+
+    // Split the first levels one node at a time until there is enough
+    // subtrees to keep the threads busy.
+    std::vector<vtkBVHTree::Node>& nodes = this->Tree->Nodes;
+    nodes.clear();
+    nodes.emplace_back();
+    const size_t numTasks = 4 * static_cast<size_t>(vtkSMPTools::GetEstimatedNumberOfThreads());
+    std::queue<std::pair<vtkIdType, Range>> pending;
+    std::vector<std::pair<vtkIdType, Range>> tasks;
+    pending.emplace(0, root);
+    Split split;
+    while (!pending.empty())
+    {
+      const vtkIdType nodeId = pending.front().first;
+      const Range range = pending.front().second;
+      pending.pop();
+      if (range.Size() < PARALLEL_BINNING_SIZE || pending.size() + tasks.size() >= numTasks)
+      {
+        tasks.emplace_back(nodeId, range);
+        continue;
+      }
+      BVHBuilder::SetBounds(nodes[nodeId], range.Bounds);
+      split = Split();
+      if (!this->FindSplit(range, split))
+      {
+        nodes[nodeId].Offset = static_cast<int32_t>(range.Begin);
+        nodes[nodeId].Count = static_cast<int32_t>(range.Size());
+        continue;
+      }
+      const vtkIdType left = static_cast<vtkIdType>(nodes.size());
+      nodes[nodeId].Offset = static_cast<int32_t>(left);
+      nodes[nodeId].Count = 0;
+      nodes.emplace_back();
+      nodes.emplace_back();
+      pending.emplace(left, split.Left);
+      pending.emplace(left + 1, split.Right);
+    }
+
+    // Build the remaining subtrees in parallel.
+    std::vector<std::vector<vtkBVHTree::Node>> subtrees(tasks.size());
+    vtkSMPTools::For(0, static_cast<vtkIdType>(tasks.size()), 1,
+      [&](vtkIdType begin, vtkIdType end)
+      {
+        for (vtkIdType i = begin; i < end; ++i)
+        {
+          this->BuildSubtree(tasks[i].second, subtrees[i]);
+        }
+      });
+
+    // Append the subtrees: their root replaces the pending node, the other
+    // nodes are shifted after the current ones.
+    for (size_t i = 0; i < tasks.size(); ++i)
+    {
+      std::vector<vtkBVHTree::Node>& subtree = subtrees[i];
+      const int32_t shift = static_cast<int32_t>(nodes.size()) - 1;
+      for (auto& node : subtree)
+      {
+        if (!node.IsLeaf())
+        {
+          node.Offset += shift;
+        }
+      }
+      nodes[tasks[i].first] = subtree[0];
+      nodes.insert(nodes.end(), subtree.begin() + 1, subtree.end());
+    }
+    nodes.shrink_to_fit();
+  }
+};
+
+//------------------------------------------------------------------------------
+// A segment p1 + t * (p2 - p1), t in [0, 1], prepared for box tests.
+struct Ray
+{
+  double Origin[3];
+  double Direction[3];
+  double InverseDirection[3];
+
+  Ray(const double p1[3], const double p2[3])
+  {
+    for (int i = 0; i < 3; ++i)
+    {
+      this->Origin[i] = p1[i];
+      this->Direction[i] = p2[i] - p1[i];
+      // A large finite value avoids 0 * inf when the origin is on a box plane.
+      this->InverseDirection[i] = this->Direction[i] != 0.0 ? 1.0 / this->Direction[i] : 1e300;
+    }
+  }
+};
+
+//------------------------------------------------------------------------------
+// Slab test of a ray against a node inflated by tol. Return whether the ray
+// enters the node before tMax, and the entry parameter.
+inline bool HitNode(
+  const vtkBVHTree::Node& node, const Ray& ray, double tol, double tMax, double& tEntry)
+{
+  double tNear = 0.0;
+  double tFar = tMax;
+  for (int i = 0; i < 3; ++i)
+  {
+    const double t0 = (node.Min[i] - tol - ray.Origin[i]) * ray.InverseDirection[i];
+    const double t1 = (node.Max[i] + tol - ray.Origin[i]) * ray.InverseDirection[i];
+    tNear = std::max(tNear, std::min(t0, t1));
+    tFar = std::min(tFar, std::max(t0, t1));
+  }
+  tEntry = tNear;
+  return tNear <= tFar;
+}
+
+//------------------------------------------------------------------------------
+inline bool NodeContains(const vtkBVHTree::Node& node, const double x[3])
+{
+  return node.Min[0] <= x[0] && x[0] <= node.Max[0] && node.Min[1] <= x[1] &&
+    x[1] <= node.Max[1] && node.Min[2] <= x[2] && x[2] <= node.Max[2];
+}
+
+//------------------------------------------------------------------------------
+inline double Distance2ToNode(const vtkBVHTree::Node& node, const double x[3])
+{
+  double distance2 = 0.0;
+  for (int i = 0; i < 3; ++i)
+  {
+    const double delta = std::max({ node.Min[i] - x[i], 0.0, x[i] - node.Max[i] });
+    distance2 += delta * delta;
+  }
+  return distance2;
+}
+
+//------------------------------------------------------------------------------
+inline double Distance2ToBounds(const double bounds[6], const double x[3])
+{
+  double distance2 = 0.0;
+  for (int i = 0; i < 3; ++i)
+  {
+    const double delta = std::max({ bounds[2 * i] - x[i], 0.0, x[i] - bounds[2 * i + 1] });
+    distance2 += delta * delta;
+  }
+  return distance2;
+}
+
+//------------------------------------------------------------------------------
+struct IntersectionInfo
+{
+  vtkIdType CellId;
+  std::array<double, 3> IntersectionPoint;
+  double T;
+
+  IntersectionInfo(vtkIdType cellId, const double x[3], double t)
+    : CellId(cellId)
+    , IntersectionPoint({ x[0], x[1], x[2] })
+    , T(t)
+  {
+  }
+};
+
+//------------------------------------------------------------------------------
+void AddBox(vtkPoints* points, vtkCellArray* lines, const vtkBVHTree::Node& node)
+{
+  vtkIdType ids[8];
+  for (int corner = 0; corner < 8; ++corner)
+  {
+    ids[corner] = points->InsertNextPoint((corner & 1) ? node.Max[0] : node.Min[0],
+      (corner & 2) ? node.Max[1] : node.Min[1], (corner & 4) ? node.Max[2] : node.Min[2]);
+  }
+  constexpr int edges[12][2] = { { 0, 1 }, { 2, 3 }, { 4, 5 }, { 6, 7 }, { 0, 2 }, { 1, 3 },
+    { 4, 6 }, { 5, 7 }, { 0, 4 }, { 1, 5 }, { 2, 6 }, { 3, 7 } };
+  for (const auto& edge : edges)
+  {
+    const vtkIdType line[2] = { ids[edge[0]], ids[edge[1]] };
+    lines->InsertNextCell(2, line);
+  }
+}
+} // anonymous namespace
+
+//------------------------------------------------------------------------------
+// Here is the VTK class proper.
+
+//------------------------------------------------------------------------------
+vtkBVHCellLocator::vtkBVHCellLocator()
+{
+  this->CacheCellBounds = 1; // always cached
+  this->NumberOfCellsPerNode = 4;
+  this->NumberOfBins = 16;
+}
+
+//------------------------------------------------------------------------------
+vtkBVHCellLocator::~vtkBVHCellLocator()
+{
+  this->FreeSearchStructure();
+  this->FreeCellBounds();
+}
+
+//------------------------------------------------------------------------------
+void vtkBVHCellLocator::FreeSearchStructure()
+{
+  this->Tree.reset();
+}
+
+//------------------------------------------------------------------------------
+void vtkBVHCellLocator::BuildLocator()
+{
+  // don't rebuild if build time is newer than modified and dataset modified time
+  if (this->Tree && this->BuildTime > this->MTime && this->BuildTime > this->DataSet->GetMTime())
+  {
+    return;
+  }
+  // don't rebuild if UseExistingSearchStructure is ON and a search structure already exists
+  if (this->Tree && this->UseExistingSearchStructure)
+  {
+    this->BuildTime.Modified();
+    vtkDebugMacro(<< "BuildLocator exited - UseExistingSearchStructure");
+    return;
+  }
+  this->BuildLocatorInternal();
+}
+
+//------------------------------------------------------------------------------
+void vtkBVHCellLocator::ForceBuildLocator()
+{
+  this->BuildLocatorInternal();
+}
+
+//------------------------------------------------------------------------------
+void vtkBVHCellLocator::BuildLocatorInternal()
+{
+  vtkIdType numCells;
+  if (!this->DataSet || (numCells = this->DataSet->GetNumberOfCells()) < 1)
+  {
+    vtkErrorMacro(<< " No Cells in the data set\n");
+    return;
+  }
+  if (numCells >= VTK_INT_MAX)
+  {
+    vtkErrorMacro(<< "vtkBVHCellLocator supports less than " << VTK_INT_MAX << " cells.");
+    return;
+  }
+  this->FreeSearchStructure();
+  this->FreeCellBounds();
+  this->StoreCellBounds();
+
+  auto tree = std::make_shared<vtkBVHTree>();
+  tree->MaxCellSize = this->DataSet->GetMaxCellSize();
+  BVHBuilder builder(tree.get(), this->CellBounds, this->NumberOfBins,
+    std::min(this->NumberOfCellsPerNode, VTK_INT_MAX / 4));
+  builder.Build(numCells);
+  this->Tree = tree;
+  this->BuildTime.Modified();
+}
+
+//------------------------------------------------------------------------------
+vtkIdType vtkBVHCellLocator::GetNumberOfNodes()
+{
+  return this->Tree ? static_cast<vtkIdType>(this->Tree->Nodes.size()) : 0;
+}
+
+//------------------------------------------------------------------------------
+unsigned long vtkBVHCellLocator::GetActualMemorySize()
+{
+  size_t size = 0;
+  if (this->Tree)
+  {
+    size += this->Tree->Nodes.capacity() * sizeof(vtkBVHTree::Node);
+    size += this->Tree->CellIds.capacity() * sizeof(vtkIdType);
+  }
+  if (this->CellBoundsSharedPtr)
+  {
+    size += this->CellBoundsSharedPtr->capacity() * sizeof(double);
+  }
+  return static_cast<unsigned long>(std::ceil(size / 1024.0));
+}
+
+//------------------------------------------------------------------------------
+vtkIdType vtkBVHCellLocator::FindCell(
+  double x[3], double, vtkGenericCell* cell, int& subId, double pcoords[3], double* weights)
+{
+  this->BuildLocator();
+  if (!this->Tree)
+  {
+    return -1;
+  }
+  const vtkBVHTree::Node* nodes = this->Tree->Nodes.data();
+  const vtkIdType* cellIds = this->Tree->CellIds.data();
+  double dist2;
+
+  int32_t stack[MAX_STACK_SIZE];
+  int stackSize = 0;
+  if (NodeContains(nodes[0], x))
+  {
+    stack[stackSize++] = 0;
+  }
+  while (stackSize > 0)
+  {
+    const vtkBVHTree::Node& node = nodes[stack[--stackSize]];
+    if (node.IsLeaf())
+    {
+      for (int32_t i = node.Offset; i < node.Offset + node.Count; ++i)
+      {
+        const vtkIdType cellId = cellIds[i];
+        if (vtkAbstractCellLocator::IsInBounds(this->CellBounds + 6 * cellId, x))
+        {
+          this->DataSet->GetCell(cellId, cell);
+          if (cell->EvaluatePosition(x, nullptr, subId, pcoords, dist2, weights) == 1)
+          {
+            return cellId;
+          }
+        }
+      }
+      continue;
+    }
+    for (int32_t child = node.Offset + 1; child >= node.Offset; --child)
+    {
+      if (NodeContains(nodes[child], x))
+      {
+        stack[stackSize++] = child;
+      }
+    }
+  }
+  return -1;
+}
+
+//------------------------------------------------------------------------------
+int vtkBVHCellLocator::IntersectWithLine(const double p1[3], const double p2[3], double tol,
+  double& t, double x[3], double pcoords[3], int& subId, vtkIdType& cellId, vtkGenericCell* cell)
+{
+  this->BuildLocator();
+  if (!this->Tree)
+  {
+    return 0;
+  }
+  const vtkBVHTree::Node* nodes = this->Tree->Nodes.data();
+  const vtkIdType* cellIds = this->Tree->CellIds.data();
+  const Ray ray(p1, p2);
+
+  double tBest = VTK_DOUBLE_MAX, xBest[3], pcoordsBest[3], tHit, xHit[3], pcoordsHit[3];
+  double hitCellBoundsPosition[3], tHitCellBounds;
+  int subIdBest = -1, subIdHit;
+  vtkIdType cellIdBest = -1;
+
+  // Stack of nodes, with their entry parameter so that nodes further than the
+  // best hit found meanwhile can be skipped.
+  std::pair<int32_t, double> stack[MAX_STACK_SIZE];
+  int stackSize = 0;
+  double tEntry, tEntries[2];
+  if (HitNode(nodes[0], ray, tol, 1.0, tEntry))
+  {
+    stack[stackSize++] = std::make_pair(0, tEntry);
+  }
+  while (stackSize > 0)
+  {
+    const auto top = stack[--stackSize];
+    if (top.second > tBest)
+    {
+      continue;
+    }
+    const vtkBVHTree::Node& node = nodes[top.first];
+    if (node.IsLeaf())
+    {
+      for (int32_t i = node.Offset; i < node.Offset + node.Count; ++i)
+      {
+        const vtkIdType cId = cellIds[i];
+        if (vtkBox::IntersectBox(this->CellBounds + 6 * cId, p1, ray.Direction,
+              hitCellBoundsPosition, tHitCellBounds, tol) &&
+          tHitCellBounds <= tBest)
+        {
+          this->DataSet->GetCell(cId, cell);
+          if (cell->IntersectWithLine(p1, p2, tol, tHit, xHit, pcoordsHit, subIdHit) &&
+            tHit < tBest)
+          {
+            tBest = tHit;
+            cellIdBest = cId;
+            subIdBest = subIdHit;
+            std::copy_n(xHit, 3, xBest);
+            std::copy_n(pcoordsHit, 3, pcoordsBest);
+          }
+        }
+      }
+      continue;
+    }
+    // Test both children, visit the nearest first.
+    bool hits[2];
+    for (int c = 0; c < 2; ++c)
+    {
+      hits[c] = HitNode(nodes[node.Offset + c], ray, tol, std::min(tBest, 1.0), tEntries[c]);
+    }
+    const int nearChild = (hits[1] && (!hits[0] || tEntries[1] < tEntries[0])) ? 1 : 0;
+    const int farChild = 1 - nearChild;
+    if (hits[farChild])
+    {
+      stack[stackSize++] = std::make_pair(node.Offset + farChild, tEntries[farChild]);
+    }
+    if (hits[nearChild])
+    {
+      stack[stackSize++] = std::make_pair(node.Offset + nearChild, tEntries[nearChild]);
+    }
+  }
+
+  if (cellIdBest < 0)
+  {
+    return 0;
+  }
+  t = tBest;
+  subId = subIdBest;
+  cellId = cellIdBest;
+  std::copy_n(xBest, 3, x);
+  std::copy_n(pcoordsBest, 3, pcoords);
+  this->DataSet->GetCell(cellId, cell);
+  return 1;
+}
+
+//------------------------------------------------------------------------------
+int vtkBVHCellLocator::IntersectWithLine(const double p1[3], const double p2[3], double tol,
+  vtkPoints* points, vtkIdList* cellIds, vtkGenericCell* cell)
+{
+  // Initialize the list of points/cells
+  if (points)
+  {
+    points->Reset();
+  }
+  if (cellIds)
+  {
+    cellIds->Reset();
+  }
+  this->BuildLocator();
+  if (!this->Tree)
+  {
+    return 0;
+  }
+  const vtkBVHTree::Node* nodes = this->Tree->Nodes.data();
+  const vtkIdType* leafCellIds = this->Tree->CellIds.data();
+  const Ray ray(p1, p2);
+  double t, x[3], pcoords[3], hitCellBoundsPosition[3], tHitCellBounds, tEntry;
+  int subId;
+
+  // Each cell belongs to a single leaf, so it is found at most once.
+  std::vector<IntersectionInfo> cellIntersections;
+  int32_t stack[MAX_STACK_SIZE];
+  int stackSize = 0;
+  stack[stackSize++] = 0;
+  while (stackSize > 0)
+  {
+    const vtkBVHTree::Node& node = nodes[stack[--stackSize]];
+    if (!HitNode(node, ray, tol, 1.0, tEntry))
+    {
+      continue;
+    }
+    if (!node.IsLeaf())
+    {
+      stack[stackSize++] = node.Offset + 1;
+      stack[stackSize++] = node.Offset;
+      continue;
+    }
+    for (int32_t i = node.Offset; i < node.Offset + node.Count; ++i)
+    {
+      const vtkIdType cId = leafCellIds[i];
+      if (!vtkBox::IntersectBox(this->CellBounds + 6 * cId, p1, ray.Direction,
+            hitCellBoundsPosition, tHitCellBounds, tol))
+      {
+        continue;
+      }
+      if (cell)
+      {
+        this->DataSet->GetCell(cId, cell);
+        if (cell->IntersectWithLine(p1, p2, tol, t, x, pcoords, subId))
+        {
+          cellIntersections.emplace_back(cId, x, t);
+        }
+      }
+      else
+      {
+        cellIntersections.emplace_back(cId, hitCellBoundsPosition, tHitCellBounds);
+      }
+    }
+  }
+
+  // if we had intersections, sort them by increasing t
+  if (cellIntersections.empty())
+  {
+    return 0;
+  }
+  const vtkIdType numIntersections = static_cast<vtkIdType>(cellIntersections.size());
+  std::sort(cellIntersections.begin(), cellIntersections.end(),
+    [&](const IntersectionInfo& a, const IntersectionInfo& b) { return a.T < b.T; });
+  if (points)
+  {
+    points->SetNumberOfPoints(numIntersections);
+    for (vtkIdType i = 0; i < numIntersections; ++i)
+    {
+      points->SetPoint(i, cellIntersections[i].IntersectionPoint.data());
+    }
+  }
+  if (cellIds)
+  {
+    cellIds->SetNumberOfIds(numIntersections);
+    for (vtkIdType i = 0; i < numIntersections; ++i)
+    {
+      cellIds->SetId(i, cellIntersections[i].CellId);
+    }
+  }
+  return 1;
+}
+
+//------------------------------------------------------------------------------
+void vtkBVHCellLocator::IntersectWithLines(vtkPoints* p1, vtkPoints* p2, double tol,
+  vtkIdList* cellIds, vtkDoubleArray* t, vtkPoints* intersections)
+{
+  if (!p1 || !p2 || !cellIds || p1->GetNumberOfPoints() != p2->GetNumberOfPoints())
+  {
+    vtkErrorMacro(<< "IntersectWithLines needs as many start points as end points");
+    return;
+  }
+  const vtkIdType numQueries = p1->GetNumberOfPoints();
+  cellIds->SetNumberOfIds(numQueries);
+  std::fill_n(cellIds->GetPointer(0), numQueries, -1);
+  vtkIdType* ids = cellIds->GetPointer(0);
+  double* tOut = vtkCellLocatorBatch::AllocateTuples(t, 1, numQueries);
+  vtkCellLocatorBatch::AllocatePoints(intersections, numQueries);
+  this->BuildLocator();
+  if (!this->Tree)
+  {
+    return;
+  }
+
+  // Packets are made of consecutive queries in the coherent order.
+  std::vector<vtkIdType> order;
+  this->GetQueryOrder(p1, p2, order);
+  const vtkIdType numPackets = (numQueries + PACKET_SIZE - 1) / PACKET_SIZE;
+  const vtkBVHTree::Node* nodes = this->Tree->Nodes.data();
+  const vtkIdType* leafCellIds = this->Tree->CellIds.data();
+  const double* cellBounds = this->CellBounds;
+  vtkDataSet* dataSet = this->DataSet;
+
+  vtkCellLocatorBatch::Run(this->DataSet, numPackets, std::vector<vtkIdType>(),
+    [&](vtkIdType packetId, vtkGenericCell* cell, double*)
+    {
+      // The slab tests use a structure of arrays of the rays of the packet, so
+      // that the loops over the rays can be vectorized.
+      vtkIdType queryIds[PACKET_SIZE];
+      double a0[PACKET_SIZE][3], a1[PACKET_SIZE][3], rayDirection[PACKET_SIZE][3];
+      double origin[3][PACKET_SIZE], inverse[3][PACKET_SIZE];
+      double tBest[PACKET_SIZE], xBest[PACKET_SIZE][3];
+      vtkIdType cellIdBest[PACKET_SIZE];
+      const vtkIdType first = packetId * PACKET_SIZE;
+      const int numRays = static_cast<int>(std::min<vtkIdType>(PACKET_SIZE, numQueries - first));
+      for (int r = 0; r < PACKET_SIZE; ++r)
+      {
+        // Unused lanes repeat the last ray, which cannot hit anything new.
+        const int lane = std::min(r, numRays - 1);
+        queryIds[r] = order.empty() ? first + lane : order[first + lane];
+        p1->GetPoint(queryIds[r], a0[r]);
+        p2->GetPoint(queryIds[r], a1[r]);
+        for (int i = 0; i < 3; ++i)
+        {
+          origin[i][r] = a0[r][i];
+          rayDirection[r][i] = a1[r][i] - a0[r][i];
+          inverse[i][r] = rayDirection[r][i] != 0.0 ? 1.0 / rayDirection[r][i] : 1e300;
+        }
+        tBest[r] = VTK_DOUBLE_MAX;
+        cellIdBest[r] = -1;
+      }
+
+      // Slab test of the whole packet against a node.
+      auto hitNode = [&](const vtkBVHTree::Node& node, bool hits[PACKET_SIZE])
+      {
+        bool any = false;
+        for (int r = 0; r < PACKET_SIZE; ++r)
+        {
+          double tNear = 0.0;
+          double tFar = std::min(tBest[r], 1.0);
+          for (int i = 0; i < 3; ++i)
+          {
+            const double t0 = (node.Min[i] - tol - origin[i][r]) * inverse[i][r];
+            const double t1 = (node.Max[i] + tol - origin[i][r]) * inverse[i][r];
+            tNear = std::max(tNear, std::min(t0, t1));
+            tFar = std::min(tFar, std::max(t0, t1));
+          }
+          hits[r] = tNear <= tFar;
+          any |= hits[r];
+        }
+        return any;
+      };
+
+      double tHit, xHit[3], pcoords[3], hitCellBoundsPosition[3], tHitCellBounds;
+      int subId;
+      bool hits[PACKET_SIZE];
+      int32_t stack[MAX_STACK_SIZE];
+      int stackSize = 0;
+      stack[stackSize++] = 0;
+      while (stackSize > 0)
+      {
+        const vtkBVHTree::Node& node = nodes[stack[--stackSize]];
+        if (!hitNode(node, hits))
+        {
+          continue;
+        }
+        if (!node.IsLeaf())
+        {
+          // Visit first the child nearest to the first active ray.
+          const int lead = static_cast<int>(std::find(hits, hits + PACKET_SIZE, true) - hits);
+          const Ray leadRay(a0[lead], a1[lead]);
+          double tEntries[2];
+          HitNode(nodes[node.Offset], leadRay, tol, VTK_DOUBLE_MAX, tEntries[0]);
+          HitNode(nodes[node.Offset + 1], leadRay, tol, VTK_DOUBLE_MAX, tEntries[1]);
+          const int nearChild = tEntries[1] < tEntries[0] ? 1 : 0;
+          stack[stackSize++] = node.Offset + 1 - nearChild;
+          stack[stackSize++] = node.Offset + nearChild;
+          continue;
+        }
+        for (int32_t i = node.Offset; i < node.Offset + node.Count; ++i)
+        {
+          // The cell is only extracted once for the whole packet.
+          const vtkIdType cId = leafCellIds[i];
+          bool cellExtracted = false;
+          for (int r = 0; r < numRays; ++r)
+          {
+            if (!hits[r] ||
+              !vtkBox::IntersectBox(cellBounds + 6 * cId, a0[r], rayDirection[r],
+                hitCellBoundsPosition, tHitCellBounds, tol) ||
+              tHitCellBounds > tBest[r])
+            {
+              continue;
+            }
+            if (!cellExtracted)
+            {
+              dataSet->GetCell(cId, cell);
+              cellExtracted = true;
+            }
+            if (cell->IntersectWithLine(a0[r], a1[r], tol, tHit, xHit, pcoords, subId) &&
+              tHit < tBest[r])
+            {
+              tBest[r] = tHit;
+              cellIdBest[r] = cId;
+              std::copy_n(xHit, 3, xBest[r]);
+            }
+          }
+        }
+      }
+
+      for (int r = 0; r < numRays; ++r)
+      {
+        if (cellIdBest[r] < 0)
+        {
+          continue;
+        }
+        ids[queryIds[r]] = cellIdBest[r];
+        if (tOut)
+        {
+          tOut[queryIds[r]] = tBest[r];
+        }
+        if (intersections)
+        {
+          intersections->SetPoint(queryIds[r], xBest[r]);
+        }
+      }
+    });
+
+  if (t)
+  {
+    t->Modified();
+  }
+  if (intersections)
+  {
+    intersections->Modified();
+  }
+}
+
+//------------------------------------------------------------------------------
+vtkIdType vtkBVHCellLocator::FindClosestPointWithinRadius(double x[3], double radius,
+  double closestPoint[3], vtkGenericCell* cell, vtkIdType& closestCellId, int& closestSubId,
+  double& minDist2, int& inside)
+{
+  this->BuildLocator();
+  if (!this->Tree)
+  {
+    return 0;
+  }
+  const vtkBVHTree::Node* nodes = this->Tree->Nodes.data();
+  const vtkIdType* cellIds = this->Tree->CellIds.data();
+  std::vector<double> weights(this->Tree->MaxCellSize);
+  double pcoords[3], point[3], dist2;
+  int subId, stat;
+  vtkIdType retVal = 0;
+
+  using node = std::pair<double, int32_t>;
+  std::priority_queue<node, std::vector<node>, std::greater<>> queue;
+  queue.emplace(Distance2ToNode(nodes[0], x), 0);
+
+  // minimum squared distance to the closest point
+  minDist2 = radius * radius;
+
+  // Process the nodes by increasing distance until they are further away
+  // than the current closest point.
+  while (!queue.empty())
+  {
+    const node top = queue.top();
+    if (top.first > minDist2)
+    {
+      break;
+    }
+    queue.pop();
+    const vtkBVHTree::Node& current = nodes[top.second];
+    if (!current.IsLeaf())
+    {
+      for (int32_t child = current.Offset; child <= current.Offset + 1; ++child)
+      {
+        const double childDist2 = Distance2ToNode(nodes[child], x);
+        if (childDist2 <= minDist2)
+        {
+          queue.emplace(childDist2, child);
+        }
+      }
+      continue;
+    }
+    for (int32_t i = current.Offset; i < current.Offset + current.Count; ++i)
+    {
+      const vtkIdType cellId = cellIds[i];
+      // compute distance to cell only if distance to bounding box smaller than minDist2
+      if (Distance2ToBounds(this->CellBounds + 6 * cellId, x) < minDist2)
+      {
+        this->DataSet->GetCell(cellId, cell);
+        // stat==(-1) is numerical error; stat==0 means outside; stat=1 means inside.
+        stat = cell->EvaluatePosition(x, point, subId, pcoords, dist2, weights.data());
+        if (stat != -1 && dist2 < minDist2)
+        {
+          retVal = 1;
+          inside = stat;
+          minDist2 = dist2;
+          closestCellId = cellId;
+          closestSubId = subId;
+          std::copy_n(point, 3, closestPoint);
+        }
+      }
+    }
+  }
+  if (retVal)
+  {
+    this->DataSet->GetCell(closestCellId, cell);
+  }
+  return retVal;
+}
+
+//------------------------------------------------------------------------------
+void vtkBVHCellLocator::FindCellsWithinBounds(double* bbox, vtkIdList* cells)
+{
+  if (!cells)
+  {
+    return;
+  }
+  cells->Reset();
+  this->BuildLocator();
+  if (!this->Tree)
+  {
+    return;
+  }
+  const vtkBVHTree::Node* nodes = this->Tree->Nodes.data();
+  const vtkIdType* cellIds = this->Tree->CellIds.data();
+  auto overlaps = [bbox](const double min[3], const double max[3])
+  {
+    return min[0] <= bbox[1] && bbox[0] <= max[0] && min[1] <= bbox[3] && bbox[2] <= max[1] &&
+      min[2] <= bbox[5] && bbox[4] <= max[2];
+  };
+
+  int32_t stack[MAX_STACK_SIZE];
+  int stackSize = 0;
+  stack[stackSize++] = 0;
+  while (stackSize > 0)
+  {
+    const vtkBVHTree::Node& node = nodes[stack[--stackSize]];
+    const double min[3] = { node.Min[0], node.Min[1], node.Min[2] };
+    const double max[3] = { node.Max[0], node.Max[1], node.Max[2] };
+    if (!overlaps(min, max))
+    {
+      continue;
+    }
+    if (!node.IsLeaf())
+    {
+      stack[stackSize++] = node.Offset + 1;
+      stack[stackSize++] = node.Offset;
+      continue;
+    }
+    for (int32_t i = node.Offset; i < node.Offset + node.Count; ++i)
+    {
+      const double* bds = this->CellBounds + 6 * cellIds[i];
+      const double cellMin[3] = { bds[0], bds[2], bds[4] };
+      const double cellMax[3] = { bds[1], bds[3], bds[5] };
+      if (overlaps(cellMin, cellMax))
+      {
+        cells->InsertNextId(cellIds[i]);
+      }
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+void vtkBVHCellLocator::GenerateRepresentation(int level, vtkPolyData* pd)
+{
+  this->BuildLocator();
+  if (!this->Tree)
+  {
+    return;
+  }
+  vtkNew<vtkPoints> points;
+  points->SetDataTypeToFloat();
+  vtkNew<vtkCellArray> lines;
+  pd->SetPoints(points);
+  pd->SetLines(lines);
+
+  const vtkBVHTree::Node* nodes = this->Tree->Nodes.data();
+  std::vector<std::pair<int32_t, int>> stack;
+  stack.emplace_back(0, 0);
+  while (!stack.empty())
+  {
+    const int32_t nodeId = stack.back().first;
+    const int nodeLevel = stack.back().second;
+    stack.pop_back();
+    const vtkBVHTree::Node& node = nodes[nodeId];
+    if (nodeLevel == level || (level < 0 && node.IsLeaf()))
+    {
+      AddBox(points, lines, node);
+    }
+    else if (!node.IsLeaf())
+    {
+      stack.emplace_back(node.Offset + 1, nodeLevel + 1);
+      stack.emplace_back(node.Offset, nodeLevel + 1);
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+void vtkBVHCellLocator::ShallowCopy(vtkAbstractCellLocator* locator)
+{
+  vtkBVHCellLocator* cellLocator = vtkBVHCellLocator::SafeDownCast(locator);
+  if (!cellLocator)
+  {
+    vtkErrorMacro("Cannot cast " << locator->GetClassName() << " to vtkBVHCellLocator.");
+    return;
+  }
+  // we only copy what's actually used by vtkBVHCellLocator
+
+  // vtkLocator parameters
+  this->SetUseExistingSearchStructure(cellLocator->GetUseExistingSearchStructure());
+
+  // vtkAbstractCellLocator parameters
+  this->SetNumberOfCellsPerNode(cellLocator->GetNumberOfCellsPerNode());
+  this->CacheCellBounds = cellLocator->CacheCellBounds;
+  this->CellBoundsSharedPtr = cellLocator->CellBoundsSharedPtr; // This is important
+  this->CellBounds = this->CellBoundsSharedPtr.get() ? this->CellBoundsSharedPtr->data() : nullptr;
+
+  // vtkBVHCellLocator parameters
+  this->NumberOfBins = cellLocator->NumberOfBins;
+  this->Tree = cellLocator->Tree;
+  this->BuildTime.Modified();
+}
+
+//------------------------------------------------------------------------------
+void vtkBVHCellLocator::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+
+  os << indent << "Number Of Bins: " << this->NumberOfBins << "\n";
+  os << indent << "Number Of Nodes: " << this->GetNumberOfNodes() << "\n";
+}
+VTK_ABI_NAMESPACE_END
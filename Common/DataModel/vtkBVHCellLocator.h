@@ -0,0 +1,191 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class   vtkBVHCellLocator
+ * @brief   a bounding volume hierarchy of cells, tuned for ray queries
+ *
+ * vtkBVHCellLocator is a type of vtkAbstractCellLocator which organizes the
+ * cells in a binary bounding volume hierarchy (BVH). The tree is built top
+ * down in parallel (via vtkSMPTools): each node is split along the plane
+ * which minimizes the surface area heuristic (SAH) among NumberOfBins
+ * candidate planes per axis, which makes it especially efficient for
+ * IntersectWithLine and similar ray queries on large surface meshes.
+ *
+ * The nodes are stored in a compact array of 32 bytes per node, the two
+ * children of a node being adjacent, and single precision bounds rounded
+ * outwards. Queries test both children of a node at once and visit the
+ * nearest one first. The batched IntersectWithLines traverses the tree with
+ * packets of rays, so that the nodes and cells visited are shared by several
+ * coherent rays.
+ *
+ * vtkBVHCellLocator utilizes the following parent class parameters:
+ * - NumberOfCellsPerNode        (default 4)
+ * - UseExistingSearchStructure  (default false)
+ *
+ * vtkBVHCellLocator does NOT utilize the following parameters:
+ * - CacheCellBounds             (always cached)
+ * - Automatic
+ * - Level
+ * - MaxLevel
+ * - Tolerance
+ * - RetainCellLists
+ *
+ * @warning
+ * The number of cells must be smaller than VTK_INT_MAX.
+ *
+ * @sa
+ * vtkAbstractCellLocator vtkCellLocator vtkStaticCellLocator vtkCellTreeLocator
+ * vtkModifiedBSPTree vtkOBBTree
+ */
+
+#ifndef vtkBVHCellLocator_h
+#define vtkBVHCellLocator_h
+
+#include "vtkAbstractCellLocator.h"
+#include "vtkCommonDataModelModule.h" // For export macro
+
+#include <memory> // For shared_ptr
+
+VTK_ABI_NAMESPACE_BEGIN
+struct vtkBVHTree;
+
+class VTKCOMMONDATAMODEL_EXPORT vtkBVHCellLocator : public vtkAbstractCellLocator
+{
+public:
+  ///@{
+  /**
+   * Standard methods to instantiate, print and obtain type-related information.
+   */
+  static vtkBVHCellLocator* New();
+  vtkTypeMacro(vtkBVHCellLocator, vtkAbstractCellLocator);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+  ///@}
+
+  ///@{
+  /**
+   * Set/Get the number of candidate split planes evaluated per axis with the
+   * surface area heuristic when splitting a node. More bins give a slightly
+   * better tree for a slower build. Default is 16.
+   */
+  vtkSetClampMacro(NumberOfBins, int, 2, 256);
+  vtkGetMacro(NumberOfBins, int);
+  ///@}
+
+  /**
+   * Return the number of nodes of the hierarchy, 0 if it is not built.
+   */
+  vtkIdType GetNumberOfNodes();
+
+  /**
+   * Return the memory used by the hierarchy and the cached cell bounds, in
+   * kibibytes (1024 bytes).
+   */
+  unsigned long GetActualMemorySize();
+
+  // Reuse any superclass signatures that we don't override.
+  using vtkAbstractCellLocator::FindCell;
+  using vtkAbstractCellLocator::FindClosestPoint;
+  using vtkAbstractCellLocator::FindClosestPointWithinRadius;
+  using vtkAbstractCellLocator::IntersectWithLine;
+
+  /**
+   * Return intersection point (if any) AND the cell which was intersected by
+   * the finite line. The cell is returned as a cell id and as a generic cell.
+   *
+   * For other IntersectWithLine signatures, see vtkAbstractCellLocator.
+   */
+  int IntersectWithLine(const double a0[3], const double a1[3], double tol, double& t, double x[3],
+    double pcoords[3], int& subId, vtkIdType& cellId, vtkGenericCell* cell) override;
+
+  /**
+   * Take the passed line segment and intersect it with the data set.
+   * The return value of the function is 0 if no intersections were found.
+   * For each intersection with the bounds of a cell or with a cell (if a cell is provided),
+   * the points and cellIds have the relevant information added sorted by t.
+   * If points or cellIds are nullptr pointers, then no information is generated for that list.
+   *
+   * For other IntersectWithLine signatures, see vtkAbstractCellLocator.
+   */
+  int IntersectWithLine(const double p1[3], const double p2[3], double tol, vtkPoints* points,
+    vtkIdList* cellIds, vtkGenericCell* cell) override;
+
+  /**
+   * Batched IntersectWithLine, see vtkAbstractCellLocator. The segments are
+   * traversed by packets of coherent rays.
+   */
+  void IntersectWithLines(vtkPoints* p1, vtkPoints* p2, double tol, vtkIdList* cellIds,
+    vtkDoubleArray* t = nullptr, vtkPoints* intersections = nullptr) override;
+
+  /**
+   * Return the closest point within a specified radius and the cell which is
+   * closest to the point x. The closest point is somewhere on a cell, it
+   * need not be one of the vertices of the cell. This method returns 1 if a
+   * point is found within the specified radius. If there are no cells within
+   * the specified radius, the method returns 0 and the values of
+   * closestPoint, cellId, subId, and dist2 are undefined. If a closest point
+   * is found, inside returns the return value of the EvaluatePosition call to
+   * the closest cell; inside(=1) or outside(=0).
+   */
+  vtkIdType FindClosestPointWithinRadius(double x[3], double radius, double closestPoint[3],
+    vtkGenericCell* cell, vtkIdType& cellId, int& subId, double& dist2, int& inside) override;
+
+  /**
+   * Return a list of unique cell ids inside of a given bounding box. The
+   * user must provide the vtkIdList to populate.
+   */
+  void FindCellsWithinBounds(double* bbox, vtkIdList* cells) override;
+
+  /**
+   * Find the cell containing a given point. returns -1 if no cell found
+   * the cell parameters are copied into the supplied variables, a cell must
+   * be provided to store the information.
+   *
+   * For other FindCell signatures, see vtkAbstractCellLocator.
+   */
+  vtkIdType FindCell(double x[3], double vtkNotUsed(tol2), vtkGenericCell* cell, int& subId,
+    double pcoords[3], double* weights) override;
+
+  /**
+   * FindCell, FindClosestPointWithinRadius and IntersectWithLine are thread
+   * safe, the batched queries run in parallel.
+   */
+  int GetThreadSafeQueries() override
+  {
+    return FIND_CELL | FIND_CLOSEST_POINT | INTERSECT_WITH_LINE;
+  }
+
+  ///@{
+  /**
+   * Satisfy vtkLocator abstract interface. GenerateRepresentation produces
+   * the boxes of the nodes at the given level, or of the leaves if level is
+   * -1.
+   */
+  void GenerateRepresentation(int level, vtkPolyData* pd) override;
+  void FreeSearchStructure() override;
+  void BuildLocator() override;
+  void ForceBuildLocator() override;
+  ///@}
+
+  /**
+   * Shallow copy of a vtkBVHCellLocator: the hierarchy is shared.
+   *
+   * Before you shallow copy, make sure to call SetDataSet()
+   */
+  void ShallowCopy(vtkAbstractCellLocator* locator) override;
+
+protected:
+  vtkBVHCellLocator();
+  ~vtkBVHCellLocator() override;
+
+  void BuildLocatorInternal() override;
+
+  int NumberOfBins;
+  std::shared_ptr<vtkBVHTree> Tree;
+
+private:
+  vtkBVHCellLocator(const vtkBVHCellLocator&) = delete;
+  void operator=(const vtkBVHCellLocator&) = delete;
+};
+
+VTK_ABI_NAMESPACE_END
+#endif
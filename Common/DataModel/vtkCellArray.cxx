@@ -758,6 +758,41 @@ void vtkCellArray::DeepCopy(vtkAbstractCellArray* ca)
       this->Modified();
       break;
     }
+    // The deep copy of a view owns its memory: it uses the matching storage.
+    case StorageTypes::ViewInt32:
+    case StorageTypes::ViewInt64:
+    {
+      if (other->StorageType == StorageTypes::ViewInt32)
+      {
+        this->Use32BitStorage();
+      }
+      else
+      {
+        this->Use64BitStorage();
+      }
+      this->Offsets->DeepCopy(other->Offsets);
+      this->Connectivity->DeepCopy(other->Connectivity);
+      this->Modified();
+      break;
+    }
+    case StorageTypes::FixedSizeViewInt32:
+    {
+      this->UseFixedSize32BitStorage(1 /*dummy, ImplicitDeepCopy will fix it*/);
+      this->GetOffsetsAffineArray32()->ImplicitDeepCopy(
+        AffineArray32::FastDownCast(other->Offsets));
+      this->Connectivity->DeepCopy(other->Connectivity);
+      this->Modified();
+      break;
+    }
+    case StorageTypes::FixedSizeViewInt64:
+    {
+      this->UseFixedSize64BitStorage(1 /*dummy, ImplicitDeepCopy will fix it*/);
+      this->GetOffsetsAffineArray64()->ImplicitDeepCopy(
+        AffineArray64::FastDownCast(other->Offsets));
+      this->Connectivity->DeepCopy(other->Connectivity);
+      this->Modified();
+      break;
+    }
     case StorageTypes::Int32:
     case StorageTypes::Int64:
     case StorageTypes::Generic:
@@ -804,6 +839,10 @@ void vtkCellArray::ShallowCopy(vtkAbstractCellArray* ca)
 //------------------------------------------------------------------------------
 void vtkCellArray::Append(vtkCellArray* src, vtkIdType pointOffset)
 {
+  if (this->IsStorageView())
+  {
+    this->DetachView();
+  }
   if (src->GetNumberOfCells() > 0)
   {
     this->Dispatch(AppendImpl{}, src, pointOffset);
@@ -813,6 +852,10 @@ void vtkCellArray::Append(vtkCellArray* src, vtkIdType pointOffset)
 //------------------------------------------------------------------------------
 void vtkCellArray::Initialize()
 {
+  if (this->IsStorageView())
+  {
+    this->DetachView(false);
+  }
   this->Dispatch(InitializeImpl{});
 
   this->LegacyData->Initialize();
@@ -939,6 +982,174 @@ void vtkCellArray::SetData(AffineArray64* offsets, AOSArray64* connectivity)
   this->StorageType = StorageTypes::FixedSizeInt64;
 }
 
+//------------------------------------------------------------------------------
+void vtkCellArray::SetData(ViewArray32* offsets, ViewArray32* connectivity)
+{
+  this->SetViewData(offsets, connectivity, StorageTypes::ViewInt32);
+}
+
+//------------------------------------------------------------------------------
+void vtkCellArray::SetData(ViewArray64* offsets, ViewArray64* connectivity)
+{
+  this->SetViewData(offsets, connectivity, StorageTypes::ViewInt64);
+}
+
+//------------------------------------------------------------------------------
+void vtkCellArray::SetData(AffineArray32* offsets, ViewArray32* connectivity)
+{
+  this->SetViewData(offsets, connectivity, StorageTypes::FixedSizeViewInt32);
+}
+
+//------------------------------------------------------------------------------
+void vtkCellArray::SetData(AffineArray64* offsets, ViewArray64* connectivity)
+{
+  this->SetViewData(offsets, connectivity, StorageTypes::FixedSizeViewInt64);
+}
+
+//------------------------------------------------------------------------------
+void vtkCellArray::SetViewData(
+  vtkDataArray* offsets, vtkDataArray* connectivity, StorageTypes storageType)
+{
+  if (!offsets || !connectivity)
+  {
+    vtkErrorMacro("Empty offsets or connectivity array.");
+    return;
+  }
+  if (offsets->GetNumberOfComponents() != 1 || connectivity->GetNumberOfComponents() != 1)
+  {
+    vtkErrorMacro("Only single component arrays may be used for vtkCellArray "
+                  "storage.");
+    return;
+  }
+
+  if (this->Offsets.Get() != offsets)
+  {
+    this->Offsets = offsets;
+    this->Modified();
+  }
+  if (this->Connectivity.Get() != connectivity)
+  {
+    this->Connectivity = connectivity;
+    this->Modified();
+  }
+  this->StorageType = storageType;
+}
+
+//------------------------------------------------------------------------------
+void vtkCellArray::DetachView(bool copyCells)
+{
+  vtkSmartPointer<vtkDataArray> offsets = this->Offsets;
+  vtkSmartPointer<vtkDataArray> connectivity = this->Connectivity;
+  switch (this->StorageType)
+  {
+    case StorageTypes::ViewInt32:
+      this->Use32BitStorage();
+      break;
+    case StorageTypes::ViewInt64:
+      this->Use64BitStorage();
+      break;
+    case StorageTypes::FixedSizeViewInt32:
+      this->UseFixedSize32BitStorage(1 /*dummy, ImplicitDeepCopy will fix it*/);
+      this->GetOffsetsAffineArray32()->ImplicitDeepCopy(AffineArray32::FastDownCast(offsets));
+      break;
+    case StorageTypes::FixedSizeViewInt64:
+      this->UseFixedSize64BitStorage(1 /*dummy, ImplicitDeepCopy will fix it*/);
+      this->GetOffsetsAffineArray64()->ImplicitDeepCopy(AffineArray64::FastDownCast(offsets));
+      break;
+    default:
+      return;
+  }
+  if (copyCells)
+  {
+    if (!this->IsStorageFixedSize())
+    {
+      this->Offsets->DeepCopy(offsets);
+    }
+    this->Connectivity->DeepCopy(connectivity);
+  }
+  this->Modified();
+}
+
+VTK_ABI_NAMESPACE_END
+
+namespace
+{
+template <typename T>
+void SetDataViewImpl(vtkCellArray* cellArray, vtkIdType numberOfCells, const T* offsets,
+  const T* connectivity, T base)
+{
+  vtkNew<vtkImplicitArray<vtkCellArrayViewBackend<T>>> offsetsView;
+  offsetsView->ConstructBackend(offsets, base);
+  offsetsView->SetNumberOfValues(numberOfCells + 1);
+  vtkNew<vtkImplicitArray<vtkCellArrayViewBackend<T>>> connectivityView;
+  connectivityView->ConstructBackend(connectivity, base);
+  connectivityView->SetNumberOfValues(offsetsView->GetValue(numberOfCells));
+  cellArray->SetData(offsetsView, connectivityView);
+}
+
+template <typename T>
+void SetFixedSizeDataViewImpl(vtkCellArray* cellArray, vtkIdType numberOfCells,
+  vtkIdType cellSize, const T* connectivity, vtkIdType cellStride, T base)
+{
+  vtkNew<vtkAffineArray<T>> offsets;
+  offsets->ConstructBackend(static_cast<T>(cellSize), 0);
+  offsets->SetNumberOfValues(numberOfCells + 1);
+  vtkNew<vtkImplicitArray<vtkCellArrayViewBackend<T>>> connectivityView;
+  connectivityView->ConstructBackend(connectivity, cellSize, cellStride, base);
+  connectivityView->SetNumberOfValues(numberOfCells * cellSize);
+  cellArray->SetData(offsets, connectivityView);
+}
+} // end anon namespace
+
+VTK_ABI_NAMESPACE_BEGIN
+//------------------------------------------------------------------------------
+void vtkCellArray::SetDataView(vtkIdType numberOfCells, const vtkTypeInt32* offsets,
+  const vtkTypeInt32* connectivity, vtkTypeInt32 base)
+{
+  if (numberOfCells < 0 || !offsets || !connectivity)
+  {
+    vtkErrorMacro("Invalid number of cells, offsets or connectivity buffer.");
+    return;
+  }
+  SetDataViewImpl(this, numberOfCells, offsets, connectivity, base);
+}
+
+//------------------------------------------------------------------------------
+void vtkCellArray::SetDataView(vtkIdType numberOfCells, const vtkTypeInt64* offsets,
+  const vtkTypeInt64* connectivity, vtkTypeInt64 base)
+{
+  if (numberOfCells < 0 || !offsets || !connectivity)
+  {
+    vtkErrorMacro("Invalid number of cells, offsets or connectivity buffer.");
+    return;
+  }
+  SetDataViewImpl(this, numberOfCells, offsets, connectivity, base);
+}
+
+//------------------------------------------------------------------------------
+void vtkCellArray::SetFixedSizeDataView(vtkIdType numberOfCells, vtkIdType cellSize,
+  const vtkTypeInt32* connectivity, vtkIdType cellStride, vtkTypeInt32 base)
+{
+  if (numberOfCells < 0 || cellSize <= 0 || cellStride < cellSize || !connectivity)
+  {
+    vtkErrorMacro("Invalid number of cells, cell size, cell stride or connectivity buffer.");
+    return;
+  }
+  SetFixedSizeDataViewImpl(this, numberOfCells, cellSize, connectivity, cellStride, base);
+}
+
+//------------------------------------------------------------------------------
+void vtkCellArray::SetFixedSizeDataView(vtkIdType numberOfCells, vtkIdType cellSize,
+  const vtkTypeInt64* connectivity, vtkIdType cellStride, vtkTypeInt64 base)
+{
+  if (numberOfCells < 0 || cellSize <= 0 || cellStride < cellSize || !connectivity)
+  {
+    vtkErrorMacro("Invalid number of cells, cell size, cell stride or connectivity buffer.");
+    return;
+  }
+  SetFixedSizeDataViewImpl(this, numberOfCells, cellSize, connectivity, cellStride, base);
+}
+
 VTK_ABI_NAMESPACE_END
 
 namespace
@@ -952,6 +1163,13 @@ struct SetDataGenericImpl
     this->CellArray->SetData(offsets, connectivity);
   }
 };
+
+// The arrays of the view storages, which are not part of vtkArrayDispatch::OffsetsArrays
+// and vtkArrayDispatch::ConnectivityArrays.
+using ViewOffsetsArrays = vtkTypeList::Create<vtkCellArray::ViewArray32,
+  vtkCellArray::ViewArray64, vtkCellArray::AffineArray32, vtkCellArray::AffineArray64>;
+using ViewConnectivityArrays =
+  vtkTypeList::Create<vtkCellArray::ViewArray32, vtkCellArray::ViewArray64>;
 } // end anon namespace
 
 VTK_ABI_NAMESPACE_BEGIN
@@ -973,7 +1191,10 @@ bool vtkCellArray::SetData(vtkDataArray* offsets, vtkDataArray* connectivity)
   using Dispatcher =
     vtkArrayDispatch::Dispatch2ByArrayWithSameValueType<vtkArrayDispatch::OffsetsArrays,
       vtkArrayDispatch::ConnectivityArrays>;
-  if (!Dispatcher::Execute(offsets, connectivity, worker))
+  using ViewDispatcher =
+    vtkArrayDispatch::Dispatch2ByArrayWithSameValueType<ViewOffsetsArrays, ViewConnectivityArrays>;
+  if (!Dispatcher::Execute(offsets, connectivity, worker) &&
+    !ViewDispatcher::Execute(offsets, connectivity, worker))
   {
     if (this->Offsets.Get() != offsets)
     {
@@ -1335,6 +1556,10 @@ bool vtkCellArray::ConvertToSmallestStorage()
 //------------------------------------------------------------------------------
 bool vtkCellArray::AllocateExact(vtkIdType numCells, vtkIdType connectivitySize)
 {
+  if (this->IsStorageView())
+  {
+    this->DetachView(false);
+  }
   bool result;
   this->Dispatch(AllocateExactImpl{}, numCells, connectivitySize, result);
   return result;
@@ -1343,6 +1568,10 @@ bool vtkCellArray::AllocateExact(vtkIdType numCells, vtkIdType connectivitySize)
 //------------------------------------------------------------------------------
 bool vtkCellArray::ResizeExact(vtkIdType numCells, vtkIdType connectivitySize)
 {
+  if (this->IsStorageView())
+  {
+    this->DetachView();
+  }
   bool result;
   this->Dispatch(ResizeExactImpl{}, numCells, connectivitySize, result);
   return result;
@@ -1390,6 +1619,18 @@ void vtkCellArray::PrintSelf(ostream& os, vtkIndent indent)
     case StorageTypes::FixedSizeInt64:
       os << "FixedSizeInt64\n";
       break;
+    case StorageTypes::ViewInt32:
+      os << "ViewInt32\n";
+      break;
+    case StorageTypes::ViewInt64:
+      os << "ViewInt64\n";
+      break;
+    case StorageTypes::FixedSizeViewInt32:
+      os << "FixedSizeViewInt32\n";
+      break;
+    case StorageTypes::FixedSizeViewInt64:
+      os << "FixedSizeViewInt64\n";
+      break;
     case StorageTypes::Generic:
     default:
       os << "Generic\n";
@@ -1422,12 +1663,20 @@ void vtkCellArray::SetTraversalCellId(vtkIdType cellId)
 //------------------------------------------------------------------------------
 void vtkCellArray::ReverseCellAtId(vtkIdType cellId)
 {
+  if (this->IsStorageView())
+  {
+    this->DetachView();
+  }
   this->Dispatch(ReverseCellAtIdImpl{}, cellId);
 }
 
 //------------------------------------------------------------------------------
 void vtkCellArray::ReplaceCellAtId(vtkIdType cellId, vtkIdList* list)
 {
+  if (this->IsStorageView())
+  {
+    this->DetachView();
+  }
   this->Dispatch(ReplaceCellAtIdImpl{}, cellId, list->GetNumberOfIds(), list->GetPointer(0));
 }
 
@@ -1435,6 +1684,10 @@ void vtkCellArray::ReplaceCellAtId(vtkIdType cellId, vtkIdList* list)
 void vtkCellArray::ReplaceCellAtId(
   vtkIdType cellId, vtkIdType cellSize, const vtkIdType cellPoints[])
 {
+  if (this->IsStorageView())
+  {
+    this->DetachView();
+  }
   this->Dispatch(ReplaceCellAtIdImpl{}, cellId, cellSize, cellPoints);
 }
 
@@ -1442,6 +1695,10 @@ void vtkCellArray::ReplaceCellAtId(
 void vtkCellArray::ReplaceCellPointAtId(
   vtkIdType cellId, vtkIdType cellPointIndex, vtkIdType newPointId)
 {
+  if (this->IsStorageView())
+  {
+    this->DetachView();
+  }
   this->Dispatch(ReplaceCellPointAtIdImpl{}, cellId, cellPointIndex, newPointId);
 }
 
@@ -1489,13 +1746,21 @@ void vtkCellArray::AppendLegacyFormat(vtkIdTypeArray* data, vtkIdType ptOffset)
 //------------------------------------------------------------------------------
 void vtkCellArray::AppendLegacyFormat(const vtkIdType* data, vtkIdType len, vtkIdType ptOffset)
 {
+  if (this->IsStorageView())
+  {
+    this->DetachView();
+  }
   this->Dispatch(AppendLegacyFormatImpl{}, data, len, ptOffset);
 }
 
 //------------------------------------------------------------------------------
 void vtkCellArray::Squeeze()
 {
-  this->Dispatch(SqueezeImpl{});
+  // The external buffers of a view are not ours to reallocate.
+  if (!this->IsStorageView())
+  {
+    this->Dispatch(SqueezeImpl{});
+  }
 
   // Just delete the legacy buffer.
   this->LegacyData->Initialize();
@@ -1512,7 +1777,9 @@ bool vtkCellArray::IsValid()
 //------------------------------------------------------------------------------
 vtkIdType vtkCellArray::IsHomogeneous() const
 {
-  if (this->IsStorageFixedSize32Bit() || this->IsStorageFixedSize64Bit())
+  if (this->IsStorageFixedSize32Bit() || this->IsStorageFixedSize64Bit() ||
+    this->StorageType == StorageTypes::FixedSizeViewInt32 ||
+    this->StorageType == StorageTypes::FixedSizeViewInt64)
   {
     return this->GetNumberOfCells() == 0 ? 0 : this->GetCellSize(0);
   }
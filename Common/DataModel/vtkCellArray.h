@@ -85,6 +85,7 @@
  * - `bool IsStorageFixedSize32Bit()`
  * - `bool IsStorageFixedSize() // Either 32- or 64-bit fixed size`
  * - `bool IsStorageGeneric()`
+ * - `bool IsStorageView() // Read-only view on external buffers`
  * - `bool IsStorageShareable() // Can pointers to internal storage be shared`
  * - `void Use64BitStorage()`
  * - `void Use32BitStorage()`
@@ -115,6 +116,17 @@
  * storage when any overload of vtkCellArray::SetData is invoked with array types that
  * are NOT in vtkArrayDispatch::ConnectivityArrays.
  *
+ * Finally, the view storage modes (ViewInt64, ViewInt32, FixedSizeViewInt64 and
+ * FixedSizeViewInt32) reference the connectivity of an external code without copying it,
+ * see SetDataView() and SetFixedSizeDataView(). The buffers are read through
+ * vtkCellArrayViewBackend, which supports strided cell records and 1-based indices.
+ * GetCellAtId(), GetCellSize(), GetCellPointAtId() and vtkCellArrayIterator are
+ * specialized for these arrays, so that traversal does not go through the virtual
+ * vtkDataArray API, while Dispatch() hands them to functors as vtkDataArray. Views are
+ * read-only: the methods modifying the cells, e.g. InsertNextCell() or
+ * ReplaceCellAtId(), first replace the view by a copy in the matching Int64, Int32,
+ * FixedSizeInt64 or FixedSizeInt32 storage.
+ *
  * @sa vtkAbstractCellArray vtkStructuredCellArray vtkCellTypes vtkCellLinks
  */
 
@@ -128,6 +140,7 @@
 #include "vtkAOSDataArrayTemplate.h" // Needed for inline methods
 #include "vtkAffineArray.h"          // Needed for inline methods
 #include "vtkCell.h"                 // Needed for inline methods
+#include "vtkCellArrayViewBackend.h" // Needed for inline methods
 #include "vtkDataArrayAccessor.h"    // Needed for inline methods
 #include "vtkDataArrayRange.h"       // Needed for inline methods
 #include "vtkDeprecation.h"          // For VTK_DEPRECATED_IN_9_6_0
@@ -177,6 +190,8 @@ public:
   using AOSArray64 = vtkAOSDataArrayTemplate<vtkTypeInt64>;
   using AffineArray32 = vtkAffineArray<vtkTypeInt32>;
   using AffineArray64 = vtkAffineArray<vtkTypeInt64>;
+  using ViewArray32 = vtkImplicitArray<vtkCellArrayViewBackend<vtkTypeInt32>>;
+  using ViewArray64 = vtkImplicitArray<vtkCellArrayViewBackend<vtkTypeInt64>>;
 
   ///@{
   /**
@@ -372,6 +387,55 @@ public:
   void SetData(AffineArray64*, AOSArray64* connectivity);
   ///@}
 
+#ifndef __VTK_WRAP__
+  ///@{
+  /**
+   * Set the internal data arrays to views on external buffers, see
+   * vtkCellArrayViewBackend. The storage type will be one of ViewInt64, ViewInt32,
+   * FixedSizeViewInt64 or FixedSizeViewInt32.
+   *
+   * If the arrays are nullptr, or they don't have 1 component, an error is logged.
+   */
+  void SetData(ViewArray32*, ViewArray32* connectivity);
+  void SetData(ViewArray64*, ViewArray64* connectivity);
+  void SetData(AffineArray32*, ViewArray32* connectivity);
+  void SetData(AffineArray64*, ViewArray64* connectivity);
+  ///@}
+
+  ///@{
+  /**
+   * Use the given external buffers as offsets (numberOfCells + 1 values) and
+   * connectivity, without copying them. base is subtracted from all the values, e.g. 1
+   * for the buffers of a Fortran code.
+   *
+   * The buffers are not owned by the cell array: they must stay valid as long as the
+   * cell array, or its shallow copies, use them. The storage is read-only: a
+   * modification of the cells first copies them.
+   */
+  void SetDataView(vtkIdType numberOfCells, const vtkTypeInt32* offsets,
+    const vtkTypeInt32* connectivity, vtkTypeInt32 base = 0);
+  void SetDataView(vtkIdType numberOfCells, const vtkTypeInt64* offsets,
+    const vtkTypeInt64* connectivity, vtkTypeInt64 base = 0);
+  ///@}
+
+  ///@{
+  /**
+   * Use the given external buffer as the connectivity of numberOfCells cells of
+   * cellSize points, without copying it. The point ids of the cells are stored
+   * cellStride values apart, so that the cells may be records holding other values
+   * after their point ids. base is subtracted from all the point ids.
+   *
+   * The buffer is not owned by the cell array: it must stay valid as long as the
+   * cell array, or its shallow copies, use it. The storage is read-only: a
+   * modification of the cells first copies them.
+   */
+  void SetFixedSizeDataView(vtkIdType numberOfCells, vtkIdType cellSize,
+    const vtkTypeInt32* connectivity, vtkIdType cellStride, vtkTypeInt32 base = 0);
+  void SetFixedSizeDataView(vtkIdType numberOfCells, vtkIdType cellSize,
+    const vtkTypeInt64* connectivity, vtkIdType cellStride, vtkTypeInt64 base = 0);
+  ///@}
+#endif // __VTK_WRAP__
+
   /**
    * Set the internal data arrays to the supplied offsets and connectivity
    * arrays.
@@ -414,6 +478,10 @@ public:
     FixedSizeInt64,
     FixedSizeInt32,
     Generic,
+    ViewInt64,
+    ViewInt32,
+    FixedSizeViewInt64,
+    FixedSizeViewInt32,
   };
 
   /**
@@ -454,6 +522,23 @@ public:
    */
   bool IsStorageGeneric() const { return this->StorageType == StorageTypes::Generic; }
 
+  /**
+   * @return True if the internal storage is a read-only view on external buffers.
+   */
+  bool IsStorageView() const
+  {
+    switch (this->StorageType)
+    {
+      case StorageTypes::ViewInt64:
+      case StorageTypes::ViewInt32:
+      case StorageTypes::FixedSizeViewInt64:
+      case StorageTypes::FixedSizeViewInt32:
+        return true;
+      default:
+        return false;
+    }
+  }
+
   /**
    * @return True if the internal storage can be shared as a
    * pointer to vtkIdType, i.e., the type and organization of internal
@@ -518,6 +603,12 @@ public:
         return this->CanConvertToFixedSize32BitStorage();
       case StorageTypes::FixedSizeInt64:
         return this->CanConvertToFixedSize64BitStorage();
+      case StorageTypes::ViewInt64:
+      case StorageTypes::ViewInt32:
+      case StorageTypes::FixedSizeViewInt64:
+      case StorageTypes::FixedSizeViewInt32:
+        // Views can only be set from external buffers.
+        return this->StorageType == type;
       case StorageTypes::Generic:
       default:
         return true;
@@ -560,6 +651,12 @@ public:
         return this->ConvertToFixedSize32BitStorage();
       case StorageTypes::FixedSizeInt64:
         return this->ConvertToFixedSize64BitStorage();
+      case StorageTypes::ViewInt64:
+      case StorageTypes::ViewInt32:
+      case StorageTypes::FixedSizeViewInt64:
+      case StorageTypes::FixedSizeViewInt32:
+        // Views can only be set from external buffers.
+        return this->StorageType == type;
       case StorageTypes::Generic:
       default:
         return true;
@@ -1541,6 +1638,43 @@ protected:
 private:
   vtkCellArray(const vtkCellArray&) = delete;
   void operator=(const vtkCellArray&) = delete;
+
+  void SetViewData(vtkDataArray* offsets, vtkDataArray* connectivity, StorageTypes storageType);
+
+  // Replace the view storages by storages owning a copy of the cells, before
+  // a modification. If copyCells is false, the new storages are left for the
+  // caller to reset.
+  void DetachView(bool copyCells = true);
+
+  // Dispatch() hands the view storages to functors as vtkDataArray, so that
+  // they do not add instantiations of every functor of VTK. The read accessors
+  // use this variant instead, which specializes them for the views.
+  template <typename Functor, typename... Args>
+  void DispatchRead(Functor&& functor, Args&&... args) const
+  {
+    switch (this->StorageType)
+    {
+      case StorageTypes::ViewInt32:
+        functor(static_cast<ViewArray32*>(this->Offsets.Get()),
+          static_cast<ViewArray32*>(this->Connectivity.Get()), std::forward<Args>(args)...);
+        break;
+      case StorageTypes::ViewInt64:
+        functor(static_cast<ViewArray64*>(this->Offsets.Get()),
+          static_cast<ViewArray64*>(this->Connectivity.Get()), std::forward<Args>(args)...);
+        break;
+      case StorageTypes::FixedSizeViewInt32:
+        functor(static_cast<AffineArray32*>(this->Offsets.Get()),
+          static_cast<ViewArray32*>(this->Connectivity.Get()), std::forward<Args>(args)...);
+        break;
+      case StorageTypes::FixedSizeViewInt64:
+        functor(static_cast<AffineArray64*>(this->Offsets.Get()),
+          static_cast<ViewArray64*>(this->Connectivity.Get()), std::forward<Args>(args)...);
+        break;
+      default:
+        this->Dispatch(std::forward<Functor>(functor), std::forward<Args>(args)...);
+        break;
+    }
+  }
 };
 
 template <typename ArrayT>
@@ -1801,7 +1935,7 @@ inline int vtkCellArray::GetNextCell(vtkIdList* pts)
 inline vtkIdType vtkCellArray::GetCellSize(const vtkIdType cellId) const
 {
   vtkIdType cellSize;
-  this->Dispatch(vtkCellArray_detail::GetCellSizeImpl{}, cellId, cellSize);
+  this->DispatchRead(vtkCellArray_detail::GetCellSizeImpl{}, cellId, cellSize);
   return cellSize;
 }
 
@@ -1809,32 +1943,36 @@ inline vtkIdType vtkCellArray::GetCellSize(const vtkIdType cellId) const
 void vtkCellArray::GetCellAtId(vtkIdType cellId, vtkIdType& cellSize, vtkIdType const*& cellPoints,
   vtkIdList* ptIds) VTK_SIZEHINT(cellPoints, cellSize)
 {
-  this->Dispatch(vtkCellArray_detail::GetCellAtIdImpl{}, cellId, cellSize, cellPoints, ptIds);
+  this->DispatchRead(vtkCellArray_detail::GetCellAtIdImpl{}, cellId, cellSize, cellPoints, ptIds);
 }
 
 //----------------------------------------------------------------------------
 void vtkCellArray::GetCellAtId(vtkIdType cellId, vtkIdList* pts)
 {
-  this->Dispatch(vtkCellArray_detail::GetCellAtIdImpl{}, cellId, pts);
+  this->DispatchRead(vtkCellArray_detail::GetCellAtIdImpl{}, cellId, pts);
 }
 
 //----------------------------------------------------------------------------
 void vtkCellArray::GetCellAtId(vtkIdType cellId, vtkIdType& cellSize, vtkIdType* cellPoints)
 {
-  this->Dispatch(vtkCellArray_detail::GetCellAtIdImpl{}, cellId, cellSize, cellPoints);
+  this->DispatchRead(vtkCellArray_detail::GetCellAtIdImpl{}, cellId, cellSize, cellPoints);
 }
 
 //----------------------------------------------------------------------------
 inline vtkIdType vtkCellArray::GetCellPointAtId(vtkIdType cellId, vtkIdType cellPointIndex) const
 {
   vtkIdType pointId;
-  this->Dispatch(vtkCellArray_detail::CellPointAtIdImpl{}, cellId, cellPointIndex, pointId);
+  this->DispatchRead(vtkCellArray_detail::CellPointAtIdImpl{}, cellId, cellPointIndex, pointId);
   return pointId;
 }
 
 //----------------------------------------------------------------------------
 vtkIdType vtkCellArray::InsertNextCell(vtkIdType npts, const vtkIdType* pts) VTK_SIZEHINT(pts, npts)
 {
+  if (this->IsStorageView())
+  {
+    this->DetachView();
+  }
   vtkIdType cellId;
   this->Dispatch(vtkCellArray_detail::InsertNextCellImpl{}, npts, pts, cellId);
   return cellId;
@@ -1843,6 +1981,10 @@ vtkIdType vtkCellArray::InsertNextCell(vtkIdType npts, const vtkIdType* pts) VTK
 //----------------------------------------------------------------------------
 vtkIdType vtkCellArray::InsertNextCell(int npts)
 {
+  if (this->IsStorageView())
+  {
+    this->DetachView();
+  }
   vtkIdType cellId;
   this->Dispatch(vtkCellArray_detail::InsertNextCellImpl{}, npts, cellId);
   return cellId;
@@ -1851,18 +1993,30 @@ vtkIdType vtkCellArray::InsertNextCell(int npts)
 //----------------------------------------------------------------------------
 inline void vtkCellArray::InsertCellPoint(vtkIdType id)
 {
+  if (this->IsStorageView())
+  {
+    this->DetachView();
+  }
   this->Dispatch(vtkCellArray_detail::InsertCellPointImpl{}, id);
 }
 
 //----------------------------------------------------------------------------
 inline void vtkCellArray::UpdateCellCount(int npts)
 {
+  if (this->IsStorageView())
+  {
+    this->DetachView();
+  }
   this->Dispatch(vtkCellArray_detail::UpdateCellCountImpl{}, npts);
 }
 
 //----------------------------------------------------------------------------
 vtkIdType vtkCellArray::InsertNextCell(vtkIdList* pts)
 {
+  if (this->IsStorageView())
+  {
+    this->DetachView();
+  }
   vtkIdType cellId;
   this->Dispatch(
     vtkCellArray_detail::InsertNextCellImpl{}, pts->GetNumberOfIds(), pts->GetPointer(0), cellId);
@@ -1873,6 +2027,10 @@ vtkIdType vtkCellArray::InsertNextCell(vtkIdList* pts)
 vtkIdType vtkCellArray::InsertNextCell(vtkCell* cell)
 {
   vtkIdList* pts = cell->GetPointIds();
+  if (this->IsStorageView())
+  {
+    this->DetachView();
+  }
   vtkIdType cellId;
   this->Dispatch(
     vtkCellArray_detail::InsertNextCellImpl{}, pts->GetNumberOfIds(), pts->GetPointer(0), cellId);
@@ -1882,6 +2040,10 @@ vtkIdType vtkCellArray::InsertNextCell(vtkCell* cell)
 //----------------------------------------------------------------------------
 inline void vtkCellArray::Reset()
 {
+  if (this->IsStorageView())
+  {
+    this->DetachView(false);
+  }
   this->Dispatch(vtkCellArray_detail::ResetImpl{});
 }
 
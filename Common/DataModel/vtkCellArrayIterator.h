@@ -40,11 +40,13 @@
  * 3-4x reduction in traversal performance. On the other hand, the
  * vtkCellArray can use the appropriate storage to save memory, perform
  * zero-copy, and/or efficiently represent the cell connectivity
- * information.) Note that referencing internal vtkCellArray storage has
- * implications on the validity of the iterator. If the underlying
- * vtkCellArray storage changes while iterating, and the iterator is
- * referencing this storage, unpredictable and catastrophic results are
- * likely - hence do not modify the vtkCellArray while iterating.
+ * information.) The copy goes through vtkCellArray::GetCellAtId(), so it is
+ * specialized for each storage type, including the views on external
+ * buffers (see vtkCellArray::SetDataView()). Note that referencing internal
+ * vtkCellArray storage has implications on the validity of the iterator.
+ * If the underlying vtkCellArray storage changes while iterating, and the
+ * iterator is referencing this storage, unpredictable and catastrophic
+ * results are likely - hence do not modify the vtkCellArray while iterating.
  *
  * @sa
  * vtkCellArray
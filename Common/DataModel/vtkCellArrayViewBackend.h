@@ -0,0 +1,84 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+#ifndef vtkCellArrayViewBackend_h
+#define vtkCellArrayViewBackend_h
+
+/**
+ * \class vtkCellArrayViewBackend
+ *
+ * A backend for the `vtkImplicitArray` framework giving a read-only view on
+ * an external buffer of offsets or point ids, used by vtkCellArray to share
+ * the connectivity of simulation codes without copying it.
+ *
+ * The buffer is read by blocks of BlockSize values, consecutive blocks being
+ * BlockStride values apart, and Base is subtracted from every value:
+ * \code
+ * value(idx) = buffer[(idx / BlockSize) * BlockStride + idx % BlockSize] - Base
+ * \endcode
+ * For example:
+ * - a contiguous buffer uses BlockSize == BlockStride,
+ * - a buffer of records of 5 values, the 4 first ones being the point ids
+ *   of a tetrahedron, uses BlockSize = 4 and BlockStride = 5,
+ * - a 1-based Fortran buffer uses Base = 1.
+ *
+ * The value is computed inline, so that the vtkCellArray::Dispatch functors
+ * are specialized for this backend.
+ *
+ * @warning The buffer is not owned by the backend: do not use the array
+ * after the buffer memory is released.
+ *
+ * @sa
+ * vtkCellArray vtkImplicitArray vtkStridedImplicitBackend
+ */
+
+#include "vtkType.h"
+
+VTK_ABI_NAMESPACE_BEGIN
+template <typename ValueType>
+class vtkCellArrayViewBackend final
+{
+public:
+  vtkCellArrayViewBackend(
+    const ValueType* buffer, vtkIdType blockSize, vtkIdType blockStride, ValueType base = 0)
+    : Buffer(buffer)
+    , BlockSize(blockSize > 0 ? blockSize : 1)
+    , BlockStride(blockStride > this->BlockSize ? blockStride : this->BlockSize)
+    , Base(base)
+  {
+  }
+  vtkCellArrayViewBackend(const ValueType* buffer, ValueType base = 0)
+    : vtkCellArrayViewBackend(buffer, 1, 1, base)
+  {
+  }
+
+  /**
+   * Return the value at the given index.
+   */
+  ValueType operator()(vtkIdType idx) const
+  {
+    if (this->BlockSize == this->BlockStride)
+    {
+      return this->Buffer[idx] - this->Base;
+    }
+    if (this->BlockSize == 1)
+    {
+      return this->Buffer[idx * this->BlockStride] - this->Base;
+    }
+    return this->Buffer[(idx / this->BlockSize) * this->BlockStride + idx % this->BlockSize] -
+      this->Base;
+  }
+
+  const ValueType* GetBuffer() const { return this->Buffer; }
+  vtkIdType GetBlockSize() const { return this->BlockSize; }
+  vtkIdType GetBlockStride() const { return this->BlockStride; }
+  ValueType GetBase() const { return this->Base; }
+
+private:
+  const ValueType* Buffer;
+  vtkIdType BlockSize;
+  vtkIdType BlockStride;
+  ValueType Base;
+};
+VTK_ABI_NAMESPACE_END
+
+#endif // vtkCellArrayViewBackend_h
@@ -130,6 +130,15 @@ public:
   vtkIdType FindCell(double x[3], double vtkNotUsed(tol2), vtkGenericCell* GenCell, int& subId,
     double pcoords[3], double* weights) override;
 
+  /**
+   * FindCell, FindClosestPointWithinRadius and IntersectWithLine are thread
+   * safe, the batched queries run in parallel.
+   */
+  int GetThreadSafeQueries() override
+  {
+    return FIND_CELL | FIND_CLOSEST_POINT | INTERSECT_WITH_LINE;
+  }
+
   /**
    * Return a list of unique cell ids inside of a given bounding box. The
    * user must provide the vtkIdList to populate.
@@ -0,0 +1,334 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class   vtkCellLocatorBatch
+ * @brief   Private machinery of the batched cell locator queries
+ *
+ * vtkCellLocatorBatch runs the batched queries of vtkAbstractCellLocator
+ * (FindCells, FindClosestPoints and IntersectWithLines) with vtkSMPTools. The
+ * queries are optionally processed in a spatially coherent order, and each
+ * thread reuses its own vtkGenericCell and weights, so a query only costs the
+ * search itself. The search is given as a functor, which lets each locator
+ * call its own search structure directly. Searches which are not thread safe
+ * run serially.
+ *
+ * This header is private to the locators of VTK::CommonDataModel.
+ */
+
+#ifndef vtkCellLocatorBatchPrivate_h
+#define vtkCellLocatorBatchPrivate_h
+
+#include "vtkDataSet.h"
+#include "vtkDoubleArray.h"
+#include "vtkGenericCell.h"
+#include "vtkIdList.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+VTK_ABI_NAMESPACE_BEGIN
+struct vtkCellLocatorBatch
+{
+  // Per thread scratch space reused by all the queries of a thread.
+  struct LocalData
+  {
+    vtkSmartPointer<vtkGenericCell> Cell;
+    std::vector<double> Weights;
+  };
+
+  //----------------------------------------------------------------------------
+  // Sort the query ids by the key given for each query. The key is computed
+  // in parallel; ties keep the original order so the result is deterministic.
+  template <typename TKeyFunctor>
+  static void SortQueries(vtkIdType numQueries, TKeyFunctor key, std::vector<vtkIdType>& order)
+  {
+    std::vector<std::pair<uint64_t, vtkIdType>> keys(static_cast<size_t>(numQueries));
+    vtkSMPTools::For(0, numQueries,
+      [&](vtkIdType begin, vtkIdType end)
+      {
+        for (vtkIdType queryId = begin; queryId < end; ++queryId)
+        {
+          keys[queryId] = std::make_pair(static_cast<uint64_t>(key(queryId)), queryId);
+        }
+      });
+    vtkSMPTools::Sort(keys.begin(), keys.end());
+    order.resize(keys.size());
+    vtkSMPTools::For(0, numQueries,
+      [&](vtkIdType begin, vtkIdType end)
+      {
+        for (vtkIdType i = begin; i < end; ++i)
+        {
+          order[i] = keys[i].second;
+        }
+      });
+  }
+
+  //----------------------------------------------------------------------------
+  // Order the points along a Morton (Z-order) curve spanning their bounds.
+  static void ComputeMortonOrder(vtkPoints* points, std::vector<vtkIdType>& order)
+  {
+    constexpr double resolution = (1 << 21) - 1;
+    double bounds[6];
+    points->GetBounds(bounds);
+    double scale[3];
+    for (int i = 0; i < 3; ++i)
+    {
+      const double length = bounds[2 * i + 1] - bounds[2 * i];
+      scale[i] = length > 0.0 ? resolution / length : 0.0;
+    }
+    vtkCellLocatorBatch::SortQueries(
+      points->GetNumberOfPoints(),
+      [&](vtkIdType pointId)
+      {
+        double x[3];
+        points->GetPoint(pointId, x);
+        uint64_t code = 0;
+        for (int i = 0; i < 3; ++i)
+        {
+          const uint64_t coordinate = static_cast<uint64_t>(
+            vtkMath::ClampValue((x[i] - bounds[2 * i]) * scale[i], 0.0, resolution));
+          code |= vtkCellLocatorBatch::SpreadBits(coordinate) << i;
+        }
+        return code;
+      },
+      order);
+  }
+
+  //----------------------------------------------------------------------------
+  // Insert two zero bits between each of the 21 low bits of the value.
+  static uint64_t SpreadBits(uint64_t value)
+  {
+    value &= 0x1fffff;
+    value = (value | value << 32) & 0x1f00000000ffffULL;
+    value = (value | value << 16) & 0x1f0000ff0000ffULL;
+    value = (value | value << 8) & 0x100f00f00f00f00fULL;
+    value = (value | value << 4) & 0x10c30c30c30c30c3ULL;
+    value = (value | value << 2) & 0x1249249249249249ULL;
+    return value;
+  }
+
+  //----------------------------------------------------------------------------
+  // Call query(queryId, cell, weights) for each query, following the order
+  // if it is not empty, in parallel unless told otherwise.
+  template <typename TQueryFunctor>
+  static void Run(vtkDataSet* dataSet, vtkIdType numQueries, const std::vector<vtkIdType>& order,
+    TQueryFunctor query, bool parallel = true)
+  {
+    if (numQueries < 1 || !dataSet || dataSet->GetNumberOfCells() < 1)
+    {
+      return;
+    }
+    // Cause the non thread safe initialization of the cells to happen now.
+    {
+      vtkNew<vtkGenericCell> cell;
+      dataSet->GetCell(0, cell);
+    }
+    const size_t maxCellSize = static_cast<size_t>(dataSet->GetMaxCellSize());
+    const vtkIdType* queryIds = order.empty() ? nullptr : order.data();
+
+    vtkSMPThreadLocal<LocalData> localData;
+    auto runQueries = [&](vtkIdType begin, vtkIdType end)
+    {
+      LocalData& local = localData.Local();
+      if (!local.Cell)
+      {
+        local.Cell = vtkSmartPointer<vtkGenericCell>::New();
+        local.Weights.resize(maxCellSize);
+      }
+      for (vtkIdType i = begin; i < end; ++i)
+      {
+        query(queryIds ? queryIds[i] : i, local.Cell.Get(), local.Weights.data());
+      }
+    };
+    if (parallel)
+    {
+      vtkSMPTools::For(0, numQueries, runQueries);
+    }
+    else
+    {
+      runQueries(0, numQueries);
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  // Allocate the optional output arrays of a batch.
+  static double* AllocateTuples(vtkDoubleArray* array, int numComponents, vtkIdType numQueries)
+  {
+    if (!array)
+    {
+      return nullptr;
+    }
+    array->SetNumberOfComponents(numComponents);
+    array->SetNumberOfTuples(numQueries);
+    return array->GetPointer(0);
+  }
+
+  static void AllocatePoints(vtkPoints* points, vtkIdType numQueries)
+  {
+    if (points)
+    {
+      points->SetNumberOfPoints(numQueries);
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  // findCell(x, cell, subId, pcoords, weights) returns the id of the cell
+  // containing x, or -1.
+  template <typename TFindCellFunctor>
+  static void FindCells(vtkDataSet* dataSet, vtkPoints* points,
+    const std::vector<vtkIdType>& order, vtkIdList* cellIds, vtkDoubleArray* pcoords,
+    TFindCellFunctor findCell, bool parallel = true)
+  {
+    const vtkIdType numQueries = points->GetNumberOfPoints();
+    cellIds->SetNumberOfIds(numQueries);
+    std::fill_n(cellIds->GetPointer(0), numQueries, -1);
+    vtkIdType* ids = cellIds->GetPointer(0);
+    double* pcoordsOut = vtkCellLocatorBatch::AllocateTuples(pcoords, 3, numQueries);
+
+    vtkCellLocatorBatch::Run(dataSet, numQueries, order,
+      [&](vtkIdType queryId, vtkGenericCell* cell, double* weights)
+      {
+        double x[3], pc[3] = { 0.0, 0.0, 0.0 };
+        int subId = 0;
+        points->GetPoint(queryId, x);
+        ids[queryId] = findCell(x, cell, subId, pc, weights);
+        if (pcoordsOut)
+        {
+          std::copy_n(pc, 3, pcoordsOut + 3 * queryId);
+        }
+      },
+      parallel);
+    if (pcoords)
+    {
+      pcoords->Modified();
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  // findClosestPoint(x, closestPoint, cell, cellId, subId, dist2) returns
+  // whether a closest point was found.
+  template <typename TFindClosestPointFunctor>
+  static void FindClosestPoints(vtkDataSet* dataSet, vtkPoints* points,
+    const std::vector<vtkIdType>& order, vtkIdList* cellIds, vtkPoints* closestPoints,
+    vtkDoubleArray* dist2, TFindClosestPointFunctor findClosestPoint)
+  {
+    const vtkIdType numQueries = points->GetNumberOfPoints();
+    cellIds->SetNumberOfIds(numQueries);
+    std::fill_n(cellIds->GetPointer(0), numQueries, -1);
+    vtkIdType* ids = cellIds->GetPointer(0);
+    vtkCellLocatorBatch::AllocatePoints(closestPoints, numQueries);
+    double* dist2Out = vtkCellLocatorBatch::AllocateTuples(dist2, 1, numQueries);
+
+    vtkCellLocatorBatch::Run(dataSet, numQueries, order,
+      [&](vtkIdType queryId, vtkGenericCell* cell, double*)
+      {
+        double x[3], closestPoint[3] = { 0.0, 0.0, 0.0 }, d2 = VTK_DOUBLE_MAX;
+        vtkIdType cellId = -1;
+        int subId = 0;
+        points->GetPoint(queryId, x);
+        if (!findClosestPoint(x, closestPoint, cell, cellId, subId, d2))
+        {
+          cellId = -1;
+          d2 = VTK_DOUBLE_MAX;
+        }
+        ids[queryId] = cellId;
+        if (closestPoints)
+        {
+          closestPoints->SetPoint(queryId, closestPoint);
+        }
+        if (dist2Out)
+        {
+          dist2Out[queryId] = d2;
+        }
+      });
+    if (closestPoints)
+    {
+      closestPoints->Modified();
+    }
+    if (dist2)
+    {
+      dist2->Modified();
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  // intersect(p1, p2, t, x, pcoords, subId, cellId, cell) returns non zero
+  // when the segment hits a cell.
+  template <typename TIntersectFunctor>
+  static void IntersectWithLines(vtkDataSet* dataSet, vtkPoints* p1, vtkPoints* p2,
+    const std::vector<vtkIdType>& order, vtkIdList* cellIds, vtkDoubleArray* t,
+    vtkPoints* intersections, TIntersectFunctor intersect)
+  {
+    const vtkIdType numQueries = p1->GetNumberOfPoints();
+    cellIds->SetNumberOfIds(numQueries);
+    std::fill_n(cellIds->GetPointer(0), numQueries, -1);
+    vtkIdType* ids = cellIds->GetPointer(0);
+    double* tOut = vtkCellLocatorBatch::AllocateTuples(t, 1, numQueries);
+    vtkCellLocatorBatch::AllocatePoints(intersections, numQueries);
+
+    vtkCellLocatorBatch::Run(dataSet, numQueries, order,
+      [&](vtkIdType queryId, vtkGenericCell* cell, double*)
+      {
+        double a0[3], a1[3], x[3] = { 0.0, 0.0, 0.0 }, pcoords[3], tHit = VTK_DOUBLE_MAX;
+        vtkIdType cellId = -1;
+        int subId = 0;
+        p1->GetPoint(queryId, a0);
+        p2->GetPoint(queryId, a1);
+        if (!intersect(a0, a1, tHit, x, pcoords, subId, cellId, cell))
+        {
+          cellId = -1;
+          tHit = VTK_DOUBLE_MAX;
+        }
+        ids[queryId] = cellId;
+        if (tOut)
+        {
+          tOut[queryId] = tHit;
+        }
+        if (intersections)
+        {
+          intersections->SetPoint(queryId, x);
+        }
+      });
+    if (t)
+    {
+      t->Modified();
+    }
+    if (intersections)
+    {
+      intersections->Modified();
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  // The midpoints of the segments, used to order the ray queries.
+  static void ComputeMidpoints(vtkPoints* p1, vtkPoints* p2, vtkPoints* midpoints)
+  {
+    const vtkIdType numQueries = p1->GetNumberOfPoints();
+    midpoints->SetDataTypeToDouble();
+    midpoints->SetNumberOfPoints(numQueries);
+    vtkSMPTools::For(0, numQueries,
+      [&](vtkIdType begin, vtkIdType end)
+      {
+        double a0[3], a1[3];
+        for (vtkIdType queryId = begin; queryId < end; ++queryId)
+        {
+          p1->GetPoint(queryId, a0);
+          p2->GetPoint(queryId, a1);
+          midpoints->SetPoint(queryId, 0.5 * (a0[0] + a1[0]), 0.5 * (a0[1] + a1[1]),
+            0.5 * (a0[2] + a1[2]));
+        }
+      });
+    midpoints->Modified();
+  }
+};
+VTK_ABI_NAMESPACE_END
+#endif // vtkCellLocatorBatchPrivate_h
+// VTK-HeaderTest-Exclude: vtkCellLocatorBatchPrivate.h
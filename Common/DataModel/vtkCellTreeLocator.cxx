@@ -6,6 +6,7 @@
 #include "vtkBoundingBox.h"
 #include "vtkBox.h"
 #include "vtkCellArray.h"
+#include "vtkCellLocatorBatchPrivate.h"
 #include "vtkGenericCell.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
@@ -1389,6 +1390,55 @@ int vtkCellTreeLocator::IntersectWithLine(const double p1[3], const double p2[3]
   return this->Tree->IntersectWithLine(p1, p2, tol, points, cellIds, cell);
 }
 
+//------------------------------------------------------------------------------
+void vtkCellTreeLocator::FindCells(
+  vtkPoints* points, vtkIdList* cellIds, double vtkNotUsed(tol2), vtkDoubleArray* pcoords)
+{
+  if (!points || !cellIds)
+  {
+    return;
+  }
+  this->BuildLocator();
+  if (!this->Tree)
+  {
+    cellIds->SetNumberOfIds(points->GetNumberOfPoints());
+    std::fill_n(cellIds->GetPointer(0), points->GetNumberOfPoints(), -1);
+    return;
+  }
+  std::vector<vtkIdType> order;
+  this->GetQueryOrder(points, nullptr, order);
+  detail::vtkCellTree* tree = this->Tree;
+  vtkCellLocatorBatch::FindCells(this->DataSet, points, order, cellIds, pcoords,
+    [tree](double x[3], vtkGenericCell* cell, int& subId, double pc[3], double* weights)
+    { return tree->FindCell(x, cell, subId, pc, weights); });
+}
+
+//------------------------------------------------------------------------------
+void vtkCellTreeLocator::IntersectWithLines(vtkPoints* p1, vtkPoints* p2, double tol,
+  vtkIdList* cellIds, vtkDoubleArray* t, vtkPoints* intersections)
+{
+  if (!p1 || !p2 || !cellIds || p1->GetNumberOfPoints() != p2->GetNumberOfPoints())
+  {
+    vtkErrorMacro(<< "IntersectWithLines needs as many start points as end points");
+    return;
+  }
+  this->BuildLocator();
+  if (!this->Tree)
+  {
+    cellIds->SetNumberOfIds(p1->GetNumberOfPoints());
+    std::fill_n(cellIds->GetPointer(0), p1->GetNumberOfPoints(), -1);
+    return;
+  }
+  std::vector<vtkIdType> order;
+  this->GetQueryOrder(p1, p2, order);
+  detail::vtkCellTree* tree = this->Tree;
+  vtkCellLocatorBatch::IntersectWithLines(this->DataSet, p1, p2, order, cellIds, t,
+    intersections,
+    [tree, tol](const double a0[3], const double a1[3], double& tHit, double x[3],
+      double pcoords[3], int& subId, vtkIdType& cellId, vtkGenericCell* cell)
+    { return tree->IntersectWithLine(a0, a1, tol, tHit, x, pcoords, subId, cellId, cell); });
+}
+
 //------------------------------------------------------------------------------
 void vtkCellTreeLocator::GenerateRepresentation(int level, vtkPolyData* pd)
 {
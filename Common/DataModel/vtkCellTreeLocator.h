@@ -147,6 +147,23 @@ public:
   vtkIdType FindCell(double pos[3], double vtkNotUsed(tol2), vtkGenericCell* cell, int& subId,
     double pcoords[3], double* weights) override;
 
+  /**
+   * FindCell and IntersectWithLine are thread safe, the batched queries
+   * using them run in parallel.
+   */
+  int GetThreadSafeQueries() override { return FIND_CELL | INTERSECT_WITH_LINE; }
+
+  ///@{
+  /**
+   * Batched queries, see vtkAbstractCellLocator. They traverse the cell tree
+   * directly.
+   */
+  void FindCells(vtkPoints* points, vtkIdList* cellIds, double tol2 = 0.0,
+    vtkDoubleArray* pcoords = nullptr) override;
+  void IntersectWithLines(vtkPoints* p1, vtkPoints* p2, double tol, vtkIdList* cellIds,
+    vtkDoubleArray* t = nullptr, vtkPoints* intersections = nullptr) override;
+  ///@}
+
   ///@{
   /**
    * Satisfy vtkLocator abstract interface.
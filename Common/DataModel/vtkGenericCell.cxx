@@ -46,6 +46,7 @@
 #include "vtkQuadraticTetra.h"
 #include "vtkQuadraticTriangle.h"
 #include "vtkQuadraticWedge.h"
+#include "vtkScratchArena.h"
 #include "vtkTetra.h"
 #include "vtkTriQuadraticHexahedron.h"
 #include "vtkTriQuadraticPyramid.h"
@@ -74,6 +75,7 @@ vtkGenericCell::vtkGenericCell()
   this->PointIds->Delete();
   this->PointIds = this->Cell->PointIds;
   this->PointIds->Register(this);
+  vtkScratchArena::CountHeapAllocation(sizeof(vtkGenericCell));
 }
 
 //------------------------------------------------------------------------------
@@ -453,6 +455,7 @@ void vtkGenericCell::SetCellType(int cellType)
     else if (this->CellStore[cellType] == nullptr)
     {
       this->CellStore[cellType] = vtkGenericCell::InstantiateCell(cellType);
+      vtkScratchArena::CountHeapAllocation();
       this->Cell = this->CellStore[cellType];
     }
     else
@@ -10,6 +10,7 @@
 #include "vtkCellArray.h"
 #include "vtkDataSet.h"
 #include "vtkDataSetCollection.h"
+#include "vtkDoubleArray.h"
 #include "vtkFloatArray.h"
 #include "vtkGarbageCollector.h"
 #include "vtkIdList.h"
@@ -23,15 +24,20 @@
 #include "vtkPoints.h"
 #include "vtkPolyData.h"
 #include "vtkRectilinearGrid.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 #include "vtkTimerLog.h"
 #include "vtkUniformGrid.h"
 #include "vtkUnsignedCharArray.h"
 
 #include <algorithm>
+#include <cstdint>
 #include <list>
 #include <map>
 #include <queue>
 #include <set>
+#include <utility>
+#include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
 namespace
@@ -172,6 +178,30 @@ private:
 };
 }
 
+//------------------------------------------------------------------------------
+// A node of the flat copy of the tree, 32 bytes. The points of a node are
+// contiguous in LocatorPoints, since DivideRegion partitions them in place.
+struct vtkKdTree::FlatNode
+{
+  float Min[3];   // tight bounds of the points of the node
+  float Max[3];   //
+  int32_t Offset; // leaf: first point in LocatorPoints; interior: index of the left child
+  int32_t Count;  // leaf: number of points; interior: -1
+
+  bool IsLeaf() const { return this->Count >= 0; }
+
+  float Distance2(const float x[3]) const
+  {
+    float distance2 = 0.0f;
+    for (int i = 0; i < 3; ++i)
+    {
+      const float delta = std::max({ this->Min[i] - x[i], 0.0f, x[i] - this->Max[i] });
+      distance2 += delta * delta;
+    }
+    return distance2;
+  }
+};
+
 //------------------------------------------------------------------------------
 vtkStandardNewMacro(vtkKdTree);
 
@@ -209,6 +239,7 @@ vtkKdTree::vtkKdTree()
   this->LocatorPoints = nullptr;
   this->LocatorIds = nullptr;
   this->LocatorRegionLocation = nullptr;
+  this->FlatNodes = nullptr;
 
   this->LastDataCacheSize = 0;
   this->LastNumDataSets = 0;
@@ -894,7 +925,7 @@ void vtkKdTree::BuildLocatorInternal()
 
     this->ProgressOffset += this->ProgressScale;
     this->ProgressScale = 0.7;
-    this->DivideRegion(kd, ptarray, nullptr, 0);
+    this->DivideRegionInParallel(kd, ptarray, nullptr);
 
     TIMERDONE("Build tree");
 
@@ -1238,6 +1269,87 @@ int vtkKdTree::DivideTest(int size, int level)
 
 //------------------------------------------------------------------------------
 int vtkKdTree::DivideRegion(vtkKdNode* kd, float* c1, int* ids, int level)
+{
+  if (!this->SplitRegion(kd, c1, ids, level))
+  {
+    return 0;
+  }
+
+  int nleft = kd->GetLeft()->GetNumberOfPoints();
+
+  int* leftIds = ids;
+  int* rightIds = ids ? ids + nleft : nullptr;
+
+  this->DivideRegion(kd->GetLeft(), c1, leftIds, level + 1);
+
+  this->DivideRegion(kd->GetRight(), c1 + nleft * 3, rightIds, level + 1);
+
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+// The regions of a level are independent: they own disjoint ranges of the
+// point array. Divide the first levels one level at a time, dividing the
+// regions of a level in parallel, until there are enough regions to keep the
+// threads busy. Then divide these regions entirely in parallel. The tree is
+// the same as the one built by DivideRegion.
+void vtkKdTree::DivideRegionInParallel(vtkKdNode* kd, float* c1, int* ids)
+{
+  struct Region
+  {
+    vtkKdNode* Node;
+    float* Points;
+    int* Ids;
+    int Level;
+  };
+  const size_t numTasks = 4 * static_cast<size_t>(vtkSMPTools::GetEstimatedNumberOfThreads());
+  std::vector<Region> regions{ { kd, c1, ids, 0 } };
+  std::vector<Region> children;
+  std::vector<unsigned char> divided;
+
+  while (!regions.empty() && regions.size() < numTasks)
+  {
+    divided.assign(regions.size(), 0);
+    vtkSMPTools::For(0, static_cast<vtkIdType>(regions.size()), 1,
+      [&](vtkIdType begin, vtkIdType end)
+      {
+        for (vtkIdType i = begin; i < end; ++i)
+        {
+          const Region& region = regions[i];
+          divided[i] = static_cast<unsigned char>(
+            this->SplitRegion(region.Node, region.Points, region.Ids, region.Level));
+        }
+      });
+
+    children.clear();
+    for (size_t i = 0; i < regions.size(); ++i)
+    {
+      if (!divided[i])
+      {
+        continue; // this region is a leaf
+      }
+      const Region& region = regions[i];
+      const int nleft = region.Node->GetLeft()->GetNumberOfPoints();
+      children.push_back({ region.Node->GetLeft(), region.Points, region.Ids, region.Level + 1 });
+      children.push_back({ region.Node->GetRight(), region.Points + nleft * 3,
+        region.Ids ? region.Ids + nleft : nullptr, region.Level + 1 });
+    }
+    regions.swap(children);
+  }
+
+  vtkSMPTools::For(0, static_cast<vtkIdType>(regions.size()), 1,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType i = begin; i < end; ++i)
+      {
+        const Region& region = regions[i];
+        this->DivideRegion(region.Node, region.Points, region.Ids, region.Level);
+      }
+    });
+}
+
+//------------------------------------------------------------------------------
+int vtkKdTree::SplitRegion(vtkKdNode* kd, float* c1, int* ids, int level)
 {
   int ok = this->DivideTest(kd->GetNumberOfPoints(), level);
 
@@ -1297,16 +1409,7 @@ int vtkKdTree::DivideRegion(vtkKdNode* kd, float* c1, int* ids, int level)
     return 0; // unable to divide region further
   }
 
-  int nleft = kd->GetLeft()->GetNumberOfPoints();
-
-  int* leftIds = ids;
-  int* rightIds = ids ? ids + nleft : nullptr;
-
-  this->DivideRegion(kd->GetLeft(), c1, leftIds, level + 1);
-
-  this->DivideRegion(kd->GetRight(), c1 + nleft * 3, rightIds, level + 1);
-
-  return 0;
+  return 1;
 }
 
 //------------------------------------------------------------------------------
@@ -1837,7 +1940,7 @@ void vtkKdTree::BuildLocatorFromPoints(vtkPoints** ptArrays, int numPtArrays)
 
   TIMER("Build tree");
 
-  this->DivideRegion(kd, points, ptIds, 0);
+  this->DivideRegionInParallel(kd, points, ptIds);
 
   this->SetActualLevel();
   this->BuildRegionList();
@@ -1859,9 +1962,81 @@ void vtkKdTree::BuildLocatorFromPoints(vtkPoints** ptArrays, int numPtArrays)
 
   this->SetCalculator(this->Top);
 
+  this->BuildFlatNodes();
+
   TIMERDONE("Build tree");
 }
 
+//------------------------------------------------------------------------------
+void vtkKdTree::BuildFlatNodes()
+{
+  delete[] this->FlatNodes;
+  const int numNodes = 2 * this->NumberOfRegions - 1;
+  this->FlatNodes = new FlatNode[numNodes];
+
+  // Children are stored after their parent, next to each other.
+  std::vector<std::pair<vtkKdNode*, int>> stack;
+  stack.emplace_back(this->Top, 0);
+  int nextNode = 1;
+  while (!stack.empty())
+  {
+    vtkKdNode* kd = stack.back().first;
+    FlatNode& node = this->FlatNodes[stack.back().second];
+    stack.pop_back();
+    if (kd->GetLeft() == nullptr)
+    {
+      node.Offset = this->LocatorRegionLocation[kd->GetID()];
+      node.Count = kd->GetNumberOfPoints();
+      continue;
+    }
+    node.Offset = nextNode;
+    node.Count = -1;
+    stack.emplace_back(kd->GetRight(), nextNode + 1);
+    stack.emplace_back(kd->GetLeft(), nextNode);
+    nextNode += 2;
+  }
+
+  // Bounds of the leaves, then of their ancestors.
+  vtkSMPTools::For(0, numNodes,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType nodeId = begin; nodeId < end; ++nodeId)
+      {
+        FlatNode& node = this->FlatNodes[nodeId];
+        if (!node.IsLeaf())
+        {
+          continue;
+        }
+        std::fill_n(node.Min, 3, VTK_FLOAT_MAX);
+        std::fill_n(node.Max, 3, -VTK_FLOAT_MAX);
+        const float* pt = this->LocatorPoints + 3 * static_cast<vtkIdType>(node.Offset);
+        for (int i = 0; i < node.Count; ++i, pt += 3)
+        {
+          for (int j = 0; j < 3; ++j)
+          {
+            node.Min[j] = std::min(node.Min[j], pt[j]);
+            node.Max[j] = std::max(node.Max[j], pt[j]);
+          }
+        }
+      }
+    });
+  for (int nodeId = numNodes - 1; nodeId >= 0; --nodeId)
+  {
+    FlatNode& node = this->FlatNodes[nodeId];
+    if (node.IsLeaf())
+    {
+      continue;
+    }
+    const FlatNode& left = this->FlatNodes[node.Offset];
+    const FlatNode& right = this->FlatNodes[node.Offset + 1];
+    for (int j = 0; j < 3; ++j)
+    {
+      node.Min[j] = std::min(left.Min[j], right.Min[j]);
+      node.Max[j] = std::max(left.Max[j], right.Max[j]);
+    }
+  }
+}
+
 //------------------------------------------------------------------------------
 // Query functions subsequent to BuildLocatorFromPoints,
 // relating to duplicate and nearby points
@@ -2674,6 +2849,129 @@ void vtkKdTree::FindClosestNPoints(int N, const double x[3], vtkIdList* result)
   orderedPoints.GetSortedIds(result);
 }
 
+//------------------------------------------------------------------------------
+void vtkKdTree::FindClosestNPointsBatch(
+  int N, vtkPoints* points, vtkIdTypeArray* neighbors, vtkDoubleArray* dist2)
+{
+  if (!points || !neighbors)
+  {
+    return;
+  }
+  const vtkIdType numQueries = points->GetNumberOfPoints();
+  N = std::max(N, 0);
+  neighbors->SetNumberOfComponents(N);
+  neighbors->SetNumberOfTuples(numQueries);
+  if (dist2)
+  {
+    dist2->SetNumberOfComponents(N);
+    dist2->SetNumberOfTuples(numQueries);
+  }
+  if (N == 0 || numQueries == 0)
+  {
+    return;
+  }
+  if (!this->LocatorPoints || !this->FlatNodes)
+  {
+    vtkErrorMacro(<< "vtkKdTree::FindClosestNPointsBatch - must build locator first");
+    neighbors->Fill(-1);
+    return;
+  }
+
+  // The N closest points found so far are kept in a max heap, the traversal
+  // visits the nearest child first and skips the nodes further than the
+  // farthest of them.
+  using Candidate = std::pair<float, int>;
+  struct LocalData
+  {
+    std::vector<Candidate> Heap;
+    std::vector<std::pair<float, int>> Stack;
+  };
+  vtkSMPThreadLocal<LocalData> localData;
+  const FlatNode* nodes = this->FlatNodes;
+  const float* locatorPoints = this->LocatorPoints;
+  const int* locatorIds = this->LocatorIds;
+  vtkIdType* neighborIds = neighbors->GetPointer(0);
+  double* distances = dist2 ? dist2->GetPointer(0) : nullptr;
+
+  vtkSMPTools::For(0, numQueries,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      LocalData& local = localData.Local();
+      std::vector<Candidate>& heap = local.Heap;
+      std::vector<std::pair<float, int>>& stack = local.Stack;
+      const size_t numNeighbors = static_cast<size_t>(N);
+      double x[3];
+      float xfloat[3];
+      for (vtkIdType queryId = begin; queryId < end; ++queryId)
+      {
+        points->GetPoint(queryId, x);
+        xfloat[0] = static_cast<float>(x[0]);
+        xfloat[1] = static_cast<float>(x[1]);
+        xfloat[2] = static_cast<float>(x[2]);
+
+        heap.clear();
+        stack.clear();
+        stack.emplace_back(nodes[0].Distance2(xfloat), 0);
+        while (!stack.empty())
+        {
+          const std::pair<float, int> top = stack.back();
+          stack.pop_back();
+          if (heap.size() == numNeighbors && top.first > heap.front().first)
+          {
+            continue;
+          }
+          const FlatNode& node = nodes[top.second];
+          if (node.IsLeaf())
+          {
+            const float* pt = locatorPoints + 3 * static_cast<vtkIdType>(node.Offset);
+            for (int i = 0; i < node.Count; ++i, pt += 3)
+            {
+              const float d2 = vtkMath::Distance2BetweenPoints(xfloat, pt);
+              if (heap.size() < numNeighbors)
+              {
+                heap.emplace_back(d2, node.Offset + i);
+                std::push_heap(heap.begin(), heap.end());
+              }
+              else if (d2 < heap.front().first)
+              {
+                std::pop_heap(heap.begin(), heap.end());
+                heap.back() = Candidate(d2, node.Offset + i);
+                std::push_heap(heap.begin(), heap.end());
+              }
+            }
+            continue;
+          }
+          // Push the farthest child first so that the nearest is visited first.
+          const float leftDist2 = nodes[node.Offset].Distance2(xfloat);
+          const float rightDist2 = nodes[node.Offset + 1].Distance2(xfloat);
+          if (leftDist2 <= rightDist2)
+          {
+            stack.emplace_back(rightDist2, node.Offset + 1);
+            stack.emplace_back(leftDist2, node.Offset);
+          }
+          else
+          {
+            stack.emplace_back(leftDist2, node.Offset);
+            stack.emplace_back(rightDist2, node.Offset + 1);
+          }
+        }
+
+        std::sort_heap(heap.begin(), heap.end());
+        vtkIdType* ids = neighborIds + queryId * N;
+        double* d2 = distances ? distances + queryId * N : nullptr;
+        for (size_t i = 0; i < numNeighbors; ++i)
+        {
+          const bool found = i < heap.size();
+          ids[i] = found ? static_cast<vtkIdType>(locatorIds[heap[i].second]) : -1;
+          if (d2)
+          {
+            d2[i] = found ? static_cast<double>(heap[i].first) : VTK_DOUBLE_MAX;
+          }
+        }
+      }
+    });
+}
+
 //------------------------------------------------------------------------------
 vtkIdTypeArray* vtkKdTree::GetPointsInRegion(int regionId)
 {
@@ -3099,6 +3397,9 @@ void vtkKdTree::FreeSearchStructure()
 
   delete[] this->LocatorRegionLocation;
   this->LocatorRegionLocation = nullptr;
+
+  delete[] this->FlatNodes;
+  this->FlatNodes = nullptr;
 }
 
 //------------------------------------------------------------------------------
@@ -33,6 +33,10 @@
  *     ids to a subset of the ids that is unique within a supplied
  *     tolerance, or you can use FindPoint and FindClosestPoint to
  *     locate points in the original set that the tree was built from.
+ *     FindClosestNPointsBatch finds the neighbors of many points at once.
+ *
+ *     The regions are divided in parallel using vtkSMPTools; the resulting
+ *     tree does not depend on the number of threads.
  *
  * @sa
  *      vtkLocator vtkCellLocator vtkPKdTree
@@ -49,6 +53,7 @@ class vtkTimerLog;
 class vtkIdList;
 class vtkIdTypeArray;
 class vtkIntArray;
+class vtkDoubleArray;
 class vtkPointSet;
 class vtkPoints;
 class vtkCellArray;
@@ -542,6 +547,20 @@ public:
    */
   void FindClosestNPoints(int N, const double x[3], vtkIdList* result);
 
+  /**
+   * Find the closest N points to each of the given points. This is the
+   * batched version of FindClosestNPoints: the queries run in parallel on a
+   * flat copy of the tree, and the results are returned in arrays rather
+   * than in one vtkIdList per query. neighbors gets N components per query
+   * point, the ids of the closest points sorted from closest to farthest,
+   * padded with -1 if the tree has less than N points. If dist2 is given, it
+   * gets the matching squared distances (VTK_DOUBLE_MAX for padding). The
+   * distances are computed in single precision, like the tree. You must have called
+   * BuildLocatorFromPoints before calling this.
+   */
+  void FindClosestNPointsBatch(
+    int N, vtkPoints* points, vtkIdTypeArray* neighbors, vtkDoubleArray* dist2 = nullptr);
+
   /**
    * Get a list of the original IDs of all points in a region.  You
    * must have called BuildLocatorFromPoints before calling this.
@@ -768,6 +787,15 @@ protected:
 
   int DivideRegion(vtkKdNode* kd, float* c1, int* ids, int nlevels);
 
+  // Divide a region once, return 1 if it was divided.
+  int SplitRegion(vtkKdNode* kd, float* c1, int* ids, int level);
+
+  // Same as DivideRegion, dividing independent regions in parallel.
+  void DivideRegionInParallel(vtkKdNode* kd, float* c1, int* ids);
+
+  // Copy the tree built from points into FlatNodes, for the batched queries.
+  void BuildFlatNodes();
+
   void DoMedianFind(vtkKdNode* kd, float* c1, int* ids, int d1, int d2, int d3);
 
   void SelfRegister(vtkKdNode* kd);
@@ -876,6 +904,11 @@ protected:
   int* LocatorIds;
   int* LocatorRegionLocation;
 
+  // The tree built by BuildLocatorFromPoints, as an array of nodes in which
+  // the two children of a node are adjacent.
+  struct FlatNode;
+  FlatNode* FlatNodes;
+
   float MaxWidth;
 
   // These Last* values are here to save state so we can
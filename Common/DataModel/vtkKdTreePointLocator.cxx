@@ -49,6 +49,14 @@ void vtkKdTreePointLocator::FindClosestNPoints(int N, const double x[3], vtkIdLi
   this->KdTree->FindClosestNPoints(N, x, result);
 }
 
+//------------------------------------------------------------------------------
+void vtkKdTreePointLocator::FindClosestNPointsBatch(
+  int N, vtkPoints* points, vtkIdTypeArray* neighbors, vtkDoubleArray* dist2)
+{
+  this->BuildLocator();
+  this->KdTree->FindClosestNPointsBatch(N, points, neighbors, dist2);
+}
+
 //------------------------------------------------------------------------------
 void vtkKdTreePointLocator::FindPointsWithinRadius(double R, const double x[3], vtkIdList* result)
 {
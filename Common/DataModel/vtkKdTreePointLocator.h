@@ -53,6 +53,14 @@ public:
    */
   void FindClosestNPoints(int N, const double x[3], vtkIdList* result) override;
 
+  /**
+   * Find the closest N points to each of the given points, see
+   * vtkAbstractPointLocator. The queries run in parallel on a flat copy of the
+   * k-d tree. The squared distances are computed in single precision.
+   */
+  void FindClosestNPointsBatch(int N, vtkPoints* points, vtkIdTypeArray* neighbors,
+    vtkDoubleArray* dist2 = nullptr) override;
+
   /**
    * Find all points within a specified radius R of position x.
    * The result is not sorted in any specific manner.
@@ -6,6 +6,7 @@
 #include "vtkBoundingBox.h"
 #include "vtkBox.h"
 #include "vtkCellArray.h"
+#include "vtkCellLocatorBatchPrivate.h"
 #include "vtkDoubleArray.h"
 #include "vtkGenericCell.h"
 #include "vtkIdList.h"
@@ -1436,6 +1437,104 @@ int vtkStaticCellLocator::IntersectWithLine(const double p1[3], const double p2[
   return this->Processor->IntersectWithLine(p1, p2, tol, points, cellIds, cell);
 }
 
+//------------------------------------------------------------------------------
+void vtkStaticCellLocator::ComputeQueryOrder(vtkPoints* points, std::vector<vtkIdType>& order)
+{
+  if (!this->Binner)
+  {
+    this->Superclass::ComputeQueryOrder(points, order);
+    return;
+  }
+  const vtkCellBinner* binner = this->Binner;
+  vtkCellLocatorBatch::SortQueries(
+    points->GetNumberOfPoints(),
+    [&](vtkIdType pointId)
+    {
+      double x[3];
+      points->GetPoint(pointId, x);
+      return binner->GetBinIndex(x);
+    },
+    order);
+}
+
+//------------------------------------------------------------------------------
+void vtkStaticCellLocator::FindCells(
+  vtkPoints* points, vtkIdList* cellIds, double vtkNotUsed(tol2), vtkDoubleArray* pcoords)
+{
+  if (!points || !cellIds)
+  {
+    return;
+  }
+  this->BuildLocator();
+  if (!this->Processor)
+  {
+    cellIds->SetNumberOfIds(points->GetNumberOfPoints());
+    std::fill_n(cellIds->GetPointer(0), points->GetNumberOfPoints(), -1);
+    return;
+  }
+  std::vector<vtkIdType> order;
+  this->GetQueryOrder(points, nullptr, order);
+  vtkCellProcessor* processor = this->Processor;
+  vtkCellLocatorBatch::FindCells(this->DataSet, points, order, cellIds, pcoords,
+    [processor](double x[3], vtkGenericCell* cell, int& subId, double pc[3], double* weights)
+    { return processor->FindCell(x, cell, subId, pc, weights); });
+}
+
+//------------------------------------------------------------------------------
+void vtkStaticCellLocator::FindClosestPoints(
+  vtkPoints* points, vtkIdList* cellIds, vtkPoints* closestPoints, vtkDoubleArray* dist2)
+{
+  if (!points || !cellIds)
+  {
+    return;
+  }
+  this->BuildLocator();
+  if (!this->Processor)
+  {
+    cellIds->SetNumberOfIds(points->GetNumberOfPoints());
+    std::fill_n(cellIds->GetPointer(0), points->GetNumberOfPoints(), -1);
+    return;
+  }
+  std::vector<vtkIdType> order;
+  this->GetQueryOrder(points, nullptr, order);
+  vtkCellProcessor* processor = this->Processor;
+  vtkCellLocatorBatch::FindClosestPoints(this->DataSet, points, order, cellIds, closestPoints,
+    dist2,
+    [processor](double x[3], double closestPoint[3], vtkGenericCell* cell, vtkIdType& cellId,
+      int& subId, double& d2)
+    {
+      int inside;
+      return processor->FindClosestPointWithinRadius(
+               x, vtkMath::Inf(), closestPoint, cell, cellId, subId, d2, inside) != 0;
+    });
+}
+
+//------------------------------------------------------------------------------
+void vtkStaticCellLocator::IntersectWithLines(vtkPoints* p1, vtkPoints* p2, double tol,
+  vtkIdList* cellIds, vtkDoubleArray* t, vtkPoints* intersections)
+{
+  if (!p1 || !p2 || !cellIds || p1->GetNumberOfPoints() != p2->GetNumberOfPoints())
+  {
+    vtkErrorMacro(<< "IntersectWithLines needs as many start points as end points");
+    return;
+  }
+  this->BuildLocator();
+  if (!this->Processor)
+  {
+    cellIds->SetNumberOfIds(p1->GetNumberOfPoints());
+    std::fill_n(cellIds->GetPointer(0), p1->GetNumberOfPoints(), -1);
+    return;
+  }
+  std::vector<vtkIdType> order;
+  this->GetQueryOrder(p1, p2, order);
+  vtkCellProcessor* processor = this->Processor;
+  vtkCellLocatorBatch::IntersectWithLines(this->DataSet, p1, p2, order, cellIds, t,
+    intersections,
+    [processor, tol](const double a0[3], const double a1[3], double& tHit, double x[3],
+      double pcoords[3], int& subId, vtkIdType& cellId, vtkGenericCell* cell)
+    { return processor->IntersectWithLine(a0, a1, tol, tHit, x, pcoords, subId, cellId, cell); });
+}
+
 //------------------------------------------------------------------------------
 bool vtkStaticCellLocator::InsideCellBounds(double x[3], vtkIdType cellId)
 {
@@ -193,6 +193,29 @@ public:
   vtkIdType FindCell(double x[3], double vtkNotUsed(tol2), vtkGenericCell* GenCell, int& subId,
     double pcoords[3], double* weights) override;
 
+  /**
+   * FindCell, FindClosestPointWithinRadius and IntersectWithLine are thread
+   * safe, the batched queries run in parallel.
+   */
+  int GetThreadSafeQueries() override
+  {
+    return FIND_CELL | FIND_CLOSEST_POINT | INTERSECT_WITH_LINE;
+  }
+
+  ///@{
+  /**
+   * Batched queries, see vtkAbstractCellLocator. They query the bins of the
+   * locator directly, and process the queries bin after bin when
+   * ReorderQueries is on.
+   */
+  void FindCells(vtkPoints* points, vtkIdList* cellIds, double tol2 = 0.0,
+    vtkDoubleArray* pcoords = nullptr) override;
+  void FindClosestPoints(vtkPoints* points, vtkIdList* cellIds,
+    vtkPoints* closestPoints = nullptr, vtkDoubleArray* dist2 = nullptr) override;
+  void IntersectWithLines(vtkPoints* p1, vtkPoints* p2, double tol, vtkIdList* cellIds,
+    vtkDoubleArray* t = nullptr, vtkPoints* intersections = nullptr) override;
+  ///@}
+
   /**
    * Quickly test if a point is inside the bounds of a particular cell.
    * This function should be used ONLY after the locator is built.
@@ -222,6 +245,9 @@ protected:
 
   void BuildLocatorInternal() override;
 
+  // Order the batched queries by bin.
+  void ComputeQueryOrder(vtkPoints* points, std::vector<vtkIdType>& order) override;
+
   double Bounds[6]; // Bounding box of the whole dataset
   int Divisions[3]; // Number of sub-divisions in x-y-z directions
   double H[3];      // Width of each bin in x-y-z directions
@@ -31,8 +31,9 @@
  *    a cell can have less than 2^7 faces, so use vtkTypeInt8. Otherwise, use vtkTypeInt32
  *    when the input grid has polyhedron cells.
  *
- * @warning
- * This class handles only linear cells.
+ * The faces of nonlinear 3D cells are hashed using their corner points only, so
+ * that a face shared by a linear and a nonlinear cell ends up in a single hash.
+ * Nonlinear 0-1-2D cells are grouped with the other 0-1-2D cells.
  *
  * @warning
  * This class has been threaded with vtkSMPTools. Using TBB or other
@@ -5,15 +5,24 @@
 #include "vtkArrayDispatch.h"
 #include "vtkArrayDispatchDataSetArrayList.h"
 #include "vtkBatch.h"
+#include "vtkBiQuadraticQuadraticHexahedron.h"
+#include "vtkBiQuadraticQuadraticWedge.h"
 #include "vtkGenericCell.h"
 #include "vtkHexagonalPrism.h"
 #include "vtkHexahedron.h"
 #include "vtkIdList.h"
 #include "vtkPentagonalPrism.h"
 #include "vtkPyramid.h"
+#include "vtkQuadraticHexahedron.h"
+#include "vtkQuadraticLinearWedge.h"
+#include "vtkQuadraticPyramid.h"
+#include "vtkQuadraticTetra.h"
+#include "vtkQuadraticWedge.h"
 #include "vtkSMPThreadLocalObject.h"
 #include "vtkSMPTools.h"
 #include "vtkTetra.h"
+#include "vtkTriQuadraticHexahedron.h"
+#include "vtkTriQuadraticPyramid.h"
 #include "vtkUnstructuredGrid.h"
 #include "vtkVoxel.h"
 #include "vtkWedge.h"
@@ -137,6 +146,26 @@ struct vtkStaticFaceHashLinksTemplate<TInputIdType, TFaceIdType>::CreateFacesInf
 
   struct FaceInformationOperator : public vtkCellArray::DispatchUtilities
   {
+    // The hash value of a face of a quadratic cell is the minimum id of its corner points,
+    // so that it matches the hash value of the same face seen from a linear cell.
+    // Faces in [beginQuadFace, endQuadFace) have 4 corners, the other ones have 3.
+    template <typename TCell, typename TPoints>
+    static void HashQuadraticFaces(const TPoints& pts, int numFaces, int beginQuadFace,
+      int endQuadFace, TInputIdType* faceHashValues, vtkIdType& facesOffset)
+    {
+      vtkIdType ptIds[4];
+      for (int faceId = 0; faceId < numFaces; faceId++)
+      {
+        const vtkIdType* faceVerts = TCell::GetFaceArray(faceId);
+        const int numCorners = faceId >= beginQuadFace && faceId < endQuadFace ? 4 : 3;
+        for (int i = 0; i < numCorners; ++i)
+        {
+          ptIds[i] = pts[faceVerts[i]];
+        }
+        faceHashValues[facesOffset++] = *std::min_element(ptIds, ptIds + numCorners);
+      }
+    }
+
     template <class OffsetsT, class ConnectivityT, class CellTypesT>
     void operator()(OffsetsT* offsets, ConnectivityT* conn, CellTypesT* cellTypes,
       CreateFacesInformation* This, vtkIdType beginBatchId, vtkIdType endBatchId)
@@ -317,21 +346,71 @@ struct vtkStaticFaceHashLinksTemplate<TInputIdType, TFaceIdType>::CreateFacesInf
                   *std::min_element(facePointIds, facePointIds + numFacePoints);
               }
               break;
+            case VTK_QUADRATIC_TETRA:
+              cellOffsets[cellId] = facesOffset;
+              HashQuadraticFaces<vtkQuadraticTetra>(pts, 4, 0, 0, faceHashValues, facesOffset);
+              break;
+            case VTK_QUADRATIC_HEXAHEDRON:
+              cellOffsets[cellId] = facesOffset;
+              HashQuadraticFaces<vtkQuadraticHexahedron>(
+                pts, 6, 0, 6, faceHashValues, facesOffset);
+              break;
+            case VTK_TRIQUADRATIC_HEXAHEDRON:
+              cellOffsets[cellId] = facesOffset;
+              HashQuadraticFaces<vtkTriQuadraticHexahedron>(
+                pts, 6, 0, 6, faceHashValues, facesOffset);
+              break;
+            case VTK_BIQUADRATIC_QUADRATIC_HEXAHEDRON:
+              cellOffsets[cellId] = facesOffset;
+              HashQuadraticFaces<vtkBiQuadraticQuadraticHexahedron>(
+                pts, 6, 0, 6, faceHashValues, facesOffset);
+              break;
+            case VTK_QUADRATIC_WEDGE:
+              cellOffsets[cellId] = facesOffset;
+              HashQuadraticFaces<vtkQuadraticWedge>(pts, 5, 2, 5, faceHashValues, facesOffset);
+              break;
+            case VTK_QUADRATIC_LINEAR_WEDGE:
+              cellOffsets[cellId] = facesOffset;
+              HashQuadraticFaces<vtkQuadraticLinearWedge>(
+                pts, 5, 2, 5, faceHashValues, facesOffset);
+              break;
+            case VTK_BIQUADRATIC_QUADRATIC_WEDGE:
+              cellOffsets[cellId] = facesOffset;
+              HashQuadraticFaces<vtkBiQuadraticQuadraticWedge>(
+                pts, 5, 2, 5, faceHashValues, facesOffset);
+              break;
+            case VTK_QUADRATIC_PYRAMID:
+              cellOffsets[cellId] = facesOffset;
+              HashQuadraticFaces<vtkQuadraticPyramid>(pts, 5, 0, 1, faceHashValues, facesOffset);
+              break;
+            case VTK_TRIQUADRATIC_PYRAMID:
+              cellOffsets[cellId] = facesOffset;
+              HashQuadraticFaces<vtkTriQuadraticPyramid>(
+                pts, 5, 0, 1, faceHashValues, facesOffset);
+              break;
             default:
-              // Other types of 3D linear cells handled by vtkGeometryFilter. Exactly what
-              // is a linear cell is defined by vtkCellTypeUtilities::IsLinear().
+              // Other types of 3D cells are handled through vtkCell::GetFace(). Exactly what
+              // is a linear cell is defined by vtkCellTypeUtilities::IsLinear(). The faces
+              // of nonlinear cells are hashed using their corner points only.
               This->Input->GetCell(cellId, cell);
-              if (cell->GetCellDimension() == 3 && cell->IsLinear())
+              cellOffsets[cellId] = facesOffset;
+              if (cell->GetCellDimension() == 3)
               {
-                cellOffsets[cellId] = facesOffset;
+                const bool isLinear = cell->IsLinear() != 0;
                 for (faceId = 0, numFaces = cell->GetNumberOfFaces(); faceId < numFaces; faceId++)
                 {
                   vtkCell* faceCell = cell->GetFace(faceId);
-                  faceHashValues[facesOffset++] =
-                    *std::min_element(faceCell->PointIds->GetPointer(0),
-                      faceCell->PointIds->GetPointer(faceCell->PointIds->GetNumberOfIds()));
+                  const vtkIdType numCorners = isLinear ? faceCell->PointIds->GetNumberOfIds()
+                                                        : faceCell->GetNumberOfEdges();
+                  faceHashValues[facesOffset++] = *std::min_element(
+                    faceCell->PointIds->GetPointer(0), faceCell->PointIds->GetPointer(numCorners));
                 }
               }
+              else
+              {
+                // nonlinear 0-1-2d cells
+                faceHashValues[facesOffset++] = This->NumberOfPoints;
+              }
           }
         }
       }
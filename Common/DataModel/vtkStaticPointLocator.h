@@ -145,6 +145,11 @@ public:
    */
   void FindClosestNPoints(int N, const double x[3], vtkIdList* result) override;
 
+  /**
+   * FindClosestNPoints is thread safe, the batched queries run in parallel.
+   */
+  bool IsFindClosestNPointsThreadSafe() override { return true; }
+
   /**
    * Find approximately N close points which are strictly greater than
    * >minDist2 away from the query point x (minDist2 is the square of the
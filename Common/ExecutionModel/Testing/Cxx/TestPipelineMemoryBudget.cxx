@@ -0,0 +1,157 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// .NAME Test of vtkPipelineMemoryBudget.
+// .SECTION Description
+// Update a chain of filters with a memory budget smaller than their outputs
+// and check that the least recently used outputs are evicted, that they are
+// generated again when needed, and that the results do not change.
+
+#include "vtkCallbackCommand.h"
+#include "vtkCommand.h"
+#include "vtkDataArray.h"
+#include "vtkDataSet.h"
+#include "vtkElevationFilter.h"
+#include "vtkExecutive.h"
+#include "vtkImageData.h"
+#include "vtkNew.h"
+#include "vtkPipelineMemoryBudget.h"
+#include "vtkPointData.h"
+#include "vtkRTAnalyticSource.h"
+
+#include <cstdlib>
+#include <iostream>
+
+namespace
+{
+//------------------------------------------------------------------------------
+void CountExecution(vtkObject*, unsigned long, void* clientData, void*)
+{
+  ++*static_cast<int*>(clientData);
+}
+
+//------------------------------------------------------------------------------
+bool CheckValue(const char* name, vtkIdType value, vtkIdType expected)
+{
+  if (value != expected)
+  {
+    std::cerr << "Error: " << name << " is " << value << " instead of " << expected << "."
+              << std::endl;
+    return false;
+  }
+  return true;
+}
+}
+
+//------------------------------------------------------------------------------
+int TestPipelineMemoryBudget(int, char*[])
+{
+  int status = EXIT_SUCCESS;
+  int executions = 0;
+  vtkNew<vtkCallbackCommand> counter;
+  counter->SetCallback(CountExecution);
+  counter->SetClientData(&executions);
+
+  // source -> first -> second -> last
+  vtkNew<vtkRTAnalyticSource> source;
+  source->SetWholeExtent(-20, 20, -20, 20, -20, 20);
+  vtkNew<vtkElevationFilter> first;
+  first->SetInputConnection(source->GetOutputPort());
+  vtkNew<vtkElevationFilter> second;
+  second->SetInputConnection(first->GetOutputPort());
+  vtkNew<vtkElevationFilter> last;
+  last->SetInputConnection(second->GetOutputPort());
+  for (vtkAlgorithm* algorithm :
+    { static_cast<vtkAlgorithm*>(source), static_cast<vtkAlgorithm*>(first),
+      static_cast<vtkAlgorithm*>(second), static_cast<vtkAlgorithm*>(last) })
+  {
+    algorithm->AddObserver(vtkCommand::StartEvent, counter);
+  }
+
+  vtkNew<vtkPipelineMemoryBudget> budget;
+  vtkPipelineMemoryBudget::SetGlobalBudget(budget);
+
+  // Without limit, all the outputs are tracked and kept.
+  last->Update();
+  unsigned long lastSize = last->GetOutputDataObject(0)->GetActualMemorySize();
+  if (!CheckValue("number of outputs", budget->GetNumberOfOutputs(), 4) ||
+    !CheckValue("number of evictions", budget->GetNumberOfEvictions(), 0) ||
+    budget->GetOccupancy() <= lastSize)
+  {
+    status = EXIT_FAILURE;
+  }
+
+  // Only the output of the last filter fits in the budget.
+  budget->SetBudget(lastSize + 1);
+  budget->EvictOutputs(last->GetExecutive());
+  if (!CheckValue("number of evictions", budget->GetNumberOfEvictions(), 3) ||
+    !CheckValue("number of outputs", budget->GetNumberOfOutputs(), 1) ||
+    !CheckValue("released source output", source->GetOutputDataObject(0)->GetDataReleased(), 1) ||
+    !CheckValue("last output points",
+      vtkDataSet::SafeDownCast(last->GetOutputDataObject(0))->GetNumberOfPoints(), 41 * 41 * 41) ||
+    budget->GetOccupancy() > budget->GetBudget())
+  {
+    status = EXIT_FAILURE;
+  }
+
+  // The evicted outputs are not needed by an up to date pipeline.
+  executions = 0;
+  last->Update();
+  if (!CheckValue("executions of an up to date pipeline", executions, 0))
+  {
+    status = EXIT_FAILURE;
+  }
+
+  // They are generated again when the last filter executes, then evicted at
+  // the end of the update.
+  executions = 0;
+  last->SetHighPoint(0.0, 0.0, 20.0);
+  last->Update();
+  if (!CheckValue("executions after eviction", executions, 4) ||
+    !CheckValue("number of regenerations", budget->GetNumberOfRegenerations(), 3) ||
+    !CheckValue("number of evictions", budget->GetNumberOfEvictions(), 6) ||
+    budget->GetOccupancy() > budget->GetBudget())
+  {
+    status = EXIT_FAILURE;
+  }
+
+  // The output of the last filter is evicted by the next update.
+  double range[2], expected[2];
+  vtkDataSet::SafeDownCast(last->GetOutputDataObject(0))
+    ->GetPointData()
+    ->GetArray("Elevation")
+    ->GetRange(range);
+  vtkNew<vtkElevationFilter> reference;
+  reference->SetInputConnection(source->GetOutputPort());
+  reference->SetHighPoint(0.0, 0.0, 20.0);
+  reference->Update();
+  vtkDataSet::SafeDownCast(reference->GetOutputDataObject(0))
+    ->GetPointData()
+    ->GetArray("Elevation")
+    ->GetRange(expected);
+  if (range[0] != expected[0] || range[1] != expected[1])
+  {
+    std::cerr << "Error: the elevation range is [" << range[0] << ", " << range[1]
+              << "] instead of [" << expected[0] << ", " << expected[1] << "]." << std::endl;
+    status = EXIT_FAILURE;
+  }
+
+  // The data given by the application is never evicted.
+  vtkNew<vtkImageData> image;
+  image->DeepCopy(reference->GetOutputDataObject(0));
+  vtkNew<vtkElevationFilter> consumer;
+  consumer->SetInputData(image);
+  budget->SetBudget(1);
+  consumer->Update();
+  if (!CheckValue("application data points", image->GetNumberOfPoints(), 41 * 41 * 41))
+  {
+    status = EXIT_FAILURE;
+  }
+
+  vtkPipelineMemoryBudget::SetGlobalBudget(nullptr);
+  if (!CheckValue("number of outputs of a replaced budget", budget->GetNumberOfOutputs(), 0))
+  {
+    status = EXIT_FAILURE;
+  }
+
+  return status;
+}
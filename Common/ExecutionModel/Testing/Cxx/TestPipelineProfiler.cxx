@@ -0,0 +1,101 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// .NAME Test of vtkPipelineProfiler.
+// .SECTION Description
+// Update a small pipeline with a global profiler and check the passes it
+// records, the Chrome trace it writes and its summary.
+
+#include "vtkElevationFilter.h"
+#include "vtkNew.h"
+#include "vtkPipelineProfiler.h"
+#include "vtkRTAnalyticSource.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+//------------------------------------------------------------------------------
+int TestPipelineProfiler(int, char*[])
+{
+  int status = EXIT_SUCCESS;
+
+  vtkNew<vtkRTAnalyticSource> source;
+  source->SetWholeExtent(-20, 20, -20, 20, -20, 20);
+  vtkNew<vtkElevationFilter> elevation;
+  elevation->SetInputConnection(source->GetOutputPort());
+
+  vtkNew<vtkPipelineProfiler> profiler;
+  vtkPipelineProfiler::SetGlobalProfiler(profiler);
+  elevation->Update();
+  vtkPipelineProfiler::SetGlobalProfiler(nullptr);
+
+  // Nothing is recorded once the profiler is removed.
+  vtkIdType numberOfRecords = profiler->GetNumberOfRecords();
+  elevation->Modified();
+  elevation->Update();
+  if (profiler->GetNumberOfRecords() != numberOfRecords)
+  {
+    std::cerr << "Error: passes recorded by a profiler which is not global." << std::endl;
+    status = EXIT_FAILURE;
+  }
+
+  int informationPasses = 0;
+  int dataPasses = 0;
+  for (const vtkPipelineProfiler::Record& record : profiler->GetRecords())
+  {
+    if (record.Duration < 0.0 || !record.Success)
+    {
+      std::cerr << "Error: invalid record for " << record.ClassName << " " << record.Pass << "."
+                << std::endl;
+      status = EXIT_FAILURE;
+    }
+    if (record.Pass == "REQUEST_INFORMATION")
+    {
+      ++informationPasses;
+    }
+    if (record.Pass == "REQUEST_DATA" && record.ClassName == "vtkElevationFilter")
+    {
+      ++dataPasses;
+      if (record.ForCalls < 1 || record.InputBytes <= 0 || record.OutputBytes <= record.InputBytes)
+      {
+        std::cerr << "Error: the data pass of the elevation filter recorded " << record.ForCalls
+                  << " For() calls, " << record.InputBytes << " input bytes and "
+                  << record.OutputBytes << " output bytes." << std::endl;
+        status = EXIT_FAILURE;
+      }
+    }
+  }
+  if (informationPasses != 2 || dataPasses != 1)
+  {
+    std::cerr << "Error: " << informationPasses << " information passes and " << dataPasses
+              << " data passes of the elevation filter recorded." << std::endl;
+    status = EXIT_FAILURE;
+  }
+
+  std::ostringstream trace;
+  profiler->WriteChromeTrace(trace);
+  if (trace.str().find("\"traceEvents\"") == std::string::npos ||
+    trace.str().find("\"vtkElevationFilter REQUEST_DATA\"") == std::string::npos)
+  {
+    std::cerr << "Error: unexpected trace:\n" << trace.str() << std::endl;
+    status = EXIT_FAILURE;
+  }
+
+  std::ostringstream summary;
+  profiler->PrintSummary(summary);
+  if (summary.str().find("1 executions") == std::string::npos)
+  {
+    std::cerr << "Error: unexpected summary:\n" << summary.str() << std::endl;
+    status = EXIT_FAILURE;
+  }
+
+  profiler->Clear();
+  if (profiler->GetNumberOfRecords() != 0)
+  {
+    std::cerr << "Error: records remain after Clear()." << std::endl;
+    status = EXIT_FAILURE;
+  }
+
+  return status;
+}
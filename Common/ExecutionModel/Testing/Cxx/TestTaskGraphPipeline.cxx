@@ -0,0 +1,285 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// .NAME Test of vtkTaskGraphPipeline.
+// .SECTION Description
+// Update a fan-out pipeline, where four filters read the output of the same
+// source and are appended, with vtkCompositeDataPipeline and with
+// vtkTaskGraphPipeline. Check that both produce the same output and that each
+// algorithm executes once and only when needed. Then update filters iterating
+// over the blocks of the same composite data set concurrently.
+
+#include "vtkAppendFilter.h"
+#include "vtkCallbackCommand.h"
+#include "vtkCommand.h"
+#include "vtkCompositeDataIterator.h"
+#include "vtkCompositeDataPipeline.h"
+#include "vtkContourFilter.h"
+#include "vtkCutter.h"
+#include "vtkDataArray.h"
+#include "vtkDataSet.h"
+#include "vtkElevationFilter.h"
+#include "vtkMultiBlockDataGroupFilter.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkPlane.h"
+#include "vtkPointData.h"
+#include "vtkRTAnalyticSource.h"
+#include "vtkSmartPointer.h"
+#include "vtkTaskGraphPipeline.h"
+#include "vtkThreshold.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+//------------------------------------------------------------------------------
+void CountExecution(vtkObject*, unsigned long, void* clientData, void*)
+{
+  ++*static_cast<std::atomic<int>*>(clientData);
+}
+
+//------------------------------------------------------------------------------
+struct FanOutPipeline
+{
+  vtkSmartPointer<vtkRTAnalyticSource> Source;
+  vtkSmartPointer<vtkContourFilter> Contour;
+  vtkSmartPointer<vtkCutter> Cutter;
+  vtkSmartPointer<vtkThreshold> Threshold;
+  vtkSmartPointer<vtkElevationFilter> Elevation;
+  vtkSmartPointer<vtkAppendFilter> Append;
+  std::atomic<int> Executions{ 0 };
+
+  // The algorithms use the default executive prototype.
+  FanOutPipeline()
+  {
+    this->Source = vtkSmartPointer<vtkRTAnalyticSource>::New();
+    this->Source->SetWholeExtent(-40, 40, -40, 40, -40, 40);
+
+    this->Contour = vtkSmartPointer<vtkContourFilter>::New();
+    this->Contour->SetInputConnection(this->Source->GetOutputPort());
+    this->Contour->SetValue(0, 150.0);
+
+    vtkNew<vtkPlane> plane;
+    plane->SetNormal(1.0, 1.0, 0.0);
+    this->Cutter = vtkSmartPointer<vtkCutter>::New();
+    this->Cutter->SetInputConnection(this->Source->GetOutputPort());
+    this->Cutter->SetCutFunction(plane);
+
+    this->Threshold = vtkSmartPointer<vtkThreshold>::New();
+    this->Threshold->SetInputConnection(this->Source->GetOutputPort());
+    this->Threshold->SetThresholdFunction(vtkThreshold::THRESHOLD_BETWEEN);
+    this->Threshold->SetLowerThreshold(200.0);
+    this->Threshold->SetUpperThreshold(250.0);
+
+    this->Elevation = vtkSmartPointer<vtkElevationFilter>::New();
+    this->Elevation->SetInputConnection(this->Source->GetOutputPort());
+    this->Elevation->SetLowPoint(-40.0, 0.0, 0.0);
+    this->Elevation->SetHighPoint(40.0, 0.0, 0.0);
+
+    this->Append = vtkSmartPointer<vtkAppendFilter>::New();
+    this->Append->AddInputConnection(this->Contour->GetOutputPort());
+    this->Append->AddInputConnection(this->Cutter->GetOutputPort());
+    this->Append->AddInputConnection(this->Threshold->GetOutputPort());
+    this->Append->AddInputConnection(this->Elevation->GetOutputPort());
+
+    vtkNew<vtkCallbackCommand> counter;
+    counter->SetCallback(CountExecution);
+    counter->SetClientData(&this->Executions);
+    for (vtkAlgorithm* algorithm : this->Algorithms())
+    {
+      algorithm->AddObserver(vtkCommand::StartEvent, counter);
+    }
+  }
+
+  std::vector<vtkAlgorithm*> Algorithms() const
+  {
+    return { this->Source, this->Contour, this->Cutter, this->Threshold, this->Elevation,
+      this->Append };
+  }
+
+  // Return the number of algorithms executed by the update.
+  int Update(vtkAlgorithm* algorithm)
+  {
+    this->Executions = 0;
+    algorithm->Update();
+    return this->Executions;
+  }
+};
+
+//------------------------------------------------------------------------------
+// Two image data sets grouped in a multiblock data set, read by filters which
+// iterate over its blocks.
+struct CompositeFanOutPipeline
+{
+  vtkNew<vtkRTAnalyticSource> Sources[2];
+  vtkNew<vtkMultiBlockDataGroupFilter> Group;
+  vtkNew<vtkElevationFilter> Elevations[4];
+
+  CompositeFanOutPipeline()
+  {
+    this->Sources[0]->SetWholeExtent(-20, 0, -20, 20, -20, 20);
+    this->Sources[1]->SetWholeExtent(0, 20, -20, 20, -20, 20);
+    this->Group->AddInputConnection(this->Sources[0]->GetOutputPort());
+    this->Group->AddInputConnection(this->Sources[1]->GetOutputPort());
+    for (int i = 0; i < 4; ++i)
+    {
+      this->Elevations[i]->SetInputConnection(this->Group->GetOutputPort());
+      this->Elevations[i]->SetLowPoint(-20.0 + i, 0.0, 0.0);
+      this->Elevations[i]->SetHighPoint(20.0, 5.0 * i, 0.0);
+    }
+  }
+
+  std::vector<vtkAlgorithm*> Consumers() const
+  {
+    return { this->Elevations[0], this->Elevations[1], this->Elevations[2],
+      this->Elevations[3] };
+  }
+};
+
+//------------------------------------------------------------------------------
+// Return the ranges of the elevation of the blocks, or nothing if the output
+// is not the expected multiblock data set.
+std::vector<double> ElevationRanges(vtkDataObject* output)
+{
+  std::vector<double> ranges;
+  auto composite = vtkMultiBlockDataSet::SafeDownCast(output);
+  if (!composite)
+  {
+    return ranges;
+  }
+  vtkSmartPointer<vtkCompositeDataIterator> iter;
+  iter.TakeReference(composite->NewIterator());
+  for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+  {
+    auto block = vtkDataSet::SafeDownCast(iter->GetCurrentDataObject());
+    vtkDataArray* elevation = block ? block->GetPointData()->GetArray("Elevation") : nullptr;
+    if (!elevation)
+    {
+      return std::vector<double>();
+    }
+    ranges.push_back(elevation->GetRange()[0]);
+    ranges.push_back(elevation->GetRange()[1]);
+  }
+  return ranges;
+}
+
+//------------------------------------------------------------------------------
+bool CheckExecutions(const char* update, int executions, int expected)
+{
+  if (executions != expected)
+  {
+    std::cerr << "Error: " << update << " executed " << executions << " algorithms instead of "
+              << expected << "." << std::endl;
+    return false;
+  }
+  return true;
+}
+}
+
+//------------------------------------------------------------------------------
+int TestTaskGraphPipeline(int, char*[])
+{
+  int status = EXIT_SUCCESS;
+
+  vtkNew<vtkCompositeDataPipeline> sequentialPrototype;
+  vtkAlgorithm::SetDefaultExecutivePrototype(sequentialPrototype);
+  FanOutPipeline sequential;
+
+  vtkNew<vtkTaskGraphPipeline> taskGraphPrototype;
+  vtkAlgorithm::SetDefaultExecutivePrototype(taskGraphPrototype);
+  FanOutPipeline concurrent;
+  vtkAlgorithm::SetDefaultExecutivePrototype(nullptr);
+
+  if (!vtkTaskGraphPipeline::SafeDownCast(concurrent.Append->GetExecutive()))
+  {
+    std::cerr << "Error: the executive prototype was not used." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Each algorithm executes once, then only when modified.
+  if (!CheckExecutions("first update", concurrent.Update(concurrent.Append), 6) ||
+    !CheckExecutions("second update", concurrent.Update(concurrent.Append), 0))
+  {
+    status = EXIT_FAILURE;
+  }
+  concurrent.Contour->SetValue(0, 175.0);
+  sequential.Contour->SetValue(0, 175.0);
+  if (!CheckExecutions("update of a modified branch", concurrent.Update(concurrent.Append), 2))
+  {
+    status = EXIT_FAILURE;
+  }
+
+  sequential.Append->Update();
+  vtkUnstructuredGrid* expected = sequential.Append->GetOutput();
+  vtkUnstructuredGrid* output = concurrent.Append->GetOutput();
+  if (expected->GetNumberOfPoints() == 0 ||
+    output->GetNumberOfPoints() != expected->GetNumberOfPoints() ||
+    output->GetNumberOfCells() != expected->GetNumberOfCells())
+  {
+    std::cerr << "Error: the task graph produced " << output->GetNumberOfPoints() << " points and "
+              << output->GetNumberOfCells() << " cells instead of "
+              << expected->GetNumberOfPoints() << " points and " << expected->GetNumberOfCells()
+              << " cells." << std::endl;
+    status = EXIT_FAILURE;
+  }
+
+  // Update the branches without the append filter.
+  concurrent.Source->Modified();
+  concurrent.Executions = 0;
+  if (!vtkTaskGraphPipeline::UpdateConcurrently({ concurrent.Contour, concurrent.Cutter,
+        concurrent.Threshold, concurrent.Elevation }) ||
+    !CheckExecutions("concurrent update of the branches", concurrent.Executions, 5))
+  {
+    status = EXIT_FAILURE;
+  }
+  if (concurrent.Contour->GetOutput()->GetNumberOfPoints() !=
+    sequential.Contour->GetOutput()->GetNumberOfPoints())
+  {
+    std::cerr << "Error: the contour differs after a concurrent update." << std::endl;
+    status = EXIT_FAILURE;
+  }
+
+  // The filters iterating over the blocks of the same composite data set
+  // produce the same blocks as when they are updated one after another.
+  vtkAlgorithm::SetDefaultExecutivePrototype(sequentialPrototype);
+  CompositeFanOutPipeline compositeSequential;
+  vtkAlgorithm::SetDefaultExecutivePrototype(taskGraphPrototype);
+  CompositeFanOutPipeline compositeConcurrent;
+  vtkAlgorithm::SetDefaultExecutivePrototype(nullptr);
+  std::vector<std::vector<double>> expectedRanges;
+  for (vtkElevationFilter* elevation : compositeSequential.Elevations)
+  {
+    elevation->Update();
+    expectedRanges.push_back(ElevationRanges(elevation->GetOutputDataObject(0)));
+    if (expectedRanges.back().size() != 4)
+    {
+      std::cerr << "Error: the elevation of the blocks is missing." << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  for (int iteration = 0; iteration < 10; ++iteration)
+  {
+    compositeConcurrent.Group->Modified();
+    if (!vtkTaskGraphPipeline::UpdateConcurrently(compositeConcurrent.Consumers()))
+    {
+      std::cerr << "Error: the concurrent update of the composite consumers failed." << std::endl;
+      return EXIT_FAILURE;
+    }
+    for (int i = 0; i < 4; ++i)
+    {
+      vtkElevationFilter* elevation = compositeConcurrent.Elevations[i];
+      if (ElevationRanges(elevation->GetOutputDataObject(0)) != expectedRanges[i] ||
+        elevation->GetInputDataObject(0, 0) != compositeConcurrent.Group->GetOutputDataObject(0))
+      {
+        std::cerr << "Error: the output of composite consumer " << i << " differs." << std::endl;
+        status = EXIT_FAILURE;
+      }
+    }
+  }
+
+  return status;
+}
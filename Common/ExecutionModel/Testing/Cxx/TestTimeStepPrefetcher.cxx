@@ -0,0 +1,167 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// .NAME Test of vtkTimeStepPrefetcher.
+// .SECTION Description
+// Step through the time steps of a source with a prefetcher and check the
+// hits, the data handed over, the cancellations on a change of direction or
+// of the source, the budget, and the deletion of the source.
+
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataAlgorithm.h"
+#include "vtkSmartPointer.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkTimeStepPrefetcher.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+
+#define CHECK(b)                                                                                   \
+  do                                                                                               \
+  {                                                                                                \
+    if (!(b))                                                                                      \
+    {                                                                                              \
+      std::cerr << "Error on Line " << __LINE__ << ": " #b << std::endl;                           \
+      return EXIT_FAILURE;                                                                         \
+    }                                                                                              \
+  } while (false)
+
+namespace
+{
+constexpr int NUMBER_OF_TIME_STEPS = 10;
+constexpr vtkIdType NUMBER_OF_POINTS = 1000;
+
+//------------------------------------------------------------------------------
+// Generate points whose x coordinate is the requested time.
+class TestTimeStepSource : public vtkPolyDataAlgorithm
+{
+public:
+  static TestTimeStepSource* New();
+  vtkTypeMacro(TestTimeStepSource, vtkPolyDataAlgorithm);
+
+  int GetNumberOfExecutions() { return this->NumberOfExecutions; }
+
+protected:
+  TestTimeStepSource() { this->SetNumberOfInputPorts(0); }
+
+  int RequestInformation(vtkInformation*, vtkInformationVector**,
+    vtkInformationVector* outputVector) override
+  {
+    double timeSteps[NUMBER_OF_TIME_STEPS];
+    for (int i = 0; i < NUMBER_OF_TIME_STEPS; ++i)
+    {
+      timeSteps[i] = i;
+    }
+    double timeRange[2] = { 0.0, NUMBER_OF_TIME_STEPS - 1.0 };
+    vtkInformation* outInfo = outputVector->GetInformationObject(0);
+    outInfo->Set(vtkStreamingDemandDrivenPipeline::TIME_STEPS(), timeSteps, NUMBER_OF_TIME_STEPS);
+    outInfo->Set(vtkStreamingDemandDrivenPipeline::TIME_RANGE(), timeRange, 2);
+    return 1;
+  }
+
+  int RequestData(
+    vtkInformation*, vtkInformationVector**, vtkInformationVector* outputVector) override
+  {
+    ++this->NumberOfExecutions;
+    vtkInformation* outInfo = outputVector->GetInformationObject(0);
+    double time = outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP());
+    vtkNew<vtkPoints> points;
+    points->SetNumberOfPoints(NUMBER_OF_POINTS);
+    for (vtkIdType i = 0; i < NUMBER_OF_POINTS; ++i)
+    {
+      points->SetPoint(i, time, static_cast<double>(i), 0.0);
+    }
+    vtkPolyData::GetData(outputVector)->SetPoints(points);
+    return 1;
+  }
+
+private:
+  std::atomic<int> NumberOfExecutions{ 0 };
+};
+vtkStandardNewMacro(TestTimeStepSource);
+
+//------------------------------------------------------------------------------
+double GetOutputTime(TestTimeStepSource* source)
+{
+  vtkPolyData* output = source->GetOutput();
+  return output->GetNumberOfPoints() == NUMBER_OF_POINTS ? output->GetPoint(0)[0] : -1.0;
+}
+}
+
+//------------------------------------------------------------------------------
+int TestTimeStepPrefetcher(int, char*[])
+{
+  vtkNew<vtkTimeStepPrefetcher> prefetcher;
+  vtkSmartPointer<TestTimeStepSource> source = vtkSmartPointer<TestTimeStepSource>::New();
+  prefetcher->SetNumberOfTimeSteps(2);
+  prefetcher->SetAlgorithm(source);
+  CHECK(vtkTimeStepPrefetcher::GetPrefetcher(source) == prefetcher);
+
+  // The first time step is read, then the next two are prefetched.
+  source->UpdateTimeStep(0.0);
+  prefetcher->Wait();
+  CHECK(GetOutputTime(source) == 0.0);
+  CHECK(prefetcher->GetNumberOfMisses() == 1);
+  CHECK(prefetcher->GetNumberOfPrefetchedTimeSteps() == 2);
+  CHECK(source->GetNumberOfExecutions() == 3);
+  CHECK(prefetcher->GetOccupancy() > 0);
+
+  // Stepping forward hands the prefetched time steps over.
+  for (int step = 1; step <= 3; ++step)
+  {
+    source->UpdateTimeStep(step);
+    CHECK(GetOutputTime(source) == step);
+    prefetcher->Wait();
+  }
+  CHECK(prefetcher->GetNumberOfHits() == 3);
+  CHECK(prefetcher->GetNumberOfMisses() == 1);
+  CHECK(prefetcher->GetNumberOfPrefetchedTimeSteps() == 5);
+  CHECK(source->GetNumberOfExecutions() == 6);
+
+  // Stepping backward drops the time steps prefetched ahead.
+  source->UpdateTimeStep(2.0);
+  CHECK(GetOutputTime(source) == 2.0);
+  CHECK(prefetcher->GetNumberOfMisses() == 2);
+  CHECK(prefetcher->GetNumberOfCancellations() == 1);
+  prefetcher->Wait();
+  source->UpdateTimeStep(1.0);
+  CHECK(GetOutputTime(source) == 1.0);
+  CHECK(prefetcher->GetNumberOfHits() == 4);
+
+  // Once the budget is reached, no other time step is read until the
+  // prefetched one is handed over.
+  prefetcher->Cancel();
+  prefetcher->Wait();
+  prefetcher->ResetCounters();
+  prefetcher->SetBudget(1);
+  source->UpdateTimeStep(5.0);
+  prefetcher->Wait();
+  CHECK(prefetcher->GetNumberOfPrefetchedTimeSteps() == 1);
+  source->UpdateTimeStep(6.0);
+  CHECK(GetOutputTime(source) == 6.0);
+  CHECK(prefetcher->GetNumberOfHits() == 1);
+  prefetcher->Wait();
+  CHECK(prefetcher->GetNumberOfPrefetchedTimeSteps() == 2);
+  prefetcher->SetBudget(0);
+
+  // A modification of the source drops the prefetched time steps.
+  prefetcher->Wait();
+  source->Modified();
+  source->UpdateTimeStep(7.0);
+  CHECK(GetOutputTime(source) == 7.0);
+  CHECK(prefetcher->GetNumberOfHits() == 1);
+  CHECK(prefetcher->GetNumberOfCancellations() == 1);
+
+  // The source may be deleted while a time step is prefetched.
+  source->UpdateTimeStep(8.0);
+  source = nullptr;
+  CHECK(prefetcher->GetAlgorithm() == nullptr);
+  CHECK(prefetcher->GetOccupancy() == 0);
+
+  return EXIT_SUCCESS;
+}
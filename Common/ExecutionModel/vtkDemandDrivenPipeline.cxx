@@ -21,7 +21,9 @@
 #include "vtkInformationVector.h"
 #include "vtkLogger.h"
 #include "vtkObjectFactory.h"
+#include "vtkPipelineMemoryBudget.h"
 #include "vtkPointData.h"
+#include "vtkSmartPointer.h"
 
 #include <vector>
 
@@ -47,6 +49,10 @@ vtkDemandDrivenPipeline::vtkDemandDrivenPipeline()
 //------------------------------------------------------------------------------
 vtkDemandDrivenPipeline::~vtkDemandDrivenPipeline()
 {
+  if (vtkPipelineMemoryBudget* budget = vtkPipelineMemoryBudget::GetGlobalBudget())
+  {
+    budget->RemoveOutputs(this);
+  }
   if (this->InfoRequest)
   {
     this->InfoRequest->Delete();
@@ -401,8 +407,18 @@ int vtkDemandDrivenPipeline::UpdateData(int outputPort)
 
   // Send the request.
   this->DataRequest->Set(FROM_OUTPUT_PORT(), outputPort);
-  return this->ProcessRequest(
-    this->DataRequest, this->GetInputInformation(), this->GetOutputInformation());
+  vtkSmartPointer<vtkPipelineMemoryBudget> budget = vtkPipelineMemoryBudget::GetGlobalBudget();
+  if (budget)
+  {
+    budget->UpdateStarted();
+  }
+  int result =
+    this->ProcessRequest(this->DataRequest, this->GetInputInformation(), this->GetOutputInformation());
+  if (budget)
+  {
+    budget->UpdateFinished(this);
+  }
+  return result;
 }
 
 //------------------------------------------------------------------------------
@@ -501,6 +517,24 @@ void vtkDemandDrivenPipeline::ExecuteDataStart(
     }
   }
 
+  // The inputs are the most recently used outputs of the memory budget.
+  if (vtkPipelineMemoryBudget* budget = vtkPipelineMemoryBudget::GetGlobalBudget())
+  {
+    for (i = 0; i < this->GetNumberOfInputPorts(); ++i)
+    {
+      for (int j = 0; j < inInfo[i]->GetNumberOfInformationObjects(); ++j)
+      {
+        vtkExecutive* producer;
+        int producerPort;
+        vtkExecutive::PRODUCER()->Get(inInfo[i]->GetInformationObject(j), producer, producerPort);
+        if (producer)
+        {
+          budget->OutputUsed(producer, producerPort);
+        }
+      }
+    }
+  }
+
   // Tell observers the algorithm is about to execute.
   this->Algorithm->InvokeEvent(vtkCommand::StartEvent, nullptr);
 
@@ -547,10 +581,17 @@ void vtkDemandDrivenPipeline::ExecuteDataEnd(
   // Tell outputs they have been generated.
   this->MarkOutputsGenerated(request, inInfoVec, outputs);
 
-  // Remove any not-generated mark.
+  // Remove any not-generated mark. Track the generated outputs which are
+  // not released after use in the memory budget.
+  vtkPipelineMemoryBudget* budget = vtkPipelineMemoryBudget::GetGlobalBudget();
   for (i = 0; i < outputs->GetNumberOfInformationObjects(); ++i)
   {
     vtkInformation* outInfo = outputs->GetInformationObject(i);
+    if (budget && !outInfo->Get(DATA_NOT_GENERATED()) && !outInfo->Get(RELEASE_DATA()) &&
+      !vtkDataObject::GetGlobalReleaseDataFlag())
+    {
+      budget->OutputGenerated(this, i, outInfo->Get(vtkDataObject::DATA_OBJECT()));
+    }
     outInfo->Remove(DATA_NOT_GENERATED());
   }
 
@@ -564,6 +605,13 @@ void vtkDemandDrivenPipeline::ExecuteDataEnd(
       if (dataObject && (vtkDataObject::GetGlobalReleaseDataFlag() || inInfo->Get(RELEASE_DATA())))
       {
         dataObject->ReleaseData();
+        vtkExecutive* producer;
+        int producerPort;
+        vtkExecutive::PRODUCER()->Get(inInfo, producer, producerPort);
+        if (budget && producer)
+        {
+          budget->OutputReleased(producer, producerPort);
+        }
       }
     }
   }
@@ -1008,10 +1056,10 @@ int vtkDemandDrivenPipeline ::NeedToExecuteData(
       return 1;
     }
 
-    // If the output on the port making the request is out-of-date
-    // then we must execute.
+    // If the output on the port making the request is out-of-date,
+    // or was released, then we must execute.
     vtkDataObject* data = info->Get(vtkDataObject::DATA_OBJECT());
-    if (!data || this->PipelineMTime > data->GetUpdateTime())
+    if (!data || data->GetDataReleased() || this->PipelineMTime > data->GetUpdateTime())
     {
       return 1;
     }
@@ -9,11 +9,13 @@
 #include "vtkExecutive.h"
 #include "vtkForEach.h"
 #include "vtkInformation.h"
+#include "vtkInformationIntegerKey.h"
 #include "vtkInformationObjectBaseKey.h"
 #include "vtkInformationRequestKey.h"
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkTaskGraphPipeline.h"
 #include "vtkWeakPointer.h"
 
 VTK_ABI_NAMESPACE_BEGIN
@@ -45,6 +47,8 @@ vtkEndFor::vtkEndFor()
   : Internal(new Internals)
 {
   this->SetAggregator(vtkSmartPointer<vtkAggregateToPartitionedDataSetCollection>::New());
+  // The loop body is updated again for each iteration.
+  this->GetInformation()->Set(vtkTaskGraphPipeline::EXECUTE_ALONE(), 1);
 }
 
 //------------------------------------------------------------------------------
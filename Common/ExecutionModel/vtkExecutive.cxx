@@ -14,7 +14,9 @@
 #include "vtkInformationKeyVectorKey.h"
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
+#include "vtkPipelineProfiler.h"
 #include "vtkSmartPointer.h"
+#include "vtkTimeStepPrefetcher.h"
 
 #include <sstream>
 #include <vector>
@@ -719,9 +721,29 @@ int vtkExecutive::CallAlgorithm(vtkInformation* request, int direction,
   this->CopyDefaultInformation(request, direction, inInfo, outInfo);
 
   // Invoke the request on the algorithm.
+  vtkSmartPointer<vtkPipelineProfiler> profiler = vtkPipelineProfiler::GetGlobalProfiler();
+  vtkPipelineProfiler::Pass pass;
+  if (profiler)
+  {
+    profiler->StartPass(pass, this->Algorithm, request, inInfo);
+  }
+  // The prefetcher of the algorithm may be executing it on another thread.
+  vtkTimeStepPrefetcher* prefetcher = vtkTimeStepPrefetcher::GetPrefetcher(this->Algorithm);
+  if (prefetcher)
+  {
+    prefetcher->LockAlgorithm();
+  }
   this->InAlgorithm = 1;
   int result = this->Algorithm->ProcessRequest(request, inInfo, outInfo);
   this->InAlgorithm = 0;
+  if (prefetcher)
+  {
+    prefetcher->UnlockAlgorithm();
+  }
+  if (profiler)
+  {
+    profiler->EndPass(pass, outInfo, result);
+  }
 
   // If the algorithm failed report it now.
   if (!result)
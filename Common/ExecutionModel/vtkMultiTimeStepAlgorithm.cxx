@@ -6,11 +6,13 @@
 #include "vtkCompositeDataPipeline.h"
 #include "vtkInformation.h"
 #include "vtkInformationDoubleVectorKey.h"
+#include "vtkInformationIntegerKey.h"
 #include "vtkInformationKey.h"
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkTaskGraphPipeline.h"
 
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkMultiTimeStepAlgorithm);
@@ -25,6 +27,8 @@ vtkMultiTimeStepAlgorithm::vtkMultiTimeStepAlgorithm()
   this->SetNumberOfInputPorts(1);
   this->CacheData = false;
   this->NumberOfCacheEntries = 1;
+  // The input is updated again for each requested time step.
+  this->GetInformation()->Set(vtkTaskGraphPipeline::EXECUTE_ALONE(), 1);
 }
 
 //------------------------------------------------------------------------------
@@ -0,0 +1,317 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "vtkPipelineMemoryBudget.h"
+
+#include "vtkAlgorithm.h"
+#include "vtkDataObject.h"
+#include "vtkExecutive.h"
+#include "vtkInformation.h"
+#include "vtkInformationIntegerKey.h"
+#include "vtkInformationVector.h"
+#include "vtkObjectFactory.h"
+
+#include <algorithm>
+#include <climits>
+#include <list>
+#include <map>
+#include <mutex>
+#include <set>
+#include <utility>
+#include <vector>
+
+VTK_ABI_NAMESPACE_BEGIN
+vtkStandardNewMacro(vtkPipelineMemoryBudget);
+
+vtkInformationKeyMacro(vtkPipelineMemoryBudget, KEEP_OUTPUTS, Integer);
+
+vtkPipelineMemoryBudget* vtkPipelineMemoryBudget::GlobalBudget = nullptr;
+
+//------------------------------------------------------------------------------
+struct vtkPipelineMemoryBudget::Internals
+{
+  using OutputId = std::pair<vtkExecutive*, int>;
+
+  struct Output
+  {
+    OutputId Id;
+    unsigned long Size;
+  };
+
+  // Remove an output from the tracked ones. Its entry in the index is erased
+  // by the caller.
+  void Forget(std::map<OutputId, std::list<Output>::iterator>::iterator found)
+  {
+    this->Occupancy -= found->second->Size;
+    this->Outputs.erase(found->second);
+  }
+
+  std::mutex Mutex;
+  // Least recently used first.
+  std::list<Output> Outputs;
+  std::map<OutputId, std::list<Output>::iterator> Index;
+  // Evicted outputs, to count the ones generated again.
+  std::set<OutputId> Evicted;
+  int ActiveUpdates = 0;
+
+  unsigned long Budget = 0;
+  unsigned long Occupancy = 0;
+  unsigned long PeakOccupancy = 0;
+  vtkIdType NumberOfEvictions = 0;
+  vtkIdType NumberOfRegenerations = 0;
+};
+
+//------------------------------------------------------------------------------
+vtkPipelineMemoryBudget::vtkPipelineMemoryBudget()
+  : Internal(new Internals)
+{
+}
+
+//------------------------------------------------------------------------------
+vtkPipelineMemoryBudget::~vtkPipelineMemoryBudget() = default;
+
+//------------------------------------------------------------------------------
+void vtkPipelineMemoryBudget::SetGlobalBudget(vtkPipelineMemoryBudget* budget)
+{
+  if (vtkPipelineMemoryBudget::GlobalBudget == budget)
+  {
+    return;
+  }
+  if (vtkPipelineMemoryBudget* previous = vtkPipelineMemoryBudget::GlobalBudget)
+  {
+    {
+      std::lock_guard<std::mutex> lock(previous->Internal->Mutex);
+      previous->Internal->Outputs.clear();
+      previous->Internal->Index.clear();
+      previous->Internal->Evicted.clear();
+      previous->Internal->Occupancy = 0;
+    }
+    vtkPipelineMemoryBudget::GlobalBudget = nullptr;
+    previous->UnRegister(nullptr);
+  }
+  if (budget)
+  {
+    budget->Register(nullptr);
+  }
+  vtkPipelineMemoryBudget::GlobalBudget = budget;
+}
+
+//------------------------------------------------------------------------------
+vtkPipelineMemoryBudget* vtkPipelineMemoryBudget::GetGlobalBudget()
+{
+  return vtkPipelineMemoryBudget::GlobalBudget;
+}
+
+//------------------------------------------------------------------------------
+void vtkPipelineMemoryBudget::SetBudget(unsigned long budget)
+{
+  {
+    std::lock_guard<std::mutex> lock(this->Internal->Mutex);
+    if (this->Internal->Budget == budget)
+    {
+      return;
+    }
+    this->Internal->Budget = budget;
+  }
+  this->Modified();
+}
+
+//------------------------------------------------------------------------------
+unsigned long vtkPipelineMemoryBudget::GetBudget()
+{
+  std::lock_guard<std::mutex> lock(this->Internal->Mutex);
+  return this->Internal->Budget;
+}
+
+//------------------------------------------------------------------------------
+unsigned long vtkPipelineMemoryBudget::GetOccupancy()
+{
+  std::lock_guard<std::mutex> lock(this->Internal->Mutex);
+  return this->Internal->Occupancy;
+}
+
+//------------------------------------------------------------------------------
+unsigned long vtkPipelineMemoryBudget::GetPeakOccupancy()
+{
+  std::lock_guard<std::mutex> lock(this->Internal->Mutex);
+  return this->Internal->PeakOccupancy;
+}
+
+//------------------------------------------------------------------------------
+vtkIdType vtkPipelineMemoryBudget::GetNumberOfOutputs()
+{
+  std::lock_guard<std::mutex> lock(this->Internal->Mutex);
+  return static_cast<vtkIdType>(this->Internal->Index.size());
+}
+
+//------------------------------------------------------------------------------
+vtkIdType vtkPipelineMemoryBudget::GetNumberOfEvictions()
+{
+  std::lock_guard<std::mutex> lock(this->Internal->Mutex);
+  return this->Internal->NumberOfEvictions;
+}
+
+//------------------------------------------------------------------------------
+vtkIdType vtkPipelineMemoryBudget::GetNumberOfRegenerations()
+{
+  std::lock_guard<std::mutex> lock(this->Internal->Mutex);
+  return this->Internal->NumberOfRegenerations;
+}
+
+//------------------------------------------------------------------------------
+void vtkPipelineMemoryBudget::ResetCounters()
+{
+  std::lock_guard<std::mutex> lock(this->Internal->Mutex);
+  this->Internal->PeakOccupancy = this->Internal->Occupancy;
+  this->Internal->NumberOfEvictions = 0;
+  this->Internal->NumberOfRegenerations = 0;
+}
+
+//------------------------------------------------------------------------------
+void vtkPipelineMemoryBudget::OutputGenerated(vtkExecutive* executive, int port, vtkDataObject* data)
+{
+  vtkAlgorithm* algorithm = executive->GetAlgorithm();
+  if (!data || (algorithm && algorithm->GetInformation()->Get(KEEP_OUTPUTS())))
+  {
+    return;
+  }
+  // Computed before locking, this may traverse a large composite dataset.
+  unsigned long size = data->GetActualMemorySize();
+
+  std::lock_guard<std::mutex> lock(this->Internal->Mutex);
+  Internals::OutputId id(executive, port);
+  auto found = this->Internal->Index.find(id);
+  if (found != this->Internal->Index.end())
+  {
+    this->Internal->Forget(found);
+    this->Internal->Index.erase(found);
+  }
+  if (this->Internal->Evicted.erase(id))
+  {
+    ++this->Internal->NumberOfRegenerations;
+  }
+  this->Internal->Index[id] =
+    this->Internal->Outputs.insert(this->Internal->Outputs.end(), Internals::Output{ id, size });
+  this->Internal->Occupancy += size;
+  this->Internal->PeakOccupancy =
+    std::max(this->Internal->PeakOccupancy, this->Internal->Occupancy);
+}
+
+//------------------------------------------------------------------------------
+void vtkPipelineMemoryBudget::OutputUsed(vtkExecutive* executive, int port)
+{
+  std::lock_guard<std::mutex> lock(this->Internal->Mutex);
+  auto found = this->Internal->Index.find(Internals::OutputId(executive, port));
+  if (found != this->Internal->Index.end())
+  {
+    // Move it last, as the most recently used.
+    this->Internal->Outputs.splice(
+      this->Internal->Outputs.end(), this->Internal->Outputs, found->second);
+  }
+}
+
+//------------------------------------------------------------------------------
+void vtkPipelineMemoryBudget::OutputReleased(vtkExecutive* executive, int port)
+{
+  std::lock_guard<std::mutex> lock(this->Internal->Mutex);
+  auto found = this->Internal->Index.find(Internals::OutputId(executive, port));
+  if (found != this->Internal->Index.end())
+  {
+    this->Internal->Forget(found);
+    this->Internal->Index.erase(found);
+  }
+}
+
+//------------------------------------------------------------------------------
+void vtkPipelineMemoryBudget::RemoveOutputs(vtkExecutive* executive)
+{
+  std::lock_guard<std::mutex> lock(this->Internal->Mutex);
+  auto& index = this->Internal->Index;
+  auto first = index.lower_bound(Internals::OutputId(executive, INT_MIN));
+  auto last = first;
+  for (; last != index.end() && last->first.first == executive; ++last)
+  {
+    this->Internal->Forget(last);
+  }
+  index.erase(first, last);
+
+  auto& evicted = this->Internal->Evicted;
+  evicted.erase(evicted.lower_bound(Internals::OutputId(executive, INT_MIN)),
+    evicted.upper_bound(Internals::OutputId(executive, INT_MAX)));
+}
+
+//------------------------------------------------------------------------------
+void vtkPipelineMemoryBudget::UpdateStarted()
+{
+  std::lock_guard<std::mutex> lock(this->Internal->Mutex);
+  ++this->Internal->ActiveUpdates;
+}
+
+//------------------------------------------------------------------------------
+void vtkPipelineMemoryBudget::UpdateFinished(vtkExecutive* executive)
+{
+  {
+    std::lock_guard<std::mutex> lock(this->Internal->Mutex);
+    // Outputs are still being read while an update is in progress.
+    if (--this->Internal->ActiveUpdates > 0)
+    {
+      return;
+    }
+  }
+  for (int i = 0; executive && i < executive->GetNumberOfOutputPorts(); ++i)
+  {
+    this->OutputUsed(executive, i);
+  }
+  this->EvictOutputs(executive);
+}
+
+//------------------------------------------------------------------------------
+void vtkPipelineMemoryBudget::EvictOutputs(vtkExecutive* keep)
+{
+  std::vector<Internals::OutputId> evicted;
+  {
+    std::lock_guard<std::mutex> lock(this->Internal->Mutex);
+    auto& outputs = this->Internal->Outputs;
+    auto output = outputs.begin();
+    while (this->Internal->Budget > 0 && this->Internal->Occupancy > this->Internal->Budget &&
+      output != outputs.end())
+    {
+      if (output->Id.first == keep)
+      {
+        ++output;
+        continue;
+      }
+      evicted.push_back(output->Id);
+      this->Internal->Evicted.insert(output->Id);
+      this->Internal->Occupancy -= output->Size;
+      this->Internal->Index.erase(output->Id);
+      output = outputs.erase(output);
+      ++this->Internal->NumberOfEvictions;
+    }
+  }
+
+  // The next request for the data executes the algorithm again.
+  for (const auto& id : evicted)
+  {
+    vtkInformation* info = id.first->GetOutputInformation(id.second);
+    if (vtkDataObject* data = info ? info->Get(vtkDataObject::DATA_OBJECT()) : nullptr)
+    {
+      vtkDebugMacro("Evicting output " << id.second << " of "
+                                       << id.first->GetAlgorithm()->GetObjectDescription());
+      data->ReleaseData();
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+void vtkPipelineMemoryBudget::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "Budget: " << this->GetBudget() << " KiB\n";
+  os << indent << "Occupancy: " << this->GetOccupancy() << " KiB\n";
+  os << indent << "PeakOccupancy: " << this->GetPeakOccupancy() << " KiB\n";
+  os << indent << "NumberOfOutputs: " << this->GetNumberOfOutputs() << "\n";
+  os << indent << "NumberOfEvictions: " << this->GetNumberOfEvictions() << "\n";
+  os << indent << "NumberOfRegenerations: " << this->GetNumberOfRegenerations() << "\n";
+}
+VTK_ABI_NAMESPACE_END
@@ -0,0 +1,154 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class   vtkPipelineMemoryBudget
+ * @brief   Bound the memory held by the outputs of the pipeline
+ *
+ * vtkPipelineMemoryBudget tracks the memory used by the outputs of all the
+ * algorithms, as reported by vtkDataObject::GetActualMemorySize(), and
+ * releases the least recently used ones when their total exceeds a budget.
+ * A released output is generated again, by executing its algorithm, the next
+ * time an algorithm downstream needs it. This bounds the memory kept by the
+ * intermediate outputs of long running applications, at the cost of
+ * executing again the algorithms whose outputs are evicted.
+ *
+ * The budget applies once it is made global with SetGlobalBudget(). The
+ * executives derived from vtkDemandDrivenPipeline then report the outputs they
+ * generate, and the outputs read by the algorithms they execute. Outputs are
+ * only evicted when the outermost update completes, i.e. when
+ * vtkAlgorithm::Update() returns, and never those of the updated algorithm.
+ * Until then, the occupancy may exceed the budget.
+ *
+ * An algorithm whose outputs cannot be generated again, as vtkTrivialProducer
+ * whose output is given by the application, sets the KEEP_OUTPUTS() key in its
+ * information. The outputs of an algorithm are not tracked either when they
+ * are released by the pipeline after use (see
+ * vtkDemandDrivenPipeline::SetReleaseDataFlag()).
+ *
+ * Data objects kept by the application, e.g. obtained with
+ * vtkAlgorithm::GetOutputDataObject(), are emptied when evicted. Arrays shared
+ * between several outputs are counted for each of them.
+ *
+ * @sa
+ * vtkDemandDrivenPipeline vtkCachedStreamingDemandDrivenPipeline
+ */
+
+#ifndef vtkPipelineMemoryBudget_h
+#define vtkPipelineMemoryBudget_h
+
+#include "vtkCommonExecutionModelModule.h" // For export macro
+#include "vtkObject.h"
+
+#include <memory> // For std::unique_ptr
+
+VTK_ABI_NAMESPACE_BEGIN
+class vtkDataObject;
+class vtkExecutive;
+class vtkInformationIntegerKey;
+
+class VTKCOMMONEXECUTIONMODEL_EXPORT vtkPipelineMemoryBudget : public vtkObject
+{
+public:
+  static vtkPipelineMemoryBudget* New();
+  vtkTypeMacro(vtkPipelineMemoryBudget, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  ///@{
+  /**
+   * Set/Get the budget which applies to the outputs of all the pipelines, or
+   * nullptr (the default) to track nothing. The outputs tracked by the
+   * previous budget are forgotten.
+   */
+  static void SetGlobalBudget(vtkPipelineMemoryBudget* budget);
+  static vtkPipelineMemoryBudget* GetGlobalBudget();
+  ///@}
+
+  ///@{
+  /**
+   * Set/Get the memory the outputs may use, in kibibytes. 0 means no limit,
+   * in which case the outputs are tracked but never evicted. Default is 0.
+   */
+  void SetBudget(unsigned long budget);
+  unsigned long GetBudget();
+  ///@}
+
+  /**
+   * Return the memory used by the tracked outputs, in kibibytes.
+   */
+  unsigned long GetOccupancy();
+
+  /**
+   * Return the highest occupancy reached, in kibibytes.
+   */
+  unsigned long GetPeakOccupancy();
+
+  /**
+   * Return the number of outputs tracked.
+   */
+  vtkIdType GetNumberOfOutputs();
+
+  /**
+   * Return the number of outputs evicted so far.
+   */
+  vtkIdType GetNumberOfEvictions();
+
+  /**
+   * Return the number of evicted outputs which were generated again because
+   * an algorithm needed them. A value close to the number of evictions means
+   * the budget is too low for the pipelines.
+   */
+  vtkIdType GetNumberOfRegenerations();
+
+  /**
+   * Reset the peak occupancy and the numbers of evictions and regenerations.
+   */
+  void ResetCounters();
+
+  /**
+   * Evict the least recently used outputs until the occupancy fits in the
+   * budget, except the outputs of the given executive. This is done at the
+   * end of each update, so it is only needed after the budget is decreased.
+   */
+  void EvictOutputs(vtkExecutive* keep = nullptr);
+
+  /**
+   * Key set to 1 in the information of an algorithm (vtkAlgorithm::GetInformation())
+   * whose outputs must never be evicted.
+   * \ingroup InformationKeys
+   */
+  static vtkInformationIntegerKey* KEEP_OUTPUTS();
+
+  ///@{
+  /**
+   * Methods called by the executives.
+   * OutputGenerated() tracks an output after its algorithm executed,
+   * OutputUsed() marks an output as recently used, OutputReleased() forgets
+   * an output released by the pipeline, and RemoveOutputs() forgets the
+   * outputs of an executive being destroyed. UpdateStarted() and
+   * UpdateFinished() surround the updates, outputs are evicted after the
+   * outermost one, except those of the given executive if any.
+   */
+  void OutputGenerated(vtkExecutive* executive, int port, vtkDataObject* data);
+  void OutputUsed(vtkExecutive* executive, int port);
+  void OutputReleased(vtkExecutive* executive, int port);
+  void RemoveOutputs(vtkExecutive* executive);
+  void UpdateStarted();
+  void UpdateFinished(vtkExecutive* executive);
+  ///@}
+
+protected:
+  vtkPipelineMemoryBudget();
+  ~vtkPipelineMemoryBudget() override;
+
+private:
+  vtkPipelineMemoryBudget(const vtkPipelineMemoryBudget&) = delete;
+  void operator=(const vtkPipelineMemoryBudget&) = delete;
+
+  static vtkPipelineMemoryBudget* GlobalBudget;
+
+  struct Internals;
+  std::unique_ptr<Internals> Internal;
+};
+
+VTK_ABI_NAMESPACE_END
+#endif
@@ -0,0 +1,314 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "vtkPipelineProfiler.h"
+
+#include "vtkAlgorithm.h"
+#include "vtkDataObject.h"
+#include "vtkDemandDrivenPipeline.h"
+#include "vtkInformation.h"
+#include "vtkInformationIterator.h"
+#include "vtkInformationRequestKey.h"
+#include "vtkInformationVector.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkSMPTools.h"
+#include "vtkScratchArena.h"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <mutex>
+#include <thread>
+
+VTK_ABI_NAMESPACE_BEGIN
+vtkStandardNewMacro(vtkPipelineProfiler);
+
+vtkPipelineProfiler* vtkPipelineProfiler::GlobalProfiler = nullptr;
+
+//------------------------------------------------------------------------------
+struct vtkPipelineProfiler::Internals
+{
+  using Clock = std::chrono::steady_clock;
+
+  double Now() const { return std::chrono::duration<double>(Clock::now() - this->Origin).count(); }
+
+  std::mutex Mutex;
+  Clock::time_point Origin = Clock::now();
+  std::vector<Record> Records;
+  std::map<std::thread::id, int> Threads;
+};
+
+namespace
+{
+//------------------------------------------------------------------------------
+long long DataSize(vtkInformationVector* infoVector)
+{
+  long long size = 0;
+  for (int i = 0; infoVector && i < infoVector->GetNumberOfInformationObjects(); ++i)
+  {
+    if (vtkDataObject* data = infoVector->GetInformationObject(i)->Get(vtkDataObject::DATA_OBJECT()))
+    {
+      size += static_cast<long long>(data->GetActualMemorySize()) * 1024;
+    }
+  }
+  return size;
+}
+
+//------------------------------------------------------------------------------
+void WriteJSONString(ostream& os, const std::string& str)
+{
+  os << '"';
+  for (char c : str)
+  {
+    switch (c)
+    {
+      case '"':
+        os << "\\\"";
+        break;
+      case '\\':
+        os << "\\\\";
+        break;
+      case '\n':
+        os << "\\n";
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20)
+        {
+          os << ' ';
+        }
+        else
+        {
+          os << c;
+        }
+    }
+  }
+  os << '"';
+}
+}
+
+//------------------------------------------------------------------------------
+vtkPipelineProfiler::vtkPipelineProfiler()
+  : Internal(new Internals)
+{
+}
+
+//------------------------------------------------------------------------------
+vtkPipelineProfiler::~vtkPipelineProfiler() = default;
+
+//------------------------------------------------------------------------------
+void vtkPipelineProfiler::SetGlobalProfiler(vtkPipelineProfiler* profiler)
+{
+  if (vtkPipelineProfiler::GlobalProfiler == profiler)
+  {
+    return;
+  }
+  if (vtkPipelineProfiler::GlobalProfiler)
+  {
+    vtkPipelineProfiler::GlobalProfiler->UnRegister(nullptr);
+    vtkPipelineProfiler::GlobalProfiler = nullptr;
+  }
+  if (profiler)
+  {
+    profiler->Register(nullptr);
+  }
+  vtkPipelineProfiler::GlobalProfiler = profiler;
+}
+
+//------------------------------------------------------------------------------
+vtkPipelineProfiler* vtkPipelineProfiler::GetGlobalProfiler()
+{
+  return vtkPipelineProfiler::GlobalProfiler;
+}
+
+//------------------------------------------------------------------------------
+vtkIdType vtkPipelineProfiler::GetNumberOfRecords()
+{
+  std::lock_guard<std::mutex> lock(this->Internal->Mutex);
+  return static_cast<vtkIdType>(this->Internal->Records.size());
+}
+
+//------------------------------------------------------------------------------
+std::vector<vtkPipelineProfiler::Record> vtkPipelineProfiler::GetRecords()
+{
+  std::lock_guard<std::mutex> lock(this->Internal->Mutex);
+  return this->Internal->Records;
+}
+
+//------------------------------------------------------------------------------
+void vtkPipelineProfiler::Clear()
+{
+  std::lock_guard<std::mutex> lock(this->Internal->Mutex);
+  this->Internal->Records.clear();
+  this->Internal->Threads.clear();
+  this->Internal->Origin = Internals::Clock::now();
+}
+
+//------------------------------------------------------------------------------
+void vtkPipelineProfiler::StartPass(
+  Pass& pass, vtkAlgorithm* algorithm, vtkInformation* request, vtkInformationVector** inInfo)
+{
+  pass.Algorithm = algorithm;
+
+  // The request is identified by its request key.
+  vtkNew<vtkInformationIterator> iter;
+  iter->SetInformationWeak(request);
+  for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+  {
+    if (vtkInformationRequestKey::SafeDownCast(iter->GetCurrentKey()))
+    {
+      pass.Name = iter->GetCurrentKey()->GetName();
+      break;
+    }
+  }
+
+  if (this->MeasureDataSizes && request->Has(vtkDemandDrivenPipeline::REQUEST_DATA()))
+  {
+    pass.InputBytes = 0;
+    for (int i = 0; i < algorithm->GetNumberOfInputPorts(); ++i)
+    {
+      pass.InputBytes += DataSize(inInfo[i]);
+    }
+  }
+
+  vtkScratchArena::Statistics statistics = vtkScratchArena::GetStatistics();
+  pass.HeapAllocations = statistics.HeapAllocations;
+  pass.ArenaAllocations = statistics.ArenaAllocations;
+  pass.ForCalls = vtkSMPTools::GetNumberOfForCalls();
+  pass.Start = this->Internal->Now();
+}
+
+//------------------------------------------------------------------------------
+void vtkPipelineProfiler::EndPass(Pass& pass, vtkInformationVector* outInfo, int result)
+{
+  Record record;
+  record.Duration = this->Internal->Now() - pass.Start;
+  record.Start = pass.Start;
+  record.ForCalls = vtkSMPTools::GetNumberOfForCalls() - pass.ForCalls;
+  vtkScratchArena::Statistics statistics = vtkScratchArena::GetStatistics();
+  record.HeapAllocations = statistics.HeapAllocations - pass.HeapAllocations;
+  record.ArenaAllocations = statistics.ArenaAllocations - pass.ArenaAllocations;
+  record.Algorithm = pass.Algorithm->GetObjectDescription();
+  record.ClassName = pass.Algorithm->GetClassName();
+  record.Pass = pass.Name ? pass.Name : "UNKNOWN";
+  record.Success = result != 0;
+  if (pass.InputBytes >= 0)
+  {
+    record.InputBytes = pass.InputBytes;
+    record.OutputBytes = DataSize(outInfo);
+  }
+
+  std::lock_guard<std::mutex> lock(this->Internal->Mutex);
+  auto thread = this->Internal->Threads
+                  .emplace(std::this_thread::get_id(),
+                    static_cast<int>(this->Internal->Threads.size()))
+                  .first;
+  record.Thread = thread->second;
+  this->Internal->Records.push_back(std::move(record));
+}
+
+//------------------------------------------------------------------------------
+bool vtkPipelineProfiler::WriteChromeTrace(const char* fileName)
+{
+  std::ofstream file(fileName);
+  if (!file)
+  {
+    vtkErrorMacro("Cannot open " << fileName << " for writing.");
+    return false;
+  }
+  this->WriteChromeTrace(file);
+  return static_cast<bool>(file);
+}
+
+//------------------------------------------------------------------------------
+void vtkPipelineProfiler::WriteChromeTrace(ostream& os)
+{
+  std::vector<Record> records = this->GetRecords();
+  int numberOfThreads = 0;
+  for (const Record& record : records)
+  {
+    numberOfThreads = std::max(numberOfThreads, record.Thread + 1);
+  }
+
+  os << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+  const char* separator = "\n";
+  for (int thread = 0; thread < numberOfThreads; ++thread)
+  {
+    os << separator << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << thread
+       << ",\"args\":{\"name\":\"pipeline thread " << thread << "\"}}";
+    separator = ",\n";
+  }
+  os << std::fixed << std::setprecision(3);
+  for (const Record& record : records)
+  {
+    os << separator << "{\"name\":";
+    WriteJSONString(os, record.ClassName + " " + record.Pass);
+    os << ",\"cat\":";
+    WriteJSONString(os, record.Pass);
+    os << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << record.Thread << ",\"ts\":" << record.Start * 1e6
+       << ",\"dur\":" << record.Duration * 1e6 << ",\"args\":{\"algorithm\":";
+    WriteJSONString(os, record.Algorithm);
+    if (record.InputBytes >= 0)
+    {
+      os << ",\"input_bytes\":" << record.InputBytes << ",\"output_bytes\":" << record.OutputBytes;
+    }
+    os << ",\"smp_for_calls\":" << record.ForCalls
+       << ",\"heap_allocations\":" << record.HeapAllocations
+       << ",\"arena_allocations\":" << record.ArenaAllocations
+       << ",\"success\":" << (record.Success ? "true" : "false") << "}}";
+    separator = ",\n";
+  }
+  os << "\n]}\n";
+}
+
+//------------------------------------------------------------------------------
+void vtkPipelineProfiler::PrintSummary(ostream& os)
+{
+  struct Summary
+  {
+    std::string Algorithm;
+    double Total = 0.0;
+    int Executions = 0;
+    std::map<std::string, double> Passes;
+  };
+  std::map<std::string, Summary> summaries;
+  for (const Record& record : this->GetRecords())
+  {
+    Summary& summary = summaries[record.Algorithm];
+    summary.Algorithm = record.Algorithm;
+    summary.Total += record.Duration;
+    summary.Passes[record.Pass] += record.Duration;
+    if (record.Pass == vtkDemandDrivenPipeline::REQUEST_DATA()->GetName())
+    {
+      ++summary.Executions;
+    }
+  }
+  std::vector<Summary*> sorted;
+  for (auto& summary : summaries)
+  {
+    sorted.push_back(&summary.second);
+  }
+  std::sort(sorted.begin(), sorted.end(),
+    [](const Summary* a, const Summary* b) { return a->Total > b->Total; });
+
+  for (const Summary* summary : sorted)
+  {
+    os << summary->Algorithm << ": " << summary->Total << " s, " << summary->Executions
+       << " executions\n";
+    for (const auto& pass : summary->Passes)
+    {
+      os << "  " << pass.first << ": " << pass.second << " s\n";
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+void vtkPipelineProfiler::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "MeasureDataSizes: " << (this->MeasureDataSizes ? "On" : "Off") << "\n";
+  os << indent << "NumberOfRecords: " << this->GetNumberOfRecords() << "\n";
+}
+VTK_ABI_NAMESPACE_END
@@ -0,0 +1,170 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class   vtkPipelineProfiler
+ * @brief   Record the passes of all the algorithms of the pipelines
+ *
+ * vtkPipelineProfiler records each request an executive makes to its
+ * algorithm (REQUEST_INFORMATION, REQUEST_UPDATE_EXTENT, REQUEST_DATA...)
+ * once it is made global with SetGlobalProfiler(). For each of these passes,
+ * it records the wall time, the thread, the number of vtkSMPTools::For()
+ * calls, the allocations counted by vtkScratchArena and, for REQUEST_DATA,
+ * the memory of the inputs and of the outputs. The records can be written
+ * as a Chrome trace, which chrome://tracing and https://ui.perfetto.dev
+ * display as a timeline, or summarized per algorithm.
+ *
+ * \code{.cpp}
+ * vtkNew<vtkPipelineProfiler> profiler;
+ * vtkPipelineProfiler::SetGlobalProfiler(profiler);
+ * writer->Update();
+ * vtkPipelineProfiler::SetGlobalProfiler(nullptr);
+ * profiler->WriteChromeTrace("pipeline.json");
+ * profiler->PrintSummary(std::cout);
+ * \endcode
+ *
+ * The time of a pass does not include the passes of the algorithms upstream,
+ * which the executive makes before. The For() calls are those made from the
+ * thread executing the algorithm. The allocation counters are process-wide,
+ * so they include the allocations of the passes executing concurrently, and
+ * are only counted when vtkScratchArena::SetCountAllocations() is on.
+ * Measuring the memory of the data objects traverses composite datasets, it
+ * can be disabled with MeasureDataSizesOff().
+ *
+ * @sa
+ * vtkExecutionTimer vtkScratchArena vtkSMPTools
+ */
+
+#ifndef vtkPipelineProfiler_h
+#define vtkPipelineProfiler_h
+
+#include "vtkCommonExecutionModelModule.h" // For export macro
+#include "vtkObject.h"
+#include "vtkWrappingHints.h" // For VTK_WRAPEXCLUDE
+
+#include <memory> // For std::unique_ptr
+#include <string> // For Record
+#include <vector> // For GetRecords
+
+VTK_ABI_NAMESPACE_BEGIN
+class vtkAlgorithm;
+class vtkInformation;
+class vtkInformationVector;
+
+class VTKCOMMONEXECUTIONMODEL_EXPORT vtkPipelineProfiler : public vtkObject
+{
+public:
+  static vtkPipelineProfiler* New();
+  vtkTypeMacro(vtkPipelineProfiler, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  ///@{
+  /**
+   * Set/Get the profiler recording the passes of all the executives, or
+   * nullptr (the default) to record nothing.
+   */
+  static void SetGlobalProfiler(vtkPipelineProfiler* profiler);
+  static vtkPipelineProfiler* GetGlobalProfiler();
+  ///@}
+
+  ///@{
+  /**
+   * Enable/disable the measure of the memory of the inputs and outputs of
+   * REQUEST_DATA. Default is on.
+   */
+  vtkSetMacro(MeasureDataSizes, bool);
+  vtkGetMacro(MeasureDataSizes, bool);
+  vtkBooleanMacro(MeasureDataSizes, bool);
+  ///@}
+
+  /**
+   * A pass of an algorithm. Times are in seconds since the creation of the
+   * profiler or the last Clear().
+   */
+  struct Record
+  {
+    std::string Algorithm;   // object description of the algorithm
+    std::string ClassName;   // class of the algorithm
+    std::string Pass;        // name of the request key, e.g. REQUEST_DATA
+    double Start = 0.0;      // start time
+    double Duration = 0.0;   // wall time
+    int Thread = 0;          // index of the thread, in order of first record
+    long long InputBytes = -1;  // memory of the inputs, -1 when not measured
+    long long OutputBytes = -1; // memory of the outputs, -1 when not measured
+    vtkIdType ForCalls = 0;     // vtkSMPTools::For() calls from the thread
+    vtkIdType HeapAllocations = 0;  // see vtkScratchArena::Statistics
+    vtkIdType ArenaAllocations = 0; // see vtkScratchArena::Statistics
+    bool Success = true;            // result of the request
+  };
+
+  /**
+   * Return the number of passes recorded.
+   */
+  vtkIdType GetNumberOfRecords();
+
+  /**
+   * Return a copy of the records, in the order the passes ended.
+   */
+  VTK_WRAPEXCLUDE std::vector<Record> GetRecords();
+
+  /**
+   * Remove the records and restart the clock.
+   */
+  void Clear();
+
+  ///@{
+  /**
+   * Write the records in the Chrome trace event format, as complete events
+   * named after the class of the algorithm and the pass. The file version
+   * returns false if the file cannot be written.
+   */
+  bool WriteChromeTrace(const char* fileName);
+  void WriteChromeTrace(ostream& os);
+  ///@}
+
+  /**
+   * Print, for each algorithm, the number of executions and the time spent
+   * in each pass, the algorithms spending the most time first.
+   */
+  void PrintSummary(ostream& os);
+
+  /**
+   * State of a pass in progress, see StartPass().
+   */
+  struct Pass
+  {
+    vtkAlgorithm* Algorithm = nullptr;
+    const char* Name = nullptr;
+    double Start = 0.0;
+    long long InputBytes = -1;
+    vtkIdType ForCalls = 0;
+    vtkIdType HeapAllocations = 0;
+    vtkIdType ArenaAllocations = 0;
+  };
+
+  ///@{
+  /**
+   * Methods called by vtkExecutive around each request made to its algorithm.
+   */
+  VTK_WRAPEXCLUDE void StartPass(
+    Pass& pass, vtkAlgorithm* algorithm, vtkInformation* request, vtkInformationVector** inInfo);
+  VTK_WRAPEXCLUDE void EndPass(Pass& pass, vtkInformationVector* outInfo, int result);
+  ///@}
+
+protected:
+  vtkPipelineProfiler();
+  ~vtkPipelineProfiler() override;
+
+  bool MeasureDataSizes = true;
+
+private:
+  vtkPipelineProfiler(const vtkPipelineProfiler&) = delete;
+  void operator=(const vtkPipelineProfiler&) = delete;
+
+  static vtkPipelineProfiler* GlobalProfiler;
+
+  struct Internals;
+  std::unique_ptr<Internals> Internal;
+};
+
+VTK_ABI_NAMESPACE_END
+#endif
@@ -27,6 +27,7 @@
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkSmartPointer.h"
+#include "vtkTimeStepPrefetcher.h"
 
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkStreamingDemandDrivenPipeline);
@@ -886,6 +887,31 @@ int vtkStreamingDemandDrivenPipeline ::VerifyOutputInformation(
   return 1;
 }
 
+//------------------------------------------------------------------------------
+int vtkStreamingDemandDrivenPipeline::ExecuteData(
+  vtkInformation* request, vtkInformationVector** inInfoVec, vtkInformationVector* outInfoVec)
+{
+  vtkTimeStepPrefetcher* prefetcher = vtkTimeStepPrefetcher::GetPrefetcher(this->Algorithm);
+  if (!prefetcher)
+  {
+    return this->Superclass::ExecuteData(request, inInfoVec, outInfoVec);
+  }
+
+  // Execute the algorithm only if the requested time step was not prefetched.
+  int result = 1;
+  this->ExecuteDataStart(request, inInfoVec, outInfoVec);
+  if (!prefetcher->HandOver(request, outInfoVec))
+  {
+    result = this->CallAlgorithm(request, vtkExecutive::RequestDownstream, inInfoVec, outInfoVec);
+  }
+  this->ExecuteDataEnd(request, inInfoVec, outInfoVec);
+  if (result)
+  {
+    prefetcher->Prefetch(request, outInfoVec);
+  }
+  return result;
+}
+
 //------------------------------------------------------------------------------
 void vtkStreamingDemandDrivenPipeline ::ExecuteDataStart(
   vtkInformation* request, vtkInformationVector** inInfoVec, vtkInformationVector* outInfoVec)
@@ -315,6 +315,11 @@ protected:
   int NeedToExecuteData(
     int outputPort, vtkInformationVector** inInfoVec, vtkInformationVector* outInfoVec) override;
 
+  // Override this to hand the data prefetched by a vtkTimeStepPrefetcher
+  // over to the outputs.
+  int ExecuteData(vtkInformation* request, vtkInformationVector** inInfoVec,
+    vtkInformationVector* outInfoVec) override;
+
   // Override these to handle the continue-executing option.
   void ExecuteDataStart(vtkInformation* request, vtkInformationVector** inInfoVec,
     vtkInformationVector* outInfoVec) override;
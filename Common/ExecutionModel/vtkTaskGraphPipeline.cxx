@@ -0,0 +1,629 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "vtkTaskGraphPipeline.h"
+
+#include "vtkAlgorithm.h"
+#include "vtkCompositeDataIterator.h"
+#include "vtkCompositeDataSet.h"
+#include "vtkDataArray.h"
+#include "vtkDataObject.h"
+#include "vtkDataSet.h"
+#include "vtkCellData.h"
+#include "vtkDataSetAttributes.h"
+#include "vtkGenericCell.h"
+#include "vtkInformation.h"
+#include "vtkInformationExecutivePortKey.h"
+#include "vtkInformationIntegerKey.h"
+#include "vtkInformationVector.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPipelineMemoryBudget.h"
+#include "vtkPointData.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+VTK_ABI_NAMESPACE_BEGIN
+vtkStandardNewMacro(vtkTaskGraphPipeline);
+
+vtkInformationKeyMacro(vtkTaskGraphPipeline, EXECUTE_ALONE, Integer);
+vtkInformationKeyMacro(vtkTaskGraphPipeline, INPUTS_UP_TO_DATE, Integer);
+
+namespace
+{
+// Number of task graphs executing on the calling thread. Pipelines updated
+// from within an algorithm executed by a task graph are updated sequentially.
+VTK_THREAD_LOCAL int TaskGraphDepth = 0;
+
+struct TaskGraphScope
+{
+  TaskGraphScope() { ++TaskGraphDepth; }
+  ~TaskGraphScope() { --TaskGraphDepth; }
+  TaskGraphScope(const TaskGraphScope&) = delete;
+  void operator=(const TaskGraphScope&) = delete;
+};
+
+//------------------------------------------------------------------------------
+// Build the state that data sets compute on first access, so that it is only
+// read by the algorithms reading the data object at the same time.
+void PrepareAttributes(vtkDataSetAttributes* attributes)
+{
+  for (int i = 0; i < attributes->GetNumberOfArrays(); ++i)
+  {
+    vtkDataArray* array = attributes->GetArray(i);
+    if (!array)
+    {
+      continue;
+    }
+    double range[2];
+    int numberOfComponents = array->GetNumberOfComponents();
+    for (int component = 0; component < numberOfComponents; ++component)
+    {
+      array->GetRange(range, component);
+    }
+    if (numberOfComponents > 1)
+    {
+      array->GetRange(range, -1);
+    }
+  }
+}
+
+void PrepareForConcurrentReads(vtkDataObject* dataObject)
+{
+  if (auto composite = vtkCompositeDataSet::SafeDownCast(dataObject))
+  {
+    vtkSmartPointer<vtkCompositeDataIterator> iter;
+    iter.TakeReference(composite->NewIterator());
+    for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+    {
+      PrepareForConcurrentReads(iter->GetCurrentDataObject());
+    }
+  }
+  else if (auto dataSet = vtkDataSet::SafeDownCast(dataObject))
+  {
+    double bounds[6];
+    dataSet->GetBounds(bounds);
+    if (dataSet->GetNumberOfCells() > 0)
+    {
+      // Builds the cells of polydata.
+      vtkNew<vtkGenericCell> cell;
+      dataSet->GetCell(0, cell);
+    }
+    PrepareAttributes(dataSet->GetPointData());
+    PrepareAttributes(dataSet->GetCellData());
+  }
+}
+}
+
+//------------------------------------------------------------------------------
+// Graph of the algorithms to execute, where each algorithm executes once its
+// producers did. Independent algorithms are executed by waves of SMP tasks:
+// a task continues with the consumers it made ready, and hands over the
+// others to the next wave or, when nested parallelism is enabled, to a nested
+// SMP loop.
+class vtkTaskGraphPipelineScheduler
+{
+public:
+  // Add the producers of the inputs of a consumer which is not part of the
+  // graph. Return false if they cannot be executed by a task graph.
+  bool AddInputs(vtkTaskGraphPipeline* consumer) { return this->AddInputs(nullptr, consumer); }
+
+  // Add an algorithm to update through the given port.
+  bool AddOutput(vtkTaskGraphPipeline* executive, int port)
+  {
+    return this->AddProducer(nullptr, executive, port);
+  }
+
+  // Return false if the graph is empty or cannot execute concurrently.
+  bool CanExecute();
+
+  // Execute the graph: each algorithm receives a copy of the request.
+  int Execute(vtkInformation* request);
+
+private:
+  struct Node
+  {
+    vtkTaskGraphPipeline* Executive = nullptr;
+    // Output ports requested by the consumers, which the algorithm is
+    // executed for.
+    std::vector<int> Ports;
+    std::vector<Node*> Consumers;
+    int NumberOfProducers = 0;
+    bool Alone = false;
+    // Output ports read by several algorithms of the graph.
+    std::vector<int> SharedPorts;
+    // Held while the algorithm executes, when it shares an input with other
+    // algorithms which must not execute at the same time.
+    std::vector<std::mutex*> Locks;
+    vtkNew<vtkInformation> Request;
+    std::atomic<int> PendingProducers{ 0 };
+    std::atomic<bool> InputFailed{ false };
+  };
+
+  using OutputId = std::pair<vtkExecutive*, int>;
+
+  bool AddInputs(Node* node, vtkTaskGraphPipeline* executive);
+  bool AddProducer(Node* consumer, vtkExecutive* producer, int port);
+  static void AddEdge(Node* producer, Node* consumer);
+  static bool IteratesOver(Node* consumer, vtkExecutive* producer, int port);
+  void SerializeReaders(const OutputId& output, const std::vector<Node*>& readers);
+  static bool ExecuteNode(Node* node);
+  void Run(Node* node);
+  void RunAll(const std::vector<Node*>& nodes);
+
+  std::map<vtkExecutive*, std::unique_ptr<Node>> Nodes;
+  std::vector<Node*> Order;
+  // Algorithms of the graph reading the output of an algorithm which does not
+  // execute, in case another output of the same algorithm has to.
+  std::map<vtkExecutive*, std::vector<Node*>> UpToDateReaders;
+  // Number of algorithms reading an output, and the ones executed by the
+  // graph.
+  std::map<OutputId, int> Readers;
+  std::map<OutputId, std::vector<Node*>> GraphReaders;
+  std::map<OutputId, std::unique_ptr<std::mutex>> ReaderLocks;
+
+  std::mutex Mutex;
+  std::vector<Node*> Ready;
+  std::vector<Node*> Parked;
+  std::atomic<bool> Success{ true };
+};
+
+//------------------------------------------------------------------------------
+bool vtkTaskGraphPipelineScheduler::AddInputs(Node* node, vtkTaskGraphPipeline* executive)
+{
+  vtkAlgorithm* algorithm = executive->GetAlgorithm();
+  for (int i = 0; i < executive->GetNumberOfInputPorts(); ++i)
+  {
+    int nic = algorithm->GetNumberOfInputConnections(i);
+    vtkInformationVector* inVector = executive->GetInputInformation()[i];
+    for (int j = 0; j < nic; ++j)
+    {
+      vtkInformation* info = inVector->GetInformationObject(j);
+      vtkExecutive* e;
+      int producerPort;
+      vtkExecutive::PRODUCER()->Get(info, e, producerPort);
+      if (e && !this->AddProducer(node, e, producerPort))
+      {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool vtkTaskGraphPipelineScheduler::AddProducer(Node* consumer, vtkExecutive* producer, int port)
+{
+  auto executive = vtkTaskGraphPipeline::SafeDownCast(producer);
+  if (!executive || !executive->ConcurrentExecution || executive->SharedInputInformation)
+  {
+    return false;
+  }
+
+  ++this->Readers[OutputId(executive, port)];
+  if (consumer)
+  {
+    this->GraphReaders[OutputId(executive, port)].push_back(consumer);
+  }
+
+  auto found = this->Nodes.find(executive);
+  Node* node = found != this->Nodes.end() ? found->second.get() : nullptr;
+  bool needed = executive->NeedToExecuteData(
+    port, executive->GetInputInformation(), executive->GetOutputInformation());
+  if (node)
+  {
+    if (needed && std::find(node->Ports.begin(), node->Ports.end(), port) == node->Ports.end())
+    {
+      node->Ports.push_back(port);
+    }
+    AddEdge(node, consumer);
+    return true;
+  }
+  if (!needed)
+  {
+    if (consumer)
+    {
+      this->UpToDateReaders[executive].push_back(consumer);
+    }
+    return true;
+  }
+
+  auto& created = this->Nodes[executive];
+  created.reset(new Node);
+  node = created.get();
+  node->Executive = executive;
+  node->Ports.push_back(port);
+  node->Alone = executive->GetAlgorithm()->GetInformation()->Get(
+                  vtkTaskGraphPipeline::EXECUTE_ALONE()) != 0;
+  AddEdge(node, consumer);
+
+  // The algorithms which read another output of this algorithm, thought to
+  // be up to date, have to wait for it as well.
+  auto readers = this->UpToDateReaders.find(executive);
+  if (readers != this->UpToDateReaders.end())
+  {
+    for (Node* reader : readers->second)
+    {
+      AddEdge(node, reader);
+    }
+    this->UpToDateReaders.erase(readers);
+  }
+
+  if (!this->AddInputs(node, executive))
+  {
+    return false;
+  }
+  // Producers come before their consumers.
+  this->Order.push_back(node);
+  return true;
+}
+
+//------------------------------------------------------------------------------
+void vtkTaskGraphPipelineScheduler::AddEdge(Node* producer, Node* consumer)
+{
+  if (consumer &&
+    std::find(producer->Consumers.begin(), producer->Consumers.end(), consumer) ==
+      producer->Consumers.end())
+  {
+    producer->Consumers.push_back(consumer);
+    ++consumer->NumberOfProducers;
+  }
+}
+
+//------------------------------------------------------------------------------
+bool vtkTaskGraphPipelineScheduler::IteratesOver(Node* consumer, vtkExecutive* producer, int port)
+{
+  vtkTaskGraphPipeline* executive = consumer->Executive;
+  int compositePort;
+  return executive->ShouldIterateOverInput(executive->GetInputInformation(), compositePort) &&
+    executive->GetInputInformation()[compositePort]->GetInformationObject(0) ==
+    producer->GetOutputInformation(port);
+}
+
+//------------------------------------------------------------------------------
+void vtkTaskGraphPipelineScheduler::SerializeReaders(
+  const OutputId& output, const std::vector<Node*>& readers)
+{
+  // An algorithm iterating over the blocks of a composite input sets each
+  // block in turn in the input information, which is the output information
+  // of the producer: the other algorithms reading this output must not
+  // execute meanwhile.
+  if (!vtkCompositeDataSet::SafeDownCast(output.first->GetOutputData(output.second)) ||
+    std::none_of(readers.begin(), readers.end(),
+      [&output](Node* reader) { return IteratesOver(reader, output.first, output.second); }))
+  {
+    return;
+  }
+  auto& lock = this->ReaderLocks[output];
+  lock.reset(new std::mutex);
+  for (Node* reader : readers)
+  {
+    if (std::find(reader->Locks.begin(), reader->Locks.end(), lock.get()) == reader->Locks.end())
+    {
+      reader->Locks.push_back(lock.get());
+      // Always acquired in the same order.
+      std::sort(reader->Locks.begin(), reader->Locks.end());
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+bool vtkTaskGraphPipelineScheduler::CanExecute()
+{
+  if (this->Order.empty())
+  {
+    return false;
+  }
+  for (const auto& reader : this->Readers)
+  {
+    vtkExecutive* executive = reader.first.first;
+    int port = reader.first.second;
+    // A released output cannot be read by several algorithms at once.
+    if (reader.second > 1 && port >= 0 &&
+      static_cast<vtkTaskGraphPipeline*>(executive)->GetReleaseDataFlag(port))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+int vtkTaskGraphPipelineScheduler::Execute(vtkInformation* request)
+{
+  TaskGraphScope scope;
+
+  for (const auto& reader : this->GraphReaders)
+  {
+    if (reader.second.size() < 2 || reader.first.second < 0)
+    {
+      continue;
+    }
+    this->SerializeReaders(reader.first, reader.second);
+    vtkExecutive* executive = reader.first.first;
+    auto found = this->Nodes.find(executive);
+    if (found != this->Nodes.end())
+    {
+      found->second->SharedPorts.push_back(reader.first.second);
+    }
+    else
+    {
+      PrepareForConcurrentReads(executive->GetOutputData(reader.first.second));
+    }
+  }
+
+  std::vector<Node*> wave;
+  for (Node* node : this->Order)
+  {
+    node->Request->Copy(request, 1);
+    node->Request->Set(vtkTaskGraphPipeline::INPUTS_UP_TO_DATE(), 1);
+    node->PendingProducers = node->NumberOfProducers;
+    if (node->NumberOfProducers == 0)
+    {
+      (node->Alone ? this->Parked : wave).push_back(node);
+    }
+  }
+
+  for (;;)
+  {
+    if (wave.empty())
+    {
+      Node* alone = nullptr;
+      {
+        std::lock_guard<std::mutex> lock(this->Mutex);
+        std::swap(wave, this->Ready);
+        if (wave.empty() && !this->Parked.empty())
+        {
+          alone = this->Parked.back();
+          this->Parked.pop_back();
+        }
+      }
+      if (alone)
+      {
+        // Nothing else executes at this point.
+        this->Run(alone);
+        continue;
+      }
+      if (wave.empty())
+      {
+        break;
+      }
+    }
+    this->RunAll(wave);
+    wave.clear();
+  }
+
+  return this->Success ? 1 : 0;
+}
+
+//------------------------------------------------------------------------------
+void vtkTaskGraphPipelineScheduler::RunAll(const std::vector<Node*>& nodes)
+{
+  if (nodes.size() == 1)
+  {
+    this->Run(nodes[0]);
+    return;
+  }
+  vtkSMPTools::For(0, static_cast<vtkIdType>(nodes.size()), 1,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType i = begin; i < end; ++i)
+      {
+        this->Run(nodes[i]);
+      }
+    });
+}
+
+//------------------------------------------------------------------------------
+void vtkTaskGraphPipelineScheduler::Run(Node* node)
+{
+  TaskGraphScope scope;
+  while (node)
+  {
+    bool success = !node->InputFailed && ExecuteNode(node);
+    if (!success)
+    {
+      this->Success = false;
+    }
+    else
+    {
+      for (int port : node->SharedPorts)
+      {
+        PrepareForConcurrentReads(node->Executive->GetOutputData(port));
+      }
+    }
+
+    std::vector<Node*> ready;
+    Node* next = nullptr;
+    for (Node* consumer : node->Consumers)
+    {
+      if (!success)
+      {
+        consumer->InputFailed = true;
+      }
+      if (--consumer->PendingProducers == 0)
+      {
+        if (consumer->Alone)
+        {
+          std::lock_guard<std::mutex> lock(this->Mutex);
+          this->Parked.push_back(consumer);
+        }
+        else if (!next)
+        {
+          next = consumer;
+        }
+        else
+        {
+          ready.push_back(consumer);
+        }
+      }
+    }
+    if (!ready.empty())
+    {
+      if (vtkSMPTools::GetNestedParallelism())
+      {
+        ready.push_back(next);
+        next = nullptr;
+        this->RunAll(ready);
+      }
+      else
+      {
+        std::lock_guard<std::mutex> lock(this->Mutex);
+        this->Ready.insert(this->Ready.end(), ready.begin(), ready.end());
+      }
+    }
+    node = next;
+  }
+}
+
+//------------------------------------------------------------------------------
+bool vtkTaskGraphPipelineScheduler::ExecuteNode(Node* node)
+{
+  vtkTaskGraphPipeline* executive = node->Executive;
+  std::vector<std::unique_lock<std::mutex>> locks;
+  for (std::mutex* lock : node->Locks)
+  {
+    locks.emplace_back(*lock);
+  }
+  bool success = true;
+  for (int port : node->Ports)
+  {
+    node->Request->Set(vtkExecutive::FROM_OUTPUT_PORT(), port);
+    if (!executive->ProcessRequest(
+          node->Request, executive->GetInputInformation(), executive->GetOutputInformation()))
+    {
+      success = false;
+    }
+  }
+  return success;
+}
+
+//------------------------------------------------------------------------------
+vtkTaskGraphPipeline::vtkTaskGraphPipeline() = default;
+
+//------------------------------------------------------------------------------
+vtkTaskGraphPipeline::~vtkTaskGraphPipeline() = default;
+
+//------------------------------------------------------------------------------
+int vtkTaskGraphPipeline::ForwardUpstream(vtkInformation* request)
+{
+  if (!request->Has(REQUEST_DATA()) || this->SharedInputInformation)
+  {
+    return this->Superclass::ForwardUpstream(request);
+  }
+
+  if (request->Get(INPUTS_UP_TO_DATE()))
+  {
+    // The task graph executing this algorithm executed its inputs before.
+    return this->Algorithm->ModifyRequest(request, BeforeForward) &&
+      this->Algorithm->ModifyRequest(request, AfterForward);
+  }
+
+  vtkTaskGraphPipelineScheduler scheduler;
+  if (!this->ConcurrentExecution || TaskGraphDepth > 0 || !scheduler.AddInputs(this) ||
+    !scheduler.CanExecute())
+  {
+    return this->Superclass::ForwardUpstream(request);
+  }
+
+  if (!this->Algorithm->ModifyRequest(request, BeforeForward))
+  {
+    return 0;
+  }
+  int result = scheduler.Execute(request);
+  if (!this->Algorithm->ModifyRequest(request, AfterForward))
+  {
+    return 0;
+  }
+  return result;
+}
+
+//------------------------------------------------------------------------------
+bool vtkTaskGraphPipeline::UpdateConcurrently(const std::vector<vtkAlgorithm*>& algorithms)
+{
+  bool success = true;
+  std::vector<std::pair<vtkTaskGraphPipeline*, int>> outputs;
+  for (vtkAlgorithm* algorithm : algorithms)
+  {
+    auto executive = vtkTaskGraphPipeline::SafeDownCast(algorithm->GetExecutive());
+    if (!executive || !executive->ConcurrentExecution || TaskGraphDepth > 0)
+    {
+      algorithm->Update();
+      continue;
+    }
+    // Same passes as vtkStreamingDemandDrivenPipeline::Update() before the
+    // data is requested.
+    int port = algorithm->GetNumberOfOutputPorts() > 0 ? 0 : -1;
+    if (!executive->UpdateInformation())
+    {
+      success = false;
+      continue;
+    }
+    executive->PropagateTime(port);
+    executive->UpdateTimeDependentInformation(port);
+    if (!executive->PropagateUpdateExtent(port))
+    {
+      success = false;
+      continue;
+    }
+    if (!executive->LastPropogateUpdateExtentShortCircuited)
+    {
+      outputs.emplace_back(executive, port);
+    }
+  }
+
+  vtkTaskGraphPipelineScheduler scheduler;
+  bool concurrent = true;
+  for (const auto& output : outputs)
+  {
+    concurrent = concurrent && scheduler.AddOutput(output.first, output.second);
+  }
+
+  if (concurrent && scheduler.CanExecute())
+  {
+    vtkNew<vtkInformation> request;
+    request->Set(REQUEST_DATA());
+    request->Set(vtkExecutive::FORWARD_DIRECTION(), vtkExecutive::RequestUpstream);
+    request->Set(vtkExecutive::ALGORITHM_AFTER_FORWARD(), 1);
+    vtkSmartPointer<vtkPipelineMemoryBudget> budget = vtkPipelineMemoryBudget::GetGlobalBudget();
+    if (budget)
+    {
+      budget->UpdateStarted();
+    }
+    int result = scheduler.Execute(request);
+    if (budget)
+    {
+      // The updated outputs are evicted last.
+      for (const auto& output : outputs)
+      {
+        budget->OutputUsed(output.first, output.second);
+      }
+      budget->UpdateFinished(nullptr);
+    }
+    return result && success;
+  }
+  for (const auto& output : outputs)
+  {
+    if (!output.first->UpdateData(output.second))
+    {
+      success = false;
+    }
+  }
+  return success;
+}
+
+//------------------------------------------------------------------------------
+void vtkTaskGraphPipeline::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "ConcurrentExecution: " << (this->ConcurrentExecution ? "On" : "Off") << endl;
+}
+VTK_ABI_NAMESPACE_END
@@ -0,0 +1,110 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class   vtkTaskGraphPipeline
+ * @brief   Executive that executes independent branches concurrently
+ *
+ * vtkTaskGraphPipeline is a vtkCompositeDataPipeline which, instead of
+ * updating the inputs of an algorithm one after another, gathers the
+ * algorithms upstream that need to execute in a graph of tasks and executes
+ * the independent ones concurrently using the SMP framework. For example,
+ * when a reader feeds four filters whose outputs are appended, the four
+ * filters execute at the same time once the reader is done. Each algorithm
+ * still executes once, after all of its inputs are up to date.
+ *
+ * Concurrent execution only applies to the REQUEST_DATA pass, when all the
+ * algorithms upstream use a vtkTaskGraphPipeline, which is easiest done with
+ * vtkAlgorithm::SetDefaultExecutivePrototype(). Otherwise, or if an output
+ * read by several algorithms is released after use, the executive forwards
+ * the request sequentially like its superclass.
+ *
+ * The algorithms of different branches must not share state other than their
+ * inputs. A data object read by several algorithms executing at the same time
+ * first gets its lazily computed state (bounds, cells, array ranges) built by
+ * the executive, so that these reads do not race. The algorithms reading a
+ * composite data object execute one after another if one of them iterates
+ * over its blocks, since the executive of this algorithm sets each block in
+ * turn in the information of the shared output. Algorithms which cannot
+ * execute concurrently with others, for example readers relying on a library
+ * which is not thread safe, or algorithms which update their upstream pipeline
+ * themselves, must set the EXECUTE_ALONE() key in their information. They then
+ * execute while no other algorithm of the graph does.
+ *
+ * Observers of the algorithms, e.g. of their progress events, are invoked
+ * from the thread executing the algorithm.
+ *
+ * @sa
+ * vtkCompositeDataPipeline vtkThreadedCompositeDataPipeline vtkSMPTools
+ */
+
+#ifndef vtkTaskGraphPipeline_h
+#define vtkTaskGraphPipeline_h
+
+#include "vtkCommonExecutionModelModule.h" // For export macro
+#include "vtkCompositeDataPipeline.h"
+
+#include <vector> // For UpdateConcurrently
+
+VTK_ABI_NAMESPACE_BEGIN
+class vtkAlgorithm;
+class vtkInformationIntegerKey;
+
+class VTKCOMMONEXECUTIONMODEL_EXPORT vtkTaskGraphPipeline : public vtkCompositeDataPipeline
+{
+public:
+  static vtkTaskGraphPipeline* New();
+  vtkTypeMacro(vtkTaskGraphPipeline, vtkCompositeDataPipeline);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  ///@{
+  /**
+   * Enable or disable the concurrent execution of the branches upstream of
+   * this executive. When disabled, the executive behaves like
+   * vtkCompositeDataPipeline. Default is on.
+   */
+  vtkSetMacro(ConcurrentExecution, bool);
+  vtkGetMacro(ConcurrentExecution, bool);
+  vtkBooleanMacro(ConcurrentExecution, bool);
+  ///@}
+
+  /**
+   * Update several algorithms at once: their pipelines are executed as a
+   * single graph of tasks, so that the algorithms themselves and their
+   * independent upstream branches execute concurrently. The algorithms must
+   * request the same pieces and time steps from the algorithms they share.
+   * Algorithms whose executive is not a vtkTaskGraphPipeline are updated one
+   * after another. Return false if an update failed.
+   */
+  VTK_WRAPEXCLUDE static bool UpdateConcurrently(const std::vector<vtkAlgorithm*>& algorithms);
+
+  /**
+   * Key set to 1 in the information of an algorithm (vtkAlgorithm::GetInformation())
+   * which must not execute while another algorithm of the graph executes.
+   * vtkMultiTimeStepAlgorithm, vtkTemporalAlgorithm and vtkEndFor set it,
+   * since they execute their upstream pipeline again while they execute.
+   * \ingroup InformationKeys
+   */
+  static vtkInformationIntegerKey* EXECUTE_ALONE();
+
+protected:
+  vtkTaskGraphPipeline();
+  ~vtkTaskGraphPipeline() override;
+
+  int ForwardUpstream(vtkInformation* request) override;
+  using Superclass::ForwardUpstream;
+
+  bool ConcurrentExecution = true;
+
+private:
+  vtkTaskGraphPipeline(const vtkTaskGraphPipeline&) = delete;
+  void operator=(const vtkTaskGraphPipeline&) = delete;
+
+  // Set in the requests of the algorithms executed by a task graph, whose
+  // inputs were brought up to date before.
+  static vtkInformationIntegerKey* INPUTS_UP_TO_DATE();
+
+  friend class vtkTaskGraphPipelineScheduler;
+};
+
+VTK_ABI_NAMESPACE_END
+#endif
@@ -6,8 +6,10 @@
 #include "vtkDoubleArray.h"
 #include "vtkFieldData.h"
 #include "vtkInformation.h"
+#include "vtkInformationIntegerKey.h"
 #include "vtkInformationVector.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkTaskGraphPipeline.h"
 
 //=============================================================================
 VTK_ABI_NAMESPACE_BEGIN
@@ -44,6 +46,8 @@ template <class AlgorithmT>
 vtkTemporalAlgorithm<AlgorithmT>::vtkTemporalAlgorithm()
 {
   this->ProcessedTimeSteps->SetName(this->TimeStepsArrayName());
+  // The input is updated again for each time step.
+  this->GetInformation()->Set(vtkTaskGraphPipeline::EXECUTE_ALONE(), 1);
 }
 
 //------------------------------------------------------------------------------
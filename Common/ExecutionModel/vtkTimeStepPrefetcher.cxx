@@ -0,0 +1,606 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "vtkTimeStepPrefetcher.h"
+
+#include "vtkAlgorithm.h"
+#include "vtkCallbackCommand.h"
+#include "vtkCommand.h"
+#include "vtkDataObject.h"
+#include "vtkDemandDrivenPipeline.h"
+#include "vtkExecutive.h"
+#include "vtkInformation.h"
+#include "vtkInformationObjectBaseKey.h"
+#include "vtkInformationVector.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkSmartPointer.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <list>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+VTK_ABI_NAMESPACE_BEGIN
+vtkStandardNewMacro(vtkTimeStepPrefetcher);
+
+vtkInformationKeyMacro(vtkTimeStepPrefetcher, PREFETCHER, ObjectBase);
+
+//------------------------------------------------------------------------------
+struct vtkTimeStepPrefetcher::Internals
+{
+  enum class State
+  {
+    Scheduled,
+    Running,
+    Done,
+    Failed
+  };
+
+  // A time step to prefetch. The jobs are only created and destroyed on the
+  // thread updating the pipeline, the background thread only executes them.
+  struct Job
+  {
+    double Time;
+    vtkSmartPointer<vtkInformationVector> Outputs;
+    State Status = State::Scheduled;
+    bool Dropped = false;
+    unsigned long Size = 0;
+  };
+  using JobIterator = std::list<Job>::iterator;
+
+  // What the prefetched data depends on, besides the time.
+  struct Signature
+  {
+    vtkMTimeType AlgorithmTime = 0;
+    int Piece = 0;
+    int NumberOfPieces = 1;
+    int GhostLevel = 0;
+    std::vector<int> Extent;
+
+    bool operator==(const Signature& other) const
+    {
+      return this->AlgorithmTime == other.AlgorithmTime && this->Piece == other.Piece &&
+        this->NumberOfPieces == other.NumberOfPieces && this->GhostLevel == other.GhostLevel &&
+        this->Extent == other.Extent;
+    }
+  };
+
+  static Signature GetSignature(vtkAlgorithm* algorithm, vtkInformation* outInfo)
+  {
+    using SDDP = vtkStreamingDemandDrivenPipeline;
+    Signature signature;
+    signature.AlgorithmTime = algorithm->GetMTime();
+    signature.Piece = outInfo->Get(SDDP::UPDATE_PIECE_NUMBER());
+    signature.NumberOfPieces = outInfo->Get(SDDP::UPDATE_NUMBER_OF_PIECES());
+    signature.GhostLevel = outInfo->Get(SDDP::UPDATE_NUMBER_OF_GHOST_LEVELS());
+    if (int* extent = outInfo->Get(SDDP::UPDATE_EXTENT()))
+    {
+      signature.Extent.assign(extent, extent + 6);
+    }
+    return signature;
+  }
+
+  static int GetOutputPort(vtkInformation* request)
+  {
+    int port = request->Has(vtkExecutive::FROM_OUTPUT_PORT())
+      ? request->Get(vtkExecutive::FROM_OUTPUT_PORT())
+      : 0;
+    return port >= 0 ? port : 0;
+  }
+
+  JobIterator Find(double time)
+  {
+    return std::find_if(this->Jobs.begin(), this->Jobs.end(),
+      [time](const Job& job) { return !job.Dropped && job.Time == time; });
+  }
+
+  JobIterator NextScheduled()
+  {
+    return std::find_if(this->Jobs.begin(), this->Jobs.end(),
+      [](const Job& job) { return !job.Dropped && job.Status == State::Scheduled; });
+  }
+
+  bool CanRun() { return this->Budget == 0 || this->Occupancy < this->Budget; }
+
+  // Drop a job. A running one is erased by the next call to Erase() after it
+  // completes.
+  void Drop(JobIterator job)
+  {
+    if (job->Status == State::Done)
+    {
+      this->Occupancy -= job->Size;
+    }
+    job->Dropped = true;
+  }
+
+  bool DropAll()
+  {
+    bool dropped = false;
+    for (auto job = this->Jobs.begin(); job != this->Jobs.end(); ++job)
+    {
+      if (!job->Dropped)
+      {
+        this->Drop(job);
+        dropped = true;
+      }
+    }
+    return dropped;
+  }
+
+  // Remove the dropped jobs which are not running, which releases their data.
+  void Erase()
+  {
+    this->Jobs.remove_if(
+      [](const Job& job) { return job.Dropped && job.Status != State::Running; });
+  }
+
+  void Run(vtkTimeStepPrefetcher* self);
+
+  vtkAlgorithm* Algorithm = nullptr;
+  unsigned long ObserverTag = 0;
+
+  // Guards the members below.
+  std::mutex Mutex;
+  std::condition_variable Condition;
+  std::list<Job> Jobs;
+  std::thread Thread;
+  bool Stop = false;
+  vtkNew<vtkInformation> Request;
+
+  Signature LastSignature;
+  bool HasLastTime = false;
+  double LastTime = 0.0;
+  int Direction = 1;
+
+  unsigned long Budget = 0;
+  unsigned long Occupancy = 0;
+  vtkIdType NumberOfPrefetchedTimeSteps = 0;
+  vtkIdType NumberOfHits = 0;
+  vtkIdType NumberOfMisses = 0;
+  vtkIdType NumberOfCancellations = 0;
+
+  // Serializes the requests made to the algorithm.
+  std::mutex AlgorithmMutex;
+};
+
+//------------------------------------------------------------------------------
+void vtkTimeStepPrefetcher::Internals::Run(vtkTimeStepPrefetcher* self)
+{
+  std::unique_lock<std::mutex> lock(this->Mutex);
+  while (true)
+  {
+    this->Condition.wait(lock, [this]
+      { return this->Stop || (this->NextScheduled() != this->Jobs.end() && this->CanRun()); });
+    if (this->Stop)
+    {
+      return;
+    }
+    JobIterator job = this->NextScheduled();
+    job->Status = State::Running;
+    vtkAlgorithm* algorithm = this->Algorithm;
+    lock.unlock();
+
+    int result;
+    {
+      std::lock_guard<std::mutex> algorithmLock(this->AlgorithmMutex);
+      vtkInformationVector** inputs = nullptr;
+      result = algorithm->ProcessRequest(this->Request.GetPointer(), inputs, job->Outputs.Get());
+    }
+    unsigned long size = 0;
+    for (int i = 0; result && i < job->Outputs->GetNumberOfInformationObjects(); ++i)
+    {
+      vtkInformation* outInfo = job->Outputs->GetInformationObject(i);
+      vtkDataObject* data = outInfo->Get(vtkDataObject::DATA_OBJECT());
+      if (!data->GetInformation()->Has(vtkDataObject::DATA_TIME_STEP()))
+      {
+        data->GetInformation()->Set(vtkDataObject::DATA_TIME_STEP(), job->Time);
+      }
+      size += data->GetActualMemorySize();
+    }
+
+    lock.lock();
+    job->Status = result ? State::Done : State::Failed;
+    job->Size = size;
+    if (result && !job->Dropped)
+    {
+      this->Occupancy += size;
+      ++this->NumberOfPrefetchedTimeSteps;
+    }
+    if (!result)
+    {
+      vtkDebugWithObjectMacro(
+        self, "Prefetching time " << job->Time << " of " << algorithm->GetObjectDescription()
+                                  << " failed.");
+    }
+    this->Condition.notify_all();
+  }
+}
+
+//------------------------------------------------------------------------------
+vtkTimeStepPrefetcher::vtkTimeStepPrefetcher()
+  : Internal(new Internals)
+{
+  this->Internal->Request->Set(vtkDemandDrivenPipeline::REQUEST_DATA());
+  this->Internal->Request->Set(vtkExecutive::FORWARD_DIRECTION(), vtkExecutive::RequestUpstream);
+  this->Internal->Request->Set(vtkExecutive::ALGORITHM_AFTER_FORWARD(), 1);
+  this->Internal->Request->Set(vtkExecutive::FROM_OUTPUT_PORT(), 0);
+}
+
+//------------------------------------------------------------------------------
+vtkTimeStepPrefetcher::~vtkTimeStepPrefetcher()
+{
+  this->Detach();
+}
+
+//------------------------------------------------------------------------------
+void vtkTimeStepPrefetcher::SetAlgorithm(vtkAlgorithm* algorithm)
+{
+  if (this->Internal->Algorithm == algorithm)
+  {
+    return;
+  }
+  if (algorithm && algorithm->GetNumberOfInputPorts() > 0)
+  {
+    vtkErrorMacro(<< algorithm->GetObjectDescription()
+                  << " has inputs, only the time steps of sources can be prefetched.");
+    return;
+  }
+
+  // The algorithm may hold the last reference to this object.
+  vtkSmartPointer<vtkTimeStepPrefetcher> self = this;
+  if (vtkAlgorithm* previous = this->Internal->Algorithm)
+  {
+    this->Detach();
+    previous->RemoveObserver(this->Internal->ObserverTag);
+    previous->GetInformation()->Remove(vtkTimeStepPrefetcher::PREFETCHER());
+    this->Internal->Algorithm = nullptr;
+  }
+  if (algorithm)
+  {
+    if (vtkTimeStepPrefetcher* other = vtkTimeStepPrefetcher::GetPrefetcher(algorithm))
+    {
+      other->SetAlgorithm(nullptr);
+    }
+    vtkNew<vtkCallbackCommand> observer;
+    observer->SetCallback(&vtkTimeStepPrefetcher::AlgorithmDeleted);
+    observer->SetClientData(this);
+    this->Internal->ObserverTag = algorithm->AddObserver(vtkCommand::DeleteEvent, observer);
+    algorithm->GetInformation()->Set(vtkTimeStepPrefetcher::PREFETCHER(), this);
+    this->Internal->Algorithm = algorithm;
+  }
+  this->Modified();
+}
+
+//------------------------------------------------------------------------------
+vtkAlgorithm* vtkTimeStepPrefetcher::GetAlgorithm()
+{
+  return this->Internal->Algorithm;
+}
+
+//------------------------------------------------------------------------------
+vtkTimeStepPrefetcher* vtkTimeStepPrefetcher::GetPrefetcher(vtkAlgorithm* algorithm)
+{
+  return algorithm ? vtkTimeStepPrefetcher::SafeDownCast(
+                       algorithm->GetInformation()->Get(vtkTimeStepPrefetcher::PREFETCHER()))
+                   : nullptr;
+}
+
+//------------------------------------------------------------------------------
+void vtkTimeStepPrefetcher::AlgorithmDeleted(vtkObject*, unsigned long, void* clientData, void*)
+{
+  // The algorithm is about to be destroyed, it must not be executing.
+  auto self = static_cast<vtkTimeStepPrefetcher*>(clientData);
+  self->Detach();
+  self->Internal->Algorithm = nullptr;
+}
+
+//------------------------------------------------------------------------------
+void vtkTimeStepPrefetcher::Detach()
+{
+  {
+    std::lock_guard<std::mutex> lock(this->Internal->Mutex);
+    this->Internal->Stop = true;
+  }
+  this->Internal->Condition.notify_all();
+  if (this->Internal->Thread.joinable())
+  {
+    this->Internal->Thread.join();
+  }
+  std::lock_guard<std::mutex> lock(this->Internal->Mutex);
+  this->Internal->Stop = false;
+  this->Internal->DropAll();
+  this->Internal->Erase();
+  this->Internal->HasLastTime = false;
+}
+
+//------------------------------------------------------------------------------
+void vtkTimeStepPrefetcher::SetBudget(unsigned long budget)
+{
+  {
+    std::lock_guard<std::mutex> lock(this->Internal->Mutex);
+    if (this->Internal->Budget == budget)
+    {
+      return;
+    }
+    this->Internal->Budget = budget;
+  }
+  this->Internal->Condition.notify_all();
+  this->Modified();
+}
+
+//------------------------------------------------------------------------------
+unsigned long vtkTimeStepPrefetcher::GetBudget()
+{
+  std::lock_guard<std::mutex> lock(this->Internal->Mutex);
+  return this->Internal->Budget;
+}
+
+//------------------------------------------------------------------------------
+unsigned long vtkTimeStepPrefetcher::GetOccupancy()
+{
+  std::lock_guard<std::mutex> lock(this->Internal->Mutex);
+  return this->Internal->Occupancy;
+}
+
+//------------------------------------------------------------------------------
+vtkIdType vtkTimeStepPrefetcher::GetNumberOfPrefetchedTimeSteps()
+{
+  std::lock_guard<std::mutex> lock(this->Internal->Mutex);
+  return this->Internal->NumberOfPrefetchedTimeSteps;
+}
+
+//------------------------------------------------------------------------------
+vtkIdType vtkTimeStepPrefetcher::GetNumberOfHits()
+{
+  std::lock_guard<std::mutex> lock(this->Internal->Mutex);
+  return this->Internal->NumberOfHits;
+}
+
+//------------------------------------------------------------------------------
+vtkIdType vtkTimeStepPrefetcher::GetNumberOfMisses()
+{
+  std::lock_guard<std::mutex> lock(this->Internal->Mutex);
+  return this->Internal->NumberOfMisses;
+}
+
+//------------------------------------------------------------------------------
+vtkIdType vtkTimeStepPrefetcher::GetNumberOfCancellations()
+{
+  std::lock_guard<std::mutex> lock(this->Internal->Mutex);
+  return this->Internal->NumberOfCancellations;
+}
+
+//------------------------------------------------------------------------------
+void vtkTimeStepPrefetcher::ResetCounters()
+{
+  std::lock_guard<std::mutex> lock(this->Internal->Mutex);
+  this->Internal->NumberOfPrefetchedTimeSteps = 0;
+  this->Internal->NumberOfHits = 0;
+  this->Internal->NumberOfMisses = 0;
+  this->Internal->NumberOfCancellations = 0;
+}
+
+//------------------------------------------------------------------------------
+void vtkTimeStepPrefetcher::Cancel()
+{
+  std::lock_guard<std::mutex> lock(this->Internal->Mutex);
+  if (this->Internal->DropAll())
+  {
+    ++this->Internal->NumberOfCancellations;
+  }
+  this->Internal->Erase();
+}
+
+//------------------------------------------------------------------------------
+void vtkTimeStepPrefetcher::Wait()
+{
+  std::unique_lock<std::mutex> lock(this->Internal->Mutex);
+  auto& internal = *this->Internal;
+  internal.Condition.wait(lock,
+    [&internal]
+    {
+      return std::none_of(internal.Jobs.begin(), internal.Jobs.end(),
+               [](const Internals::Job& job) { return job.Status == Internals::State::Running; }) &&
+        (internal.NextScheduled() == internal.Jobs.end() || !internal.CanRun() ||
+          !internal.Thread.joinable());
+    });
+  internal.Erase();
+}
+
+//------------------------------------------------------------------------------
+void vtkTimeStepPrefetcher::LockAlgorithm()
+{
+  this->Internal->AlgorithmMutex.lock();
+}
+
+//------------------------------------------------------------------------------
+void vtkTimeStepPrefetcher::UnlockAlgorithm()
+{
+  this->Internal->AlgorithmMutex.unlock();
+}
+
+//------------------------------------------------------------------------------
+bool vtkTimeStepPrefetcher::HandOver(vtkInformation* request, vtkInformationVector* outInfoVec)
+{
+  vtkInformation* outInfo = outInfoVec->GetInformationObject(Internals::GetOutputPort(request));
+  if (!this->Internal->Algorithm || !outInfo ||
+    !outInfo->Has(vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP()))
+  {
+    return false;
+  }
+  const double time = outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP());
+  Internals::Signature signature = Internals::GetSignature(this->Internal->Algorithm, outInfo);
+
+  std::unique_lock<std::mutex> lock(this->Internal->Mutex);
+  auto& internal = *this->Internal;
+  if (!(signature == internal.LastSignature))
+  {
+    // Prefetch() drops the time steps prefetched for another request.
+    ++internal.NumberOfMisses;
+    return false;
+  }
+  auto job = internal.Find(time);
+  if (job != internal.Jobs.end() && job->Status == Internals::State::Running)
+  {
+    // Reading it again would take longer.
+    internal.Condition.wait(lock, [&job] { return job->Status != Internals::State::Running; });
+  }
+  if (job == internal.Jobs.end() || job->Dropped || job->Status != Internals::State::Done ||
+    job->Outputs->GetNumberOfInformationObjects() != outInfoVec->GetNumberOfInformationObjects())
+  {
+    if (job != internal.Jobs.end())
+    {
+      internal.Drop(job);
+      internal.Erase();
+    }
+    ++internal.NumberOfMisses;
+    return false;
+  }
+
+  for (int i = 0; i < outInfoVec->GetNumberOfInformationObjects(); ++i)
+  {
+    vtkDataObject* output = outInfoVec->GetInformationObject(i)->Get(vtkDataObject::DATA_OBJECT());
+    vtkDataObject* data = job->Outputs->GetInformationObject(i)->Get(vtkDataObject::DATA_OBJECT());
+    if (output && data)
+    {
+      output->ShallowCopy(data);
+    }
+  }
+  internal.Drop(job);
+  internal.Erase();
+  ++internal.NumberOfHits;
+  lock.unlock();
+  internal.Condition.notify_all();
+  return true;
+}
+
+//------------------------------------------------------------------------------
+void vtkTimeStepPrefetcher::Prefetch(vtkInformation* request, vtkInformationVector* outInfoVec)
+{
+  using SDDP = vtkStreamingDemandDrivenPipeline;
+  vtkInformation* outInfo = outInfoVec->GetInformationObject(Internals::GetOutputPort(request));
+  if (!this->Internal->Algorithm || !outInfo || !outInfo->Has(SDDP::UPDATE_TIME_STEP()) ||
+    !outInfo->Has(SDDP::TIME_STEPS()))
+  {
+    return;
+  }
+  const double time = outInfo->Get(SDDP::UPDATE_TIME_STEP());
+  const double* timeSteps = outInfo->Get(SDDP::TIME_STEPS());
+  const int numberOfTimeSteps = outInfo->Length(SDDP::TIME_STEPS());
+  Internals::Signature signature = Internals::GetSignature(this->Internal->Algorithm, outInfo);
+
+  std::unique_lock<std::mutex> lock(this->Internal->Mutex);
+  auto& internal = *this->Internal;
+  bool cancel = false;
+  if (!(signature == internal.LastSignature))
+  {
+    cancel = true;
+    internal.LastSignature = signature;
+  }
+  if (internal.HasLastTime && time != internal.LastTime)
+  {
+    const int direction = time > internal.LastTime ? 1 : -1;
+    cancel = cancel || direction != internal.Direction;
+    internal.Direction = direction;
+  }
+  internal.HasLastTime = true;
+  internal.LastTime = time;
+  if (cancel && internal.DropAll())
+  {
+    ++internal.NumberOfCancellations;
+  }
+
+  // The time steps following the requested one, in the direction of the
+  // animation.
+  std::vector<double> window;
+  const double* end = timeSteps + numberOfTimeSteps;
+  if (internal.Direction > 0)
+  {
+    for (const double* step = std::upper_bound(timeSteps, end, time);
+         step != end && static_cast<int>(window.size()) < this->NumberOfTimeSteps; ++step)
+    {
+      window.push_back(*step);
+    }
+  }
+  else
+  {
+    for (const double* step = std::lower_bound(timeSteps, end, time);
+         step != timeSteps && static_cast<int>(window.size()) < this->NumberOfTimeSteps;)
+    {
+      window.push_back(*--step);
+    }
+  }
+
+  // Drop the time steps out of the window and schedule the missing ones, in
+  // order.
+  for (auto job = internal.Jobs.begin(); job != internal.Jobs.end(); ++job)
+  {
+    if (!job->Dropped && std::find(window.begin(), window.end(), job->Time) == window.end())
+    {
+      internal.Drop(job);
+    }
+  }
+  internal.Erase();
+  std::list<Internals::Job> jobs;
+  for (double step : window)
+  {
+    auto job = internal.Find(step);
+    if (job != internal.Jobs.end())
+    {
+      jobs.splice(jobs.end(), internal.Jobs, job);
+      continue;
+    }
+    jobs.push_back(Internals::Job{ step, vtkSmartPointer<vtkInformationVector>::New() });
+    // Only the keys describing the request are copied. The data objects
+    // are created here, so that they are released by this thread.
+    vtkInformationVector* outputs = jobs.back().Outputs;
+    for (int i = 0; i < outInfoVec->GetNumberOfInformationObjects(); ++i)
+    {
+      vtkInformation* from = outInfoVec->GetInformationObject(i);
+      vtkNew<vtkInformation> info;
+      info->CopyEntry(from, SDDP::TIME_STEPS());
+      info->CopyEntry(from, SDDP::TIME_RANGE());
+      info->CopyEntry(from, SDDP::WHOLE_EXTENT());
+      info->CopyEntry(from, SDDP::UPDATE_EXTENT());
+      info->CopyEntry(from, SDDP::UPDATE_PIECE_NUMBER());
+      info->CopyEntry(from, SDDP::UPDATE_NUMBER_OF_PIECES());
+      info->CopyEntry(from, SDDP::UPDATE_NUMBER_OF_GHOST_LEVELS());
+      info->Set(SDDP::UPDATE_TIME_STEP(), step);
+      if (vtkDataObject* data = from->Get(vtkDataObject::DATA_OBJECT()))
+      {
+        vtkSmartPointer<vtkDataObject> copy = vtk::TakeSmartPointer(data->NewInstance());
+        info->Set(vtkDataObject::DATA_OBJECT(), copy);
+      }
+      outputs->Append(info);
+    }
+  }
+  // The dropped running job, if any, stays until it completes.
+  internal.Jobs.splice(internal.Jobs.begin(), jobs);
+
+  if (!window.empty() && !internal.Thread.joinable())
+  {
+    internal.Thread = std::thread(&Internals::Run, this->Internal.get(), this);
+  }
+  lock.unlock();
+  internal.Condition.notify_all();
+}
+
+//------------------------------------------------------------------------------
+void vtkTimeStepPrefetcher::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "Algorithm: " << this->Internal->Algorithm << "\n";
+  os << indent << "NumberOfTimeSteps: " << this->NumberOfTimeSteps << "\n";
+  os << indent << "Budget: " << this->GetBudget() << " KiB\n";
+  os << indent << "Occupancy: " << this->GetOccupancy() << " KiB\n";
+  os << indent << "NumberOfPrefetchedTimeSteps: " << this->GetNumberOfPrefetchedTimeSteps()
+     << "\n";
+  os << indent << "NumberOfHits: " << this->GetNumberOfHits() << "\n";
+  os << indent << "NumberOfMisses: " << this->GetNumberOfMisses() << "\n";
+  os << indent << "NumberOfCancellations: " << this->GetNumberOfCancellations() << "\n";
+}
+VTK_ABI_NAMESPACE_END
@@ -0,0 +1,185 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class   vtkTimeStepPrefetcher
+ * @brief   Execute a time series source ahead of the requested time steps
+ *
+ * vtkTimeStepPrefetcher executes a source, typically a reader of a time
+ * series, for the time steps following the last requested one, on a
+ * background thread. When the pipeline then requests one of these time
+ * steps, the executive hands the prefetched data over to the output instead
+ * of executing the source, so an animation stepping through the time series
+ * does not wait for the reader.
+ *
+ * \code{.cpp}
+ * vtkNew<vtkTimeStepPrefetcher> prefetcher;
+ * prefetcher->SetNumberOfTimeSteps(2);
+ * prefetcher->SetBudget(1024 * 1024); // 1 GiB
+ * prefetcher->SetAlgorithm(reader);
+ * for (double time : timeSteps)
+ * {
+ *   reader->UpdateTimeStep(time);
+ *   renderWindow->Render();
+ * }
+ * \endcode
+ *
+ * After each execution for an UPDATE_TIME_STEP(), the next
+ * NumberOfTimeSteps values of TIME_STEPS() are scheduled in the direction of
+ * the animation, i.e. the previous ones when the requested times decrease.
+ * The prefetched data not in this window are dropped, so a change of
+ * direction or a jump cancels the prefetching, except for the time step
+ * being read which cannot be interrupted. A change of the source, of its
+ * modification time, or of the requested piece or extent, cancels it too.
+ *
+ * The prefetched data is kept until the memory it uses, as reported by
+ * vtkDataObject::GetActualMemorySize(), reaches the budget. Then no other
+ * time step is read until some of it is handed over. The budget may be
+ * exceeded by the size of one time step.
+ *
+ * The source must not have inputs, and must generate its outputs in the
+ * data objects of the output information given to RequestData(), as the
+ * pipeline expects. Its executions on the background thread never overlap
+ * those made by its executive, but they may overlap the calls made by the
+ * application: the source must not be modified while it is prefetching,
+ * call Cancel() then Wait() first. The progress events of the prefetching
+ * executions are invoked from the background thread. Place a
+ * vtkTemporalDataSetCache downstream to also keep the time steps already
+ * visited.
+ *
+ * @sa
+ * vtkStreamingDemandDrivenPipeline vtkTemporalDataSetCache
+ */
+
+#ifndef vtkTimeStepPrefetcher_h
+#define vtkTimeStepPrefetcher_h
+
+#include "vtkCommonExecutionModelModule.h" // For export macro
+#include "vtkObject.h"
+
+#include <memory> // For std::unique_ptr
+
+VTK_ABI_NAMESPACE_BEGIN
+class vtkAlgorithm;
+class vtkInformation;
+class vtkInformationObjectBaseKey;
+class vtkInformationVector;
+
+class VTKCOMMONEXECUTIONMODEL_EXPORT vtkTimeStepPrefetcher : public vtkObject
+{
+public:
+  static vtkTimeStepPrefetcher* New();
+  vtkTypeMacro(vtkTimeStepPrefetcher, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  ///@{
+  /**
+   * Set/Get the source whose time steps are prefetched. The source keeps a
+   * reference to the prefetcher until another one is set. The prefetching
+   * stops when the source is deleted.
+   */
+  void SetAlgorithm(vtkAlgorithm* algorithm);
+  vtkAlgorithm* GetAlgorithm();
+  ///@}
+
+  /**
+   * Return the prefetcher of the given algorithm, or nullptr.
+   */
+  static vtkTimeStepPrefetcher* GetPrefetcher(vtkAlgorithm* algorithm);
+
+  ///@{
+  /**
+   * Set/Get the number of time steps prefetched after the requested one.
+   * Default is 1.
+   */
+  vtkSetClampMacro(NumberOfTimeSteps, int, 0, VTK_INT_MAX);
+  vtkGetMacro(NumberOfTimeSteps, int);
+  ///@}
+
+  ///@{
+  /**
+   * Set/Get the memory the prefetched data may use, in kibibytes. 0 means no
+   * limit. Default is 0.
+   */
+  void SetBudget(unsigned long budget);
+  unsigned long GetBudget();
+  ///@}
+
+  /**
+   * Return the memory used by the prefetched data, in kibibytes.
+   */
+  unsigned long GetOccupancy();
+
+  /**
+   * Return the number of time steps prefetched so far.
+   */
+  vtkIdType GetNumberOfPrefetchedTimeSteps();
+
+  /**
+   * Return the number of requested time steps handed over, and the number of
+   * requested time steps which were not prefetched and executed the source.
+   */
+  vtkIdType GetNumberOfHits();
+  vtkIdType GetNumberOfMisses();
+
+  /**
+   * Return the number of times prefetched or scheduled time steps were
+   * dropped, because of a change of direction, of the source or of the
+   * request, or a call to Cancel().
+   */
+  vtkIdType GetNumberOfCancellations();
+
+  /**
+   * Reset the numbers of prefetched time steps, hits, misses and
+   * cancellations.
+   */
+  void ResetCounters();
+
+  /**
+   * Drop the prefetched and scheduled time steps. The time step being read,
+   * if any, is dropped when its execution completes.
+   */
+  void Cancel();
+
+  /**
+   * Wait until the scheduled time steps are prefetched, or until the budget
+   * is reached.
+   */
+  void Wait();
+
+  ///@{
+  /**
+   * Methods called by the executive of the source.
+   * LockAlgorithm() and UnlockAlgorithm() surround the requests made to the
+   * source. HandOver() copies the prefetched data of the requested time step
+   * to the outputs and returns true, or returns false if it was not
+   * prefetched. Prefetch() schedules the time steps following the one
+   * generated.
+   */
+  void LockAlgorithm();
+  void UnlockAlgorithm();
+  bool HandOver(vtkInformation* request, vtkInformationVector* outInfoVec);
+  void Prefetch(vtkInformation* request, vtkInformationVector* outInfoVec);
+  ///@}
+
+protected:
+  vtkTimeStepPrefetcher();
+  ~vtkTimeStepPrefetcher() override;
+
+  int NumberOfTimeSteps = 1;
+
+private:
+  vtkTimeStepPrefetcher(const vtkTimeStepPrefetcher&) = delete;
+  void operator=(const vtkTimeStepPrefetcher&) = delete;
+
+  // Stop the background thread and drop all the time steps.
+  void Detach();
+  static void AlgorithmDeleted(vtkObject*, unsigned long, void* clientData, void*);
+
+  static vtkInformationObjectBaseKey* PREFETCHER();
+
+  struct Internals;
+  std::unique_ptr<Internals> Internal;
+};
+
+VTK_ABI_NAMESPACE_END
+#endif
@@ -6,8 +6,10 @@
 #include "vtkGarbageCollector.h"
 #include "vtkImageData.h"
 #include "vtkInformation.h"
+#include "vtkInformationIntegerKey.h"
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
+#include "vtkPipelineMemoryBudget.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 
 VTK_ABI_NAMESPACE_BEGIN
@@ -32,6 +34,8 @@ vtkTrivialProducer::vtkTrivialProducer()
   this->Output = nullptr;
   this->WholeExtent[0] = this->WholeExtent[2] = this->WholeExtent[4] = 0;
   this->WholeExtent[1] = this->WholeExtent[3] = this->WholeExtent[5] = -1;
+  // The output is given by the application, it cannot be generated again.
+  this->GetInformation()->Set(vtkPipelineMemoryBudget::KEEP_OUTPUTS(), 1);
 }
 
 //------------------------------------------------------------------------------
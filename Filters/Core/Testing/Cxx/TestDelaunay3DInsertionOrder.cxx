@@ -0,0 +1,134 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// Check that vtkDelaunay3D triangulates the same domain whatever the point
+// insertion order, and report the time taken by each order.
+
+#include <vtkCellArray.h>
+#include <vtkDelaunay3D.h>
+#include <vtkMinimalStandardRandomSequence.h>
+#include <vtkNew.h>
+#include <vtkPoints.h>
+#include <vtkTetra.h>
+#include <vtkTimerLog.h>
+#include <vtkUnstructuredGrid.h>
+
+#include <cmath>
+#include <iostream>
+
+namespace
+{
+//------------------------------------------------------------------------------
+// Generate points either uniformly in the unit cube, or in a few tight
+// clusters, which is the worst case of the input insertion order.
+void InitializePoints(vtkUnstructuredGrid* grid, vtkIdType numPts, bool clustered)
+{
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(1);
+
+  vtkNew<vtkPoints> points;
+  points->SetDataTypeToDouble();
+  points->SetNumberOfPoints(numPts);
+  for (vtkIdType ptId = 0; ptId < numPts; ++ptId)
+  {
+    double x[3];
+    for (int i = 0; i < 3; ++i)
+    {
+      random->Next();
+      x[i] = random->GetValue();
+      if (clustered)
+      {
+        // Eight clusters, filled one after the other
+        const double center = ((ptId * 8 / numPts) >> i) & 1 ? 0.75 : 0.25;
+        x[i] = center + 0.1 * (x[i] - 0.5);
+      }
+    }
+    points->SetPoint(ptId, x);
+  }
+  grid->SetPoints(points);
+}
+
+//------------------------------------------------------------------------------
+double TotalVolume(vtkUnstructuredGrid* grid)
+{
+  double volume = 0.0;
+  double p[4][3];
+  for (vtkIdType cellId = 0; cellId < grid->GetNumberOfCells(); ++cellId)
+  {
+    vtkIdType npts;
+    const vtkIdType* pts;
+    grid->GetCellPoints(cellId, npts, pts);
+    for (int i = 0; i < 4; ++i)
+    {
+      grid->GetPoint(pts[i], p[i]);
+    }
+    volume += std::abs(vtkTetra::ComputeVolume(p[0], p[1], p[2], p[3]));
+  }
+  return volume;
+}
+
+//------------------------------------------------------------------------------
+bool TestPoints(vtkIdType numPts, bool clustered)
+{
+  const char* name = clustered ? "Clustered" : "Uniform";
+
+  vtkNew<vtkUnstructuredGrid> input;
+  InitializePoints(input, numPts, clustered);
+
+  vtkNew<vtkDelaunay3D> delaunay;
+  delaunay->SetInputData(input);
+  vtkNew<vtkTimerLog> timer;
+
+  delaunay->SetPointInsertionOrderToInputOrder();
+  timer->StartTimer();
+  delaunay->Update();
+  timer->StopTimer();
+  std::cout << "<DartMeasurement name=\"" << name
+            << "InputOrder\" type=\"numeric/double\">" << timer->GetElapsedTime()
+            << "</DartMeasurement>" << std::endl;
+  vtkNew<vtkUnstructuredGrid> inputOrderOutput;
+  inputOrderOutput->ShallowCopy(delaunay->GetOutput());
+
+  delaunay->SetPointInsertionOrderToBRIOOrder();
+  timer->StartTimer();
+  delaunay->Update();
+  timer->StopTimer();
+  std::cout << "<DartMeasurement name=\"" << name << "BRIOOrder\" type=\"numeric/double\">"
+            << timer->GetElapsedTime() << "</DartMeasurement>" << std::endl;
+  vtkUnstructuredGrid* brioOutput = delaunay->GetOutput();
+
+  if (brioOutput->GetNumberOfPoints() != numPts)
+  {
+    std::cerr << name << ": expected " << numPts << " output points, got "
+              << brioOutput->GetNumberOfPoints() << std::endl;
+    return false;
+  }
+  if (brioOutput->GetNumberOfCells() == 0 ||
+    brioOutput->GetCellType(0) != VTK_TETRA || !brioOutput->IsHomogeneous())
+  {
+    std::cerr << name << ": expected a non empty tetrahedral mesh" << std::endl;
+    return false;
+  }
+
+  // Both orders triangulate the convex hull of the points
+  const double inputOrderVolume = TotalVolume(inputOrderOutput);
+  const double brioVolume = TotalVolume(brioOutput);
+  if (std::abs(inputOrderVolume - brioVolume) > 1e-6 * inputOrderVolume)
+  {
+    std::cerr << name << ": input order volume " << inputOrderVolume
+              << " differs from BRIO volume " << brioVolume << std::endl;
+    return false;
+  }
+
+  std::cout << name << ": " << inputOrderOutput->GetNumberOfCells() << " and "
+            << brioOutput->GetNumberOfCells() << " tetrahedra" << std::endl;
+  return true;
+}
+}
+
+int TestDelaunay3DInsertionOrder(int vtkNotUsed(argc), char* vtkNotUsed(argv)[])
+{
+  bool success = TestPoints(4, false);
+  success &= TestPoints(20000, false);
+  success &= TestPoints(20000, true);
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
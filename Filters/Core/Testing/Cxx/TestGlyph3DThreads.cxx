@@ -0,0 +1,344 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// Check that vtkGlyph3D places the glyphs like the equivalent vtkTransform,
+// skips ghost points, copies the attributes of each input point to its glyph,
+// keeps the cell order of sources mixing cell kinds, and fills the GlyphVector
+// array as before in VTK_FOLLOW_CAMERA_DIRECTION mode.
+
+#include <vtkCellData.h>
+#include <vtkDataArray.h>
+#include <vtkDoubleArray.h>
+#include <vtkGlyph3D.h>
+#include <vtkIdList.h>
+#include <vtkMath.h>
+#include <vtkMinimalStandardRandomSequence.h>
+#include <vtkNew.h>
+#include <vtkPointData.h>
+#include <vtkPoints.h>
+#include <vtkPolyData.h>
+#include <vtkSphereSource.h>
+#include <vtkTransform.h>
+#include <vtkUnsignedCharArray.h>
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+namespace
+{
+constexpr vtkIdType NUMBER_OF_POINTS = 5000;
+
+//------------------------------------------------------------------------------
+vtkSmartPointer<vtkPolyData> MakeInput()
+{
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(1);
+
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkDoubleArray> scalars;
+  scalars->SetName("Scale");
+  vtkNew<vtkDoubleArray> vectors;
+  vectors->SetName("Direction");
+  vectors->SetNumberOfComponents(3);
+  vtkNew<vtkUnsignedCharArray> ghosts;
+  ghosts->SetName(vtkDataSetAttributes::GhostArrayName());
+  for (vtkIdType i = 0; i < NUMBER_OF_POINTS; ++i)
+  {
+    double x[3], v[3];
+    for (int j = 0; j < 3; ++j)
+    {
+      x[j] = random->GetNextRangeValue(-10.0, 10.0);
+      v[j] = random->GetNextRangeValue(-1.0, 1.0);
+    }
+    // Some vectors along the x axis use the flipping special case
+    if (i % 10 == 0)
+    {
+      v[1] = v[2] = 0.0;
+    }
+    points->InsertNextPoint(x);
+    vectors->InsertNextTuple(v);
+    scalars->InsertNextValue(random->GetNextRangeValue(0.5, 1.5));
+    ghosts->InsertNextValue(i % 7 == 0 ? vtkDataSetAttributes::DUPLICATEPOINT : 0);
+  }
+
+  auto input = vtkSmartPointer<vtkPolyData>::New();
+  input->SetPoints(points);
+  input->GetPointData()->SetScalars(scalars);
+  input->GetPointData()->SetVectors(vectors);
+  input->GetPointData()->AddArray(ghosts);
+  return input;
+}
+
+//------------------------------------------------------------------------------
+bool CheckGlyphPoints(vtkPolyData* input, vtkPolyData* source, vtkPolyData* output)
+{
+  vtkDataArray* scalars = input->GetPointData()->GetScalars();
+  vtkDataArray* vectors = input->GetPointData()->GetVectors();
+  vtkDataArray* ids = output->GetPointData()->GetArray("InputPointIds");
+  const vtkIdType numSourcePts = source->GetNumberOfPoints();
+
+  vtkIdType outPtId = 0;
+  for (vtkIdType ptId = 0; ptId < input->GetNumberOfPoints(); ++ptId)
+  {
+    if (ptId % 7 == 0)
+    {
+      continue;
+    }
+
+    // The transform built by the serial implementation of the filter
+    double x[3], v[3];
+    input->GetPoint(ptId, x);
+    vectors->GetTuple(ptId, v);
+    const double vMag = std::sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+    const double scale = 0.1 * scalars->GetComponent(ptId, 0);
+    vtkNew<vtkTransform> transform;
+    transform->Translate(x);
+    if (v[1] == 0.0 && v[2] == 0.0)
+    {
+      if (v[0] < 0)
+      {
+        transform->RotateWXYZ(180.0, 0, 1, 0);
+      }
+    }
+    else
+    {
+      transform->RotateWXYZ(180.0, (v[0] + vMag) / 2.0, v[1] / 2.0, v[2] / 2.0);
+    }
+    transform->Scale(scale, scale, scale);
+
+    for (vtkIdType i = 0; i < numSourcePts; ++i, ++outPtId)
+    {
+      double expected[3], actual[3];
+      transform->TransformPoint(source->GetPoint(i), expected);
+      output->GetPoint(outPtId, actual);
+      if (ids->GetComponent(outPtId, 0) != ptId ||
+        std::abs(expected[0] - actual[0]) > 1e-5 || std::abs(expected[1] - actual[1]) > 1e-5 ||
+        std::abs(expected[2] - actual[2]) > 1e-5)
+      {
+        std::cerr << "Error: wrong glyph point " << outPtId << " for input point " << ptId
+                  << std::endl;
+        return false;
+      }
+    }
+  }
+  if (outPtId != output->GetNumberOfPoints())
+  {
+    std::cerr << "Error: expected " << outPtId << " points, got " << output->GetNumberOfPoints()
+              << std::endl;
+    return false;
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool CheckGlyphAttributes(vtkPolyData* input, vtkPolyData* source, vtkPolyData* output)
+{
+  vtkDataArray* scalars = input->GetPointData()->GetScalars();
+  vtkDataArray* vectors = input->GetPointData()->GetVectors();
+  vtkDataArray* ids = output->GetPointData()->GetArray("InputPointIds");
+  vtkDataArray* glyphVectors = output->GetPointData()->GetArray("GlyphVector");
+  vtkDataArray* magnitudes = output->GetPointData()->GetArray("VectorMagnitude");
+  vtkDataArray* normals = output->GetPointData()->GetArray("Normals");
+  vtkDataArray* cellScalars = output->GetCellData()->GetArray("Scale");
+  if (!glyphVectors || !magnitudes || !normals || !cellScalars)
+  {
+    std::cerr << "Error: missing output arrays" << std::endl;
+    return false;
+  }
+
+  for (vtkIdType outPtId = 0; outPtId < output->GetNumberOfPoints(); ++outPtId)
+  {
+    const vtkIdType ptId = static_cast<vtkIdType>(ids->GetComponent(outPtId, 0));
+    double v[3], glyphVector[3], normal[3];
+    vectors->GetTuple(ptId, v);
+    glyphVectors->GetTuple(outPtId, glyphVector);
+    normals->GetTuple(outPtId, normal);
+    if (std::abs(v[0] - glyphVector[0]) > 1e-6 || std::abs(v[1] - glyphVector[1]) > 1e-6 ||
+      std::abs(v[2] - glyphVector[2]) > 1e-6 ||
+      std::abs(magnitudes->GetComponent(outPtId, 0) - vtkMath::Norm(v)) > 1e-5 ||
+      std::abs(vtkMath::Norm(normal) - 1.0) > 1e-5)
+    {
+      std::cerr << "Error: wrong attributes for glyph point " << outPtId << std::endl;
+      return false;
+    }
+  }
+
+  const vtkIdType numSourcePts = source->GetNumberOfPoints();
+  const vtkIdType numSourceCells = source->GetNumberOfCells();
+  if (output->GetNumberOfCells() != numSourceCells * output->GetNumberOfPoints() / numSourcePts ||
+    output->GetNumberOfPolys() != output->GetNumberOfCells())
+  {
+    std::cerr << "Error: unexpected number of glyph cells " << output->GetNumberOfCells()
+              << std::endl;
+    return false;
+  }
+  vtkNew<vtkIdList> cellPts;
+  vtkNew<vtkIdList> sourceCellPts;
+  for (vtkIdType cellId = 0; cellId < output->GetNumberOfCells(); ++cellId)
+  {
+    // Cells follow the glyphs, which follow the input points
+    const vtkIdType glyph = cellId / numSourceCells;
+    const vtkIdType ptId = static_cast<vtkIdType>(ids->GetComponent(glyph * numSourcePts, 0));
+    output->GetCellPoints(cellId, cellPts);
+    source->GetCellPoints(cellId % numSourceCells, sourceCellPts);
+    bool sameCell = cellPts->GetNumberOfIds() == sourceCellPts->GetNumberOfIds();
+    for (vtkIdType i = 0; sameCell && i < cellPts->GetNumberOfIds(); ++i)
+    {
+      sameCell = cellPts->GetId(i) == sourceCellPts->GetId(i) + glyph * numSourcePts;
+    }
+    if (!sameCell || cellScalars->GetComponent(cellId, 0) != scalars->GetComponent(ptId, 0))
+    {
+      std::cerr << "Error: wrong cell data for glyph cell " << cellId << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool TestMixedCells()
+{
+  // Source whose cells are of different kinds, inserted out of kind order
+  vtkNew<vtkPoints> sourcePts;
+  sourcePts->InsertNextPoint(0.0, 0.0, 0.0);
+  sourcePts->InsertNextPoint(1.0, 0.0, 0.0);
+  sourcePts->InsertNextPoint(0.0, 1.0, 0.0);
+  vtkNew<vtkPolyData> source;
+  source->SetPoints(sourcePts);
+  source->AllocateEstimate(3, 3);
+  const vtkIdType vertex0[1] = { 0 };
+  const vtkIdType triangle[3] = { 0, 1, 2 };
+  const vtkIdType vertex1[1] = { 2 };
+  source->InsertNextCell(VTK_VERTEX, 1, vertex0);
+  source->InsertNextCell(VTK_TRIANGLE, 3, triangle);
+  source->InsertNextCell(VTK_VERTEX, 1, vertex1);
+
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkDoubleArray> scalars;
+  scalars->SetName("Scale");
+  for (int i = 0; i < 4; ++i)
+  {
+    points->InsertNextPoint(10.0 * i, 0.0, 0.0);
+    scalars->InsertNextValue(i + 1.0);
+  }
+  vtkNew<vtkPolyData> input;
+  input->SetPoints(points);
+  input->GetPointData()->SetScalars(scalars);
+
+  vtkNew<vtkGlyph3D> glyph;
+  glyph->SetInputData(input);
+  glyph->SetSourceData(source);
+  glyph->FillCellDataOn();
+  glyph->Update();
+  vtkPolyData* output = glyph->GetOutput();
+
+  if (output->GetNumberOfPoints() != 12 || output->GetNumberOfCells() != 12 ||
+    output->GetNumberOfVerts() != 8 || output->GetNumberOfPolys() != 4)
+  {
+    std::cerr << "Error: unexpected glyphs for mixed cells" << std::endl;
+    return false;
+  }
+  vtkDataArray* cellScalars = output->GetCellData()->GetArray("Scale");
+  vtkNew<vtkIdList> cellPts;
+  vtkNew<vtkIdList> sourceCellPts;
+  for (vtkIdType cellId = 0; cellId < 12; ++cellId)
+  {
+    const vtkIdType glyphId = cellId / 3;
+    output->GetCellPoints(cellId, cellPts);
+    source->GetCellPoints(cellId % 3, sourceCellPts);
+    bool sameCell = output->GetCellType(cellId) == source->GetCellType(cellId % 3) &&
+      cellPts->GetNumberOfIds() == sourceCellPts->GetNumberOfIds();
+    for (vtkIdType i = 0; sameCell && i < cellPts->GetNumberOfIds(); ++i)
+    {
+      sameCell = cellPts->GetId(i) == sourceCellPts->GetId(i) + 3 * glyphId;
+    }
+    if (!sameCell || !cellScalars || cellScalars->GetComponent(cellId, 0) != glyphId + 1.0)
+    {
+      std::cerr << "Error: wrong mixed glyph cell " << cellId << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool TestFollowCamera(bool orient)
+{
+  vtkNew<vtkPoints> sourcePts;
+  sourcePts->InsertNextPoint(0.0, 0.0, 0.0);
+  vtkNew<vtkPolyData> source;
+  source->SetPoints(sourcePts);
+
+  vtkNew<vtkPoints> points;
+  for (int i = 0; i < 5; ++i)
+  {
+    points->InsertNextPoint(i, 2.0 * i, 0.0);
+  }
+  vtkNew<vtkPolyData> input;
+  input->SetPoints(points);
+
+  double camera[3] = { 1.0, 2.0, 10.0 };
+  vtkNew<vtkGlyph3D> glyph;
+  glyph->SetInputData(input);
+  glyph->SetSourceData(source);
+  glyph->SetVectorModeToFollowCameraDirection();
+  glyph->SetFollowedCameraPosition(camera);
+  glyph->SetOrient(orient);
+  glyph->Update();
+  vtkDataArray* glyphVectors = glyph->GetOutput()->GetPointData()->GetArray("GlyphVector");
+  if (!glyphVectors || glyphVectors->GetNumberOfTuples() != 5)
+  {
+    std::cerr << "Error: missing GlyphVector array" << std::endl;
+    return false;
+  }
+
+  // With Orient on, each glyph gets the direction of the previous one
+  for (vtkIdType ptId = 0; ptId < 5; ++ptId)
+  {
+    double x[3], expected[3], actual[3];
+    input->GetPoint(orient && ptId > 0 ? ptId - 1 : ptId, x);
+    for (int i = 0; i < 3; ++i)
+    {
+      expected[i] = camera[i] - x[i];
+    }
+    vtkMath::Normalize(expected);
+    glyphVectors->GetTuple(ptId, actual);
+    if (std::abs(expected[0] - actual[0]) > 1e-6 || std::abs(expected[1] - actual[1]) > 1e-6 ||
+      std::abs(expected[2] - actual[2]) > 1e-6)
+    {
+      std::cerr << "Error: wrong GlyphVector " << ptId << " with Orient " << orient << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+//------------------------------------------------------------------------------
+int TestGlyph3DThreads(int, char*[])
+{
+  vtkSmartPointer<vtkPolyData> input = MakeInput();
+
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(8);
+  sphere->SetPhiResolution(8);
+  sphere->Update();
+  vtkPolyData* source = sphere->GetOutput();
+
+  vtkNew<vtkGlyph3D> glyph;
+  glyph->SetInputData(input);
+  glyph->SetSourceData(source);
+  glyph->SetScaleFactor(0.1);
+  glyph->SetColorModeToColorByVector();
+  glyph->GeneratePointIdsOn();
+  glyph->FillCellDataOn();
+  glyph->Update();
+  vtkPolyData* output = glyph->GetOutput();
+
+  if (!CheckGlyphPoints(input, source, output) || !CheckGlyphAttributes(input, source, output) ||
+    !TestMixedCells() || !TestFollowCamera(true) || !TestFollowCamera(false))
+  {
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,95 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// Check that vtkQuadricDecimation produces the same mesh whatever the number
+// of threads used to initialize the quadrics and the edge costs.
+
+#include <vtkCellArray.h>
+#include <vtkDataArray.h>
+#include <vtkElevationFilter.h>
+#include <vtkNew.h>
+#include <vtkPointData.h>
+#include <vtkPolyData.h>
+#include <vtkQuadricDecimation.h>
+#include <vtkSMPTools.h>
+#include <vtkSphereSource.h>
+
+#include <cstdlib>
+#include <iostream>
+
+namespace
+{
+//------------------------------------------------------------------------------
+bool SameArrays(vtkDataArray* a0, vtkDataArray* a1)
+{
+  if (a0->GetNumberOfTuples() != a1->GetNumberOfTuples() ||
+    a0->GetNumberOfComponents() != a1->GetNumberOfComponents())
+  {
+    return false;
+  }
+  for (vtkIdType i = 0; i < a0->GetNumberOfValues(); ++i)
+  {
+    if (a0->GetComponent(i / a0->GetNumberOfComponents(), i % a0->GetNumberOfComponents()) !=
+      a1->GetComponent(i / a1->GetNumberOfComponents(), i % a1->GetNumberOfComponents()))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool TestDecimation(bool attributeErrorMetric, bool volumePreservation)
+{
+  // An open sphere, so that boundary constraints are used too
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(120);
+  sphere->SetPhiResolution(120);
+  sphere->SetStartTheta(10.0);
+  sphere->SetEndTheta(300.0);
+
+  vtkNew<vtkElevationFilter> elevation;
+  elevation->SetInputConnection(sphere->GetOutputPort());
+
+  vtkNew<vtkQuadricDecimation> decimator;
+  decimator->SetInputConnection(elevation->GetOutputPort());
+  decimator->SetTargetReduction(0.8);
+  decimator->SetAttributeErrorMetric(attributeErrorMetric);
+  decimator->SetVolumePreservation(volumePreservation);
+
+  vtkNew<vtkPolyData> serial;
+  vtkSMPTools::LocalScope(vtkSMPTools::Config{ 1 },
+    [&]()
+    {
+      decimator->Update();
+      serial->DeepCopy(decimator->GetOutput());
+    });
+
+  decimator->Modified();
+  decimator->Update();
+  vtkPolyData* parallel = decimator->GetOutput();
+
+  std::cout << "Attributes " << attributeErrorMetric << ", volume " << volumePreservation << ": "
+            << serial->GetNumberOfPolys() << " triangles" << std::endl;
+
+  if (serial->GetNumberOfPolys() != parallel->GetNumberOfPolys() ||
+    !SameArrays(serial->GetPoints()->GetData(), parallel->GetPoints()->GetData()) ||
+    !SameArrays(serial->GetPolys()->GetConnectivityArray(),
+      parallel->GetPolys()->GetConnectivityArray()))
+  {
+    std::cerr << "Decimation differs between 1 and " << vtkSMPTools::GetEstimatedNumberOfThreads()
+              << " threads" << std::endl;
+    return false;
+  }
+  return true;
+}
+}
+
+//------------------------------------------------------------------------------
+int TestQuadricDecimationThreads(int, char*[])
+{
+  bool success = TestDecimation(false, false);
+  success &= TestDecimation(false, true);
+  success &= TestDecimation(true, false);
+  success &= TestDecimation(true, true);
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
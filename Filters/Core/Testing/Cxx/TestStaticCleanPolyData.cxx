@@ -2,10 +2,13 @@
 // SPDX-License-Identifier: BSD-3-Clause
 
 #include <vtkCellArray.h>
+#include <vtkCellData.h>
+#include <vtkIdTypeArray.h>
 #include <vtkSmartPointer.h>
 #include <vtkStaticCleanPolyData.h>
 
 #include <iostream>
+#include <vector>
 
 namespace
 {
@@ -283,6 +286,78 @@ bool UpdateAndTestCleanPolyData(vtkStaticCleanPolyData* clean, int numExpectedPo
 
   return retValue;
 }
+
+// Many triangles, every third one degenerated to a line, with the input cell
+// ids as cell data. Check that the output cells and their data keep the
+// input order although the cells are rewritten by several threads.
+bool TestCellOrder()
+{
+  const vtkIdType numTris = 30000;
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkCellArray> polys;
+  vtkNew<vtkIdTypeArray> cellIds;
+  cellIds->SetName("CellIds");
+  std::vector<vtkIdType> expectedLines;
+  std::vector<vtkIdType> expectedPolys;
+  for (vtkIdType i = 0; i < numTris; ++i)
+  {
+    const vtkIdType p0 = points->InsertNextPoint(i, 0.0, 0.0);
+    const vtkIdType p1 = points->InsertNextPoint(i, 1.0, 0.0);
+    const vtkIdType p2 = points->InsertNextPoint(i + 0.5, 1.0, 0.0);
+    const vtkIdType tri[3] = { p0, p1, i % 3 ? p2 : p1 };
+    polys->InsertNextCell(3, tri);
+    cellIds->InsertNextValue(i);
+    (i % 3 ? expectedPolys : expectedLines).push_back(i);
+  }
+  vtkNew<vtkPolyData> input;
+  input->SetPoints(points);
+  input->SetPolys(polys);
+  input->GetCellData()->AddArray(cellIds);
+
+  vtkNew<vtkStaticCleanPolyData> clean;
+  clean->RemoveUnusedPointsOff(); // keep the point ids
+  clean->ConvertPolysToLinesOn();
+  clean->SetInputData(input);
+  clean->Update();
+  vtkPolyData* output = clean->GetOutput();
+
+  std::vector<vtkIdType> expected(expectedLines);
+  expected.insert(expected.end(), expectedPolys.begin(), expectedPolys.end());
+  auto outCellIds = vtkIdTypeArray::SafeDownCast(output->GetCellData()->GetArray("CellIds"));
+  if (output->GetNumberOfLines() != static_cast<vtkIdType>(expectedLines.size()) ||
+    output->GetNumberOfPolys() != static_cast<vtkIdType>(expectedPolys.size()) || !outCellIds ||
+    outCellIds->GetNumberOfValues() != static_cast<vtkIdType>(expected.size()))
+  {
+    std::cerr << "Wrong number of output cells." << std::endl;
+    return false;
+  }
+  for (vtkIdType i = 0; i < outCellIds->GetNumberOfValues(); ++i)
+  {
+    if (outCellIds->GetValue(i) != expected[i])
+    {
+      std::cerr << "Output cell " << i << " comes from input cell " << outCellIds->GetValue(i)
+                << " instead of " << expected[i] << std::endl;
+      return false;
+    }
+  }
+
+  // Check the connectivity of the last triangle and of the last line
+  vtkIdType npts;
+  const vtkIdType* pts;
+  output->GetPolys()->GetCellAtId(output->GetNumberOfPolys() - 1, npts, pts);
+  if (npts != 3 || pts[0] != 3 * (numTris - 1) || pts[2] != 3 * (numTris - 1) + 2)
+  {
+    std::cerr << "Wrong connectivity of the last triangle." << std::endl;
+    return false;
+  }
+  output->GetLines()->GetCellAtId(output->GetNumberOfLines() - 1, npts, pts);
+  if (npts != 2 || pts[0] != 3 * expectedLines.back() || pts[1] != 3 * expectedLines.back() + 1)
+  {
+    std::cerr << "Wrong connectivity of the last line." << std::endl;
+    return false;
+  }
+  return true;
+}
 }
 
 int TestStaticCleanPolyData(int vtkNotUsed(argc), char* vtkNotUsed(argv)[])
@@ -402,5 +477,10 @@ int TestStaticCleanPolyData(int vtkNotUsed(argc), char* vtkNotUsed(argv)[])
     retVal = EXIT_FAILURE;
   }
 
+  if (!TestCellOrder())
+  {
+    retVal = EXIT_FAILURE;
+  }
+
   return retVal;
 }
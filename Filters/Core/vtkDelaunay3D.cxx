@@ -3,8 +3,10 @@
 
 #include "vtkDelaunay3D.h"
 
+#include "vtkCellArray.h"
 #include "vtkEdgeTable.h"
 #include "vtkExecutive.h"
+#include "vtkIdTypeArray.h"
 #include "vtkIncrementalPointLocator.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
@@ -13,10 +15,17 @@
 #include "vtkPointData.h"
 #include "vtkPointLocator.h"
 #include "vtkPolyData.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkTetra.h"
 #include "vtkTriangle.h"
 #include "vtkUnstructuredGrid.h"
 
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkDelaunay3D);
 
@@ -107,6 +116,96 @@ vtkDelaunayTetra* vtkTetraArray::Resize(vtkIdType sz)
   return this->Array;
 }
 
+namespace
+{
+//------------------------------------------------------------------------------
+// Deterministic 64 bits mixing of a point id (splitmix64 finalizer), used to
+// assign points to BRIO rounds independently of the number of threads.
+uint64_t HashPointId(vtkIdType ptId)
+{
+  uint64_t z = static_cast<uint64_t>(ptId) + 0x9e3779b97f4a7c15ULL;
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+  return z ^ (z >> 31);
+}
+
+// Spread the 19 lowest bits of v so that there are two zero bits between each
+uint64_t SpreadMortonBits(uint64_t v)
+{
+  v &= 0x7ffff;
+  v = (v | (v << 32)) & 0x001f00000000ffffULL;
+  v = (v | (v << 16)) & 0x001f0000ff0000ffULL;
+  v = (v | (v << 8)) & 0x100f00f00f00f00fULL;
+  v = (v | (v << 4)) & 0x10c30c30c30c30c3ULL;
+  v = (v | (v << 2)) & 0x1249249249249249ULL;
+  return v;
+}
+
+//------------------------------------------------------------------------------
+// Compute a biased randomized insertion order (BRIO): each point is placed in
+// the last round with probability 1/2, in the previous one with probability
+// 1/4 and so on, and points are sorted along a Morton curve inside each round.
+// The sort key packs the round in the 5 highest bits and a 57 bits Morton code
+// below; ties are broken with the point id so the order is fully deterministic.
+std::vector<vtkIdType> ComputeBRIOOrder(vtkPoints* points)
+{
+  constexpr int MortonBits = 19;
+  constexpr int MaxRounds = 32;
+  constexpr vtkIdType FirstRoundSize = 64;
+
+  const vtkIdType numPts = points->GetNumberOfPoints();
+  int numRounds = 1;
+  while (numRounds < MaxRounds && (FirstRoundSize << numRounds) <= numPts)
+  {
+    ++numRounds;
+  }
+
+  double bounds[6];
+  points->GetBounds(bounds);
+  double scale[3];
+  for (int i = 0; i < 3; ++i)
+  {
+    const double length = bounds[2 * i + 1] - bounds[2 * i];
+    scale[i] = length > 0.0 ? ((1 << MortonBits) - 1) / length : 0.0;
+  }
+
+  std::vector<std::pair<uint64_t, vtkIdType>> keys(numPts);
+  vtkSMPTools::For(0, numPts,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      double x[3];
+      for (vtkIdType ptId = begin; ptId < end; ++ptId)
+      {
+        points->GetPoint(ptId, x);
+        uint64_t morton = 0;
+        for (int i = 0; i < 3; ++i)
+        {
+          const auto q = static_cast<uint64_t>((x[i] - bounds[2 * i]) * scale[i]);
+          morton |= SpreadMortonBits(q) << i;
+        }
+
+        // Count trailing zeros of the hash: 0 with probability 1/2, 1 with 1/4...
+        const uint64_t hash = HashPointId(ptId);
+        int zeros = 0;
+        while (zeros < numRounds - 1 && !((hash >> zeros) & 1))
+        {
+          ++zeros;
+        }
+        const auto round = static_cast<uint64_t>(numRounds - 1 - zeros);
+
+        keys[ptId] = std::make_pair((round << (3 * MortonBits)) | morton, ptId);
+      }
+    });
+
+  vtkSMPTools::Sort(keys.begin(), keys.end());
+
+  std::vector<vtkIdType> order(numPts);
+  vtkSMPTools::Transform(keys.cbegin(), keys.cend(), order.begin(),
+    [](const std::pair<uint64_t, vtkIdType>& key) { return key.second; });
+  return order;
+}
+}
+
 // vtkDelaunay3D methods
 //
 
@@ -124,6 +223,7 @@ vtkDelaunay3D::vtkDelaunay3D()
   this->BoundingTriangulation = 0;
   this->Offset = 2.5;
   this->OutputPointsPrecision = DEFAULT_PRECISION;
+  this->PointInsertionOrder = INPUT_ORDER;
   this->Locator = nullptr;
   this->TetraArray = nullptr;
   this->References = nullptr;
@@ -478,20 +578,27 @@ int vtkDelaunay3D::RequestData(vtkInformation* vtkNotUsed(request),
 
   Mesh = this->InitPointInsertion(center, this->Offset * tol, numPoints, points);
 
+  std::vector<vtkIdType> insertionOrder;
+  if (this->PointInsertionOrder == BRIO_ORDER)
+  {
+    insertionOrder = ComputeBRIOOrder(inPoints);
+  }
+
   // Insert each point into triangulation. Points laying "inside"
   // of tetra cause tetra to be deleted, leaving a void with bounding
   // faces. Combination of point and each face is used to form new
   // tetrahedra.
-  for (ptId = 0; ptId < numPoints; ptId++)
+  for (vtkIdType insertionId = 0; insertionId < numPoints; insertionId++)
   {
+    ptId = insertionOrder.empty() ? insertionId : insertionOrder[insertionId];
     inPoints->GetPoint(ptId, x);
 
     this->InsertPoint(Mesh, points, ptId, x, holeTetras);
 
-    if (!(ptId % 250))
+    if (!(insertionId % 250))
     {
-      vtkDebugMacro(<< "point #" << ptId);
-      this->UpdateProgress(static_cast<double>(ptId) / numPoints);
+      vtkDebugMacro(<< "point #" << insertionId);
+      this->UpdateProgress(static_cast<double>(insertionId) / numPoints);
       if (this->CheckAbort())
       {
         break;
@@ -735,14 +842,59 @@ int vtkDelaunay3D::RequestData(vtkInformation* vtkNotUsed(request),
     output->GetPointData()->PassData(input->GetPointData());
   }
 
-  for (i = 0; i < numTetras; i++)
+  if (this->Alpha > 0.0)
   {
-    if (tetraUse[i] == 2)
+    for (i = 0; i < numTetras; i++)
     {
-      Mesh->GetCellPoints(i, npts, tetraPts);
-      output->InsertNextCell(VTK_TETRA, 4, tetraPts);
+      if (tetraUse[i] == 2)
+      {
+        Mesh->GetCellPoints(i, npts, tetraPts);
+        output->InsertNextCell(VTK_TETRA, 4, tetraPts);
+      }
     }
   }
+  else
+  {
+    // Only tetrahedra are output: gather them in parallel, keeping the order
+    // of the mesh, using an exclusive scan of the kept tetra flags.
+    std::vector<vtkIdType> tetraOffsets(numTetras + 1, 0);
+    vtkSMPTools::Transform(tetraUse, tetraUse + numTetras, tetraOffsets.begin(),
+      [](char use) -> vtkIdType { return use == 2 ? 1 : 0; });
+    vtkSMPTools::ExclusiveScan(
+      tetraOffsets.begin(), tetraOffsets.end(), tetraOffsets.begin(), vtkIdType(0));
+    const vtkIdType numOutputTetras = tetraOffsets[numTetras];
+
+    vtkNew<vtkIdTypeArray> offsets;
+    offsets->SetNumberOfValues(numOutputTetras + 1);
+    vtkNew<vtkIdTypeArray> connectivity;
+    connectivity->SetNumberOfValues(4 * numOutputTetras);
+    vtkIdType* offsetsPtr = offsets->GetPointer(0);
+    vtkIdType* connPtr = connectivity->GetPointer(0);
+
+    vtkSMPThreadLocalObject<vtkIdList> tetraPtIds;
+    vtkSMPTools::For(0, numTetras,
+      [&](vtkIdType begin, vtkIdType end)
+      {
+        vtkIdList* ptIds = tetraPtIds.Local();
+        for (vtkIdType tetraId = begin; tetraId < end; ++tetraId)
+        {
+          if (tetraUse[tetraId] == 2)
+          {
+            const vtkIdType outId = tetraOffsets[tetraId];
+            vtkIdType numTetraPts;
+            const vtkIdType* ids;
+            Mesh->GetCellPoints(tetraId, numTetraPts, ids, ptIds);
+            offsetsPtr[outId] = 4 * outId;
+            std::copy(ids, ids + 4, connPtr + 4 * outId);
+          }
+        }
+      });
+    offsetsPtr[numOutputTetras] = 4 * numOutputTetras;
+
+    vtkNew<vtkCellArray> tetras;
+    tetras->SetData(offsets, connectivity);
+    output->SetCells(VTK_TETRA, tetras);
+  }
   vtkDebugMacro(<< "Generated " << output->GetNumberOfPoints() << " points and "
                 << output->GetNumberOfCells() << " tetrahedra");
 
@@ -1059,6 +1211,8 @@ void vtkDelaunay3D::PrintSelf(ostream& os, vtkIndent indent)
   }
 
   os << indent << "Output Points Precision: " << this->OutputPointsPrecision << "\n";
+  os << indent << "Point Insertion Order: "
+     << (this->PointInsertionOrder == BRIO_ORDER ? "BRIO\n" : "Input Order\n");
 }
 
 //------------------------------------------------------------------------------
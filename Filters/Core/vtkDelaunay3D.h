@@ -187,6 +187,37 @@ public:
   vtkBooleanMacro(BoundingTriangulation, vtkTypeBool);
   ///@}
 
+  /**
+   * Orders in which the input points can be inserted into the triangulation.
+   */
+  enum PointInsertionOrders
+  {
+    INPUT_ORDER = 0,
+    BRIO_ORDER = 1
+  };
+
+  ///@{
+  /**
+   * Specify the order in which the input points are inserted into the
+   * triangulation. INPUT_ORDER (the default) inserts the points in the order
+   * of the input. BRIO_ORDER inserts them in a biased randomized insertion
+   * order: points are spread over rounds of doubling size using a hash of
+   * their id, and sorted along a Morton (Z-order) curve inside each round.
+   * This keeps the cavities created by each insertion small and the walk
+   * towards the enclosing tetrahedron short, which greatly reduces the
+   * triangulation time of large or clustered point sets. The order is
+   * deterministic and is computed in parallel with vtkSMPTools.
+   *
+   * For points in general position the Delaunay triangulation is unique and
+   * both orders produce the same tetrahedra. Degenerate point sets (see the
+   * warnings above) may be triangulated differently.
+   */
+  vtkSetClampMacro(PointInsertionOrder, int, INPUT_ORDER, BRIO_ORDER);
+  vtkGetMacro(PointInsertionOrder, int);
+  void SetPointInsertionOrderToInputOrder() { this->SetPointInsertionOrder(INPUT_ORDER); }
+  void SetPointInsertionOrderToBRIOOrder() { this->SetPointInsertionOrder(BRIO_ORDER); }
+  ///@}
+
   ///@{
   /**
    * Set / get a spatial locator for merging points. By default,
@@ -268,6 +299,7 @@ protected:
   vtkTypeBool BoundingTriangulation;
   double Offset;
   int OutputPointsPrecision;
+  int PointInsertionOrder;
 
   vtkIncrementalPointLocator* Locator; // help locate points faster
 
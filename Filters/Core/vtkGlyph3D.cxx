@@ -2,18 +2,23 @@
 // SPDX-License-Identifier: BSD-3-Clause
 #include "vtkGlyph3D.h"
 
+#include "vtkArrayListTemplate.h" // For processing attribute data
 #include "vtkCell.h"
+#include "vtkCellArray.h"
 #include "vtkCellData.h"
+#include "vtkDoubleArray.h"
 #include "vtkFloatArray.h"
 #include "vtkIdList.h"
 #include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMath.h"
+#include "vtkMatrix4x4.h"
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkTransform.h"
@@ -22,8 +27,780 @@
 #include "vtkUnsignedCharArray.h"
 
 #include <algorithm>
+#include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
+namespace
+{
+// Cell array of the output receiving the glyph cells. MIXED_CELLS is used when
+// the glyph cells are of different kinds and must be inserted one by one.
+enum GlyphCellsType
+{
+  NO_CELLS = -1,
+  VERTS,
+  LINES,
+  POLYS,
+  STRIPS,
+  MIXED_CELLS
+};
+
+//------------------------------------------------------------------------------
+// Geometry of a glyph source, gathered once so that the threads never access
+// the source dataset. Points are already mapped through the SourceTransform.
+struct GlyphSource
+{
+  bool Present = false; // False for an empty entry of the source table
+  vtkIdType NumberOfPoints = 0;
+  vtkIdType NumberOfCells = 0;
+  std::vector<double> Points;
+  bool HasNormals = false;
+  std::vector<double> Normals;
+  std::vector<double> TCoords;
+  int NumberOfTCoordsComponents = 0;
+  std::vector<unsigned char> CellTypes;
+  std::vector<vtkIdType> Offsets;
+  std::vector<vtkIdType> Connectivity;
+
+  // Returns the output cell array receiving the cells of the source.
+  int Gather(vtkPolyData* source, vtkTransform* sourceTransform, bool tcoords)
+  {
+    this->Present = true;
+    int cellsType = NO_CELLS;
+    vtkCellArray* cellArrays[4] = { source->GetVerts(), source->GetLines(), source->GetPolys(),
+      source->GetStrips() };
+    for (int type = VERTS; type <= STRIPS; ++type)
+    {
+      if (cellArrays[type]->GetNumberOfCells() > 0)
+      {
+        cellsType = cellsType == NO_CELLS ? type : MIXED_CELLS;
+      }
+    }
+
+    vtkPoints* sourcePts = source->GetPoints();
+    if (sourcePts)
+    {
+      vtkNew<vtkPoints> transformedPts;
+      if (sourceTransform)
+      {
+        transformedPts->SetDataTypeToDouble();
+        sourceTransform->TransformPoints(sourcePts, transformedPts);
+        sourcePts = transformedPts;
+      }
+      this->NumberOfPoints = sourcePts->GetNumberOfPoints();
+      this->Points.resize(3 * this->NumberOfPoints);
+      for (vtkIdType ptId = 0; ptId < this->NumberOfPoints; ++ptId)
+      {
+        sourcePts->GetPoint(ptId, this->Points.data() + 3 * ptId);
+      }
+    }
+
+    if (vtkDataArray* normals = source->GetPointData()->GetNormals())
+    {
+      this->HasNormals = true;
+      this->Normals.resize(3 * this->NumberOfPoints);
+      for (vtkIdType ptId = 0; ptId < this->NumberOfPoints; ++ptId)
+      {
+        normals->GetTuple(ptId, this->Normals.data() + 3 * ptId);
+      }
+    }
+
+    vtkDataArray* sourceTCoords = source->GetPointData()->GetTCoords();
+    if (tcoords && sourceTCoords)
+    {
+      const int numComps = sourceTCoords->GetNumberOfComponents();
+      this->NumberOfTCoordsComponents = numComps;
+      this->TCoords.resize(numComps * this->NumberOfPoints);
+      for (vtkIdType ptId = 0; ptId < this->NumberOfPoints; ++ptId)
+      {
+        sourceTCoords->GetTuple(ptId, this->TCoords.data() + numComps * ptId);
+      }
+    }
+
+    // Cells are gathered in the order of their ids, which is the order of the
+    // glyph cells in the output.
+    this->NumberOfCells = source->GetNumberOfCells();
+    this->CellTypes.reserve(this->NumberOfCells);
+    this->Offsets.reserve(this->NumberOfCells + 1);
+    this->Offsets.push_back(0);
+    vtkNew<vtkIdList> cellPts;
+    vtkIdType npts;
+    const vtkIdType* pts;
+    for (vtkIdType cellId = 0; cellId < this->NumberOfCells; ++cellId)
+    {
+      source->GetCellPoints(cellId, npts, pts, cellPts);
+      this->CellTypes.push_back(static_cast<unsigned char>(source->GetCellType(cellId)));
+      this->Connectivity.insert(this->Connectivity.end(), pts, pts + npts);
+      this->Offsets.push_back(static_cast<vtkIdType>(this->Connectivity.size()));
+    }
+    return cellsType;
+  }
+};
+
+//------------------------------------------------------------------------------
+// Glyphing loop of vtkGlyph3D::Execute(). A first pass selects the glyph of
+// every input point, the output is then sized with prefix sums over the glyph
+// sizes, and a last pass lets each thread write the points, cells and
+// attributes of its glyphs at their final location. The glyph matrices are
+// built directly instead of through a vtkTransform, with the same operations.
+struct ThreadedGlyphs
+{
+  vtkGlyph3D* Filter;
+  vtkDataSet* Input;
+  vtkUniformGrid* InputUG = nullptr;
+  const unsigned char* GhostLevels = nullptr;
+  vtkDataArray* SScalars = nullptr;
+  vtkDataArray* CScalars = nullptr;
+  vtkDataArray* Array3D = nullptr; // Vectors or normals, depending on the VectorMode
+  bool HaveVectors = false;
+  double Den = 1.0;
+  int NumberOfSources = 1;
+
+  std::vector<GlyphSource> Sources;
+  int CellsType = NO_CELLS;
+  bool HaveNormals = true;
+  bool HaveTCoords = false;
+
+  // Glyph of each input point, or -1 when the point is skipped, followed by the
+  // offsets of the glyph points, cells and connectivity of each input point.
+  std::vector<int> GlyphIds;
+  std::vector<vtkIdType> PointOffsets;
+  std::vector<vtkIdType> CellOffsets;
+  std::vector<vtkIdType> ConnectivityOffsets;
+
+  // In VTK_FOLLOW_CAMERA_DIRECTION mode, the GlyphVector of each glyph is the
+  // camera direction of the glyph generated before it, or -1 for the first one.
+  std::vector<vtkIdType> PreviousGlyphPoints;
+
+  // Output data, sized before the threads start writing
+  void* OutPoints = nullptr;
+  bool DoublePoints = false;
+  vtkIdType* OutOffsets = nullptr;
+  vtkIdType* OutConnectivity = nullptr;
+  float* OutScalars = nullptr;
+  float* OutVectors = nullptr;
+  float* OutNormals = nullptr;
+  float* OutTCoords = nullptr;
+  vtkIdType* OutPointIds = nullptr;
+  ArrayList ColorScalars;
+  ArrayList PointArrays;
+  ArrayList CellArrays;
+
+  // Filter options, cached to keep the getters out of the threaded loops
+  int ScaleMode;
+  int ColorMode;
+  int VectorMode;
+  int IndexMode;
+  bool Scaling;
+  bool Orient;
+  bool Clamping;
+  double ScaleFactor;
+  double Range[2];
+  double CameraPosition[3];
+  double CameraViewUp[3];
+
+  ThreadedGlyphs(vtkGlyph3D* filter, vtkDataSet* input)
+    : Filter(filter)
+    , Input(input)
+    , ScaleMode(filter->GetScaleMode())
+    , ColorMode(filter->GetColorMode())
+    , VectorMode(filter->GetVectorMode())
+    , IndexMode(filter->GetIndexMode())
+    , Scaling(filter->GetScaling())
+    , Orient(filter->GetOrient())
+    , Clamping(filter->GetClamping())
+    , ScaleFactor(filter->GetScaleFactor())
+  {
+    filter->GetRange(this->Range);
+    filter->GetFollowedCameraPosition(this->CameraPosition);
+    filter->GetFollowedCameraViewUp(this->CameraViewUp);
+  }
+
+  // Gather the glyph sources, some of which may be null when indexing.
+  void GatherSources(const std::vector<vtkPolyData*>& sources)
+  {
+    const bool indexing = this->IndexMode != VTK_INDEXING_OFF;
+    this->Sources.resize(sources.size());
+    for (std::size_t i = 0; i < sources.size(); ++i)
+    {
+      if (!sources[i])
+      {
+        continue;
+      }
+      const int cellsType =
+        this->Sources[i].Gather(sources[i], this->Filter->GetSourceTransform(), !indexing);
+      if (cellsType != NO_CELLS)
+      {
+        this->CellsType =
+          this->CellsType == NO_CELLS || this->CellsType == cellsType ? cellsType : MIXED_CELLS;
+      }
+      this->HaveNormals &= this->Sources[i].HasNormals;
+    }
+    this->HaveTCoords = !indexing && this->Sources[0].NumberOfTCoordsComponents > 0;
+  }
+
+  // Unit vector from an input point to the followed camera
+  void GetCameraDirection(vtkIdType ptId, double v[3]) const
+  {
+    double x[3];
+    this->Input->GetPoint(ptId, x);
+    v[0] = this->CameraPosition[0] - x[0];
+    v[1] = this->CameraPosition[1] - x[1];
+    v[2] = this->CameraPosition[2] - x[2];
+    vtkMath::Normalize(v);
+  }
+
+  // Scale factors, glyph vector and vector magnitude of an input point, before
+  // the ScaleFactor is applied.
+  void GetPointScale(vtkIdType ptId, double& s, double scale[3], double v[3], double& vMag) const
+  {
+    scale[0] = scale[1] = scale[2] = 1.0;
+    s = 0.0;
+    vMag = 0.0;
+    v[0] = v[1] = v[2] = 0.0;
+    if (this->SScalars)
+    {
+      s = this->SScalars->GetComponent(ptId, 0);
+      if (this->ScaleMode == VTK_SCALE_BY_SCALAR || this->ScaleMode == VTK_DATA_SCALING_OFF)
+      {
+        scale[0] = scale[1] = scale[2] = s;
+      }
+    }
+
+    if (this->HaveVectors)
+    {
+      if (this->VectorMode == VTK_FOLLOW_CAMERA_DIRECTION)
+      {
+        vMag = 1.0;
+        this->GetCameraDirection(ptId, v);
+      }
+      else
+      {
+        this->Array3D->GetTuple(ptId, v);
+        vMag = vtkMath::Norm(v);
+        if (this->ScaleMode == VTK_SCALE_BY_VECTORCOMPONENTS)
+        {
+          std::copy(v, v + 3, scale);
+        }
+        else if (this->ScaleMode == VTK_SCALE_BY_VECTOR)
+        {
+          scale[0] = scale[1] = scale[2] = vMag;
+        }
+      }
+    }
+
+    if (this->Clamping)
+    {
+      for (int i = 0; i < 3; ++i)
+      {
+        scale[i] = std::min(std::max(scale[i], this->Range[0]), this->Range[1]);
+        scale[i] = (scale[i] - this->Range[0]) / this->Den;
+      }
+    }
+  }
+
+  int GetGlyphId(vtkIdType ptId) const
+  {
+    if ((this->GhostLevels &&
+          this->GhostLevels[ptId] &
+            (vtkDataSetAttributes::DUPLICATEPOINT | vtkDataSetAttributes::HIDDENPOINT)) ||
+      (this->InputUG && !this->InputUG->IsPointVisible(ptId)))
+    {
+      return -1;
+    }
+
+    if (this->IndexMode == VTK_INDEXING_OFF)
+    {
+      return 0;
+    }
+    double s, scale[3], v[3], vMag;
+    this->GetPointScale(ptId, s, scale, v, vMag);
+    const double value = this->IndexMode == VTK_INDEXING_BY_SCALAR ? s : vMag;
+    int index = static_cast<int>((value - this->Range[0]) * this->NumberOfSources / this->Den);
+    index = std::min(std::max(index, 0), this->NumberOfSources - 1);
+
+    // Make sure we're not indexing into an empty glyph
+    if (index < 0 || index >= static_cast<int>(this->Sources.size()) ||
+      !this->Sources[index].Present)
+    {
+      return -1;
+    }
+    return index;
+  }
+
+  // Select the glyph of every input point and compute the output offsets.
+  // Returns the number of output points, cells and connectivity ids.
+  void ComputeOffsets(vtkIdType& numPts, vtkIdType& numCells, vtkIdType& connSize)
+  {
+    const vtkIdType numInPts = this->Input->GetNumberOfPoints();
+    this->GlyphIds.resize(numInPts);
+    vtkSMPTools::For(0, numInPts,
+      [&](vtkIdType begin, vtkIdType end)
+      {
+        for (vtkIdType ptId = begin; ptId < end; ++ptId)
+        {
+          this->GlyphIds[ptId] = this->GetGlyphId(ptId);
+        }
+      });
+
+    // IsPointVisible() may be overridden by subclasses that rely on being called
+    // once per candidate point, in order: keep that loop serial.
+    const bool followCamera = this->HaveVectors && this->Orient &&
+      this->VectorMode == VTK_FOLLOW_CAMERA_DIRECTION;
+    this->PreviousGlyphPoints.resize(followCamera ? numInPts : 0);
+    vtkIdType previousPtId = -1;
+    for (vtkIdType ptId = 0; ptId < numInPts; ++ptId)
+    {
+      if (this->GlyphIds[ptId] >= 0 && !this->Filter->IsPointVisible(this->Input, ptId))
+      {
+        this->GlyphIds[ptId] = -1;
+      }
+      if (followCamera && this->GlyphIds[ptId] >= 0)
+      {
+        this->PreviousGlyphPoints[ptId] = previousPtId;
+        previousPtId = ptId;
+      }
+    }
+
+    // One extra trailing entry receives the output sizes once scanned
+    this->PointOffsets.resize(numInPts + 1);
+    this->CellOffsets.resize(numInPts + 1);
+    this->ConnectivityOffsets.resize(numInPts + 1);
+    vtkSMPTools::For(0, numInPts + 1,
+      [&](vtkIdType begin, vtkIdType end)
+      {
+        for (vtkIdType ptId = begin; ptId < end; ++ptId)
+        {
+          const int glyphId = ptId < numInPts ? this->GlyphIds[ptId] : -1;
+          const GlyphSource* glyph = glyphId < 0 ? nullptr : &this->Sources[glyphId];
+          this->PointOffsets[ptId] = glyph ? glyph->NumberOfPoints : 0;
+          this->CellOffsets[ptId] = glyph ? glyph->NumberOfCells : 0;
+          this->ConnectivityOffsets[ptId] =
+            glyph ? static_cast<vtkIdType>(glyph->Connectivity.size()) : 0;
+        }
+      });
+    vtkSMPTools::ExclusiveScan(this->PointOffsets.begin(), this->PointOffsets.end(),
+      this->PointOffsets.begin(), vtkIdType(0));
+    vtkSMPTools::ExclusiveScan(this->CellOffsets.begin(), this->CellOffsets.end(),
+      this->CellOffsets.begin(), vtkIdType(0));
+    vtkSMPTools::ExclusiveScan(this->ConnectivityOffsets.begin(),
+      this->ConnectivityOffsets.end(), this->ConnectivityOffsets.begin(), vtkIdType(0));
+    numPts = this->PointOffsets.back();
+    numCells = this->CellOffsets.back();
+    connSize = this->ConnectivityOffsets.back();
+  }
+
+  // Glyph matrix of an input point, built like the vtkTransform of the serial
+  // loop: translation, then orientation, then scaling.
+  void ComputeMatrix(vtkIdType ptId, const double scale[3], const double v[3], double vMag,
+    double matrix[16]) const
+  {
+    double rotation[16];
+    vtkMatrix4x4::Identity(rotation);
+    if (this->HaveVectors && this->Orient)
+    {
+      if (this->VectorMode == VTK_FOLLOW_CAMERA_DIRECTION)
+      {
+        // Columns are the glyph right, up and normal directions in world coordinates
+        double right[3], up[3];
+        vtkMath::Cross(this->CameraViewUp, v, right);
+        vtkMath::Cross(v, right, up);
+        for (int i = 0; i < 3; ++i)
+        {
+          rotation[4 * i] = right[i];
+          rotation[4 * i + 1] = up[i];
+          rotation[4 * i + 2] = v[i];
+        }
+      }
+      else if (vMag > 0.0)
+      {
+        if (v[1] == 0.0 && v[2] == 0.0)
+        {
+          if (v[0] < 0)
+          {
+            vtkMatrix4x4::MatrixFromRotation(180.0, 0, 1, 0, rotation);
+          }
+        }
+        else
+        {
+          vtkMatrix4x4::MatrixFromRotation(
+            180.0, (v[0] + vMag) / 2.0, v[1] / 2.0, v[2] / 2.0, rotation);
+        }
+      }
+    }
+
+    double x[3];
+    this->Input->GetPoint(ptId, x);
+    vtkMatrix4x4::Identity(matrix);
+    for (int i = 0; i < 3; ++i)
+    {
+      for (int j = 0; j < 3; ++j)
+      {
+        matrix[4 * i + j] = rotation[4 * i + j] * scale[j];
+      }
+      matrix[4 * i + 3] = x[i];
+    }
+  }
+
+  template <typename TPoints>
+  static void TransformPoints(
+    const double matrix[16], const double* inPts, vtkIdType numPts, TPoints* outPts)
+  {
+    for (vtkIdType i = 0; i < numPts; ++i, inPts += 3, outPts += 3)
+    {
+      for (int j = 0; j < 3; ++j)
+      {
+        outPts[j] = static_cast<TPoints>(matrix[4 * j] * inPts[0] + matrix[4 * j + 1] * inPts[1] +
+          matrix[4 * j + 2] * inPts[2] + matrix[4 * j + 3]);
+      }
+    }
+  }
+
+  void WriteGlyph(vtkIdType ptId)
+  {
+    const GlyphSource& glyph = this->Sources[this->GlyphIds[ptId]];
+    const vtkIdType outPtId = this->PointOffsets[ptId];
+    const vtkIdType numGlyphPts = glyph.NumberOfPoints;
+
+    double s, scale[3], v[3], vMag;
+    this->GetPointScale(ptId, s, scale, v, vMag);
+
+    // Topology, unless the cells are inserted afterwards by InsertCells()
+    const vtkIdType outCellId = this->CellOffsets[ptId];
+    if (this->CellsType != MIXED_CELLS)
+    {
+      const vtkIdType outConnId = this->ConnectivityOffsets[ptId];
+      for (vtkIdType i = 0; i < glyph.NumberOfCells; ++i)
+      {
+        this->OutOffsets[outCellId + i] = outConnId + glyph.Offsets[i];
+      }
+      vtkIdType* outConn = this->OutConnectivity + outConnId;
+      for (const vtkIdType id : glyph.Connectivity)
+      {
+        *outConn++ = id + outPtId;
+      }
+    }
+
+    // Attributes not depending on the glyph matrix
+    if (this->OutVectors)
+    {
+      double glyphVector[3] = { v[0], v[1], v[2] };
+      if (!this->PreviousGlyphPoints.empty() && this->PreviousGlyphPoints[ptId] >= 0)
+      {
+        this->GetCameraDirection(this->PreviousGlyphPoints[ptId], glyphVector);
+      }
+      for (vtkIdType i = 0; i < numGlyphPts; ++i)
+      {
+        std::copy(glyphVector, glyphVector + 3, this->OutVectors + 3 * (outPtId + i));
+      }
+    }
+    if (this->OutTCoords)
+    {
+      const int numComps = glyph.NumberOfTCoordsComponents;
+      std::copy(glyph.TCoords.begin(), glyph.TCoords.end(),
+        this->OutTCoords + numComps * outPtId);
+    }
+    if (this->OutScalars)
+    {
+      const float value = static_cast<float>(
+        this->ColorMode == VTK_COLOR_BY_VECTOR ? vMag : scale[0]);
+      std::fill_n(this->OutScalars + outPtId, numGlyphPts, value);
+    }
+    if (this->OutPointIds)
+    {
+      std::fill_n(this->OutPointIds + outPtId, numGlyphPts, ptId);
+    }
+    for (vtkIdType i = 0; i < numGlyphPts; ++i)
+    {
+      this->ColorScalars.Copy(ptId, outPtId + i);
+      this->PointArrays.Copy(ptId, outPtId + i);
+    }
+    for (vtkIdType i = 0; i < glyph.NumberOfCells; ++i)
+    {
+      this->CellArrays.Copy(ptId, outCellId + i);
+    }
+
+    // Scale the glyph
+    if (this->Scaling)
+    {
+      if (this->ScaleMode == VTK_DATA_SCALING_OFF)
+      {
+        scale[0] = scale[1] = scale[2] = this->ScaleFactor;
+      }
+      else
+      {
+        for (int i = 0; i < 3; ++i)
+        {
+          scale[i] *= this->ScaleFactor;
+        }
+      }
+      for (int i = 0; i < 3; ++i)
+      {
+        if (scale[i] == 0.0)
+        {
+          scale[i] = 1.0e-10;
+        }
+      }
+    }
+    else
+    {
+      scale[0] = scale[1] = scale[2] = 1.0;
+    }
+
+    double matrix[16];
+    this->ComputeMatrix(ptId, scale, v, vMag, matrix);
+    if (this->DoublePoints)
+    {
+      ThreadedGlyphs::TransformPoints(matrix, glyph.Points.data(), numGlyphPts,
+        static_cast<double*>(this->OutPoints) + 3 * outPtId);
+    }
+    else
+    {
+      ThreadedGlyphs::TransformPoints(matrix, glyph.Points.data(), numGlyphPts,
+        static_cast<float*>(this->OutPoints) + 3 * outPtId);
+    }
+
+    if (this->OutNormals)
+    {
+      // Normals are multiplied by the transposed inverse matrix
+      double normalMatrix[16];
+      vtkMatrix4x4::Invert(matrix, normalMatrix);
+      vtkMatrix4x4::Transpose(normalMatrix, normalMatrix);
+      const double* inNormal = glyph.Normals.data();
+      float* outNormal = this->OutNormals + 3 * outPtId;
+      for (vtkIdType i = 0; i < numGlyphPts; ++i, inNormal += 3, outNormal += 3)
+      {
+        double normal[3];
+        for (int j = 0; j < 3; ++j)
+        {
+          normal[j] = normalMatrix[4 * j] * inNormal[0] + normalMatrix[4 * j + 1] * inNormal[1] +
+            normalMatrix[4 * j + 2] * inNormal[2];
+        }
+        vtkMath::Normalize(normal);
+        std::copy(normal, normal + 3, outNormal);
+      }
+    }
+  }
+
+  // Size the output, write the glyphs and attach the resulting arrays to the
+  // output. inPD is the input point data to copy, if any.
+  void Execute(vtkPolyData* output, vtkPointData* inPD)
+  {
+    vtkIdType numPts, numCells, connSize;
+    this->ComputeOffsets(numPts, numCells, connSize);
+
+    vtkPointData* outputPD = output->GetPointData();
+    vtkCellData* outputCD = output->GetCellData();
+    if (inPD)
+    {
+      outputPD->CopyAllocate(inPD, numPts);
+      this->PointArrays.AddArrays(numPts, inPD, outputPD, 0.0, false);
+      if (this->Filter->GetFillCellData())
+      {
+        outputCD->CopyGlobalIdsOn();
+        outputCD->CopyAllocate(inPD, numCells);
+        this->CellArrays.AddArrays(numCells, inPD, outputCD, 0.0, false);
+      }
+    }
+
+    vtkNew<vtkPoints> newPts;
+    this->DoublePoints =
+      this->Filter->GetOutputPointsPrecision() == vtkAlgorithm::DOUBLE_PRECISION;
+    if (this->DoublePoints)
+    {
+      vtkNew<vtkDoubleArray> pointsData;
+      pointsData->SetNumberOfComponents(3);
+      pointsData->SetNumberOfTuples(numPts);
+      this->OutPoints = pointsData->GetPointer(0);
+      newPts->SetData(pointsData);
+    }
+    else
+    {
+      vtkNew<vtkFloatArray> pointsData;
+      pointsData->SetNumberOfComponents(3);
+      pointsData->SetNumberOfTuples(numPts);
+      this->OutPoints = pointsData->GetPointer(0);
+      newPts->SetData(pointsData);
+    }
+
+    if (this->Filter->GetGeneratePointIds())
+    {
+      vtkNew<vtkIdTypeArray> pointIds;
+      pointIds->SetName(this->Filter->GetPointIdsName());
+      pointIds->SetNumberOfValues(numPts);
+      outputPD->AddArray(pointIds);
+      this->OutPointIds = pointIds->GetPointer(0);
+    }
+
+    vtkSmartPointer<vtkDataArray> newScalars;
+    if (this->ColorMode == VTK_COLOR_BY_SCALAR && this->CScalars)
+    {
+      vtkStdString name = this->CScalars->GetName() ? this->CScalars->GetName() : "";
+      newScalars = vtkDataArray::SafeDownCast(
+        this->ColorScalars.AddArrayPair(numPts, this->CScalars, name, 0.0, false));
+      newScalars->SetName(this->CScalars->GetName());
+    }
+    else if ((this->ColorMode == VTK_COLOR_BY_SCALE && this->SScalars) ||
+      (this->ColorMode == VTK_COLOR_BY_VECTOR && this->HaveVectors))
+    {
+      vtkNew<vtkFloatArray> scalars;
+      scalars->SetNumberOfTuples(numPts);
+      if (this->ColorMode == VTK_COLOR_BY_VECTOR)
+      {
+        scalars->SetName("VectorMagnitude");
+      }
+      else
+      {
+        scalars->SetName(
+          this->ScaleMode == VTK_SCALE_BY_SCALAR ? this->SScalars->GetName() : "GlyphScale");
+      }
+      this->OutScalars = scalars->GetPointer(0);
+      newScalars = scalars;
+    }
+
+    vtkNew<vtkFloatArray> newVectors;
+    if (this->HaveVectors)
+    {
+      newVectors->SetNumberOfComponents(3);
+      newVectors->SetNumberOfTuples(numPts);
+      newVectors->SetName("GlyphVector");
+      this->OutVectors = newVectors->GetPointer(0);
+    }
+    vtkNew<vtkFloatArray> newNormals;
+    if (this->HaveNormals)
+    {
+      newNormals->SetNumberOfComponents(3);
+      newNormals->SetNumberOfTuples(numPts);
+      newNormals->SetName("Normals");
+      this->OutNormals = newNormals->GetPointer(0);
+    }
+    vtkNew<vtkFloatArray> newTCoords;
+    if (this->HaveTCoords)
+    {
+      newTCoords->SetNumberOfComponents(this->Sources[0].NumberOfTCoordsComponents);
+      newTCoords->SetNumberOfTuples(numPts);
+      newTCoords->SetName("TCoords");
+      this->OutTCoords = newTCoords->GetPointer(0);
+    }
+
+    vtkNew<vtkIdTypeArray> offsets;
+    vtkNew<vtkIdTypeArray> connectivity;
+    if (this->CellsType != MIXED_CELLS)
+    {
+      offsets->SetNumberOfValues(numCells + 1);
+      offsets->SetValue(numCells, connSize);
+      this->OutOffsets = offsets->GetPointer(0);
+      connectivity->SetNumberOfValues(connSize);
+      this->OutConnectivity = connectivity->GetPointer(0);
+    }
+
+    this->WriteGlyphs();
+
+    output->SetPoints(newPts);
+    vtkNew<vtkCellArray> cells;
+    if (this->CellsType != MIXED_CELLS)
+    {
+      cells->SetData(offsets, connectivity);
+    }
+    switch (this->CellsType)
+    {
+      case VERTS:
+        output->SetVerts(cells);
+        break;
+      case LINES:
+        output->SetLines(cells);
+        break;
+      case POLYS:
+        output->SetPolys(cells);
+        break;
+      case STRIPS:
+        output->SetStrips(cells);
+        break;
+      case MIXED_CELLS:
+        this->InsertCells(output, numCells);
+        break;
+      default:
+        break;
+    }
+
+    if (newScalars)
+    {
+      int idx = outputPD->AddArray(newScalars);
+      outputPD->SetActiveAttribute(idx, vtkDataSetAttributes::SCALARS);
+    }
+    if (this->HaveVectors)
+    {
+      outputPD->SetVectors(newVectors);
+    }
+    if (this->HaveNormals)
+    {
+      outputPD->SetNormals(newNormals);
+    }
+    if (this->HaveTCoords)
+    {
+      outputPD->SetTCoords(newTCoords);
+    }
+  }
+
+  void WriteGlyphs()
+  {
+    const vtkIdType numInPts = static_cast<vtkIdType>(this->GlyphIds.size());
+    vtkSMPTools::For(0, numInPts,
+      [&](vtkIdType begin, vtkIdType end)
+      {
+        const bool isFirst = vtkSMPTools::GetSingleThread();
+        for (vtkIdType ptId = begin; ptId < end; ++ptId)
+        {
+          if (ptId % 10000 == 0)
+          {
+            if (isFirst)
+            {
+              this->Filter->UpdateProgress(static_cast<double>(ptId) / numInPts);
+              this->Filter->CheckAbort();
+            }
+            if (this->Filter->GetAbortOutput())
+            {
+              break;
+            }
+          }
+          if (this->GlyphIds[ptId] >= 0)
+          {
+            this->WriteGlyph(ptId);
+          }
+        }
+      });
+  }
+
+  // vtkPolyData numbers the cells inserted one by one in insertion order, which
+  // the glyph cell ids then follow: insert the cells of mixed kinds serially.
+  void InsertCells(vtkPolyData* output, vtkIdType numCells) const
+  {
+    output->AllocateEstimate(numCells, 3);
+    std::vector<vtkIdType> pts;
+    const vtkIdType numInPts = static_cast<vtkIdType>(this->GlyphIds.size());
+    for (vtkIdType ptId = 0; ptId < numInPts && !this->Filter->GetAbortOutput(); ++ptId)
+    {
+      if (this->GlyphIds[ptId] < 0)
+      {
+        continue;
+      }
+      const GlyphSource& glyph = this->Sources[this->GlyphIds[ptId]];
+      const vtkIdType outPtId = this->PointOffsets[ptId];
+      for (vtkIdType i = 0; i < glyph.NumberOfCells; ++i)
+      {
+        pts.assign(glyph.Connectivity.begin() + glyph.Offsets[i],
+          glyph.Connectivity.begin() + glyph.Offsets[i + 1]);
+        for (vtkIdType& id : pts)
+        {
+          id += outPtId;
+        }
+        output->InsertNextCell(glyph.CellTypes[i], static_cast<int>(pts.size()), pts.data());
+      }
+    }
+    output->Squeeze();
+  }
+};
+} // anonymous namespace
+
 vtkStandardNewMacro(vtkGlyph3D);
 vtkCxxSetObjectMacro(vtkGlyph3D, SourceTransform, vtkTransform);
 
@@ -127,40 +904,16 @@ bool vtkGlyph3D::Execute(vtkDataSet* input, vtkInformationVector* sourceVector,
   vtkPointData* pd;
   vtkDataArray* inCScalars; // Scalars for Coloring
   unsigned char* inGhostLevels = nullptr;
-  vtkDataArray *inNormals, *sourceNormals = nullptr;
-  vtkDataArray* sourceTCoords = nullptr;
-  vtkIdType numPts, numSourcePts, numSourceCells, inPtId, i;
-  vtkPoints* sourcePts = nullptr;
-  vtkSmartPointer<vtkPoints> transformedSourcePts = vtkSmartPointer<vtkPoints>::New();
-  vtkPoints* newPts;
-  vtkDataArray* newScalars = nullptr;
-  vtkDataArray* newVectors = nullptr;
-  vtkDataArray* newNormals = nullptr;
-  vtkDataArray* newTCoords = nullptr;
-  double x[3], v[3], vNew[3], s = 0.0, vMag = 0.0, value, tc[3];
-  vtkTransform* trans = vtkTransform::New();
-  vtkNew<vtkIdList> pointIdList;
-  vtkIdList* cellPts;
-  int npts;
-  vtkIdList* pts;
-  vtkIdType ptIncr, cellIncr, cellId;
-  int haveVectors, haveNormals, haveTCoords = 0;
-  double scalex, scaley, scalez, den;
+  vtkDataArray* inNormals;
+  vtkIdType numPts;
+  int haveVectors;
+  double den;
   vtkPointData* outputPD = output->GetPointData();
-  vtkCellData* outputCD = output->GetCellData();
   int numberOfSources = this->GetNumberOfInputConnections(1);
-  vtkIdTypeArray* pointIds = nullptr;
   vtkSmartPointer<vtkPolyData> source = this->GetSource(0, sourceVector);
-  vtkNew<vtkIdList> srcPointIdList;
-  vtkNew<vtkIdList> dstPointIdList;
-  vtkNew<vtkIdList> srcCellIdList;
-  vtkNew<vtkIdList> dstCellIdList;
 
   vtkDebugMacro(<< "Generating glyphs");
 
-  pts = vtkIdList::New();
-  pts->Allocate(VTK_CELL_SIZE);
-
   pd = input->GetPointData();
   inNormals = this->GetInputArrayToProcess(2, input);
   inCScalars = this->GetInputArrayToProcess(3, input);
@@ -187,8 +940,6 @@ bool vtkGlyph3D::Execute(vtkDataSet* input, vtkInformationVector* sourceVector,
   if (numPts < 1)
   {
     vtkDebugMacro(<< "No points to glyph!");
-    pts->Delete();
-    trans->Delete();
     return true;
   }
 
@@ -218,8 +969,6 @@ bool vtkGlyph3D::Execute(vtkDataSet* input, vtkInformationVector* sourceVector,
     if (source == nullptr)
     {
       vtkErrorMacro(<< "Indexing on but don't have data to index with");
-      pts->Delete();
-      trans->Delete();
       return true;
     }
     else
@@ -251,490 +1000,48 @@ bool vtkGlyph3D::Execute(vtkDataSet* input, vtkInformationVector* sourceVector,
     source = defaultSource;
   }
 
-  if (this->IndexMode != VTK_INDEXING_OFF)
-  {
-    pd = nullptr;
-    haveNormals = 1;
-    for (numSourcePts = numSourceCells = i = 0; i < numberOfSources; i++)
-    {
-      source = this->GetSource(i, sourceVector);
-      if (source != nullptr)
-      {
-        numSourcePts = std::max(source->GetNumberOfPoints(), numSourcePts);
-        numSourceCells = std::max(source->GetNumberOfCells(), numSourceCells);
-        if (!(sourceNormals = source->GetPointData()->GetNormals()))
-        {
-          haveNormals = 0;
-        }
-      }
-    }
-  }
-  else
-  {
-    sourcePts = source->GetPoints();
-    numSourcePts = sourcePts->GetNumberOfPoints();
-    numSourceCells = source->GetNumberOfCells();
-
-    sourceNormals = source->GetPointData()->GetNormals();
-    if (sourceNormals)
-    {
-      haveNormals = 1;
-    }
-    else
-    {
-      haveNormals = 0;
-    }
-
-    sourceTCoords = source->GetPointData()->GetTCoords();
-    if (sourceTCoords)
-    {
-      haveTCoords = 1;
-    }
-    else
-    {
-      haveTCoords = 0;
-    }
-
-    // Prepare to copy output.
-    pd = input->GetPointData();
-    outputPD->CopyAllocate(pd, numPts * numSourcePts);
-    if (this->FillCellData)
-    {
-      outputCD->CopyGlobalIdsOn();
-      outputCD->CopyAllocate(pd, numPts * numSourceCells);
-    }
-  }
-
-  srcPointIdList->SetNumberOfIds(numSourcePts);
-  dstPointIdList->SetNumberOfIds(numSourcePts);
-  srcCellIdList->SetNumberOfIds(numSourceCells);
-  dstCellIdList->SetNumberOfIds(numSourceCells);
-
-  newPts = vtkPoints::New();
-
-  // Set the desired precision for the points in the output.
-  if (this->OutputPointsPrecision == vtkAlgorithm::DEFAULT_PRECISION)
-  {
-    newPts->SetDataType(VTK_FLOAT);
-  }
-  else if (this->OutputPointsPrecision == vtkAlgorithm::SINGLE_PRECISION)
-  {
-    newPts->SetDataType(VTK_FLOAT);
-  }
-  else if (this->OutputPointsPrecision == vtkAlgorithm::DOUBLE_PRECISION)
+  vtkDataArray* array3D = this->VectorMode == VTK_USE_NORMAL ? inNormals : inVectors;
+  if (haveVectors && this->VectorMode != VTK_FOLLOW_CAMERA_DIRECTION &&
+    array3D->GetNumberOfComponents() > 3)
   {
-    newPts->SetDataType(VTK_DOUBLE);
+    vtkErrorMacro(<< "vtkDataArray " << array3D->GetName() << " has more than 3 components.\n");
+    return false;
   }
 
-  newPts->Allocate(numPts * numSourcePts);
-  if (this->GeneratePointIds)
-  {
-    pointIds = vtkIdTypeArray::New();
-    pointIds->SetName(this->PointIdsName);
-    pointIds->Allocate(numPts * numSourcePts);
-    outputPD->AddArray(pointIds);
-    pointIds->Delete();
-  }
-  if (this->ColorMode == VTK_COLOR_BY_SCALAR && inCScalars)
-  {
-    newScalars = inCScalars->NewInstance();
-    newScalars->SetNumberOfComponents(inCScalars->GetNumberOfComponents());
-    newScalars->Allocate(inCScalars->GetNumberOfComponents() * numPts * numSourcePts);
-    newScalars->SetName(inCScalars->GetName());
-  }
-  else if ((this->ColorMode == VTK_COLOR_BY_SCALE) && inSScalars)
-  {
-    newScalars = vtkFloatArray::New();
-    newScalars->Allocate(numPts * numSourcePts);
-    newScalars->SetName("GlyphScale");
-    if (this->ScaleMode == VTK_SCALE_BY_SCALAR)
-    {
-      newScalars->SetName(inSScalars->GetName());
-    }
-  }
-  else if ((this->ColorMode == VTK_COLOR_BY_VECTOR) && haveVectors)
-  {
-    newScalars = vtkFloatArray::New();
-    newScalars->Allocate(numPts * numSourcePts);
-    newScalars->SetName("VectorMagnitude");
-  }
-  if (haveVectors)
-  {
-    newVectors = vtkFloatArray::New();
-    newVectors->SetNumberOfComponents(3);
-    newVectors->Allocate(3 * numPts * numSourcePts);
-    newVectors->SetName("GlyphVector");
-  }
-  if (haveNormals)
-  {
-    newNormals = vtkFloatArray::New();
-    newNormals->SetNumberOfComponents(3);
-    newNormals->Allocate(3 * numPts * numSourcePts);
-    newNormals->SetName("Normals");
-  }
-  if (haveTCoords)
-  {
-    newTCoords = vtkFloatArray::New();
-    int numComps = sourceTCoords->GetNumberOfComponents();
-    newTCoords->SetNumberOfComponents(numComps);
-    newTCoords->Allocate(numComps * numPts * numSourcePts);
-    newTCoords->SetName("TCoords");
-  }
-
-  // Setting up for calls to PolyData::InsertNextCell()
-  output->AllocateEstimate(numPts * numSourceCells, 3);
-
-  transformedSourcePts->SetDataTypeToDouble();
-  transformedSourcePts->Allocate(numSourcePts);
-
-  // Traverse all Input points, transforming Source points and copying
-  // point attributes.
-  //
-  ptIncr = 0;
-  cellIncr = 0;
-  for (inPtId = 0; inPtId < numPts; inPtId++)
+  std::vector<vtkPolyData*> sources;
+  if (this->IndexMode != VTK_INDEXING_OFF)
   {
-    scalex = scaley = scalez = 1.0;
-    if (!(inPtId % 10000))
-    {
-      this->UpdateProgress(static_cast<double>(inPtId) / numPts);
-      if (this->CheckAbort())
-      {
-        break;
-      }
-    }
-
-    // Get the scalar and vector data
-    if (inSScalars)
-    {
-      s = inSScalars->GetComponent(inPtId, 0);
-      if (this->ScaleMode == VTK_SCALE_BY_SCALAR || this->ScaleMode == VTK_DATA_SCALING_OFF)
-      {
-        scalex = scaley = scalez = s;
-      }
-    }
-
-    if (haveVectors)
-    {
-      if (this->VectorMode == VTK_FOLLOW_CAMERA_DIRECTION)
-      {
-        vMag = 1.0; // v will be set later
-      }
-      else
-      {
-        vtkDataArray* array3D = this->VectorMode == VTK_USE_NORMAL ? inNormals : inVectors;
-        if (array3D->GetNumberOfComponents() > 3)
-        {
-          vtkErrorMacro(<< "vtkDataArray " << array3D->GetName()
-                        << " has more than 3 components.\n");
-          pts->Delete();
-          trans->Delete();
-          if (newPts)
-          {
-            newPts->Delete();
-          }
-          if (newVectors)
-          {
-            newVectors->Delete();
-          }
-          return false;
-        }
-
-        v[0] = 0;
-        v[1] = 0;
-        v[2] = 0;
-        array3D->GetTuple(inPtId, v);
-        vMag = vtkMath::Norm(v);
-        if (this->ScaleMode == VTK_SCALE_BY_VECTORCOMPONENTS)
-        {
-          scalex = v[0];
-          scaley = v[1];
-          scalez = v[2];
-        }
-        else if (this->ScaleMode == VTK_SCALE_BY_VECTOR)
-        {
-          scalex = scaley = scalez = vMag;
-        }
-      }
-    }
-
-    // Clamp data scale if enabled
-    if (this->Clamping)
-    {
-      scalex = std::min(std::max(scalex, this->Range[0]), this->Range[1]);
-      scalex = (scalex - this->Range[0]) / den;
-      scaley = std::min(std::max(scaley, this->Range[0]), this->Range[1]);
-      scaley = (scaley - this->Range[0]) / den;
-      scalez = std::min(std::max(scalez, this->Range[0]), this->Range[1]);
-      scalez = (scalez - this->Range[0]) / den;
-    }
-
-    // Compute index into table of glyphs
-    if (this->IndexMode != VTK_INDEXING_OFF)
-    {
-      if (this->IndexMode == VTK_INDEXING_BY_SCALAR)
-      {
-        value = s;
-      }
-      else
-      {
-        value = vMag;
-      }
-
-      int index = static_cast<int>((value - this->Range[0]) * numberOfSources / den);
-      index = std::min(std::max(index, 0), numberOfSources - 1);
-
-      source = this->GetSource(index, sourceVector);
-      if (source != nullptr)
-      {
-        sourcePts = source->GetPoints();
-        sourceNormals = source->GetPointData()->GetNormals();
-        numSourcePts = sourcePts->GetNumberOfPoints();
-        numSourceCells = source->GetNumberOfCells();
-      }
-    }
-
-    // Make sure we're not indexing into empty glyph
-    if (source == nullptr)
-    {
-      continue;
-    }
-
-    // Check ghost points.
-    // If we are processing a piece, we do not want to duplicate glyphs on the borders.
-    if (inGhostLevels &&
-      inGhostLevels[inPtId] &
-        (vtkDataSetAttributes::DUPLICATEPOINT | vtkDataSetAttributes::HIDDENPOINT))
-    {
-      continue;
-    }
-
-    if (inputUG && !inputUG->IsPointVisible(inPtId))
-    {
-      // input is a vtkUniformGrid and the current point is blanked. Don't glyph
-      // it.
-      continue;
-    }
-
-    if (!this->IsPointVisible(input, inPtId))
-    {
-      continue;
-    }
-
-    // Now begin copying/transforming glyph
-    trans->Identity();
-
-    // Copy all topology (transformation independent)
-    for (cellId = 0; cellId < numSourceCells; cellId++)
-    {
-      source->GetCellPoints(cellId, pointIdList);
-      cellPts = pointIdList;
-      npts = cellPts->GetNumberOfIds();
-      for (pts->Reset(), i = 0; i < npts; i++)
-      {
-        pts->InsertId(i, cellPts->GetId(i) + ptIncr);
-      }
-      output->InsertNextCell(source->GetCellType(cellId), pts);
-    }
-
-    // translate Source to Input point
-    input->GetPoint(inPtId, x);
-    trans->Translate(x[0], x[1], x[2]);
-
-    if (haveVectors)
-    {
-      // Copy Input vector
-      for (i = 0; i < numSourcePts; i++)
-      {
-        newVectors->InsertTuple(i + ptIncr, v);
-      }
-      if (this->Orient)
-      {
-        if (this->VectorMode == VTK_FOLLOW_CAMERA_DIRECTION)
-        {
-          // v = glyphNormal_World (glyph normal direction in World coordinate system)
-          v[0] = this->FollowedCameraPosition[0] - x[0];
-          v[1] = this->FollowedCameraPosition[1] - x[1];
-          v[2] = this->FollowedCameraPosition[2] - x[2];
-          vtkMath::Normalize(v);
-          double glyphRight_World[3]; // glyph right direction in World coordinate system
-          vtkMath::Cross(this->FollowedCameraViewUp, v, glyphRight_World);
-          // glyph up direction in World coordinate system
-          // (approximately the same as this->FollowedCameraViewUp, but slightly adjusted to be
-          // orthogonal to the normal direction)
-          double glyphUp_World[3];
-          vtkMath::Cross(v, glyphRight_World, glyphUp_World);
-          double glyphToWorld[16] = { glyphRight_World[0], glyphUp_World[0], v[0], 0.0,
-            glyphRight_World[1], glyphUp_World[1], v[1], 0.0, glyphRight_World[2], glyphUp_World[2],
-            v[2], 0.0, 0.0, 0.0, 0.0, 1.0 };
-          trans->Concatenate(glyphToWorld);
-        }
-        else if (vMag > 0.0)
-        {
-          // if there is no y or z component
-          if (v[1] == 0.0 && v[2] == 0.0)
-          {
-            if (v[0] < 0) // just flip x if we need to
-            {
-              trans->RotateWXYZ(180.0, 0, 1, 0);
-            }
-          }
-          else
-          {
-            vNew[0] = (v[0] + vMag) / 2.0;
-            vNew[1] = v[1] / 2.0;
-            vNew[2] = v[2] / 2.0;
-            trans->RotateWXYZ(180.0, vNew[0], vNew[1], vNew[2]);
-          }
-        }
-      }
-    }
-
-    if (haveTCoords)
-    {
-      for (i = 0; i < numSourcePts; i++)
-      {
-        sourceTCoords->GetTuple(i, tc);
-        newTCoords->InsertTuple(i + ptIncr, tc);
-      }
-    }
-
-    // determine scale factor from scalars if appropriate
-    // Copy scalar value
-    if (inSScalars && (this->ColorMode == VTK_COLOR_BY_SCALE))
+    for (int i = 0; i < numberOfSources; i++)
     {
-      for (i = 0; i < numSourcePts; i++)
-      {
-        newScalars->InsertTuple(i + ptIncr, &scalex); // = scaley = scalez
-      }
-    }
-    else if (inCScalars && (this->ColorMode == VTK_COLOR_BY_SCALAR))
-    {
-      for (i = 0; i < numSourcePts; i++)
-      {
-        outputPD->CopyTuple(inCScalars, newScalars, inPtId, ptIncr + i);
-      }
-    }
-    if (haveVectors && this->ColorMode == VTK_COLOR_BY_VECTOR)
-    {
-      for (i = 0; i < numSourcePts; i++)
-      {
-        newScalars->InsertTuple(i + ptIncr, &vMag);
-      }
+      sources.push_back(this->GetSource(i, sourceVector));
     }
-
-    // scale data if appropriate
-    if (this->Scaling)
-    {
-      if (this->ScaleMode == VTK_DATA_SCALING_OFF)
-      {
-        scalex = scaley = scalez = this->ScaleFactor;
-      }
-      else
-      {
-        scalex *= this->ScaleFactor;
-        scaley *= this->ScaleFactor;
-        scalez *= this->ScaleFactor;
-      }
-
-      if (scalex == 0.0)
-      {
-        scalex = 1.0e-10;
-      }
-      if (scaley == 0.0)
-      {
-        scaley = 1.0e-10;
-      }
-      if (scalez == 0.0)
-      {
-        scalez = 1.0e-10;
-      }
-      trans->Scale(scalex, scaley, scalez);
-    }
-
-    // multiply points and normals by resulting matrix
-    if (this->SourceTransform)
-    {
-      transformedSourcePts->Reset();
-      this->SourceTransform->TransformPoints(sourcePts, transformedSourcePts);
-      trans->TransformPoints(transformedSourcePts, newPts);
-    }
-    else
-    {
-      trans->TransformPoints(sourcePts, newPts);
-    }
-
-    if (haveNormals)
-    {
-      trans->TransformNormals(sourceNormals, newNormals);
-    }
-
-    // Copy point data from source (if possible)
-    if (pd)
-    {
-      for (i = 0; i < numSourcePts; ++i)
-      {
-        srcPointIdList->SetId(i, inPtId);
-        dstPointIdList->SetId(i, ptIncr + i);
-      }
-      outputPD->CopyData(pd, srcPointIdList, dstPointIdList);
-      if (this->FillCellData)
-      {
-        for (i = 0; i < numSourceCells; ++i)
-        {
-          srcCellIdList->SetId(i, inPtId);
-          dstCellIdList->SetId(i, cellIncr + i);
-        }
-        outputCD->CopyData(pd, srcCellIdList, dstCellIdList);
-      }
-    }
-
-    // If point ids are to be generated, do it here
-    if (this->GeneratePointIds)
-    {
-      for (i = 0; i < numSourcePts; i++)
-      {
-        pointIds->InsertNextValue(inPtId);
-      }
-    }
-
-    ptIncr += numSourcePts;
-    cellIncr += numSourceCells;
   }
-
-  // Update ourselves and release memory
-  //
-  output->SetPoints(newPts);
-  newPts->Delete();
-
-  if (newScalars)
-  {
-    int idx = outputPD->AddArray(newScalars);
-    outputPD->SetActiveAttribute(idx, vtkDataSetAttributes::SCALARS);
-    newScalars->Delete();
-  }
-
-  if (newVectors)
-  {
-    outputPD->SetVectors(newVectors);
-    newVectors->Delete();
-  }
-
-  if (newNormals)
+  else
   {
-    outputPD->SetNormals(newNormals);
-    newNormals->Delete();
+    sources.push_back(source);
   }
 
-  if (newTCoords)
+  ThreadedGlyphs glyphs(this, input);
+  glyphs.InputUG = inputUG;
+  glyphs.GhostLevels = inGhostLevels;
+  glyphs.SScalars = inSScalars;
+  glyphs.CScalars = inCScalars;
+  glyphs.Array3D = array3D;
+  glyphs.HaveVectors = haveVectors != 0;
+  glyphs.Den = den;
+  glyphs.NumberOfSources = numberOfSources;
+  glyphs.GatherSources(sources);
+
+  // Make the dataset accessors thread safe before the threads use them
+  double x[3];
+  input->GetPoint(0, x);
+  if (inputUG)
   {
-    outputPD->SetTCoords(newTCoords);
-    newTCoords->Delete();
+    inputUG->GetPointGhostArray();
   }
 
-  output->Squeeze();
-  trans->Delete();
-  pts->Delete();
+  // Point data is only copied when a single glyph is used
+  glyphs.Execute(output, this->IndexMode == VTK_INDEXING_OFF ? pd : nullptr);
 
   return true;
 }
@@ -22,6 +22,12 @@
  * you'll have to decide whether to index into it with scalar value or with
  * vector magnitude.
  *
+ * The glyphs are generated with vtkSMPTools: the output is sized up front from
+ * the glyph selected at each input point, then the points, cells and attributes
+ * of the glyphs are written concurrently. When the cells of the glyphs are of
+ * different kinds (e.g. vertices and polygons), they are inserted serially
+ * afterwards, so that the output cell ids follow the input points.
+ *
  * @warning
  * The scaling of the glyphs is controlled by the ScaleFactor ivar multiplied
  * by the scalar value at each point (if VTK_SCALE_BY_SCALAR is set), or
@@ -41,10 +41,46 @@
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkPriorityQueue.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkTriangle.h"
 #include "vtkType.h"
 
+#include <algorithm>
+#include <atomic>
+
 VTK_ABI_NAMESPACE_BEGIN
+namespace
+{
+// Per thread scratch buffers used to compute the edge collapse costs in parallel
+struct CostWorkspace
+{
+  std::vector<double> X;
+  std::vector<double> Quad;
+  std::vector<double> B;
+  std::vector<double> Data;
+  std::vector<double*> A;
+
+  void Initialize(int size, int quadSize)
+  {
+    if (!this->X.empty())
+    {
+      return;
+    }
+    this->X.resize(size);
+    this->Quad.resize(quadSize);
+    this->B.resize(size);
+    this->Data.resize(size * size);
+    this->A.resize(size);
+    for (int i = 0; i < size; i++)
+    {
+      this->A[i] = this->Data.data() + i * size;
+    }
+  }
+};
+}
+
 vtkStandardNewMacro(vtkQuadricDecimation);
 
 //------------------------------------------------------------------------------
@@ -54,7 +90,6 @@ vtkQuadricDecimation::vtkQuadricDecimation()
   this->EdgeCosts = vtkPriorityQueue::New();
   this->EndPoint1List = vtkIdList::New();
   this->EndPoint2List = vtkIdList::New();
-  this->ErrorQuadrics = nullptr;
   this->VolumeConstraints = nullptr;
   this->TargetPoints = vtkDoubleArray::New();
 
@@ -188,23 +223,21 @@ void vtkQuadricDecimation::SetPointAttributeArray(vtkIdType ptId[2], const doubl
       continue;
     }
 
-    std::vector<double> res(dArray->GetNumberOfComponents(), 0.0);
-    std::vector<double> buffer(dArray->GetNumberOfComponents(), 0.0);
-    dArray->GetTuple(ptId[0], res.data());
-    for (auto& val : res)
-    {
-      val *= weightBegin;
-    }
-    dArray->GetTuple(ptId[1], buffer.data());
-    for (auto& val : buffer)
+    // reuse the same scratch buffer for all the collapses to avoid allocations
+    const int numComp = dArray->GetNumberOfComponents();
+    if (this->TempTuples.size() < static_cast<std::size_t>(2 * numComp))
     {
-      val *= weightEnd;
+      this->TempTuples.resize(2 * numComp);
     }
-    for (std::size_t comp = 0; comp < res.size(); ++comp)
+    double* res = this->TempTuples.data();
+    double* buffer = res + numComp;
+    dArray->GetTuple(ptId[0], res);
+    dArray->GetTuple(ptId[1], buffer);
+    for (int comp = 0; comp < numComp; ++comp)
     {
-      res[comp] += buffer[comp];
+      res[comp] = res[comp] * weightBegin + buffer[comp] * weightEnd;
     }
-    dArray->SetTuple(ptId[0], res.data());
+    dArray->SetTuple(ptId[0], res);
   }
 }
 
@@ -310,7 +343,6 @@ int vtkQuadricDecimation::RequestData(vtkInformation* vtkNotUsed(request),
   this->Mesh->EditableOn();
   this->Mesh->BuildLinks();
 
-  this->ErrorQuadrics = new vtkQuadricDecimation::ErrorQuadric[numPts];
   if (this->VolumePreservation)
   {
     this->VolumeConstraints = new double[numPts * 4];
@@ -352,6 +384,7 @@ int vtkQuadricDecimation::RequestData(vtkInformation* vtkNotUsed(request),
   }
   x = new double[3 + this->NumberOfComponents + this->VolumePreservation];
   this->CollapseCellIds = vtkIdList::New();
+  this->ChangedEdges = vtkIdList::New();
   this->TempX = new double[3 + this->NumberOfComponents + this->VolumePreservation];
   this->TempQuad = new double[11 + (4 * this->NumberOfComponents) + this->VolumePreservation];
 
@@ -374,19 +407,35 @@ int vtkQuadricDecimation::RequestData(vtkInformation* vtkNotUsed(request),
   this->UpdateProgress(0.15);
 
   vtkDebugMacro(<< "Computing Costs");
-  // Compute the cost of and target point for collapsing each edge.
-  for (i = 0; i < this->Edges->GetNumberOfEdges(); i++)
-  {
-    if (this->AttributeErrorMetric)
-    {
-      cost = this->ComputeCost2(i, x);
-    }
-    else
+  // Compute the cost of and target point for collapsing each edge in
+  // parallel, then fill the priority queue in edge order.
+  const vtkIdType numEdges = this->Edges->GetNumberOfEdges();
+  const int size = 3 + this->NumberOfComponents + this->VolumePreservation;
+  const int quadSize = 11 + 4 * this->NumberOfComponents;
+  std::vector<double> costs(numEdges);
+  this->TargetPoints->SetNumberOfTuples(numEdges);
+  vtkSMPThreadLocal<CostWorkspace> workspaces;
+  vtkSMPTools::For(0, numEdges,
+    [&](vtkIdType begin, vtkIdType end)
     {
-      cost = this->ComputeCost(i, x);
-    }
-    this->EdgeCosts->Insert(cost, i);
-    this->TargetPoints->InsertTuple(i, x);
+      CostWorkspace& ws = workspaces.Local();
+      ws.Initialize(size, quadSize);
+      for (vtkIdType id = begin; id < end; ++id)
+      {
+        if (this->AttributeErrorMetric)
+        {
+          costs[id] = this->ComputeCost2(id, ws.X.data(), ws.Quad.data(), ws.A.data(), ws.B.data());
+        }
+        else
+        {
+          costs[id] = this->ComputeCost(id, ws.X.data(), ws.Quad.data());
+        }
+        this->TargetPoints->SetTypedTuple(id, ws.X.data());
+      }
+    });
+  for (i = 0; i < numEdges; i++)
+  {
+    this->EdgeCosts->Insert(costs[i], i);
   }
   this->UpdateProgress(0.20);
 
@@ -446,16 +495,14 @@ int vtkQuadricDecimation::RequestData(vtkInformation* vtkNotUsed(request),
                 << " Cost: " << cost);
 
   // clean up working data
-  for (i = 0; i < numPts; i++)
-  {
-    delete[] this->ErrorQuadrics[i].Quadric;
-  }
-  delete[] this->ErrorQuadrics;
+  this->ErrorQuadrics.clear();
+  this->ErrorQuadrics.shrink_to_fit();
 
   if (this->VolumePreservation)
     delete[] this->VolumeConstraints;
   delete[] x;
   this->CollapseCellIds->Delete();
+  this->ChangedEdges->Delete();
   delete[] this->TempX;
   delete[] this->TempQuad;
   delete[] this->TempB;
@@ -465,7 +512,7 @@ int vtkQuadricDecimation::RequestData(vtkInformation* vtkNotUsed(request),
   // copy the simplified mesh from the working mesh to the output mesh
   for (i = 0; i < this->Mesh->GetNumberOfCells(); i++)
   {
-    if (this->Mesh->GetCell(i)->GetCellType() != VTK_EMPTY_CELL)
+    if (this->Mesh->GetCellType(i) != VTK_EMPTY_CELL)
     {
       outputCellList->InsertNextId(i);
     }
@@ -500,22 +547,7 @@ int vtkQuadricDecimation::RequestData(vtkInformation* vtkNotUsed(request),
 void vtkQuadricDecimation::InitializeQuadrics(vtkIdType numPts)
 {
   vtkPolyData* input = this->Mesh;
-  std::vector<double> QEM;
-  vtkIdType ptId;
-  int i, j;
-  vtkCellArray* polys;
-  vtkIdType npts;
-  const vtkIdType* pts = nullptr;
-  double point0[3], point1[3], point2[3];
-  double n[3];
-  double tempP1[3], tempP2[3], d, triArea2;
-  double data[16];
-  double *A[4], x[4];
-  int index[4];
-  A[0] = data;
-  A[1] = data + 4;
-  A[2] = data + 8;
-  A[3] = data + 12;
+  const int quadSize = 11 + 4 * this->NumberOfComponents;
 
   double regularizationVariance = 0.0;
   if (this->Regularize)
@@ -523,23 +555,26 @@ void vtkQuadricDecimation::InitializeQuadrics(vtkIdType numPts)
     regularizationVariance = std::pow(this->Regularization, 2);
   }
 
-  // allocate local QEM sparse matrix
-  QEM.resize(11 + (4 * this->NumberOfComponents));
-
   // clear and allocate global QEM array
-  for (ptId = 0; ptId < numPts; ptId++)
-  {
-    this->ErrorQuadrics[ptId].Quadric = new double[11 + (4 * this->NumberOfComponents)];
-    for (i = 0; i < 11 + 4 * this->NumberOfComponents; i++)
-    {
-      this->ErrorQuadrics[ptId].Quadric[i] = 0.0;
-    }
-  }
+  this->ErrorQuadrics.assign(numPts * quadSize, 0.0);
 
-  polys = input->GetPolys();
-  // compute the QEM for each face
-  for (polys->InitTraversal(); polys->GetNextCell(npts, pts);)
+  // Compute the QEM of a triangle together with its unit normal n, its
+  // plane offset d and its area. Return false if the attribute part of the
+  // QEM could not be computed.
+  auto computeTriangleQEM =
+    [&](const vtkIdType* pts, double* QEM, double n[3], double& d, double& triArea2)
   {
+    int i;
+    double point0[3], point1[3], point2[3];
+    double tempP1[3], tempP2[3];
+    double data[16];
+    double *A[4], x[4];
+    int index[4];
+    A[0] = data;
+    A[1] = data + 4;
+    A[2] = data + 8;
+    A[3] = data + 12;
+
     input->GetPoint(pts[0], point0);
     input->GetPoint(pts[1], point1);
     input->GetPoint(pts[2], point2);
@@ -588,242 +623,335 @@ void vtkQuadricDecimation::InitializeQuadrics(vtkIdType numPts)
         regularizationVariance * (vtkMath::Dot(point0, point0) + 1 + 3 * regularizationVariance);
     }
 
-    if (this->AttributeErrorMetric)
+    if (!this->AttributeErrorMetric)
     {
-      for (i = 0; i < 3; i++)
+      return true;
+    }
+
+    for (i = 0; i < 3; i++)
+    {
+      A[0][i] = point0[i];
+      A[1][i] = point1[i];
+      A[2][i] = point2[i];
+      A[3][i] = n[i];
+    }
+    A[0][3] = A[1][3] = A[2][3] = 1;
+    A[3][3] = 0;
+
+    // should handle poorly condition matrix better
+    if (!vtkMath::LUFactorLinearSystem(A, index, 4))
+    {
+      std::fill(QEM + 11, QEM + 11 + 4 * this->NumberOfComponents, 0.0);
+      return false;
+    }
+
+    for (i = 0; i < this->NumberOfComponents; i++)
+    {
+      x[3] = 0;
+      if (i < this->AttributeComponents[0])
       {
-        A[0][i] = point0[i];
-        A[1][i] = point1[i];
-        A[2][i] = point2[i];
-        A[3][i] = n[i];
+        x[0] =
+          input->GetPointData()->GetScalars()->GetComponent(pts[0], i) * this->AttributeScale[0];
+        x[1] =
+          input->GetPointData()->GetScalars()->GetComponent(pts[1], i) * this->AttributeScale[0];
+        x[2] =
+          input->GetPointData()->GetScalars()->GetComponent(pts[2], i) * this->AttributeScale[0];
       }
-      A[0][3] = A[1][3] = A[2][3] = 1;
-      A[3][3] = 0;
-
-      // should handle poorly condition matrix better
-      if (vtkMath::LUFactorLinearSystem(A, index, 4))
+      else if (i < this->AttributeComponents[1])
       {
-        for (i = 0; i < this->NumberOfComponents; i++)
-        {
-          x[3] = 0;
-          if (i < this->AttributeComponents[0])
-          {
-            x[0] = input->GetPointData()->GetScalars()->GetComponent(pts[0], i) *
-              this->AttributeScale[0];
-            x[1] = input->GetPointData()->GetScalars()->GetComponent(pts[1], i) *
-              this->AttributeScale[0];
-            x[2] = input->GetPointData()->GetScalars()->GetComponent(pts[2], i) *
-              this->AttributeScale[0];
-          }
-          else if (i < this->AttributeComponents[1])
-          {
-            x[0] = input->GetPointData()->GetVectors()->GetComponent(
-                     pts[0], i - this->AttributeComponents[0]) *
-              this->AttributeScale[1];
-            x[1] = input->GetPointData()->GetVectors()->GetComponent(
-                     pts[1], i - this->AttributeComponents[0]) *
-              this->AttributeScale[1];
-            x[2] = input->GetPointData()->GetVectors()->GetComponent(
-                     pts[2], i - this->AttributeComponents[0]) *
-              this->AttributeScale[1];
-          }
-          else if (i < this->AttributeComponents[2])
-          {
-            x[0] = input->GetPointData()->GetNormals()->GetComponent(
-                     pts[0], i - this->AttributeComponents[1]) *
-              this->AttributeScale[2];
-            x[1] = input->GetPointData()->GetNormals()->GetComponent(
-                     pts[1], i - this->AttributeComponents[1]) *
-              this->AttributeScale[2];
-            x[2] = input->GetPointData()->GetNormals()->GetComponent(
-                     pts[2], i - this->AttributeComponents[1]) *
-              this->AttributeScale[2];
-          }
-          else if (i < this->AttributeComponents[3])
-          {
-            x[0] = input->GetPointData()->GetTCoords()->GetComponent(
-                     pts[0], i - this->AttributeComponents[2]) *
-              this->AttributeScale[3];
-            x[1] = input->GetPointData()->GetTCoords()->GetComponent(
-                     pts[1], i - this->AttributeComponents[2]) *
-              this->AttributeScale[3];
-            x[2] = input->GetPointData()->GetTCoords()->GetComponent(
-                     pts[2], i - this->AttributeComponents[2]) *
-              this->AttributeScale[3];
-          }
-          else if (i < this->AttributeComponents[4])
-          {
-            x[0] = input->GetPointData()->GetTensors()->GetComponent(
-                     pts[0], i - this->AttributeComponents[3]) *
-              this->AttributeScale[4];
-            x[1] = input->GetPointData()->GetTensors()->GetComponent(
-                     pts[1], i - this->AttributeComponents[3]) *
-              this->AttributeScale[4];
-            x[2] = input->GetPointData()->GetTensors()->GetComponent(
-                     pts[2], i - this->AttributeComponents[3]) *
-              this->AttributeScale[4];
-          }
-          vtkMath::LUSolveLinearSystem(A, index, x, 4);
+        x[0] = input->GetPointData()->GetVectors()->GetComponent(
+                 pts[0], i - this->AttributeComponents[0]) *
+          this->AttributeScale[1];
+        x[1] = input->GetPointData()->GetVectors()->GetComponent(
+                 pts[1], i - this->AttributeComponents[0]) *
+          this->AttributeScale[1];
+        x[2] = input->GetPointData()->GetVectors()->GetComponent(
+                 pts[2], i - this->AttributeComponents[0]) *
+          this->AttributeScale[1];
+      }
+      else if (i < this->AttributeComponents[2])
+      {
+        x[0] = input->GetPointData()->GetNormals()->GetComponent(
+                 pts[0], i - this->AttributeComponents[1]) *
+          this->AttributeScale[2];
+        x[1] = input->GetPointData()->GetNormals()->GetComponent(
+                 pts[1], i - this->AttributeComponents[1]) *
+          this->AttributeScale[2];
+        x[2] = input->GetPointData()->GetNormals()->GetComponent(
+                 pts[2], i - this->AttributeComponents[1]) *
+          this->AttributeScale[2];
+      }
+      else if (i < this->AttributeComponents[3])
+      {
+        x[0] = input->GetPointData()->GetTCoords()->GetComponent(
+                 pts[0], i - this->AttributeComponents[2]) *
+          this->AttributeScale[3];
+        x[1] = input->GetPointData()->GetTCoords()->GetComponent(
+                 pts[1], i - this->AttributeComponents[2]) *
+          this->AttributeScale[3];
+        x[2] = input->GetPointData()->GetTCoords()->GetComponent(
+                 pts[2], i - this->AttributeComponents[2]) *
+          this->AttributeScale[3];
+      }
+      else if (i < this->AttributeComponents[4])
+      {
+        x[0] = input->GetPointData()->GetTensors()->GetComponent(
+                 pts[0], i - this->AttributeComponents[3]) *
+          this->AttributeScale[4];
+        x[1] = input->GetPointData()->GetTensors()->GetComponent(
+                 pts[1], i - this->AttributeComponents[3]) *
+          this->AttributeScale[4];
+        x[2] = input->GetPointData()->GetTensors()->GetComponent(
+                 pts[2], i - this->AttributeComponents[3]) *
+          this->AttributeScale[4];
+      }
+      vtkMath::LUSolveLinearSystem(A, index, x, 4);
 
-          // add in the contribution of this element into the QEM
-          QEM[0] += x[0] * x[0];
-          QEM[1] += x[0] * x[1];
-          QEM[2] += x[0] * x[2];
-          QEM[3] += x[0] * x[3];
+      // add in the contribution of this element into the QEM
+      QEM[0] += x[0] * x[0];
+      QEM[1] += x[0] * x[1];
+      QEM[2] += x[0] * x[2];
+      QEM[3] += x[0] * x[3];
 
-          QEM[4] += x[1] * x[1];
-          QEM[5] += x[1] * x[2];
-          QEM[6] += x[1] * x[3];
+      QEM[4] += x[1] * x[1];
+      QEM[5] += x[1] * x[2];
+      QEM[6] += x[1] * x[3];
 
-          QEM[7] += x[2] * x[2];
-          QEM[8] += x[2] * x[3];
+      QEM[7] += x[2] * x[2];
+      QEM[8] += x[2] * x[3];
 
-          QEM[9] += x[3] * x[3];
+      QEM[9] += x[3] * x[3];
 
-          QEM[11 + (i * 4)] = -x[0];
-          QEM[12 + (i * 4)] = -x[1];
-          QEM[13 + (i * 4)] = -x[2];
-          QEM[14 + (i * 4)] = -x[3];
-        }
-      }
-      else
-      {
-        vtkErrorMacro(<< "Unable to factor attribute matrix!");
-      }
+      QEM[11 + (i * 4)] = -x[0];
+      QEM[12 + (i * 4)] = -x[1];
+      QEM[13 + (i * 4)] = -x[2];
+      QEM[14 + (i * 4)] = -x[3];
     }
-
-    // add the QEM to all points of the face
-    for (i = 0; i < 3; i++)
+    return true;
+  };
+
+  // Each point gathers the QEM of the triangles using it. Links list the
+  // cells in increasing ids, so the sums are accumulated in the same order
+  // whatever the number of threads.
+  std::atomic<bool> factorFailed(false);
+  vtkSMPThreadLocal<std::vector<double>> localQEM;
+  vtkSMPThreadLocalObject<vtkIdList> localPtIds;
+  vtkSMPTools::For(0, numPts,
+    [&](vtkIdType begin, vtkIdType end)
     {
-      for (j = 0; j < 11 + 4 * this->NumberOfComponents; j++)
+      std::vector<double>& QEM = localQEM.Local();
+      QEM.resize(quadSize);
+      vtkIdList* ptIds = localPtIds.Local();
+      vtkIdType ncells;
+      vtkIdType* cells;
+      vtkIdType npts;
+      const vtkIdType* pts;
+      double n[3], d, triArea2;
+
+      for (vtkIdType ptId = begin; ptId < end; ptId++)
       {
-        this->ErrorQuadrics[pts[i]].Quadric[j] += QEM[j] * triArea2;
-      }
-
-      // Set volume constraint values g_vol and d_vol
-      if (this->VolumePreservation)
-      {
-        // Vector g_vol
-        for (j = 0; j < 3; j++)
+        double* quadric = this->GetQuadric(ptId);
+        input->GetPointCells(ptId, ncells, cells);
+        for (vtkIdType i = 0; i < ncells; i++)
         {
-          this->VolumeConstraints[(pts[i] * 4) + j] +=
-            n[j] * triArea2 * 2.0; // triangle normal with length triArea * 2
+          input->GetCellPoints(cells[i], npts, pts, ptIds);
+          if (!computeTriangleQEM(pts, QEM.data(), n, d, triArea2))
+          {
+            factorFailed = true;
+          }
+
+          // add the QEM to the point
+          for (int j = 0; j < quadSize; j++)
+          {
+            quadric[j] += QEM[j] * triArea2;
+          }
+
+          // Set volume constraint values g_vol and d_vol
+          if (this->VolumePreservation)
+          {
+            // Vector g_vol
+            for (int j = 0; j < 3; j++)
+            {
+              this->VolumeConstraints[(ptId * 4) + j] +=
+                n[j] * triArea2 * 2.0; // triangle normal with length triArea * 2
+            }
+            // Scalar d_vol
+            this->VolumeConstraints[(ptId * 4) + 3] +=
+              -d * triArea2 * 2.0; // (triangle normal with length triArea * 2) * (pts[0] position)
+          }
         }
-        // Scalar d_vol
-        this->VolumeConstraints[(pts[i] * 4) + 3] +=
-          -d * triArea2 * 2.0; // (triangle normal with length triArea * 2) * (pts[0] position)
       }
-    }
-  } // for all triangles
+    });
+
+  if (factorFailed)
+  {
+    vtkErrorMacro(<< "Unable to factor attribute matrix!");
+  }
 }
 
 //------------------------------------------------------------------------------
 void vtkQuadricDecimation::AddBoundaryConstraints()
 {
   vtkPolyData* input = this->Mesh;
-  double* QEM;
-  vtkIdType cellId;
-  int i, j;
-  vtkIdType npts;
-  const vtkIdType* pts;
-  double t0[3], t1[3], t2[3];
-  double e0[3], e1[3], n[3], c, w;
-  vtkIdList* cellIds = vtkIdList::New();
-
-  // allocate local QEM space matrix
-  QEM = new double[11 + 4 * this->NumberOfComponents];
-
-  for (cellId = 0; cellId < input->GetNumberOfCells(); cellId++)
-  {
-    input->GetCellPoints(cellId, npts, pts);
-
-    for (i = 0; i < 3; i++)
+  const vtkIdType numCells = input->GetNumberOfCells();
+  const vtkIdType numPts = input->GetNumberOfPoints();
+
+  // Flag the boundary edges of each triangle: bit i is set when the edge
+  // (pts[i], pts[i + 1]) is not used by any other cell.
+  std::vector<unsigned char> boundaryEdges(numCells);
+  vtkSMPThreadLocalObject<vtkIdList> localPtIds;
+  vtkSMPThreadLocalObject<vtkIdList> localCellIds;
+  vtkSMPTools::For(0, numCells,
+    [&](vtkIdType begin, vtkIdType end)
     {
-      input->GetCellEdgeNeighbors(cellId, pts[i], pts[(i + 1) % 3], cellIds);
-      if (cellIds->GetNumberOfIds() == 0)
+      vtkIdList* ptIds = localPtIds.Local();
+      vtkIdList* cellIds = localCellIds.Local();
+      vtkIdType npts;
+      const vtkIdType* pts;
+      for (vtkIdType cellId = begin; cellId < end; cellId++)
       {
-        // this is a boundary
-        input->GetPoint(pts[(i + 2) % 3], t0);
-        input->GetPoint(pts[i], t1);
-        input->GetPoint(pts[(i + 1) % 3], t2);
-
-        // computing a plane which is orthogonal to line t1, t2 and incident
-        // with it
-        for (j = 0; j < 3; j++)
+        input->GetCellPoints(cellId, npts, pts, ptIds);
+        unsigned char edges = 0;
+        for (int i = 0; i < 3; i++)
         {
-          e0[j] = t2[j] - t1[j];
-        }
-        for (j = 0; j < 3; j++)
-        {
-          e1[j] = t0[j] - t1[j];
+          input->GetCellEdgeNeighbors(cellId, pts[i], pts[(i + 1) % 3], cellIds);
+          if (cellIds->GetNumberOfIds() == 0)
+          {
+            edges |= 1 << i;
+          }
         }
+        boundaryEdges[cellId] = edges;
+      }
+    });
 
-        // compute n so that it is orthogonal to e0 and parallel to the
-        // triangle
-        c = vtkMath::Dot(e0, e1) / (e0[0] * e0[0] + e0[1] * e0[1] + e0[2] * e0[2]);
-        for (j = 0; j < 3; j++)
-        {
-          n[j] = e1[j] - c * e0[j];
-        }
-        vtkMath::Normalize(n);
+  // Compute the QEM of the plane orthogonal to the triangle through its
+  // boundary edge i, and its weight.
+  auto computeBoundaryQEM = [&](const vtkIdType* pts, int i, double* QEM, double& w)
+  {
+    int j;
+    double t0[3], t1[3], t2[3];
+    double e0[3], e1[3], n[3], c;
+
+    input->GetPoint(pts[(i + 2) % 3], t0);
+    input->GetPoint(pts[i], t1);
+    input->GetPoint(pts[(i + 1) % 3], t2);
+
+    // computing a plane which is orthogonal to line t1, t2 and incident
+    // with it
+    for (j = 0; j < 3; j++)
+    {
+      e0[j] = t2[j] - t1[j];
+    }
+    for (j = 0; j < 3; j++)
+    {
+      e1[j] = t0[j] - t1[j];
+    }
+
+    // compute n so that it is orthogonal to e0 and parallel to the
+    // triangle
+    c = vtkMath::Dot(e0, e1) / (e0[0] * e0[0] + e0[1] * e0[1] + e0[2] * e0[2]);
+    for (j = 0; j < 3; j++)
+    {
+      n[j] = e1[j] - c * e0[j];
+    }
+    vtkMath::Normalize(n);
 
 #if defined(_MSC_VER) && _MSC_VER >= 1929
-        // Visual Studio toolset starting at toolset 14.29.30133, when building in Release mode
-        // incorrectly optimizes away the line
-        //    QEM[9] = d * d;
-        // By making volatile, we are telling the compiler not to optimize out
-        // or reorder operations regarding this variable.
-        volatile
+    // Visual Studio toolset starting at toolset 14.29.30133, when building in Release mode
+    // incorrectly optimizes away the line
+    //    QEM[9] = d * d;
+    // By making volatile, we are telling the compiler not to optimize out
+    // or reorder operations regarding this variable.
+    volatile
 #endif
-          double d = -vtkMath::Dot(n, t1);
-        // The above line might merit some review: The same quadric gets added to t1 and t2 and one
-        // might prefer adding a quadric calculated using t1 at t1 and using t2 at t2
-        w = vtkMath::Norm(e0);
+      double d = -vtkMath::Dot(n, t1);
+    // The above line might merit some review: The same quadric gets added to t1 and t2 and one
+    // might prefer adding a quadric calculated using t1 at t1 and using t2 at t2
+    w = vtkMath::Norm(e0);
 
-        if (!this->WeighBoundaryConstraintsByLength)
-        {
-          /*
-           * The argument for using area instead of length is based on homogeneity here: The quadric
-           * field is already weighted by triangle area. It makes sense weighting the boundary
-           * constraints by area instead of length. Length technically has zero measure in terms of
-           * units of area. The squared version also seems to give more coherent results at the
-           * boundary.
-           */
-          w *= w;
-        }
-        w *= this->BoundaryWeightFactor;
+    if (!this->WeighBoundaryConstraintsByLength)
+    {
+      /*
+       * The argument for using area instead of length is based on homogeneity here: The quadric
+       * field is already weighted by triangle area. It makes sense weighting the boundary
+       * constraints by area instead of length. Length technically has zero measure in terms of
+       * units of area. The squared version also seems to give more coherent results at the
+       * boundary.
+       */
+      w *= w;
+    }
+    w *= this->BoundaryWeightFactor;
 
-        // could possible add in
-        // angle weights??
-        QEM[0] = n[0] * n[0];
-        QEM[1] = n[0] * n[1];
-        QEM[2] = n[0] * n[2];
-        QEM[3] = d * n[0];
+    // could possible add in
+    // angle weights??
+    QEM[0] = n[0] * n[0];
+    QEM[1] = n[0] * n[1];
+    QEM[2] = n[0] * n[2];
+    QEM[3] = d * n[0];
 
-        QEM[4] = n[1] * n[1];
-        QEM[5] = n[1] * n[2];
-        QEM[6] = d * n[1];
+    QEM[4] = n[1] * n[1];
+    QEM[5] = n[1] * n[2];
+    QEM[6] = d * n[1];
 
-        QEM[7] = n[2] * n[2];
-        QEM[8] = d * n[2];
+    QEM[7] = n[2] * n[2];
+    QEM[8] = d * n[2];
 
-        QEM[9] = d * d;
+    QEM[9] = d * d;
 
-        QEM[10] = 1;
+    QEM[10] = 1;
+  };
 
-        // need to add orthogonal plane with the other Attributes, but this
-        // is not clear??
-        // check to interaction with attribute data
-        for (j = 0; j < 11; j++)
+  // Each point gathers the constraints of the boundary edges it ends, in
+  // increasing cell ids as for the quadrics.
+  vtkSMPTools::For(0, numPts,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      vtkIdList* ptIds = localPtIds.Local();
+      vtkIdType ncells;
+      vtkIdType* cells;
+      vtkIdType npts;
+      const vtkIdType* pts;
+      double QEM[11], w;
+
+      for (vtkIdType ptId = begin; ptId < end; ptId++)
+      {
+        double* quadric = this->GetQuadric(ptId);
+        input->GetPointCells(ptId, ncells, cells);
+        for (vtkIdType k = 0; k < ncells; k++)
         {
-          this->ErrorQuadrics[pts[i]].Quadric[j] += QEM[j] * w;
-          this->ErrorQuadrics[pts[(i + 1) % 3]].Quadric[j] += QEM[j] * w;
+          // a cell using the point several times is listed several times
+          if (!boundaryEdges[cells[k]] || (k > 0 && cells[k] == cells[k - 1]))
+          {
+            continue;
+          }
+          input->GetCellPoints(cells[k], npts, pts, ptIds);
+          for (int i = 0; i < 3; i++)
+          {
+            if (!(boundaryEdges[cells[k]] & (1 << i)))
+            {
+              continue;
+            }
+            const int uses = (pts[i] == ptId) + (pts[(i + 1) % 3] == ptId);
+            if (uses == 0)
+            {
+              continue;
+            }
+            computeBoundaryQEM(pts, i, QEM, w);
+
+            // need to add orthogonal plane with the other Attributes, but this
+            // is not clear??
+            // check to interaction with attribute data
+            for (int use = 0; use < uses; use++)
+            {
+              for (int j = 0; j < 11; j++)
+              {
+                quadric[j] += QEM[j] * w;
+              }
+            }
+          }
         }
       }
-    }
-  }
-  cellIds->Delete();
-  delete[] QEM;
+    });
 }
 
 //------------------------------------------------------------------------------
@@ -831,9 +959,11 @@ void vtkQuadricDecimation::AddQuadric(vtkIdType oldPtId, vtkIdType newPtId)
 {
   int i;
 
+  double* newQuadric = this->GetQuadric(newPtId);
+  const double* oldQuadric = this->GetQuadric(oldPtId);
   for (i = 0; i < 11 + 4 * this->NumberOfComponents; i++)
   {
-    this->ErrorQuadrics[newPtId].Quadric[i] += this->ErrorQuadrics[oldPtId].Quadric[i];
+    newQuadric[i] += oldQuadric[i];
   }
 
   if (this->VolumePreservation)
@@ -884,10 +1014,10 @@ void vtkQuadricDecimation::FindAffectedEdges(vtkIdType p1Id, vtkIdType p2Id, vtk
   }
 }
 
-// FIXME: memory allocation clean up
+//------------------------------------------------------------------------------
 void vtkQuadricDecimation::UpdateEdgeData(vtkIdType pt0Id, vtkIdType pt1Id)
 {
-  vtkIdList* changedEdges = vtkIdList::New();
+  vtkIdList* changedEdges = this->ChangedEdges;
   vtkIdType i, edgeId, edge[2];
   double cost;
 
@@ -964,12 +1094,16 @@ void vtkQuadricDecimation::UpdateEdgeData(vtkIdType pt0Id, vtkIdType pt1Id)
       this->TargetPoints->InsertTuple(changedEdges->GetId(i), this->TempX);
     }
   }
-
-  changedEdges->Delete();
 }
 
 //------------------------------------------------------------------------------
 double vtkQuadricDecimation::ComputeCost(vtkIdType edgeId, double* x)
+{
+  return this->ComputeCost(edgeId, x, this->TempQuad);
+}
+
+//------------------------------------------------------------------------------
+double vtkQuadricDecimation::ComputeCost(vtkIdType edgeId, double* x, double* quad)
 {
   static const double errorNumber = 1e-10;
   double temp[3], A[3][3], b[3];
@@ -984,22 +1118,23 @@ double vtkQuadricDecimation::ComputeCost(vtkIdType edgeId, double* x)
   pointIds[0] = this->EndPoint1List->GetId(edgeId);
   pointIds[1] = this->EndPoint2List->GetId(edgeId);
 
+  const double* quadric0 = this->GetQuadric(pointIds[0]);
+  const double* quadric1 = this->GetQuadric(pointIds[1]);
   for (i = 0; i < 11 + 4 * this->NumberOfComponents; i++)
   {
-    this->TempQuad[i] =
-      this->ErrorQuadrics[pointIds[0]].Quadric[i] + this->ErrorQuadrics[pointIds[1]].Quadric[i];
+    quad[i] = quadric0[i] + quadric1[i];
   }
 
-  A[0][0] = this->TempQuad[0];
-  A[0][1] = A[1][0] = this->TempQuad[1];
-  A[0][2] = A[2][0] = this->TempQuad[2];
-  A[1][1] = this->TempQuad[4];
-  A[1][2] = A[2][1] = this->TempQuad[5];
-  A[2][2] = this->TempQuad[7];
+  A[0][0] = quad[0];
+  A[0][1] = A[1][0] = quad[1];
+  A[0][2] = A[2][0] = quad[2];
+  A[1][1] = quad[4];
+  A[1][2] = A[2][1] = quad[5];
+  A[2][2] = quad[7];
 
-  b[0] = -this->TempQuad[3];
-  b[1] = -this->TempQuad[6];
-  b[2] = -this->TempQuad[8];
+  b[0] = -quad[3];
+  b[1] = -quad[6];
+  b[2] = -quad[8];
 
   norm = vtkMath::Norm(A[0]);
   normTemp = vtkMath::Norm(A[1]);
@@ -1051,7 +1186,7 @@ double vtkQuadricDecimation::ComputeCost(vtkIdType edgeId, double* x)
 
   // Compute the cost
   // x'*quad*x
-  index = this->TempQuad;
+  index = quad;
   for (i = 0; i < 4; i++)
   {
     cost += (*index++) * newPoint[i] * newPoint[i];
@@ -1066,6 +1201,13 @@ double vtkQuadricDecimation::ComputeCost(vtkIdType edgeId, double* x)
 
 //------------------------------------------------------------------------------
 double vtkQuadricDecimation::ComputeCost2(vtkIdType edgeId, double* x)
+{
+  return this->ComputeCost2(edgeId, x, this->TempQuad, this->TempA, this->TempB);
+}
+
+//------------------------------------------------------------------------------
+double vtkQuadricDecimation::ComputeCost2(
+  vtkIdType edgeId, double* x, double* quad, double** A, double* b)
 {
   // this function is so ugly because the functionality of converting an QEM
   // into a dense matrix was not extracted into a separate function and
@@ -1079,31 +1221,32 @@ double vtkQuadricDecimation::ComputeCost2(vtkIdType edgeId, double* x)
   pointIds[0] = this->EndPoint1List->GetId(edgeId);
   pointIds[1] = this->EndPoint2List->GetId(edgeId);
 
+  const double* quadric0 = this->GetQuadric(pointIds[0]);
+  const double* quadric1 = this->GetQuadric(pointIds[1]);
   for (i = 0; i < 11 + 4 * this->NumberOfComponents; i++)
   {
-    this->TempQuad[i] =
-      this->ErrorQuadrics[pointIds[0]].Quadric[i] + this->ErrorQuadrics[pointIds[1]].Quadric[i];
+    quad[i] = quadric0[i] + quadric1[i];
   }
 
-  // copy the temp quad into TempA
+  // copy the temp quad into A
   // converting from the sparse matrix format into a dense
-  this->TempA[0][0] = this->TempQuad[0];
-  this->TempA[0][1] = this->TempA[1][0] = this->TempQuad[1];
-  this->TempA[0][2] = this->TempA[2][0] = this->TempQuad[2];
-  this->TempA[1][1] = this->TempQuad[4];
-  this->TempA[1][2] = this->TempA[2][1] = this->TempQuad[5];
-  this->TempA[2][2] = this->TempQuad[7];
+  A[0][0] = quad[0];
+  A[0][1] = A[1][0] = quad[1];
+  A[0][2] = A[2][0] = quad[2];
+  A[1][1] = quad[4];
+  A[1][2] = A[2][1] = quad[5];
+  A[2][2] = quad[7];
 
-  this->TempB[0] = -this->TempQuad[3];
-  this->TempB[1] = -this->TempQuad[6];
-  this->TempB[2] = -this->TempQuad[8];
+  b[0] = -quad[3];
+  b[1] = -quad[6];
+  b[2] = -quad[8];
 
   for (i = 3; i < 3 + this->NumberOfComponents; i++)
   {
-    this->TempA[0][i] = this->TempA[i][0] = this->TempQuad[11 + (4 * (i - 3))];
-    this->TempA[1][i] = this->TempA[i][1] = this->TempQuad[11 + (4 * (i - 3)) + 1];
-    this->TempA[2][i] = this->TempA[i][2] = this->TempQuad[11 + (4 * (i - 3)) + 2];
-    this->TempB[i] = -this->TempQuad[11 + (4 * (i - 3)) + 3];
+    A[0][i] = A[i][0] = quad[11 + (4 * (i - 3))];
+    A[1][i] = A[i][1] = quad[11 + (4 * (i - 3)) + 1];
+    A[2][i] = A[i][2] = quad[11 + (4 * (i - 3)) + 2];
+    b[i] = -quad[11 + (4 * (i - 3)) + 3];
   }
 
   // Set zero to all components of the submatrix a[3:n;3:n] and al to its diagonal
@@ -1113,11 +1256,11 @@ double vtkQuadricDecimation::ComputeCost2(vtkIdType edgeId, double* x)
     {
       if (i == j)
       {
-        this->TempA[i][j] = this->TempQuad[10];
+        A[i][j] = quad[10];
       }
       else
       {
-        this->TempA[i][j] = 0;
+        A[i][j] = 0;
       }
     }
   }
@@ -1128,50 +1271,50 @@ double vtkQuadricDecimation::ComputeCost2(vtkIdType edgeId, double* x)
     {
       if (i >= 3)
       {
-        this->TempA[i][3 + this->NumberOfComponents] = 0;
-        this->TempA[3 + this->NumberOfComponents][i] = 0;
+        A[i][3 + this->NumberOfComponents] = 0;
+        A[3 + this->NumberOfComponents][i] = 0;
       }
       else
       {
-        this->TempA[i][3 + this->NumberOfComponents] =
+        A[i][3 + this->NumberOfComponents] =
           this->VolumeConstraints[(pointIds[0] * 4) + i];
-        this->TempA[3 + this->NumberOfComponents][i] =
+        A[3 + this->NumberOfComponents][i] =
           this->VolumeConstraints[(pointIds[0] * 4) + i];
-        this->TempA[i][3 + this->NumberOfComponents] +=
+        A[i][3 + this->NumberOfComponents] +=
           this->VolumeConstraints[(pointIds[1] * 4) + i];
-        this->TempA[3 + this->NumberOfComponents][i] +=
+        A[3 + this->NumberOfComponents][i] +=
           this->VolumeConstraints[(pointIds[1] * 4) + i];
       }
     }
     // Add constraint to b
-    this->TempB[3 + this->NumberOfComponents] = this->VolumeConstraints[(pointIds[0] * 4) + 3];
-    this->TempB[3 + this->NumberOfComponents] += this->VolumeConstraints[(pointIds[1] * 4) + 3];
+    b[3 + this->NumberOfComponents] = this->VolumeConstraints[(pointIds[0] * 4) + 3];
+    b[3 + this->NumberOfComponents] += this->VolumeConstraints[(pointIds[1] * 4) + 3];
   }
 
   for (i = 0; i < 3 + this->NumberOfComponents + this->VolumePreservation; i++)
   {
-    x[i] = this->TempB[i];
+    x[i] = b[i];
   }
 
   // solve A*x = b
   // this clobers A
   // need to develop a quality of the solution test??
   solveOk = vtkMath::SolveLinearSystem(
-    this->TempA, x, 3 + this->NumberOfComponents + this->VolumePreservation);
+    A, x, 3 + this->NumberOfComponents + this->VolumePreservation);
 
   // need to copy back into A
-  this->TempA[0][0] = this->TempQuad[0];
-  this->TempA[0][1] = this->TempA[1][0] = this->TempQuad[1];
-  this->TempA[0][2] = this->TempA[2][0] = this->TempQuad[2];
-  this->TempA[1][1] = this->TempQuad[4];
-  this->TempA[1][2] = this->TempA[2][1] = this->TempQuad[5];
-  this->TempA[2][2] = this->TempQuad[7];
+  A[0][0] = quad[0];
+  A[0][1] = A[1][0] = quad[1];
+  A[0][2] = A[2][0] = quad[2];
+  A[1][1] = quad[4];
+  A[1][2] = A[2][1] = quad[5];
+  A[2][2] = quad[7];
 
   for (i = 3; i < 3 + this->NumberOfComponents; i++)
   {
-    this->TempA[0][i] = this->TempA[i][0] = this->TempQuad[11 + 4 * (i - 3)];
-    this->TempA[1][i] = this->TempA[i][1] = this->TempQuad[11 + 4 * (i - 3) + 1];
-    this->TempA[2][i] = this->TempA[i][2] = this->TempQuad[11 + 4 * (i - 3) + 2];
+    A[0][i] = A[i][0] = quad[11 + 4 * (i - 3)];
+    A[1][i] = A[i][1] = quad[11 + 4 * (i - 3) + 1];
+    A[2][i] = A[i][2] = quad[11 + 4 * (i - 3) + 2];
   }
 
   for (i = 3; i < 3 + this->NumberOfComponents; i++)
@@ -1180,11 +1323,11 @@ double vtkQuadricDecimation::ComputeCost2(vtkIdType edgeId, double* x)
     {
       if (i == j)
       {
-        this->TempA[i][j] = this->TempQuad[10];
+        A[i][j] = quad[10];
       }
       else
       {
-        this->TempA[i][j] = 0;
+        A[i][j] = 0;
       }
     }
   }
@@ -1195,16 +1338,16 @@ double vtkQuadricDecimation::ComputeCost2(vtkIdType edgeId, double* x)
     {
       if (i >= 3)
       {
-        this->TempA[i][3 + this->NumberOfComponents] = 0;
-        this->TempA[3 + this->NumberOfComponents][i] = 0;
+        A[i][3 + this->NumberOfComponents] = 0;
+        A[3 + this->NumberOfComponents][i] = 0;
       }
       else
       {
-        this->TempA[i][3 + this->NumberOfComponents] = this->VolumeConstraints[pointIds[0] * 4 + i];
-        this->TempA[3 + this->NumberOfComponents][i] = this->VolumeConstraints[pointIds[0] * 4 + i];
-        this->TempA[i][3 + this->NumberOfComponents] +=
+        A[i][3 + this->NumberOfComponents] = this->VolumeConstraints[pointIds[0] * 4 + i];
+        A[3 + this->NumberOfComponents][i] = this->VolumeConstraints[pointIds[0] * 4 + i];
+        A[i][3 + this->NumberOfComponents] +=
           this->VolumeConstraints[pointIds[1] * 4 + i];
-        this->TempA[3 + this->NumberOfComponents][i] +=
+        A[3 + this->NumberOfComponents][i] +=
           this->VolumeConstraints[pointIds[1] * 4 + i];
       }
     }
@@ -1238,7 +1381,7 @@ double vtkQuadricDecimation::ComputeCost2(vtkIdType edgeId, double* x)
       temp2[i] = 0;
       for (j = 0; j < 3 + this->NumberOfComponents; ++j)
       {
-        temp2[i] += this->TempA[i][j] * v[j];
+        temp2[i] += A[i][j] * v[j];
       }
     }
 
@@ -1256,13 +1399,13 @@ double vtkQuadricDecimation::ComputeCost2(vtkIdType edgeId, double* x)
         temp[i] = 0;
         for (j = 0; j < 3 + this->NumberOfComponents; ++j)
         {
-          temp[i] += this->TempA[i][j] * pt1[j];
+          temp[i] += A[i][j] * pt1[j];
         }
       }
 
       for (i = 0; i < 3 + this->NumberOfComponents; i++)
       {
-        temp[i] = this->TempB[i] - temp[i];
+        temp[i] = b[i] - temp[i];
       }
 
       for (i = 0; i < 3 + this->NumberOfComponents; i++)
@@ -1291,18 +1434,18 @@ double vtkQuadricDecimation::ComputeCost2(vtkIdType edgeId, double* x)
   // x'*A*x - 2*b*x + d
   for (i = 0; i < 3 + this->NumberOfComponents + this->VolumePreservation; i++)
   {
-    cost += this->TempA[i][i] * x[i] * x[i];
+    cost += A[i][i] * x[i] * x[i];
     for (j = i + 1; j < 3 + this->NumberOfComponents + this->VolumePreservation; j++)
     {
-      cost += 2.0 * this->TempA[i][j] * x[i] * x[j];
+      cost += 2.0 * A[i][j] * x[i] * x[j];
     }
   }
   for (i = 0; i < 3 + this->NumberOfComponents + this->VolumePreservation; i++)
   {
-    cost -= 2.0 * this->TempB[i] * x[i];
+    cost -= 2.0 * b[i] * x[i];
   }
 
-  cost += this->TempQuad[9];
+  cost += quad[9];
 
   return cost;
 }
@@ -37,6 +37,11 @@
  * Attributes" is also a good take on the subject especially as it pertains
  * to the error metric applied to attributes.
  *
+ * The initialization of the quadrics, of the boundary constraints and of the
+ * edge collapse costs is multithreaded with vtkSMPTools. The edge collapses
+ * themselves are performed serially in priority order, so the output does
+ * not depend on the number of threads.
+ *
  * @par Thanks:
  * Thanks to Bradley Lowekamp of the National Library of Medicine/NIH for
  * contributing this class.
@@ -49,6 +54,8 @@
 #include "vtkPolyDataAlgorithm.h"
 #include "vtkWrappingHints.h" // For VTK_MARSHALAUTO
 
+#include <vector> // For std::vector
+
 VTK_ABI_NAMESPACE_BEGIN
 class vtkEdgeTable;
 class vtkIdList;
@@ -250,6 +257,24 @@ protected:
   double ComputeCost2(vtkIdType edgeId, double* x);
   ///@}
 
+  ///@{
+  /**
+   * Thread-safe variants of ComputeCost() and ComputeCost2() using the given
+   * scratch buffers instead of TempQuad, TempA and TempB.
+   */
+  double ComputeCost(vtkIdType edgeId, double* x, double* quad);
+  double ComputeCost2(vtkIdType edgeId, double* x, double* quad, double** A, double* b);
+  ///@}
+
+  /**
+   * Return the error quadric of a point, made of 11 + 4 * NumberOfComponents
+   * values.
+   */
+  double* GetQuadric(vtkIdType ptId)
+  {
+    return this->ErrorQuadrics.data() + ptId * (11 + 4 * this->NumberOfComponents);
+  }
+
   /**
    * Find all edges that will have an endpoint change ids because of an edge
    * collapse.  p1Id and p2Id are the endpoints of the edge.  p2Id is the
@@ -336,13 +361,8 @@ protected:
   int NumberOfComponents;
   vtkPolyData* Mesh;
 
-  struct ErrorQuadric
-  {
-    double* Quadric;
-  };
-
-  // One ErrorQuadric per point
-  ErrorQuadric* ErrorQuadrics;
+  // Error quadrics of all points stored contiguously, see GetQuadric()
+  std::vector<double> ErrorQuadrics;
 
   // Controlling regularization behavior
   vtkTypeBool Regularize = false;
@@ -359,6 +379,8 @@ protected:
 
   // Temporary variables for performance
   vtkIdList* CollapseCellIds;
+  vtkIdList* ChangedEdges;
+  std::vector<double> TempTuples;
   double* TempX;
   double* TempQuad;
   double* TempB;
@@ -7,18 +7,24 @@
 #include "vtkCellArray.h"
 #include "vtkCellData.h"
 #include "vtkDataArrayRange.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMergePoints.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
 #include "vtkSMPTools.h"
 #include "vtkStaticCleanUnstructuredGrid.h"
 #include "vtkStaticPointLocator.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 
 #include <algorithm>
+#include <array>
+#include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkStaticCleanPolyData);
@@ -26,6 +32,236 @@ vtkStandardNewMacro(vtkStaticCleanPolyData);
 // This filter uses methods found in vtkStaticCleanUnstructuredGrid.
 using PointUses = unsigned char;
 
+namespace
+{
+// The output cell arrays, in the order of the output cells
+enum CellArrayType
+{
+  VERTS = 0,
+  LINES = 1,
+  POLYS = 2,
+  STRIPS = 3,
+  NUMBER_OF_CELL_ARRAYS = 4
+};
+
+//------------------------------------------------------------------------------
+// Threaded rewrite of the input cells with the new point ids. Duplicate ids
+// are removed from each cell, then degenerate cells are either dropped or
+// moved to a lower dimensional cell array. The cells are processed in blocks
+// in two passes: the first pass counts the cells and connectivity ids each
+// block produces in each output cell array, a prefix sum over the blocks
+// gives where each block writes, and the second pass writes the cells. The
+// output cells keep the order of the input cells whatever the number of
+// threads, and only a few counters per block are stored.
+struct RewriteCells
+{
+  static constexpr vtkIdType BlockSize = 4096;
+  using BlockCounts = std::array<vtkIdType, 2 * NUMBER_OF_CELL_ARRAYS>;
+
+  vtkCellArray* InCells[NUMBER_OF_CELL_ARRAYS];
+  vtkIdType InCellsBegin[NUMBER_OF_CELL_ARRAYS + 1]; // first input cell id of each array
+  const vtkIdType* PtMap;
+  bool ConvertLinesToPoints;
+  bool ConvertPolysToLines;
+  bool ConvertStripsToPolys;
+  vtkStaticCleanPolyData* Filter;
+
+  // For each block: number of cells, then number of connectivity ids, produced
+  // in each output cell array. Turned into write positions by the prefix sum.
+  std::vector<BlockCounts> Blocks;
+  BlockCounts Totals;
+  vtkIdType OutCellsBegin[NUMBER_OF_CELL_ARRAYS]; // first output cell id of each array
+
+  vtkSmartPointer<vtkIdTypeArray> Offsets[NUMBER_OF_CELL_ARRAYS];
+  vtkSmartPointer<vtkIdTypeArray> Connectivity[NUMBER_OF_CELL_ARRAYS];
+  std::vector<vtkIdType> CellMap; // output cell id -> input cell id
+
+  vtkSMPThreadLocalObject<vtkIdList> CellIds;
+  vtkSMPThreadLocal<std::vector<vtkIdType>> UniqueIds;
+
+  RewriteCells(vtkPolyData* input, const vtkIdType* ptMap, vtkStaticCleanPolyData* filter)
+    : PtMap(ptMap)
+    , ConvertLinesToPoints(filter->GetConvertLinesToPoints())
+    , ConvertPolysToLines(filter->GetConvertPolysToLines())
+    , ConvertStripsToPolys(filter->GetConvertStripsToPolys())
+    , Filter(filter)
+  {
+    this->InCells[VERTS] = input->GetVerts();
+    this->InCells[LINES] = input->GetLines();
+    this->InCells[POLYS] = input->GetPolys();
+    this->InCells[STRIPS] = input->GetStrips();
+    this->InCellsBegin[0] = 0;
+    for (int type = 0; type < NUMBER_OF_CELL_ARRAYS; ++type)
+    {
+      this->InCellsBegin[type + 1] =
+        this->InCellsBegin[type] + this->InCells[type]->GetNumberOfCells();
+    }
+    const vtkIdType numCells = this->InCellsBegin[NUMBER_OF_CELL_ARRAYS];
+    this->Blocks.resize((numCells + BlockSize - 1) / BlockSize);
+  }
+
+  // Return the output cell array of a cell of the given input cell array with
+  // numIds unique point ids, or -1 if the cell is removed.
+  int GetOutputType(int inType, vtkIdType numIds) const
+  {
+    if (numIds > inType)
+    {
+      return inType;
+    }
+    if (numIds == 3 && this->ConvertStripsToPolys)
+    {
+      return POLYS;
+    }
+    if (numIds == 2 && this->ConvertPolysToLines)
+    {
+      return LINES;
+    }
+    if (numIds == 1 && this->ConvertLinesToPoints)
+    {
+      return VERTS;
+    }
+    return -1;
+  }
+
+  // Process the cells of a block. The first pass only counts the output, the
+  // second pass writes it starting at the positions given in counts.
+  template <bool Write>
+  void ProcessBlock(vtkIdType block, BlockCounts& counts)
+  {
+    vtkIdList* cellIds = this->CellIds.Local();
+    std::vector<vtkIdType>& uniqueIds = this->UniqueIds.Local();
+    const vtkIdType blockBegin = block * BlockSize;
+    const vtkIdType blockEnd =
+      std::min(blockBegin + BlockSize, this->InCellsBegin[NUMBER_OF_CELL_ARRAYS]);
+    vtkIdType npts;
+    const vtkIdType* pts;
+
+    for (int inType = 0; inType < NUMBER_OF_CELL_ARRAYS; ++inType)
+    {
+      const vtkIdType begin = std::max(blockBegin, this->InCellsBegin[inType]);
+      const vtkIdType end = std::min(blockEnd, this->InCellsBegin[inType + 1]);
+      for (vtkIdType cellId = begin; cellId < end; ++cellId)
+      {
+        this->InCells[inType]->GetCellAtId(
+          cellId - this->InCellsBegin[inType], npts, pts, cellIds);
+
+        // The cells are small, a linear search for duplicates is the fastest
+        uniqueIds.clear();
+        for (vtkIdType i = 0; i < npts; ++i)
+        {
+          const vtkIdType ptId = this->PtMap[pts[i]];
+          if (std::find(uniqueIds.begin(), uniqueIds.end(), ptId) == uniqueIds.end())
+          {
+            uniqueIds.push_back(ptId);
+          }
+        }
+
+        const vtkIdType numIds = static_cast<vtkIdType>(uniqueIds.size());
+        const int outType = this->GetOutputType(inType, numIds);
+        if (outType < 0)
+        {
+          continue;
+        }
+        vtkIdType& numOutCells = counts[outType];
+        vtkIdType& numOutIds = counts[NUMBER_OF_CELL_ARRAYS + outType];
+        if (Write)
+        {
+          this->Offsets[outType]->SetValue(numOutCells, numOutIds);
+          std::copy(uniqueIds.begin(), uniqueIds.end(),
+            this->Connectivity[outType]->GetPointer(numOutIds));
+          this->CellMap[this->OutCellsBegin[outType] + numOutCells] = cellId;
+        }
+        ++numOutCells;
+        numOutIds += numIds;
+      }
+    }
+  }
+
+  // Process a range of blocks, checking for abort from a single thread
+  template <bool Write>
+  void ProcessBlocks(vtkIdType block, vtkIdType endBlock)
+  {
+    const bool isFirst = vtkSMPTools::GetSingleThread();
+    for (; block < endBlock; ++block)
+    {
+      if (isFirst)
+      {
+        this->Filter->CheckAbort();
+      }
+      if (this->Filter->GetAbortOutput())
+      {
+        break;
+      }
+      if (Write)
+      {
+        this->ProcessBlock<true>(block, this->Blocks[block]);
+      }
+      else
+      {
+        this->Blocks[block].fill(0);
+        this->ProcessBlock<false>(block, this->Blocks[block]);
+      }
+    }
+  }
+
+  // Rewrite the cells into the output cell arrays. Return false on abort.
+  bool Execute()
+  {
+    const vtkIdType numBlocks = static_cast<vtkIdType>(this->Blocks.size());
+    vtkSMPTools::For(0, numBlocks, 1,
+      [this](vtkIdType begin, vtkIdType end) { this->ProcessBlocks<false>(begin, end); });
+    if (this->Filter->GetAbortOutput())
+    {
+      return false;
+    }
+
+    // Prefix sum over the blocks to get where each block writes. There are
+    // few blocks so this is done serially.
+    this->Totals.fill(0);
+    for (auto& counts : this->Blocks)
+    {
+      for (std::size_t i = 0; i < counts.size(); ++i)
+      {
+        const vtkIdType count = counts[i];
+        counts[i] = this->Totals[i];
+        this->Totals[i] += count;
+      }
+    }
+    vtkIdType numOutCells = 0;
+    for (int type = 0; type < NUMBER_OF_CELL_ARRAYS; ++type)
+    {
+      this->OutCellsBegin[type] = numOutCells;
+      numOutCells += this->Totals[type];
+
+      this->Offsets[type] = vtkSmartPointer<vtkIdTypeArray>::New();
+      this->Offsets[type]->SetNumberOfValues(this->Totals[type] + 1);
+      this->Offsets[type]->SetValue(
+        this->Totals[type], this->Totals[NUMBER_OF_CELL_ARRAYS + type]);
+      this->Connectivity[type] = vtkSmartPointer<vtkIdTypeArray>::New();
+      this->Connectivity[type]->SetNumberOfValues(this->Totals[NUMBER_OF_CELL_ARRAYS + type]);
+    }
+    this->CellMap.resize(numOutCells);
+
+    vtkSMPTools::For(0, numBlocks, 1,
+      [this](vtkIdType begin, vtkIdType end) { this->ProcessBlocks<true>(begin, end); });
+    return !this->Filter->GetAbortOutput();
+  }
+
+  // Return the rewritten cells of the given output cell array, or nullptr if
+  // there are none.
+  vtkSmartPointer<vtkCellArray> GetOutputCells(int type)
+  {
+    if (this->Totals[type] == 0)
+    {
+      return nullptr;
+    }
+    auto cells = vtkSmartPointer<vtkCellArray>::New();
+    cells->SetData(this->Offsets[type], this->Connectivity[type]);
+    return cells;
+  }
+};
+}
+
 //------------------------------------------------------------------------------
 // Construct object with initial Tolerance of 0.0
 vtkStaticCleanPolyData::vtkStaticCleanPolyData()
@@ -107,21 +343,10 @@ int vtkStaticCleanPolyData::RequestData(vtkInformation* vtkNotUsed(request),
     return 1;
   }
 
-  // we'll be needing these
-  vtkIdType newId;
-  vtkIdType i;
-  vtkIdType ptId;
-  vtkIdType npts = 0;
-  const vtkIdType* pts = nullptr;
-
   vtkCellArray* inVerts = input->GetVerts();
-  vtkSmartPointer<vtkCellArray> newVerts;
   vtkCellArray* inLines = input->GetLines();
-  vtkSmartPointer<vtkCellArray> newLines;
   vtkCellArray* inPolys = input->GetPolys();
-  vtkSmartPointer<vtkCellArray> newPolys;
   vtkCellArray* inStrips = input->GetStrips();
-  vtkSmartPointer<vtkCellArray> newStrips;
 
   vtkPointData* inPD = input->GetPointData();
   vtkCellData* inCD = input->GetCellData();
@@ -217,294 +442,43 @@ int vtkStaticCleanPolyData::RequestData(vtkInformation* vtkNotUsed(request),
   }
   this->UpdateProgress(0.6);
 
-  // Finally, remap the topology to use new point ids. Celldata needs to be
-  // copied correctly. If a poly is converted to a line, or a line to a
-  // point, then using a CellCounter will not do, as the cells should be
-  // ordered verts, lines, polys, strips. We need to maintain separate cell
-  // data lists so we can copy them all correctly. Tedious but easy to
-  // implement. We can use outCD for vertex cell data, then add the rest
-  // at the end.
-  vtkSmartPointer<vtkCellData> outLineData;
-  vtkSmartPointer<vtkCellData> outPolyData;
-  vtkSmartPointer<vtkCellData> outStrpData;
-  outCD->CopyAllocate(inCD);
-
-  // Begin to adjust topology. We need to cull out duplicate points and see
-  // what's left.  Just use a vector to keep track of unique ids - it's a
-  // small set so find() will execute relatively fast.
-  std::vector<vtkIdType> cellIds;
-  vtkIdType inCellID = 0;
-  vtkIdType progressCounter = 0;
-  vtkIdType checkAbortInterval = 0;
-
-  //
-  // Vertices are renumbered and we remove duplicates
-  if (!this->CheckAbort() && inVerts->GetNumberOfCells() > 0)
+  // Finally, remap the topology to use new point ids. Degenerate cells are
+  // removed or converted to lower dimensional cells, so the cells of an input
+  // cell array may end up in another output cell array. This is threaded,
+  // and the output cells keep the order of the input cells.
+  RewriteCells rewriter(input, pmap, this);
+  if (rewriter.Execute())
   {
-    newVerts.TakeReference(vtkCellArray::New());
-    newVerts->AllocateEstimate(inVerts->GetNumberOfCells(), 1);
-    checkAbortInterval = std::min(inVerts->GetNumberOfCells() / 10 + 1, (vtkIdType)1000);
-
-    vtkDebugMacro(<< "Starting Verts " << inCellID);
-    for (inVerts->InitTraversal(); inVerts->GetNextCell(npts, pts); inCellID++)
-    {
-      if (progressCounter % checkAbortInterval == 0 && this->CheckAbort())
+    // Copy the cell data using the map from output cells to input cells
+    const vtkIdType numOutCells = static_cast<vtkIdType>(rewriter.CellMap.size());
+    outCD->CopyAllocate(inCD, numOutCells);
+    ArrayList arrays;
+    arrays.AddArrays(numOutCells, inCD, outCD, 0.0, /*promote=*/false);
+    vtkSMPTools::For(0, numOutCells,
+      [&](vtkIdType outCellId, vtkIdType endCellId)
       {
-        break;
-      }
-
-      cellIds.clear();
-      for (i = 0; i < npts; i++)
-      {
-        ptId = pmap[pts[i]];
-        if (std::find(cellIds.begin(), cellIds.end(), ptId) == cellIds.end())
+        for (; outCellId < endCellId; ++outCellId)
         {
-          cellIds.push_back(ptId);
+          arrays.Copy(rewriter.CellMap[outCellId], outCellId);
         }
-      } // for all points of vertex cell
+      });
 
-      if (!cellIds.empty())
-      {
-        newId = newVerts->InsertNextCell(cellIds.size(), cellIds.data());
-        outCD->CopyData(inCD, inCellID, newId);
-      }
-    }
-  }
-  this->UpdateProgress(0.7);
+    // Update the output connectivity
+    output->SetVerts(rewriter.GetOutputCells(VERTS));
+    output->SetLines(rewriter.GetOutputCells(LINES));
+    output->SetPolys(rewriter.GetOutputCells(POLYS));
+    output->SetStrips(rewriter.GetOutputCells(STRIPS));
 
-  // lines reduced to one point are eliminated or made into verts
-  if (!this->CheckAbort() && inLines->GetNumberOfCells() > 0)
-  {
-    newLines.TakeReference(vtkCellArray::New());
-    newLines->AllocateEstimate(inLines->GetNumberOfCells(), 2);
-    outLineData.TakeReference(vtkCellData::New());
-    outLineData->CopyAllocate(inCD);
-    checkAbortInterval = std::min(inLines->GetNumberOfCells() / 10 + 1, (vtkIdType)1000);
-    progressCounter = 0;
-    //
-    vtkDebugMacro(<< "Starting Lines " << inCellID);
-    for (inLines->InitTraversal(); inLines->GetNextCell(npts, pts); inCellID++)
-    {
-      if (progressCounter % checkAbortInterval == 0 && this->CheckAbort())
-      {
-        break;
-      }
-      cellIds.clear();
-      for (i = 0; i < npts; i++)
-      {
-        ptId = pmap[pts[i]];
-        if (std::find(cellIds.begin(), cellIds.end(), ptId) == cellIds.end())
-        {
-          cellIds.push_back(ptId);
-        }
-      } // for all cell points
-
-      if (cellIds.size() > 1)
-      {
-        newId = newLines->InsertNextCell(cellIds.size(), cellIds.data());
-        outLineData->CopyData(inCD, inCellID, newId);
-      }
-      else if (cellIds.size() == 1 && this->ConvertLinesToPoints)
-      {
-        if (!newVerts)
-        {
-          newVerts.TakeReference(vtkCellArray::New());
-          newVerts->AllocateEstimate(5, 1);
-        }
-        newId = newVerts->InsertNextCell(cellIds.size(), cellIds.data());
-        outCD->CopyData(inCD, inCellID, newId);
-      }
-    }
-    vtkDebugMacro(<< "Removed " << inLines->GetNumberOfCells() - newLines->GetNumberOfCells()
-                  << " lines");
-  }
-  this->UpdateProgress(0.8);
-
-  // polygons reduced to two points or less are either eliminated
-  // or converted to lines or points if enabled
-  if (!this->CheckAbort() && inPolys->GetNumberOfCells() > 0)
-  {
-    newPolys.TakeReference(vtkCellArray::New());
-    newPolys->AllocateCopy(inPolys);
-    outPolyData.TakeReference(vtkCellData::New());
-    outPolyData->CopyAllocate(inCD);
-    checkAbortInterval = std::min(inPolys->GetNumberOfCells() / 10 + 1, (vtkIdType)1000);
-    progressCounter = 0;
-
-    vtkDebugMacro(<< "Starting Polys " << inCellID);
-    for (inPolys->InitTraversal(); inPolys->GetNextCell(npts, pts); inCellID++)
-    {
-      if (progressCounter % checkAbortInterval == 0 && this->CheckAbort())
-      {
-        break;
-      }
-
-      cellIds.clear();
-      for (i = 0; i < npts; i++)
-      {
-        ptId = pmap[pts[i]];
-        if (std::find(cellIds.begin(), cellIds.end(), ptId) == cellIds.end())
-        {
-          cellIds.push_back(ptId);
-        }
-      } // for points in cell
-
-      if (cellIds.size() > 2)
-      {
-        newId = newPolys->InsertNextCell(cellIds.size(), cellIds.data());
-        outPolyData->CopyData(inCD, inCellID, newId);
-      }
-      else if (cellIds.size() == 2 && this->ConvertPolysToLines)
-      {
-        if (!newLines)
-        {
-          newLines.TakeReference(vtkCellArray::New());
-          newLines->AllocateEstimate(5, 2);
-          outLineData.TakeReference(vtkCellData::New());
-          outLineData->CopyAllocate(inCD);
-        }
-        newId = newLines->InsertNextCell(cellIds.size(), cellIds.data());
-        outLineData->CopyData(inCD, inCellID, newId);
-      }
-      else if (cellIds.size() == 1 && this->ConvertLinesToPoints)
-      {
-        if (!newVerts)
-        {
-          newVerts.TakeReference(vtkCellArray::New());
-          newVerts->AllocateEstimate(5, 1);
-        }
-        newId = newVerts->InsertNextCell(cellIds.size(), cellIds.data());
-        outCD->CopyData(inCD, inCellID, newId);
-      }
-    }
-    vtkDebugMacro(<< "Removed " << inPolys->GetNumberOfCells() - newPolys->GetNumberOfCells()
-                  << " polys");
+    vtkDebugMacro(<< "Removed " << input->GetNumberOfCells() - numOutCells << " cells");
   }
   this->UpdateProgress(0.9);
 
-  // triangle strips can reduced to polys/lines/points etc
-  if (!this->CheckAbort() && inStrips->GetNumberOfCells() > 0)
-  {
-    newStrips.TakeReference(vtkCellArray::New());
-    newStrips->AllocateCopy(inStrips);
-    outStrpData.TakeReference(vtkCellData::New());
-    outStrpData->CopyAllocate(inCD);
-    checkAbortInterval = std::min(inStrips->GetNumberOfCells() / 10 + 1, (vtkIdType)1000);
-    progressCounter = 0;
-
-    for (inStrips->InitTraversal(); inStrips->GetNextCell(npts, pts); inCellID++)
-    {
-      if (progressCounter % checkAbortInterval == 0 && this->CheckAbort())
-      {
-        break;
-      }
-
-      cellIds.clear();
-      for (i = 0; i < npts; i++)
-      {
-        ptId = pmap[pts[i]];
-        if (std::find(cellIds.begin(), cellIds.end(), ptId) == cellIds.end())
-        {
-          cellIds.push_back(ptId);
-        }
-      }
-      if (cellIds.size() > 3)
-      {
-        newId = newStrips->InsertNextCell(cellIds.size(), cellIds.data());
-        outStrpData->CopyData(inCD, inCellID, newId);
-      }
-      else if (cellIds.size() == 3 && this->ConvertStripsToPolys)
-      {
-        if (!newPolys)
-        {
-          newPolys.TakeReference(vtkCellArray::New());
-          newPolys->AllocateEstimate(5, 3);
-          outPolyData.TakeReference(vtkCellData::New());
-          outPolyData->CopyAllocate(inCD);
-        }
-        newId = newPolys->InsertNextCell(cellIds.size(), cellIds.data());
-        outPolyData->CopyData(inCD, inCellID, newId);
-      }
-      else if (cellIds.size() == 2 && this->ConvertPolysToLines)
-      {
-        if (!newLines)
-        {
-          newLines.TakeReference(vtkCellArray::New());
-          newLines->AllocateEstimate(5, 2);
-          outLineData.TakeReference(vtkCellData::New());
-          outLineData->CopyAllocate(inCD);
-        }
-        newId = newLines->InsertNextCell(cellIds.size(), cellIds.data());
-        outLineData->CopyData(inCD, inCellID, newId);
-      }
-      else if (cellIds.size() == 1 && this->ConvertLinesToPoints)
-      {
-        if (!newVerts)
-        {
-          newVerts.TakeReference(vtkCellArray::New());
-          newVerts->AllocateEstimate(5, 1);
-        }
-        newId = newVerts->InsertNextCell(cellIds.size(), cellIds.data());
-        outCD->CopyData(inCD, inCellID, newId);
-      }
-    }
-    vtkDebugMacro(<< "Removed " << inStrips->GetNumberOfCells() - newStrips->GetNumberOfCells()
-                  << " strips");
-  }
-
-  vtkDebugMacro(<< "Removed " << numNewPts - newPts->GetNumberOfPoints() << " points");
+  vtkDebugMacro(<< "Removed " << numPts - numNewPts << " points");
 
   // Update ourselves and release memory
   //
   this->Locator->Initialize(); // release memory.
 
-  // Now transfer all CellData from Lines/Polys/Strips into final
-  // cell attribute data. The vertex cell data has already been inserted.
-  vtkIdType cellCounter = (newVerts == nullptr ? 0 : newVerts->GetNumberOfCells());
-  vtkIdType lineCounter = (newLines == nullptr ? 0 : newLines->GetNumberOfCells());
-  vtkIdType polyCounter = (newPolys == nullptr ? 0 : newPolys->GetNumberOfCells());
-  vtkIdType strpCounter = (newStrips == nullptr ? 0 : newStrips->GetNumberOfCells());
-
-  if (newLines)
-  {
-    for (i = 0; i < lineCounter; ++i, ++cellCounter)
-    {
-      outCD->CopyData(outLineData, i, cellCounter);
-    }
-  }
-  if (newPolys)
-  {
-    for (i = 0; i < polyCounter; ++i, ++cellCounter)
-    {
-      outCD->CopyData(outPolyData, i, cellCounter);
-    }
-  }
-  if (newStrips)
-  {
-    for (i = 0; i < strpCounter; ++i, ++cellCounter)
-    {
-      outCD->CopyData(outStrpData, i, cellCounter);
-    }
-  }
-
-  // Update the output connectivity
-  if (newVerts)
-  {
-    output->SetVerts(newVerts);
-  }
-  if (newLines)
-  {
-    output->SetLines(newLines);
-  }
-  if (newPolys)
-  {
-    output->SetPolys(newPolys);
-  }
-  if (newStrips)
-  {
-    output->SetStrips(newStrips);
-  }
-
   return 1;
 }
 
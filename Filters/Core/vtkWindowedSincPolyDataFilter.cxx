@@ -882,6 +882,7 @@ struct AnalyzePoints
     vtkIdType numPts = this->Points->GetNumberOfTuples();
     if (numPts > 0)
     {
+      vtkSMPTools::LoopLabel label("vtkWindowedSincPolyDataFilter::AnalyzePoints");
       vtkSMPTools::For(0, numPts, *this);
     }
   }
@@ -1183,6 +1184,7 @@ struct InitSmoothingWorker
     PointConnectivity<TIds>* ptConn, double* c, int ptSelect[4],
     vtkWindowedSincPolyDataFilter* filter)
   {
+    vtkSMPTools::LoopLabel label("vtkWindowedSincPolyDataFilter::Smooth");
     vtkSMPTools::For(0, numPts,
       [&](vtkIdType ptId, vtkIdType endPtId)
       {
@@ -1254,6 +1256,7 @@ struct SmoothingWorker
     PointConnectivity<TIds>* ptConn, int iterNum, double* c, int ptSelect[4],
     vtkWindowedSincPolyDataFilter* filter)
   {
+    vtkSMPTools::LoopLabel label("vtkWindowedSincPolyDataFilter::Smooth");
     vtkSMPTools::For(0, numPts,
       [&](vtkIdType ptId, vtkIdType endPtId)
       {
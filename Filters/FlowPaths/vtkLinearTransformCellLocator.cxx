@@ -481,6 +481,12 @@ vtkIdType vtkLinearTransformCellLocator::FindCell(
   return cellId;
 }
 
+//------------------------------------------------------------------------------
+int vtkLinearTransformCellLocator::GetThreadSafeQueries()
+{
+  return this->CellLocator ? this->CellLocator->GetThreadSafeQueries() : 0;
+}
+
 //------------------------------------------------------------------------------
 bool vtkLinearTransformCellLocator::InsideCellBounds(double x[3], vtkIdType cellId)
 {
@@ -167,6 +167,11 @@ public:
   vtkIdType FindCell(double x[3], double vtkNotUsed(tol2), vtkGenericCell* cell, int& subId,
     double pcoords[3], double* weights) override;
 
+  /**
+   * Return the thread safe queries of the cell locator.
+   */
+  int GetThreadSafeQueries() override;
+
   /**
    * Quickly test if a point is inside the bounds of a particular cell.
    * This function should be used ONLY after the locator is built.
@@ -202,6 +202,12 @@ public:
   vtkIdType FindCell(double x[3], double vtkNotUsed(tol2), vtkGenericCell* GenCell, int& subId,
     double pcoords[3], double* weights) override;
 
+  /**
+   * FindCell and IntersectWithLine are thread safe, the batched queries
+   * using them run in parallel.
+   */
+  int GetThreadSafeQueries() override { return FIND_CELL | INTERSECT_WITH_LINE; }
+
   /**
    * After subdivision has completed, one may wish to query the tree to find
    * which cells are in which leaf nodes. This function returns a list
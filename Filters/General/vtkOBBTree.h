@@ -108,6 +108,12 @@ public:
   int IntersectWithLine(const double a0[3], const double a1[3], double tol, double& t, double x[3],
     double pcoords[3], int& subId, vtkIdType& cellId, vtkGenericCell* cell) override;
 
+  /**
+   * IntersectWithLine is thread safe, the batched IntersectWithLines runs in
+   * parallel.
+   */
+  int GetThreadSafeQueries() override { return INTERSECT_WITH_LINE; }
+
   /**
    * Take the passed line segment and intersect it with the data set.
    * This method assumes that the data set is a vtkPolyData that describes
@@ -1259,7 +1259,10 @@ vtkSmartPointer<vtkUnstructuredGrid> vtkTableBasedClipDataSet::ClipTDataSet(
   // Evaluate points and calculate pointBatches, numberOfKeptPoints, pointsMap using clipArray
   EvaluatePoints<TInputIdType, TInsideOut> evaluatePoints(
     clipArray, isoValue, this->BatchSize, this);
-  vtkSMPTools::For(0, evaluatePoints.PointBatches.GetNumberOfBatches(), evaluatePoints);
+  {
+    vtkSMPTools::LoopLabel label("vtkTableBasedClipDataSet::EvaluatePoints");
+    vtkSMPTools::For(0, evaluatePoints.PointBatches.GetNumberOfBatches(), evaluatePoints);
+  }
   const TInputIdType numberOfKeptPoints = evaluatePoints.NumberOfKeptPoints;
   const TableBasedPointBatches& pointBatches = evaluatePoints.PointBatches;
   vtkSmartPointer<vtkAOSDataArrayTemplate<TInputIdType>> pointsMap = evaluatePoints.PointsMap;
@@ -1279,7 +1282,10 @@ vtkSmartPointer<vtkUnstructuredGrid> vtkTableBasedClipDataSet::ClipTDataSet(
   using TEdge = EdgeType<TInputIdType>;
   EvaluateCells<TGrid, TInputIdType, TInsideOut> evaluateCells(
     input, clipArray.Get(), isoValue, this->BatchSize, this);
-  vtkSMPTools::For(0, evaluateCells.CellBatches.GetNumberOfBatches(), evaluateCells);
+  {
+    vtkSMPTools::LoopLabel label("vtkTableBasedClipDataSet::EvaluateCells");
+    vtkSMPTools::For(0, evaluateCells.CellBatches.GetNumberOfBatches(), evaluateCells);
+  }
   const vtkIdType connectivitySize = evaluateCells.ConnectivitySize;
   const vtkIdType numberOfOutputCells = evaluateCells.NumberOfOutputCells;
   const vtkIdType numberOfCentroids = evaluateCells.NumberOfCentroids;
@@ -1343,6 +1349,7 @@ vtkSmartPointer<vtkUnstructuredGrid> vtkTableBasedClipDataSet::ClipTDataSet(
     ExtractCells<TGrid, TInputIdType, TOutputIdType, TInsideOut> extractCells(input,
       pointsMap.Get(), cellsCase.Get(), cellBatches, cellDataArrays, edgeLocator, connectivitySize,
       numberOfOutputCells, numberOfKeptPoints, numberOfEdges, numberOfCentroids, this);
+    vtkSMPTools::LoopLabel label("vtkTableBasedClipDataSet::ExtractCells");
     vtkSMPTools::For(0, extractCells.CellBatches.GetNumberOfBatches(), extractCells);
     centroids = std::move(extractCells.Centroids);
     outputCellTypes = extractCells.OutputCellTypes;
@@ -1356,6 +1363,7 @@ vtkSmartPointer<vtkUnstructuredGrid> vtkTableBasedClipDataSet::ClipTDataSet(
     ExtractCells<TGrid, TInputIdType, TOutputIdType, TInsideOut> extractCells(input,
       pointsMap.Get(), cellsCase.Get(), cellBatches, cellDataArrays, edgeLocator, connectivitySize,
       numberOfOutputCells, numberOfKeptPoints, numberOfEdges, numberOfCentroids, this);
+    vtkSMPTools::LoopLabel label("vtkTableBasedClipDataSet::ExtractCells");
     vtkSMPTools::For(0, extractCells.CellBatches.GetNumberOfBatches(), extractCells);
     centroids = std::move(extractCells.Centroids);
     outputCellTypes = extractCells.OutputCellTypes;
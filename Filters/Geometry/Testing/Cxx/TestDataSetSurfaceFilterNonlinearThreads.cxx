@@ -0,0 +1,150 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// Check the threaded boundary extraction used by vtkDataSetSurfaceFilter for
+// unstructured grids with nonlinear cells: the surface must match the one
+// computed through vtkUnstructuredGridGeometryFilter, must not depend on the
+// number of threads, and the original ids must refer to the input grid.
+
+#include <vtkCellArray.h>
+#include <vtkCellData.h>
+#include <vtkCellType.h>
+#include <vtkCellTypeSource.h>
+#include <vtkDataSetSurfaceFilter.h>
+#include <vtkIdList.h>
+#include <vtkIdTypeArray.h>
+#include <vtkNew.h>
+#include <vtkPointData.h>
+#include <vtkPoints.h>
+#include <vtkPolyData.h>
+#include <vtkSMPTools.h>
+#include <vtkUnstructuredGrid.h>
+#include <vtkUnstructuredGridGeometryFilter.h>
+
+#include <cstdlib>
+#include <iostream>
+
+namespace
+{
+//------------------------------------------------------------------------------
+bool SameArrays(vtkDataArray* a0, vtkDataArray* a1)
+{
+  if (!a0 || !a1 || a0->GetNumberOfTuples() != a1->GetNumberOfTuples() ||
+    a0->GetNumberOfComponents() != a1->GetNumberOfComponents())
+  {
+    return false;
+  }
+  for (vtkIdType i = 0; i < a0->GetNumberOfValues(); ++i)
+  {
+    if (a0->GetComponent(i / a0->GetNumberOfComponents(), i % a0->GetNumberOfComponents()) !=
+      a1->GetComponent(i / a1->GetNumberOfComponents(), i % a1->GetNumberOfComponents()))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+void ExtractSurface(vtkUnstructuredGrid* grid, int level, vtkPolyData* output)
+{
+  vtkNew<vtkDataSetSurfaceFilter> surface;
+  surface->SetInputData(grid);
+  surface->SetNonlinearSubdivisionLevel(level);
+  surface->PassThroughCellIdsOn();
+  surface->PassThroughPointIdsOn();
+  surface->Update();
+  output->ShallowCopy(surface->GetOutput());
+}
+
+//------------------------------------------------------------------------------
+bool TestCellType(int cellType, int level)
+{
+  vtkNew<vtkCellTypeSource> source;
+  source->SetCellType(cellType);
+  source->SetBlocksDimensions(4, 3, 5);
+  source->Update();
+  vtkUnstructuredGrid* grid = source->GetOutput();
+
+  // Reference surface, going through vtkUnstructuredGridGeometryFilter
+  vtkNew<vtkUnstructuredGridGeometryFilter> uggf;
+  uggf->SetInputData(grid);
+  uggf->MergingOff();
+  uggf->Update();
+  vtkNew<vtkPolyData> reference;
+  ExtractSurface(vtkUnstructuredGrid::SafeDownCast(uggf->GetOutput()), level, reference);
+
+  vtkNew<vtkPolyData> serial;
+  vtkSMPTools::LocalScope(vtkSMPTools::Config{ 1 }, [&]() { ExtractSurface(grid, level, serial); });
+  vtkNew<vtkPolyData> threaded;
+  ExtractSurface(grid, level, threaded);
+
+  if (threaded->GetNumberOfCells() != reference->GetNumberOfCells() ||
+    threaded->GetNumberOfPoints() != reference->GetNumberOfPoints())
+  {
+    std::cerr << "Cell type " << cellType << ", level " << level << ": got "
+              << threaded->GetNumberOfCells() << " cells and " << threaded->GetNumberOfPoints()
+              << " points instead of " << reference->GetNumberOfCells() << " and "
+              << reference->GetNumberOfPoints() << std::endl;
+    return false;
+  }
+
+  auto cellIds =
+    vtkIdTypeArray::SafeDownCast(threaded->GetCellData()->GetArray("vtkOriginalCellIds"));
+  auto pointIds =
+    vtkIdTypeArray::SafeDownCast(threaded->GetPointData()->GetArray("vtkOriginalPointIds"));
+  if (!SameArrays(serial->GetPoints()->GetData(), threaded->GetPoints()->GetData()) ||
+    !SameArrays(serial->GetCellData()->GetArray("vtkOriginalCellIds"), cellIds) ||
+    !SameArrays(serial->GetPointData()->GetArray("vtkOriginalPointIds"), pointIds))
+  {
+    std::cerr << "Cell type " << cellType << ", level " << level
+              << ": the output depends on the number of threads" << std::endl;
+    return false;
+  }
+
+  // Without subdivision, each output cell only uses points of its original cell.
+  if (level == 0)
+  {
+    vtkNew<vtkIdList> inPts;
+    vtkNew<vtkIdList> outPts;
+    for (vtkIdType cellId = 0; cellId < threaded->GetNumberOfCells(); ++cellId)
+    {
+      const vtkIdType inCellId = cellIds->GetValue(cellId);
+      if (inCellId < 0 || inCellId >= grid->GetNumberOfCells())
+      {
+        std::cerr << "Cell type " << cellType << ": wrong original cell id " << inCellId
+                  << std::endl;
+        return false;
+      }
+      grid->GetCellPoints(inCellId, inPts);
+      threaded->GetCellPoints(cellId, outPts);
+      for (vtkIdType i = 0; i < outPts->GetNumberOfIds(); ++i)
+      {
+        if (inPts->IsId(pointIds->GetValue(outPts->GetId(i))) < 0)
+        {
+          std::cerr << "Cell type " << cellType << ": output cell " << cellId
+                    << " is not a face of input cell " << inCellId << std::endl;
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+}
+
+//------------------------------------------------------------------------------
+int TestDataSetSurfaceFilterNonlinearThreads(int, char*[])
+{
+  const int cellTypes[] = { VTK_QUADRATIC_TETRA, VTK_QUADRATIC_HEXAHEDRON,
+    VTK_TRIQUADRATIC_HEXAHEDRON, VTK_QUADRATIC_WEDGE, VTK_QUADRATIC_PYRAMID,
+    VTK_TRIQUADRATIC_PYRAMID, VTK_QUADRATIC_TRIANGLE };
+  bool success = true;
+  for (int cellType : cellTypes)
+  {
+    for (int level = 0; level < 3; ++level)
+    {
+      success &= TestCellType(cellType, level);
+    }
+  }
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -3,15 +3,19 @@
 
 #include "vtkDataSetSurfaceFilter.h"
 
+#include "vtkArrayListTemplate.h" // For processing attribute data
 #include "vtkBezierCurve.h"
 #include "vtkBezierQuadrilateral.h"
 #include "vtkBezierTriangle.h"
+#include "vtkBiQuadraticQuadraticHexahedron.h"
+#include "vtkBiQuadraticQuadraticWedge.h"
 #include "vtkCell.h"
 #include "vtkCellArray.h"
 #include "vtkCellData.h"
 #include "vtkCellTypeUtilities.h"
 #include "vtkDoubleArray.h"
 #include "vtkGenericCell.h"
+#include "vtkHexagonalPrism.h"
 #include "vtkHexahedron.h"
 #include "vtkIdList.h"
 #include "vtkIdTypeArray.h"
@@ -23,18 +27,30 @@
 #include "vtkMergePoints.h"
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
+#include "vtkPentagonalPrism.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkPyramid.h"
+#include "vtkQuadraticHexahedron.h"
+#include "vtkQuadraticLinearWedge.h"
+#include "vtkQuadraticPyramid.h"
+#include "vtkQuadraticTetra.h"
+#include "vtkQuadraticWedge.h"
 #include "vtkRectilinearGrid.h"
 #include "vtkRectilinearGridGeometryFilter.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
+#include "vtkStaticFaceHashLinksTemplate.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStructuredData.h"
 #include "vtkStructuredGrid.h"
 #include "vtkStructuredGridGeometryFilter.h"
 #include "vtkStructuredPoints.h"
 #include "vtkTetra.h"
+#include "vtkTriQuadraticHexahedron.h"
+#include "vtkTriQuadraticPyramid.h"
 #include "vtkUniformGrid.h"
 #include "vtkUnsignedCharArray.h"
 #include "vtkUnstructuredGrid.h"
@@ -48,6 +64,8 @@
 #include <cassert>
 #include <numeric>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace
 {
@@ -281,6 +299,396 @@ bool StructuredExecuteWithBlanking(
   return true;
 }
 
+//------------------------------------------------------------------------------
+// Threaded boundary extraction of unstructured grids with nonlinear cells.
+// 3D cells are replaced by the faces they do not share with another cell,
+// while 0D, 1D and 2D cells are passed as is. The serial 2D subdivision of
+// vtkDataSetSurfaceFilter then runs on the result. It is used in place of
+// vtkUnstructuredGridGeometryFilter for the cell types described below.
+
+// A face of a 3D cell: its type, its number of points and corner points, and
+// the indices of its points in the cell connectivity.
+struct FaceDescription
+{
+  int Type;
+  int NumberOfPoints;
+  int NumberOfCorners;
+  const vtkIdType* PointIndices;
+};
+
+// Face numbering follows vtkStaticFaceHashLinksTemplate. Returns false for
+// cells whose faces are not described, including all 0D, 1D and 2D cells.
+bool GetFaceDescription(unsigned char cellType, int faceId, FaceDescription& face)
+{
+  switch (cellType)
+  {
+    case VTK_TETRA:
+      face = { VTK_TRIANGLE, 3, 3, vtkTetra::GetFaceArray(faceId) };
+      return true;
+    case VTK_VOXEL:
+      face = { VTK_PIXEL, 4, 4, vtkVoxel::GetFaceArray(faceId) };
+      return true;
+    case VTK_HEXAHEDRON:
+      face = { VTK_QUAD, 4, 4, vtkHexahedron::GetFaceArray(faceId) };
+      return true;
+    case VTK_WEDGE:
+      face = faceId < 2 ? FaceDescription{ VTK_TRIANGLE, 3, 3, nullptr }
+                        : FaceDescription{ VTK_QUAD, 4, 4, nullptr };
+      face.PointIndices = vtkWedge::GetFaceArray(faceId);
+      return true;
+    case VTK_PYRAMID:
+      face = faceId < 1 ? FaceDescription{ VTK_QUAD, 4, 4, nullptr }
+                        : FaceDescription{ VTK_TRIANGLE, 3, 3, nullptr };
+      face.PointIndices = vtkPyramid::GetFaceArray(faceId);
+      return true;
+    case VTK_PENTAGONAL_PRISM:
+      face = faceId < 2 ? FaceDescription{ VTK_POLYGON, 5, 5, nullptr }
+                        : FaceDescription{ VTK_QUAD, 4, 4, nullptr };
+      face.PointIndices = vtkPentagonalPrism::GetFaceArray(faceId);
+      return true;
+    case VTK_HEXAGONAL_PRISM:
+      face = faceId < 2 ? FaceDescription{ VTK_POLYGON, 6, 6, nullptr }
+                        : FaceDescription{ VTK_QUAD, 4, 4, nullptr };
+      face.PointIndices = vtkHexagonalPrism::GetFaceArray(faceId);
+      return true;
+    case VTK_QUADRATIC_TETRA:
+      face = { VTK_QUADRATIC_TRIANGLE, 6, 3, vtkQuadraticTetra::GetFaceArray(faceId) };
+      return true;
+    case VTK_QUADRATIC_HEXAHEDRON:
+      face = { VTK_QUADRATIC_QUAD, 8, 4, vtkQuadraticHexahedron::GetFaceArray(faceId) };
+      return true;
+    case VTK_TRIQUADRATIC_HEXAHEDRON:
+      face = { VTK_BIQUADRATIC_QUAD, 9, 4, vtkTriQuadraticHexahedron::GetFaceArray(faceId) };
+      return true;
+    case VTK_BIQUADRATIC_QUADRATIC_HEXAHEDRON:
+      face = faceId < 4 ? FaceDescription{ VTK_BIQUADRATIC_QUAD, 9, 4, nullptr }
+                        : FaceDescription{ VTK_QUADRATIC_QUAD, 8, 4, nullptr };
+      face.PointIndices = vtkBiQuadraticQuadraticHexahedron::GetFaceArray(faceId);
+      return true;
+    case VTK_QUADRATIC_WEDGE:
+      face = faceId < 2 ? FaceDescription{ VTK_QUADRATIC_TRIANGLE, 6, 3, nullptr }
+                        : FaceDescription{ VTK_QUADRATIC_QUAD, 8, 4, nullptr };
+      face.PointIndices = vtkQuadraticWedge::GetFaceArray(faceId);
+      return true;
+    case VTK_QUADRATIC_LINEAR_WEDGE:
+      face = faceId < 2 ? FaceDescription{ VTK_QUADRATIC_TRIANGLE, 6, 3, nullptr }
+                        : FaceDescription{ VTK_QUADRATIC_LINEAR_QUAD, 6, 4, nullptr };
+      face.PointIndices = vtkQuadraticLinearWedge::GetFaceArray(faceId);
+      return true;
+    case VTK_BIQUADRATIC_QUADRATIC_WEDGE:
+      face = faceId < 2 ? FaceDescription{ VTK_QUADRATIC_TRIANGLE, 6, 3, nullptr }
+                        : FaceDescription{ VTK_BIQUADRATIC_QUAD, 9, 4, nullptr };
+      face.PointIndices = vtkBiQuadraticQuadraticWedge::GetFaceArray(faceId);
+      return true;
+    case VTK_QUADRATIC_PYRAMID:
+      face = faceId < 1 ? FaceDescription{ VTK_QUADRATIC_QUAD, 8, 4, nullptr }
+                        : FaceDescription{ VTK_QUADRATIC_TRIANGLE, 6, 3, nullptr };
+      face.PointIndices = vtkQuadraticPyramid::GetFaceArray(faceId);
+      return true;
+    case VTK_TRIQUADRATIC_PYRAMID:
+      face = faceId < 1 ? FaceDescription{ VTK_BIQUADRATIC_QUAD, 9, 4, nullptr }
+                        : FaceDescription{ VTK_BIQUADRATIC_TRIANGLE, 7, 3, nullptr };
+      face.PointIndices = vtkTriQuadraticPyramid::GetFaceArray(faceId);
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Returns true if the threaded boundary extraction supports all the cells of
+// the grid. Arbitrary order and polyhedral cells are left to
+// vtkUnstructuredGridGeometryFilter.
+bool SupportsThreadedBoundary(vtkUnstructuredGrid* input)
+{
+  vtkUnsignedCharArray* cellTypes = input->GetDistinctCellTypesArray();
+  for (vtkIdType i = 0; i < cellTypes->GetNumberOfValues(); ++i)
+  {
+    const unsigned char cellType = cellTypes->GetValue(i);
+    FaceDescription face;
+    if (GetFaceDescription(cellType, 0, face))
+    {
+      continue;
+    }
+    switch (cellType)
+    {
+      case VTK_EMPTY_CELL:
+      case VTK_VERTEX:
+      case VTK_POLY_VERTEX:
+      case VTK_LINE:
+      case VTK_POLY_LINE:
+      case VTK_TRIANGLE:
+      case VTK_TRIANGLE_STRIP:
+      case VTK_POLYGON:
+      case VTK_PIXEL:
+      case VTK_QUAD:
+      case VTK_QUADRATIC_EDGE:
+      case VTK_CUBIC_LINE:
+      case VTK_QUADRATIC_TRIANGLE:
+      case VTK_BIQUADRATIC_TRIANGLE:
+      case VTK_QUADRATIC_QUAD:
+      case VTK_QUADRATIC_LINEAR_QUAD:
+      case VTK_BIQUADRATIC_QUAD:
+      case VTK_QUADRATIC_POLYGON:
+        break;
+      default:
+        return false;
+    }
+  }
+  return true;
+}
+
+// The sorted point ids of a face, used to find the faces shared by two cells.
+// When matching boundaries ignoring cell order, only the corners are compared
+// and nonlinear faces are compared with their linear counterpart.
+struct FaceKey
+{
+  int Type;
+  int NumberOfIds;
+  vtkIdType Ids[9];
+
+  bool operator==(const FaceKey& other) const
+  {
+    return this->Type == other.Type && this->NumberOfIds == other.NumberOfIds &&
+      std::equal(this->Ids, this->Ids + this->NumberOfIds, other.Ids);
+  }
+};
+
+void BuildFaceKey(const vtkIdType* cellPts, const FaceDescription& face,
+  bool matchBoundariesIgnoringCellOrder, FaceKey& key)
+{
+  key.Type = face.Type;
+  key.NumberOfIds = face.NumberOfPoints;
+  if (matchBoundariesIgnoringCellOrder)
+  {
+    key.NumberOfIds = face.NumberOfCorners;
+    switch (face.Type)
+    {
+      case VTK_QUADRATIC_TRIANGLE:
+      case VTK_BIQUADRATIC_TRIANGLE:
+        key.Type = VTK_TRIANGLE;
+        break;
+      case VTK_QUADRATIC_QUAD:
+      case VTK_QUADRATIC_LINEAR_QUAD:
+      case VTK_BIQUADRATIC_QUAD:
+        key.Type = VTK_QUAD;
+        break;
+      default:
+        break;
+    }
+  }
+  for (int i = 0; i < key.NumberOfIds; ++i)
+  {
+    key.Ids[i] = cellPts[face.PointIndices[i]];
+  }
+  std::sort(key.Ids, key.Ids + key.NumberOfIds);
+}
+
+template <typename TInputIdType>
+vtkSmartPointer<vtkUnstructuredGrid> ExtractBoundary(vtkUnstructuredGrid* input,
+  vtkDataSetSurfaceFilter* self, std::vector<vtkIdType>& sourceCellIds)
+{
+  using TFaceHashLinks = vtkStaticFaceHashLinksTemplate<TInputIdType, vtkTypeInt8>;
+  const bool matchCorners = self->GetMatchBoundariesIgnoringCellOrder() != 0;
+
+  // Faces are grouped by the smallest id of their corner points, so that
+  // faces shared by two cells end up in the same hash.
+  TFaceHashLinks faceHashLinks;
+  faceHashLinks.BuildHashLinks(input);
+  // The last hash gathers the 0D, 1D and 2D cells.
+  const vtkIdType lowDimHash = faceHashLinks.GetNumberOfHashes() - 1;
+  const TInputIdType* firstLink = faceHashLinks.GetCellIdOfFacesInHash(0);
+
+  // Flag the faces used by a single cell and count them per hash.
+  std::vector<unsigned char> isBoundary(faceHashLinks.GetNumberOfFaces(), 0);
+  std::vector<vtkIdType> hashOffsets(lowDimHash + 1, 0);
+  vtkSMPThreadLocal<std::vector<FaceKey>> tlKeys;
+  vtkSMPThreadLocalObject<vtkIdList> tlCellPointIds;
+  vtkSMPTools::For(0, lowDimHash,
+    [&](vtkIdType beginHash, vtkIdType endHash)
+    {
+      std::vector<FaceKey>& keys = tlKeys.Local();
+      vtkIdList* cellPointIds = tlCellPointIds.Local();
+      const bool isFirst = vtkSMPTools::GetSingleThread();
+      vtkIdType npts;
+      const vtkIdType* pts;
+      FaceDescription face;
+      for (vtkIdType hash = beginHash; hash < endHash; ++hash)
+      {
+        if (hash % 10000 == 0)
+        {
+          if (isFirst)
+          {
+            self->CheckAbort();
+          }
+          if (self->GetAbortOutput())
+          {
+            break;
+          }
+        }
+        const vtkIdType numFaces = faceHashLinks.GetNumberOfFacesInHash(hash);
+        if (numFaces == 0)
+        {
+          continue;
+        }
+        const TInputIdType* cellIds = faceHashLinks.GetCellIdOfFacesInHash(hash);
+        const vtkTypeInt8* faceIds = faceHashLinks.GetFaceIdOfFacesInHash(hash);
+        keys.resize(numFaces);
+        for (vtkIdType i = 0; i < numFaces; ++i)
+        {
+          input->GetCellPoints(cellIds[i], npts, pts, cellPointIds);
+          GetFaceDescription(input->GetCellType(cellIds[i]), faceIds[i], face);
+          BuildFaceKey(pts, face, matchCorners, keys[i]);
+        }
+        unsigned char* boundary = isBoundary.data() + (cellIds - firstLink);
+        std::fill_n(boundary, numFaces, 1);
+        for (vtkIdType i = 0; i < numFaces; ++i)
+        {
+          for (vtkIdType j = i + 1; j < numFaces; ++j)
+          {
+            if (keys[i] == keys[j])
+            {
+              boundary[i] = boundary[j] = 0;
+            }
+          }
+        }
+        hashOffsets[hash] = std::count(boundary, boundary + numFaces, 1);
+      }
+    });
+  if (self->GetAbortOutput())
+  {
+    return nullptr;
+  }
+  vtkSMPTools::ExclusiveScan(
+    hashOffsets.begin(), hashOffsets.end(), hashOffsets.begin(), vtkIdType(0));
+
+  // The 0D, 1D and 2D cells come first, in the order of the input. Empty
+  // cells are not hashed and produce nothing.
+  const vtkIdType numLowDimCells = faceHashLinks.GetNumberOfFacesInHash(lowDimHash);
+  const vtkIdType numBoundaryFaces = hashOffsets[lowDimHash];
+  const vtkIdType numOutCells = numLowDimCells + numBoundaryFaces;
+  sourceCellIds.resize(numOutCells);
+  std::vector<vtkTypeInt8> sourceFaceIds(numOutCells, -1);
+  const TInputIdType* lowDimCellIds = faceHashLinks.GetCellIdOfFacesInHash(lowDimHash);
+  std::copy(lowDimCellIds, lowDimCellIds + numLowDimCells, sourceCellIds.begin());
+  vtkSMPTools::Sort(sourceCellIds.begin(), sourceCellIds.begin() + numLowDimCells);
+
+  // Boundary faces follow, sorted by hash and then by cell and face ids.
+  vtkSMPThreadLocal<std::vector<std::pair<vtkIdType, vtkTypeInt8>>> tlFaces;
+  vtkSMPTools::For(0, lowDimHash,
+    [&](vtkIdType beginHash, vtkIdType endHash)
+    {
+      std::vector<std::pair<vtkIdType, vtkTypeInt8>>& faces = tlFaces.Local();
+      for (vtkIdType hash = beginHash; hash < endHash; ++hash)
+      {
+        if (hashOffsets[hash] == hashOffsets[hash + 1])
+        {
+          continue;
+        }
+        const vtkIdType numFaces = faceHashLinks.GetNumberOfFacesInHash(hash);
+        const TInputIdType* cellIds = faceHashLinks.GetCellIdOfFacesInHash(hash);
+        const vtkTypeInt8* faceIds = faceHashLinks.GetFaceIdOfFacesInHash(hash);
+        const unsigned char* boundary = isBoundary.data() + (cellIds - firstLink);
+        faces.clear();
+        for (vtkIdType i = 0; i < numFaces; ++i)
+        {
+          if (boundary[i])
+          {
+            faces.emplace_back(cellIds[i], faceIds[i]);
+          }
+        }
+        std::sort(faces.begin(), faces.end());
+        vtkIdType outCellId = numLowDimCells + hashOffsets[hash];
+        for (const auto& cellFace : faces)
+        {
+          sourceCellIds[outCellId] = cellFace.first;
+          sourceFaceIds[outCellId++] = cellFace.second;
+        }
+      }
+    });
+  faceHashLinks.Reset();
+  std::vector<unsigned char>().swap(isBoundary);
+  self->UpdateProgress(0.2);
+
+  // Compute the connectivity offsets, then write the connectivity and types.
+  vtkNew<vtkIdTypeArray> offsets;
+  offsets->SetNumberOfValues(numOutCells + 1);
+  vtkIdType* offsetsPtr = offsets->GetPointer(0);
+  vtkSMPTools::For(0, numOutCells,
+    [&](vtkIdType beginCellId, vtkIdType endCellId)
+    {
+      FaceDescription face;
+      for (vtkIdType cellId = beginCellId; cellId < endCellId; ++cellId)
+      {
+        const vtkIdType inCellId = sourceCellIds[cellId];
+        offsetsPtr[cellId] =
+          GetFaceDescription(input->GetCellType(inCellId), sourceFaceIds[cellId], face)
+          ? face.NumberOfPoints
+          : input->GetCellSize(inCellId);
+      }
+    });
+  offsetsPtr[numOutCells] = 0;
+  vtkSMPTools::ExclusiveScan(offsetsPtr, offsetsPtr + numOutCells + 1, offsetsPtr, vtkIdType(0));
+
+  vtkNew<vtkIdTypeArray> connectivity;
+  connectivity->SetNumberOfValues(offsetsPtr[numOutCells]);
+  vtkIdType* connectivityPtr = connectivity->GetPointer(0);
+  vtkNew<vtkUnsignedCharArray> types;
+  types->SetNumberOfValues(numOutCells);
+  unsigned char* typesPtr = types->GetPointer(0);
+  vtkSMPTools::For(0, numOutCells,
+    [&](vtkIdType beginCellId, vtkIdType endCellId)
+    {
+      vtkIdList* cellPointIds = tlCellPointIds.Local();
+      vtkIdType npts;
+      const vtkIdType* pts;
+      FaceDescription face;
+      for (vtkIdType cellId = beginCellId; cellId < endCellId; ++cellId)
+      {
+        const vtkIdType inCellId = sourceCellIds[cellId];
+        const unsigned char cellType = input->GetCellType(inCellId);
+        input->GetCellPoints(inCellId, npts, pts, cellPointIds);
+        vtkIdType* outPts = connectivityPtr + offsetsPtr[cellId];
+        if (GetFaceDescription(cellType, sourceFaceIds[cellId], face))
+        {
+          typesPtr[cellId] = static_cast<unsigned char>(face.Type);
+          for (int i = 0; i < face.NumberOfPoints; ++i)
+          {
+            outPts[i] = pts[face.PointIndices[i]];
+          }
+        }
+        else
+        {
+          typesPtr[cellId] = cellType;
+          std::copy(pts, pts + npts, outPts);
+        }
+      }
+    });
+  vtkNew<vtkCellArray> cells;
+  cells->SetData(offsets, connectivity);
+
+  // Points are kept as is so that the point ids of the output match the input.
+  auto boundary = vtkSmartPointer<vtkUnstructuredGrid>::New();
+  boundary->SetPoints(input->GetPoints());
+  boundary->GetPointData()->ShallowCopy(input->GetPointData());
+  boundary->SetCells(types, cells);
+
+  vtkCellData* outCD = boundary->GetCellData();
+  outCD->CopyAllocate(input->GetCellData(), numOutCells);
+  ArrayList cellArrays;
+  cellArrays.AddArrays(numOutCells, input->GetCellData(), outCD, 0.0, false);
+  vtkSMPTools::For(0, numOutCells,
+    [&](vtkIdType beginCellId, vtkIdType endCellId)
+    {
+      for (vtkIdType cellId = beginCellId; cellId < endCellId; ++cellId)
+      {
+        cellArrays.Copy(sourceCellIds[cellId], cellId);
+      }
+    });
+  self->UpdateProgress(0.3);
+
+  return boundary;
+}
+
 }
 
 VTK_ABI_NAMESPACE_BEGIN
@@ -1398,10 +1806,27 @@ int vtkDataSetSurfaceFilter::UnstructuredGridExecuteInternal(
   vtkUnstructuredGridBase* input, vtkPolyData* output, bool handleSubdivision)
 {
   vtkSmartPointer<vtkUnstructuredGrid> tempInput;
-  if (handleSubdivision)
+  // Input cell of each cell of tempInput when it comes from ExtractBoundary().
+  std::vector<vtkIdType> tempSourceCellIds;
+  vtkUnstructuredGrid* grid = vtkUnstructuredGrid::SafeDownCast(input);
+  if (handleSubdivision && grid && SupportsThreadedBoundary(grid))
   {
     // Since this filter only properly subdivides 2D cells past
-    // level 1, we convert 3D cells to 2D by using
+    // level 1, we convert 3D cells to 2D by extracting their
+    // boundary faces in parallel.
+    const bool use64BitsIds =
+      grid->GetNumberOfPoints() > VTK_INT_MAX || grid->GetNumberOfCells() > VTK_INT_MAX;
+    tempInput = use64BitsIds ? ExtractBoundary<vtkIdType>(grid, this, tempSourceCellIds)
+                             : ExtractBoundary<vtkTypeInt32>(grid, this, tempSourceCellIds);
+    if (!tempInput)
+    {
+      return 1;
+    }
+    input = tempInput;
+  }
+  else if (handleSubdivision)
+  {
+    // Arbitrary order and polyhedral cells are converted to 2D by
     // vtkUnstructuredGridGeometryFilter.
     vtkNew<vtkUnstructuredGridGeometryFilter> uggf;
     vtkNew<vtkUnstructuredGrid> clone;
@@ -2239,6 +2664,19 @@ int vtkDataSetSurfaceFilter::UnstructuredGridExecuteInternal(
 
   if (this->PassThroughCellIds)
   {
+    if (!tempSourceCellIds.empty())
+    {
+      // Map the cells of the extracted boundary back to the input cells.
+      vtkIdType* cellIds = this->OriginalCellIds->GetPointer(0);
+      vtkSMPTools::For(0, this->OriginalCellIds->GetNumberOfValues(),
+        [&](vtkIdType begin, vtkIdType end)
+        {
+          for (vtkIdType i = begin; i < end; ++i)
+          {
+            cellIds[i] = tempSourceCellIds[cellIds[i]];
+          }
+        });
+    }
     outputCD->AddArray(this->OriginalCellIds);
   }
   if (this->PassThroughPointIds)
@@ -6,15 +6,18 @@
 #include "vtkArrayDispatch.h"
 #include "vtkArrayDispatchDataSetArrayList.h"
 #include "vtkDataArrayRange.h"
-#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
 #include "vtkMath.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointSet.h"
 #include "vtkPoints.h"
-#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPThreadLocal.h"
 #include "vtkSMPTools.h"
 #include "vtkStaticPointLocator.h"
 
+#include <algorithm>
+
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkStatisticalOutlierRemoval);
 vtkCxxSetObjectMacro(vtkStatisticalOutlierRemoval, Locator, vtkAbstractPointLocator);
@@ -25,42 +28,38 @@ namespace
 {
 
 //------------------------------------------------------------------------------
-// The threaded core of the algorithm (first pass)
+// The threaded core of the algorithm (first pass). The neighbors of a chunk
+// of points are found beforehand with a single batched query.
 template <typename TArray>
 struct ComputeMeanDistanceFunctor
 {
   TArray* Points;
-  vtkAbstractPointLocator* Locator;
-  int SampleSize;
+  const vtkIdType* Neighbors;
+  int NumberOfNeighbors;
+  vtkIdType ChunkStart;
   float* Distance;
-  double Mean;
+  double Sum;
+  vtkIdType Count;
 
-  // Don't want to allocate working arrays on every thread invocation. Thread local
-  // storage lots of new/delete.
-  vtkSMPThreadLocalObject<vtkIdList> PIds;
-  vtkSMPThreadLocal<double> ThreadMean;
+  vtkSMPThreadLocal<double> ThreadSum;
   vtkSMPThreadLocal<vtkIdType> ThreadCount;
 
-  ComputeMeanDistanceFunctor(TArray* points, vtkAbstractPointLocator* loc, int size, float* d)
+  ComputeMeanDistanceFunctor(TArray* points, const vtkIdType* neighbors, int numNeighbors,
+    vtkIdType chunkStart, float* d)
     : Points(points)
-    , Locator(loc)
-    , SampleSize(size)
+    , Neighbors(neighbors)
+    , NumberOfNeighbors(numNeighbors)
+    , ChunkStart(chunkStart)
     , Distance(d)
-    , Mean(0.0)
+    , Sum(0.0)
+    , Count(0)
   {
   }
 
-  // Just allocate a little bit of memory to get started.
   void Initialize()
   {
-    vtkIdList*& pIds = this->PIds.Local();
-    pIds->Allocate(128); // allocate some memory
-
-    double& threadMean = this->ThreadMean.Local();
-    threadMean = 0.0;
-
-    vtkIdType& threadCount = this->ThreadCount.Local();
-    threadCount = 0;
+    this->ThreadSum.Local() = 0.0;
+    this->ThreadCount.Local() = 0;
   }
 
   // Compute average distance for each point, plus accumulate summation of
@@ -70,24 +69,24 @@ struct ComputeMeanDistanceFunctor
     auto points = vtk::DataArrayTupleRange<3>(this->Points);
     auto px = points.begin() + ptId;
     double x[3], y[3];
-    vtkIdList*& pIds = this->PIds.Local();
-    double& threadMean = this->ThreadMean.Local();
+    double& threadSum = this->ThreadSum.Local();
     vtkIdType& threadCount = this->ThreadCount.Local();
 
     for (; ptId < endPtId; ++ptId, ++px)
     {
       px->GetTuple(x);
 
-      // The method FindClosestNPoints will include the current point, so
-      // we increase the sample size by one.
-      this->Locator->FindClosestNPoints(this->SampleSize + 1, x, pIds);
-      vtkIdType numPts = pIds->GetNumberOfIds();
-
+      // The neighbors include the current point, the list is padded with -1
+      // when there are less points than requested.
+      const vtkIdType* pIds =
+        this->Neighbors + (ptId - this->ChunkStart) * this->NumberOfNeighbors;
+      vtkIdType numPts = 0;
       double sum = 0.0;
       vtkIdType nei;
-      for (int sample = 0; sample < numPts; ++sample)
+      for (int sample = 0; sample < this->NumberOfNeighbors && pIds[sample] >= 0; ++sample)
       {
-        nei = pIds->GetId(sample);
+        ++numPts;
+        nei = pIds[sample];
         if (nei != ptId) // exclude ourselves
         {
           auto py = points[nei];
@@ -100,7 +99,7 @@ struct ComputeMeanDistanceFunctor
       if (numPts > 0)
       {
         this->Distance[ptId] = sum / static_cast<double>(numPts - 1);
-        threadMean += this->Distance[ptId];
+        threadSum += this->Distance[ptId];
         threadCount++;
       }
       else // ignore if no points are found, something bad has happened
@@ -110,41 +109,55 @@ struct ComputeMeanDistanceFunctor
     }
   }
 
-  // Compute the mean by compositing all threads
+  // Composite the sums of all threads
   void Reduce()
   {
-    double mean = 0.0;
-    vtkIdType count = 0;
-
-    vtkSMPThreadLocal<double>::iterator mItr;
-    vtkSMPThreadLocal<double>::iterator mEnd = this->ThreadMean.end();
-    for (mItr = this->ThreadMean.begin(); mItr != mEnd; ++mItr)
+    for (double threadSum : this->ThreadSum)
     {
-      mean += *mItr;
+      this->Sum += threadSum;
     }
-
-    vtkSMPThreadLocal<vtkIdType>::iterator cItr;
-    vtkSMPThreadLocal<vtkIdType>::iterator cEnd = this->ThreadCount.end();
-    for (cItr = this->ThreadCount.begin(); cItr != cEnd; ++cItr)
+    for (vtkIdType threadCount : this->ThreadCount)
     {
-      count += *cItr;
+      this->Count += threadCount;
     }
-
-    count = (count < 1 ? 1 : count);
-    this->Mean = mean / static_cast<double>(count);
   }
 }; // ComputeMeanDistanceFunctor
 
 struct ComputeMeanDistanceWorker
 {
+  // Number of points whose neighbors are searched at once, this bounds the
+  // memory used by the lists of neighbors.
+  static constexpr vtkIdType ChunkSize = 65536;
+
   template <typename TArray>
-  void operator()(
-    TArray* points, vtkStatisticalOutlierRemoval* self, float* distances, double& mean)
+  void operator()(TArray* points, vtkPoints* inPts, vtkStatisticalOutlierRemoval* self,
+    float* distances, double& mean)
   {
-    ComputeMeanDistanceFunctor<TArray> meanDist(
-      points, self->GetLocator(), self->GetSampleSize(), distances);
-    vtkSMPTools::For(0, points->GetNumberOfTuples(), meanDist);
-    mean = meanDist.Mean;
+    // The method FindClosestNPoints will include the current point, so
+    // we increase the sample size by one.
+    const int numNeighbors = self->GetSampleSize() + 1;
+    const vtkIdType numPts = inPts->GetNumberOfPoints();
+    vtkNew<vtkPoints> chunk;
+    chunk->SetDataType(inPts->GetDataType());
+    vtkNew<vtkIdTypeArray> neighbors;
+    double sum = 0.0;
+    vtkIdType count = 0;
+    for (vtkIdType chunkStart = 0; chunkStart < numPts; chunkStart += ChunkSize)
+    {
+      const vtkIdType chunkEnd = std::min(chunkStart + ChunkSize, numPts);
+      chunk->SetNumberOfPoints(chunkEnd - chunkStart);
+      chunk->InsertPoints(0, chunkEnd - chunkStart, chunkStart, inPts);
+      self->GetLocator()->FindClosestNPointsBatch(numNeighbors, chunk, neighbors);
+
+      ComputeMeanDistanceFunctor<TArray> meanDist(
+        points, neighbors->GetPointer(0), numNeighbors, chunkStart, distances);
+      vtkSMPTools::For(chunkStart, chunkEnd, meanDist);
+      sum += meanDist.Sum;
+      count += meanDist.Count;
+    }
+
+    count = (count < 1 ? 1 : count);
+    mean = sum / static_cast<double>(count);
   }
 };
 
@@ -305,10 +318,11 @@ int vtkStatisticalOutlierRemoval::FilterPoints(vtkPointSet* input)
   float* dist = new float[numPts];
   double mean = 0.0, sigma = 0.0;
   ComputeMeanDistanceWorker worker;
+  vtkPoints* inPts = input->GetPoints();
   if (!vtkArrayDispatch::DispatchByArray<vtkArrayDispatch::PointArrays>::Execute(
-        input->GetPoints()->GetData(), worker, this, dist, mean))
+        inPts->GetData(), worker, inPts, this, dist, mean))
   {
-    worker(input->GetPoints()->GetData(), this, dist, mean);
+    worker(inPts->GetData(), inPts, this, dist, mean);
   }
 
   // At this point the mean distance for each point, and across the point
@@ -0,0 +1,76 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkToCompressedArrayStrategy.h"
+
+#include "vtkCompressedArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkZLibDataCompressor.h"
+
+#include <cmath>
+#include <cstdlib>
+
+#include <iostream>
+
+int TestToCompressedArrayStrategy(int, char*[])
+{
+  vtkNew<vtkDoubleArray> baseArr;
+  baseArr->SetName("Smooth");
+  baseArr->SetNumberOfComponents(3);
+  baseArr->SetNumberOfTuples(50000);
+  for (vtkIdType iT = 0; iT < baseArr->GetNumberOfTuples(); ++iT)
+  {
+    const double x = static_cast<float>(std::cos(iT * 1e-4));
+    baseArr->SetTuple3(iT, x, 2.0 * x, 100.0);
+  }
+
+  vtkNew<vtkToCompressedArrayStrategy> strat;
+  strat->SetBlockSize(8192);
+  auto opt = strat->EstimateReduction(baseArr);
+  if (!opt.IsSome || opt.Value >= 1.0)
+  {
+    std::cout << "Could not successfully compress smooth array." << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::cout << "Reduction factor with LZ4: " << opt.Value << std::endl;
+
+  vtkSmartPointer<vtkDataArray> compressed = strat->Reduce(baseArr);
+  vtkSmartPointer<vtkCompressedArray<double>> typed =
+    vtkArrayDownCast<vtkCompressedArray<double>>(compressed);
+  if (!typed)
+  {
+    std::cout << "Did not successfully identify type of compressed array to use" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  if (typed->GetNumberOfComponents() != baseArr->GetNumberOfComponents() ||
+    typed->GetNumberOfTuples() != baseArr->GetNumberOfTuples())
+  {
+    std::cout << "Did not set the shape of the compressed array correctly" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  for (vtkIdType iV = 0; iV < baseArr->GetNumberOfValues(); ++iV)
+  {
+    if (typed->GetValue(iV) != baseArr->GetValue(iV))
+    {
+      std::cout << "Compressed array does not evaluate to base array" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Any compressor can be used.
+  vtkNew<vtkZLibDataCompressor> zlib;
+  strat->SetCompressor(zlib);
+  strat->ClearCache();
+  compressed = strat->Reduce(baseArr);
+  for (vtkIdType iT = 0; iT < baseArr->GetNumberOfTuples(); iT += 101)
+  {
+    if (compressed->GetComponent(iT, 1) != baseArr->GetComponent(iT, 1))
+    {
+      std::cout << "Compressed array does not evaluate to base array with zlib" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
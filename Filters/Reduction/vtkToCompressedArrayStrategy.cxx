@@ -0,0 +1,158 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkToCompressedArrayStrategy.h"
+
+#include "vtkCompressedArray.h"
+#include "vtkDataArray.h"
+#include "vtkDataCompressor.h"
+#include "vtkLZ4DataCompressor.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkSmartPointer.h"
+
+#include <vector>
+
+namespace
+{
+struct GenerateCompressedWorklet
+{
+  template <typename ValueType>
+  void operator()(ValueType*, vtkDataArray* arr, vtkDataCompressor* dataCompressor,
+    vtkIdType blockSize, int cacheSize, vtkSmartPointer<vtkDataArray>& cArr) const
+  {
+    vtkSmartPointer<vtkDataCompressor> compressor = dataCompressor;
+    auto compress = [compressor](const unsigned char* input, std::size_t inputSize,
+                      std::vector<unsigned char>& output)
+    {
+      output.resize(compressor->GetMaximumCompressionSpace(inputSize));
+      const std::size_t size =
+        compressor->Compress(input, inputSize, output.data(), output.size());
+      output.resize(size);
+      return size != 0;
+    };
+    auto decompress = [compressor](const unsigned char* input, std::size_t inputSize,
+                        unsigned char* output, std::size_t outputSize)
+    { return compressor->Uncompress(input, inputSize, output, outputSize) == outputSize; };
+
+    vtkNew<vtkCompressedArray<ValueType>> compressed;
+    compressed->ConstructBackend(arr, blockSize, compress, decompress, cacheSize);
+    compressed->SetNumberOfComponents(arr->GetNumberOfComponents());
+    compressed->SetNumberOfTuples(arr->GetNumberOfTuples());
+    compressed->SetName(arr->GetName());
+    cArr = compressed;
+  }
+};
+}
+
+VTK_ABI_NAMESPACE_BEGIN
+//-------------------------------------------------------------------------
+struct vtkToCompressedArrayStrategy::vtkInternals
+{
+  vtkSmartPointer<vtkDataArray> Compressed;
+  vtkDataArray* CachedArray = nullptr;
+  vtkMTimeType ArrayMTimeAtCaching = 0;
+};
+
+//-------------------------------------------------------------------------
+vtkObjectFactoryNewMacro(vtkToCompressedArrayStrategy);
+vtkCxxSetObjectMacro(vtkToCompressedArrayStrategy, Compressor, vtkDataCompressor);
+
+//-------------------------------------------------------------------------
+vtkToCompressedArrayStrategy::vtkToCompressedArrayStrategy()
+  : Internals(new vtkInternals())
+{
+  this->Compressor = vtkLZ4DataCompressor::New();
+}
+
+//-------------------------------------------------------------------------
+vtkToCompressedArrayStrategy::~vtkToCompressedArrayStrategy()
+{
+  this->SetCompressor(nullptr);
+}
+
+//-------------------------------------------------------------------------
+void vtkToCompressedArrayStrategy::PrintSelf(std::ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "Compressor: ";
+  if (this->Compressor)
+  {
+    os << this->Compressor->GetClassName() << "\n";
+  }
+  else
+  {
+    os << "(none)\n";
+  }
+  os << indent << "BlockSize: " << this->BlockSize << "\n";
+  os << indent << "CacheSize: " << this->CacheSize << "\n";
+  os << std::flush;
+}
+
+//-------------------------------------------------------------------------
+vtkToImplicitStrategy::Optional vtkToCompressedArrayStrategy::EstimateReduction(
+  vtkDataArray* arr)
+{
+  if (!arr)
+  {
+    vtkWarningMacro("Cannot transform nullptr to compressed array.");
+    return vtkToImplicitStrategy::Optional();
+  }
+  if (!arr->GetNumberOfValues() || !arr->GetDataTypeSize())
+  {
+    return vtkToImplicitStrategy::Optional();
+  }
+  auto compressed = this->Reduce(arr);
+  if (!compressed)
+  {
+    return vtkToImplicitStrategy::Optional();
+  }
+  this->Internals->Compressed = compressed;
+  this->Internals->CachedArray = arr;
+  this->Internals->ArrayMTimeAtCaching = arr->GetMTime();
+  const double size = static_cast<double>(arr->GetNumberOfValues()) * arr->GetDataTypeSize();
+  return vtkToImplicitStrategy::Optional(
+    static_cast<double>(compressed->GetActualMemorySize()) * 1024.0 / size);
+}
+
+//-------------------------------------------------------------------------
+vtkSmartPointer<vtkDataArray> vtkToCompressedArrayStrategy::Reduce(vtkDataArray* arr)
+{
+  vtkSmartPointer<vtkDataArray> res = nullptr;
+  if (!arr)
+  {
+    vtkWarningMacro("Cannot transform nullptr to compressed array.");
+    return res;
+  }
+  if (!arr->GetNumberOfValues())
+  {
+    return res;
+  }
+  if (this->Internals->Compressed && this->Internals->CachedArray == arr &&
+    this->Internals->ArrayMTimeAtCaching == arr->GetMTime())
+  {
+    return this->Internals->Compressed;
+  }
+  if (!this->Compressor)
+  {
+    vtkErrorMacro("No compressor set.");
+    return res;
+  }
+  ::GenerateCompressedWorklet worker;
+  switch (arr->GetDataType())
+  {
+    vtkTemplateMacro(worker(static_cast<VTK_TT*>(nullptr), arr, this->Compressor,
+      this->BlockSize, this->CacheSize, res));
+    default:
+      vtkWarningMacro("Cannot compress arrays of type " << arr->GetDataTypeAsString() << ".");
+      break;
+  }
+  return res;
+}
+
+//-------------------------------------------------------------------------
+void vtkToCompressedArrayStrategy::ClearCache()
+{
+  this->Internals->Compressed = nullptr;
+  this->Internals->CachedArray = nullptr;
+}
+VTK_ABI_NAMESPACE_END
@@ -0,0 +1,96 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+#ifndef vtkToCompressedArrayStrategy_h
+#define vtkToCompressedArrayStrategy_h
+
+#include "vtkFiltersReductionModule.h" // for export
+#include "vtkToImplicitStrategy.h"
+
+#include <memory>
+
+VTK_ABI_NAMESPACE_BEGIN
+/**
+ * @class vtkToCompressedArrayStrategy
+ *
+ * Strategy to be used in conjunction with `vtkToImplicitArrayFilter` to store arrays in compressed
+ * blocks which are decompressed on demand, see `vtkCompressedArray`. The compression is lossless:
+ * the Tolerance is not used.
+ *
+ * The blocks are compressed with a `vtkDataCompressor`, `vtkLZ4DataCompressor` by default. A
+ * compressor which decompresses faster, such as `vtkZstdDataCompressor` or LZ4, is preferable for
+ * arrays which are read often. The bytes of the values are shuffled before compression, which
+ * typically reduces the memory of smooth fields by a factor 3 to 10.
+ *
+ * The estimation compresses the array: the result is cached and returned by the following call
+ * to `Reduce` on the same unmodified array.
+ */
+class vtkDataCompressor;
+class VTKFILTERSREDUCTION_EXPORT vtkToCompressedArrayStrategy final : public vtkToImplicitStrategy
+{
+public:
+  static vtkToCompressedArrayStrategy* New();
+  vtkTypeMacro(vtkToCompressedArrayStrategy, vtkToImplicitStrategy);
+  void PrintSelf(std::ostream& os, vtkIndent indent) override;
+
+  ///@{
+  /**
+   * Get/Set the compressor of the blocks.
+   *
+   * Default value: a vtkLZ4DataCompressor
+   */
+  virtual void SetCompressor(vtkDataCompressor*);
+  vtkGetObjectMacro(Compressor, vtkDataCompressor);
+  ///@}
+
+  ///@{
+  /**
+   * Get/Set the number of values per block, rounded up to whole tuples. Larger
+   * blocks compress better but are slower to access randomly.
+   *
+   * Default value: 16384
+   */
+  vtkSetClampMacro(BlockSize, vtkIdType, 1, VTK_ID_MAX);
+  vtkGetMacro(BlockSize, vtkIdType);
+  ///@}
+
+  ///@{
+  /**
+   * Get/Set the number of decompressed blocks kept in the cache of each array.
+   *
+   * Default value: 4
+   */
+  vtkSetClampMacro(CacheSize, int, 1, VTK_INT_MAX);
+  vtkGetMacro(CacheSize, int);
+  ///@}
+
+  ///@{
+  /**
+   * Parent API implementing the strategy
+   */
+  vtkToImplicitStrategy::Optional EstimateReduction(vtkDataArray*) override;
+  vtkSmartPointer<vtkDataArray> Reduce(vtkDataArray*) override;
+  ///@}
+
+  /**
+   * Destroys the compressed array computed by the last call to `EstimateReduction`
+   */
+  void ClearCache() override;
+
+protected:
+  vtkToCompressedArrayStrategy();
+  ~vtkToCompressedArrayStrategy() override;
+
+  vtkDataCompressor* Compressor = nullptr;
+  vtkIdType BlockSize = 16384;
+  int CacheSize = 4;
+
+private:
+  vtkToCompressedArrayStrategy(const vtkToCompressedArrayStrategy&) = delete;
+  void operator=(const vtkToCompressedArrayStrategy&) = delete;
+
+  struct vtkInternals;
+  std::unique_ptr<vtkInternals> Internals;
+};
+VTK_ABI_NAMESPACE_END
+
+#endif // vtkToCompressedArrayStrategy_h
@@ -0,0 +1,53 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// .NAME Test of vtkZstdDataCompressor
+// .SECTION Description
+// Round trip a buffer through every compression level, with and without
+// the zstd worker threads.
+
+#include "vtkNew.h"
+#include "vtkZstdDataCompressor.h"
+
+#include <iostream>
+#include <vector>
+
+int TestCompressZstd(int, char*[])
+{
+  constexpr size_t size = 100024;
+  std::vector<unsigned char> buffer(size);
+  for (size_t cc = 0; cc < size; cc++)
+  {
+    buffer[cc] = static_cast<unsigned char>((cc * cc) % 251);
+  }
+
+  vtkNew<vtkZstdDataCompressor> compressor;
+  std::vector<unsigned char> cbuffer(compressor->GetMaximumCompressionSpace(size));
+  std::vector<unsigned char> ucbuffer(size);
+  for (int threads = 0; threads < 3; threads += 2)
+  {
+    compressor->SetNumberOfThreads(threads);
+    for (int level = 1; level <= 9; ++level)
+    {
+      compressor->SetCompressionLevel(level);
+      if (compressor->GetCompressionLevel() != level)
+      {
+        std::cerr << "Compression level " << level << " read back as "
+                  << compressor->GetCompressionLevel() << std::endl;
+        return 1;
+      }
+      size_t rlen = compressor->Compress(buffer.data(), size, cbuffer.data(), cbuffer.size());
+      if (rlen == 0 || rlen >= size)
+      {
+        std::cerr << "Level " << level << ": compression failed" << std::endl;
+        return 1;
+      }
+      rlen = compressor->Uncompress(cbuffer.data(), rlen, ucbuffer.data(), size);
+      if (rlen != size || ucbuffer != buffer)
+      {
+        std::cerr << "Level " << level << ": wrong uncompressed data" << std::endl;
+        return 1;
+      }
+    }
+  }
+  return 0;
+}
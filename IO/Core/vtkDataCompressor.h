@@ -88,6 +88,14 @@ public:
   virtual void SetCompressionLevel(int compressionLevel) = 0;
   virtual int GetCompressionLevel() = 0;
 
+  /**
+   * Return true if the Compress methods may be called concurrently from
+   * several threads on this instance, which lets vtkXMLWriter compress
+   * independent blocks in parallel. The default is false. Subclasses whose
+   * CompressBuffer does not modify their state should return true.
+   */
+  virtual bool SupportsConcurrentCompression() { return false; }
+
 protected:
   vtkDataCompressor();
   ~vtkDataCompressor() override;
@@ -29,6 +29,12 @@ public:
    *  Compress method.
    */
   size_t GetMaximumCompressionSpace(size_t size) override;
+
+  /**
+   * Compression only reads the acceleration level, so blocks may be
+   * compressed concurrently.
+   */
+  bool SupportsConcurrentCompression() override { return true; }
   /**
    *  Get/Set the compression level.
    */
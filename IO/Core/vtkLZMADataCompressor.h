@@ -35,6 +35,12 @@ public:
    *  Compress method.
    */
   size_t GetMaximumCompressionSpace(size_t size) override;
+
+  /**
+   * Compression only reads the compression level, so blocks may be
+   * compressed concurrently.
+   */
+  bool SupportsConcurrentCompression() override { return true; }
   /**
    *  Get/Set the compression level.
    */
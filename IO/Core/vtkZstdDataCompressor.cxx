@@ -0,0 +1,122 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkZstdDataCompressor.h"
+#include "vtkObjectFactory.h"
+
+#include <zstd.h>
+
+#include <algorithm>
+#include <memory>
+
+VTK_ABI_NAMESPACE_BEGIN
+vtkStandardNewMacro(vtkZstdDataCompressor);
+
+namespace
+{
+// zstd level used for each vtkDataCompressor level 1..9.
+constexpr int ZstdLevels[9] = { 1, 2, 3, 5, 7, 9, 12, 15, 19 };
+
+struct ContextDeleter
+{
+  void operator()(ZSTD_CCtx* context) const { ZSTD_freeCCtx(context); }
+};
+}
+
+//------------------------------------------------------------------------------
+vtkZstdDataCompressor::vtkZstdDataCompressor()
+{
+  this->ZstdLevel = 3;
+  this->NumberOfThreads = 0;
+}
+
+//------------------------------------------------------------------------------
+vtkZstdDataCompressor::~vtkZstdDataCompressor() = default;
+
+//------------------------------------------------------------------------------
+void vtkZstdDataCompressor::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+
+  os << indent << "ZstdLevel: " << this->ZstdLevel << endl;
+  os << indent << "NumberOfThreads: " << this->NumberOfThreads << endl;
+}
+
+//------------------------------------------------------------------------------
+size_t vtkZstdDataCompressor::CompressBuffer(unsigned char const* uncompressedData,
+  size_t uncompressedSize, unsigned char* compressedData, size_t compressionSpace)
+{
+  // A context per call keeps the compressor usable from several threads.
+  std::unique_ptr<ZSTD_CCtx, ContextDeleter> context(ZSTD_createCCtx());
+  if (!context)
+  {
+    vtkErrorMacro("Zstd error while creating the compression context.");
+    return 0;
+  }
+  ZSTD_CCtx_setParameter(context.get(), ZSTD_c_compressionLevel, this->ZstdLevel);
+  if (this->NumberOfThreads > 0 &&
+    ZSTD_isError(
+      ZSTD_CCtx_setParameter(context.get(), ZSTD_c_nbWorkers, this->NumberOfThreads)))
+  {
+    vtkWarningMacro("The zstd library does not support multithreading, "
+                    "compressing on the calling thread.");
+  }
+
+  size_t cs = ZSTD_compress2(
+    context.get(), compressedData, compressionSpace, uncompressedData, uncompressedSize);
+  if (ZSTD_isError(cs))
+  {
+    vtkErrorMacro("Zstd error while compressing data: " << ZSTD_getErrorName(cs));
+    return 0;
+  }
+  return cs;
+}
+
+//------------------------------------------------------------------------------
+size_t vtkZstdDataCompressor::UncompressBuffer(unsigned char const* compressedData,
+  size_t compressedSize, unsigned char* uncompressedData, size_t uncompressedSize)
+{
+  size_t us = ZSTD_decompress(uncompressedData, uncompressedSize, compressedData, compressedSize);
+  if (ZSTD_isError(us))
+  {
+    vtkErrorMacro("Zstd error while uncompressing data: " << ZSTD_getErrorName(us));
+    return 0;
+  }
+  // Make sure the output size matched that expected.
+  if (us != uncompressedSize)
+  {
+    vtkErrorMacro("Decompression produced incorrect size.\n"
+                  "Expected "
+      << uncompressedSize << " and got " << us);
+    return 0;
+  }
+  return us;
+}
+
+//------------------------------------------------------------------------------
+int vtkZstdDataCompressor::GetCompressionLevel()
+{
+  // Smallest level whose zstd level reaches the current one.
+  const int* level = std::lower_bound(ZstdLevels, ZstdLevels + 9, this->ZstdLevel);
+  const int compressionLevel = std::min(static_cast<int>(level - ZstdLevels), 8) + 1;
+  vtkDebugMacro(<< this->GetClassName() << " (" << this << "): returning CompressionLevel "
+                << compressionLevel);
+  return compressionLevel;
+}
+
+//------------------------------------------------------------------------------
+void vtkZstdDataCompressor::SetCompressionLevel(int compressionLevel)
+{
+  int min = 1;
+  int max = 9;
+  vtkDebugMacro(<< this->GetClassName() << " (" << this << "): setting CompressionLevel to "
+                << compressionLevel);
+  compressionLevel = std::min(std::max(compressionLevel, min), max);
+  this->SetZstdLevel(ZstdLevels[compressionLevel - 1]);
+}
+
+//------------------------------------------------------------------------------
+size_t vtkZstdDataCompressor::GetMaximumCompressionSpace(size_t size)
+{
+  return ZSTD_compressBound(size);
+}
+VTK_ABI_NAMESPACE_END
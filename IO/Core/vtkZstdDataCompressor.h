@@ -0,0 +1,96 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class   vtkZstdDataCompressor
+ * @brief   Data compression using Zstandard.
+ *
+ * vtkZstdDataCompressor provides a concrete vtkDataCompressor class
+ * using Zstandard (zstd) for compressing and uncompressing data. Zstandard
+ * reaches compression ratios close to LZMA at its higher levels while
+ * decompressing at a speed close to LZ4.
+ *
+ * This class is only available when VTK is built with `VTK_USE_ZSTD`, see
+ * `vtkIOCoreConfigure.h`.
+ */
+
+#ifndef vtkZstdDataCompressor_h
+#define vtkZstdDataCompressor_h
+
+#include "vtkDataCompressor.h"
+#include "vtkIOCoreModule.h" // For export macro
+
+VTK_ABI_NAMESPACE_BEGIN
+class VTKIOCORE_EXPORT vtkZstdDataCompressor : public vtkDataCompressor
+{
+public:
+  vtkTypeMacro(vtkZstdDataCompressor, vtkDataCompressor);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+  static vtkZstdDataCompressor* New();
+
+  /**
+   *  Get the maximum space that may be needed to store data of the
+   *  given uncompressed size after compression.  This is the minimum
+   *  size of the output buffer that can be passed to the four-argument
+   *  Compress method.
+   */
+  size_t GetMaximumCompressionSpace(size_t size) override;
+
+  /**
+   * Compression only reads the compression parameters, so blocks may be
+   * compressed concurrently.
+   */
+  bool SupportsConcurrentCompression() override { return true; }
+
+  /**
+   *  Get/Set the compression level.
+   */
+  // Compression level getter required by vtkDataCompressor.
+  int GetCompressionLevel() override;
+
+  // Compression level setter required by vtkDataCompressor. The levels
+  // 1..9 are spread over the zstd levels 1..19.
+  void SetCompressionLevel(int compressionLevel) override;
+
+  ///@{
+  /**
+   * Direct setting of the zstd compression level, between 1 and 22, for a
+   * finer control than SetCompressionLevel. Levels above 19 use much more
+   * memory to compress and to uncompress. Default is 3, the zstd default.
+   */
+  vtkSetClampMacro(ZstdLevel, int, 1, 22);
+  vtkGetMacro(ZstdLevel, int);
+  ///@}
+
+  ///@{
+  /**
+   * Number of threads used by zstd itself to compress each buffer. 0, the
+   * default, compresses on the calling thread. Other values only take effect
+   * when the zstd library was built with multithreading support, and are
+   * mostly useful for large buffers: vtkXMLWriter already compresses its
+   * blocks in parallel.
+   */
+  vtkSetClampMacro(NumberOfThreads, int, 0, 256);
+  vtkGetMacro(NumberOfThreads, int);
+  ///@}
+
+protected:
+  vtkZstdDataCompressor();
+  ~vtkZstdDataCompressor() override;
+
+  int ZstdLevel;
+  int NumberOfThreads;
+
+  // Compression method required by vtkDataCompressor.
+  size_t CompressBuffer(unsigned char const* uncompressedData, size_t uncompressedSize,
+    unsigned char* compressedData, size_t compressionSpace) override;
+  // Decompression method required by vtkDataCompressor.
+  size_t UncompressBuffer(unsigned char const* compressedData, size_t compressedSize,
+    unsigned char* uncompressedData, size_t uncompressedSize) override;
+
+private:
+  vtkZstdDataCompressor(const vtkZstdDataCompressor&) = delete;
+  void operator=(const vtkZstdDataCompressor&) = delete;
+};
+
+VTK_ABI_NAMESPACE_END
+#endif
@@ -0,0 +1,198 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// .NAME Test the parallel parsing of vtkSTLReader.
+// .SECTION Description
+// Read large ASCII and binary files, which are parsed by several threads, and
+// compare the triangles to the ones written. Also read a small hand written
+// ASCII file using several solids, mixed case keywords and CRLF line endings,
+// including from a stream splitting its lines and CRLF pairs between reads.
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkDataArray.h"
+#include "vtkIdList.h"
+#include "vtkMathUtilities.h"
+#include "vtkMemoryResourceStream.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSTLReader.h"
+#include "vtkSTLWriter.h"
+#include "vtkSphereSource.h"
+#include "vtkTestUtilities.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+namespace
+{
+//------------------------------------------------------------------------------
+// Memory stream returning at most MaximumRead bytes at once.
+class ShortReadStream : public vtkMemoryResourceStream
+{
+public:
+  static ShortReadStream* New();
+  vtkTypeMacro(ShortReadStream, vtkMemoryResourceStream);
+
+  std::size_t Read(void* buffer, std::size_t bytes) override
+  {
+    return this->Superclass::Read(buffer, std::min(bytes, this->MaximumRead));
+  }
+
+  std::size_t MaximumRead = 1;
+};
+vtkStandardNewMacro(ShortReadStream);
+
+//------------------------------------------------------------------------------
+// Compare the triangles read from fileName to the ones of the input: without
+// merging, triangle i uses the points 3 * i to 3 * i + 2.
+bool TestFile(const std::string& fileName, const char* name, vtkPolyData* input)
+{
+  vtkNew<vtkSTLReader> reader;
+  reader->SetFileName(fileName.c_str());
+  reader->MergingOff();
+  reader->Update();
+  vtkPolyData* output = reader->GetOutput();
+
+  const vtkIdType numberOfTriangles = input->GetNumberOfPolys();
+  if (output->GetNumberOfPolys() != numberOfTriangles ||
+    output->GetNumberOfPoints() != 3 * numberOfTriangles)
+  {
+    std::cerr << name << ": read " << output->GetNumberOfPolys() << " triangles and "
+              << output->GetNumberOfPoints() << " points instead of " << numberOfTriangles
+              << " triangles" << std::endl;
+    return false;
+  }
+
+  vtkNew<vtkIdList> inputPts;
+  vtkNew<vtkIdList> pts;
+  for (vtkIdType cellId = 0; cellId < numberOfTriangles; ++cellId)
+  {
+    output->GetPolys()->GetCellAtId(cellId, pts);
+    if (pts->GetNumberOfIds() != 3 || pts->GetId(0) != 3 * cellId ||
+      pts->GetId(1) != 3 * cellId + 1 || pts->GetId(2) != 3 * cellId + 2)
+    {
+      std::cerr << name << ": wrong connectivity for triangle " << cellId << std::endl;
+      return false;
+    }
+    input->GetPolys()->GetCellAtId(cellId, inputPts);
+    for (vtkIdType i = 0; i < 3; ++i)
+    {
+      double expected[3];
+      double point[3];
+      input->GetPoint(inputPts->GetId(i), expected);
+      output->GetPoint(pts->GetId(i), point);
+      for (int j = 0; j < 3; ++j)
+      {
+        if (!vtkMathUtilities::FuzzyCompare(point[j], expected[j], 1e-5))
+        {
+          std::cerr << name << ": wrong point " << i << " for triangle " << cellId << std::endl;
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool TestMultipleSolids()
+{
+  const std::string stl = "solid first\r\n"
+                          "  FACET normal 0 0 1\r\n"
+                          "    Outer Loop\r\n"
+                          "      VERTEX 0 0 0\r\n"
+                          "      vertex +1.5e0 0 0\r\n"
+                          "      vertex 0 1 0\r\n"
+                          "    endloop\r\n"
+                          "  endfacet\r\n"
+                          "\r\n"
+                          "endsolid first\r\n"
+                          "solid second\r\n"
+                          "  facet normal 0 0 1\r\n"
+                          "    outer loop\r\n"
+                          "      vertex 0 0 1\r\n"
+                          "      vertex 1 0 1\r\n"
+                          "      vertex 0 1 1\r\n"
+                          "    endloop\r\n"
+                          "  endfacet\r\n"
+                          "endsolid second";
+
+  // The lines, and their \r\n pairs, are split between reads of the stream
+  // when it returns a few bytes at once.
+  for (std::size_t maximumRead : { stl.size(), std::size_t(1), std::size_t(5), std::size_t(7) })
+  {
+    vtkNew<ShortReadStream> stream;
+    stream->SetBuffer(stl);
+    stream->MaximumRead = maximumRead;
+    vtkNew<vtkSTLReader> reader;
+    reader->SetStream(stream);
+    reader->MergingOff();
+    reader->ScalarTagsOn();
+    reader->Update();
+
+    vtkPolyData* output = reader->GetOutput();
+    vtkDataArray* solids = output->GetCellData()->GetScalars("STLSolidLabeling");
+    if (output->GetNumberOfPolys() != 2 || !solids || solids->GetComponent(0, 0) != 0 ||
+      solids->GetComponent(1, 0) != 1)
+    {
+      std::cerr << "Multiple solids: wrong triangles or solid labels reading " << maximumRead
+                << " bytes at once" << std::endl;
+      return false;
+    }
+    if (std::string(reader->GetHeader()) != "first\nsecond")
+    {
+      std::cerr << "Multiple solids: wrong header " << reader->GetHeader() << " reading "
+                << maximumRead << " bytes at once" << std::endl;
+      return false;
+    }
+    double point[3];
+    output->GetPoint(1, point);
+    if (point[0] != 1.5)
+    {
+      std::cerr << "Multiple solids: wrong point " << point[0] << " reading " << maximumRead
+                << " bytes at once" << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+//------------------------------------------------------------------------------
+int TestSTLReaderParallel(int argc, char* argv[])
+{
+  char* tempDir =
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  if (!tempDir)
+  {
+    std::cerr << "Could not determine temporary directory.\n";
+    return EXIT_FAILURE;
+  }
+  const std::string testDirectory = tempDir;
+  delete[] tempDir;
+
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(400);
+  sphere->SetPhiResolution(400);
+  sphere->Update();
+
+  vtkNew<vtkSTLWriter> writer;
+  writer->SetInputConnection(sphere->GetOutputPort());
+  const std::string asciiFileName = testDirectory + "/TestSTLReaderParallelASCII.stl";
+  writer->SetFileName(asciiFileName.c_str());
+  writer->SetFileTypeToASCII();
+  writer->Write();
+  const std::string binaryFileName = testDirectory + "/TestSTLReaderParallelBinary.stl";
+  writer->SetFileName(binaryFileName.c_str());
+  writer->SetFileTypeToBinary();
+  writer->Write();
+
+  bool success = TestFile(asciiFileName, "ASCII", sphere->GetOutput());
+  success &= TestFile(binaryFileName, "Binary", sphere->GetOutput());
+  success &= TestMultipleSolids();
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
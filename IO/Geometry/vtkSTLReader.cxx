@@ -8,6 +8,7 @@
 #include "vtkErrorCode.h"
 #include "vtkFileResourceStream.h"
 #include "vtkFloatArray.h"
+#include "vtkIdTypeArray.h"
 #include "vtkIncrementalPointLocator.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
@@ -17,16 +18,21 @@
 #include "vtkPolyData.h"
 #include "vtkResourceParser.h"
 #include "vtkResourceStream.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStringScanner.h"
 #include "vtkUnsignedCharArray.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cctype>
 #include <cmath>
 #include <cstdlib>
+#include <cstring>
+#include <memory>
 #include <string>
+#include <vector>
 #include <vtksys/SystemTools.hxx>
 
 VTK_ABI_NAMESPACE_BEGIN
@@ -38,6 +44,37 @@ constexpr int STL_HEADER_SIZE = 80;
 
 // twelve 32-bit-floating point numbers + 2 byte for attribute byte count = 50 bytes.
 constexpr vtkTypeInt64 STL_TRI_SIZE = 12 * sizeof(float) + sizeof(uint16_t);
+
+// Number of facets of a binary file read and decoded at once.
+constexpr vtkIdType STL_BINARY_CHUNK_FACETS = 1 << 20;
+
+// Number of bytes of an ASCII file read and tokenized at once.
+constexpr std::size_t STL_ASCII_CHUNK_SIZE = 64 << 20;
+
+//------------------------------------------------------------------------------
+// STL triangles never share points: triangle i uses points 3i, 3i + 1 and 3i + 2.
+void BuildTriangles(vtkCellArray* polys, vtkIdType numTriangles)
+{
+  vtkNew<vtkIdTypeArray> offsets;
+  offsets->SetNumberOfValues(numTriangles + 1);
+  vtkNew<vtkIdTypeArray> connectivity;
+  connectivity->SetNumberOfValues(3 * numTriangles);
+  vtkSMPTools::For(0, numTriangles + 1,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType triangle = begin; triangle < end; ++triangle)
+      {
+        offsets->SetValue(triangle, 3 * triangle);
+        if (triangle < numTriangles)
+        {
+          connectivity->SetValue(3 * triangle, 3 * triangle);
+          connectivity->SetValue(3 * triangle + 1, 3 * triangle + 1);
+          connectivity->SetValue(3 * triangle + 2, 3 * triangle + 2);
+        }
+      }
+    });
+  polys->SetData(offsets, connectivity);
+}
 }
 
 vtkStandardNewMacro(vtkSTLReader);
@@ -130,9 +167,7 @@ int vtkSTLReader::RequestData(vtkInformation* vtkNotUsed(request),
       newScalars->Allocate(5000);
     }
 
-    vtkNew<vtkResourceParser> parser;
-    parser->SetStream(stream);
-    if (!this->ReadASCIISTL(parser, newPts.Get(), newPolys.Get(), newScalars))
+    if (!this->ReadASCIISTL(stream, newPts.Get(), newPolys.Get(), newScalars))
     {
       // In relaxed mode, fallback to try reading as binary (because we have seen malformed STL
       // files in the wild that have the 80 byte header but start with `solid`).
@@ -260,13 +295,6 @@ bool vtkSTLReader::ReadBinaryTrisFile(vtkResourceStream* stream, vtkTypeInt64& n
 bool vtkSTLReader::ReadBinarySTL(
   vtkResourceStream* stream, vtkPoints* newPts, vtkCellArray* newPolys)
 {
-  struct facet_t_t
-  {
-    float n[3], v1[3], v2[3], v3[3];
-    uint16_t attrByteCount;
-  };
-  using facet_t = struct facet_t_t;
-
   vtkDebugMacro(<< "Reading BINARY STL file");
 
   //  File is read to obtain raw information as well as bounding box
@@ -318,64 +346,74 @@ bool vtkSTLReader::ReadBinarySTL(
     return false;
   }
 
-  // now allocate the memory we need for the triangles.
-  // note we ignore the triangle count field and read until end of file.
-  newPts->Allocate(numTrisFile * 3);
-  newPolys->AllocateEstimate(numTrisFile, 3);
+  // Facets are read by large chunks, and decoded in parallel straight into the points.
+  // Note we ignore the triangle count field and read until end of file.
+  const vtkIdType numTris = static_cast<vtkIdType>(numTrisFile);
+  vtkNew<vtkFloatArray> coords;
+  coords->SetNumberOfComponents(3);
+  coords->SetNumberOfTuples(3 * numTris);
+  float* outCoords = coords->GetPointer(0);
 
-  facet_t facet;
-  for (size_t i = 0; stream->Read(&facet, ::STL_TRI_SIZE) > 0; ++i)
+  std::vector<unsigned char> buffer;
+  for (vtkIdType first = 0; first < numTris; first += ::STL_BINARY_CHUNK_FACETS)
   {
-    vtkByteSwap::Swap4LE(facet.n);
-    vtkByteSwap::Swap4LE(facet.n + 1);
-    vtkByteSwap::Swap4LE(facet.n + 2);
-    if (!std::isfinite(facet.n[0]) || !std::isfinite(facet.n[1]) || !std::isfinite(facet.n[2]))
+    const vtkIdType numFacets = std::min(::STL_BINARY_CHUNK_FACETS, numTris - first);
+    buffer.resize(static_cast<std::size_t>(numFacets * ::STL_TRI_SIZE));
+    if (stream->Read(buffer.data(), buffer.size()) != buffer.size())
     {
-      vtkErrorMacro("Normal vector non-finite.");
+      vtkErrorMacro("STLReader error reading file. Premature EOF while reading triangles.");
       return false;
     }
 
-    vtkByteSwap::Swap4LE(facet.v1);
-    vtkByteSwap::Swap4LE(facet.v1 + 1);
-    vtkByteSwap::Swap4LE(facet.v1 + 2);
-    if (!std::isfinite(facet.v1[0]) || !std::isfinite(facet.v1[1]) || !std::isfinite(facet.v1[2]))
-    {
-      vtkErrorMacro("vertex 1 non-finite.");
-      return false;
-    }
-
-    vtkByteSwap::Swap4LE(facet.v2);
-    vtkByteSwap::Swap4LE(facet.v2 + 1);
-    vtkByteSwap::Swap4LE(facet.v2 + 2);
-    if (!std::isfinite(facet.v2[0]) || !std::isfinite(facet.v2[1]) || !std::isfinite(facet.v2[2]))
-    {
-      vtkErrorMacro("vertex 2 non-finite.");
-      return false;
-    }
+    // Index of the first non-finite value of the chunk, in the order of the file.
+    const vtkIdType numValues = 12 * numFacets;
+    std::atomic<vtkIdType> firstInvalid(numValues);
+    vtkSMPTools::For(0, numFacets,
+      [&](vtkIdType begin, vtkIdType end)
+      {
+        for (vtkIdType facet = begin; facet < end; ++facet)
+        {
+          // Normal followed by the three vertices, facets are not aligned in the file.
+          float values[12];
+          std::memcpy(values, buffer.data() + facet * ::STL_TRI_SIZE, sizeof(values));
+          vtkByteSwap::Swap4LERange(values, 12);
+          for (int i = 0; i < 12; ++i)
+          {
+            if (!std::isfinite(values[i]))
+            {
+              const vtkIdType index = 12 * facet + i;
+              vtkIdType current = firstInvalid.load();
+              while (index < current && !firstInvalid.compare_exchange_weak(current, index))
+              {
+              }
+              break;
+            }
+          }
+          std::copy(values + 3, values + 12, outCoords + 9 * (first + facet));
+        }
+      });
 
-    vtkByteSwap::Swap4LE(facet.v3);
-    vtkByteSwap::Swap4LE(facet.v3 + 1);
-    vtkByteSwap::Swap4LE(facet.v3 + 2);
-    if (!std::isfinite(facet.v3[0]) || !std::isfinite(facet.v3[1]) || !std::isfinite(facet.v3[2]))
+    if (firstInvalid < numValues)
     {
-      vtkErrorMacro("vertex 3 non-finite.");
+      const int vertex = static_cast<int>(firstInvalid % 12) / 3;
+      if (vertex == 0)
+      {
+        vtkErrorMacro("Normal vector non-finite.");
+      }
+      else
+      {
+        vtkErrorMacro("vertex " << vertex << " non-finite.");
+      }
       return false;
     }
 
-    vtkIdType pts[3];
-    pts[0] = newPts->InsertNextPoint(facet.v1);
-    pts[1] = newPts->InsertNextPoint(facet.v2);
-    pts[2] = newPts->InsertNextPoint(facet.v3);
-
-    newPolys->InsertNextCell(3, pts);
-
-    if ((i % 100000) == 0 && i != 0)
-    {
-      vtkDebugMacro(<< "triangle# " << i);
-      this->UpdateProgress(static_cast<double>(i) / numTrisFile);
-    }
+    vtkDebugMacro(<< "triangle# " << first + numFacets);
+    this->UpdateProgress(static_cast<double>(first + numFacets) / numTris);
   }
 
+  newPts->SetData(coords);
+  ::BuildTriangles(newPolys, numTris);
+
   return true;
 }
 
@@ -394,25 +432,179 @@ inline std::string stlParseExpected(const std::string& expected, const std::stri
   return "Parse error. Expecting '" + expected + "' found '" + found + "'";
 }
 
-// Get three space-delimited floats from string.
-bool stlReadVertex(char* buf, float vertCoord[3])
+// Get three space-delimited floats from [first, last).
+bool stlReadVertex(const char* first, const char* last, float vertCoord[3])
 {
-  std::string_view buffer = buf;
-
   for (int i = 0; i < 3; ++i)
   {
-    auto result = vtk::scan_value<float>(buffer);
-    if (!result)
+    while (first < last && isspace(static_cast<unsigned char>(*first)))
+    {
+      ++first;
+    }
+    if (first < last && *first == '+')
+    {
+      ++first;
+    }
+    auto result = vtk::from_chars(first, last, vertCoord[i]);
+    if (result.ec != std::errc())
     {
       return false;
     }
-    vertCoord[i] = result->value();
-    buffer = result->range().data();
+    first = result.ptr;
   }
 
   return true;
 }
 
+inline bool stlIsEndOfLine(char c)
+{
+  return c == '\n' || c == '\r';
+}
+
+// First token of a line of an ASCII file.
+enum class StlAsciiKeyword : unsigned char
+{
+  Empty,
+  Solid,
+  Color,
+  Facet,
+  Outer,
+  Vertex,
+  EndLoop,
+  EndFacet,
+  EndSolid,
+  Other
+};
+
+// Line of an ASCII file, tokenized in parallel. Offsets are relative to the parsed chunk.
+struct StlAsciiLine
+{
+  StlAsciiKeyword Keyword;
+  bool ValidVertex;
+  float Vertex[3];
+  std::size_t CommandBegin;
+  std::size_t CommandEnd;
+  std::size_t ArgumentBegin;
+  std::size_t LineEnd;
+};
+
+// Case insensitive comparison of a token with a lower case keyword.
+bool stlIsKeyword(const char* token, std::size_t size, const char* keyword)
+{
+  std::size_t i = 0;
+  for (; i < size && keyword[i]; ++i)
+  {
+    if (tolower(static_cast<unsigned char>(token[i])) != keyword[i])
+    {
+      return false;
+    }
+  }
+  return i == size && !keyword[i];
+}
+
+StlAsciiKeyword stlGetKeyword(const char* token, std::size_t size)
+{
+  struct
+  {
+    const char* Name;
+    StlAsciiKeyword Keyword;
+  } constexpr keywords[] = { { "vertex", StlAsciiKeyword::Vertex },
+    { "facet", StlAsciiKeyword::Facet }, { "outer", StlAsciiKeyword::Outer },
+    { "endloop", StlAsciiKeyword::EndLoop }, { "endfacet", StlAsciiKeyword::EndFacet },
+    { "solid", StlAsciiKeyword::Solid }, { "endsolid", StlAsciiKeyword::EndSolid },
+    { "color", StlAsciiKeyword::Color } };
+
+  if (size == 0)
+  {
+    return StlAsciiKeyword::Empty;
+  }
+  for (const auto& keyword : keywords)
+  {
+    if (stlIsKeyword(token, size, keyword.Name))
+    {
+      return keyword.Keyword;
+    }
+  }
+  return StlAsciiKeyword::Other;
+}
+
+// Tokenize the lines of chunk[begin, end), which starts at the beginning of a line.
+void stlTokenizeLines(
+  const char* chunk, std::size_t begin, std::size_t end, std::vector<StlAsciiLine>& lines)
+{
+  std::size_t pos = begin;
+  while (pos < end)
+  {
+    StlAsciiLine line{};
+    line.LineEnd = std::find_if(chunk + pos, chunk + end, stlIsEndOfLine) - chunk;
+
+    // Cue to the first non-space, then separate the first token from its arguments.
+    while (pos < line.LineEnd && isspace(static_cast<unsigned char>(chunk[pos])))
+    {
+      ++pos;
+    }
+    line.CommandBegin = pos;
+    while (pos < line.LineEnd && !isspace(static_cast<unsigned char>(chunk[pos])))
+    {
+      ++pos;
+    }
+    line.CommandEnd = pos;
+    while (pos < line.LineEnd && isspace(static_cast<unsigned char>(chunk[pos])))
+    {
+      ++pos;
+    }
+    line.ArgumentBegin = pos;
+
+    line.Keyword = stlGetKeyword(chunk + line.CommandBegin, line.CommandEnd - line.CommandBegin);
+    if (line.Keyword == StlAsciiKeyword::Vertex)
+    {
+      line.ValidVertex =
+        stlReadVertex(chunk + line.ArgumentBegin, chunk + line.LineEnd, line.Vertex);
+    }
+    lines.push_back(line);
+
+    // Skip the end of line, \r\n being a single one.
+    pos = line.LineEnd + 1;
+    if (pos < end && chunk[pos - 1] == '\r' && chunk[pos] == '\n')
+    {
+      ++pos;
+    }
+  }
+}
+
+// Tokenize the lines of chunk[0, size) in parallel, one vector of lines per range.
+void stlTokenizeChunk(
+  const char* chunk, std::size_t size, std::vector<std::vector<StlAsciiLine>>& lines)
+{
+  // Split the chunk in ranges starting at the beginning of a line.
+  const std::size_t numRanges = lines.size();
+  std::vector<std::size_t> bounds(numRanges + 1, size);
+  bounds[0] = 0;
+  for (std::size_t range = 1; range < numRanges; ++range)
+  {
+    std::size_t pos = std::max(bounds[range - 1], range * size / numRanges);
+    while (pos > 0 && pos < size && !stlIsEndOfLine(chunk[pos - 1]))
+    {
+      ++pos;
+    }
+    if (pos > 0 && pos < size && chunk[pos - 1] == '\r' && chunk[pos] == '\n')
+    {
+      ++pos;
+    }
+    bounds[range] = pos;
+  }
+
+  vtkSMPTools::For(0, static_cast<vtkIdType>(numRanges), 1,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType range = begin; range < end; ++range)
+      {
+        lines[range].clear();
+        stlTokenizeLines(chunk, bounds[range], bounds[range + 1], lines[range]);
+      }
+    });
+}
+
 } // end of anonymous namespace
 
 // https://en.wikipedia.org/wiki/STL_%28file_format%29#ASCII_STL
@@ -440,7 +632,7 @@ bool stlReadVertex(char* buf, float vertCoord[3])
 // endsolid [name]
 
 bool vtkSTLReader::ReadASCIISTL(
-  vtkResourceParser* parser, vtkPoints* newPts, vtkCellArray* newPolys, vtkFloatArray* scalars)
+  vtkResourceStream* stream, vtkPoints* newPts, vtkCellArray* newPolys, vtkFloatArray* scalars)
 {
   vtkDebugMacro(<< "Reading ASCII STL file");
 
@@ -448,10 +640,8 @@ bool vtkSTLReader::ReadASCIISTL(
   this->SetBinaryHeader(nullptr);
   std::string header;
 
-  std::string line;   // line buffer
-  float vertCoord[3]; // scratch space when parsing "vertex %f %f %f"
-  vtkIdType pts[3];   // point ids for building triangles
   int vertOff = 0;
+  vtkIdType numTris = 0;
 
   int solidId = -1;
   size_t lineNum = 0;
@@ -466,99 +656,30 @@ bool vtkSTLReader::ReadASCIISTL(
     scanEndFacet,
     scanEndSolid
   };
+  StlAsciiScanState state = scanSolid;
 
   std::string errorMessage;
 
-  for (StlAsciiScanState state = scanSolid; errorMessage.empty(); /*nil*/)
+  // Handle a tokenized line, following the grammar of ASCII STL files.
+  const auto scanLine = [&](const char* chunk, const StlAsciiLine& line)
   {
-    vtkParseResult res = parser->ReadLine(line);
-    char* cmd = line.data();
-    if (res == vtkParseResult::EndOfStream)
-    {
-      // If scanning for the next "solid" this is a valid way to exit,
-      // but is an error if scanning for the initial "solid" or any other token
-
-      switch (state)
-      {
-        case scanSolid:
-        {
-          // Emit error if EOF encountered without having read anything
-          if (solidId < 0)
-            errorMessage = stlParseEof("solid");
-          break;
-        }
-        case scanFacet:
-        {
-          errorMessage = stlParseEof("facet");
-          break;
-        }
-        case scanLoop:
-        {
-          errorMessage = stlParseEof("outer loop");
-          break;
-        }
-        case scanVerts:
-        {
-          errorMessage = stlParseEof("vertex");
-          break;
-        }
-        case scanEndLoop:
-        {
-          errorMessage = stlParseEof("endloop");
-          break;
-        }
-        case scanEndFacet:
-        {
-          errorMessage = stlParseEof("endfacet");
-          break;
-        }
-        case scanEndSolid:
-        {
-          errorMessage = stlParseEof("endsolid");
-          break;
-        }
-      }
-
-      // Terminate the parsing loop
-      break;
-    }
-
-    // Cue to the first non-space.
-    while (isspace(*cmd))
-    {
-      ++cmd;
-    }
-
     // An empty line - try again
-    if (!*cmd)
+    if (line.Keyword == StlAsciiKeyword::Empty)
     {
       // Increment line-number, but not while still in the header
       if (lineNum)
         ++lineNum;
-      continue;
+      return;
     }
 
-    // Ensure consistent case on the first token and separate from
-    // subsequent arguments
-
-    char* arg = cmd;
-    while (*arg && !isspace(*arg))
-    {
-      *arg = tolower(*arg);
-      ++arg;
-    }
-
-    // Terminate first token (cmd)
-    if (*arg)
+    // Lower case first token, only needed for error messages
+    const auto cmd = [&]()
     {
-      *arg = '\0';
-      ++arg;
-
-      while (isspace(*arg))
-      {
-        ++arg;
-      }
-    }
+      std::string token(chunk + line.CommandBegin, chunk + line.CommandEnd);
+      std::transform(token.begin(), token.end(), token.begin(),
+        [](unsigned char c) { return static_cast<char>(tolower(c)); });
+      return token;
+    };
 
     ++lineNum;
 
@@ -567,7 +688,7 @@ bool vtkSTLReader::ReadASCIISTL(
     {
       case scanSolid:
       {
-        if (!strcmp(cmd, "solid"))
+        if (line.Keyword == StlAsciiKeyword::Solid)
         {
           ++solidId;
           state = scanFacet; // Next state
@@ -575,64 +696,56 @@ bool vtkSTLReader::ReadASCIISTL(
           {
             header += "\n";
           }
-          if (*arg)
-          {
-            header += arg;
-            // strip end-of-line character from the end
-            while (!header.empty() && (header.back() == '\r' || header.back() == '\n'))
-            {
-              header.pop_back();
-            }
-          }
+          header.append(chunk + line.ArgumentBegin, chunk + line.LineEnd);
         }
         else
         {
-          errorMessage = stlParseExpected("solid", cmd);
+          errorMessage = stlParseExpected("solid", cmd());
         }
         break;
       }
       case scanFacet:
       {
-        if (!strcmp(cmd, "color"))
+        if (line.Keyword == StlAsciiKeyword::Color)
         {
           // Optional 'color' entry (after solid) - continue looking for 'facet'
-          continue;
+          break;
         }
 
-        if (!strcmp(cmd, "facet"))
+        if (line.Keyword == StlAsciiKeyword::Facet)
         {
           state = scanLoop; // Next state
         }
-        else if (!strcmp(cmd, "endsolid"))
+        else if (line.Keyword == StlAsciiKeyword::EndSolid)
         {
           // Finished with 'endsolid' - find next solid
           state = scanSolid;
         }
         else
         {
-          errorMessage = stlParseExpected("facet", cmd);
+          errorMessage = stlParseExpected("facet", cmd());
         }
         break;
       }
       case scanLoop:
       {
-        if (!strcmp(cmd, "outer")) // More pedantic => && !strcmp(arg, "loop")
+        if (line.Keyword == StlAsciiKeyword::Outer) // More pedantic => && arg == "loop"
         {
           state = scanVerts; // Next state
         }
         else
         {
-          errorMessage = stlParseExpected("outer loop", cmd);
+          errorMessage = stlParseExpected("outer loop", cmd());
         }
         break;
       }
       case scanVerts:
       {
-        if (!strcmp(cmd, "vertex"))
+        if (line.Keyword == StlAsciiKeyword::Vertex)
         {
-          if (stlReadVertex(arg, vertCoord))
+          if (line.ValidVertex)
           {
-            pts[vertOff] = newPts->InsertNextPoint(vertCoord);
+            newPts->InsertNextPoint(line.Vertex);
             ++vertOff; // Next vertex
 
             if (vertOff >= 3)
@@ -642,16 +755,11 @@ bool vtkSTLReader::ReadASCIISTL(
               state = scanEndLoop; // Next state
 
               // Save as cell
-              newPolys->InsertNextCell(3, pts);
+              ++numTris;
               if (scalars)
               {
                 scalars->InsertNextValue(solidId);
               }
-
-              if ((newPolys->GetNumberOfCells() % 5000) == 0)
-              {
-                this->UpdateProgress((newPolys->GetNumberOfCells() % 50000) / 50000.0);
-              }
             }
           }
           else
@@ -661,49 +769,180 @@ bool vtkSTLReader::ReadASCIISTL(
         }
         else
         {
-          errorMessage = stlParseExpected("vertex", cmd);
+          errorMessage = stlParseExpected("vertex", cmd());
         }
         break;
       }
       case scanEndLoop:
       {
-        if (!strcmp(cmd, "endloop"))
+        if (line.Keyword == StlAsciiKeyword::EndLoop)
         {
           state = scanEndFacet; // Next state
         }
         else
         {
-          errorMessage = stlParseExpected("endloop", cmd);
+          errorMessage = stlParseExpected("endloop", cmd());
         }
         break;
       }
       case scanEndFacet:
       {
-        if (!strcmp(cmd, "endfacet"))
+        if (line.Keyword == StlAsciiKeyword::EndFacet)
         {
           state = scanFacet; // Next facet, or endsolid
         }
         else
         {
-          errorMessage = stlParseExpected("endfacet", cmd);
+          errorMessage = stlParseExpected("endfacet", cmd());
         }
         break;
       }
       case scanEndSolid:
       {
-        if (!strcmp(cmd, "endsolid"))
+        if (line.Keyword == StlAsciiKeyword::EndSolid)
         {
           state = scanSolid; // Start over again
         }
         else
         {
-          errorMessage = stlParseExpected("endsolid", cmd);
+          errorMessage = stlParseExpected("endsolid", cmd());
         }
         break;
       }
     }
+  };
+
+  // Size of the stream, for progress only
+  const vtkTypeInt64 streamBegin = stream->Tell();
+  const vtkTypeInt64 streamSize =
+    stream->Seek(0, vtkResourceStream::SeekDirection::End) - streamBegin;
+  stream->Seek(streamBegin, vtkResourceStream::SeekDirection::Begin);
+
+  // The stream is read by chunks of complete lines. The lines of a chunk are tokenized and their
+  // vertices are parsed in parallel, then the grammar is checked on the tokens in order.
+  // The buffer is not initialized, and not larger than the rest of the stream.
+  std::unique_ptr<char[]> chunk;
+  std::size_t chunkCapacity = 0;
+  std::size_t chunkSize = 0; // Read bytes in chunk, an incomplete line may be at the end
+  vtkTypeInt64 parsed = 0;
+  std::vector<std::vector<StlAsciiLine>> lines(
+    4 * static_cast<std::size_t>(vtkSMPTools::GetEstimatedNumberOfThreads()));
+  for (bool endOfStream = false; !endOfStream && errorMessage.empty(); /*nil*/)
+  {
+    std::size_t readSize = ::STL_ASCII_CHUNK_SIZE;
+    if (streamSize > 0)
+    {
+      // Keep at least one byte to detect the end of the stream.
+      const vtkTypeInt64 remaining = streamSize - parsed - static_cast<vtkTypeInt64>(chunkSize);
+      readSize = static_cast<std::size_t>(
+        std::max<vtkTypeInt64>(std::min<vtkTypeInt64>(remaining, readSize), 1));
+    }
+    if (chunkSize + readSize > chunkCapacity)
+    {
+      chunkCapacity = chunkSize + readSize;
+      std::unique_ptr<char[]> larger(new char[chunkCapacity]);
+      std::copy(chunk.get(), chunk.get() + chunkSize, larger.get());
+      chunk = std::move(larger);
+    }
+    const std::size_t read = stream->Read(chunk.get() + chunkSize, readSize);
+    endOfStream = read == 0;
+    chunkSize += read;
+
+    // Only parse complete lines, except for the last line of the stream. A line ending with \r
+    // at the end of the chunk may be followed by \n in the next one: it is kept for the next
+    // chunk, so that the \r\n pair is not read as two ends of line.
+    std::size_t parseSize = chunkSize;
+    if (!endOfStream)
+    {
+      std::size_t searchSize = chunkSize;
+      if (searchSize > 0 && chunk[searchSize - 1] == '\r')
+      {
+        --searchSize;
+      }
+      const auto rend = std::make_reverse_iterator(chunk.get());
+      parseSize = static_cast<std::size_t>(
+        rend - std::find_if(std::make_reverse_iterator(chunk.get() + searchSize), rend,
+                 stlIsEndOfLine));
+      if (parseSize == 0)
+      {
+        continue; // A line longer than a chunk, read more of it
+      }
+    }
+
+    ::stlTokenizeChunk(chunk.get(), parseSize, lines);
+    for (const auto& rangeLines : lines)
+    {
+      for (const auto& line : rangeLines)
+      {
+        scanLine(chunk.get(), line);
+        if (!errorMessage.empty())
+        {
+          break;
+        }
+      }
+      if (!errorMessage.empty())
+      {
+        break;
+      }
+    }
+
+    // Keep the incomplete line for the next chunk.
+    std::copy(chunk.get() + parseSize, chunk.get() + chunkSize, chunk.get());
+    chunkSize -= parseSize;
+    parsed += parseSize;
+    if (streamSize > 0)
+    {
+      this->UpdateProgress(static_cast<double>(parsed) / streamSize);
+    }
+  }
+
+  // If scanning for the next "solid" the end of the stream is a valid way to exit,
+  // but is an error if scanning for the initial "solid" or any other token
+  if (errorMessage.empty())
+  {
+    switch (state)
+    {
+      case scanSolid:
+      {
+        // Emit error if EOF encountered without having read anything
+        if (solidId < 0)
+          errorMessage = stlParseEof("solid");
+        break;
+      }
+      case scanFacet:
+      {
+        errorMessage = stlParseEof("facet");
+        break;
+      }
+      case scanLoop:
+      {
+        errorMessage = stlParseEof("outer loop");
+        break;
+      }
+      case scanVerts:
+      {
+        errorMessage = stlParseEof("vertex");
+        break;
+      }
+      case scanEndLoop:
+      {
+        errorMessage = stlParseEof("endloop");
+        break;
+      }
+      case scanEndFacet:
+      {
+        errorMessage = stlParseEof("endfacet");
+        break;
+      }
+      case scanEndSolid:
+      {
+        errorMessage = stlParseEof("endsolid");
+        break;
+      }
+    }
   }
 
+  ::BuildTriangles(newPolys, numTris);
   this->SetHeader(header.c_str());
 
   if (!errorMessage.empty())
@@ -9,6 +9,9 @@
  * vtkSTLReader. The object automatically detects whether the file is
  * ASCII or binary. This reader supports reading streams.
  *
+ * Large files are read by chunks. The facets of binary files are decoded,
+ * and the lines of ASCII files are tokenized, in parallel with vtkSMPTools.
+ *
  * .stl files are quite inefficient since they duplicate vertex
  * definitions. By setting the Merging boolean you can control whether the
  * point data is merged after reading. Merging is performed by default,
@@ -31,7 +34,6 @@ class vtkCellArray;
 class vtkFloatArray;
 class vtkIncrementalPointLocator;
 class vtkPoints;
-class vtkResourceParser;
 class vtkResourceStream;
 
 class VTKIOGEOMETRY_EXPORT vtkSTLReader : public vtkAbstractPolyDataReader
@@ -153,7 +155,7 @@ private:
 
   bool ReadBinarySTL(vtkResourceStream* stream, vtkPoints*, vtkCellArray*);
   bool ReadASCIISTL(
-    vtkResourceParser* parser, vtkPoints*, vtkCellArray*, vtkFloatArray* scalars = nullptr);
+    vtkResourceStream* stream, vtkPoints*, vtkCellArray*, vtkFloatArray* scalars = nullptr);
 
   static bool ReadBinaryHeader(vtkResourceStream* stream, vtkUnsignedCharArray* header);
   static bool ReadBinaryTrisField(vtkResourceStream* stream, uint32_t& numTrisField);
@@ -236,6 +236,9 @@ void vtkHDFWriter::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Overwrite: " << (this->Overwrite ? "yes" : "no") << "\n";
   os << indent << "WriteAllTimeSteps: " << (this->WriteAllTimeSteps ? "yes" : "no") << "\n";
   os << indent << "ChunkSize: " << this->ChunkSize << "\n";
+  os << indent << "CompressionLevel: " << this->CompressionLevel << "\n";
+  os << indent << "CompressionFilter: " << (this->CompressionFilter == ZSTD ? "ZSTD" : "DEFLATE")
+     << "\n";
 }
 
 //------------------------------------------------------------------------------
@@ -279,6 +282,7 @@ void vtkHDFWriter::WriteData()
     writer->SetInputData(input);
     writer->SetFileName(subFilePath.c_str());
     writer->SetCompressionLevel(this->CompressionLevel);
+    writer->SetCompressionFilter(this->CompressionFilter);
     writer->SetChunkSize(this->ChunkSize);
     writer->SetUseExternalComposite(this->UseExternalComposite);
     writer->SetUseExternalPartitions(this->UseExternalPartitions);
@@ -506,6 +510,7 @@ bool vtkHDFWriter::WriteDatasetToFile(hid_t group, vtkPartitionedDataSet* input)
       writer->SetInputData(input->GetPartition(partIndex));
       writer->SetFileName(subFilePath.c_str());
       writer->SetCompressionLevel(this->CompressionLevel);
+      writer->SetCompressionFilter(this->CompressionFilter);
       writer->SetChunkSize(this->ChunkSize);
       writer->SetUseExternalComposite(this->UseExternalComposite);
       writer->SetUseExternalPartitions(this->UseExternalPartitions);
@@ -1400,6 +1405,7 @@ bool vtkHDFWriter::AppendExternalBlock(vtkDataObject* block, const std::string&
   writer->SetInputData(block);
   writer->SetFileName(subfileName.c_str());
   writer->SetCompressionLevel(this->CompressionLevel);
+  writer->SetCompressionFilter(this->CompressionFilter);
   writer->SetChunkSize(this->ChunkSize);
   writer->SetUseExternalComposite(this->UseExternalComposite);
   writer->SetUseExternalPartitions(this->UseExternalPartitions);
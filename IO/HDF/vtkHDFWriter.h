@@ -137,6 +137,31 @@ public:
   vtkGetMacro(CompressionLevel, int);
   ///@}
 
+  /**
+   * HDF5 filters that can compress the data.
+   */
+  enum CompressionFilterType
+  {
+    DEFLATE,
+    ZSTD
+  };
+
+  ///@{
+  /**
+   * Get/set the hdf5 filter used to compress the data when CompressionLevel is not 0.
+   * DEFLATE is built in hdf5. ZSTD uses the registered zstd filter (id 32015), which must be
+   * available as an hdf5 plugin (see HDF5_PLUGIN_PATH) to write and to read the file. The
+   * CompressionLevel is forwarded to the zstd filter. When the plugin cannot be loaded, the writer
+   * warns and falls back to DEFLATE.
+   *
+   * Default to DEFLATE.
+   */
+  vtkSetClampMacro(CompressionFilter, int, DEFLATE, ZSTD);
+  vtkGetMacro(CompressionFilter, int);
+  void SetCompressionFilterToDeflate() { this->SetCompressionFilter(DEFLATE); }
+  void SetCompressionFilterToZstd() { this->SetCompressionFilter(ZSTD); }
+  ///@}
+
   ///@{
   /**
    * When set, write composite leaf blocks in different files,
@@ -403,6 +428,7 @@ private:
   bool UseExternalPartitions = false;
   int ChunkSize = 25000;
   int CompressionLevel = 0;
+  int CompressionFilter = DEFLATE;
 
   // Temporal-related private variables
   std::vector<double> timeSteps;
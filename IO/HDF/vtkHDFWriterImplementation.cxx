@@ -58,6 +58,12 @@ bool ContainsAny(const std::string& path, const std::vector<std::string>& subpat
 };
 }
 
+namespace
+{
+// Identifier of the zstd filter in the hdf5 registry of third-party filters
+constexpr H5Z_filter_t ZSTD_FILTER_ID = 32015;
+}
+
 //------------------------------------------------------------------------------
 bool vtkHDFWriter::Implementation::WriteHeader(hid_t group, const char* hdfType)
 {
@@ -428,6 +434,22 @@ vtkHDF::ScopedH5DHandle vtkHDFWriter::Implementation::CreateHdfDataset(
   return this->CreateHdfDataset(group, name, type, dataspace);
 }
 
+//------------------------------------------------------------------------------
+bool vtkHDFWriter::Implementation::IsZstdFilterAvailable()
+{
+  if (this->ZstdFilterAvailable < 0)
+  {
+    // Also loads the filter from the hdf5 plugin path when needed
+    this->ZstdFilterAvailable = H5Zfilter_avail(::ZSTD_FILTER_ID) > 0 ? 1 : 0;
+    if (!this->ZstdFilterAvailable)
+    {
+      vtkWarningWithObjectMacro(this->Writer,
+        "The hdf5 zstd filter plugin is not available, using deflate compression instead.");
+    }
+  }
+  return this->ZstdFilterAvailable == 1;
+}
+
 //------------------------------------------------------------------------------
 vtkHDF::ScopedH5DHandle vtkHDFWriter::Implementation::CreateChunkedHdfDataset(hid_t group,
   const char* name, hid_t type, hid_t dataspace, hsize_t numCols, hsize_t chunkSize[],
@@ -450,7 +472,15 @@ vtkHDF::ScopedH5DHandle vtkHDFWriter::Implementation::CreateChunkedHdfDataset(hi
 
   if (compressionLevel != 0)
   {
-    H5Pset_deflate(plist, compressionLevel);
+    if (this->Writer->CompressionFilter == vtkHDFWriter::ZSTD && this->IsZstdFilterAvailable())
+    {
+      const unsigned int zstdLevel = static_cast<unsigned int>(compressionLevel);
+      H5Pset_filter(plist, ::ZSTD_FILTER_ID, H5Z_FLAG_MANDATORY, 1, &zstdLevel);
+    }
+    else
+    {
+      H5Pset_deflate(plist, compressionLevel);
+    }
   }
 
   vtkHDF::ScopedH5DHandle dset =
@@ -323,6 +323,12 @@ private:
   std::vector<vtkHDF::ScopedH5FHandle> Subfiles;
   std::vector<std::string> SubfileNames;
   bool SubFilesReady = false;
+  int ZstdFilterAvailable = -1; // Unknown until the first compressed dataset
+
+  /**
+   * Return true if the hdf5 zstd filter plugin can be used, warn once otherwise.
+   */
+  bool IsZstdFilterAvailable();
 
   const std::array<std::string, 4> PrimitiveNames = { { "Vertices", "Lines", "Polygons",
     "Strips" } };
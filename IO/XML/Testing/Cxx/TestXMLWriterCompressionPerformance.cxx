@@ -0,0 +1,132 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// .NAME Test speed of the compression of appended XML data.
+// .SECTION Description
+// Write a large image in appended raw mode with every compressor and several
+// block sizes. The blocks are compressed in parallel when the compressor
+// allows it: the output must be identical to the one written with a single
+// thread, must be read back unchanged, and the throughput is reported.
+
+#include "vtkFloatArray.h"
+#include "vtkImageData.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkSMPTools.h"
+#include "vtkTimerLog.h"
+#include "vtkXMLImageDataReader.h"
+#include "vtkXMLImageDataWriter.h"
+#include "vtkXMLWriterBase.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+namespace
+{
+constexpr int DIMENSION = 128;
+
+//------------------------------------------------------------------------------
+std::string Write(vtkImageData* image, int compressorType, size_t blockSize, double& duration)
+{
+  vtkNew<vtkXMLImageDataWriter> writer;
+  writer->SetInputData(image);
+  writer->WriteToOutputStringOn();
+  writer->SetDataModeToAppended();
+  writer->EncodeAppendedDataOff();
+  writer->SetCompressorType(compressorType);
+  writer->SetBlockSize(blockSize);
+
+  vtkNew<vtkTimerLog> timer;
+  timer->StartTimer();
+  writer->Write();
+  timer->StopTimer();
+  duration = timer->GetElapsedTime();
+  return writer->GetOutputString();
+}
+
+//------------------------------------------------------------------------------
+bool TestCompressor(vtkImageData* image, int compressorType, const char* name, size_t blockSize)
+{
+  double serialDuration;
+  std::string serial;
+  vtkSMPTools::LocalScope(vtkSMPTools::Config{ 1 },
+    [&]() { serial = Write(image, compressorType, blockSize, serialDuration); });
+  double threadedDuration;
+  const std::string threaded = Write(image, compressorType, blockSize, threadedDuration);
+
+  if (serial != threaded)
+  {
+    std::cerr << name << " with blocks of " << blockSize
+              << " bytes: the output depends on the number of threads" << std::endl;
+    return false;
+  }
+
+  vtkNew<vtkXMLImageDataReader> reader;
+  reader->ReadFromInputStringOn();
+  reader->SetInputString(threaded);
+  reader->Update();
+  vtkDataArray* expected = image->GetPointData()->GetScalars();
+  vtkDataArray* result = reader->GetOutput()->GetPointData()->GetArray(expected->GetName());
+  if (!result || result->GetNumberOfValues() != expected->GetNumberOfValues())
+  {
+    std::cerr << name << " with blocks of " << blockSize << " bytes: cannot read the data back"
+              << std::endl;
+    return false;
+  }
+  for (vtkIdType i = 0; i < expected->GetNumberOfValues(); ++i)
+  {
+    if (result->GetComponent(i, 0) != expected->GetComponent(i, 0))
+    {
+      std::cerr << name << " with blocks of " << blockSize << " bytes: wrong value at " << i
+                << std::endl;
+      return false;
+    }
+  }
+
+  const double megaBytes = expected->GetNumberOfValues() * sizeof(float) / (1024.0 * 1024.0);
+  const std::string measurement = std::string(name) + "-" + std::to_string(blockSize);
+  std::cout << "<DartMeasurement name=\"" << measurement
+            << "-SerialMBPerSecond\" type=\"numeric/double\">" << megaBytes / serialDuration
+            << "</DartMeasurement>" << std::endl;
+  std::cout << "<DartMeasurement name=\"" << measurement << "-" << vtkSMPTools::GetBackend()
+            << "MBPerSecond\" type=\"numeric/double\">" << megaBytes / threadedDuration
+            << "</DartMeasurement>" << std::endl;
+  return true;
+}
+}
+
+//------------------------------------------------------------------------------
+int TestXMLWriterCompressionPerformance(int, char*[])
+{
+  // Smooth field with some noise so that the compression ratio is realistic.
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(DIMENSION, DIMENSION, DIMENSION);
+  vtkNew<vtkFloatArray> scalars;
+  scalars->SetName("Scalars");
+  scalars->SetNumberOfValues(image->GetNumberOfPoints());
+  vtkSMPTools::For(0, image->GetNumberOfPoints(),
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType i = begin; i < end; ++i)
+      {
+        const float noise = static_cast<float>((i * 7919) % 101) * 1e-4f;
+        scalars->SetValue(i, std::sin(i * 1e-3f) + noise);
+      }
+    });
+  image->GetPointData()->SetScalars(scalars);
+
+  std::cout << "Writing " << DIMENSION << "^3 floats with "
+            << vtkSMPTools::GetEstimatedNumberOfThreads() << " threads and the "
+            << vtkSMPTools::GetBackend() << " backend." << std::endl;
+
+  const size_t blockSizes[] = { 32768, 1048576 };
+  bool success = true;
+  for (size_t blockSize : blockSizes)
+  {
+    success &= TestCompressor(image, vtkXMLWriterBase::ZLIB, "ZLib", blockSize);
+    success &= TestCompressor(image, vtkXMLWriterBase::LZ4, "LZ4", blockSize);
+    success &= TestCompressor(image, vtkXMLWriterBase::LZMA, "LZMA", blockSize);
+  }
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
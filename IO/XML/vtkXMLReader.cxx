@@ -13,6 +13,7 @@
 #include "vtkDataSetAttributes.h"
 #include "vtkErrorCode.h"
 #include "vtkFileResourceStream.h"
+#include "vtkIOCoreConfigure.h"
 #include "vtkInformation.h"
 #include "vtkInformationDoubleKey.h"
 #include "vtkInformationDoubleVectorKey.h"
@@ -39,6 +40,10 @@
 #include "vtkXMLReaderVersion.h"
 #include "vtkZLibDataCompressor.h"
 
+#ifdef VTK_USE_ZSTD
+#include "vtkZstdDataCompressor.h"
+#endif
+
 #include "vtksys/Encoding.hxx"
 #include "vtksys/FStream.hxx"
 #include <vtksys/SystemTools.hxx>
@@ -568,6 +573,12 @@ void vtkXMLReader::SetupCompressor(const char* type)
     {
       compressor = vtkLZMADataCompressor::New();
     }
+#ifdef VTK_USE_ZSTD
+    else if (strcmp(type, "vtkZstdDataCompressor") == 0)
+    {
+      compressor = vtkZstdDataCompressor::New();
+    }
+#endif
   }
 
   if (!compressor)
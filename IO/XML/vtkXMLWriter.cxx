@@ -16,6 +16,7 @@
 #include "vtkDoubleArray.h"
 #include "vtkEndian.h"
 #include "vtkErrorCode.h"
+#include "vtkHalfFloatArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationDoubleKey.h"
 #include "vtkInformationDoubleVectorKey.h"
@@ -33,6 +34,7 @@
 #include "vtkOutputStream.h"
 #include "vtkPointData.h"
 #include "vtkPoints.h"
+#include "vtkSMPTools.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStringArray.h"
 #include "vtkStringFormatter.h"
@@ -48,11 +50,13 @@
 
 #include "vtksys/FStream.hxx"
 
+#include <algorithm>
 #include <cassert>
 #include <cmath>
 #include <memory>
 #include <sstream>
 #include <string>
+#include <vector>
 
 #if !defined(_WIN32) || defined(__CYGWIN__)
 #include <unistd.h> /* unlink */
@@ -196,6 +200,36 @@ struct WriteBinaryDataBlockWorker
     vtkXMLWriterHelper::SetProgressPartial(this->Writer, 1);
   }
 
+  //----------------------------------------------------------------------------
+  // Specialize for vtkHalfFloatArray, written as Float32 with bulk conversions
+  void operator()(vtkHalfFloatArray* array)
+  {
+    size_t blockWords = this->Writer->GetBlockSize() / this->OutWordSize;
+    std::vector<float> buffer(blockWords);
+    if (buffer.empty())
+    {
+      this->Result = false;
+      return;
+    }
+
+    vtkXMLWriterHelper::SetProgressPartial(this->Writer, 0);
+    this->Result = true;
+    vtkIdType valueIdx = 0;
+    size_t wordsLeft = this->NumWords;
+    while (this->Result && wordsLeft > 0)
+    {
+      const size_t words = std::min(blockWords, wordsLeft);
+      array->GetFloatValues(valueIdx, static_cast<vtkIdType>(words), buffer.data());
+      this->Result = vtkXMLWriterHelper::WriteBinaryDataBlock(this->Writer,
+                       reinterpret_cast<unsigned char*>(buffer.data()), words, this->WordType) != 0;
+      valueIdx += static_cast<vtkIdType>(words);
+      wordsLeft -= words;
+      vtkXMLWriterHelper::SetProgressPartial(
+        this->Writer, static_cast<float>(this->NumWords - wordsLeft) / this->NumWords);
+    }
+    vtkXMLWriterHelper::SetProgressPartial(this->Writer, 1);
+  }
+
   //----------------------------------------------------------------------------
   // Specialize for non-AoS generic arrays:
   template <class DerivedType, typename ValueType, int ArrayType>
@@ -422,6 +456,25 @@ int vtkXMLWriterWriteBinaryDataBlocks(vtkXMLWriter* writer, vtkStringArray* iter
 } // end anon namespace
 //*****************************************************************************
 
+//------------------------------------------------------------------------------
+// Blocks of the array being written, kept uncompressed until
+// MaximumNumberOfBlocks of them can be compressed in parallel.
+struct vtkXMLWriter::CompressionBatch
+{
+  std::vector<unsigned char> Data;
+  std::vector<size_t> Offsets{ 0 }; // Offsets of the blocks in Data
+  std::vector<unsigned char> CompressedData;
+  size_t MaximumNumberOfBlocks = 0;
+
+  size_t GetNumberOfBlocks() const { return this->Offsets.size() - 1; }
+
+  void Clear()
+  {
+    this->Data.clear();
+    this->Offsets.resize(1);
+  }
+};
+
 //------------------------------------------------------------------------------
 vtkXMLWriter::vtkXMLWriter()
 {
@@ -432,6 +485,7 @@ vtkXMLWriter::vtkXMLWriter()
 
   // Initialize compression data.
   this->CompressionHeader = nullptr;
+  this->PendingCompressionBlocks = nullptr;
   this->Int32IdTypeBuffer = nullptr;
   this->ByteSwapBuffer = nullptr;
 
@@ -465,6 +519,7 @@ vtkXMLWriter::~vtkXMLWriter()
   this->OutStringStream = nullptr;
   delete this->FieldDataOM;
   delete[] this->NumberOfTimeValues;
+  delete this->PendingCompressionBlocks;
 }
 
 //------------------------------------------------------------------------------
@@ -1001,6 +1056,12 @@ int vtkXMLWriter::WriteBinaryData(vtkAbstractArray* a)
       result = 0;
     }
 
+    // Compress and write the blocks that are still pending.
+    if (result && !this->FlushCompressionBlocks())
+    {
+      result = 0;
+    }
+
     // Finish writing the data.
     if (result && !this->DataStream->EndWriting())
     {
@@ -1016,6 +1077,11 @@ int vtkXMLWriter::WriteBinaryData(vtkAbstractArray* a)
     // Destroy the compression header if it was used.
     delete this->CompressionHeader;
     this->CompressionHeader = nullptr;
+    if (this->PendingCompressionBlocks)
+    {
+      this->PendingCompressionBlocks->Clear();
+      this->PendingCompressionBlocks->MaximumNumberOfBlocks = 0;
+    }
 
     return result;
   }
@@ -1131,8 +1197,9 @@ int vtkXMLWriter::WriteBinaryDataInternal(vtkAbstractArray* a)
   }
   else if (vtkDataArray* da = vtkArrayDownCast<vtkDataArray>(a))
   {
-    // Create a dispatcher that also handles vtkBitArray:
-    using AllArrays = vtkTypeList::Append<vtkArrayDispatch::AllArrays, vtkBitArray>::Result;
+    // Create a dispatcher that also handles vtkBitArray and vtkHalfFloatArray:
+    using AllArrays =
+      vtkTypeList::Append<vtkArrayDispatch::AllArrays, vtkBitArray, vtkHalfFloatArray>::Result;
     using PointCellArrays = vtkTypeList::Append<vtkArrayDispatch::AllPointArrays,
       vtkArrayDispatch::OffsetsArrays, vtkArrayDispatch::CellTypesArrays>::Result;
     using XMLArrays =
@@ -1357,12 +1424,40 @@ int vtkXMLWriter::CreateCompressionHeader(size_t size)
   // Initialize counter for block writing.
   this->CompressionBlockNumber = 0;
 
+  // Blocks are compressed independently, so several of them can be
+  // compressed at once when the compressor allows it.
+  const size_t numThreads = static_cast<size_t>(vtkSMPTools::GetEstimatedNumberOfThreads());
+  if (numBlocks > 1 && numThreads > 1 && this->Compressor->SupportsConcurrentCompression())
+  {
+    if (!this->PendingCompressionBlocks)
+    {
+      this->PendingCompressionBlocks = new CompressionBatch;
+    }
+    // A few blocks per thread balance the compression time of the blocks
+    // while bounding the memory used by the batch.
+    this->PendingCompressionBlocks->MaximumNumberOfBlocks = std::min(numBlocks, 4 * numThreads);
+    this->PendingCompressionBlocks->Clear();
+  }
+
   return result;
 }
 
 //------------------------------------------------------------------------------
 int vtkXMLWriter::WriteCompressionBlock(unsigned char* data, size_t size)
 {
+  CompressionBatch* batch = this->PendingCompressionBlocks;
+  if (batch && batch->MaximumNumberOfBlocks > 1)
+  {
+    // Keep a copy of the block, the caller reuses its buffer.
+    batch->Data.insert(batch->Data.end(), data, data + size);
+    batch->Offsets.push_back(batch->Data.size());
+    if (batch->GetNumberOfBlocks() < batch->MaximumNumberOfBlocks)
+    {
+      return 1;
+    }
+    return this->FlushCompressionBlocks();
+  }
+
   // Compress the data.
   vtkUnsignedCharArray* outputArray = this->Compressor->Compress(data, size);
 
@@ -1386,6 +1481,67 @@ int vtkXMLWriter::WriteCompressionBlock(unsigned char* data, size_t size)
   return result;
 }
 
+//------------------------------------------------------------------------------
+int vtkXMLWriter::FlushCompressionBlocks()
+{
+  CompressionBatch* batch = this->PendingCompressionBlocks;
+  if (!batch || batch->GetNumberOfBlocks() == 0)
+  {
+    return 1;
+  }
+
+  // Reserve the maximum compressed size of every block.
+  const size_t numBlocks = batch->GetNumberOfBlocks();
+  std::vector<size_t> compressedOffsets(numBlocks + 1, 0);
+  for (size_t block = 0; block < numBlocks; ++block)
+  {
+    compressedOffsets[block + 1] = compressedOffsets[block] +
+      this->Compressor->GetMaximumCompressionSpace(
+        batch->Offsets[block + 1] - batch->Offsets[block]);
+  }
+  batch->CompressedData.resize(compressedOffsets[numBlocks]);
+
+  // Compress the blocks in parallel.
+  std::vector<size_t> compressedSizes(numBlocks, 0);
+  vtkDataCompressor* compressor = this->Compressor;
+  vtkSMPTools::For(0, static_cast<vtkIdType>(numBlocks), 1,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType block = begin; block < end; ++block)
+      {
+        compressedSizes[block] = compressor->Compress(batch->Data.data() + batch->Offsets[block],
+          batch->Offsets[block + 1] - batch->Offsets[block],
+          batch->CompressedData.data() + compressedOffsets[block],
+          compressedOffsets[block + 1] - compressedOffsets[block]);
+      }
+    });
+
+  // Write the compressed blocks in order and store their sizes in the
+  // compression header.
+  int result = 1;
+  for (size_t block = 0; block < numBlocks && result; ++block)
+  {
+    if (compressedSizes[block] == 0)
+    {
+      vtkErrorMacro("Failed to compress block " << this->CompressionBlockNumber << ".");
+      result = 0;
+      break;
+    }
+    result = this->DataStream->Write(
+      batch->CompressedData.data() + compressedOffsets[block], compressedSizes[block]);
+    this->CompressionHeader->Set(3 + this->CompressionBlockNumber++, compressedSizes[block]);
+  }
+  this->Stream->flush();
+  if (this->Stream->fail())
+  {
+    this->SetErrorCode(vtkErrorCode::GetLastSystemError());
+    result = 0;
+  }
+
+  batch->Clear();
+  return result;
+}
+
 //------------------------------------------------------------------------------
 int vtkXMLWriter::WriteCompressionHeader()
 {
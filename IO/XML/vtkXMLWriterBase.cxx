@@ -5,12 +5,17 @@
 #include "vtkXMLWriterBase.h"
 
 #include "vtkDataCompressor.h"
+#include "vtkIOCoreConfigure.h"
 #include "vtkLZ4DataCompressor.h"
 #include "vtkLZMADataCompressor.h"
 #include "vtkObjectFactory.h"
 #include "vtkXMLReaderVersion.h"
 #include "vtkZLibDataCompressor.h"
 
+#ifdef VTK_USE_ZSTD
+#include "vtkZstdDataCompressor.h"
+#endif
+
 VTK_ABI_NAMESPACE_BEGIN
 vtkCxxSetObjectMacro(vtkXMLWriterBase, Compressor, vtkDataCompressor);
 //----------------------------------------------------------------------------
@@ -122,6 +127,20 @@ void vtkXMLWriterBase::SetCompressorType(int compressorType)
     this->Compressor->SetCompressionLevel(this->CompressionLevel);
     this->Modified();
   }
+  else if (compressorType == ZSTD)
+  {
+#ifdef VTK_USE_ZSTD
+    if (this->Compressor)
+    {
+      this->Compressor->Delete();
+    }
+    this->Compressor = vtkZstdDataCompressor::New();
+    this->Compressor->SetCompressionLevel(this->CompressionLevel);
+    this->Modified();
+#else
+    vtkWarningMacro("Zstd compression is not available, VTK was built without VTK_USE_ZSTD.");
+#endif
+  }
   else
   {
     vtkWarningMacro("Invalid compressorType:" << compressorType);
@@ -139,18 +139,22 @@ public:
     NONE,
     ZLIB,
     LZ4,
-    LZMA
+    LZMA,
+    ZSTD
   };
 
   ///@{
   /**
    * Convenience functions to set the compressor to certain known types.
+   * ZSTD is only available when VTK is built with `VTK_USE_ZSTD`, otherwise
+   * the compressor is left unchanged.
    */
   void SetCompressorType(int compressorType);
   void SetCompressorTypeToNone() { this->SetCompressorType(NONE); }
   void SetCompressorTypeToLZ4() { this->SetCompressorType(LZ4); }
   void SetCompressorTypeToZLib() { this->SetCompressorType(ZLIB); }
   void SetCompressorTypeToLZMA() { this->SetCompressorType(LZMA); }
+  void SetCompressorTypeToZstd() { this->SetCompressorType(ZSTD); }
   ///@}
 
   ///@{